@@ -32,7 +32,7 @@ from backend.config import (
 from backend.memory import MemoryManager
 from backend.llm import get_all_providers
 from backend.core.logging import get_logger, set_request_id, reset_request_id, get_request_id
-from backend.core.telemetry.metrics import MetricsRegistry
+from backend.core.telemetry.metrics import MetricsRegistry, native_stats_collector
 from backend.core.errors import AxnmihnError
 from backend.core.health.health_check import HealthChecker, HealthResult, HealthState
 from backend.api import (
@@ -136,6 +136,7 @@ async def lifespan(app: FastAPI):
     _metrics.counter("http_requests_total", "Total HTTP requests")
     _metrics.histogram("http_request_duration_seconds", "HTTP request duration")
     _metrics.counter("http_errors_total", "Total HTTP errors")
+    _metrics.register_collector(native_stats_collector)
     state.metrics = _metrics
 
     # Initialize health checker with component checks
@@ -73,6 +73,11 @@ KNOWLEDGE_GRAPH_PATH = DATA_ROOT / "knowledge_graph.json"
 
 PERSONA_PATH = DATA_ROOT / "dynamic_persona.json"
 
+INTERACTION_LOG_DIR = DATA_ROOT / "interaction_logs"
+# Segment retention; 0 keeps everything
+INTERACTION_LOG_MAX_AGE_DAYS = float(os.getenv("INTERACTION_LOG_MAX_AGE_DAYS", "90"))
+INTERACTION_LOG_MAX_BYTES = int(os.getenv("INTERACTION_LOG_MAX_BYTES", str(2 * 1024**3)))
+
 STORAGE_ROOT = PROJECT_ROOT / "storage"
 
 RESEARCH_INBOX_DIR = STORAGE_ROOT / "research" / "inbox"
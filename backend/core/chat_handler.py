@@ -30,6 +30,7 @@ from backend.core.services.react_service import (
 )
 from backend.core.services.emotion_service import classify_emotion
 from backend.core.intent.classifier import classify_keyword
+from backend.core.telemetry.interaction_log import InteractionLog, get_log_writer
 from backend.llm.router import DEFAULT_MODEL
 from backend.config import CHAT_PROVIDER, CHAT_THINKING_LEVEL
 
@@ -257,6 +258,7 @@ class ChatHandler:
         # 7. Run ReAct loop
         full_response = ""
         llm_elapsed = 0.0
+        tool_calls: list = []
 
         async for event in self.react_service.run(
             prompt=final_prompt,
@@ -272,6 +274,7 @@ class ChatHandler:
                 result: ReActResult = event.metadata["react_result"]
                 full_response = result.full_response
                 llm_elapsed = result.llm_elapsed_ms
+                tool_calls = result.tool_calls
             else:
                 yield event
 
@@ -296,8 +299,10 @@ class ChatHandler:
             turns=self._get_turn_count(),
         )
 
-        # 10. Log interaction to session archive
-        self._log_interaction(model_config, tier, classification, request, total_elapsed, full_response)
+        # 10. Log interaction (segment append + background archive write)
+        self._log_interaction(
+            model_config, tier, classification, request, total_elapsed, full_response, tool_calls
+        )
 
         # 11. Yield final events
         yield ChatEvent(EventType.STATUS, "Idle")
@@ -380,14 +385,38 @@ class ChatHandler:
         classification: ClassificationResult,
         request: ChatRequest,
         total_elapsed: float,
-        full_response: str
+        full_response: str,
+        tool_calls: Optional[List[str]] = None,
     ) -> None:
-        """Log interaction to session archive."""
+        """Log interaction to the native log segments and the session archive.
+
+        The native append only queues the record. The session-archive SQL
+        insert runs in a worker thread as a background task so the turn
+        never waits on the database.
+        """
+        writer = get_log_writer()
+        if writer is not None:
+            try:
+                writer.append(InteractionLog(
+                    session_id=self._get_session_id() or "",
+                    effective_model=model_config.id,
+                    tier=tier,
+                    latency_ms=int(total_elapsed),
+                    tokens_in=len(request.user_input) // 4,
+                    tokens_out=len(full_response) // 4,
+                    turn_id=self._get_turn_count(),
+                    tool_calls=list(tool_calls or []),
+                ))
+            except Exception as e:
+                _log.debug("LOG segment append fail", error=str(e))
+
         if not (self.state.memory_manager and self.state.memory_manager.is_session_archive_available()):
             return
 
         try:
-            self.state.memory_manager.session_archive.log_interaction(
+            archive = self.state.memory_manager.session_archive
+            write = asyncio.to_thread(
+                archive.log_interaction,
                 routing_decision={
                     "effective_model": model_config.id,
                     "tier": tier,
@@ -401,7 +430,9 @@ class ChatHandler:
                 latency_ms=int(total_elapsed),
                 tokens_in=len(request.user_input) // 4,
                 tokens_out=len(full_response) // 4,
-                response_text=full_response
+                tool_calls=list(tool_calls or []),
+                response_text=full_response,
             )
+            self._spawn_task(write, "interaction_log")
         except Exception as e:
             _log.debug("LOG interaction fail", error=str(e))
@@ -1,8 +1,8 @@
-"""Token counting with SHA-256 LRU cache."""
+"""Token counting with an XXH3-keyed LRU cache."""
 
-import hashlib
 from collections import OrderedDict
 from backend.core.logging import get_logger
+from backend.core.utils.content_hash import hash64
 
 _log = get_logger("core.token_counter")
 
@@ -13,7 +13,7 @@ class TokenCounter:
     CHARS_PER_TOKEN = 4  # fallback estimate
 
     def __init__(self, cache_size: int = 1000):
-        self._cache: OrderedDict[str, int] = OrderedDict()
+        self._cache: OrderedDict[int, int] = OrderedDict()
         self._cache_size = cache_size
 
     def count(self, text: str) -> int:
@@ -25,7 +25,7 @@ class TokenCounter:
         Returns:
             Estimated token count
         """
-        key = hashlib.sha256(text.encode()).hexdigest()[:16]
+        key = hash64(text)
         if key in self._cache:
             self._cache.move_to_end(key)
             return self._cache[key]
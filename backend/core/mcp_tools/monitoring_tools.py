@@ -246,8 +246,69 @@ async def system_status_tool(arguments: dict[str, Any]) -> Sequence[TextContent]
         return [TextContent(type="text", text=f"✗ Error: {str(e)}")]
 
 
+@register_tool(
+    "native_stats",
+    category="system",
+    description="Get per-call counters and latency percentiles for the C++ native module (axnmihn_native).",
+    input_schema={
+        "type": "object",
+        "properties": {
+            "reset": {
+                "type": "boolean",
+                "description": "If true, zero the native counters after reading them",
+                "default": False
+            }
+        },
+        "required": []
+    }
+)
+async def native_stats_tool(arguments: dict[str, Any]) -> Sequence[TextContent]:
+    """Get native module call counters.
+
+    Args:
+        arguments: Dict with optional reset flag
+
+    Returns:
+        TextContent with calls, latency percentiles and kernel share per entry point
+    """
+    reset = arguments.get("reset", False)
+    _log.debug("TOOL invoke", fn="native_stats", reset=reset)
+
+    try:
+        try:
+            import axnmihn_native as native
+        except ImportError:
+            return [TextContent(type="text", text="✗ Native module not available")]
+
+        stats = native.stats()
+        if reset:
+            native.reset_stats()
+        if not stats:
+            return [TextContent(type="text", text="✓ No native calls recorded yet.")]
+
+        output = ["✓ Native Call Stats:", ""]
+
+        # Sort by total time spent
+        for name, s in sorted(stats.items(), key=lambda x: x[1]["total_ns"], reverse=True)[:20]:
+            kernel_share = s["kernel_ns"] / s["total_ns"] if s["total_ns"] else 0.0
+            output.append(f"  {name}:")
+            output.append(
+                f"    Calls: {s['calls']} | Elements: {s['elements']} | "
+                f"p50: {s['p50_ns'] / 1e3:.1f}µs | p99: {s['p99_ns'] / 1e3:.1f}µs | "
+                f"Kernel: {kernel_share:.0%}"
+            )
+
+        _log.info("TOOL ok", fn="native_stats", entries=len(stats))
+        return [TextContent(type="text", text="\n".join(output))]
+
+    except Exception as e:
+        _log.error("TOOL fail", fn="native_stats", err=str(e)[:100])
+        return [TextContent(type="text", text=f"✗ Error: {str(e)}")]
+
+
 __all__ = [
     "check_task_status",
     "tool_metrics_tool",
     "system_status_tool",
+    "native_stats_tool",
 ]
@@ -5,7 +5,7 @@ from their new specialized modules:
 - command_tools: run_command
 - search_tools: search_codebase, search_codebase_regex
 - log_tools: read_system_logs, list_available_logs, analyze_log_errors
-- monitoring_tools: check_task_status, tool_metrics, system_status
+- monitoring_tools: check_task_status, tool_metrics, system_status, native_stats
 
 All imports from this module will continue to work as before.
 """
@@ -22,6 +22,7 @@ from .monitoring_tools import (
     check_task_status,
     tool_metrics_tool,
     system_status_tool,
+    native_stats_tool,
 )
 
 __all__ = [
@@ -38,4 +39,5 @@ __all__ = [
     "check_task_status",
     "tool_metrics_tool",
     "system_status_tool",
+    "native_stats_tool",
 ]
@@ -64,6 +64,7 @@ class ReActResult:
     full_response: str
     loops_completed: int
     llm_elapsed_ms: float
+    tool_calls: List[str] = field(default_factory=list)  # Executed tool names, in order
 
 
 class ReActLoopService:
@@ -109,6 +110,7 @@ class ReActLoopService:
         current_system_prompt = system_prompt
         loop_count = 0
         full_response = ""
+        tool_calls: List[str] = []
 
         llm_start_time = time.perf_counter()
 
@@ -251,6 +253,7 @@ class ReActLoopService:
 
                 # Emit tool events
                 for result in execution_result.results:
+                    tool_calls.append(result.name)
                     yield ChatEvent(EventType.TOOL_START, "", metadata={
                         "tool_name": result.name,
                         "tool_args": {}
@@ -263,6 +266,7 @@ class ReActLoopService:
                     })
 
                 # Spawn deferred tools
+                tool_calls.extend(name for name, _ in execution_result.deferred_tools)
                 if execution_result.deferred_tools and background_tasks is not None:
                     self.tool_service.spawn_deferred_task(
                         execution_result.deferred_tools,
@@ -301,7 +305,8 @@ class ReActLoopService:
             "react_result": ReActResult(
                 full_response=full_response,
                 loops_completed=loop_count,
-                llm_elapsed_ms=llm_elapsed
+                llm_elapsed_ms=llm_elapsed,
+                tool_calls=tool_calls,
             )
         })
 
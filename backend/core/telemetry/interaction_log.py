@@ -1,12 +1,29 @@
-"""LLM interaction telemetry logging."""
+"""LLM interaction telemetry logging.
 
+Besides the SQL tables, interactions can go to native append-only log
+segments (InteractionLogWriter): append() only queues the record, a
+background thread writes and fsyncs, and read_interaction_columns()
+scans the segments into NumPy columns for analytics.
+"""
+
+import atexit
 import json
+import threading
+import time
 from dataclasses import dataclass, field
-from typing import Optional, List
+from pathlib import Path
+from typing import Any, Dict, Optional, List, Union
 from backend.core.logging import get_logger
 
 _log = get_logger("core.telemetry")
 
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE_LOG = hasattr(_native, "interaction_log")
+except ImportError:
+    _native = None
+    _HAS_NATIVE_LOG = False
+
 
 @dataclass
 class InteractionLog:
@@ -23,6 +40,7 @@ class InteractionLog:
     tokens_out: int = 0
     tool_calls: List[str] = field(default_factory=list)
     error: Optional[str] = None
+    turn_id: Optional[int] = None
 
 
 def log_interaction(conn_mgr, log: InteractionLog) -> int:
@@ -91,3 +109,122 @@ def query_interactions(
         for row in rows:
             result.append(dict(zip(col_names, row)))
         return result
+
+
+class InteractionLogWriter:
+    """Non-blocking writer for native interaction log segments.
+
+    append() encodes the record and queues it; a native background thread
+    writes batches to `interactions-NNNNNN.axlog` segments and fsyncs at
+    most every fsync_interval_ms, so logging adds no I/O to a chat turn.
+    Closed segments older than max_age_seconds, or beyond max_total_bytes
+    (oldest first), are deleted whenever a new segment is opened.
+    """
+
+    def __init__(
+        self,
+        directory: Union[str, Path],
+        segment_bytes: int = 64 * 1024 * 1024,
+        fsync_interval_ms: int = 1000,
+        max_age_seconds: float = 0.0,
+        max_total_bytes: int = 0,
+    ):
+        if not _HAS_NATIVE_LOG:
+            raise RuntimeError("axnmihn_native.interaction_log is not available")
+        self.directory = Path(directory)
+        self._writer = _native.interaction_log.LogWriter(
+            str(self.directory),
+            segment_bytes=segment_bytes,
+            fsync_interval_ms=fsync_interval_ms,
+            max_age_seconds=max_age_seconds,
+            max_total_bytes=max_total_bytes,
+        )
+
+    def append(self, log: InteractionLog, timestamp: Optional[float] = None) -> bool:
+        """Queue one interaction.
+
+        Args:
+            log: InteractionLog to store
+            timestamp: Epoch seconds (defaults to now)
+
+        Returns:
+            False if the record was dropped (queue full or writer closed)
+        """
+        return self._writer.append(
+            time.time() if timestamp is None else timestamp,
+            session_id=log.session_id,
+            model=log.effective_model,
+            tier=log.tier,
+            router_reason=log.router_reason,
+            turn_id=-1 if log.turn_id is None else log.turn_id,
+            latency_ms=log.latency_ms,
+            ttft_ms=log.ttft_ms,
+            tokens_in=log.tokens_in,
+            tokens_out=log.tokens_out,
+            tool_calls_json=json.dumps(log.tool_calls, ensure_ascii=False),
+            tool_call_count=min(len(log.tool_calls), 0xFFFF),
+            error=log.error,
+        )
+
+    def flush(self) -> None:
+        """Block until everything appended so far is on disk."""
+        self._writer.flush()
+
+    def close(self) -> None:
+        self._writer.close()
+
+    @property
+    def stats(self) -> Dict[str, int]:
+        return self._writer.stats()
+
+
+_writer: Optional[InteractionLogWriter] = None
+_writer_lock = threading.Lock()
+
+
+def get_log_writer() -> Optional[InteractionLogWriter]:
+    """Process-wide writer for INTERACTION_LOG_DIR, or None without the native module."""
+    global _writer
+    if not _HAS_NATIVE_LOG:
+        return None
+    if _writer is None:
+        with _writer_lock:
+            if _writer is None:
+                from backend.config import (
+                    INTERACTION_LOG_DIR,
+                    INTERACTION_LOG_MAX_AGE_DAYS,
+                    INTERACTION_LOG_MAX_BYTES,
+                )
+
+                try:
+                    _writer = InteractionLogWriter(
+                        INTERACTION_LOG_DIR,
+                        max_age_seconds=INTERACTION_LOG_MAX_AGE_DAYS * 86400.0,
+                        max_total_bytes=INTERACTION_LOG_MAX_BYTES,
+                    )
+                except Exception as e:
+                    _log.warning("Interaction log writer unavailable", error=str(e))
+                    return None
+                atexit.register(_writer.close)
+    return _writer
+
+
+def read_interaction_columns(
+    directory: Union[str, Path], since: float = 0.0
+) -> Optional[Dict[str, Any]]:
+    """Scan native log segments into columns.
+
+    Args:
+        directory: Segment directory
+        since: Minimum timestamp (epoch seconds)
+
+    Returns:
+        Dict of NumPy columns (string columns as (codes, dictionary)),
+        or None without the native module
+    """
+    if not _HAS_NATIVE_LOG:
+        return None
+    columns = _native.interaction_log.read_columns(str(directory), since)
+    if columns["corrupt"]:
+        _log.warning("Damaged interaction log segments", count=columns["corrupt"])
+    return columns
@@ -3,7 +3,9 @@
 Lightweight, zero-dependency metrics with Counter, Gauge, and Histogram types.
 """
 
+from collections.abc import Callable
 from dataclasses import dataclass, field
+from typing import Any
 
 
 @dataclass
@@ -110,6 +112,7 @@ class MetricsRegistry:
 
     def __init__(self) -> None:
         self._metrics: dict[str, Counter | Gauge | Histogram] = {}
+        self._collectors: list[Callable[[], str]] = []
 
     def counter(self, name: str, help_text: str) -> Counter:
         if name in self._metrics:
@@ -134,5 +137,70 @@ class MetricsRegistry:
         self._metrics[name] = h
         return h
 
+    def register_collector(self, collector: Callable[[], str]) -> None:
+        """Add a callable that renders extra metrics text on every scrape."""
+        self._collectors.append(collector)
+
     def format_all(self) -> str:
-        return "\n\n".join(m.format() for m in self._metrics.values())
+        parts = [m.format() for m in self._metrics.values()]
+        for collector in self._collectors:
+            text = collector()
+            if text:
+                parts.append(text)
+        return "\n\n".join(parts)
+
+
+NATIVE_LATENCY_BUCKETS = [1e-6, 1e-5, 1e-4, 1e-3, 0.01, 0.1, 1, 10]
+
+
+def format_native_stats(stats: dict[str, dict[str, Any]]) -> str:
+    """Render axnmihn_native.stats() output in Prometheus text format.
+
+    Args:
+        stats: Mapping of native entry point to its counters
+
+    Returns:
+        Metrics text labelled by ``fn`` (empty if there are no calls)
+    """
+    if not stats:
+        return ""
+
+    counters = [
+        ("calls", "axnmihn_native_calls_total", "Native entry point calls"),
+        ("elements", "axnmihn_native_elements_total", "Elements processed by native calls"),
+        ("bytes_in", "axnmihn_native_bytes_in_total", "Input bytes read by native calls"),
+        ("bytes_out", "axnmihn_native_bytes_out_total", "Output bytes written by native calls"),
+    ]
+    lines: list[str] = []
+    for key, name, help_text in counters:
+        lines.append(f"# HELP {name} {help_text}")
+        lines.append(f"# TYPE {name} counter")
+        for fn, s in sorted(stats.items()):
+            lines.append(f'{name}{{fn="{fn}"}} {s[key]}')
+
+    name = "axnmihn_native_kernel_seconds_total"
+    lines.append(f"# HELP {name} Time in native kernels, excluding marshalling")
+    lines.append(f"# TYPE {name} counter")
+    for fn, s in sorted(stats.items()):
+        lines.append(f'{name}{{fn="{fn}"}} {s["kernel_ns"] / 1e9}')
+
+    name = "axnmihn_native_call_duration_seconds"
+    lines.append(f"# HELP {name} Native call duration including marshalling")
+    lines.append(f"# TYPE {name} histogram")
+    for fn, s in sorted(stats.items()):
+        for le in NATIVE_LATENCY_BUCKETS:
+            count = sum(c for upper_ns, c in s["buckets"] if upper_ns / 1e9 <= le)
+            lines.append(f'{name}_bucket{{fn="{fn}",le="{le}"}} {count}')
+        lines.append(f'{name}_bucket{{fn="{fn}",le="+Inf"}} {s["calls"]}')
+        lines.append(f'{name}_sum{{fn="{fn}"}} {s["total_ns"] / 1e9}')
+        lines.append(f'{name}_count{{fn="{fn}"}} {s["calls"]}')
+    return "\n".join(lines)
+
+
+def native_stats_collector() -> str:
+    """Collector for MetricsRegistry that exports native call counters."""
+    try:
+        import axnmihn_native
+    except ImportError:
+        return ""
+    return format_native_stats(axnmihn_native.stats())
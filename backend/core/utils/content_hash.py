@@ -0,0 +1,107 @@
+"""Shared content hashing for dedup and cache keys.
+
+Every caller hashes with XXH3 after the same optional normalization, so
+dedup passes and caches agree on what "the same text" means. The native
+module hashes batches in parallel; otherwise the xxhash package (same
+values) or, without it, BLAKE2b is used.
+"""
+
+import hashlib
+from typing import Dict, List, Sequence
+
+from backend.core.utils.text_normalize import normalize_text
+
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE = hasattr(_native, "hashing")
+except ImportError:
+    _native = None
+    _HAS_NATIVE = False
+
+try:
+    import xxhash as _xxhash
+except ImportError:
+    _xxhash = None
+
+
+def _hash128_py(data: bytes) -> int:
+    if _xxhash is not None:
+        return _xxhash.xxh3_128_intdigest(data)
+    return int.from_bytes(hashlib.blake2b(data, digest_size=16).digest(), "little")
+
+
+def _hash64_py(data: bytes) -> int:
+    if _xxhash is not None:
+        return _xxhash.xxh3_64_intdigest(data)
+    return int.from_bytes(hashlib.blake2b(data, digest_size=8).digest(), "little")
+
+
+def content_hash(
+    text: str,
+    collapse_whitespace: bool = False,
+    casefold: bool = False,
+    max_chars: int = 0,
+    nfkc: bool = False,
+) -> str:
+    """128-bit content hash as 32 hex characters.
+
+    Args:
+        text: Input text
+        collapse_whitespace: Trim and collapse whitespace before hashing
+        casefold: Fold case (str.casefold) before hashing
+        max_chars: Hash only the first N normalized characters (0 = all)
+        nfkc: NFKC-normalize before hashing
+
+    Returns:
+        Hex digest
+    """
+    normalized = normalize_text(text, collapse_whitespace, casefold, max_chars, nfkc)
+    if _HAS_NATIVE:
+        value = _native.hashing.xxh3_128(normalized)
+    else:
+        value = _hash128_py(normalized.encode())
+    return f"{value:032x}"
+
+
+def hash64(text: str) -> int:
+    """64-bit hash of text, for in-memory cache keys."""
+    if _HAS_NATIVE:
+        return _native.hashing.xxh3_64(text)
+    return _hash64_py(text.encode())
+
+
+def duplicate_groups(
+    texts: Sequence[str],
+    collapse_whitespace: bool = False,
+    casefold: bool = False,
+    max_chars: int = 0,
+    nfkc: bool = False,
+) -> List[List[int]]:
+    """Group indices of texts that are equal after normalization.
+
+    Args:
+        texts: Texts to compare
+        collapse_whitespace: Trim and collapse whitespace before hashing
+        casefold: Fold case (str.casefold) before hashing
+        max_chars: Compare only the first N normalized characters (0 = all)
+        nfkc: NFKC-normalize before hashing
+
+    Returns:
+        Groups of two or more indices, ascending within a group and
+        ordered by their first index
+    """
+    if _HAS_NATIVE:
+        groups = _native.hashing.duplicate_groups(
+            list(texts),
+            collapse_whitespace=collapse_whitespace,
+            casefold=casefold,
+            max_chars=max_chars,
+            nfkc=nfkc,
+        )
+        return [g.tolist() for g in groups]
+
+    by_hash: Dict[int, List[int]] = {}
+    for i, text in enumerate(texts):
+        normalized = normalize_text(text, collapse_whitespace, casefold, max_chars, nfkc)
+        by_hash.setdefault(_hash128_py(normalized.encode()), []).append(i)
+    return [group for group in by_hash.values() if len(group) > 1]
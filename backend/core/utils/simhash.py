@@ -0,0 +1,215 @@
+"""SimHash near-duplicate detection for message text.
+
+Retries and edited resends produce long messages that differ by a few
+words and usually have no embedding. A 64-bit SimHash over word pairs
+moves by only a few bits for such edits, and a banded index finds every
+fingerprint within the Hamming threshold without comparing all pairs.
+The native module does the shingling and lookups; the Python fallback
+computes the same fingerprints (with the xxhash package installed).
+"""
+
+from typing import Dict, List, Sequence, Tuple
+
+from backend.core.utils.content_hash import hash64, normalize_text
+
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE = hasattr(_native, "simhash")
+except ImportError:
+    _native = None
+    _HAS_NATIVE = False
+
+DEFAULT_MAX_DISTANCE = 6
+DEFAULT_SHINGLE_SIZE = 2
+# Shorter texts have too few shingles for a stable fingerprint
+MIN_NEAR_DUP_CHARS = 200
+
+
+def hamming(a: int, b: int) -> int:
+    """Number of differing bits between two fingerprints."""
+    return (a ^ b).bit_count()
+
+
+def _fingerprint_py(text: str, kind: str, shingle_size: int) -> int:
+    normalized = normalize_text(text, collapse_whitespace=True, casefold=True)
+    if not normalized:
+        return 0
+    sep = " " if kind == "word" else ""
+    units = normalized.split(" ") if kind == "word" else normalized
+    k = max(shingle_size, 1)
+    if len(units) <= k:
+        return hash64(normalized)
+
+    counts = [0] * 64
+    for i in range(len(units) - k + 1):
+        h = hash64(sep.join(units[i:i + k]))
+        for bit in range(64):
+            counts[bit] += 1 if (h >> bit) & 1 else -1
+    return sum(1 << bit for bit in range(64) if counts[bit] > 0)
+
+
+def fingerprints(
+    texts: Sequence[str],
+    kind: str = "word",
+    shingle_size: int = DEFAULT_SHINGLE_SIZE,
+) -> List[int]:
+    """SimHash fingerprints of texts.
+
+    Args:
+        texts: Texts to fingerprint (whitespace collapsed, case folded)
+        kind: "word" or "char" shingles
+        shingle_size: Words or characters per shingle
+
+    Returns:
+        One 64-bit fingerprint per text (0 for empty text)
+    """
+    if kind not in ("word", "char"):
+        raise ValueError("kind must be 'word' or 'char'")
+    if _HAS_NATIVE:
+        return _native.simhash.fingerprint_batch(
+            list(texts), kind=kind, shingle_size=shingle_size
+        ).tolist()
+    return [_fingerprint_py(text, kind, shingle_size) for text in texts]
+
+
+def fingerprint(text: str, kind: str = "word", shingle_size: int = DEFAULT_SHINGLE_SIZE) -> int:
+    """SimHash fingerprint of one text."""
+    return fingerprints([text], kind, shingle_size)[0]
+
+
+class SimHashIndex:
+    """Incremental banded index of fingerprints.
+
+    Fingerprints get ids in insertion order. The 64 bits are split into
+    max_distance + 1 bands; any fingerprint within max_distance bits
+    agrees with the query on at least one band, so a query only checks
+    ids that share a band value.
+    """
+
+    def __init__(self, max_distance: int = DEFAULT_MAX_DISTANCE, use_native: bool = True):
+        if not 0 <= max_distance <= 63:
+            raise ValueError("max_distance must be in 0..63")
+        self.max_distance = max_distance
+        self._native = None
+        if use_native and _HAS_NATIVE:
+            self._native = _native.simhash.SimHashIndex(max_distance)
+            return
+
+        bands = max_distance + 1
+        base, extra = divmod(64, bands)
+        self._bands: List[Tuple[int, int]] = []
+        shift = 0
+        for b in range(bands):
+            width = base + (1 if b < extra else 0)
+            self._bands.append((shift, (1 << width) - 1))
+            shift += width
+        self._tables: List[Dict[int, List[int]]] = [{} for _ in range(bands)]
+        self._fingerprints: List[int] = []
+
+    @property
+    def is_native(self) -> bool:
+        return self._native is not None
+
+    def __len__(self) -> int:
+        if self._native is not None:
+            return len(self._native)
+        return len(self._fingerprints)
+
+    def add(self, fp: int) -> int:
+        """Add a fingerprint and return its id."""
+        if self._native is not None:
+            return self._native.add(fp)
+        fp_id = len(self._fingerprints)
+        self._fingerprints.append(fp)
+        for (shift, mask), table in zip(self._bands, self._tables):
+            table.setdefault((fp >> shift) & mask, []).append(fp_id)
+        return fp_id
+
+    def query(self, fp: int) -> List[Tuple[int, int]]:
+        """(id, distance) of indexed fingerprints within max_distance, nearest first."""
+        if self._native is not None:
+            return self._native.query(fp)
+        matches = {}
+        for (shift, mask), table in zip(self._bands, self._tables):
+            for fp_id in table.get((fp >> shift) & mask, ()):
+                if fp_id not in matches:
+                    d = hamming(fp, self._fingerprints[fp_id])
+                    if d <= self.max_distance:
+                        matches[fp_id] = d
+        return sorted(matches.items(), key=lambda m: (m[1], m[0]))
+
+    def add_and_query(self, fp: int) -> Tuple[int, List[Tuple[int, int]]]:
+        """Query, then add: (new id, matches among earlier fingerprints)."""
+        if self._native is not None:
+            return self._native.add_and_query(fp)
+        matches = self.query(fp)
+        return self.add(fp), matches
+
+
+def near_duplicate_groups(
+    texts: Sequence[str],
+    max_distance: int = DEFAULT_MAX_DISTANCE,
+    kind: str = "word",
+    shingle_size: int = DEFAULT_SHINGLE_SIZE,
+) -> List[List[int]]:
+    """Group texts whose fingerprints are within max_distance bits (transitively).
+
+    Returns:
+        Groups of two or more indices, ascending within a group and
+        ordered by their first index
+    """
+    fps = fingerprints(texts, kind, shingle_size)
+    if _HAS_NATIVE:
+        import numpy as np
+
+        groups = _native.simhash.near_duplicate_groups(
+            np.asarray(fps, dtype=np.uint64), max_distance
+        )
+        return [g.tolist() for g in groups]
+
+    parent = list(range(len(fps)))
+
+    def find(x: int) -> int:
+        while parent[x] != x:
+            parent[x] = parent[parent[x]]
+            x = parent[x]
+        return x
+
+    index = SimHashIndex(max_distance, use_native=False)
+    for i, fp in enumerate(fps):
+        _, matches = index.add_and_query(fp)
+        for j, _ in matches:
+            a, b = find(i), find(j)
+            if a != b:
+                parent[max(a, b)] = min(a, b)
+
+    members: Dict[int, List[int]] = {}
+    for i in range(len(fps)):
+        members.setdefault(find(i), []).append(i)
+    return [group for group in members.values() if len(group) > 1]
+
+
+def superseded_near_duplicates(
+    texts: Sequence[str],
+    max_distance: int = DEFAULT_MAX_DISTANCE,
+    min_chars: int = MIN_NEAR_DUP_CHARS,
+) -> List[int]:
+    """Indices of texts that a later text nearly duplicates.
+
+    Texts are scanned newest first against an index of the texts kept so
+    far, so of each retry chain only the last version survives. Texts
+    shorter than min_chars are never reported.
+
+    Returns:
+        Ascending indices of superseded texts
+    """
+    candidates = [i for i, text in enumerate(texts) if len(text) >= min_chars]
+    fps = fingerprints([texts[i] for i in candidates])
+    index = SimHashIndex(max_distance)
+    superseded = []
+    for i, fp in zip(reversed(candidates), reversed(fps)):
+        if index.query(fp):
+            superseded.append(i)
+        else:
+            index.add(fp)
+    return sorted(superseded)
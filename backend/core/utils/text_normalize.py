@@ -0,0 +1,77 @@
+"""Canonical text normalization for name indexes, similarity and hashing.
+
+Entity names, dedup scripts and similarity scores all compare text
+through text_key(): NFKC (full-width and compatibility forms fold to
+their plain equivalents), full Unicode case folding ("Straße" matches
+"STRASSE") and whitespace collapse. The native module runs the same
+steps from generated Unicode tables with an ASCII fast path; the Python
+fallback uses unicodedata and gives identical results when both use the
+same Unicode version.
+"""
+
+import unicodedata
+from typing import List, Sequence
+
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE = hasattr(_native, "unicode")
+except ImportError:
+    _native = None
+    _HAS_NATIVE = False
+
+# Below this many texts the per-call overhead outweighs the parallel batch
+_NATIVE_BATCH_MIN = 64
+
+
+def normalize_text(
+    text: str,
+    collapse_whitespace: bool = False,
+    casefold: bool = False,
+    max_chars: int = 0,
+    nfkc: bool = False,
+) -> str:
+    """Normalize text the way the native hasher does.
+
+    Steps run in the order nfkc, casefold, collapse_whitespace, max_chars.
+
+    Args:
+        text: Input text
+        collapse_whitespace: Trim and collapse whitespace runs to one space
+        casefold: Full Unicode case folding (str.casefold)
+        max_chars: Keep at most this many characters (0 = all)
+        nfkc: Apply NFKC normalization first
+
+    Returns:
+        Normalized text
+    """
+    if nfkc and not text.isascii():
+        text = unicodedata.normalize("NFKC", text)
+    if casefold:
+        text = text.casefold()
+    if collapse_whitespace:
+        text = " ".join(text.split())
+    if max_chars:
+        text = text[:max_chars]
+    return text
+
+
+def text_key(text: str, max_chars: int = 0) -> str:
+    """Comparison key: NFKC, case folded, whitespace collapsed.
+
+    Args:
+        text: Name or text to compare
+        max_chars: Keep at most this many characters of the key (0 = all)
+
+    Returns:
+        Key text; two inputs are "the same name" when their keys are equal
+    """
+    if _HAS_NATIVE:
+        return _native.unicode.normalize(text, max_chars=max_chars)
+    return normalize_text(text, True, True, max_chars, nfkc=True)
+
+
+def text_keys(texts: Sequence[str], max_chars: int = 0) -> List[str]:
+    """text_key() for each text, batched through the native module."""
+    if _HAS_NATIVE and len(texts) >= _NATIVE_BATCH_MIN:
+        return _native.unicode.normalize_batch(list(texts), max_chars=max_chars)
+    return [text_key(text, max_chars) for text in texts]
@@ -1,22 +1,34 @@
 """M0 Event Buffer — in-memory asyncio-compatible event stream.
 
-Session-lifetime buffer using deque with maxsize.
-Queue full → oldest event dropped (deque maxlen behavior).
+Session-lifetime buffer with maxsize.
+Queue full → oldest event dropped.
 No persistence needed (session-scoped).
+
+When the native module is available events live in a native ring
+(fixed-size records, JSON metadata in a per-slot side arena, per-type
+index); otherwise a deque with maxlen is used. Both behave the same.
 """
 
+import json
 import uuid
 from collections import deque
 from dataclasses import dataclass, field
 from datetime import datetime
 from enum import Enum
-from typing import Any, Callable, Coroutine, Dict, List
+from typing import Any, Callable, Coroutine, Dict, List, Optional, Tuple
 
 from backend.core.logging import get_logger
-from backend.core.utils.timezone import now_vancouver
+from backend.core.utils.timezone import VANCOUVER_TZ, now_vancouver
 
 _log = get_logger("memory.event_buffer")
 
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE = hasattr(_native, "events")
+except ImportError:
+    _native = None
+    _HAS_NATIVE = False
+
 
 class EventType(str, Enum):
     MESSAGE_RECEIVED = "message_received"
@@ -27,6 +39,15 @@ class EventType(str, Enum):
     TOOL_EXECUTED = "tool_executed"
 
 
+# Native ring type index <-> EventType
+_TYPES: List[EventType] = list(EventType)
+_TYPE_INDEX: Dict[EventType, int] = {t: i for i, t in enumerate(_TYPES)}
+
+# Native record limits (see event_ring.hpp)
+_MAX_EVENT_ID_BYTES = 23
+_METADATA_BYTES = 512
+
+
 @dataclass
 class StreamEvent:
     event_id: str = field(default_factory=lambda: str(uuid.uuid4())[:8])
@@ -38,22 +59,43 @@ class StreamEvent:
 class EventBuffer:
     """Session-lifetime event buffer (M0 layer).
 
-    In-memory buffer using deque with maxsize.
-    Queue full → oldest event dropped by deque.
+    Bounded buffer with maxsize; when full the oldest event is dropped.
+    Handlers receive every event exactly once, in push order: dispatch()
+    pushes and then delivers everything pending, dispatch_pending()
+    delivers events added with push() in one batch.
     No persistence needed (session-scoped).
     """
 
     DEFAULT_MAXSIZE = 1000
 
-    def __init__(self, maxsize: int = DEFAULT_MAXSIZE):
-        self._buffer: deque[StreamEvent] = deque(maxlen=maxsize)
+    def __init__(self, maxsize: int = DEFAULT_MAXSIZE, use_native: Optional[bool] = None):
         self._maxsize = maxsize
+        self._handlers: List[Callable[[StreamEvent], Coroutine]] = []
+        self._handler_cursor = 0
+
+        if use_native is None:
+            use_native = _HAS_NATIVE
+        self._ring = (
+            _native.events.EventRing(maxsize, len(_TYPES), _METADATA_BYTES)
+            if use_native and _HAS_NATIVE else None
+        )
+        # Events the ring cannot hold losslessly, by sequence number
+        self._spill: Dict[int, StreamEvent] = {}
+
+        self._buffer: deque[StreamEvent] = deque(maxlen=maxsize)
         self._total_pushed = 0
         self._total_dropped = 0
-        self._handlers: List[Callable[[StreamEvent], Coroutine]] = []
+        self._cleared_upto = 0
+
+    @property
+    def is_native(self) -> bool:
+        return self._ring is not None
 
     def push(self, event: StreamEvent) -> None:
-        """Push event. If full, oldest is automatically dropped by deque."""
+        """Push event. If full, oldest is dropped."""
+        if self._ring is not None:
+            self._push_native(event)
+            return
         was_full = len(self._buffer) >= self._maxsize
         self._buffer.append(event)
         self._total_pushed += 1
@@ -65,6 +107,8 @@ class EventBuffer:
         """Get most recent N events."""
         if n <= 0:
             return []
+        if self._ring is not None:
+            return [self._from_record(r) for r in self._ring.recent(n)]
         # PERF-039: Direct slice without full list conversion
         buf_len = len(self._buffer)
         if n >= buf_len:
@@ -73,31 +117,140 @@ class EventBuffer:
         return [self._buffer[i] for i in range(buf_len - n, buf_len)]
 
     def get_by_type(self, event_type: EventType, limit: int = 10) -> List[StreamEvent]:
-        """Get recent events of specific type."""
+        """Get recent events of specific type (most recent first)."""
+        if limit <= 0:
+            return []
+        if self._ring is not None:
+            records = self._ring.by_type(_TYPE_INDEX[event_type], limit)
+            return [self._from_record(r) for r in records]
         return [e for e in reversed(self._buffer) if e.type == event_type][:limit]
 
+    def drain(self, cursor: int, max_events: int = 1024) -> Tuple[List[StreamEvent], int, int]:
+        """Events pushed at or after sequence number `cursor`, oldest first.
+
+        Args:
+            cursor: 0 for everything still buffered, or a previous next_cursor
+            max_events: Batch size cap
+
+        Returns:
+            (events, next_cursor, missed) where missed counts events that
+            were dropped from the buffer before they could be drained
+        """
+        if self._ring is not None:
+            records, next_cursor, missed = self._ring.drain(cursor, max_events)
+            return [self._from_record(r) for r in records], next_cursor, missed
+
+        first = self._total_pushed - len(self._buffer)
+        missed = max(0, first - max(cursor, self._cleared_upto))
+        start = max(cursor, first)
+        end = min(self._total_pushed, start + max_events)
+        events = [self._buffer[seq - first] for seq in range(start, end)]
+        return events, max(end, start), missed
+
     def register_handler(self, handler: Callable[[StreamEvent], Coroutine]) -> None:
         """Register async event handler for consume pattern."""
         self._handlers.append(handler)
 
     async def dispatch(self, event: StreamEvent) -> None:
-        """Push event and dispatch to all registered handlers."""
+        """Push event and dispatch everything pending to registered handlers."""
         self.push(event)
-        for handler in self._handlers:
-            try:
-                await handler(event)
-            except Exception as e:
-                _log.warning("Event handler failed", type=event.type.value, error=str(e))
+        await self.dispatch_pending()
+
+    async def dispatch_pending(self, max_events: int = 1024) -> int:
+        """Deliver events pushed since the last dispatch to every handler.
+
+        Returns:
+            Number of events delivered
+        """
+        if not self._handlers:
+            self._handler_cursor = self._head()
+            return 0
+        delivered = 0
+        while True:
+            events, next_cursor, missed = self.drain(self._handler_cursor, max_events)
+            self._handler_cursor = next_cursor
+            if missed:
+                _log.warning("Event handlers fell behind", missed=missed)
+            for event in events:
+                for handler in self._handlers:
+                    try:
+                        await handler(event)
+                    except Exception as e:
+                        _log.warning("Event handler failed", type=event.type.value, error=str(e))
+            delivered += len(events)
+            if len(events) < max_events:
+                return delivered
 
     def clear(self) -> None:
         """Clear all events (session end)."""
+        if self._ring is not None:
+            self._ring.clear()
+            self._spill.clear()
+            return
         self._buffer.clear()
+        self._cleared_upto = self._total_pushed
 
     @property
     def stats(self) -> Dict[str, int]:
+        if self._ring is not None:
+            s = self._ring.stats()
+            return {
+                "current_size": s["size"],
+                "total_pushed": s["pushed"],
+                "total_dropped": s["dropped"],
+                "maxsize": self._maxsize,
+            }
         return {
             "current_size": len(self._buffer),
             "total_pushed": self._total_pushed,
             "total_dropped": self._total_dropped,
             "maxsize": self._maxsize,
         }
+
+    # ── native ring ──
+
+    def _head(self) -> int:
+        return self._ring.head if self._ring is not None else self._total_pushed
+
+    def _push_native(self, event: StreamEvent) -> None:
+        ts = event.timestamp
+        metadata = ""
+        # Records come back in VANCOUVER_TZ, so only that tzinfo round-trips
+        lossless = ts.tzinfo == VANCOUVER_TZ and len(event.event_id.encode()) <= _MAX_EVENT_ID_BYTES
+        if event.metadata and lossless:
+            try:
+                metadata = json.dumps(event.metadata, ensure_ascii=False)
+            except (TypeError, ValueError):
+                lossless = False
+            else:
+                # JSON turns int keys into str and tuples into lists
+                lossless = (len(metadata.encode()) <= _METADATA_BYTES
+                            and json.loads(metadata) == event.metadata)
+        if not lossless:
+            metadata = ""
+
+        seq = self._ring.push(_TYPE_INDEX[event.type], event.event_id, ts.timestamp(), metadata)
+        if not lossless:
+            self._spill[seq] = event
+        if self._spill:
+            self._prune_spill(seq)
+        _log.debug("Event pushed", type=event.type.value, seq=seq)
+
+    def _prune_spill(self, seq: int) -> None:
+        # Spilled events leave with their ring slot
+        if len(self._spill) > self._maxsize:
+            oldest = seq - self._maxsize
+            for key in [k for k in self._spill if k <= oldest]:
+                del self._spill[key]
+
+    def _from_record(self, record: tuple) -> StreamEvent:
+        seq, type_index, timestamp, event_id, metadata = record
+        spilled = self._spill.get(seq)
+        if spilled is not None:
+            return spilled
+        return StreamEvent(
+            event_id=event_id,
+            type=_TYPES[type_index],
+            timestamp=datetime.fromtimestamp(timestamp, tz=VANCOUVER_TZ),
+            metadata=json.loads(metadata) if metadata else {},
+        )
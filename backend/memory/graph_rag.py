@@ -391,7 +391,7 @@ class KnowledgeGraph:
             # Convert back to string IDs, exclude start node
             return {
                 self._idx_to_node[idx]
-                for idx in visited_indices
+                for idx in visited_indices.tolist()
                 if idx in self._idx_to_node and idx != start_idx
             }
 
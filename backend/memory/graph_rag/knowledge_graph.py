@@ -6,6 +6,7 @@ from dataclasses import dataclass, field
 from typing import Dict, List, Optional, Set, Any
 
 from backend.config import KNOWLEDGE_GRAPH_PATH
+from backend.core.utils.text_normalize import normalize_text, text_key, text_keys
 from backend.core.utils.timezone import now_vancouver
 
 from .utils import (
@@ -61,7 +62,7 @@ class KnowledgeGraph:
         self.persist_path = persist_path if persist_path else str(KNOWLEDGE_GRAPH_PATH)
 
         # PERF-008: O(1) name→entity_id index for dedup
-        self._name_index: Dict[str, str] = {}  # normalized_lower_name → entity_id
+        self._name_index: Dict[str, str] = {}  # text_key(name) → entity_id
 
         # PERF-008: O(1) entity_id→[Relation] index for relation lookups
         self._relation_index: Dict[str, List[Relation]] = defaultdict(list)
@@ -100,11 +101,11 @@ class KnowledgeGraph:
         )
 
     def _normalize_entity_name(self, name: str) -> str:
-        """Normalize entity name: collapse whitespace, strip."""
-        return " ".join(name.strip().split())
+        """Normalize entity name for display: NFKC, collapse whitespace, strip."""
+        return normalize_text(name, collapse_whitespace=True, nfkc=True)
 
     def _deduplicate_entity(self, entity: Entity) -> Optional[str]:
-        """Check for existing entity with same lowercase name.
+        """Check for existing entity with the same name key (see text_key).
 
         Returns existing entity_id if duplicate found, None otherwise.
         If duplicate: prefers non-CONCEPT type, merges mentions.
@@ -123,7 +124,7 @@ class KnowledgeGraph:
                 return existing_id
             return None
 
-        normalized = self._normalize_entity_name(entity.name).lower()
+        normalized = text_key(entity.name)
         # PERF-008: O(1) lookup via name index instead of O(n) scan
         existing_id = self._name_index.get(normalized)
         if existing_id is not None and existing_id in self.entities:
@@ -143,7 +144,7 @@ class KnowledgeGraph:
         """Add or update an entity in the graph."""
         # Stopword filter for CONCEPT type
         normalized_name = self._normalize_entity_name(entity.name)
-        if entity.entity_type == "concept" and normalized_name.lower() in ENTITY_STOPWORDS:
+        if entity.entity_type == "concept" and text_key(normalized_name) in ENTITY_STOPWORDS:
             _log.debug("Stopword entity filtered", name=entity.name)
             return ""
 
@@ -175,7 +176,7 @@ class KnowledgeGraph:
             entity.last_accessed = entity.created_at
             self.entities[entity.id] = entity
             # PERF-008: Update name index for O(1) dedup
-            self._name_index[self._normalize_entity_name(entity.name).lower()] = entity.id
+            self._name_index[text_key(entity.name)] = entity.id
             self._native_index_dirty = True
 
         return entity.id
@@ -244,36 +245,29 @@ class KnowledgeGraph:
         return self.entities.get(entity_id)
 
     def find_entities_by_name(self, name: str) -> List[Entity]:
-        """Find entities by partial name match (case-insensitive)."""
+        """Find entities by partial name match (case- and width-insensitive)."""
         if self._pg:
             rows = self._pg.find_entities_by_name(name)
             return [self._pg_row_to_entity(r) for r in rows]
-        name_lower = name.lower()
-        return [
-            e for e in self.entities.values()
-            if name_lower in e.name.lower()
-        ]
+        return self.find_entities_by_names_batch([name])[name]
 
     def find_entities_by_names_batch(self, names: List[str]) -> Dict[str, List[Entity]]:
         """PERF-042: Batch version of find_entities_by_name."""
         if self._pg:
             rows = self._pg.find_entities_by_names_batch(names)
             result: dict[str, list[Entity]] = {name: [] for name in names}
-            for row in rows:
-                entity = self._pg_row_to_entity(row)
-                # Match to original name(s)
-                for name in names:
-                    if name.lower() in entity.name.lower():
-                        result[name].append(entity)
+            entities = [self._pg_row_to_entity(row) for row in rows]
+            entity_keys = text_keys([e.name for e in entities])
+            # Match to original name(s)
+            for name, key in zip(names, text_keys(names)):
+                result[name] = [e for e, ek in zip(entities, entity_keys) if key in ek]
             return result
         # In-memory fallback
         result = {name: [] for name in names}
-        for name in names:
-            name_lower = name.lower()
-            result[name] = [
-                e for e in self.entities.values()
-                if name_lower in e.name.lower()
-            ]
+        entities = list(self.entities.values())
+        entity_keys = text_keys([e.name for e in entities])
+        for name, key in zip(names, text_keys(names)):
+            result[name] = [e for e, ek in zip(entities, entity_keys) if key in ek]
         return result
 
     def find_entities_by_type(self, entity_type: str) -> List[Entity]:
@@ -343,7 +337,7 @@ class KnowledgeGraph:
             # Convert back to string IDs, exclude start node
             return {
                 self._idx_to_node[idx]
-                for idx in visited_indices
+                for idx in visited_indices.tolist()
                 if idx in self._idx_to_node and idx != start_idx
             }
 
@@ -583,6 +577,8 @@ class KnowledgeGraph:
 
             for k, v in data.get("entities", {}).items():
                 self.entities[k] = Entity(**v)
+            names = [e.name for e in self.entities.values()]
+            self._name_index = dict(zip(text_keys(names), self.entities.keys()))
 
             for k, v in data.get("relations", {}).items():
                 rel = Relation(**v)
@@ -5,6 +5,7 @@ import json
 from typing import Dict, List, Optional, Tuple, Any
 
 from backend.config import MEMORY_EXTRACTION_TIMEOUT
+from backend.core.utils.text_normalize import text_key
 
 from .utils import _log, _HAS_SPACY, _nlp
 from .knowledge_graph import Entity, Relation
@@ -63,9 +64,10 @@ class RelationshipExtractor:
         seen_names = set()
         for ent in doc.ents:
             name = ent.text.strip()
-            if not name or name.lower() in seen_names:
+            key = text_key(name)
+            if not key or key in seen_names:
                 continue
-            seen_names.add(name.lower())
+            seen_names.add(key)
             entity = {
                 "name": name,
                 "type": self._map_ner_type(ent.label_),
@@ -80,11 +82,11 @@ class RelationshipExtractor:
     def _merge_ner_llm(
         self, ner_entities: List[dict], llm_entities: List[dict]
     ) -> List[dict]:
-        """Merge NER and LLM entities. LLM overrides NER on name match."""
-        llm_name_map = {e["name"].lower(): e for e in llm_entities}
+        """Merge NER and LLM entities. LLM overrides NER on name match (see text_key)."""
+        llm_name_map = {text_key(e["name"]): e for e in llm_entities}
         merged = list(llm_entities)  # LLM entities take priority
         for ner_e in ner_entities:
-            if ner_e["name"].lower() not in llm_name_map:
+            if text_key(ner_e["name"]) not in llm_name_map:
                 merged.append(ner_e)
         return merged
 
@@ -4,13 +4,28 @@ Tracks query-memory access patterns for:
 - Hot memory detection (most frequently accessed)
 - Channel diversity counting (for T-02 decay integration)
 - Prefetch candidate identification
+
+Counts are exact Python counters by default. With use_native=True they
+live in a native heavy-hitter sketch instead (space-saving top-k over a
+count-min sketch, HyperLogLog channel counts per tracked memory), so
+memory stays fixed however many memories are accessed. That mode is
+lossy: a memory outside the top `capacity` keeps only its count-min
+estimate, so its channel mentions drop to a lower bound of 1.
 """
 
 import json
+import time
 from collections import Counter, defaultdict, deque
 from datetime import timedelta
 from typing import Any, Dict, List, Optional, Set
 
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE = hasattr(_native, "sketch")
+except ImportError:
+    _native = None
+    _HAS_NATIVE = False
+
 from backend.core.logging import get_logger
 from backend.core.utils.timezone import now_vancouver
 
@@ -18,9 +33,22 @@ _log = get_logger("memory.meta")
 
 
 class MetaMemory:
-    """Track query-memory access patterns for hot memory detection and channel diversity."""
+    """Track query-memory access patterns for hot memory detection and channel diversity.
+
+    Access counts optionally decay with a half-life, so hot memories
+    reflect recent use; by default they never decay.
+    """
 
-    def __init__(self, conn_mgr=None, pg_repository=None):
+    DEFAULT_CAPACITY = 4096
+
+    def __init__(
+        self,
+        conn_mgr=None,
+        pg_repository=None,
+        capacity: int = DEFAULT_CAPACITY,
+        half_life_hours: Optional[float] = None,
+        use_native: bool = False,
+    ):
         """Initialize MetaMemory.
 
         Args:
@@ -28,14 +56,32 @@ class MetaMemory:
                       If None, operates in memory-only mode.
             pg_repository: Optional PgMetaMemoryRepository. When provided,
                           PostgreSQL is used for persistence.
+            capacity: Memories tracked exactly by the native sketch
+            half_life_hours: Access count half-life; None disables decay
+            use_native: Opt in to the bounded, lossy native sketch (ignored
+                        when the native module is unavailable)
         """
         self._conn_mgr = conn_mgr
         self._pg = pg_repository
-        # In-memory tracking (write-behind cache)
+        self._half_life = half_life_hours * 3600.0 if half_life_hours else 0.0
+
+        self._sketch = (
+            _native.sketch.AccessSketch(capacity, half_life_seconds=self._half_life)
+            if use_native and _HAS_NATIVE else None
+        )
+
+        # In-memory tracking (write-behind cache), used without the native sketch.
+        # Counts are forward-decayed: scaled by 2^((t - landmark) / half_life).
         self._memory_access: Counter = Counter()  # memory_id -> access_count
         self._memory_channels: defaultdict[str, Set[str]] = defaultdict(set)  # memory_id -> {channel_ids}
+        self._landmark: Optional[float] = None
+        self._all_channels: Set[str] = set()
         self._patterns: deque = deque(maxlen=10000)  # PERF-039: Bounded deque instead of unbounded list
 
+    @property
+    def is_native(self) -> bool:
+        return self._sketch is not None
+
     def record_access(
         self,
         query_text: str,
@@ -51,9 +97,16 @@ class MetaMemory:
             relevance_scores: Optional relevance scores for each match
             channel_id: Channel where the access occurred
         """
-        for mem_id in matched_memory_ids:
-            self._memory_access[mem_id] += 1
-            self._memory_channels[mem_id].add(channel_id)
+        now = time.time()
+        if self._sketch is not None:
+            self._sketch.record(list(matched_memory_ids), channel_id, now)
+        else:
+            weight = self._weight(now)
+            for mem_id in matched_memory_ids:
+                self._memory_access[mem_id] += weight
+                self._memory_channels[mem_id].add(channel_id)
+            if matched_memory_ids:
+                self._all_channels.add(channel_id)
 
         pattern = {
             "query_text": query_text[:200],
@@ -83,12 +136,26 @@ class MetaMemory:
 
         Returns:
             List of dicts with memory_id, access_count, channel_diversity
+            (access_count is the decayed count rounded to an integer)
         """
+        if limit <= 0:
+            return []
+        now = time.time()
+        if self._sketch is not None:
+            return [
+                {
+                    "memory_id": mid,
+                    "access_count": round(count),
+                    "channel_diversity": channels,
+                }
+                for mid, count, _error, channels in self._sketch.top(limit, now)
+            ]
+        scale = self._scale(now)
         hot = self._memory_access.most_common(limit)
         return [
             {
                 "memory_id": mid,
-                "access_count": count,
+                "access_count": round(count / scale),
                 "channel_diversity": len(self._memory_channels.get(mid, set())),
             }
             for mid, count in hot
@@ -103,8 +170,33 @@ class MetaMemory:
         Returns:
             Number of distinct channels
         """
+        if self._sketch is not None:
+            return self.get_channel_mentions_batch([memory_id])[0]
         return len(self._memory_channels.get(memory_id, set()))
 
+    def get_channel_mentions_batch(self, memory_ids: List[str]) -> List[int]:
+        """Distinct channel counts for many memories, in order.
+
+        Feeds the decay batch a channel_mentions column in one native call.
+
+        Args:
+            memory_ids: Memory document IDs
+
+        Returns:
+            Number of distinct channels per ID. With the native sketch, an
+            ID that is not tracked (never seen, or evicted) but has a
+            count-min estimate reports 1: it was accessed from at least
+            one channel, and 0 would drop its channel-diversity boost.
+        """
+        if self._sketch is not None:
+            ids = list(memory_ids)
+            counts = self._sketch.channel_counts(ids).tolist()
+            if 0 in counts:
+                estimates = self._sketch.estimates(ids, time.time()).tolist()
+                counts = [c if c or e <= 0.0 else 1 for c, e in zip(counts, estimates)]
+            return counts
+        return [len(self._memory_channels.get(mid, ())) for mid in memory_ids]
+
     def prune_old_patterns(self, older_than_days: int = 30) -> int:
         """Remove patterns older than specified days.
 
@@ -156,15 +248,39 @@ class MetaMemory:
         except Exception as e:
             _log.warning("Pattern persist failed", error=str(e))
 
+    def _weight(self, now: float) -> float:
+        """Forward-decay weight of an access at `now` (1.0 without decay)."""
+        if not self._half_life:
+            return 1.0
+        if self._landmark is None:
+            self._landmark = now
+        exponent = (now - self._landmark) / self._half_life
+        if exponent > 64:
+            # Rescale stored counts before the weights overflow
+            factor = 2.0 ** -exponent
+            for mid in self._memory_access:
+                self._memory_access[mid] *= factor
+            self._landmark = now
+            exponent = 0.0
+        return 2.0 ** exponent
+
+    def _scale(self, now: float) -> float:
+        if not self._half_life or self._landmark is None:
+            return 1.0
+        return 2.0 ** min((now - self._landmark) / self._half_life, 1000.0)
+
     @property
     def stats(self) -> Dict[str, int]:
         """Get meta memory statistics."""
+        if self._sketch is not None:
+            s = self._sketch.stats()
+            return {
+                "tracked_memories": s["tracked"],
+                "total_patterns": len(self._patterns),
+                "unique_channels": s["distinct_channels"],
+            }
         return {
             "tracked_memories": len(self._memory_access),
             "total_patterns": len(self._patterns),
-            "unique_channels": len(
-                set().union(*(channels for channels in self._memory_channels.values()))
-                if self._memory_channels
-                else set()
-            ),
+            "unique_channels": len(self._all_channels),
         }
@@ -36,7 +36,7 @@ from .promotion import PromotionCriteria
 from .access_tracker import AccessTracker
 from .retrieval import MemoryRetriever
 from .importance import calculate_importance_async, calculate_importance_sync
-from .migrator import LegacyMemoryMigrator
+from .migrator import EmbeddingSpaceMigrator, LegacyMemoryMigrator
 from typing import Optional
 
 __all__ = [
@@ -66,6 +66,7 @@ __all__ = [
     "apply_adaptive_decay",
     # Migration
     "LegacyMemoryMigrator",
+    "EmbeddingSpaceMigrator",
 ]
 
 # PERF-039: Module-level singleton to avoid re-instantiation
@@ -1,10 +1,23 @@
-"""Access tracking and batch update management."""
+"""Access tracking and batch update management.
+
+Repeated accesses to one memory between flushes are coalesced into a
+single row (count, last access time, channel bits). With the native
+module the accumulator is a sharded lock-free table; otherwise a dict.
+"""
 
 import time
-from typing import Set
+from datetime import datetime
+from typing import Dict, List, Optional, Tuple
 
 from backend.core.logging import get_logger
-from backend.core.utils.timezone import now_vancouver
+from backend.core.utils.timezone import VANCOUVER_TZ
+
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE = hasattr(_native, "access")
+except ImportError:
+    _native = None
+    _HAS_NATIVE = False
 
 from .config import MemoryConfig
 from .protocols import MemoryRepositoryProtocol
@@ -16,14 +29,19 @@ class AccessTracker:
     """Tracks memory access and manages batch updates.
     
     Accumulates access updates in memory and flushes them to storage
-    based on count threshold or time interval.
+    based on count threshold or time interval. A flush writes every
+    accessed memory with one batch_update_metadata call.
     """
 
+    # Channel bits available per memory; later channels share the last bit
+    MAX_CHANNEL_BITS = 64
+
     def __init__(
         self,
         repository: MemoryRepositoryProtocol,
         flush_threshold: int = MemoryConfig.FLUSH_THRESHOLD,
         flush_interval: int = MemoryConfig.FLUSH_INTERVAL_SECONDS,
+        use_native: Optional[bool] = None,
     ):
         """Initialize access tracker.
         
@@ -31,36 +49,61 @@ class AccessTracker:
             repository: Repository for persisting access updates
             flush_threshold: Number of pending updates to trigger auto-flush
             flush_interval: Seconds between auto-flushes
+            use_native: Force the native accumulator on/off (default: if available)
         """
         self._repository = repository
         self._flush_threshold = flush_threshold
         self._flush_interval = flush_interval
-        
-        self._pending_access_updates: Set[str] = set()
+
+        if use_native is None:
+            use_native = _HAS_NATIVE
+        self._accumulator = (
+            _native.access.AccessAccumulator() if use_native and _HAS_NATIVE else None
+        )
+        # doc_id -> [count, last_ts, channel_mask], used without the native accumulator
+        self._pending_access_updates: Dict[str, list] = {}
+        self._channel_bits: Dict[str, int] = {}
         self._last_flush_time: float = time.time()
 
-    def track_access(self, doc_id: str) -> None:
+    @property
+    def is_native(self) -> bool:
+        return self._accumulator is not None
+
+    def track_access(self, doc_id: str, channel_id: Optional[str] = None) -> None:
         """Track memory access.
         
         Args:
             doc_id: Document ID that was accessed
+            channel_id: Optional channel the access came from
         """
-        self._pending_access_updates.add(doc_id)
+        now = time.time()
+        mask = self._channel_mask(channel_id) if channel_id else 0
+        if self._accumulator is not None:
+            self._accumulator.track(doc_id, now, mask)
+            return
+        entry = self._pending_access_updates.get(doc_id)
+        if entry is None:
+            self._pending_access_updates[doc_id] = [1, now, mask]
+        else:
+            entry[0] += 1
+            entry[1] = max(entry[1], now)
+            entry[2] |= mask
 
     def maybe_flush(self) -> None:
         """Check if access updates should be flushed and flush if needed."""
         should_flush = False
 
-        if len(self._pending_access_updates) >= self._flush_threshold:
+        pending = self.pending_count
+        if pending >= self._flush_threshold:
             should_flush = True
             _log.debug(
                 "Auto-flush triggered (threshold)",
-                pending=len(self._pending_access_updates),
+                pending=pending,
                 threshold=self._flush_threshold,
             )
 
         elapsed = time.time() - self._last_flush_time
-        if elapsed >= self._flush_interval and self._pending_access_updates:
+        if elapsed >= self._flush_interval and pending:
             should_flush = True
             _log.debug(
                 "Auto-flush triggered (interval)",
@@ -77,17 +120,16 @@ class AccessTracker:
         Returns:
             Number of successfully updated memories
         """
-        if not self._pending_access_updates:
+        ids_to_update, counts, last_ts, _channels = self.drain()
+        if not ids_to_update:
             return 0
-
-        ids_to_update = list(self._pending_access_updates)
-        self._pending_access_updates.clear()
         self._last_flush_time = time.time()
 
-        now = now_vancouver().isoformat()
-
-        # Batch update (PERF-019)
-        metadatas = [{"last_accessed": now} for _ in ids_to_update]
+        # Batch update (PERF-019): one call for every coalesced memory
+        metadatas = [
+            {"last_accessed": datetime.fromtimestamp(ts, tz=VANCOUVER_TZ).isoformat()}
+            for ts in last_ts
+        ]
         updated = self._repository.batch_update_metadata(ids_to_update, metadatas)
 
         if updated < len(ids_to_update):
@@ -98,15 +140,53 @@ class AccessTracker:
             )
 
         if updated > 0:
-            _log.debug("MEM flush", count=updated)
+            _log.debug("MEM flush", count=updated, accesses=sum(counts))
 
         return updated
 
+    def drain(self) -> Tuple[List[str], List[int], List[float], List[int]]:
+        """Take all pending accesses as columns.
+
+        Returns:
+            (doc_ids, access counts, last access epoch seconds, channel
+            bitmasks), one row per memory accessed since the last drain
+        """
+        if self._accumulator is not None:
+            cols = self._accumulator.drain()
+            return (
+                cols["ids"],
+                cols["count"].tolist(),
+                cols["last_ts"].tolist(),
+                cols["channels"].tolist(),
+            )
+        pending = self._pending_access_updates
+        self._pending_access_updates = {}
+        ids = list(pending)
+        return (
+            ids,
+            [pending[i][0] for i in ids],
+            [pending[i][1] for i in ids],
+            [pending[i][2] for i in ids],
+        )
+
+    def channel_bit(self, channel_id: str) -> int:
+        """Bit index assigned to a channel in the drained bitmasks."""
+        bit = self._channel_bits.get(channel_id)
+        if bit is None:
+            bit = min(len(self._channel_bits), self.MAX_CHANNEL_BITS - 1)
+            self._channel_bits[channel_id] = bit
+        return bit
+
+    def _channel_mask(self, channel_id: str) -> int:
+        return 1 << self.channel_bit(channel_id)
+
     @property
     def pending_count(self) -> int:
-        """Get number of pending access updates."""
+        """Get number of memories with pending access updates."""
+        if self._accumulator is not None:
+            return self._accumulator.pending
         return len(self._pending_access_updates)
 
     def clear_pending(self) -> None:
         """Clear all pending updates without flushing."""
-        self._pending_access_updates.clear()
+        self.drain()
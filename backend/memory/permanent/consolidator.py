@@ -1,7 +1,8 @@
 """Memory consolidation service."""
 
+import time
 from datetime import datetime, timezone
-from typing import Dict, List
+from typing import Dict, List, Optional
 
 from backend.core.logging import get_logger
 from .config import MemoryConfig
@@ -66,9 +67,10 @@ class MemoryConsolidator:
         from .dynamic_decay import DYNAMIC_DECAY_ENABLED
 
         if DYNAMIC_DECAY_ENABLED:
+            from backend.config import INTERACTION_LOG_DIR
             from .dynamic_decay import calculate_dynamic_config, collect_behavior_metrics
 
-            metrics = collect_behavior_metrics(self._conn_mgr)
+            metrics = collect_behavior_metrics(self._conn_mgr, log_dir=INTERACTION_LOG_DIR)
             dynamic_config = calculate_dynamic_config(metrics)
             self.decay_calculator.config.BASE_DECAY_RATE = dynamic_config["base_rate"]
             self.decay_calculator.peak_hours = metrics.peak_hours
@@ -179,9 +181,91 @@ class MemoryConsolidator:
         except ImportError:
             shared_graph = None
 
+        decayed_values = self._decay_from_columns(batch_data, shared_graph)
+        if decayed_values is None:
+            decayed_values = self._decay_from_metadata(batch_data, shared_graph)
+
+        # Determine deletions
+        to_delete = []
+        for (_, doc_id, metadata), decayed_importance in zip(batch_data, decayed_values):
+            repetitions = metadata.get("repetitions", 1)
+            access_count = metadata.get("access_count", 0)
+
+            if (
+                decayed_importance < self.config.DECAY_DELETE_THRESHOLD
+                and repetitions < 2
+                and access_count < 3
+            ):
+                to_delete.append(doc_id)
+
+        return to_delete, decayed_values
+
+    def _decay_from_columns(self, batch_data: List[tuple], shared_graph) -> Optional[List[float]]:
+        """Decayed importance from the repository's binary COPY stream.
+
+        Decay inputs come straight from ``pgcopy.MemoryColumns.decay_records()``
+        batch by batch, with no per-row dicts or ISO timestamp parsing.
+        Rows the stream did not return (e.g. inserted since get_all())
+        go through the metadata path.
+
+        Returns:
+            Decayed importance per batch item, or None when the repository
+            cannot stream columns (no PostgreSQL or no native loader)
+        """
+        stream = getattr(self.repository, "stream_columns", None)
+        if stream is None or not is_native_available():
+            return None
+
+        import numpy as np
+
+        positions = {doc_id: pos for pos, (_, doc_id, _) in enumerate(batch_data)}
+        decayed: List[Optional[float]] = [None] * len(batch_data)
+        now = time.time()
+
+        def on_batch(columns) -> None:
+            ids = columns.ids
+            connections = np.fromiter(
+                (get_connection_count(doc_id, graph=shared_graph) if doc_id in positions else 0
+                 for doc_id in ids),
+                dtype=np.int32, count=len(ids),
+            )
+            mentions = (
+                np.asarray(self._meta_memory.get_channel_mentions_batch(ids), dtype=np.int32)
+                if self._meta_memory
+                else None
+            )
+            records = columns.decay_records(now, connection_count=connections, channel_mentions=mentions)
+            for doc_id, value in zip(ids, self.decay_calculator.calculate_records(records).tolist()):
+                pos = positions.get(doc_id)
+                if pos is not None:
+                    decayed[pos] = value
+
+        try:
+            if stream(on_batch) is None:
+                return None
+        except Exception as e:
+            _log.warning("Columnar decay failed, using metadata", error=str(e))
+            return None
+
+        missing = [pos for pos, value in enumerate(decayed) if value is None]
+        if missing:
+            fallback = self._decay_from_metadata([batch_data[pos] for pos in missing], shared_graph)
+            for pos, value in zip(missing, fallback):
+                decayed[pos] = value
+        return decayed
+
+    def _decay_from_metadata(self, batch_data: List[tuple], shared_graph) -> List[float]:
+        """Decayed importance computed from get_all() metadata dicts."""
+        # Channel diversity as one column lookup for the whole batch
+        channel_mentions = (
+            self._meta_memory.get_channel_mentions_batch([doc_id for _, doc_id, _ in batch_data])
+            if self._meta_memory
+            else [0] * len(batch_data)
+        )
+
         # Prepare batch input for decay calculator
         memories_for_decay = []
-        for _, doc_id, metadata in batch_data:
+        for (_, doc_id, metadata), mentions in zip(batch_data, channel_mentions):
             created_at = metadata.get("created_at") or metadata.get("timestamp", "")
             importance = metadata.get("importance")
             if importance is None:
@@ -199,30 +283,11 @@ class MemoryConsolidator:
                 "connection_count": connection_count,
                 "last_accessed": last_accessed,
                 "memory_type": memory_type,
-                "channel_mentions": (
-                    self._meta_memory.get_channel_mentions(doc_id)
-                    if self._meta_memory
-                    else 0
-                ),
+                "channel_mentions": mentions,
             })
 
         # Batch calculate decayed importance
-        decayed_values = self.decay_calculator.calculate_batch(memories_for_decay)
-
-        # Determine deletions
-        to_delete = []
-        for (_, doc_id, metadata), decayed_importance in zip(batch_data, decayed_values):
-            repetitions = metadata.get("repetitions", 1)
-            access_count = metadata.get("access_count", 0)
-
-            if (
-                decayed_importance < self.config.DECAY_DELETE_THRESHOLD
-                and repetitions < 2
-                and access_count < 3
-            ):
-                to_delete.append(doc_id)
-
-        return to_delete, decayed_values
+        return self.decay_calculator.calculate_batch(memories_for_decay)
 
     def _get_surviving_updates(
         self,
@@ -289,16 +289,60 @@ class AdaptiveDecayCalculator:
         if not valid_data:
             return [p["importance"] if p else 0.5 for p in processed]
 
-        # Build numpy arrays
-        importance = np.array([d["importance"] for d in valid_data], dtype=np.float64)
-        hours_passed = np.array([d["hours_passed"] for d in valid_data], dtype=np.float64)
-        access_count = np.array([d["access_count"] for d in valid_data], dtype=np.int32)
-        connection_count = np.array([d["connection_count"] for d in valid_data], dtype=np.int32)
-        last_access_hours = np.array([d["last_access_hours"] for d in valid_data], dtype=np.float64)
-        memory_type = np.array([d["memory_type"] for d in valid_data], dtype=np.int32)
-        channel_mentions = np.array([d.get("channel_mentions", 0) for d in valid_data], dtype=np.int32)
+        config = self._native_config()
+
+        if hasattr(_native.decay_ops, "RECORD_DTYPE"):
+            # One packed record array instead of seven column arrays
+            records = np.array(
+                [
+                    (
+                        d["importance"],
+                        d["hours_passed"],
+                        d["last_access_hours"],
+                        d["access_count"],
+                        d["connection_count"],
+                        d["memory_type"],
+                        d.get("channel_mentions", 0),
+                    )
+                    for d in valid_data
+                ],
+                dtype=_native.decay_ops.RECORD_DTYPE,
+            )
+            results_arr = _native.decay_ops.calculate_batch_numpy(records, config)
+        else:
+            results_arr = self._calculate_columns_native(valid_data, config)
+
+        # Map results back to original indices
+        results = []
+        valid_idx = 0
+        for i, p in enumerate(processed):
+            if p is None:
+                results.append(0.5)  # Default for invalid entries
+            else:
+                results.append(float(results_arr[valid_idx]))
+                valid_idx += 1
+
+        return results
+
+    def calculate_records(self, records):
+        """Decayed importance for a packed decay_ops.RECORD_DTYPE array.
+
+        For decay inputs that are already columnar, e.g.
+        ``pgcopy.MemoryColumns.decay_records()``. Native only; like the
+        native batch path, circadian stability is not applied.
+
+        Args:
+            records: decay_ops.RECORD_DTYPE array
 
-        # Create config
+        Returns:
+            float64 array of decayed importance, one per record
+        """
+        if not _HAS_NATIVE:
+            raise RuntimeError("calculate_records needs the native decay module")
+        return _native.decay_ops.calculate_batch_numpy(records, self._native_config())
+
+    def _native_config(self):
+        """Native DecayConfig mirroring self.config."""
         config = _native.decay_ops.DecayConfig()
         config.base_decay_rate = self.config.BASE_DECAY_RATE
         config.min_retention = self.config.MIN_RETENTION
@@ -309,34 +353,35 @@ class AdaptiveDecayCalculator:
         # T-02: Set channel diversity k if native module supports it
         if hasattr(config, "channel_diversity_k"):
             config.channel_diversity_k = self.config.CHANNEL_DIVERSITY_K
+        return config
+
+    @staticmethod
+    def _calculate_columns_native(valid_data: List[dict], config):
+        """Column-array call for native modules built before RECORD_DTYPE."""
+        import numpy as np
+
+        importance = np.array([d["importance"] for d in valid_data], dtype=np.float64)
+        hours_passed = np.array([d["hours_passed"] for d in valid_data], dtype=np.float64)
+        access_count = np.array([d["access_count"] for d in valid_data], dtype=np.int32)
+        connection_count = np.array([d["connection_count"] for d in valid_data], dtype=np.int32)
+        last_access_hours = np.array([d["last_access_hours"] for d in valid_data], dtype=np.float64)
+        memory_type = np.array([d["memory_type"] for d in valid_data], dtype=np.int32)
+        channel_mentions = np.array([d.get("channel_mentions", 0) for d in valid_data], dtype=np.int32)
 
-        # Call native batch function
         try:
-            results_arr = _native.decay_ops.calculate_batch_numpy(
+            return _native.decay_ops.calculate_batch_numpy(
                 importance, hours_passed, access_count,
                 connection_count, last_access_hours, memory_type,
                 channel_mentions, config,
             )
         except TypeError:
             # Fallback: native module not yet rebuilt with channel_mentions
-            results_arr = _native.decay_ops.calculate_batch_numpy(
+            return _native.decay_ops.calculate_batch_numpy(
                 importance, hours_passed, access_count,
                 connection_count, last_access_hours, memory_type,
                 config,
             )
 
-        # Map results back to original indices
-        results = []
-        valid_idx = 0
-        for i, p in enumerate(processed):
-            if p is None:
-                results.append(0.5)  # Default for invalid entries
-            else:
-                results.append(float(results_arr[valid_idx]))
-                valid_idx += 1
-
-        return results
-
     def _calculate_batch_python(self, processed: List[Optional[dict]]) -> List[float]:
         """Batch calculation using Python (fallback)."""
         from .dynamic_decay import apply_circadian_stability
@@ -145,55 +145,106 @@ def apply_circadian_stability(
     return access_count
 
 
-def collect_behavior_metrics(conn_mgr=None) -> UserBehaviorMetrics:
+def _metrics_from_log_segments(metrics: UserBehaviorMetrics, log_dir, days: int = 7) -> bool:
+    """Fill latency, tool usage and hourly activity from native log segments.
+
+    Args:
+        metrics: Metrics to update in place
+        log_dir: Interaction log segment directory
+        days: Look-back window
+
+    Returns:
+        True if the segments held any interactions in the window
+    """
+    import time
+
+    import numpy as np
+
+    from backend.core.telemetry.interaction_log import read_interaction_columns
+    from backend.core.utils.timezone import now_vancouver
+
+    now = time.time()
+    columns = read_interaction_columns(log_dir, since=now - days * 86400)
+    if columns is None or len(columns["timestamp"]) == 0:
+        return False
+
+    latency = columns["latency_ms"]
+    latency = latency[latency >= 0]
+    if latency.size:
+        metrics.avg_latency_ms = float(latency.mean())
+    total = len(columns["timestamp"])
+    metrics.tool_usage_frequency = float(np.count_nonzero(columns["tool_call_count"])) / total * 10
+
+    # Local hour of day; one UTC offset for the whole window is close enough
+    offset = now_vancouver().utcoffset().total_seconds()
+    hour_index = ((columns["timestamp"] + offset) // 3600).astype(np.int64)
+    counts = np.bincount(hour_index % 24, minlength=24)
+    metrics.hourly_activity_rate = (counts / days).tolist()
+    metrics.daily_active_hours = float(np.unique(hour_index).size) / days
+    return True
+
+
+def collect_behavior_metrics(conn_mgr=None, log_dir=None) -> UserBehaviorMetrics:
     """Collect user behavior metrics from interaction logs.
 
     Args:
         conn_mgr: Optional SQLiteConnectionManager or PgConnectionManager.
                   If None, returns default metrics.
+        log_dir: Optional native interaction log directory. When it holds
+                 recent interactions, latency, tool usage and hourly
+                 activity come from a columnar scan of its segments.
 
     Returns:
         UserBehaviorMetrics populated from database or defaults.
     """
     metrics = UserBehaviorMetrics()
 
-    if conn_mgr is None:
+    from_segments = False
+    if log_dir is not None:
+        try:
+            from_segments = _metrics_from_log_segments(metrics, log_dir)
+        except Exception as e:
+            _log.debug("Interaction log scan failed, using database", error=str(e))
+
+    if conn_mgr is None and not from_segments:
         return metrics
 
-    try:
-        # Attempt to query interaction logs for metrics
-        rows = conn_mgr.execute_dict(
-            """
-            SELECT
-                AVG(latency_ms) AS avg_latency,
-                COUNT(CASE WHEN tool_name IS NOT NULL THEN 1 END) AS tool_calls,
-                COUNT(*) AS total_interactions
-            FROM interaction_logs
-            WHERE created_at > NOW() - INTERVAL '7 days'
-            """
-        )
-
-        if rows:
-            row = rows[0]
-            metrics.avg_latency_ms = float(row.get("avg_latency") or 1000.0)
-            total = int(row.get("total_interactions") or 0)
-            tool_calls = int(row.get("tool_calls") or 0)
-            metrics.tool_usage_frequency = tool_calls / max(total, 1) * 10
-
-        # Session duration average
-        session_rows = conn_mgr.execute_dict(
-            """
-            SELECT AVG(EXTRACT(EPOCH FROM (ended_at - started_at))) AS avg_dur
-            FROM sessions
-            WHERE ended_at IS NOT NULL
-              AND started_at > NOW() - INTERVAL '7 days'
-            """
-        )
-        if session_rows and session_rows[0].get("avg_dur"):
-            metrics.session_duration_avg = float(session_rows[0]["avg_dur"])
-
-    except Exception as e:
-        _log.debug("Behavior metrics collection failed, using defaults", error=str(e))
+    if conn_mgr is not None:
+        try:
+            if not from_segments:
+                # Attempt to query interaction logs for metrics
+                rows = conn_mgr.execute_dict(
+                    """
+                    SELECT
+                        AVG(latency_ms) AS avg_latency,
+                        COUNT(CASE WHEN tool_name IS NOT NULL THEN 1 END) AS tool_calls,
+                        COUNT(*) AS total_interactions
+                    FROM interaction_logs
+                    WHERE created_at > NOW() - INTERVAL '7 days'
+                    """
+                )
+
+                if rows:
+                    row = rows[0]
+                    metrics.avg_latency_ms = float(row.get("avg_latency") or 1000.0)
+                    total = int(row.get("total_interactions") or 0)
+                    tool_calls = int(row.get("tool_calls") or 0)
+                    metrics.tool_usage_frequency = tool_calls / max(total, 1) * 10
+
+            # Session duration average
+            session_rows = conn_mgr.execute_dict(
+                """
+                SELECT AVG(EXTRACT(EPOCH FROM (ended_at - started_at))) AS avg_dur
+                FROM sessions
+                WHERE ended_at IS NOT NULL
+                  AND started_at > NOW() - INTERVAL '7 days'
+                """
+            )
+            if session_rows and session_rows[0].get("avg_dur"):
+                metrics.session_duration_avg = float(session_rows[0]["avg_dur"])
+
+        except Exception as e:
+            _log.debug("Behavior metrics collection failed, using defaults", error=str(e))
 
     metrics.engagement_score = calculate_engagement(metrics)
     metrics.peak_hours = detect_peak_hours(metrics.hourly_activity_rate)
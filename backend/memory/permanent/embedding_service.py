@@ -1,7 +1,6 @@
 """Embedding generation service with caching."""
 
 import asyncio
-import hashlib
 import time
 from typing import Dict, List, Optional
 
@@ -10,6 +9,7 @@ from google import genai
 from backend.config import EMBEDDING_MAX_RETRIES
 from backend.core.logging import get_logger
 from backend.core.utils.circuit_breaker import EMBEDDING_CIRCUIT
+from backend.core.utils.content_hash import hash64
 from .config import MemoryConfig
 
 _log = get_logger("memory.embedding")
@@ -73,7 +73,7 @@ class EmbeddingService:
             return None
 
         # PERF-027: Use deterministic hash for cache key
-        cache_key = f"{hashlib.sha256(text[:500].encode()).hexdigest()[:16]}:{task_type}"
+        cache_key = f"{hash64(text[:500]):016x}:{task_type}"
 
         if cache_key in self._cache:
             # PERF-027: True LRU - move accessed key to end
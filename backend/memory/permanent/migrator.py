@@ -1,13 +1,22 @@
-"""Legacy memory migration utilities."""
+"""Legacy memory and embedding-model migration utilities."""
 
-from typing import Optional, Dict, Any
+import random
+from typing import Any, Callable, Dict, List, Optional, Sequence
 
 import chromadb
+import numpy as np
 
 from backend.core.logging import get_logger
 from backend.config import CHROMADB_PATH
 from .facade import PromotionCriteria
 
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE = hasattr(_native, "mapping")
+except ImportError:
+    _native = None
+    _HAS_NATIVE = False
+
 _log = get_logger("memory.migrator")
 
 
@@ -157,3 +166,291 @@ class LegacyMemoryMigrator:
             report["migrated_count"] = migrated
 
         return report
+
+
+def _as_vector(embedding: Any) -> Optional[np.ndarray]:
+    """Stored embedding as float64, parsing pgvector's '[x,y,...]' text."""
+    if embedding is None:
+        return None
+    if isinstance(embedding, str):
+        values = np.fromstring(embedding.strip().strip("[]"), sep=",")
+    else:
+        values = np.asarray(embedding, dtype=np.float64)
+    return values if values.ndim == 1 and values.size else None
+
+
+def _unit_rows(x: np.ndarray) -> np.ndarray:
+    norms = np.linalg.norm(x, axis=1, keepdims=True)
+    return x / np.where(norms > 1e-10, norms, 1.0)
+
+
+class _NumpyLinearMap:
+    """numpy stand-in for native.mapping.LinearMap (same fit and metrics)."""
+
+    def __init__(self, source_dim: int, target_dim: int):
+        self.source_dim = source_dim
+        self.target_dim = target_dim
+        self.matrix: Optional[np.ndarray] = None
+
+    def fit(self, source, target, *, method: str = "procrustes", ridge: float = 1e-3) -> None:
+        x, y = _unit_rows(np.asarray(source)), _unit_rows(np.asarray(target))
+        if method == "procrustes":
+            u, _, vt = np.linalg.svd(x.T @ y, full_matrices=False)
+            self.matrix = (u @ vt).T
+        elif method == "least_squares":
+            gram = x.T @ x
+            penalty = max(ridge, 0.0) * np.trace(gram) / self.source_dim
+            gram[np.diag_indices_from(gram)] += penalty
+            self.matrix = np.linalg.solve(gram, x.T @ y).T
+        else:
+            raise ValueError("method must be 'procrustes' or 'least_squares'")
+
+    def apply(self, data, *, normalize: bool = True) -> np.ndarray:
+        mapped = _unit_rows(np.asarray(data)) @ self.matrix.T
+        return _unit_rows(mapped) if normalize else mapped
+
+    def evaluate(self, source, target, *, k: int = 10, queries: int = 200, seed: int = 0) -> Dict[str, Any]:
+        mapped, truth = self.apply(source), _unit_rows(np.asarray(target))
+        n = len(mapped)
+        if k == 0 or n <= k:
+            raise ValueError("need more than k pairs")
+        cosines = np.sum(mapped * truth, axis=1)
+        rows = np.random.default_rng(seed).choice(n, size=min(queries, n), replace=False)
+        overlap, top1 = [], []
+        for row in rows:
+            exact = truth @ truth[row]
+            approx = mapped @ mapped[row]
+            exact[row] = approx[row] = -np.inf
+            common = np.intersect1d(np.argsort(-exact)[:k], np.argsort(-approx)[:k])
+            overlap.append(len(common) / k)
+            top1.append(int(np.argmax(truth @ mapped[row])) == row)
+        return {
+            "pairs": n,
+            "queries": len(rows),
+            "k": k,
+            "mean_cosine": float(cosines.mean()),
+            "min_cosine": float(cosines.min()),
+            "neighbor_overlap": float(np.mean(overlap)) if overlap else 0.0,
+            "top1": float(np.mean(top1)) if top1 else 0.0,
+        }
+
+
+class EmbeddingSpaceMigrator:
+    """Move a store to a new embedding model through a learned linear map.
+
+    Re-embedding every memory goes through the rate-limited API. Instead a
+    sample of stored memories is embedded with the new model, a linear map
+    from the old space to the new one is fitted on most of the sample
+    (native Procrustes or ridge least squares), and the held-out rest
+    measures the map before any embedding is rewritten. The whole store is
+    then mapped locally in batches; sampled memories keep their true
+    new-model embedding.
+    """
+
+    def __init__(
+        self,
+        repository,
+        embed: Callable[[str], Optional[Sequence[float]]],
+        sample_size: int = 2000,
+        holdout: float = 0.2,
+        method: str = "procrustes",
+        ridge: float = 1e-3,
+        k: int = 10,
+        batch_size: int = 1024,
+        seed: int = 0,
+    ):
+        """Initialize migrator.
+
+        Args:
+            repository: Store to migrate (MemoryRepositoryProtocol)
+            embed: New-model embedding function, e.g. an EmbeddingService's
+                get_embedding configured with the new model
+            sample_size: Memories to re-embed for fitting and evaluation
+            holdout: Share of the sample kept out of the fit for evaluation
+            method: "procrustes" (orthogonal) or "least_squares"
+            ridge: Least-squares penalty relative to the mean diagonal of X^T X
+            k: Neighbours per query for neighbour overlap@k
+            batch_size: Rows mapped and written per batch
+            seed: Sampling seed
+        """
+        self.repository = repository
+        self.embed = embed
+        self.sample_size = sample_size
+        self.holdout = holdout
+        self.method = method
+        self.ridge = ridge
+        self.k = k
+        self.batch_size = batch_size
+        self.seed = seed
+        self.mapping = None
+        self.quality: Dict[str, Any] = {}
+        self._sampled: Dict[str, np.ndarray] = {}
+
+    def _load(self) -> Dict[str, Any]:
+        limit = self.repository.count() or None
+        return self.repository.get_all(include=["documents", "embeddings"], limit=limit)
+
+    def fit(self, data: Optional[Dict[str, Any]] = None) -> Dict[str, Any]:
+        """Re-embed a sample with the new model, fit the map and evaluate it.
+
+        Args:
+            data: get_all() result with documents and embeddings (loaded
+                from the repository when omitted)
+
+        Returns:
+            Quality report: pairs, mean/min cosine, neighbor_overlap, top1
+        """
+        data = data if data is not None else self._load()
+        ids = data.get("ids") or []
+        documents = data.get("documents") or []
+        embeddings = data.get("embeddings")
+        embeddings = [] if embeddings is None else embeddings
+
+        candidates = [i for i in range(len(ids)) if i < len(documents) and documents[i]]
+        rng = random.Random(self.seed)
+        rng.shuffle(candidates)
+
+        source: List[np.ndarray] = []
+        target: List[np.ndarray] = []
+        self._sampled = {}
+        for i in candidates:
+            if len(source) >= self.sample_size:
+                break
+            old = _as_vector(embeddings[i]) if i < len(embeddings) else None
+            if old is None:
+                continue
+            new = self.embed(documents[i])
+            if new is None:
+                continue
+            new_vec = np.asarray(new, dtype=np.float64)
+            source.append(old)
+            target.append(new_vec)
+            self._sampled[ids[i]] = new_vec
+
+        n_eval = int(len(source) * self.holdout)
+        if len(source) - n_eval < 2 or n_eval <= self.k:
+            raise ValueError(
+                f"not enough re-embedded samples ({len(source)}) to fit and evaluate the map"
+            )
+        x = np.vstack(source)
+        y = np.vstack(target)
+
+        mapping_cls = _native.mapping.LinearMap if _HAS_NATIVE else _NumpyLinearMap
+        self.mapping = mapping_cls(x.shape[1], y.shape[1])
+        self.mapping.fit(x[n_eval:], y[n_eval:], method=self.method, ridge=self.ridge)
+        self.quality = dict(self.mapping.evaluate(x[:n_eval], y[:n_eval], k=self.k, seed=self.seed))
+        self.quality["method"] = self.method
+        self.quality["fitted_on"] = len(source) - n_eval
+
+        _log.info(
+            "Embedding map fitted",
+            method=self.method,
+            pairs=self.quality["fitted_on"],
+            mean_cosine=round(self.quality["mean_cosine"], 4),
+            neighbor_overlap=round(self.quality["neighbor_overlap"], 4),
+            top1=round(self.quality["top1"], 4),
+        )
+        return self.quality
+
+    def _write(self, doc_ids: List[str], vectors: List[List[float]], written: int) -> int:
+        updated = self.repository.update_embeddings(doc_ids, vectors)
+        if updated < len(doc_ids):
+            _log.error("Embedding migration batch failed", sent=len(doc_ids), updated=updated,
+                       written=written)
+            raise RuntimeError(
+                f"embedding update wrote {updated} of {len(doc_ids)} rows after {written} rows "
+                "were already migrated; the store now mixes old and new embeddings"
+            )
+        return updated
+
+    def migrate(
+        self,
+        dry_run: bool = True,
+        min_neighbor_overlap: float = 0.0,
+        store_dim: Optional[int] = None,
+    ) -> Dict[str, Any]:
+        """Fit (if needed) and rewrite every stored embedding in the new space.
+
+        Writing stops at the first batch the repository does not fully
+        update, since later batches would leave mapped and unmapped
+        vectors side by side.
+
+        Args:
+            dry_run: If True, only fit and report quality
+            min_neighbor_overlap: Refuse to write when the held-out
+                neighbour overlap@k is lower
+            store_dim: Embedding width the store accepts (N of a pgvector
+                vector(N) column, a Chroma collection's dimension). Defaults
+                to the current width; pass the new one after altering the
+                column when the new model's width differs
+
+        Returns:
+            Migration report with the map quality and update counts
+
+        Raises:
+            ValueError: If the map's target_dim differs from store_dim
+            RuntimeError: If a batch is only partly written
+        """
+        data = self._load()
+        if self.mapping is None:
+            self.fit(data)
+
+        report: Dict[str, Any] = {"quality": dict(self.quality), "total": len(data.get("ids") or [])}
+        if dry_run:
+            report["action"] = "dry_run"
+            return report
+        if self.quality["neighbor_overlap"] < min_neighbor_overlap:
+            _log.warning(
+                "Embedding map below quality threshold",
+                neighbor_overlap=self.quality["neighbor_overlap"],
+                threshold=min_neighbor_overlap,
+            )
+            report["action"] = "rejected"
+            return report
+        store_dim = store_dim or self.mapping.source_dim
+        if self.mapping.target_dim != store_dim:
+            raise ValueError(
+                f"mapped embeddings have {self.mapping.target_dim} dims but the store takes "
+                f"{store_dim}; alter the embedding column first and pass store_dim"
+            )
+
+        ids = data.get("ids") or []
+        embeddings = data.get("embeddings")
+        embeddings = [] if embeddings is None else embeddings
+        mapped = reembedded = skipped = updated = 0
+        for start in range(0, len(ids), self.batch_size):
+            batch_ids: List[str] = []
+            rows: List[np.ndarray] = []
+            for i in range(start, min(start + self.batch_size, len(ids))):
+                if ids[i] in self._sampled:
+                    continue
+                old = _as_vector(embeddings[i]) if i < len(embeddings) else None
+                if old is None or old.size != self.mapping.source_dim:
+                    skipped += 1
+                    continue
+                batch_ids.append(ids[i])
+                rows.append(old)
+            if not rows:
+                continue
+            new_rows = self.mapping.apply(np.vstack(rows))
+            updated += self._write(batch_ids, new_rows.tolist(), updated)
+            mapped += len(rows)
+
+        sampled_ids = [doc_id for doc_id in ids if doc_id in self._sampled]
+        for start in range(0, len(sampled_ids), self.batch_size):
+            chunk = sampled_ids[start:start + self.batch_size]
+            updated += self._write(
+                chunk, [self._sampled[doc_id].tolist() for doc_id in chunk], updated
+            )
+            reembedded += len(chunk)
+
+        report.update(
+            action="migrated",
+            mapped=mapped,
+            reembedded=reembedded,
+            skipped=skipped,
+            updated=updated,
+        )
+        _log.info("Embedding migration done", mapped=mapped, reembedded=reembedded,
+                  skipped=skipped, updated=updated)
+        return report
@@ -3,13 +3,15 @@
 import re
 from typing import Dict
 
+from backend.core.utils.text_normalize import text_key
+
 from .config import MemoryConfig
 
 
 def _text_similarity(a: str, b: str) -> float:
-    """Fast text similarity score (0-1)."""
+    """Fast text similarity score (0-1) of the first 500 key characters (see text_key)."""
     from difflib import SequenceMatcher
-    return SequenceMatcher(None, a.lower()[:500], b.lower()[:500]).ratio()
+    return SequenceMatcher(None, text_key(a, 500), text_key(b, 500)).ratio()
 
 
 class PromotionCriteria:
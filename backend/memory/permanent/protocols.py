@@ -143,6 +143,18 @@ class MemoryRepositoryProtocol(Protocol):
         """
         ...
 
+    def update_embeddings(self, doc_ids: List[str], embeddings: List[List[float]]) -> int:
+        """Replace the embeddings of existing memories.
+
+        Args:
+            doc_ids: List of document IDs
+            embeddings: New embedding vectors (one per doc_id)
+
+        Returns:
+            Number of successfully updated memories
+        """
+        ...
+
 
 class DecayCalculatorProtocol(Protocol):
     """Protocol for memory importance decay calculation."""
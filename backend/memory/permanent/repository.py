@@ -297,6 +297,31 @@ class ChromaDBRepository:
             )
             return False
 
+    def update_embeddings(self, doc_ids: List[str], embeddings: List[List[float]]) -> int:
+        """Replace the embeddings of existing documents.
+
+        Args:
+            doc_ids: List of document IDs
+            embeddings: New embedding vectors (one per doc_id)
+
+        Returns:
+            Number of successfully updated documents
+        """
+        if not doc_ids or len(doc_ids) != len(embeddings):
+            return 0
+
+        try:
+            self._collection.update(
+                ids=doc_ids,
+                embeddings=embeddings,  # type: ignore[arg-type]
+            )
+            _log.debug("Batch embedding update", count=len(doc_ids))
+            return len(doc_ids)
+
+        except Exception as e:
+            _log.error("Batch embedding update failed", error=str(e), count=len(doc_ids))
+            return 0
+
     def delete(self, doc_ids: List[str]) -> int:
         """Delete memories by ID.
 
@@ -0,0 +1,148 @@
+"""Columnar loading of the memories table through binary COPY.
+
+Reading memories with ``SELECT`` builds a dict per row and parses each
+embedding from text. Here the server streams
+``COPY (SELECT ...) TO STDOUT (FORMAT binary)`` into the native
+``pgcopy.MemoryLoader``. The loader decodes each tuple straight into
+decay columns, an id list and a float32 embedding matrix. At most one
+tuple split across messages is buffered, and ``stream_columns`` hands
+rows over in batches, so a full-table load stays bounded in memory.
+"""
+
+from typing import Any, Callable, Optional
+
+from backend.core.logging import get_logger
+
+from .connection import PgConnectionManager
+
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE = hasattr(_native, "pgcopy")
+except ImportError:
+    _native = None
+    _HAS_NATIVE = False
+
+_log = get_logger("memory.pg.columnar")
+
+EMBEDDING_DIM = 3072
+EMBEDDING_TYPES = ("vector", "halfvec")
+
+# Order and types MemoryLoader expects (pgcopy.BASE_COLUMNS of them)
+_BASE_COLUMNS = (
+    "uuid::text",
+    "memory_type::text",
+    "importance::float8",
+    "access_count::int4",
+    "created_at::timestamptz",
+    "last_accessed::timestamptz",
+    "(length(content) / 4)::int4",  # token_cost, as len(content) // 4
+)
+
+
+def available() -> bool:
+    """Whether the native loader is built."""
+    return _HAS_NATIVE
+
+
+def copy_query(
+    dim: int = EMBEDDING_DIM,
+    embedding_type: str = "halfvec",
+    limit: Optional[int] = None,
+) -> str:
+    """Binary COPY statement for the memories table.
+
+    Args:
+        dim: Embedding dimension, or 0 to leave embeddings out
+        embedding_type: Wire type for the embedding column; ``halfvec``
+            sends half as many bytes as ``vector``
+        limit: Newest ``limit`` memories only
+
+    Returns:
+        ``COPY (SELECT ...) TO STDOUT (FORMAT binary)``
+    """
+    if embedding_type not in EMBEDDING_TYPES:
+        raise ValueError(f"embedding_type must be one of {EMBEDDING_TYPES}")
+    columns = list(_BASE_COLUMNS)
+    if dim:
+        columns.append(f"embedding::{embedding_type}({int(dim)})")
+    select = f"SELECT {', '.join(columns)} FROM memories"
+    if limit is not None:
+        select += f" ORDER BY created_at DESC LIMIT {int(limit)}"
+    return f"COPY ({select}) TO STDOUT (FORMAT binary)"
+
+
+class _BatchSink:
+    """File-like COPY sink that passes on each full batch as it decodes."""
+
+    def __init__(self, loader: Any, batch_rows: int, on_batch: Callable[[Any], None]):
+        self._loader = loader
+        self._batch_rows = batch_rows
+        self._on_batch = on_batch
+
+    def write(self, data: bytes) -> int:
+        self._loader.feed(data)
+        if len(self._loader) >= self._batch_rows:
+            self._on_batch(self._loader.take())
+        return len(data)
+
+
+def _loader(dim: int, embedding_type: str) -> Any:
+    if not _HAS_NATIVE:
+        raise RuntimeError("columnar loading needs axnmihn_native.pgcopy")
+    return _native.pgcopy.MemoryLoader(dim, type=embedding_type)
+
+
+def load_columns(
+    conn_mgr: PgConnectionManager,
+    dim: int = EMBEDDING_DIM,
+    embedding_type: str = "halfvec",
+    limit: Optional[int] = None,
+) -> Any:
+    """Load memories into one ``pgcopy.MemoryColumns``.
+
+    Args:
+        conn_mgr: Connection manager
+        dim: Embedding dimension, or 0 to leave embeddings out
+        embedding_type: Wire type for the embedding column
+        limit: Newest ``limit`` memories only
+
+    Returns:
+        MemoryColumns with ids, decay columns and (rows, dim) embeddings
+    """
+    sql = copy_query(dim, embedding_type, limit)
+    loader = _loader(dim, embedding_type)
+    if limit:
+        loader.reserve(limit)
+    conn_mgr.copy_to(sql, loader)
+    loader.finish()
+    _log.debug("Memories loaded", rows=loader.total_rows, dim=dim)
+    return loader.take()
+
+
+def stream_columns(
+    conn_mgr: PgConnectionManager,
+    on_batch: Callable[[Any], None],
+    batch_rows: int = 10000,
+    dim: int = EMBEDDING_DIM,
+    embedding_type: str = "halfvec",
+    limit: Optional[int] = None,
+) -> int:
+    """Load memories in ``pgcopy.MemoryColumns`` batches of ``batch_rows``.
+
+    ``on_batch`` runs during the COPY as each batch fills, and once more
+    for the remainder, so only one batch is held at a time.
+
+    Returns:
+        Total rows loaded
+    """
+    if batch_rows <= 0:
+        raise ValueError("batch_rows must be positive")
+    sql = copy_query(dim, embedding_type, limit)
+    loader = _loader(dim, embedding_type)
+    loader.reserve(batch_rows)
+    conn_mgr.copy_to(sql, _BatchSink(loader, batch_rows, on_batch))
+    loader.finish()
+    if len(loader):
+        on_batch(loader.take())
+    _log.debug("Memories streamed", rows=loader.total_rows, dim=dim)
+    return loader.total_rows
@@ -2,7 +2,7 @@
 
 import atexit
 from contextlib import contextmanager
-from typing import List, Optional, Tuple
+from typing import Any, List, Optional, Tuple
 
 import psycopg2
 import psycopg2.extras
@@ -114,6 +114,16 @@ class PgConnectionManager:
                 cur.executemany(sql, params_list)
                 return cur.rowcount
 
+    def copy_to(self, sql: str, sink: Any) -> None:
+        """Run ``COPY ... TO STDOUT`` and stream its output into ``sink``.
+
+        ``sink`` needs a ``write(data)`` method; psycopg2 calls it once per
+        CopyData message, so the result is never held in full.
+        """
+        with self.get_connection() as conn:
+            with conn.cursor() as cur:
+                cur.copy_expert(sql, sink)
+
     def health_check(self) -> bool:
         """Return True if the pool can execute ``SELECT 1``."""
         try:
@@ -6,6 +6,7 @@ from typing import Any, Dict, List, Optional
 from backend.core.logging import get_logger
 from backend.core.utils.timezone import now_vancouver
 
+from . import columnar, vector_codec
 from .connection import PgConnectionManager
 
 _log = get_logger("memory.pg.memory")
@@ -67,7 +68,7 @@ class PgMemoryRepository:
             content,
             metadata.get("type", "insight"),
             importance,
-            str(embedding),
+            vector_codec.to_text(embedding),
             metadata.get("source_session"),
             metadata.get("source_channel"),
             metadata.get("created_at", now),
@@ -128,6 +129,10 @@ class PgMemoryRepository:
             if "embeddings" in include:
                 embeddings_out.append(r.get("embedding"))
 
+        if "embeddings" in include:
+            # pgvector text -> float32 arrays (None for NULL), parsed in one batch
+            embeddings_out = vector_codec.from_text_rows(embeddings_out)
+
         result: Dict[str, Any] = {"ids": ids}
         if "documents" in include:
             result["documents"] = documents
@@ -138,6 +143,27 @@ class PgMemoryRepository:
 
         return result
 
+    def load_columns(self, dim: int = columnar.EMBEDDING_DIM, limit: int = None):
+        """Load memories as native columns through binary COPY.
+
+        Unlike get_all() no per-row dicts are built: ids, decay inputs and a
+        float32 (rows, dim) embedding matrix come back in one
+        ``pgcopy.MemoryColumns``. Use ``columnar.stream_columns`` to process
+        the table in bounded batches instead.
+        """
+        return columnar.load_columns(self._conn, dim=dim, limit=limit)
+
+    def stream_columns(self, on_batch, batch_rows: int = 10000, dim: int = 0) -> Optional[int]:
+        """Stream memories as ``pgcopy.MemoryColumns`` batches (no embeddings by default).
+
+        Returns:
+            Total rows streamed, or None when the native loader is not
+            built (callers fall back to get_all())
+        """
+        if not columnar.available():
+            return None
+        return columnar.stream_columns(self._conn, on_batch, batch_rows=batch_rows, dim=dim)
+
     def get_by_id(self, doc_id: str) -> Optional[Dict[str, Any]]:
         rows = self._conn.execute_dict("SELECT * FROM memories WHERE uuid = %s", (doc_id,))
         if not rows:
@@ -159,7 +185,7 @@ class PgMemoryRepository:
     ) -> List[Dict[str, Any]]:
         """Cosine similarity search using pgvector halfvec HNSW index."""
         where_sql, where_params = self._build_where(where)
-        emb_str = str(embedding)
+        emb_str = vector_codec.to_text(embedding)
 
         # PERF-026: Use CTE to send embedding once
         sql = f"""
@@ -235,6 +261,28 @@ class PgMemoryRepository:
                 updated += 1
         return updated
 
+    def update_embeddings(self, doc_ids: List[str], embeddings: List[List[float]]) -> int:
+        """Replace the embeddings of existing memories.
+
+        Args:
+            doc_ids: List of document IDs
+            embeddings: New embedding vectors (one per doc_id)
+
+        Returns:
+            Number of updated memories
+        """
+        if not doc_ids or len(doc_ids) != len(embeddings):
+            return 0
+
+        texts = vector_codec.to_text_rows(embeddings)
+        params = [(text, doc_id) for doc_id, text in zip(doc_ids, texts)]
+        updated = self._conn.execute_many(
+            "UPDATE memories SET embedding = %s::vector WHERE uuid = %s",
+            params,
+        )
+        _log.debug("Batch embedding update", count=len(doc_ids))
+        return updated if updated >= 0 else len(doc_ids)
+
     # ── Delete ───────────────────────────────────────────────────────
 
     def delete(self, doc_ids: List[str]) -> int:
@@ -0,0 +1,93 @@
+"""pgvector text encoding for embedding parameters and results.
+
+psycopg2 has no vector adapter, so embeddings travel as pgvector's text
+form "[v1,v2,...]". ``str(list)`` of a 3072-dim float64 embedding is about
+69 KB and slow to build, and reading a column back means parsing similar
+text. The native codec formats float32 shortest round-trip digits
+(which is all ``vector`` / ``halfvec`` keep) and parses with a SWAR
+number parser; the NumPy fallback produces the same values.
+"""
+
+from typing import Any, List, Optional, Sequence
+
+import numpy as np
+
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE = hasattr(_native, "pgvector")
+except ImportError:
+    _native = None
+    _HAS_NATIVE = False
+
+
+def to_text(embedding: Sequence[float]) -> str:
+    """pgvector text for an embedding, for ``%s::vector`` parameters.
+
+    Args:
+        embedding: Embedding values (list or 1-D array)
+
+    Returns:
+        "[v1,v2,...]" with each value rounded to float32
+    """
+    if _HAS_NATIVE:
+        return _native.pgvector.format(np.asarray(embedding))
+    values = np.asarray(embedding, dtype=np.float32)
+    if values.ndim != 1 or values.size == 0 or not np.all(np.isfinite(values)):
+        raise ValueError("embedding must be a non-empty 1-D array of finite float32 values")
+    # str() of a NumPy float32 is its shortest round-trip form
+    return "[" + ",".join(str(v) for v in values) + "]"
+
+
+def to_text_rows(embeddings: Sequence[Sequence[float]]) -> List[str]:
+    """to_text() for each embedding."""
+    if _HAS_NATIVE and len(embeddings):
+        rows = np.asarray(embeddings, dtype=np.float64)
+        if rows.ndim == 2:
+            return _native.pgvector.format_rows(rows)
+    return [to_text(e) for e in embeddings]
+
+
+def from_text(text: Any) -> Optional[np.ndarray]:
+    """Embedding from a pgvector column value.
+
+    Args:
+        text: pgvector text, or a value that is already a sequence
+
+    Returns:
+        float32 array, or None for NULL
+    """
+    if text is None:
+        return None
+    if not isinstance(text, (str, bytes)):
+        return np.asarray(text, dtype=np.float32)
+    if _HAS_NATIVE:
+        return _native.pgvector.parse(text)
+    if isinstance(text, bytes):
+        text = text.decode()
+    body = text.strip()
+    if not (body.startswith("[") and body.endswith("]")):
+        raise ValueError("malformed vector text")
+    values = np.array(body[1:-1].split(","), dtype=np.float32)
+    if values.size == 0:
+        raise ValueError("vector must have at least 1 dimension")
+    return values
+
+
+def from_text_rows(texts: Sequence[Any]) -> List[Optional[np.ndarray]]:
+    """from_text() for a column of values; NULLs stay None."""
+    present = [i for i, t in enumerate(texts) if isinstance(t, (str, bytes))]
+    out: List[Optional[np.ndarray]] = [
+        None if t is None or isinstance(t, (str, bytes)) else from_text(t) for t in texts
+    ]
+    if _HAS_NATIVE and present:
+        try:
+            matrix = _native.pgvector.parse_rows([texts[i] for i in present])
+        except ValueError:
+            matrix = None  # Mixed dimensions: parse one by one
+        if matrix is not None:
+            for row, i in enumerate(present):
+                out[i] = matrix[row]
+            return out
+    for i in present:
+        out[i] = from_text(texts[i])
+    return out
@@ -4,10 +4,31 @@ from typing import Any, Dict, List, Optional
 
 from backend.config import UTILITY_MODEL
 from backend.core.logging import get_logger
+from backend.core.utils.simhash import superseded_near_duplicates
 
 _log = get_logger("memory.recent.summarizer")
 
 
+def drop_near_duplicate_messages(messages: List[Dict]) -> List[Dict]:
+    """Drop long messages that a later message of the same role nearly repeats.
+
+    Retries and edited resends leave near-identical copies in a session;
+    only the latest version is worth archiving and summarizing.
+
+    Args:
+        messages: Session messages in turn order.
+
+    Returns:
+        Messages without superseded near-duplicates, in the same order.
+    """
+    dropped = set()
+    for role in {msg.get("role") for msg in messages}:
+        positions = [i for i, msg in enumerate(messages) if msg.get("role") == role]
+        texts = [messages[i].get("content") or "" for i in positions]
+        dropped.update(positions[j] for j in superseded_near_duplicates(texts))
+    return [msg for i, msg in enumerate(messages) if i not in dropped]
+
+
 class SessionSummarizer:
     """Generates LLM summaries for expired sessions and archives them.
 
@@ -96,7 +117,17 @@ class SessionSummarizer:
                     if not messages:
                         continue
 
-                    summary = await self.generate_summary(messages, llm_client)
+                    # Near-duplicates only stay out of the summary prompt; the
+                    # archive keeps every message since the session is deleted.
+                    kept = drop_near_duplicate_messages(messages)
+                    if len(kept) < len(messages):
+                        _log.info(
+                            "Dropped near-duplicate messages",
+                            session_id=session_id[:8],
+                            dropped=len(messages) - len(kept),
+                        )
+
+                    summary = await self.generate_summary(kept, llm_client)
                     if not summary:
                         _log.warning(
                             "Failed to generate summary", session_id=session_id[:8]
@@ -0,0 +1,657 @@
+/**
+ * Native kernel benchmarks at production shapes.
+ *
+ * Shapes follow the live system: 3072-dim embeddings (gemini-embedding),
+ * 10k-1M memories, a 10k-entity / 50k-edge knowledge graph and Korean
+ * chat-log text. Build with -DAXNMIHN_BUILD_BENCHMARKS=ON; see the
+ * README's "Benchmarking" section for flags.
+ */
+
+#include "corpus.hpp"
+#include "harness.hpp"
+
+#include "content_hash.hpp"
+#include "decay.hpp"
+#include "graph_ops.hpp"
+#include "knn_graph.hpp"
+#include "memory_engine.hpp"
+#include "pg_copy.hpp"
+#include "pgvector_codec.hpp"
+#include "pq.hpp"
+#include "projection.hpp"
+#include "simhash.hpp"
+#include "stats.hpp"
+#include "string_ops.hpp"
+#include "text_ops.hpp"
+#include "trace.hpp"
+#include "unicode_norm.hpp"
+#include "vector_ops.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace axnmihn {
+namespace bench {
+
+namespace {
+
+constexpr size_t DIM = 3072;
+
+std::string shape(const char* family, size_t a) {
+    return std::string(family) + "/" + std::to_string(a);
+}
+
+std::string shape(const char* family, size_t a, size_t b) {
+    return shape(family, a) + "/" + std::to_string(b);
+}
+
+size_t total_bytes(const std::vector<std::string>& texts) {
+    size_t bytes = 0;
+    for (const std::string& t : texts) {
+        bytes += t.size();
+    }
+    return bytes;
+}
+
+// ====================
+// Decay
+// ====================
+
+void decay_single(State& state) {
+    const DecayColumnsData& c = decay_columns(1024);
+    const decay::DecayConfig config;
+    size_t i = 0;
+    while (state.keep_running()) {
+        decay::DecayInput input{c.importance[i], c.hours_passed[i], c.access_count[i],
+                                c.connection_count[i], c.last_access_hours[i],
+                                c.memory_type[i], c.channel_mentions[i]};
+        do_not_optimize(decay::calculate(input, config));
+        i = (i + 1) & 1023;
+    }
+    state.set_items_processed(state.iterations());
+}
+
+void add_decay_arrays(size_t n, unsigned flags) {
+    add(shape("decay/batch_arrays", n), SIMD | flags, [n](State& state) {
+        const DecayColumnsData& c = decay_columns(n);
+        const decay::DecayConfig config;
+        std::vector<double> out(n);
+        while (state.keep_running()) {
+            decay::calculate_batch_arrays(
+                n, c.importance.data(), c.hours_passed.data(), c.access_count.data(),
+                c.connection_count.data(), c.last_access_hours.data(), c.memory_type.data(),
+                c.channel_mentions.data(), config, out.data());
+            do_not_optimize(out.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * n * (4 * sizeof(double) + 4 * sizeof(int)));
+    });
+}
+
+void add_decay_records(size_t n, unsigned flags) {
+    add(shape("decay/batch_records", n), SIMD | flags, [n](State& state) {
+        const std::vector<decay::DecayRecord>& records = decay_records(n);
+        const decay::DecayConfig config;
+        std::vector<double> out(n);
+        const decay::DecayColumns columns = decay::record_columns(
+            records.data(), static_cast<std::ptrdiff_t>(sizeof(decay::DecayRecord)));
+        while (state.keep_running()) {
+            decay::calculate_batch_strided(n, columns, config, MutableStridedView<double>(out.data()));
+            do_not_optimize(out.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * n * (sizeof(decay::DecayRecord) + sizeof(double)));
+    });
+}
+
+// ====================
+// Vector ops
+// ====================
+
+void cosine_single(State& state) {
+    const std::vector<double>& data = embeddings(2, DIM);
+    const std::vector<double> a(data.begin(), data.begin() + DIM);
+    const std::vector<double> b(data.begin() + DIM, data.end());
+    while (state.keep_running()) {
+        do_not_optimize(vector_ops::cosine_similarity(a, b));
+    }
+    state.set_items_processed(state.iterations());
+}
+
+void add_cosine_batch(size_t n, unsigned flags) {
+    add(shape("vector/cosine_batch", n, DIM), SIMD | flags, [n](State& state) {
+        const std::vector<double>& corpus = embeddings(n, DIM);
+        const std::vector<double>& q = query(DIM);
+        std::vector<double> out(n);
+        while (state.keep_running()) {
+            vector_ops::cosine_similarity_batch_into(
+                StridedView<double>(q.data()), StridedMatrix<double>(corpus.data(), n, DIM),
+                MutableStridedView<double>(out.data()));
+            do_not_optimize(out.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * n * DIM * sizeof(double));
+    });
+}
+
+void add_dot_f32_scan(size_t n) {
+    add(shape("vector/dot_f32_scan", n, DIM), SIMD, [n](State& state) {
+        const std::vector<float>& rows = embeddings_f32(n, DIM);
+        const std::vector<float>& q = embeddings_f32(1, DIM);
+        float sink = 0.0f;
+        while (state.keep_running()) {
+            for (size_t i = 0; i < n; ++i) {
+                sink += vector_ops::dot_product_f32(q.data(), &rows[i * DIM], DIM);
+            }
+            do_not_optimize(sink);
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * n * DIM * sizeof(float));
+    });
+}
+
+void add_find_duplicates(size_t n, unsigned flags) {
+    add(shape("vector/find_duplicates", n, DIM), SIMD | flags, [n](State& state) {
+        const std::vector<double>& data = embeddings(n, DIM);
+        size_t found = 0;
+        while (state.keep_running()) {
+            PairList pairs = vector_ops::find_duplicates_by_embedding(
+                StridedMatrix<double>(data.data(), n, DIM), 0.95);
+            found = pairs.size();
+            do_not_optimize(found);
+        }
+        state.set_items_processed(state.iterations() * n * (n - 1) / 2);
+        state.set_label("pairs=" + std::to_string(found));
+    });
+}
+
+// ====================
+// Graph ops
+// ====================
+
+void add_bfs(size_t nodes, size_t edges, int depth, unsigned flags) {
+    add(shape("graph/bfs", nodes, edges) + "/depth:" + std::to_string(depth), flags,
+        [nodes, edges, depth](State& state) {
+            const Adjacency& adj = graph(nodes, edges);
+            const std::vector<size_t> start{0, nodes / 3, nodes / 2, nodes - 1, 17};
+            size_t reached = 0;
+            while (state.keep_running()) {
+                auto found = graph_ops::bfs_neighbors(adj, start, depth);
+                reached = found.size();
+                do_not_optimize(found.data());
+            }
+            state.set_items_processed(state.iterations() * reached);
+            state.set_label("reached=" + std::to_string(reached));
+        });
+}
+
+void add_components(size_t nodes, size_t edges, unsigned flags) {
+    add(shape("graph/connected_components", nodes, edges), flags, [nodes, edges](State& state) {
+        const Adjacency& adj = graph(nodes, edges);
+        std::vector<int> ids(nodes);
+        int count = 0;
+        while (state.keep_running()) {
+            count = graph_ops::find_connected_components_into(
+                adj, nodes, MutableStridedView<int>(ids.data()));
+            do_not_optimize(ids.data());
+        }
+        state.set_items_processed(state.iterations() * (nodes + edges));
+        state.set_label("components=" + std::to_string(count));
+    });
+}
+
+// ====================
+// String / text ops (Korean)
+// ====================
+
+void levenshtein_korean(State& state) {
+    const std::vector<std::string>& texts = korean_texts(2, 200, 200);
+    while (state.keep_running()) {
+        do_not_optimize(string_ops::levenshtein_distance(texts[0], texts[1]));
+    }
+    state.set_items_processed(state.iterations());
+}
+
+void add_similarity_batch(size_t n) {
+    add(shape("string/similarity_batch_ko", n), NONE, [n](State& state) {
+        const std::vector<std::string>& targets = korean_texts(n, 20, 120);
+        const std::string& q = korean_texts(1, 60, 60)[0];
+        std::vector<double> out(n);
+        while (state.keep_running()) {
+            string_ops::string_similarity_batch_into(q, targets, MutableStridedView<double>(out.data()));
+            do_not_optimize(out.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+    });
+}
+
+void add_string_duplicates(size_t n, unsigned flags) {
+    add(shape("string/find_duplicates_ko", n), flags, [n](State& state) {
+        const std::vector<std::string>& texts = korean_texts(n, 20, 120);
+        size_t found = 0;
+        while (state.keep_running()) {
+            PairList pairs = string_ops::find_string_duplicates(texts, 0.85);
+            found = pairs.size();
+            do_not_optimize(found);
+        }
+        state.set_items_processed(state.iterations() * n * (n - 1) / 2);
+        state.set_label("pairs=" + std::to_string(found));
+    });
+}
+
+void add_korean_spacing(size_t n) {
+    add(shape("text/fix_korean_spacing_batch", n), NONE, [n](State& state) {
+        const std::vector<std::string>& texts = korean_texts(n, 50, 400);
+        const size_t bytes = total_bytes(texts);
+        while (state.keep_running()) {
+            std::vector<std::string> fixed = text_ops::fix_korean_spacing_batch(texts);
+            do_not_optimize(fixed.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * bytes);
+    });
+}
+
+// ====================
+// Memory engine
+// ====================
+
+void add_build_context(size_t n, bool with_entities, unsigned flags) {
+    std::string name = shape("engine/build_context", n, DIM);
+    if (with_entities) {
+        name += "/entities";
+    }
+    add(name, SIMD | PARALLEL | flags, [n, with_entities](State& state) {
+        const engine::MemoryEngine& eng = memory_engine(n, DIM);
+        const std::vector<double>& q = query(DIM);
+        std::vector<std::string> entities;
+        if (with_entities) {
+            entities = {"entity-0", "entity-1", "entity-7"};
+        }
+        engine::BuildFilters filters;
+        filters.graph_depth = 2;
+        filters.max_per_topic = 3;
+        size_t selected = 0;
+        while (state.keep_running()) {
+            engine::ContextSelection sel = eng.build_context(
+                StridedView<double>(q.data()), entities, 4000, NOW, filters);
+            selected = sel.ids.size();
+            do_not_optimize(sel.scores.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_label("selected=" + std::to_string(selected));
+    });
+}
+
+// ====================
+// Product quantization
+// ====================
+
+/** 96-byte codes at 3072 dims (m=192, 4 bits), trained on the first 2000 rows. */
+const pq::PQIndex& pq_index(size_t n) {
+    static std::map<size_t, std::unique_ptr<pq::PQIndex>> cache;
+    std::unique_ptr<pq::PQIndex>& slot = cache[n];
+    if (!slot) {
+        const std::vector<double>& data = embeddings(n, DIM);
+        pq::ProductQuantizer quantizer(DIM, 192, 4);
+        quantizer.train(StridedMatrix<double>(data.data(), std::min<size_t>(n, 2000), DIM), 8, 7);
+        slot.reset(new pq::PQIndex(std::move(quantizer)));
+        slot->add(StridedMatrix<double>(data.data(), n, DIM));
+    }
+    return *slot;
+}
+
+void add_pq_encode(size_t n, unsigned flags) {
+    add(shape("pq/encode", n, DIM), PARALLEL | flags, [n](State& state) {
+        const std::vector<double>& data = embeddings(n, DIM);
+        const pq::ProductQuantizer& quantizer = pq_index(n).quantizer();
+        while (state.keep_running()) {
+            std::vector<uint8_t> codes = quantizer.encode(StridedMatrix<double>(data.data(), n, DIM));
+            do_not_optimize(codes.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * n * DIM * sizeof(double));
+    });
+}
+
+void add_pq_search(size_t n, size_t refine, unsigned flags) {
+    add(shape("pq/search_fast_scan", n, DIM) + "/refine:" + std::to_string(refine),
+        SIMD | PARALLEL | flags, [n, refine](State& state) {
+            const pq::PQIndex& index = pq_index(n);
+            const std::vector<double>& q = query(DIM);
+            while (state.keep_running()) {
+                pq::SearchResult result = index.search(StridedView<double>(q.data()), 10, refine);
+                do_not_optimize(result.scores.data());
+            }
+            state.set_items_processed(state.iterations() * n);
+            state.set_bytes_processed(state.iterations() * n * index.quantizer().code_size());
+        });
+}
+
+// ====================
+// Projection
+// ====================
+
+const projection::LinearProjection& random_projection(size_t out_dim) {
+    static std::map<size_t, std::unique_ptr<projection::LinearProjection>> cache;
+    std::unique_ptr<projection::LinearProjection>& slot = cache[out_dim];
+    if (!slot) {
+        slot.reset(new projection::LinearProjection(DIM, out_dim));
+        slot->random_orthogonal(11);
+    }
+    return *slot;
+}
+
+void add_project(size_t n, size_t out_dim, bool half, unsigned flags) {
+    std::string name = shape(half ? "projection/project_f16" : "projection/project", n, DIM);
+    name += "/out:" + std::to_string(out_dim);
+    add(name, SIMD | PARALLEL | flags, [n, out_dim, half](State& state) {
+        const std::vector<double>& data = embeddings(n, DIM);
+        const projection::LinearProjection& proj = random_projection(out_dim);
+        const StridedMatrix<double> rows(data.data(), n, DIM);
+        std::vector<float> out(half ? 0 : n * out_dim);
+        std::vector<uint16_t> out_f16(half ? n * out_dim : 0);
+        while (state.keep_running()) {
+            if (half) {
+                proj.project_f16_into(rows, 0, true, out_f16.data());
+                do_not_optimize(out_f16.data());
+            } else {
+                proj.project_into(rows, 0, true, out.data());
+                do_not_optimize(out.data());
+            }
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * n * DIM * sizeof(double));
+    });
+}
+
+// ====================
+// Hashing / normalization (Korean)
+// ====================
+
+void add_xxh3(size_t n) {
+    add(shape("hash/xxh3_64_ko", n), NONE, [n](State& state) {
+        const std::vector<std::string>& texts = korean_texts(n, 20, 400);
+        uint64_t sink = 0;
+        while (state.keep_running()) {
+            for (const std::string& t : texts) {
+                sink ^= hashing::xxh3_64(t.data(), t.size());
+            }
+            do_not_optimize(sink);
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * total_bytes(texts));
+    });
+}
+
+void add_hash_batch(size_t n, unsigned flags) {
+    add(shape("hash/hash64_batch_ko", n) + "/nfkc_casefold", PARALLEL | flags, [n](State& state) {
+        const std::vector<std::string>& texts = korean_texts(n, 20, 400);
+        hashing::NormalizeOptions options;
+        options.collapse_whitespace = true;
+        options.casefold = true;
+        options.nfkc = true;
+        while (state.keep_running()) {
+            std::vector<uint64_t> hashes = hashing::hash64_batch(texts, options);
+            do_not_optimize(hashes.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * total_bytes(texts));
+    });
+}
+
+void add_nfkc_casefold(size_t n) {
+    add(shape("unicode/nfkc_casefold_ko", n), NONE, [n](State& state) {
+        const std::vector<std::string>& texts = korean_texts(n, 20, 400);
+        std::string out;
+        while (state.keep_running()) {
+            for (const std::string& t : texts) {
+                unicode::nfkc_casefold_into(t, true, true, out);
+                do_not_optimize(out.data());
+            }
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * total_bytes(texts));
+    });
+}
+
+void add_simhash_fingerprints(size_t n, unsigned flags) {
+    add(shape("simhash/fingerprint_batch_ko", n), PARALLEL | flags, [n](State& state) {
+        const std::vector<std::string>& texts = korean_texts(n, 20, 400);
+        while (state.keep_running()) {
+            std::vector<uint64_t> fps = simhash::fingerprint_batch(texts);
+            do_not_optimize(fps.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * total_bytes(texts));
+    });
+}
+
+void add_simhash_pairs(size_t n, unsigned flags) {
+    add(shape("simhash/near_duplicate_pairs_ko", n), PARALLEL | flags, [n](State& state) {
+        const std::vector<uint64_t> fps = simhash::fingerprint_batch(korean_texts(n, 20, 400));
+        size_t found = 0;
+        while (state.keep_running()) {
+            PairList pairs = simhash::near_duplicate_pairs(fps);
+            found = pairs.size();
+            do_not_optimize(found);
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_label("pairs=" + std::to_string(found));
+    });
+}
+
+// ====================
+// pgvector codec / binary COPY
+// ====================
+
+void add_pgvector_format(size_t n, unsigned flags) {
+    add(shape("pgvector/format_text_rows", n, DIM), PARALLEL | flags, [n](State& state) {
+        const std::vector<double>& data = embeddings(n, DIM);
+        size_t bytes = 0;
+        while (state.keep_running()) {
+            std::vector<std::string> texts =
+                pgvector::format_text_rows(StridedMatrix<double>(data.data(), n, DIM));
+            bytes = total_bytes(texts);
+            do_not_optimize(texts.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * bytes);
+    });
+}
+
+void add_pgvector_parse(size_t n, unsigned flags) {
+    add(shape("pgvector/parse_text_rows", n, DIM), PARALLEL | flags, [n](State& state) {
+        const std::vector<double>& data = embeddings(n, DIM);
+        const std::vector<std::string> texts =
+            pgvector::format_text_rows(StridedMatrix<double>(data.data(), n, DIM));
+        const std::vector<std::string_view> views(texts.begin(), texts.end());
+        while (state.keep_running()) {
+            size_t dim = 0;
+            std::vector<float> rows = pgvector::parse_text_rows(views, dim);
+            do_not_optimize(rows.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * total_bytes(texts));
+    });
+}
+
+void add_pgvector_binary(size_t n, pgvector::WireType type) {
+    const char* family = type == pgvector::WireType::HalfVec ? "pgvector/binary_halfvec"
+                                                              : "pgvector/binary_vector";
+    add(shape(family, n, DIM), NONE, [n, type](State& state) {
+        const std::vector<float>& rows = embeddings_f32(n, DIM);
+        const size_t row_bytes = pgvector::binary_size(type, DIM);
+        std::vector<uint8_t> wire(n * row_bytes);
+        std::vector<float> back(n * DIM);
+        while (state.keep_running()) {
+            for (size_t i = 0; i < n; ++i) {
+                pgvector::encode_binary(&rows[i * DIM], DIM, type, &wire[i * row_bytes]);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                pgvector::decode_binary(&wire[i * row_bytes], row_bytes, type, &back[i * DIM]);
+            }
+            do_not_optimize(back.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * n * row_bytes);
+    });
+}
+
+void add_pgcopy_feed(size_t n) {
+    add(shape("pgcopy/feed_halfvec", n, DIM), NONE, [n](State& state) {
+        // One feed() per 64 KiB, roughly what libpq hands out per CopyData batch.
+        constexpr size_t CHUNK = 64 * 1024;
+        const std::vector<uint8_t>& stream = memory_copy_stream(n, DIM);
+        while (state.keep_running()) {
+            pgcopy::MemoryLoader loader(DIM, pgvector::WireType::HalfVec);
+            loader.reserve(n);
+            for (size_t pos = 0; pos < stream.size(); pos += CHUNK) {
+                loader.feed(stream.data() + pos, std::min(CHUNK, stream.size() - pos));
+            }
+            loader.finish();
+            do_not_optimize(loader.columns().embeddings.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_bytes_processed(state.iterations() * stream.size());
+    });
+}
+
+void add_pgcopy_decay_records(size_t n) {
+    add(shape("pgcopy/decay_records", n), NONE, [n](State& state) {
+        const std::vector<uint8_t>& stream = memory_copy_stream(n, DIM);
+        pgcopy::MemoryLoader loader(DIM, pgvector::WireType::HalfVec);
+        loader.feed(stream.data(), stream.size());
+        const int32_t zero = 0;
+        const StridedView<int32_t> none(&zero, 0);
+        std::vector<decay::DecayRecord> out(n);
+        while (state.keep_running()) {
+            pgcopy::decay_records(loader.columns(), NOW, none, none, out.data());
+            do_not_optimize(out.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+    });
+}
+
+// ====================
+// kNN graph
+// ====================
+
+void add_knn_build(size_t n, knn::BuildMethod method, unsigned flags) {
+    const char* family = method == knn::BuildMethod::Exact ? "knn/build_exact" : "knn/build_nn_descent";
+    add(shape(family, n, DIM), SIMD | PARALLEL | flags, [n, method](State& state) {
+        const std::vector<double>& data = embeddings(n, DIM);
+        knn::BuildOptions options;
+        options.method = method;
+        size_t edges = 0;
+        while (state.keep_running()) {
+            knn::CsrGraph g = knn::build(StridedMatrix<double>(data.data(), n, DIM), options);
+            edges = g.edges();
+            do_not_optimize(g.indices.data());
+        }
+        state.set_items_processed(state.iterations() * n);
+        state.set_label("edges=" + std::to_string(edges));
+    });
+}
+
+// ====================
+// Instrumentation overhead
+// ====================
+
+void call_scope_overhead(State& state) {
+    static const uint32_t probe = stats::register_probe("bench.call_scope");
+    const bool was_enabled = stats::enabled();
+    stats::set_enabled(true);
+    while (state.keep_running()) {
+        stats::CallScope call(probe);
+        call.elements(1);
+        auto timer = call.kernel();
+    }
+    stats::set_enabled(was_enabled);
+    state.set_items_processed(state.iterations());
+}
+
+void trace_span_overhead(State& state) {
+    const bool was_enabled = trace::enabled();
+    trace::set_enabled(true);
+    while (state.keep_running()) {
+        trace::Span span("bench", "bench.trace_span");
+        span.batch(1);
+    }
+    trace::set_enabled(was_enabled);
+    trace::clear();
+    state.set_items_processed(state.iterations());
+}
+
+void register_all() {
+    add("decay/calculate", NONE, decay_single);
+    add_decay_arrays(10000, NONE);
+    add_decay_arrays(100000, NONE);
+    add_decay_arrays(1000000, LARGE);
+    add_decay_records(10000, NONE);
+    add_decay_records(100000, NONE);
+    add_decay_records(1000000, LARGE);
+
+    add("vector/cosine/3072", SIMD, cosine_single);
+    add_cosine_batch(10000, NONE);
+    add_cosine_batch(50000, LARGE);
+    add_dot_f32_scan(10000);
+    add_find_duplicates(500, NONE);
+    add_find_duplicates(2000, LARGE);
+
+    add_bfs(10000, 50000, 2, NONE);
+    add_bfs(10000, 50000, 3, NONE);
+    add_components(10000, 50000, NONE);
+    add_components(100000, 500000, LARGE);
+
+    add("string/levenshtein_ko/200", NONE, levenshtein_korean);
+    add_similarity_batch(10000);
+    add_string_duplicates(300, NONE);
+    add_string_duplicates(1000, LARGE);
+    add_korean_spacing(10000);
+
+    add_build_context(10000, false, NONE);
+    add_build_context(10000, true, NONE);
+    add_build_context(100000, false, LARGE);
+
+    add_pq_encode(10000, NONE);
+    add_pq_search(10000, 4, NONE);
+    add_pq_search(100000, 4, LARGE);
+
+    add_project(10000, 256, false, NONE);
+    add_project(10000, 256, true, NONE);
+
+    add_xxh3(10000);
+    add_hash_batch(10000, NONE);
+    add_nfkc_casefold(10000);
+    add_simhash_fingerprints(10000, NONE);
+    add_simhash_pairs(10000, NONE);
+    add_simhash_pairs(100000, LARGE);
+
+    add_pgvector_format(1000, NONE);
+    add_pgvector_parse(1000, NONE);
+    add_pgvector_binary(1000, pgvector::WireType::Vector);
+    add_pgvector_binary(1000, pgvector::WireType::HalfVec);
+    add_pgcopy_feed(10000);
+    add_pgcopy_decay_records(10000);
+
+    add_knn_build(2000, knn::BuildMethod::Exact, NONE);
+    add_knn_build(10000, knn::BuildMethod::NNDescent, LARGE);
+
+    add("runtime/call_scope", NONE, call_scope_overhead);
+    add("runtime/trace_span", NONE, trace_span_overhead);
+}
+
+}  // anonymous namespace
+
+}  // namespace bench
+}  // namespace axnmihn
+
+int main(int argc, char** argv) {
+    axnmihn::bench::register_all();
+    return axnmihn::bench::run(argc, argv);
+}
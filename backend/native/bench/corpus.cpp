@@ -0,0 +1,368 @@
+#include "corpus.hpp"
+
+#include "pgvector_codec.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace axnmihn {
+namespace bench {
+
+namespace {
+
+// splitmix64: tiny, fast and identical on every platform (unlike the
+// <random> distributions)
+struct Rng {
+    uint64_t state;
+
+    explicit Rng(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    double uniform() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    size_t below(size_t n) { return static_cast<size_t>(next() % n); }
+
+    // Sum of four uniforms: cheap, roughly normal, mean 0
+    double gaussian() { return (uniform() + uniform() + uniform() + uniform() - 2.0) * 1.7320508; }
+};
+
+std::mutex g_cache_mutex;
+
+template <typename Key, typename Value, typename Build>
+const Value& cached(std::map<Key, std::unique_ptr<Value>>& cache, const Key& key, Build build) {
+    std::lock_guard<std::mutex> lock(g_cache_mutex);
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+        it = cache.emplace(key, std::make_unique<Value>(build())).first;
+    }
+    return *it->second;
+}
+
+using Shape = std::pair<size_t, size_t>;
+
+const char* const NOUNS[] = {
+    "오늘", "내일", "어제", "사용자", "메모리", "대화", "프로젝트", "회의", "일정", "커피",
+    "서울", "부산", "회사", "친구", "가족", "주말", "여행", "음악", "영화", "책",
+    "코드", "서버", "데이터베이스", "모델", "검색", "기억", "질문", "답변", "문제", "해결",
+    "아침", "저녁", "점심", "운동", "건강", "날씨", "비", "눈", "공부", "시험",
+    "생일", "선물", "계획", "목표", "습관", "취미", "게임", "사진", "카메라", "노트북",
+};
+
+const char* const PARTICLES[] = {
+    "은", "는", "이", "가", "을", "를", "에", "에서", "와", "과", "도", "만", "의", "로", "까지", "",
+};
+
+const char* const PREDICATES[] = {
+    "했어요", "좋아해요", "싫어해요", "기억해줘", "알려줘", "확인했어", "준비 중이에요",
+    "끝났습니다", "시작할게요", "궁금해요", "필요해요", "어땠어?", "괜찮아", "바빠요",
+};
+
+const char* const LATIN[] = {
+    "Python", "API", "GPU", "SQL", "PostgreSQL", "Redis", "LLM", "v2.1", "OK", "PR",
+};
+
+const char* const PUNCT[] = {".", "!", "?", ",", "~", "..."};
+
+// UTF-8 codepoint count
+size_t char_count(const std::string& s) {
+    size_t n = 0;
+    for (unsigned char c : s) {
+        n += (c & 0xC0) != 0x80;
+    }
+    return n;
+}
+
+template <size_t N>
+const char* pick(Rng& rng, const char* const (&words)[N]) {
+    return words[rng.below(N)];
+}
+
+std::string korean_sentence(Rng& rng) {
+    std::string s;
+    const size_t words = 2 + rng.below(5);
+    for (size_t w = 0; w < words; ++w) {
+        if (!s.empty()) {
+            s += ' ';
+        }
+        if (rng.below(10) == 0) {
+            s += pick(rng, LATIN);
+        } else {
+            s += pick(rng, NOUNS);
+            s += pick(rng, PARTICLES);
+        }
+        if (rng.below(12) == 0) {
+            s += ' ';
+            s += std::to_string(rng.below(2025));
+        }
+    }
+    s += ' ';
+    s += pick(rng, PREDICATES);
+    s += pick(rng, PUNCT);
+    // A third of sentence boundaries are missing their space
+    if (rng.below(3) != 0) {
+        s += ' ';
+    }
+    return s;
+}
+
+}  // anonymous namespace
+
+const std::vector<double>& embeddings(size_t n, size_t dim) {
+    static std::map<Shape, std::unique_ptr<std::vector<double>>> cache;
+    return cached(cache, Shape(n, dim), [&] {
+        Rng rng(0xE3B0C442ull ^ (n * 31 + dim));
+        std::vector<double> data(n * dim);
+        for (size_t i = 0; i < n; ++i) {
+            double* row = &data[i * dim];
+            if (i > 0 && i % 50 == 0) {
+                // Near-duplicate of the previous row (cosine ~0.98)
+                const double* prev = row - dim;
+                for (size_t d = 0; d < dim; ++d) {
+                    row[d] = prev[d] + 0.004 * rng.gaussian();
+                }
+            } else {
+                for (size_t d = 0; d < dim; ++d) {
+                    row[d] = 0.02 * rng.gaussian();
+                }
+            }
+        }
+        return data;
+    });
+}
+
+const std::vector<float>& embeddings_f32(size_t n, size_t dim) {
+    static std::map<Shape, std::unique_ptr<std::vector<float>>> cache;
+    return cached(cache, Shape(n, dim), [&] {
+        Rng rng(0x5A17ull ^ (n * 31 + dim));
+        std::vector<float> data(n * dim);
+        for (size_t i = 0; i < n; ++i) {
+            float* row = &data[i * dim];
+            double norm_sq = 0.0;
+            for (size_t d = 0; d < dim; ++d) {
+                row[d] = static_cast<float>(rng.gaussian());
+                norm_sq += static_cast<double>(row[d]) * row[d];
+            }
+            const float inv = static_cast<float>(1.0 / std::sqrt(std::max(norm_sq, 1e-12)));
+            for (size_t d = 0; d < dim; ++d) {
+                row[d] *= inv;
+            }
+        }
+        return data;
+    });
+}
+
+const DecayColumnsData& decay_columns(size_t n) {
+    static std::map<size_t, std::unique_ptr<DecayColumnsData>> cache;
+    return cached(cache, n, [&] {
+        Rng rng(0xDECAull ^ n);
+        DecayColumnsData c;
+        c.importance.resize(n);
+        c.hours_passed.resize(n);
+        c.access_count.resize(n);
+        c.connection_count.resize(n);
+        c.last_access_hours.resize(n);
+        c.memory_type.resize(n);
+        c.channel_mentions.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            c.importance[i] = 0.1 + 0.9 * rng.uniform();
+            // Ages up to two years, skewed towards recent memories
+            const double u = rng.uniform();
+            c.hours_passed[i] = 17520.0 * u * u;
+            c.access_count[i] = static_cast<int>(rng.below(4) == 0 ? rng.below(200) : rng.below(5));
+            c.connection_count[i] = static_cast<int>(rng.below(12));
+            c.last_access_hours[i] = rng.below(3) == 0 ? -1.0 : c.hours_passed[i] * rng.uniform();
+            c.memory_type[i] = static_cast<int>(rng.below(4));
+            c.channel_mentions[i] = static_cast<int>(rng.below(4));
+        }
+        return c;
+    });
+}
+
+const std::vector<decay::DecayRecord>& decay_records(size_t n) {
+    static std::map<size_t, std::unique_ptr<std::vector<decay::DecayRecord>>> cache;
+    const DecayColumnsData& c = decay_columns(n);
+    return cached(cache, n, [&] {
+        std::vector<decay::DecayRecord> records(n);
+        for (size_t i = 0; i < n; ++i) {
+            records[i] = decay::DecayRecord{
+                c.importance[i], c.hours_passed[i], c.last_access_hours[i],
+                c.access_count[i], c.connection_count[i], c.memory_type[i], c.channel_mentions[i]};
+        }
+        return records;
+    });
+}
+
+const Adjacency& graph(size_t nodes, size_t edges) {
+    static std::map<Shape, std::unique_ptr<Adjacency>> cache;
+    return cached(cache, Shape(nodes, edges), [&] {
+        Rng rng(0x6A09E667ull ^ (nodes * 131 + edges));
+        Adjacency adj;
+        adj.reserve(nodes);
+        for (size_t e = 0; e < edges; ++e) {
+            // Squaring a uniform biases endpoints towards low ids: a few hub
+            // entities and a long tail, like the knowledge graph
+            const double u = rng.uniform();
+            const size_t a = static_cast<size_t>(u * u * static_cast<double>(nodes));
+            const size_t b = rng.below(nodes);
+            if (a == b) {
+                continue;
+            }
+            adj[a].push_back(b);
+            adj[b].push_back(a);
+        }
+        return adj;
+    });
+}
+
+const std::vector<std::string>& korean_texts(size_t n, size_t min_chars, size_t max_chars) {
+    static std::map<std::pair<size_t, Shape>, std::unique_ptr<std::vector<std::string>>> cache;
+    return cached(cache, std::make_pair(n, Shape(min_chars, max_chars)), [&] {
+        Rng rng(0xAC00ull ^ (n * 7 + min_chars * 13 + max_chars));
+        std::vector<std::string> texts;
+        texts.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (i > 0 && rng.below(20) == 0) {
+                // Near-duplicate: an earlier text with its tail rewritten
+                std::string text = texts[rng.below(i)];
+                text += korean_sentence(rng);
+                texts.push_back(std::move(text));
+                continue;
+            }
+            const size_t target = min_chars + rng.below(max_chars - min_chars + 1);
+            std::string text;
+            while (char_count(text) < target) {
+                text += korean_sentence(rng);
+            }
+            texts.push_back(std::move(text));
+        }
+        return texts;
+    });
+}
+
+const engine::MemoryEngine& memory_engine(size_t n, size_t dim) {
+    static std::map<Shape, std::unique_ptr<engine::MemoryEngine>> cache;
+    std::lock_guard<std::mutex> lock(g_cache_mutex);
+    auto it = cache.find(Shape(n, dim));
+    if (it != cache.end()) {
+        return *it->second;
+    }
+
+    auto eng = std::make_unique<engine::MemoryEngine>(dim);
+    Rng rng(0xB5C0FBCFull ^ (n * 17 + dim));
+    std::vector<double> row(dim);
+    std::vector<std::string> hot;
+    const size_t n_entities = std::max<size_t>(1, n / 20);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t d = 0; d < dim; ++d) {
+            row[d] = rng.gaussian();
+        }
+        engine::MemoryAttributes attrs;
+        attrs.importance = 0.1 + 0.9 * rng.uniform();
+        attrs.event_time = NOW - 3600.0 * 17520.0 * rng.uniform();
+        attrs.last_accessed = rng.below(3) == 0 ? -1.0 : attrs.event_time + (NOW - attrs.event_time) * rng.uniform();
+        attrs.access_count = static_cast<int>(rng.below(20));
+        attrs.connection_count = static_cast<int>(rng.below(8));
+        attrs.memory_type = static_cast<int>(rng.below(4));
+        attrs.channel_mentions = static_cast<int>(rng.below(3));
+        attrs.token_cost = static_cast<int>(20 + rng.below(400));
+
+        const std::string id = "mem-" + std::to_string(i);
+        eng->upsert(id, StridedView<double>(row.data()), attrs);
+        eng->link_entity(id, "entity-" + std::to_string(rng.below(n_entities)));
+        eng->set_topics(id, {"topic-" + std::to_string(rng.below(64))});
+        if (rng.below(100) == 0) {
+            hot.push_back(id);
+        }
+    }
+    // Sparse entity graph: about three relations per entity
+    for (size_t e = 0; e < n_entities * 3; ++e) {
+        eng->add_relation("entity-" + std::to_string(rng.below(n_entities)),
+                          "entity-" + std::to_string(rng.below(n_entities)));
+    }
+    eng->set_hot(hot);
+    return *cache.emplace(Shape(n, dim), std::move(eng)).first->second;
+}
+
+const std::vector<uint8_t>& memory_copy_stream(size_t n, size_t dim) {
+    static std::map<Shape, std::unique_ptr<std::vector<uint8_t>>> cache;
+    // Looked up before cached() takes the (non-recursive) cache mutex.
+    const std::vector<float>& rows = embeddings_f32(n, dim);
+    return cached(cache, Shape(n, dim), [&] {
+        constexpr double PG_EPOCH = 946684800.0;
+        const char* const types[] = {"conversation", "fact", "preference", "insight"};
+        std::vector<uint8_t> out;
+        auto be = [&out](uint64_t value, int bytes) {
+            for (int shift = 8 * (bytes - 1); shift >= 0; shift -= 8) {
+                out.push_back(static_cast<uint8_t>(value >> shift));
+            }
+        };
+        auto text = [&](const std::string& s) {
+            be(s.size(), 4);
+            out.insert(out.end(), s.begin(), s.end());
+        };
+        auto timestamp = [&](double seconds) {
+            be(8, 4);
+            be(static_cast<uint64_t>(static_cast<int64_t>((seconds - PG_EPOCH) * 1e6)), 8);
+        };
+
+        const uint8_t signature[11] = {'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xFF, '\r', '\n', 0};
+        out.insert(out.end(), signature, signature + sizeof(signature));
+        be(0, 4);  // flags
+        be(0, 4);  // header extension length
+
+        const size_t vec_bytes = pgvector::binary_size(pgvector::WireType::HalfVec, dim);
+        Rng rng(0xC0FFEEull ^ (n * 29 + dim));
+        for (size_t i = 0; i < n; ++i) {
+            be(8, 2);  // BASE_COLUMNS + embedding
+            text("mem-" + std::to_string(i));
+            text(types[rng.below(4)]);
+            const double importance = 0.1 + 0.9 * rng.uniform();
+            uint64_t bits;
+            std::memcpy(&bits, &importance, sizeof(bits));
+            be(8, 4);
+            be(bits, 8);
+            be(4, 4);
+            be(rng.below(20), 4);
+            const double created = NOW - 3600.0 * 17520.0 * rng.uniform();
+            timestamp(created);
+            if (rng.below(3) == 0) {
+                be(0xFFFFFFFFu, 4);  // NULL last_accessed
+            } else {
+                timestamp(created + (NOW - created) * rng.uniform());
+            }
+            be(4, 4);
+            be(20 + rng.below(400), 4);
+            be(vec_bytes, 4);
+            out.resize(out.size() + vec_bytes);
+            pgvector::encode_binary(&rows[i * dim], dim, pgvector::WireType::HalfVec,
+                                    out.data() + out.size() - vec_bytes);
+        }
+        be(0xFFFF, 2);  // trailer
+        return out;
+    });
+}
+
+const std::vector<double>& query(size_t dim) {
+    static std::map<size_t, std::unique_ptr<std::vector<double>>> cache;
+    return cached(cache, dim, [&] {
+        Rng rng(0x0FF1CEull ^ dim);
+        std::vector<double> q(dim);
+        for (double& x : q) {
+            x = rng.gaussian();
+        }
+        return q;
+    });
+}
+
+}  // namespace bench
+}  // namespace axnmihn
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "decay.hpp"
+#include "memory_engine.hpp"
+
+namespace axnmihn {
+namespace bench {
+
+/**
+ * Deterministic synthetic inputs shaped like production data.
+ *
+ * Every generator is seeded, so two runs (or two machines) see the same
+ * inputs. Results are cached per shape: the first benchmark that asks
+ * for a shape pays for building it, outside the timed loop.
+ */
+
+/** Row-major n x dim embeddings; every 50th row is a near-duplicate of its predecessor. */
+const std::vector<double>& embeddings(size_t n, size_t dim);
+
+/** Unit-norm float32 rows, for the f32 kernels. */
+const std::vector<float>& embeddings_f32(size_t n, size_t dim);
+
+/** Decay inputs as separate columns (the calculate_batch_arrays layout). */
+struct DecayColumnsData {
+    std::vector<double> importance;
+    std::vector<double> hours_passed;
+    std::vector<int> access_count;
+    std::vector<int> connection_count;
+    std::vector<double> last_access_hours;
+    std::vector<int> memory_type;
+    std::vector<int> channel_mentions;
+};
+
+const DecayColumnsData& decay_columns(size_t n);
+
+/** The same inputs as packed DecayRecords (the structured-array path). */
+const std::vector<decay::DecayRecord>& decay_records(size_t n);
+
+/** Undirected graph with a power-law-ish degree spread. */
+using Adjacency = std::unordered_map<size_t, std::vector<size_t>>;
+const Adjacency& graph(size_t nodes, size_t edges);
+
+/**
+ * Korean chat-log style texts: Hangul words with particles, some Latin
+ * terms and digits, and punctuation that is sometimes missing the space
+ * the spacing fixer inserts. About 5% are near-duplicates of an earlier
+ * text.
+ */
+const std::vector<std::string>& korean_texts(size_t n, size_t min_chars, size_t max_chars);
+
+/** Memory engine loaded with n memories, one entity and topic each, ~1% hot. */
+const engine::MemoryEngine& memory_engine(size_t n, size_t dim);
+
+/**
+ * Binary COPY output of the memories table (pgcopy::BASE_COLUMNS plus a
+ * halfvec embedding): header, n tuples and trailer, as the server sends it.
+ */
+const std::vector<uint8_t>& memory_copy_stream(size_t n, size_t dim);
+
+/** Query embedding for the engine / cosine benchmarks. */
+const std::vector<double>& query(size_t dim);
+
+/** Epoch seconds used as "now" by the decay and engine benchmarks. */
+constexpr double NOW = 1.76e9;
+
+}  // namespace bench
+}  // namespace axnmihn
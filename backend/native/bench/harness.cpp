@@ -0,0 +1,391 @@
+#include "harness.hpp"
+
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#include <unistd.h>
+
+namespace axnmihn {
+namespace bench {
+
+namespace {
+
+struct Benchmark {
+    std::string name;
+    unsigned flags;
+    Body body;
+};
+
+std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct Options {
+    std::string filter = ".";
+    double min_time = 0.5;  // seconds per reported run
+    std::string format = "console";
+    std::string out_path;
+    std::vector<std::string> simd{"auto"};
+    std::vector<size_t> threads;
+    bool large = false;
+    bool list = false;
+};
+
+struct Result {
+    std::string name;
+    std::string family;
+    uint64_t iterations = 0;
+    double real_ns = 0.0;  // per iteration
+    double cpu_ns = 0.0;   // per iteration, whole process
+    double items_per_second = 0.0;
+    double bytes_per_second = 0.0;
+    size_t threads = 1;
+    std::string simd;
+    std::string label;
+    std::string error;
+};
+
+std::vector<std::string> split(const std::string& text, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream stream(text);
+    std::string part;
+    while (std::getline(stream, part, sep)) {
+        if (!part.empty()) {
+            parts.push_back(part);
+        }
+    }
+    return parts;
+}
+
+bool take_flag(const std::string& arg, const char* name, std::string& value) {
+    const std::string prefix = std::string("--") + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) == 0) {
+        value = arg.substr(prefix.size());
+        return true;
+    }
+    return false;
+}
+
+void usage() {
+    std::cerr <<
+        "usage: axnmihn_bench [options]\n"
+        "  --benchmark_filter=REGEX     run benchmarks whose name matches\n"
+        "  --benchmark_min_time=SEC     minimum measured time per run (default 0.5)\n"
+        "  --benchmark_format=FMT       console (default) or json on stdout\n"
+        "  --benchmark_out=PATH         also write the JSON report to PATH\n"
+        "  --benchmark_list_tests       print the benchmark names and exit\n"
+        "  --simd=LIST                  comma list of auto,scalar,avx2 or 'all'\n"
+        "  --threads=LIST               comma list of thread caps for parallel kernels\n"
+        "  --large                      include the 100k-1M shapes (several GB)\n";
+}
+
+bool parse(int argc, char** argv, Options& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        std::string value;
+        if (take_flag(arg, "benchmark_filter", value)) {
+            opts.filter = value;
+        } else if (take_flag(arg, "benchmark_min_time", value)) {
+            if (!value.empty() && value.back() == 's') {
+                value.pop_back();
+            }
+            opts.min_time = std::strtod(value.c_str(), nullptr);
+        } else if (take_flag(arg, "benchmark_format", value)) {
+            opts.format = value;
+        } else if (take_flag(arg, "benchmark_out", value)) {
+            opts.out_path = value;
+        } else if (arg == "--benchmark_list_tests") {
+            opts.list = true;
+        } else if (take_flag(arg, "simd", value)) {
+            opts.simd = value == "all" ? simd::available() : split(value, ',');
+        } else if (take_flag(arg, "threads", value)) {
+            opts.threads.clear();
+            for (const std::string& part : split(value, ',')) {
+                opts.threads.push_back(static_cast<size_t>(std::strtoul(part.c_str(), nullptr, 10)));
+            }
+        } else if (arg == "--large") {
+            opts.large = true;
+        } else {
+            std::cerr << "unknown flag: " << arg << "\n";
+            usage();
+            return false;
+        }
+    }
+    if (opts.threads.empty()) {
+        opts.threads.push_back(1);
+        size_t all = runtime::default_pool().size() + 1;
+        if (all > 1) {
+            opts.threads.push_back(all);
+        }
+    }
+    if (opts.format != "console" && opts.format != "json") {
+        std::cerr << "unknown format: " << opts.format << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Run the body once with a fixed iteration count
+State run_once(const Benchmark& bm, uint64_t iterations, size_t threads, const char* simd) {
+    State state(iterations, threads, simd);
+    bm.body(state);
+    return state;
+}
+
+Result measure(const Benchmark& bm, const Options& opts, size_t threads) {
+    Result result;
+    result.family = bm.name;
+    result.threads = threads;
+    result.simd = simd::active();
+    result.name = bm.name;
+    if (bm.flags & SIMD) {
+        result.name += "/simd:" + result.simd;
+    }
+    if (bm.flags & PARALLEL) {
+        result.name += "/threads:" + std::to_string(threads);
+    }
+
+    // Grow the iteration count until one run lasts min_time, as Google
+    // Benchmark does; the last run is the one reported.
+    uint64_t iterations = 1;
+    for (;;) {
+        State state = run_once(bm, iterations, threads, simd::active());
+        if (!state.error().empty()) {
+            result.error = state.error();
+            return result;
+        }
+        const double seconds = state.wall_ns() / 1e9;
+        if (seconds >= opts.min_time || iterations >= 1000000000ull) {
+            result.iterations = iterations;
+            result.real_ns = state.wall_ns() / static_cast<double>(iterations);
+            result.cpu_ns = state.cpu_ns() / static_cast<double>(iterations);
+            if (seconds > 0) {
+                result.items_per_second = static_cast<double>(state.items()) / seconds;
+                result.bytes_per_second = static_cast<double>(state.bytes()) / seconds;
+            }
+            result.label = state.label();
+            return result;
+        }
+        double grow = seconds > 0 ? opts.min_time * 1.4 / seconds : 10.0;
+        grow = std::min(10.0, std::max(2.0, grow));
+        iterations = static_cast<uint64_t>(static_cast<double>(iterations) * grow);
+    }
+}
+
+std::string json_escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+std::string host_name() {
+    char buf[256] = {0};
+    if (gethostname(buf, sizeof(buf) - 1) != 0) {
+        return "unknown";
+    }
+    return buf;
+}
+
+std::string iso_date() {
+    char buf[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+    return buf;
+}
+
+std::string to_json(const std::vector<Result>& results, const char* executable) {
+    std::ostringstream out;
+    out.precision(17);
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": \"" << iso_date() << "\",\n";
+    out << "    \"host_name\": \"" << json_escape(host_name()) << "\",\n";
+    out << "    \"executable\": \"" << json_escape(executable) << "\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "    \"pool_threads\": " << runtime::default_pool().size() << ",\n";
+    out << "    \"simd_variants\": [";
+    const std::vector<std::string> variants = simd::available();
+    for (size_t i = 0; i < variants.size(); ++i) {
+        out << (i ? ", " : "") << "\"" << variants[i] << "\"";
+    }
+    out << "],\n";
+#ifdef NDEBUG
+    out << "    \"library_build_type\": \"release\",\n";
+#else
+    out << "    \"library_build_type\": \"debug\",\n";
+#endif
+    out << "    \"cpu_time_scope\": \"process\"\n";
+    out << "  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i ? "," : "") << "\n    {\n";
+        out << "      \"name\": \"" << json_escape(r.name) << "\",\n";
+        out << "      \"family_name\": \"" << json_escape(r.family) << "\",\n";
+        out << "      \"run_type\": \"iteration\",\n";
+        out << "      \"simd\": \"" << r.simd << "\",\n";
+        out << "      \"threads\": " << r.threads << ",\n";
+        if (!r.error.empty()) {
+            out << "      \"error_occurred\": true,\n";
+            out << "      \"error_message\": \"" << json_escape(r.error) << "\"\n    }";
+            continue;
+        }
+        out << "      \"iterations\": " << r.iterations << ",\n";
+        out << "      \"real_time\": " << r.real_ns << ",\n";
+        out << "      \"cpu_time\": " << r.cpu_ns << ",\n";
+        out << "      \"time_unit\": \"ns\"";
+        if (r.items_per_second > 0) {
+            out << ",\n      \"items_per_second\": " << r.items_per_second;
+        }
+        if (r.bytes_per_second > 0) {
+            out << ",\n      \"bytes_per_second\": " << r.bytes_per_second;
+        }
+        if (!r.label.empty()) {
+            out << ",\n      \"label\": \"" << json_escape(r.label) << "\"";
+        }
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+std::string human_rate(double per_second) {
+    char buf[32];
+    const char* units[] = {"", "k", "M", "G", "T"};
+    size_t u = 0;
+    while (per_second >= 1000.0 && u + 1 < sizeof(units) / sizeof(units[0])) {
+        per_second /= 1000.0;
+        ++u;
+    }
+    std::snprintf(buf, sizeof(buf), "%.4g%s/s", per_second, units[u]);
+    return buf;
+}
+
+void print_console_row(const Result& r) {
+    if (!r.error.empty()) {
+        std::printf("%-64s ERROR: %s\n", r.name.c_str(), r.error.c_str());
+        return;
+    }
+    std::string rate;
+    if (r.items_per_second > 0) {
+        rate = "items=" + human_rate(r.items_per_second);
+    }
+    if (r.bytes_per_second > 0) {
+        rate += (rate.empty() ? "" : " ") + std::string("bytes=") + human_rate(r.bytes_per_second);
+    }
+    std::printf("%-64s %14.0f ns %14.0f ns %10llu  %s%s%s\n", r.name.c_str(), r.real_ns, r.cpu_ns,
+                static_cast<unsigned long long>(r.iterations), rate.c_str(),
+                r.label.empty() ? "" : "  ", r.label.c_str());
+    std::fflush(stdout);
+}
+
+}  // anonymous namespace
+
+void add(const std::string& name, unsigned flags, Body body) {
+    registry().push_back(Benchmark{name, flags, std::move(body)});
+}
+
+int run(int argc, char** argv) {
+    Options opts;
+    if (!parse(argc, argv, opts)) {
+        return 2;
+    }
+
+    std::regex filter;
+    try {
+        filter = std::regex(opts.filter);
+    } catch (const std::regex_error&) {
+        std::cerr << "invalid --benchmark_filter: " << opts.filter << "\n";
+        return 2;
+    }
+
+    std::vector<const Benchmark*> selected;
+    for (const Benchmark& bm : registry()) {
+        if ((bm.flags & LARGE) && !opts.large) {
+            continue;
+        }
+        if (std::regex_search(bm.name, filter)) {
+            selected.push_back(&bm);
+        }
+    }
+
+    if (opts.list) {
+        for (const Benchmark* bm : selected) {
+            std::printf("%s\n", bm->name.c_str());
+        }
+        return 0;
+    }
+
+    const bool console = opts.format == "console";
+    if (console) {
+        std::printf("%-64s %17s %17s %10s\n", "Benchmark", "Time", "CPU", "Iterations");
+        std::printf("%s\n", std::string(112, '-').c_str());
+    }
+
+    std::vector<Result> results;
+    for (const Benchmark* bm : selected) {
+        const std::vector<std::string> variants =
+            (bm->flags & SIMD) ? opts.simd : std::vector<std::string>{"auto"};
+        const std::vector<size_t> threads =
+            (bm->flags & PARALLEL) ? opts.threads : std::vector<size_t>{1};
+        for (const std::string& variant : variants) {
+            try {
+                simd::set_variant(variant);
+            } catch (const std::invalid_argument& e) {
+                std::cerr << e.what() << "\n";
+                return 2;
+            }
+            for (size_t t : threads) {
+                runtime::set_max_parallelism(t);
+                Result r = measure(*bm, opts, t);
+                if (console) {
+                    print_console_row(r);
+                }
+                results.push_back(std::move(r));
+            }
+        }
+    }
+    simd::set_variant("auto");
+    runtime::set_max_parallelism(0);
+
+    const std::string json = to_json(results, argv[0]);
+    if (!console) {
+        std::fputs(json.c_str(), stdout);
+    }
+    if (!opts.out_path.empty()) {
+        std::ofstream file(opts.out_path);
+        if (!file) {
+            std::cerr << "cannot write " << opts.out_path << "\n";
+            return 1;
+        }
+        file << json;
+    }
+
+    for (const Result& r : results) {
+        if (!r.error.empty()) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+}  // namespace bench
+}  // namespace axnmihn
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace axnmihn {
+namespace bench {
+
+/**
+ * Per-run state handed to a benchmark body (Google Benchmark style).
+ *
+ * Usage:
+ *     void bm_foo(bench::State& state) {
+ *         const auto& data = corpus(...);       // untimed setup
+ *         while (state.keep_running()) {
+ *             bench::do_not_optimize(kernel(data));
+ *         }
+ *         state.set_items_processed(state.iterations() * data.size());
+ *     }
+ *
+ * The clock starts on the first keep_running() call and stops when it
+ * returns false, so setup before the loop is not measured.
+ */
+class State {
+public:
+    State(uint64_t max_iterations, size_t threads, const char* simd)
+        : max_iterations_(max_iterations), threads_(threads), simd_(simd) {}
+
+    bool keep_running() {
+        if (count_ == 0) {
+            start_wall_ = std::chrono::steady_clock::now();
+            start_cpu_ = std::clock();
+        }
+        if (count_ < max_iterations_) {
+            ++count_;
+            return true;
+        }
+        wall_ns_ = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_wall_).count());
+        cpu_ns_ = static_cast<double>(std::clock() - start_cpu_) * 1e9 / CLOCKS_PER_SEC;
+        return false;
+    }
+
+    uint64_t iterations() const { return max_iterations_; }
+
+    /** Thread cap applied to parallel kernels for this run. */
+    size_t threads() const { return threads_; }
+
+    /** SIMD variant forced for this run. */
+    const char* simd() const { return simd_; }
+
+    void set_items_processed(uint64_t n) { items_ = n; }
+    void set_bytes_processed(uint64_t n) { bytes_ = n; }
+    void set_label(std::string label) { label_ = std::move(label); }
+
+    /** Abort the run; the benchmark is reported with this message. */
+    void skip_with_error(std::string message) {
+        error_ = std::move(message);
+        max_iterations_ = 0;
+    }
+
+    double wall_ns() const { return wall_ns_; }
+    double cpu_ns() const { return cpu_ns_; }
+    uint64_t items() const { return items_; }
+    uint64_t bytes() const { return bytes_; }
+    const std::string& label() const { return label_; }
+    const std::string& error() const { return error_; }
+
+private:
+    uint64_t max_iterations_;
+    uint64_t count_ = 0;
+    size_t threads_;
+    const char* simd_;
+    std::chrono::steady_clock::time_point start_wall_;
+    std::clock_t start_cpu_ = 0;
+    double wall_ns_ = 0.0;
+    double cpu_ns_ = 0.0;
+    uint64_t items_ = 0;
+    uint64_t bytes_ = 0;
+    std::string label_;
+    std::string error_;
+};
+
+/**
+ * Registration flags.
+ *
+ * PARALLEL benchmarks run once per --threads value; the others run once
+ * with threads=1. SIMD benchmarks run once per --simd variant; the others
+ * only under "auto". LARGE benchmarks only run with --large (they need
+ * several GB of memory or minutes per run).
+ */
+enum Flags : unsigned {
+    NONE = 0,
+    PARALLEL = 1u << 0,
+    SIMD = 1u << 1,
+    LARGE = 1u << 2,
+};
+
+using Body = std::function<void(State&)>;
+
+/** Add a benchmark; `name` uses '/'-separated shape components. */
+void add(const std::string& name, unsigned flags, Body body);
+
+/**
+ * Parse command-line flags, run every matching benchmark and write the
+ * report. Returns the process exit code.
+ */
+int run(int argc, char** argv);
+
+/** Keep a value alive so the optimizer cannot drop the computation. */
+template <typename T>
+inline void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+}  // namespace bench
+}  // namespace axnmihn
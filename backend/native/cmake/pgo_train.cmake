@@ -0,0 +1,36 @@
+# PGO training run (invoked by the pgo-train target with cmake -P).
+#
+# Clears stale counters, runs the instrumented benchmark workload and, for
+# Clang, merges the raw profiles into axnmihn.profdata.
+#
+# Variables: BENCH, BENCH_ARGS, PROFILE_DIR, COMPILER_ID, LLVM_PROFDATA
+
+file(REMOVE_RECURSE "${PROFILE_DIR}")
+file(MAKE_DIRECTORY "${PROFILE_DIR}")
+
+separate_arguments(bench_args UNIX_COMMAND "${BENCH_ARGS}")
+execute_process(
+    COMMAND "${BENCH}" ${bench_args}
+    RESULT_VARIABLE bench_result
+    OUTPUT_QUIET)
+if(NOT bench_result EQUAL 0)
+    message(FATAL_ERROR "Training run failed: ${BENCH} exited with ${bench_result}")
+endif()
+
+if(COMPILER_ID MATCHES "Clang")
+    if(NOT LLVM_PROFDATA)
+        message(FATAL_ERROR "llvm-profdata not found; cannot merge Clang profiles")
+    endif()
+    file(GLOB raw_profiles "${PROFILE_DIR}/*.profraw")
+    execute_process(
+        COMMAND "${LLVM_PROFDATA}" merge -o "${PROFILE_DIR}/axnmihn.profdata" ${raw_profiles}
+        RESULT_VARIABLE merge_result)
+    if(NOT merge_result EQUAL 0)
+        message(FATAL_ERROR "llvm-profdata merge failed")
+    endif()
+    message(STATUS "PGO profile: ${PROFILE_DIR}/axnmihn.profdata")
+else()
+    file(GLOB_RECURSE gcda_files "${PROFILE_DIR}/*.gcda")
+    list(LENGTH gcda_files gcda_count)
+    message(STATUS "PGO profile: ${gcda_count} .gcda files in ${PROFILE_DIR}")
+endif()
@@ -0,0 +1,377 @@
+#include "access_sketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace axnmihn {
+namespace sketch {
+
+namespace {
+
+// Forward-decay exponent past which stored counters are rescaled (e^64 ~ 6e27)
+constexpr double MAX_EXPONENT = 64.0;
+
+uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+}  // anonymous namespace
+
+// FNV-1a for stability across runs, finalized so every bit is usable by
+// the HyperLogLog register index and the count-min rows
+uint64_t hash_id(const std::string& s) {
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return mix64(h);
+}
+
+// =============================================================================
+// DistinctCounter
+// =============================================================================
+
+void DistinctCounter::add(uint64_t hash) {
+    if (registers_) {
+        add_dense(hash);
+        return;
+    }
+    for (size_t i = 0; i < sparse_size_; ++i) {
+        if (sparse_[i] == hash) {
+            return;
+        }
+    }
+    if (sparse_size_ < SPARSE_MAX) {
+        sparse_[sparse_size_++] = hash;
+        return;
+    }
+    registers_.reset(new uint8_t[size_t(1) << precision_]());
+    for (size_t i = 0; i < sparse_size_; ++i) {
+        add_dense(sparse_[i]);
+    }
+    add_dense(hash);
+}
+
+void DistinctCounter::add_dense(uint64_t hash) {
+    const size_t index = static_cast<size_t>(hash >> (64 - precision_));
+    const uint64_t rest = hash << precision_;
+    const uint8_t rank = rest == 0
+        ? static_cast<uint8_t>(64 - precision_ + 1)
+        : static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+}
+
+uint64_t DistinctCounter::estimate() const {
+    if (!registers_) {
+        return sparse_size_;
+    }
+    const size_t m = size_t(1) << precision_;
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (size_t i = 0; i < m; ++i) {
+        sum += std::ldexp(1.0, -registers_[i]);
+        zeros += registers_[i] == 0;
+    }
+    double alpha;
+    switch (m) {
+        case 16: alpha = 0.673; break;
+        case 32: alpha = 0.697; break;
+        case 64: alpha = 0.709; break;
+        default: alpha = 0.7213 / (1.0 + 1.079 / static_cast<double>(m)); break;
+    }
+    const double md = static_cast<double>(m);
+    double e = alpha * md * md / sum;
+    if (e <= 2.5 * md && zeros > 0) {
+        e = md * std::log(md / static_cast<double>(zeros));  // Linear counting
+    }
+    return static_cast<uint64_t>(std::llround(e));
+}
+
+void DistinctCounter::clear() {
+    sparse_size_ = 0;
+    registers_.reset();
+}
+
+// =============================================================================
+// AccessSketch
+// =============================================================================
+
+AccessSketch::AccessSketch(SketchOptions options)
+    : options_(options),
+      decay_rate_(options.half_life_seconds > 0.0 ? std::log(2.0) / options.half_life_seconds : 0.0),
+      all_channels_(12) {
+    if (options_.capacity == 0 || options_.capacity > UINT32_MAX) {
+        throw std::invalid_argument("capacity must be in 1..2^32-1");
+    }
+    if (options_.cms_width == 0 || options_.cms_depth == 0) {
+        throw std::invalid_argument("count-min width and depth must be > 0");
+    }
+    if (!(options_.half_life_seconds >= 0.0)) {
+        throw std::invalid_argument("half_life_seconds must be >= 0");
+    }
+    if (options_.channel_precision < 4 || options_.channel_precision > 16) {
+        throw std::invalid_argument("channel_precision must be in 4..16");
+    }
+    entries_.reserve(options_.capacity);
+    heap_.reserve(options_.capacity);
+    index_.reserve(options_.capacity);
+    cms_.assign(options_.cms_width * options_.cms_depth, 0.0);
+}
+
+double AccessSketch::weight_locked(double now) {
+    if (decay_rate_ == 0.0) {
+        return 1.0;
+    }
+    if (!has_landmark_) {
+        landmark_ = now;
+        has_landmark_ = true;
+    }
+    double exponent = decay_rate_ * (now - landmark_);
+    if (exponent > MAX_EXPONENT) {
+        rescale_locked(now);
+        exponent = 0.0;
+    }
+    return std::exp(exponent);
+}
+
+double AccessSketch::scale_at(double now) const {
+    if (decay_rate_ == 0.0 || !has_landmark_) {
+        return 1.0;
+    }
+    return std::exp(decay_rate_ * (now - landmark_));
+}
+
+void AccessSketch::rescale_locked(double now) {
+    // Uniform scaling keeps the heap order, so no re-heapify is needed
+    const double factor = std::exp(-decay_rate_ * (now - landmark_));
+    for (auto& e : entries_) {
+        e.count *= factor;
+        e.error *= factor;
+    }
+    for (auto& cell : cms_) {
+        cell *= factor;
+    }
+    landmark_ = now;
+}
+
+double AccessSketch::cms_add_locked(uint64_t hash, double w) {
+    // Conservative update: raise only the cells below the new estimate
+    const size_t width = options_.cms_width;
+    const uint64_t h1 = hash;
+    const uint64_t h2 = mix64(hash ^ 0x9e3779b97f4a7c15ULL) | 1;
+    const double updated = cms_estimate_locked(hash) + w;
+    for (size_t r = 0; r < options_.cms_depth; ++r) {
+        double& cell = cms_[r * width + (h1 + r * h2) % width];
+        cell = std::max(cell, updated);
+    }
+    return updated;
+}
+
+double AccessSketch::cms_estimate_locked(uint64_t hash) const {
+    const size_t width = options_.cms_width;
+    const uint64_t h1 = hash;
+    const uint64_t h2 = mix64(hash ^ 0x9e3779b97f4a7c15ULL) | 1;
+    double est = cms_[h1 % width];
+    for (size_t r = 1; r < options_.cms_depth; ++r) {
+        est = std::min(est, cms_[r * width + (h1 + r * h2) % width]);
+    }
+    return est;
+}
+
+void AccessSketch::swap_heap_locked(size_t a, size_t b) {
+    std::swap(heap_[a], heap_[b]);
+    entries_[heap_[a]].heap_pos = static_cast<uint32_t>(a);
+    entries_[heap_[b]].heap_pos = static_cast<uint32_t>(b);
+}
+
+void AccessSketch::sift_down_locked(size_t pos) {
+    const size_t n = heap_.size();
+    while (true) {
+        size_t smallest = pos;
+        const size_t left = 2 * pos + 1;
+        const size_t right = left + 1;
+        if (left < n && entries_[heap_[left]].count < entries_[heap_[smallest]].count) {
+            smallest = left;
+        }
+        if (right < n && entries_[heap_[right]].count < entries_[heap_[smallest]].count) {
+            smallest = right;
+        }
+        if (smallest == pos) {
+            return;
+        }
+        swap_heap_locked(pos, smallest);
+        pos = smallest;
+    }
+}
+
+void AccessSketch::sift_up_locked(size_t pos) {
+    while (pos > 0) {
+        const size_t parent = (pos - 1) / 2;
+        if (entries_[heap_[parent]].count <= entries_[heap_[pos]].count) {
+            return;
+        }
+        swap_heap_locked(pos, parent);
+        pos = parent;
+    }
+}
+
+void AccessSketch::touch_locked(const std::string& id, uint64_t hash, uint64_t channel, double w) {
+    const double history = cms_add_locked(hash, w);
+
+    auto it = index_.find(id);
+    if (it != index_.end()) {
+        Entry& e = entries_[it->second];
+        e.count += w;
+        e.channels.add(channel);
+        sift_down_locked(e.heap_pos);
+        return;
+    }
+
+    if (entries_.size() < options_.capacity) {
+        const uint32_t slot = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
+        Entry& e = entries_.back();
+        e.id = id;
+        e.count = w;
+        e.channels = DistinctCounter(options_.channel_precision);
+        e.channels.add(channel);
+        e.heap_pos = static_cast<uint32_t>(heap_.size());
+        heap_.push_back(slot);
+        index_.emplace(id, slot);
+        sift_up_locked(e.heap_pos);
+        return;
+    }
+
+    // Replace the minimum; its count bounds the newcomer's unseen history
+    const uint32_t slot = heap_[0];
+    Entry& e = entries_[slot];
+    index_.erase(e.id);
+    e.count = std::min(e.count + w, history);
+    e.error = e.count - w;
+    e.id = id;
+    e.channels.clear();
+    e.channels.add(channel);
+    index_.emplace(id, slot);
+    sift_down_locked(0);
+    ++evictions_;
+}
+
+void AccessSketch::record(const std::vector<std::string>& ids, const std::string& channel,
+                          double now) {
+    if (ids.empty()) {
+        return;
+    }
+    const uint64_t channel_hash = hash_id(channel);
+    std::lock_guard<std::mutex> lock(mutex_);
+    const double w = weight_locked(now);
+    all_channels_.add(channel_hash);
+    for (const auto& id : ids) {
+        touch_locked(id, hash_id(id), channel_hash, w);
+    }
+    updates_ += ids.size();
+}
+
+std::vector<HotItem> AccessSketch::top(size_t k, double now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<uint32_t> order(entries_.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = static_cast<uint32_t>(i);
+    }
+    k = std::min(k, order.size());
+    std::partial_sort(order.begin(), order.begin() + k, order.end(),
+        [this](uint32_t a, uint32_t b) {
+            if (entries_[a].count != entries_[b].count) {
+                return entries_[a].count > entries_[b].count;
+            }
+            return entries_[a].id < entries_[b].id;
+        });
+
+    const double scale = scale_at(now);
+    std::vector<HotItem> out;
+    out.reserve(k);
+    for (size_t i = 0; i < k; ++i) {
+        const Entry& e = entries_[order[i]];
+        HotItem item;
+        item.id = e.id;
+        item.count = e.count / scale;
+        item.error = e.error / scale;
+        item.channels = e.channels.estimate();
+        out.push_back(std::move(item));
+    }
+    return out;
+}
+
+double AccessSketch::estimate(const std::string& id, double now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(id);
+    const double count = it != index_.end()
+        ? entries_[it->second].count
+        : cms_estimate_locked(hash_id(id));
+    return count / scale_at(now);
+}
+
+uint64_t AccessSketch::channel_count(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(id);
+    return it != index_.end() ? entries_[it->second].channels.estimate() : 0;
+}
+
+std::vector<double> AccessSketch::estimates(const std::vector<std::string>& ids,
+                                            double now) const {
+    std::vector<double> out(ids.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    const double scale = scale_at(now);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        auto it = index_.find(ids[i]);
+        const double count = it != index_.end()
+            ? entries_[it->second].count
+            : cms_estimate_locked(hash_id(ids[i]));
+        out[i] = count / scale;
+    }
+    return out;
+}
+
+std::vector<int32_t> AccessSketch::channel_counts(const std::vector<std::string>& ids) const {
+    std::vector<int32_t> out(ids.size(), 0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        auto it = index_.find(ids[i]);
+        if (it != index_.end()) {
+            out[i] = static_cast<int32_t>(entries_[it->second].channels.estimate());
+        }
+    }
+    return out;
+}
+
+void AccessSketch::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    heap_.clear();
+    index_.clear();
+    std::fill(cms_.begin(), cms_.end(), 0.0);
+    all_channels_.clear();
+    has_landmark_ = false;
+    updates_ = 0;
+    evictions_ = 0;
+}
+
+SketchStats AccessSketch::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SketchStats s;
+    s.tracked = entries_.size();
+    s.capacity = options_.capacity;
+    s.updates = updates_;
+    s.evictions = evictions_;
+    s.distinct_channels = all_channels_.estimate();
+    return s;
+}
+
+}  // namespace sketch
+}  // namespace axnmihn
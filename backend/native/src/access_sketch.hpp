@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace axnmihn {
+namespace sketch {
+
+/**
+ * Distinct-value counter: exact for a handful of values, HyperLogLog after.
+ *
+ * The first SPARSE_MAX distinct 64-bit hashes are kept verbatim, so small
+ * cardinalities (the common case for channels per memory) are exact.
+ * Beyond that the hashes are folded into 2^precision one-byte registers.
+ */
+class DistinctCounter {
+public:
+    static constexpr size_t SPARSE_MAX = 8;
+
+    explicit DistinctCounter(uint8_t precision = 6) : precision_(precision) {}
+
+    void add(uint64_t hash);
+    uint64_t estimate() const;
+    void clear();
+
+private:
+    void add_dense(uint64_t hash);
+
+    uint8_t precision_;
+    uint8_t sparse_size_ = 0;
+    uint64_t sparse_[SPARSE_MAX] = {};
+    std::unique_ptr<uint8_t[]> registers_;  // Allocated when the sparse set overflows
+};
+
+struct SketchOptions {
+    size_t capacity = 4096;          // Tracked (top-k) items
+    double half_life_seconds = 0.0;  // 0 = counts never decay
+    size_t cms_width = 2048;         // Count-min columns per row
+    size_t cms_depth = 4;            // Count-min rows
+    uint8_t channel_precision = 6;   // HyperLogLog precision per tracked item
+};
+
+struct HotItem {
+    std::string id;
+    double count = 0.0;    // Decayed access count (upper bound)
+    double error = 0.0;    // Maximum overestimate in count
+    uint64_t channels = 0; // Distinct channels seen while tracked
+};
+
+struct SketchStats {
+    uint64_t tracked = 0;
+    uint64_t capacity = 0;
+    uint64_t updates = 0;            // Item accesses recorded
+    uint64_t evictions = 0;          // Tracked items replaced by newcomers
+    uint64_t distinct_channels = 0;  // Across every access
+};
+
+/**
+ * Heavy-hitter sketch for memory access tracking.
+ *
+ * Space-saving keeps the `capacity` most accessed ids in an indexed
+ * min-heap; a newcomer replaces the minimum entry and inherits its count
+ * as error. A count-min sketch (conservative update) remembers every id,
+ * so the inherited count is capped by the newcomer's own history and
+ * untracked ids still get an estimate. Each tracked id carries a
+ * DistinctCounter of the channels it was accessed from.
+ *
+ * Counts decay with a half-life using forward decay: an access at time t
+ * adds 2^((t - landmark) / half_life) and queries divide by the weight at
+ * `now`, so decay never touches stored counters (they are rescaled only
+ * when the weight grows large). Memory is fixed at construction:
+ * capacity entries plus cms_width * cms_depth cells.
+ *
+ * All methods are serialized by an internal mutex.
+ */
+class AccessSketch {
+public:
+    explicit AccessSketch(SketchOptions options = SketchOptions());
+
+    /**
+     * Record one access event (no-op for an empty id list).
+     *
+     * Args:
+     *     ids: Memory IDs matched by the access (repeats count twice)
+     *     channel: Channel the access came from
+     *     now: Epoch seconds
+     */
+    void record(const std::vector<std::string>& ids, const std::string& channel, double now);
+
+    /**
+     * Most accessed tracked ids, highest count first (ties by id).
+     *
+     * Args:
+     *     k: Maximum number of items
+     *     now: Epoch seconds the decayed counts are evaluated at
+     */
+    std::vector<HotItem> top(size_t k, double now) const;
+
+    /** Decayed access count: tracked count, else the count-min estimate. */
+    double estimate(const std::string& id, double now) const;
+
+    /** Distinct channels for a tracked id, 0 if untracked. */
+    uint64_t channel_count(const std::string& id) const;
+
+    /** estimate() for each id, as a column. */
+    std::vector<double> estimates(const std::vector<std::string>& ids, double now) const;
+
+    /** channel_count() for each id, as a column. */
+    std::vector<int32_t> channel_counts(const std::vector<std::string>& ids) const;
+
+    void clear();
+
+    SketchStats stats() const;
+
+    const SketchOptions& options() const { return options_; }
+
+private:
+    struct Entry {
+        std::string id;
+        double count = 0.0;   // Forward-decayed (scaled by the landmark weight)
+        double error = 0.0;
+        DistinctCounter channels;
+        uint32_t heap_pos = 0;
+    };
+
+    double weight_locked(double now);
+    double scale_at(double now) const;
+    void rescale_locked(double now);
+    double cms_add_locked(uint64_t hash, double w);
+    double cms_estimate_locked(uint64_t hash) const;
+    void sift_down_locked(size_t pos);
+    void sift_up_locked(size_t pos);
+    void swap_heap_locked(size_t a, size_t b);
+    void touch_locked(const std::string& id, uint64_t hash, uint64_t channel, double w);
+
+    SketchOptions options_;
+    double decay_rate_;   // ln 2 / half_life, 0 = no decay
+    double landmark_ = 0.0;
+    bool has_landmark_ = false;
+
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> heap_;     // Entry indices, min count on top
+    std::unordered_map<std::string, uint32_t> index_;
+    std::vector<double> cms_;        // cms_depth rows of cms_width cells
+    DistinctCounter all_channels_;
+
+    uint64_t updates_ = 0;
+    uint64_t evictions_ = 0;
+};
+
+/** 64-bit string hash used for sketch rows and distinct counts. */
+uint64_t hash_id(const std::string& s);
+
+}  // namespace sketch
+}  // namespace axnmihn
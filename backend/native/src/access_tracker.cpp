@@ -0,0 +1,223 @@
+#include "access_tracker.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace axnmihn {
+namespace access {
+
+namespace {
+
+// FNV-1a plus a finalizer: low bits pick the slot, high bits the shard
+uint64_t hash_id(std::string_view s) {
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+uint64_t double_bits(double v) {
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+double bits_double(uint64_t bits) {
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+size_t round_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+}  // anonymous namespace
+
+struct AccessAccumulator::Entry {
+    Entry(std::string_view key, uint64_t h) : id(key), hash(h) {}
+
+    const std::string id;
+    const uint64_t hash;
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint64_t> last_ts{0};     // double bits
+    std::atomic<uint64_t> channels{0};
+    std::atomic<bool> queued{false};      // On the shard's dirty stack
+    std::atomic<Entry*> next_dirty{nullptr};
+};
+
+struct AccessAccumulator::Table {
+    explicit Table(size_t capacity) : mask(capacity - 1), slots(new std::atomic<Entry*>[capacity]) {
+        for (size_t i = 0; i < capacity; ++i) {
+            slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    size_t mask;
+    std::unique_ptr<std::atomic<Entry*>[]> slots;
+};
+
+struct alignas(64) AccessAccumulator::Shard {
+    std::atomic<Table*> table{nullptr};
+    std::atomic<Entry*> dirty{nullptr};   // Treiber stack of touched entries
+
+    std::mutex insert_mutex;              // Interning and growth only
+    std::vector<std::unique_ptr<Table>> tables;  // Current one last
+    std::vector<std::unique_ptr<Entry>> entries;
+};
+
+AccessAccumulator::AccessAccumulator(size_t num_shards, size_t initial_capacity) {
+    const size_t shards = round_pow2(std::max<size_t>(num_shards, 1));
+    shard_bits_ = 0;
+    while ((size_t(1) << shard_bits_) < shards) {
+        ++shard_bits_;
+    }
+    shards_.reset(new Shard[shards]);
+    const size_t capacity = round_pow2(std::max<size_t>(initial_capacity, 8));
+    for (size_t s = 0; s < shards; ++s) {
+        shards_[s].tables.emplace_back(new Table(capacity));
+        shards_[s].table.store(shards_[s].tables.back().get(), std::memory_order_release);
+    }
+}
+
+AccessAccumulator::~AccessAccumulator() = default;
+
+AccessAccumulator::Shard& AccessAccumulator::shard_for(uint64_t hash) {
+    return shard_bits_ == 0 ? shards_[0] : shards_[hash >> (64 - shard_bits_)];
+}
+
+AccessAccumulator::Entry* AccessAccumulator::find(const Table* table, uint64_t hash,
+                                                  std::string_view id) const {
+    for (size_t i = hash & table->mask;; i = (i + 1) & table->mask) {
+        Entry* e = table->slots[i].load(std::memory_order_acquire);
+        if (e == nullptr) {
+            return nullptr;
+        }
+        if (e->hash == hash && e->id == id) {
+            return e;
+        }
+    }
+}
+
+AccessAccumulator::Entry* AccessAccumulator::intern(Shard& shard, uint64_t hash,
+                                                    std::string_view id) {
+    std::lock_guard<std::mutex> lock(shard.insert_mutex);
+    Table* table = shard.tables.back().get();
+    if (Entry* e = find(table, hash, id)) {
+        return e;  // Interned by another thread meanwhile
+    }
+
+    // Keep the load factor under 1/2 so probes stay short and never cycle
+    if ((shard.entries.size() + 1) * 2 > table->mask + 1) {
+        auto grown = std::make_unique<Table>((table->mask + 1) * 2);
+        for (const auto& entry : shard.entries) {
+            size_t i = entry->hash & grown->mask;
+            while (grown->slots[i].load(std::memory_order_relaxed) != nullptr) {
+                i = (i + 1) & grown->mask;
+            }
+            grown->slots[i].store(entry.get(), std::memory_order_relaxed);
+        }
+        table = grown.get();
+        shard.tables.push_back(std::move(grown));
+        shard.table.store(table, std::memory_order_release);
+    }
+
+    shard.entries.emplace_back(new Entry(id, hash));
+    Entry* e = shard.entries.back().get();
+    size_t i = hash & table->mask;
+    while (table->slots[i].load(std::memory_order_relaxed) != nullptr) {
+        i = (i + 1) & table->mask;
+    }
+    table->slots[i].store(e, std::memory_order_release);
+    return e;
+}
+
+void AccessAccumulator::track(std::string_view id, double timestamp, uint64_t channel_mask) {
+    const uint64_t hash = hash_id(id);
+    Shard& shard = shard_for(hash);
+    Entry* e = find(shard.table.load(std::memory_order_acquire), hash, id);
+    if (e == nullptr) {
+        e = intern(shard, hash, id);
+    }
+
+    if (channel_mask) {
+        e->channels.fetch_or(channel_mask, std::memory_order_relaxed);
+    }
+    const uint64_t ts_bits = double_bits(timestamp);
+    uint64_t seen = e->last_ts.load(std::memory_order_relaxed);
+    while (bits_double(seen) < timestamp &&
+           !e->last_ts.compare_exchange_weak(seen, ts_bits, std::memory_order_relaxed)) {
+    }
+    e->count.fetch_add(1, std::memory_order_seq_cst);
+
+    // First access since the entry was last drained: queue it
+    if (!e->queued.exchange(true, std::memory_order_seq_cst)) {
+        Entry* head = shard.dirty.load(std::memory_order_relaxed);
+        do {
+            e->next_dirty.store(head, std::memory_order_relaxed);
+        } while (!shard.dirty.compare_exchange_weak(head, e, std::memory_order_release,
+                                                    std::memory_order_relaxed));
+        pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+    accesses_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AccessAccumulator::track_many(const std::vector<std::string>& ids, double timestamp,
+                                   uint64_t channel_mask) {
+    for (const auto& id : ids) {
+        track(id, timestamp, channel_mask);
+    }
+}
+
+AccessColumns AccessAccumulator::drain() {
+    AccessColumns out;
+    const size_t shards = size_t(1) << shard_bits_;
+    for (size_t s = 0; s < shards; ++s) {
+        Entry* e = shards_[s].dirty.exchange(nullptr, std::memory_order_acquire);
+        while (e != nullptr) {
+            Entry* next = e->next_dirty.load(std::memory_order_relaxed);
+            // Unqueue before taking the count: an access after this point
+            // either lands in the count taken below or re-queues the entry
+            e->queued.store(false, std::memory_order_seq_cst);
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            const uint32_t count = e->count.exchange(0, std::memory_order_seq_cst);
+            if (count > 0) {
+                out.ids.push_back(e->id);
+                out.count.push_back(static_cast<int32_t>(count));
+                out.last_ts.push_back(bits_double(e->last_ts.load(std::memory_order_relaxed)));
+                out.channels.push_back(e->channels.exchange(0, std::memory_order_relaxed));
+            }
+            e = next;
+        }
+    }
+    drains_.fetch_add(1, std::memory_order_relaxed);
+    return out;
+}
+
+AccumulatorStats AccessAccumulator::stats() const {
+    AccumulatorStats s;
+    const size_t shards = size_t(1) << shard_bits_;
+    for (size_t i = 0; i < shards; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].insert_mutex);
+        s.interned += shards_[i].entries.size();
+    }
+    s.pending = pending_.load(std::memory_order_relaxed);
+    s.accesses = accesses_.load(std::memory_order_relaxed);
+    s.drains = drains_.load(std::memory_order_relaxed);
+    return s;
+}
+
+}  // namespace access
+}  // namespace axnmihn
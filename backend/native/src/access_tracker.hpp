@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace axnmihn {
+namespace access {
+
+/**
+ * Coalesced accesses taken by drain(), one row per memory id.
+ */
+struct AccessColumns {
+    std::vector<std::string> ids;
+    std::vector<int32_t> count;       // Accesses since the previous drain
+    std::vector<double> last_ts;      // Latest access time (epoch seconds)
+    std::vector<uint64_t> channels;   // OR of the channel bits seen
+
+    size_t size() const { return ids.size(); }
+};
+
+struct AccumulatorStats {
+    uint64_t interned = 0;   // Distinct ids ever seen
+    uint64_t pending = 0;    // Ids with accesses not yet drained
+    uint64_t accesses = 0;   // track() calls
+    uint64_t drains = 0;
+};
+
+/**
+ * Concurrent access accumulator for memory ids.
+ *
+ * Ids are interned into per-shard open-addressing tables of stable
+ * entries. An access to a known id is lock-free: a probe plus a
+ * fetch_add on the count, a max on last_ts and a fetch_or on the channel
+ * mask. The first access since the last drain also pushes the entry onto
+ * the shard's dirty stack, so drain() only visits ids that were touched.
+ * Only the first access to a new id takes the shard's insert lock.
+ *
+ * Tables grow by copying entry pointers into a larger table; old tables
+ * stay alive until destruction so a racing lookup still reaches the same
+ * entry. Interned ids are never freed (memory is O(distinct ids)).
+ *
+ * An access racing drain() is counted exactly once, but its channel bit
+ * may be reported by a different drain than its count.
+ */
+class AccessAccumulator {
+public:
+    /**
+     * Args:
+     *     num_shards: Shard count (rounded up to a power of two)
+     *     initial_capacity: Slots per shard before the first growth
+     */
+    explicit AccessAccumulator(size_t num_shards = 16, size_t initial_capacity = 1024);
+    ~AccessAccumulator();
+    AccessAccumulator(const AccessAccumulator&) = delete;
+    AccessAccumulator& operator=(const AccessAccumulator&) = delete;
+
+    /**
+     * Record one access.
+     *
+     * Args:
+     *     id: Memory id
+     *     timestamp: Epoch seconds
+     *     channel_mask: Channel bits to OR into the entry (0 = none)
+     */
+    void track(std::string_view id, double timestamp, uint64_t channel_mask = 0);
+
+    /** track() for each id with one timestamp and mask. */
+    void track_many(const std::vector<std::string>& ids, double timestamp,
+                    uint64_t channel_mask = 0);
+
+    /**
+     * Take every pending access and reset the counts.
+     *
+     * Returns:
+     *     One row per id accessed since the previous drain
+     */
+    AccessColumns drain();
+
+    /** Ids with accesses not yet drained (approximate under concurrency). */
+    uint64_t pending() const { return pending_.load(std::memory_order_relaxed); }
+
+    AccumulatorStats stats() const;
+
+private:
+    struct Entry;
+    struct Table;
+    struct Shard;
+
+    Shard& shard_for(uint64_t hash);
+    Entry* find(const Table* table, uint64_t hash, std::string_view id) const;
+    Entry* intern(Shard& shard, uint64_t hash, std::string_view id);
+
+    size_t shard_bits_;
+    std::unique_ptr<Shard[]> shards_;
+
+    std::atomic<uint64_t> pending_{0};
+    std::atomic<uint64_t> accesses_{0};
+    std::atomic<uint64_t> drains_{0};
+};
+
+}  // namespace access
+}  // namespace axnmihn
@@ -0,0 +1,195 @@
+#include "accuracy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <unordered_set>
+
+namespace axnmihn {
+namespace accuracy {
+
+double ErrorStats::rmse() const {
+    return count ? std::sqrt(sum_sq / static_cast<double>(count)) : 0.0;
+}
+
+void ErrorStats::merge(const ErrorStats& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0 || other.max_abs > max_abs) {
+        max_abs = other.max_abs;
+        worst_index = other.worst_index;
+    }
+    count += other.count;
+    sum_abs += other.sum_abs;
+    sum_sq += other.sum_sq;
+    max_rel = std::max(max_rel, other.max_rel);
+}
+
+ErrorStats compare_values(StridedView<double> approx, StridedView<double> exact, size_t n) {
+    ErrorStats stats;
+    stats.count = n;
+    for (size_t i = 0; i < n; ++i) {
+        const double e = exact[i];
+        const double err = std::fabs(approx[i] - e);
+        if (err > stats.max_abs) {
+            stats.max_abs = err;
+            stats.worst_index = i;
+        }
+        stats.sum_abs += err;
+        stats.sum_sq += err * err;
+        stats.max_rel = std::max(stats.max_rel, err / std::max(std::fabs(e), 1e-12));
+    }
+    return stats;
+}
+
+std::vector<int64_t> top_k(StridedView<double> scores, size_t n, size_t k) {
+    k = std::min(k, n);
+    std::vector<int64_t> idx(n);
+    std::iota(idx.begin(), idx.end(), int64_t{0});
+    auto better = [&](int64_t a, int64_t b) {
+        const double sa = scores[static_cast<size_t>(a)];
+        const double sb = scores[static_cast<size_t>(b)];
+        return sa > sb || (sa == sb && a < b);
+    };
+    std::partial_sort(idx.begin(), idx.begin() + static_cast<std::ptrdiff_t>(k), idx.end(), better);
+    idx.resize(k);
+    return idx;
+}
+
+double recall_at_k(const int64_t* approx, size_t n_approx,
+                   const int64_t* exact, size_t n_exact, size_t k) {
+    const size_t want = std::min(k, n_exact);
+    if (want == 0) {
+        return 1.0;
+    }
+    std::unordered_set<int64_t> truth(exact, exact + want);
+    size_t hits = 0;
+    for (size_t i = 0; i < std::min(k, n_approx); ++i) {
+        hits += truth.count(approx[i]);
+    }
+    return static_cast<double>(hits) / static_cast<double>(want);
+}
+
+double SetAgreement::jaccard() const {
+    const size_t united = approx + exact - common;
+    return united ? static_cast<double>(common) / static_cast<double>(united) : 1.0;
+}
+
+namespace {
+
+uint64_t pair_key(int64_t a, int64_t b) {
+    if (a > b) {
+        std::swap(a, b);
+    }
+    return (static_cast<uint64_t>(a) << 32) ^ static_cast<uint64_t>(b);
+}
+
+std::unordered_set<uint64_t> pair_set(const PairList& pairs) {
+    std::unordered_set<uint64_t> keys;
+    keys.reserve(pairs.size());
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        keys.insert(pair_key(pairs.first[i], pairs.second[i]));
+    }
+    return keys;
+}
+
+}  // anonymous namespace
+
+SetAgreement pair_agreement(const PairList& approx, const PairList& exact) {
+    const std::unordered_set<uint64_t> a = pair_set(approx);
+    const std::unordered_set<uint64_t> e = pair_set(exact);
+    SetAgreement result;
+    result.approx = a.size();
+    result.exact = e.size();
+    for (uint64_t key : a) {
+        result.common += e.count(key);
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Runtime sampling
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// Rate scaled to 2^32 so the hot path compares integers
+std::atomic<uint64_t> g_threshold{0};
+
+struct Registry {
+    std::mutex mutex;
+    std::map<std::string, MetricStats> metrics;
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+}  // anonymous namespace
+
+void set_sample_rate(double rate) {
+    rate = std::min(1.0, std::max(0.0, rate));
+    g_threshold.store(static_cast<uint64_t>(rate * 4294967296.0), std::memory_order_relaxed);
+}
+
+double sample_rate() {
+    return static_cast<double>(g_threshold.load(std::memory_order_relaxed)) / 4294967296.0;
+}
+
+bool should_sample() {
+    const uint64_t threshold = g_threshold.load(std::memory_order_relaxed);
+    if (threshold == 0) {
+        return false;
+    }
+    // xorshift64*, seeded per thread from its address
+    thread_local uint64_t state = reinterpret_cast<uintptr_t>(&state) | 1;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    const uint64_t draw = (state * 0x2545F4914F6CDD1Dull) >> 32;
+    return draw < threshold;
+}
+
+void record_error(const std::string& metric, const ErrorStats& stats) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    MetricStats& m = reg.metrics[metric];
+    m.name = metric;
+    m.samples += 1;
+    m.error.merge(stats);
+}
+
+void record_recall(const std::string& metric, double recall) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    MetricStats& m = reg.metrics[metric];
+    m.name = metric;
+    m.recall_samples += 1;
+    m.recall_sum += recall;
+    m.recall_min = std::min(m.recall_min, recall);
+}
+
+std::vector<MetricStats> metrics() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<MetricStats> result;
+    result.reserve(reg.metrics.size());
+    for (const auto& entry : reg.metrics) {
+        result.push_back(entry.second);
+    }
+    return result;
+}
+
+void reset_metrics() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.metrics.clear();
+}
+
+}  // namespace accuracy
+}  // namespace axnmihn
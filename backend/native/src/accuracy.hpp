@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "pair_list.hpp"
+#include "strided.hpp"
+
+namespace axnmihn {
+namespace accuracy {
+
+/**
+ * Differential accuracy metrics for approximate kernels.
+ *
+ * Each fast kernel (fast-math decay, float32 engine scan, and later
+ * quantized / hashed indexes) is checked against an exact reference. The
+ * same metrics serve the offline harness, where both sides run over
+ * large inputs, and runtime sampling, where a small fraction of calls
+ * also run the reference on a subset of their elements.
+ */
+
+/**
+ * Element-wise error between an approximate and an exact result.
+ */
+struct ErrorStats {
+    size_t count = 0;
+    double max_abs = 0.0;
+    double sum_abs = 0.0;
+    double sum_sq = 0.0;
+    double max_rel = 0.0;     // |a - e| / max(|e|, 1e-12)
+    size_t worst_index = 0;   // index of max_abs
+
+    double mean_abs() const { return count ? sum_abs / static_cast<double>(count) : 0.0; }
+    double rmse() const;
+
+    /** Fold another batch in (worst_index is kept from whichever has the larger max_abs). */
+    void merge(const ErrorStats& other);
+};
+
+/**
+ * Compare n values element by element.
+ *
+ * Args:
+ *     approx: Values from the fast kernel
+ *     exact: Values from the reference
+ *     n: Number of elements
+ *
+ * Returns:
+ *     Max/mean absolute error, max relative error and RMSE
+ */
+ErrorStats compare_values(StridedView<double> approx, StridedView<double> exact, size_t n);
+
+/**
+ * Indices of the k largest scores, best first (ties broken by index).
+ */
+std::vector<int64_t> top_k(StridedView<double> scores, size_t n, size_t k);
+
+/**
+ * recall@k: |approx[:k] ∩ exact[:k]| / min(k, |exact|). 1.0 when exact is empty.
+ */
+double recall_at_k(const int64_t* approx, size_t n_approx,
+                   const int64_t* exact, size_t n_exact, size_t k);
+
+/**
+ * Agreement between two duplicate-pair sets (pairs are unordered).
+ */
+struct SetAgreement {
+    size_t approx = 0;
+    size_t exact = 0;
+    size_t common = 0;
+
+    double precision() const { return approx ? static_cast<double>(common) / approx : 1.0; }
+    double recall() const { return exact ? static_cast<double>(common) / exact : 1.0; }
+    double jaccard() const;
+};
+
+SetAgreement pair_agreement(const PairList& approx, const PairList& exact);
+
+// ---------------------------------------------------------------------------
+// Runtime sampling
+// ---------------------------------------------------------------------------
+
+/**
+ * Fraction of eligible calls (0-1) that also run their exact reference.
+ * 0 (the default) disables sampling; the check is then one relaxed load.
+ */
+void set_sample_rate(double rate);
+double sample_rate();
+
+/** Elements re-checked per sampled call, spread evenly over the batch. */
+constexpr size_t SAMPLE_ELEMENTS = 64;
+
+/**
+ * Decide whether the current call is sampled (thread-local RNG, no locks).
+ */
+bool should_sample();
+
+/**
+ * Accumulated metrics for one named approximate kernel.
+ */
+struct MetricStats {
+    std::string name;
+    uint64_t samples = 0;        // sampled calls that recorded element errors
+    ErrorStats error;            // merged element errors
+    uint64_t recall_samples = 0;
+    double recall_sum = 0.0;
+    double recall_min = 1.0;
+
+    double mean_recall() const {
+        return recall_samples ? recall_sum / static_cast<double>(recall_samples) : 1.0;
+    }
+};
+
+/** Record one sampled call's element errors under `metric`. */
+void record_error(const std::string& metric, const ErrorStats& stats);
+
+/** Record one sampled call's recall@k under `metric`. */
+void record_recall(const std::string& metric, double recall);
+
+std::vector<MetricStats> metrics();
+void reset_metrics();
+
+}  // namespace accuracy
+}  // namespace axnmihn
@@ -0,0 +1,122 @@
+#include "arena.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+namespace axnmihn {
+namespace alloc {
+
+namespace {
+
+// Chunks are 64-byte aligned so AVX loads from arena buffers never split
+constexpr size_t CHUNK_ALIGN = 64;
+
+std::atomic<uint64_t> g_arenas{0};
+std::atomic<uint64_t> g_chunk_allocs{0};
+std::atomic<uint64_t> g_chunk_frees{0};
+std::atomic<uint64_t> g_bytes_reserved{0};
+std::atomic<uint64_t> g_high_water{0};
+
+void raise_high_water(uint64_t value) {
+    uint64_t seen = g_high_water.load(std::memory_order_relaxed);
+    while (value > seen &&
+           !g_high_water.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+}  // anonymous namespace
+
+Arena::Arena() {
+    g_arenas.fetch_add(1, std::memory_order_relaxed);
+}
+
+Arena::~Arena() {
+    for (const Chunk& c : chunks_) {
+        ::operator delete(c.data, std::align_val_t(CHUNK_ALIGN));
+    }
+    g_chunk_frees.fetch_add(chunks_.size(), std::memory_order_relaxed);
+    g_bytes_reserved.fetch_sub(reserved_, std::memory_order_relaxed);
+    g_arenas.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void* Arena::allocate(size_t bytes, size_t align) {
+    if (bytes == 0) {
+        bytes = 1;
+    }
+    // Bump within the current chunk, moving on to later (retained) chunks
+    while (current_ < chunks_.size()) {
+        const Chunk& c = chunks_[current_];
+        const size_t start = (offset_ + align - 1) & ~(align - 1);
+        if (start + bytes <= c.size) {
+            used_ += start + bytes - offset_;
+            offset_ = start + bytes;
+            if (used_ > high_water_) {
+                high_water_ = used_;
+                raise_high_water(high_water_);
+            }
+            return c.data + start;
+        }
+        used_ += c.size - offset_;
+        ++current_;
+        offset_ = 0;
+    }
+
+    // Out of chunks: grow geometrically so a large call needs few of them
+    const size_t size = std::max({MIN_CHUNK, reserved_, bytes});
+    char* data = static_cast<char*>(::operator new(size, std::align_val_t(CHUNK_ALIGN)));
+    chunks_.push_back(Chunk{data, size});
+    reserved_ += size;
+    g_chunk_allocs.fetch_add(1, std::memory_order_relaxed);
+    g_bytes_reserved.fetch_add(size, std::memory_order_relaxed);
+    current_ = chunks_.size() - 1;
+    offset_ = 0;
+    return allocate(bytes, align);
+}
+
+void Arena::rewind(const Mark& m) {
+    current_ = m.chunk;
+    offset_ = m.offset;
+    used_ = m.used;
+}
+
+void Arena::trim() {
+    // Free unused chunks from the back until the retained size fits
+    while (reserved_ > RETAIN_BYTES && chunks_.size() > current_ + 1) {
+        const Chunk c = chunks_.back();
+        chunks_.pop_back();
+        ::operator delete(c.data, std::align_val_t(CHUNK_ALIGN));
+        reserved_ -= c.size;
+        g_chunk_frees.fetch_add(1, std::memory_order_relaxed);
+        g_bytes_reserved.fetch_sub(c.size, std::memory_order_relaxed);
+    }
+}
+
+Arena& thread_arena() {
+    thread_local Arena arena;
+    return arena;
+}
+
+ArenaScope::ArenaScope(Arena& arena) : arena_(arena), mark_(arena.mark()) {
+    ++arena_.depth_;
+}
+
+ArenaScope::~ArenaScope() {
+    arena_.rewind(mark_);
+    if (--arena_.depth_ == 0) {
+        arena_.trim();
+    }
+}
+
+ArenaStats arena_stats() {
+    ArenaStats s;
+    s.arenas = g_arenas.load(std::memory_order_relaxed);
+    s.chunk_allocs = g_chunk_allocs.load(std::memory_order_relaxed);
+    s.chunk_frees = g_chunk_frees.load(std::memory_order_relaxed);
+    s.bytes_reserved = g_bytes_reserved.load(std::memory_order_relaxed);
+    s.high_water = g_high_water.load(std::memory_order_relaxed);
+    return s;
+}
+
+}  // namespace alloc
+}  // namespace axnmihn
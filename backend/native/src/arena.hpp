@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+namespace axnmihn {
+namespace alloc {
+
+/**
+ * Monotonic (bump) allocator for call-scoped temporaries.
+ *
+ * Memory comes from a list of chunks that are kept between calls, so a
+ * kernel that rewinds its scope on exit reaches a steady state with no
+ * heap allocation at all. Individual frees are no-ops; everything
+ * allocated after a mark is released together by rewind().
+ *
+ * One arena per thread (thread_arena()); an Arena is not thread-safe.
+ */
+class Arena {
+public:
+    /** Smallest chunk requested from the heap. */
+    static constexpr size_t MIN_CHUNK = 64 * 1024;
+    /** Chunks kept after the outermost scope exits; larger ones are freed. */
+    static constexpr size_t RETAIN_BYTES = 16 * 1024 * 1024;
+
+    struct Mark {
+        size_t chunk = 0;
+        size_t offset = 0;
+        size_t used = 0;
+    };
+
+    Arena();
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * Allocate `bytes` with the given alignment (power of two, <= 64).
+     *
+     * Args:
+     *     bytes: Size in bytes
+     *     align: Required alignment
+     *
+     * Returns:
+     *     Pointer valid until the enclosing mark is rewound
+     */
+    void* allocate(size_t bytes, size_t align);
+
+    Mark mark() const { return Mark{current_, offset_, used_}; }
+
+    /** Release everything allocated since `m`. */
+    void rewind(const Mark& m);
+
+    size_t used() const { return used_; }
+    size_t reserved() const { return reserved_; }
+
+private:
+    friend class ArenaScope;
+
+    struct Chunk {
+        char* data;
+        size_t size;
+    };
+
+    void trim();
+
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0;   // chunk being bumped
+    size_t offset_ = 0;    // next free byte in chunks_[current_]
+    size_t used_ = 0;      // bytes handed out since the arena was empty
+    size_t reserved_ = 0;  // sum of chunk sizes
+    size_t high_water_ = 0;
+    int depth_ = 0;        // open ArenaScopes
+};
+
+/** The calling thread's arena. */
+Arena& thread_arena();
+
+/**
+ * RAII scope over an arena: everything allocated through it (or through
+ * the arena directly) while it is open is released when it closes.
+ * Scopes nest; the outermost one also trims oversized chunks.
+ */
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena = thread_arena());
+    ~ArenaScope();
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    /** Uninitialised storage for n objects of trivially destructible T. */
+    template<typename T>
+    T* array(size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "arena memory is released without running destructors");
+        return static_cast<T*>(arena_.allocate(n * sizeof(T), alignof(T)));
+    }
+
+    Arena& arena() { return arena_; }
+
+private:
+    Arena& arena_;
+    Arena::Mark mark_;
+};
+
+/**
+ * std-compatible allocator drawing from an Arena (deallocate is a no-op).
+ * Containers using it must not outlive the ArenaScope they were built in.
+ */
+template<typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    Arena* arena;
+
+    explicit ArenaAllocator(Arena& a) : arena(&a) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) {}
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template<typename T>
+using ArenaSet = std::unordered_set<T, std::hash<T>, std::equal_to<T>, ArenaAllocator<T>>;
+
+/**
+ * Arena counters summed over all arenas (live and destroyed).
+ */
+struct ArenaStats {
+    uint64_t arenas = 0;          // live arenas (one per thread that used one)
+    uint64_t chunk_allocs = 0;    // heap allocations for chunks
+    uint64_t chunk_frees = 0;
+    uint64_t bytes_reserved = 0;  // currently held by all arenas
+    uint64_t high_water = 0;      // largest in-use size seen in one arena
+};
+
+ArenaStats arena_stats();
+
+}  // namespace alloc
+}  // namespace axnmihn
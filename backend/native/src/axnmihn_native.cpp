@@ -2,11 +2,45 @@
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "access_sketch.hpp"
+#include "access_tracker.hpp"
+#include "accuracy.hpp"
+#include "arena.hpp"
+#include "buffer_pool.hpp"
+#include "content_hash.hpp"
 #include "decay.hpp"
+#include "event_ring.hpp"
+#include "simhash.hpp"
 #include "vector_ops.hpp"
 #include "graph_ops.hpp"
+#include "interaction_log.hpp"
 #include "string_ops.hpp"
 #include "text_ops.hpp"
+#include "pair_list.hpp"
+#include "pq.hpp"
+#include "projection.hpp"
+#include "linear_map.hpp"
+#include "knn_graph.hpp"
+#include "pgvector_codec.hpp"
+#include "pg_copy.hpp"
+#include "strided.hpp"
+#include "cancel.hpp"
+#include "thread_pool.hpp"
+#include "memory_engine.hpp"
+#include "simd.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include "unicode_norm.hpp"
 
 namespace py = pybind11;
 
@@ -16,6 +50,490 @@ const T* get_array_ptr(py::array_t<T>& arr) {
     return arr.data();
 }
 
+// Hand a std::vector's buffer to NumPy without copying.
+// The vector is moved to the heap and freed by the capsule when the
+// array (and every view of it) is garbage collected; pooled vectors
+// return their buffer to the buffer pool at that point.
+template<typename T, typename Alloc>
+py::array_t<T> vector_to_numpy(std::vector<T, Alloc>&& vec) {
+    auto* owned = new std::vector<T, Alloc>(std::move(vec));
+    py::capsule owner(owned, [](void* p) {
+        delete static_cast<std::vector<T, Alloc>*>(p);
+    });
+    return py::array_t<T>(static_cast<py::ssize_t>(owned->size()), owned->data(), owner);
+}
+
+// Pair results come back as three parallel arrays: (i, j, similarity).
+py::tuple pairs_to_numpy(axnmihn::PairList&& pairs) {
+    return py::make_tuple(
+        vector_to_numpy(std::move(pairs.first)),
+        vector_to_numpy(std::move(pairs.second)),
+        vector_to_numpy(std::move(pairs.similarity)));
+}
+
+// Strict mode: raise instead of silently copying inputs that need conversion
+std::atomic<bool> g_strict_arrays{false};
+
+template<typename T>
+std::string dtype_name() {
+    return py::str(py::dtype::of<T>()).cast<std::string>();
+}
+
+// Borrow `obj` as an array of T. Arrays that already have the right dtype
+// are used in place with whatever strides they have; anything else needs a
+// converting copy, which raises TypeError in strict mode.
+template<typename T>
+py::array_t<T> borrow_array(py::handle obj, const char* name) {
+    if (py::isinstance<py::array_t<T>>(obj)) {
+        return py::reinterpret_borrow<py::array_t<T>>(obj);
+    }
+    if (g_strict_arrays.load(std::memory_order_relaxed)) {
+        throw py::type_error(std::string(name) + ": expected a " + dtype_name<T>() +
+                             " array; converting would copy (strict mode)");
+    }
+    auto converted = py::array_t<T>::ensure(obj);
+    if (!converted) {
+        throw py::type_error(std::string(name) + ": cannot convert to a " +
+                             dtype_name<T>() + " array");
+    }
+    return converted;
+}
+
+// Length of a 1-D array, or ValueError
+template<typename T>
+py::ssize_t length_1d(const py::array_t<T>& arr, const char* name) {
+    if (arr.ndim() != 1) {
+        throw py::value_error(std::string(name) + ": expected a 1-D array");
+    }
+    return arr.shape(0);
+}
+
+template<typename T>
+axnmihn::StridedView<T> view_1d(const py::array_t<T>& arr, py::ssize_t n, const char* name) {
+    if (length_1d(arr, name) != n) {
+        throw py::value_error(std::string(name) + ": expected length " + std::to_string(n) +
+                              ", got " + std::to_string(arr.shape(0)));
+    }
+    return axnmihn::StridedView<T>(arr.data(), arr.strides(0));
+}
+
+template<typename T>
+axnmihn::StridedMatrix<T> view_2d(const py::array_t<T>& arr, const char* name) {
+    if (arr.ndim() != 2) {
+        throw py::value_error(std::string(name) + ": expected a 2-D array");
+    }
+    return axnmihn::StridedMatrix<T>(
+        arr.data(), static_cast<size_t>(arr.shape(0)), static_cast<size_t>(arr.shape(1)),
+        arr.strides(0), arr.strides(1));
+}
+
+// Result buffer: a fresh array, or the caller's `out=` array (any stride)
+// so steady-state loops can run without allocating.
+template<typename T>
+py::array_t<T> output_array(const py::object& out, py::ssize_t n) {
+    if (out.is_none()) {
+        return py::array_t<T>(n);
+    }
+    if (!py::isinstance<py::array_t<T>>(out)) {
+        throw py::type_error("out: expected a " + dtype_name<T>() + " array");
+    }
+    auto arr = py::reinterpret_borrow<py::array_t<T>>(out);
+    if (arr.ndim() != 1 || arr.shape(0) != n) {
+        throw py::value_error("out: expected shape (" + std::to_string(n) + ",)");
+    }
+    if (!arr.writeable()) {
+        throw py::value_error("out: array is read-only");
+    }
+    return arr;
+}
+
+template<typename T>
+axnmihn::MutableStridedView<T> mutable_view(py::array_t<T>& arr) {
+    return axnmihn::MutableStridedView<T>(arr.mutable_data(), arr.strides(0));
+}
+
+// ---------------------------------------------------------------------------
+// Call counters (native.stats())
+// ---------------------------------------------------------------------------
+
+// Entry points open a CallScope with a per-site probe; the scope covers
+// the binding body (input borrowing, kernel, result conversion) and the
+// kernel section is timed separately so marshalling = total - kernel.
+// Arguments pybind11 converts before the body runs are not included.
+
+template<typename T>
+uint64_t array_bytes(const py::array_t<T>& arr) {
+    return static_cast<uint64_t>(arr.nbytes());
+}
+
+// Bind a plain kernel function with call counting (one element per call)
+template<typename R, typename... Args>
+auto counted(const char* name, R (*fn)(Args...)) {
+    const uint32_t probe = axnmihn::stats::register_probe(name);
+    return [probe, fn](Args... args) -> R {
+        axnmihn::stats::CallScope call(probe);
+        call.elements(1);
+        auto timer = call.kernel();
+        return fn(std::forward<Args>(args)...);
+    };
+}
+
+py::dict error_to_python(const axnmihn::accuracy::ErrorStats& e) {
+    py::dict d;
+    d["count"] = e.count;
+    d["max_abs"] = e.max_abs;
+    d["mean_abs"] = e.mean_abs();
+    d["max_rel"] = e.max_rel;
+    d["rmse"] = e.rmse();
+    d["worst_index"] = e.worst_index;
+    return d;
+}
+
+// Events come back as (seq, type, timestamp, event_id, metadata bytes)
+py::list events_to_python(std::vector<axnmihn::events::Event>&& events) {
+    py::list out(events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        auto& e = events[i];
+        out[i] = py::make_tuple(e.seq, e.type, e.timestamp, e.event_id,
+                                e.metadata_lost ? py::object(py::none()) : py::object(py::bytes(e.metadata)));
+    }
+    return out;
+}
+
+// Dictionary-encoded string column as (codes array, dictionary list)
+py::tuple string_column_to_python(axnmihn::ilog::StringColumn&& column) {
+    py::list dictionary(column.dictionary.size());
+    for (size_t i = 0; i < column.dictionary.size(); ++i) {
+        dictionary[i] = py::str(column.dictionary[i]);
+    }
+    return py::make_tuple(vector_to_numpy(std::move(column.codes)), dictionary);
+}
+
+// (i, j[, sim]) arrays as returned by the find_duplicates* bindings
+axnmihn::PairList pairs_from_python(py::handle obj, const char* name) {
+    py::sequence seq = py::reinterpret_borrow<py::sequence>(obj);
+    if (py::len(seq) < 2) {
+        throw py::value_error(std::string(name) + ": expected (i, j[, sim]) arrays");
+    }
+    auto first = borrow_array<int64_t>(seq[0], name);
+    auto second = borrow_array<int64_t>(seq[1], name);
+    const py::ssize_t n = length_1d(first, name);
+    auto first_view = view_1d(first, n, name);
+    auto second_view = view_1d(second, n, name);
+    axnmihn::PairList pairs;
+    for (py::ssize_t k = 0; k < n; ++k) {
+        pairs.add(static_cast<size_t>(first_view[k]), static_cast<size_t>(second_view[k]), 0.0);
+    }
+    return pairs;
+}
+
+py::dict stats_to_python(const std::vector<axnmihn::stats::ProbeStats>& snapshot) {
+    py::dict result;
+    for (const auto& s : snapshot) {
+        py::list buckets;
+        for (size_t b = 0; b < s.buckets.size(); ++b) {
+            if (s.buckets[b]) {
+                buckets.append(py::make_tuple(axnmihn::stats::bucket_upper_bound(b), s.buckets[b]));
+            }
+        }
+        py::dict entry;
+        entry["calls"] = s.calls;
+        entry["elements"] = s.elements;
+        entry["bytes_in"] = s.bytes_in;
+        entry["bytes_out"] = s.bytes_out;
+        entry["total_ns"] = s.total_ns;
+        entry["kernel_ns"] = s.kernel_ns;
+        entry["max_ns"] = s.max_ns;
+        entry["p50_ns"] = s.percentile(0.50);
+        entry["p90_ns"] = s.percentile(0.90);
+        entry["p99_ns"] = s.percentile(0.99);
+        entry["buckets"] = buckets;
+        result[py::str(s.name)] = entry;
+    }
+    return result;
+}
+
+// Engine methods report unknown memory ids as std::out_of_range;
+// Python callers get KeyError like a dict lookup.
+template<typename Fn>
+void with_memory_id(Fn fn) {
+    try {
+        fn();
+    } catch (const std::out_of_range& e) {
+        throw py::key_error(e.what());
+    }
+}
+
+// Optional input column: the caller's array, or `fallback` broadcast with
+// a zero stride when the argument is None. `holder` keeps a converted
+// array alive for as long as the view is used.
+template<typename T>
+axnmihn::StridedView<T> optional_column(
+    const py::object& obj, py::ssize_t n, const char* name,
+    const T* fallback, py::array_t<T>& holder) {
+    if (obj.is_none()) {
+        return axnmihn::StridedView<T>(fallback, 0);
+    }
+    holder = borrow_array<T>(obj, name);
+    return view_1d(holder, n, name);
+}
+
+// Field view of a structured array, checked against the expected C type
+template<typename T>
+axnmihn::StridedView<T> record_field(const py::array& arr, const char* name) {
+    py::object fields = arr.dtype().attr("fields");
+    if (!fields.contains(name)) {
+        throw py::value_error(std::string("records: missing field '") + name + "'");
+    }
+    auto field = fields[name].cast<py::tuple>();
+    auto field_dtype = field[0].cast<py::dtype>();
+    const char expected_kind = std::is_floating_point<T>::value ? 'f' : 'i';
+    if (field_dtype.kind() != expected_kind ||
+        field_dtype.itemsize() != static_cast<py::ssize_t>(sizeof(T)) ||
+        !field_dtype.attr("isnative").cast<bool>()) {
+        throw py::type_error(std::string("records: field '") + name + "' must be " +
+                             dtype_name<T>());
+    }
+    auto offset = field[1].cast<py::ssize_t>();
+    return axnmihn::StridedView<T>(
+        static_cast<const char*>(arr.data()) + offset, arr.strides(0));
+}
+
+// Decay columns read in place from a 1-D structured array (any field order,
+// extra fields and row strides allowed)
+axnmihn::decay::DecayColumns structured_decay_columns(const py::array& arr) {
+    if (arr.ndim() != 1) {
+        throw py::value_error("records: expected a 1-D structured array");
+    }
+    return axnmihn::decay::DecayColumns{
+        record_field<double>(arr, "importance"),
+        record_field<double>(arr, "hours_passed"),
+        record_field<int>(arr, "access_count"),
+        record_field<int>(arr, "connection_count"),
+        record_field<double>(arr, "last_access_hours"),
+        record_field<int>(arr, "memory_type"),
+        record_field<int>(arr, "channel_mentions"),
+    };
+}
+
+// Convert a Python {node: [neighbors]} dict to the C++ adjacency map
+std::unordered_map<size_t, std::vector<size_t>> adjacency_from_dict(const py::dict& adjacency) {
+    std::unordered_map<size_t, std::vector<size_t>> adj_map;
+    for (auto item : adjacency) {
+        size_t key = item.first.cast<size_t>();
+        py::list neighbors = item.second.cast<py::list>();
+
+        std::vector<size_t> neighbor_vec;
+        for (auto n : neighbors) {
+            neighbor_vec.push_back(n.cast<size_t>());
+        }
+        adj_map[key] = neighbor_vec;
+    }
+    return adj_map;
+}
+
+// (indptr, indices) arrays as a validated CSR view, read in place
+axnmihn::graph_ops::CsrView csr_view(const py::array_t<int64_t>& indptr,
+                                     const py::array_t<int64_t>& indices) {
+    const py::ssize_t n_offsets = length_1d(indptr, "indptr");
+    if (n_offsets < 1) {
+        throw py::value_error("indptr: expected at least one offset");
+    }
+    const py::ssize_t n_edges = length_1d(indices, "indices");
+    axnmihn::graph_ops::CsrView view{
+        view_1d(indptr, n_offsets, "indptr"), view_1d(indices, n_edges, "indices"),
+        static_cast<size_t>(n_offsets - 1), static_cast<size_t>(n_edges)};
+    axnmihn::graph_ops::validate_csr(view);
+    return view;
+}
+
+// kNN graphs come back as three arrays: (indptr, indices, scores)
+py::tuple csr_to_numpy(axnmihn::knn::CsrGraph&& graph) {
+    return py::make_tuple(
+        vector_to_numpy(std::move(graph.indptr)),
+        vector_to_numpy(std::move(graph.indices)),
+        vector_to_numpy(std::move(graph.scores)));
+}
+
+axnmihn::knn::BuildOptions knn_options(size_t k, const std::string& method, double min_similarity,
+                                       size_t exact_limit, size_t max_iterations,
+                                       double sample_rate, double delta, uint64_t seed) {
+    axnmihn::knn::BuildOptions options;
+    options.k = k;
+    if (method == "auto") {
+        options.method = axnmihn::knn::BuildMethod::Auto;
+    } else if (method == "exact") {
+        options.method = axnmihn::knn::BuildMethod::Exact;
+    } else if (method == "nn_descent") {
+        options.method = axnmihn::knn::BuildMethod::NNDescent;
+    } else {
+        throw std::invalid_argument("method must be 'auto', 'exact' or 'nn_descent'");
+    }
+    options.min_similarity = min_similarity;
+    options.exact_limit = exact_limit;
+    options.max_iterations = max_iterations;
+    options.sample_rate = sample_rate;
+    options.delta = delta;
+    options.seed = seed;
+    return options;
+}
+
+// UTF-8 text of a str, or the contents of a bytes object, without copying
+std::string_view text_view(py::handle obj, const char* name) {
+    if (PyUnicode_Check(obj.ptr())) {
+        Py_ssize_t size = 0;
+        const char* data = PyUnicode_AsUTF8AndSize(obj.ptr(), &size);
+        if (!data) {
+            throw py::error_already_set();
+        }
+        return std::string_view(data, static_cast<size_t>(size));
+    }
+    if (PyBytes_Check(obj.ptr())) {
+        return std::string_view(PyBytes_AS_STRING(obj.ptr()),
+                                static_cast<size_t>(PyBytes_GET_SIZE(obj.ptr())));
+    }
+    throw py::type_error(std::string(name) + ": expected str or bytes");
+}
+
+axnmihn::pgvector::WireType wire_type(const std::string& type) {
+    if (type == "vector") {
+        return axnmihn::pgvector::WireType::Vector;
+    }
+    if (type == "halfvec") {
+        return axnmihn::pgvector::WireType::HalfVec;
+    }
+    throw std::invalid_argument("type must be 'vector' or 'halfvec'");
+}
+
+// Decoded vectors come back as float32, or as float16 for dtype="float16"
+bool half_output(const std::string& dtype) {
+    if (dtype == "float32") {
+        return false;
+    }
+    if (dtype == "float16") {
+        return true;
+    }
+    throw std::invalid_argument("dtype must be 'float32' or 'float16'");
+}
+
+// Contiguous 1-D buffer (bytes, bytearray, memoryview, ...) for raw input
+py::buffer_info contiguous_buffer(py::handle obj, const char* name) {
+    if (!PyObject_CheckBuffer(obj.ptr())) {
+        throw py::type_error(std::string(name) + ": expected bytes or another buffer");
+    }
+    py::buffer_info info = py::reinterpret_borrow<py::buffer>(obj).request();
+    if (info.ndim > 1 || (info.ndim == 1 && info.strides[0] != info.itemsize)) {
+        throw py::value_error(std::string(name) + ": buffer must be 1-D and contiguous");
+    }
+    return info;
+}
+
+// Zero-copy array over a column of a bound object; `owner` (the Python
+// wrapper) keeps the storage alive for as long as the array exists
+template<typename T>
+py::array column_view(const std::vector<T>& column, py::handle owner) {
+    return py::array_t<T>(static_cast<py::ssize_t>(column.size()), column.data(), owner);
+}
+
+// ---------------------------------------------------------------------------
+// Async bridge: native thread pool -> asyncio.Future
+// ---------------------------------------------------------------------------
+
+// Python objects owned by one in-flight async call. Created and destroyed
+// with the GIL held; worker threads only carry the raw pointer.
+struct AsyncCall {
+    py::object loop;
+    py::object future;
+    py::object keepalive;  // input arrays the kernel reads without the GIL
+};
+
+// Runs on the loop thread via call_soon_threadsafe
+void resolve_future(py::object future, py::object value, bool is_error) {
+    if (future.attr("done")().cast<bool>()) {
+        return;  // cancelled while the kernel was finishing
+    }
+    future.attr(is_error ? "set_exception" : "set_result")(value);
+}
+
+py::object exception_to_python(std::exception_ptr error) {
+    py::object builtins = py::module_::import("builtins");
+    try {
+        std::rethrow_exception(error);
+    } catch (const py::error_already_set& e) {
+        return e.value();
+    } catch (const std::invalid_argument& e) {
+        return builtins.attr("ValueError")(e.what());
+    } catch (const std::exception& e) {
+        return builtins.attr("RuntimeError")(e.what());
+    } catch (...) {
+        return builtins.attr("RuntimeError")("unknown native error");
+    }
+}
+
+// Run `work(const CancelToken&)` on the native thread pool and return an
+// asyncio.Future bound to the running loop.
+//
+// `work` runs without the GIL and must only touch C++ data (array views
+// are fine as long as their arrays are in `keepalive`). `convert` turns the
+// result into a Python object under the GIL on the worker, and the future
+// is completed on its own loop with call_soon_threadsafe. Cancelling the
+// future sets the token so the kernel stops at its next check.
+template<typename Work, typename Convert>
+py::object submit_async(py::object keepalive, Work work, Convert convert) {
+    py::object loop = py::module_::import("asyncio").attr("get_running_loop")();
+    py::object future = loop.attr("create_future")();
+    auto token = std::make_shared<axnmihn::runtime::CancelToken>();
+
+    future.attr("add_done_callback")(py::cpp_function([token](py::object done) {
+        if (done.attr("cancelled")().cast<bool>()) {
+            token->cancel();
+        }
+    }));
+
+    auto* call = new AsyncCall{loop, future, std::move(keepalive)};
+
+    axnmihn::runtime::default_pool().submit(
+        [call, token, work = std::move(work), convert = std::move(convert)]() mutable {
+            using Result = decltype(work(*token));
+            std::optional<Result> result;
+            std::exception_ptr error;
+
+            if (!token->cancelled()) {
+                try {
+                    result.emplace(work(*token));
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+
+            py::gil_scoped_acquire gil;
+            if (!token->cancelled()) {
+                py::object value;
+                bool is_error = static_cast<bool>(error);
+                if (is_error) {
+                    value = exception_to_python(error);
+                } else {
+                    try {
+                        value = convert(std::move(*result));
+                    } catch (...) {
+                        value = exception_to_python(std::current_exception());
+                        is_error = true;
+                    }
+                }
+
+                try {
+                    call->loop.attr("call_soon_threadsafe")(
+                        py::cpp_function(&resolve_future), call->future, value, is_error);
+                } catch (const py::error_already_set&) {
+                    // Loop already closed: nobody is left to await the result
+                }
+            }
+            delete call;
+        });
+
+    return future;
+}
+
 PYBIND11_MODULE(axnmihn_native, m) {
     m.doc() = "C++ native optimizations for axnmihn";
 
@@ -60,55 +578,85 @@ PYBIND11_MODULE(axnmihn_native, m) {
         .def_readwrite("memory_type", &axnmihn::decay::DecayInput::memory_type)
         .def_readwrite("channel_mentions", &axnmihn::decay::DecayInput::channel_mentions);
 
-    decay_m.def("calculate", &axnmihn::decay::calculate,
+    decay_m.def("calculate", counted("decay_ops.calculate", &axnmihn::decay::calculate),
         "Calculate decayed importance for a single memory",
         py::arg("input"), py::arg("config"));
 
-    decay_m.def("calculate_batch", &axnmihn::decay::calculate_batch,
+    decay_m.def("calculate_reference",
+        counted("decay_ops.calculate_reference", &axnmihn::decay::calculate_reference),
+        "Exact (libm-only) decay for one memory; the accuracy reference for calculate*",
+        py::arg("input"), py::arg("config"));
+
+    decay_m.def("calculate_batch",
+        [](const std::vector<axnmihn::decay::DecayInput>& inputs,
+           const axnmihn::decay::DecayConfig& config) {
+            static const uint32_t probe = axnmihn::stats::register_probe("decay_ops.calculate_batch");
+            axnmihn::stats::CallScope call(probe);
+            call.elements(inputs.size());
+            call.bytes_in(inputs.size() * sizeof(axnmihn::decay::DecayInput));
+            call.bytes_out(inputs.size() * sizeof(double));
+            std::vector<double> scores;
+            {
+                auto timer = call.kernel();
+                scores = axnmihn::decay::calculate_batch(inputs, config);
+            }
+            return vector_to_numpy(std::move(scores));
+        },
         "Calculate decayed importance for a batch of memories",
         py::arg("inputs"), py::arg("config"));
 
     // NumPy array version for maximum efficiency
     decay_m.def("calculate_batch_numpy",
-        [](py::array_t<double> importance,
-           py::array_t<double> hours_passed,
-           py::array_t<int> access_count,
-           py::array_t<int> connection_count,
-           py::array_t<double> last_access_hours,
-           py::array_t<int> memory_type,
-           py::array_t<int> channel_mentions,
-           const axnmihn::decay::DecayConfig& config) {
+        [](py::handle importance,
+           py::handle hours_passed,
+           py::handle access_count,
+           py::handle connection_count,
+           py::handle last_access_hours,
+           py::handle memory_type,
+           py::handle channel_mentions,
+           const axnmihn::decay::DecayConfig& config,
+           py::object out) {
+            static const uint32_t probe = axnmihn::stats::register_probe("decay_ops.calculate_batch_numpy");
+            axnmihn::stats::CallScope call(probe);
+            auto marshal = call.phase("marshal");
 
-            auto imp = importance.unchecked<1>();
-            auto hrs = hours_passed.unchecked<1>();
-            auto acc = access_count.unchecked<1>();
-            auto conn = connection_count.unchecked<1>();
-            auto last = last_access_hours.unchecked<1>();
-            auto mtype = memory_type.unchecked<1>();
-            auto chmnt = channel_mentions.unchecked<1>();
+            auto imp = borrow_array<double>(importance, "importance");
+            auto hrs = borrow_array<double>(hours_passed, "hours_passed");
+            auto acc = borrow_array<int>(access_count, "access_count");
+            auto conn = borrow_array<int>(connection_count, "connection_count");
+            auto last = borrow_array<double>(last_access_hours, "last_access_hours");
+            auto mtype = borrow_array<int>(memory_type, "memory_type");
+            auto chmnt = borrow_array<int>(channel_mentions, "channel_mentions");
 
-            size_t n = imp.size();
+            const py::ssize_t n = length_1d(imp, "importance");
 
-            // Create output array
-            py::array_t<double> result(n);
-            auto output = result.mutable_unchecked<1>();
+            axnmihn::decay::DecayColumns columns{
+                view_1d(imp, n, "importance"),
+                view_1d(hrs, n, "hours_passed"),
+                view_1d(acc, n, "access_count"),
+                view_1d(conn, n, "connection_count"),
+                view_1d(last, n, "last_access_hours"),
+                view_1d(mtype, n, "memory_type"),
+                view_1d(chmnt, n, "channel_mentions"),
+            };
 
-            axnmihn::decay::calculate_batch_arrays(
-                n,
-                imp.data(0),
-                hrs.data(0),
-                acc.data(0),
-                conn.data(0),
-                last.data(0),
-                mtype.data(0),
-                chmnt.data(0),
-                config,
-                output.mutable_data(0)
-            );
+            auto result = output_array<double>(out, n);
+            marshal.stop();
+
+            call.elements(static_cast<uint64_t>(n));
+            call.bytes_in(array_bytes(imp) + array_bytes(hrs) + array_bytes(acc) + array_bytes(conn) +
+                          array_bytes(last) + array_bytes(mtype) + array_bytes(chmnt));
+            call.bytes_out(static_cast<uint64_t>(n) * sizeof(double));
+            {
+                auto timer = call.kernel();
+                axnmihn::decay::calculate_batch_strided(
+                    static_cast<size_t>(n), columns, config, mutable_view(result));
+            }
 
             return result;
         },
-        "Calculate decayed importance for a batch using NumPy arrays",
+        "Calculate decayed importance for a batch using NumPy arrays.\n"
+        "Strided views are read in place; pass out= to reuse a result buffer.",
         py::arg("importance"),
         py::arg("hours_passed"),
         py::arg("access_count"),
@@ -116,50 +664,185 @@ PYBIND11_MODULE(axnmihn_native, m) {
         py::arg("last_access_hours"),
         py::arg("memory_type"),
         py::arg("channel_mentions"),
-        py::arg("config"));
+        py::arg("config"),
+        py::kw_only(),
+        py::arg("out") = py::none());
+
+    // Structured-record version: one array of DecayRecord instead of seven
+    PYBIND11_NUMPY_DTYPE(axnmihn::decay::DecayRecord,
+        importance, hours_passed, last_access_hours,
+        access_count, connection_count, memory_type, channel_mentions);
+    decay_m.attr("RECORD_DTYPE") = py::dtype::of<axnmihn::decay::DecayRecord>();
+
+    decay_m.def("calculate_batch_numpy",
+        [](py::handle records,
+           const axnmihn::decay::DecayConfig& config,
+           py::object out) {
+            static const uint32_t probe = axnmihn::stats::register_probe("decay_ops.calculate_batch_records");
+            axnmihn::stats::CallScope call(probe);
+            auto decode = call.phase("decode");
+
+            // Structured array: read each field in place by name
+            if (py::isinstance<py::array>(records)) {
+                auto arr = py::reinterpret_borrow<py::array>(records);
+                if (!arr.dtype().attr("fields").is_none()) {
+                    auto columns = structured_decay_columns(arr);
+                    auto result = output_array<double>(out, arr.shape(0));
+                    decode.stop();
+                    call.elements(static_cast<uint64_t>(arr.shape(0)));
+                    call.bytes_in(static_cast<uint64_t>(arr.nbytes()));
+                    call.bytes_out(static_cast<uint64_t>(arr.shape(0)) * sizeof(double));
+                    auto timer = call.kernel();
+                    axnmihn::decay::calculate_batch_strided(
+                        static_cast<size_t>(arr.shape(0)), columns, config, mutable_view(result));
+                    return result;
+                }
+            }
+
+            // Raw buffer of packed DecayRecord structs (bytes, memoryview, ...)
+            if (!PyObject_CheckBuffer(records.ptr())) {
+                throw py::type_error(
+                    "records: expected a structured array or a buffer of packed records");
+            }
+            py::buffer_info info = py::reinterpret_borrow<py::buffer>(records).request();
+            if (info.ndim != 1 || info.strides[0] != info.itemsize) {
+                throw py::value_error("records: buffer must be 1-D and contiguous");
+            }
+            const auto nbytes = static_cast<size_t>(info.size * info.itemsize);
+            constexpr size_t record_size = sizeof(axnmihn::decay::DecayRecord);
+            if (nbytes % record_size != 0) {
+                throw py::value_error("records: buffer size is not a multiple of " +
+                                      std::to_string(record_size) + " bytes");
+            }
+
+            const size_t n = nbytes / record_size;
+            auto result = output_array<double>(out, static_cast<py::ssize_t>(n));
+            decode.stop();
+            call.elements(n);
+            call.bytes_in(nbytes);
+            call.bytes_out(n * sizeof(double));
+            auto timer = call.kernel();
+            axnmihn::decay::calculate_batch_strided(
+                n,
+                axnmihn::decay::record_columns(
+                    static_cast<const axnmihn::decay::DecayRecord*>(info.ptr), record_size),
+                config,
+                mutable_view(result));
+            return result;
+        },
+        "Calculate decayed importance from one structured array (decay_ops.RECORD_DTYPE)\n"
+        "or a buffer of packed 40-byte DecayRecord structs.",
+        py::arg("records"),
+        py::arg("config"),
+        py::kw_only(),
+        py::arg("out") = py::none());
 
     // ====================
     // Vector Operations
     // ====================
     py::module vector_m = m.def_submodule("vector_ops", "Vector similarity calculations");
 
-    vector_m.def("cosine_similarity", &axnmihn::vector_ops::cosine_similarity,
+    vector_m.def("cosine_similarity",
+        counted("vector_ops.cosine_similarity", &axnmihn::vector_ops::cosine_similarity),
         "Calculate cosine similarity between two vectors",
         py::arg("a"), py::arg("b"));
 
     vector_m.def("cosine_similarity_batch",
-        [](py::array_t<double> query, py::array_t<double, py::array::c_style | py::array::forcecast> corpus) {
-            auto q = query.unchecked<1>();
-            auto c = corpus.unchecked<2>();
+        [](py::handle query, py::handle corpus, py::object out) {
+            static const uint32_t probe = axnmihn::stats::register_probe("vector_ops.cosine_similarity_batch");
+            axnmihn::stats::CallScope call(probe);
+            auto marshal = call.phase("marshal");
+            auto q = borrow_array<double>(query, "query");
+            auto c = borrow_array<double>(corpus, "corpus");
 
-            size_t n_vectors = c.shape(0);
-            size_t dim = c.shape(1);
+            auto corpus_view = view_2d(c, "corpus");
+            auto query_view = view_1d(q, static_cast<py::ssize_t>(corpus_view.cols), "query");
 
-            std::vector<double> query_vec(q.data(0), q.data(0) + q.size());
+            auto result = output_array<double>(out, static_cast<py::ssize_t>(corpus_view.rows));
+            marshal.stop();
+
+            if (!query_view.contiguous() || !corpus_view.rows_contiguous()) {
+                call.simd("scalar");  // strided rows take the scalar path
+            }
+            call.elements(corpus_view.rows);
+            call.bytes_in(array_bytes(q) + array_bytes(c));
+            call.bytes_out(corpus_view.rows * sizeof(double));
+            {
+                auto timer = call.kernel();
+                axnmihn::vector_ops::cosine_similarity_batch_into(
+                    query_view, corpus_view, mutable_view(result));
+            }
 
-            return axnmihn::vector_ops::cosine_similarity_batch(
-                query_vec, c.data(0, 0), n_vectors, dim);
+            return result;
         },
-        "Calculate cosine similarity between query and corpus",
-        py::arg("query"), py::arg("corpus"));
+        "Calculate cosine similarity between query and corpus.\n"
+        "Strided views are read in place; pass out= to reuse a result buffer.",
+        py::arg("query"), py::arg("corpus"), py::kw_only(), py::arg("out") = py::none());
 
     vector_m.def("find_duplicates_by_embedding",
-        [](py::array_t<double, py::array::c_style | py::array::forcecast> embeddings, double threshold) {
-            auto e = embeddings.unchecked<2>();
-            size_t n = e.shape(0);
-            size_t dim = e.shape(1);
-
-            auto result = axnmihn::vector_ops::find_duplicates_by_embedding(
-                e.data(0, 0), n, dim, threshold);
+        [](py::handle embeddings, double threshold) {
+            static const uint32_t probe = axnmihn::stats::register_probe("vector_ops.find_duplicates_by_embedding");
+            axnmihn::stats::CallScope call(probe);
+            auto e = borrow_array<double>(embeddings, "embeddings");
+            auto view = view_2d(e, "embeddings");
 
-            // Convert to Python list of tuples
-            py::list output;
-            for (const auto& [i, j, sim] : result) {
-                output.append(py::make_tuple(i, j, sim));
+            call.elements(view.rows);
+            call.bytes_in(array_bytes(e));
+            axnmihn::PairList pairs;
+            {
+                auto timer = call.kernel();
+                pairs = axnmihn::vector_ops::find_duplicates_by_embedding(view, threshold);
             }
-            return output;
+            call.bytes_out(pairs.size() * (2 * sizeof(int64_t) + sizeof(double)));
+            auto convert = call.phase("convert");
+            return pairs_to_numpy(std::move(pairs));
         },
-        "Find duplicate pairs by embedding similarity",
+        "Find duplicate pairs by embedding similarity; returns (i, j, sim) arrays",
+        py::arg("embeddings"), py::arg("threshold"));
+
+    vector_m.def("cosine_similarity_batch_async",
+        [](py::handle query, py::handle corpus) {
+            auto q = borrow_array<double>(query, "query");
+            auto c = borrow_array<double>(corpus, "corpus");
+
+            auto corpus_view = view_2d(c, "corpus");
+            auto query_view = view_1d(q, static_cast<py::ssize_t>(corpus_view.cols), "query");
+
+            return submit_async(py::make_tuple(q, c),
+                [query_view, corpus_view](const axnmihn::runtime::CancelToken& cancel) {
+                    static const uint32_t probe = axnmihn::stats::register_probe("vector_ops.cosine_similarity_batch_async");
+                    axnmihn::stats::CallScope call(probe);
+                    call.elements(corpus_view.rows);
+                    auto timer = call.kernel();
+                    std::vector<double> scores(corpus_view.rows);
+                    axnmihn::vector_ops::cosine_similarity_batch_into(
+                        query_view, corpus_view,
+                        axnmihn::MutableStridedView<double>(scores.data()), &cancel);
+                    return scores;
+                },
+                [](std::vector<double>&& scores) { return vector_to_numpy(std::move(scores)); });
+        },
+        "Awaitable cosine_similarity_batch running on the native thread pool.\n"
+        "Input arrays must not be modified until the future completes.",
+        py::arg("query"), py::arg("corpus"));
+
+    vector_m.def("find_duplicates_by_embedding_async",
+        [](py::handle embeddings, double threshold) {
+            auto e = borrow_array<double>(embeddings, "embeddings");
+            auto view = view_2d(e, "embeddings");
+
+            return submit_async(py::make_tuple(e),
+                [view, threshold](const axnmihn::runtime::CancelToken& cancel) {
+                    static const uint32_t probe = axnmihn::stats::register_probe("vector_ops.find_duplicates_by_embedding_async");
+                    axnmihn::stats::CallScope call(probe);
+                    call.elements(view.rows);
+                    auto timer = call.kernel();
+                    return axnmihn::vector_ops::find_duplicates_by_embedding(view, threshold, &cancel);
+                },
+                [](axnmihn::PairList&& pairs) { return pairs_to_numpy(std::move(pairs)); });
+        },
+        "Awaitable find_duplicates_by_embedding running on the native thread pool.\n"
+        "Cancelling the future stops the scan early.",
         py::arg("embeddings"), py::arg("threshold"));
 
     // ====================
@@ -169,18 +852,11 @@ PYBIND11_MODULE(axnmihn_native, m) {
 
     graph_m.def("bfs_neighbors",
         [](py::dict adjacency, py::list start_nodes, int max_depth) {
+            static const uint32_t probe = axnmihn::stats::register_probe("graph_ops.bfs_neighbors");
+            axnmihn::stats::CallScope call(probe);
+            auto marshal = call.phase("marshal");
             // Convert Python dict to C++ map
-            std::unordered_map<size_t, std::vector<size_t>> adj_map;
-            for (auto item : adjacency) {
-                size_t key = item.first.cast<size_t>();
-                py::list neighbors = item.second.cast<py::list>();
-
-                std::vector<size_t> neighbor_vec;
-                for (auto n : neighbors) {
-                    neighbor_vec.push_back(n.cast<size_t>());
-                }
-                adj_map[key] = neighbor_vec;
-            }
+            auto adj_map = adjacency_from_dict(adjacency);
 
             // Convert start nodes
             std::vector<size_t> starts;
@@ -188,71 +864,2160 @@ PYBIND11_MODULE(axnmihn_native, m) {
                 starts.push_back(n.cast<size_t>());
             }
 
-            auto result = axnmihn::graph_ops::bfs_neighbors(adj_map, starts, max_depth);
-
-            // Convert to Python set
-            py::set output;
-            for (size_t node : result) {
-                output.add(py::int_(node));
+            marshal.stop();
+            call.elements(adj_map.size());
+            axnmihn::alloc::pooled_vector<int64_t> visited;
+            {
+                auto timer = call.kernel();
+                visited = axnmihn::graph_ops::bfs_neighbors(adj_map, starts, max_depth);
             }
-            return output;
+            call.bytes_out(visited.size() * sizeof(int64_t));
+            return vector_to_numpy(std::move(visited));
         },
-        "Find all neighbors within max_depth using BFS",
+        "Find all neighbors within max_depth using BFS; returns node ids in discovery order",
         py::arg("adjacency"), py::arg("start_nodes"), py::arg("max_depth"));
 
     graph_m.def("find_connected_components",
-        [](py::dict adjacency, size_t n_nodes) {
-            std::unordered_map<size_t, std::vector<size_t>> adj_map;
-            for (auto item : adjacency) {
-                size_t key = item.first.cast<size_t>();
-                py::list neighbors = item.second.cast<py::list>();
+        [](py::dict adjacency, size_t n_nodes, py::object out) {
+            static const uint32_t probe = axnmihn::stats::register_probe("graph_ops.find_connected_components");
+            axnmihn::stats::CallScope call(probe);
+            auto marshal = call.phase("marshal");
+            auto adj_map = adjacency_from_dict(adjacency);
+            marshal.stop();
 
-                std::vector<size_t> neighbor_vec;
-                for (auto n : neighbors) {
-                    neighbor_vec.push_back(n.cast<size_t>());
-                }
-                adj_map[key] = neighbor_vec;
+            auto result = output_array<int>(out, static_cast<py::ssize_t>(n_nodes));
+            call.elements(n_nodes);
+            call.bytes_out(n_nodes * sizeof(int));
+            {
+                auto timer = call.kernel();
+                axnmihn::graph_ops::find_connected_components_into(
+                    adj_map, n_nodes, mutable_view(result));
             }
-
-            return axnmihn::graph_ops::find_connected_components(adj_map, n_nodes);
+            return result;
         },
         "Find connected components in graph",
+        py::arg("adjacency"), py::arg("n_nodes"), py::kw_only(), py::arg("out") = py::none());
+
+    graph_m.def("find_connected_components_async",
+        [](py::dict adjacency, size_t n_nodes) {
+            return submit_async(py::none(),
+                [adj_map = adjacency_from_dict(adjacency), n_nodes](
+                        const axnmihn::runtime::CancelToken& cancel) {
+                    static const uint32_t probe = axnmihn::stats::register_probe("graph_ops.find_connected_components_async");
+                    axnmihn::stats::CallScope call(probe);
+                    call.elements(n_nodes);
+                    auto timer = call.kernel();
+                    std::vector<int> component_ids(n_nodes);
+                    axnmihn::graph_ops::find_connected_components_into(
+                        adj_map, n_nodes,
+                        axnmihn::MutableStridedView<int>(component_ids.data()), &cancel);
+                    return component_ids;
+                },
+                [](std::vector<int>&& ids) { return vector_to_numpy(std::move(ids)); });
+        },
+        "Awaitable find_connected_components running on the native thread pool",
         py::arg("adjacency"), py::arg("n_nodes"));
 
+    graph_m.def("bfs_neighbors_csr",
+        [](py::handle indptr, py::handle indices, py::list start_nodes, int max_depth) {
+            static const uint32_t probe = axnmihn::stats::register_probe("graph_ops.bfs_neighbors_csr");
+            axnmihn::stats::CallScope call(probe);
+            auto p = borrow_array<int64_t>(indptr, "indptr");
+            auto i = borrow_array<int64_t>(indices, "indices");
+            auto graph = csr_view(p, i);
+            std::vector<size_t> starts;
+            for (auto n : start_nodes) {
+                starts.push_back(n.cast<size_t>());
+            }
+
+            call.elements(graph.n_nodes);
+            call.bytes_in(array_bytes(p) + array_bytes(i));
+            axnmihn::alloc::pooled_vector<int64_t> visited;
+            {
+                auto timer = call.kernel();
+                visited = axnmihn::graph_ops::bfs_neighbors(graph, starts, max_depth);
+            }
+            call.bytes_out(visited.size() * sizeof(int64_t));
+            return vector_to_numpy(std::move(visited));
+        },
+        "bfs_neighbors over a CSR graph (e.g. from knn.build), read in place",
+        py::arg("indptr"), py::arg("indices"), py::arg("start_nodes"), py::arg("max_depth"));
+
+    graph_m.def("find_connected_components_csr",
+        [](py::handle indptr, py::handle indices, py::object out) {
+            static const uint32_t probe = axnmihn::stats::register_probe("graph_ops.find_connected_components_csr");
+            axnmihn::stats::CallScope call(probe);
+            auto p = borrow_array<int64_t>(indptr, "indptr");
+            auto i = borrow_array<int64_t>(indices, "indices");
+            auto graph = csr_view(p, i);
+
+            auto result = output_array<int>(out, static_cast<py::ssize_t>(graph.n_nodes));
+            call.elements(graph.n_nodes);
+            call.bytes_in(array_bytes(p) + array_bytes(i));
+            call.bytes_out(graph.n_nodes * sizeof(int));
+            {
+                auto timer = call.kernel();
+                axnmihn::graph_ops::find_connected_components_into(graph, mutable_view(result));
+            }
+            return result;
+        },
+        "Connected components of a CSR graph; edges are followed as stored,\n"
+        "so pass knn.symmetrize() output for undirected components",
+        py::arg("indptr"), py::arg("indices"), py::kw_only(), py::arg("out") = py::none());
+
+    // ====================
+    // kNN Graph
+    // ====================
+    py::module knn_m = m.def_submodule("knn",
+        "All-pairs k-nearest-neighbour graphs in CSR form");
+
+    knn_m.def("build",
+        [](py::handle embeddings, size_t k, const std::string& method, double min_similarity,
+           size_t exact_limit, size_t max_iterations, double sample_rate, double delta,
+           uint64_t seed) {
+            static const uint32_t probe = axnmihn::stats::register_probe("knn.build");
+            axnmihn::stats::CallScope call(probe);
+            auto e = borrow_array<double>(embeddings, "embeddings");
+            auto view = view_2d(e, "embeddings");
+            const auto options = knn_options(k, method, min_similarity, exact_limit,
+                                              max_iterations, sample_rate, delta, seed);
+            call.elements(view.rows);
+            call.bytes_in(array_bytes(e));
+            axnmihn::knn::CsrGraph graph;
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                graph = axnmihn::knn::build(view, options);
+            }
+            call.bytes_out(graph.indptr.size() * sizeof(int64_t) +
+                           graph.edges() * (sizeof(int64_t) + sizeof(float)));
+            return csr_to_numpy(std::move(graph));
+        },
+        "Each row's top-k most similar other rows of (n, dim) float64 embeddings.\n"
+        "Returns CSR arrays (indptr int64, indices int64, scores float32), best\n"
+        "first per row. method: 'exact' (tiled scan), 'nn_descent' or 'auto'\n"
+        "(exact up to exact_limit rows).",
+        py::arg("embeddings"), py::arg("k") = 10, py::kw_only(), py::arg("method") = "auto",
+        py::arg("min_similarity") = -1.0, py::arg("exact_limit") = 5000,
+        py::arg("max_iterations") = 12, py::arg("sample_rate") = 1.0, py::arg("delta") = 0.001,
+        py::arg("seed") = 0);
+
+    knn_m.def("build_async",
+        [](py::handle embeddings, size_t k, const std::string& method, double min_similarity,
+           size_t exact_limit, size_t max_iterations, double sample_rate, double delta,
+           uint64_t seed) {
+            auto e = borrow_array<double>(embeddings, "embeddings");
+            auto view = view_2d(e, "embeddings");
+            const auto options = knn_options(k, method, min_similarity, exact_limit,
+                                              max_iterations, sample_rate, delta, seed);
+
+            return submit_async(py::make_tuple(e),
+                [view, options](const axnmihn::runtime::CancelToken& cancel) {
+                    static const uint32_t probe = axnmihn::stats::register_probe("knn.build_async");
+                    axnmihn::stats::CallScope call(probe);
+                    call.elements(view.rows);
+                    auto timer = call.kernel();
+                    return axnmihn::knn::build(view, options, &cancel);
+                },
+                [](axnmihn::knn::CsrGraph&& graph) { return csr_to_numpy(std::move(graph)); });
+        },
+        "Awaitable knn.build running on the native thread pool.\n"
+        "Cancelling the future stops the build early.",
+        py::arg("embeddings"), py::arg("k") = 10, py::kw_only(), py::arg("method") = "auto",
+        py::arg("min_similarity") = -1.0, py::arg("exact_limit") = 5000,
+        py::arg("max_iterations") = 12, py::arg("sample_rate") = 1.0, py::arg("delta") = 0.001,
+        py::arg("seed") = 0);
+
+    knn_m.def("symmetrize",
+        [](py::handle indptr, py::handle indices, py::handle scores, bool mutual) {
+            static const uint32_t probe = axnmihn::stats::register_probe("knn.symmetrize");
+            axnmihn::stats::CallScope call(probe);
+            auto p = borrow_array<int64_t>(indptr, "indptr");
+            auto i = borrow_array<int64_t>(indices, "indices");
+            auto sc = borrow_array<float>(scores, "scores");
+            auto view = csr_view(p, i);
+            auto score_view = view_1d(sc, static_cast<py::ssize_t>(view.n_edges), "scores");
+
+            axnmihn::knn::CsrGraph graph;
+            graph.indptr.resize(view.n_nodes + 1);
+            graph.indices.resize(view.n_edges);
+            graph.scores.resize(view.n_edges);
+            for (size_t n = 0; n <= view.n_nodes; ++n) {
+                graph.indptr[n] = view.indptr[n];
+            }
+            for (size_t e = 0; e < view.n_edges; ++e) {
+                graph.indices[e] = view.indices[e];
+                graph.scores[e] = score_view[e];
+            }
+            call.elements(view.n_edges);
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                graph = axnmihn::knn::symmetrize(graph, mutual);
+            }
+            return csr_to_numpy(std::move(graph));
+        },
+        "Undirected version of a kNN graph: the union of both edge directions,\n"
+        "or only edges present both ways with mutual=True. Returns CSR arrays.",
+        py::arg("indptr"), py::arg("indices"), py::arg("scores"), py::kw_only(),
+        py::arg("mutual") = false);
+
     // ====================
     // String Operations
     // ====================
     py::module string_m = m.def_submodule("string_ops", "String similarity operations");
 
-    string_m.def("levenshtein_distance", &axnmihn::string_ops::levenshtein_distance,
+    string_m.def("levenshtein_distance",
+        counted("string_ops.levenshtein_distance", &axnmihn::string_ops::levenshtein_distance),
         "Calculate Levenshtein (edit) distance between two strings",
         py::arg("a"), py::arg("b"));
 
-    string_m.def("string_similarity", &axnmihn::string_ops::string_similarity,
+    string_m.def("string_similarity",
+        counted("string_ops.string_similarity", &axnmihn::string_ops::string_similarity),
         "Calculate normalized string similarity (0-1)",
         py::arg("a"), py::arg("b"));
 
-    string_m.def("find_string_duplicates", &axnmihn::string_ops::find_string_duplicates,
-        "Find duplicate string pairs by similarity",
+    string_m.def("find_string_duplicates",
+        [](const std::vector<std::string>& strings, double threshold) {
+            static const uint32_t probe = axnmihn::stats::register_probe("string_ops.find_string_duplicates");
+            axnmihn::stats::CallScope call(probe);
+            call.elements(strings.size());
+            axnmihn::PairList pairs;
+            {
+                auto timer = call.kernel();
+                pairs = axnmihn::string_ops::find_string_duplicates(strings, threshold);
+            }
+            call.bytes_out(pairs.size() * (2 * sizeof(int64_t) + sizeof(double)));
+            return pairs_to_numpy(std::move(pairs));
+        },
+        "Find duplicate string pairs by similarity; returns (i, j, sim) arrays",
         py::arg("strings"), py::arg("threshold"));
 
-    string_m.def("string_similarity_batch", &axnmihn::string_ops::string_similarity_batch,
+    string_m.def("find_string_duplicates_async",
+        [](std::vector<std::string> strings, double threshold) {
+            return submit_async(py::none(),
+                [strings = std::move(strings), threshold](
+                        const axnmihn::runtime::CancelToken& cancel) {
+                    static const uint32_t probe = axnmihn::stats::register_probe("string_ops.find_string_duplicates_async");
+                    axnmihn::stats::CallScope call(probe);
+                    call.elements(strings.size());
+                    auto timer = call.kernel();
+                    return axnmihn::string_ops::find_string_duplicates(strings, threshold, &cancel);
+                },
+                [](axnmihn::PairList&& pairs) { return pairs_to_numpy(std::move(pairs)); });
+        },
+        "Awaitable find_string_duplicates running on the native thread pool",
+        py::arg("strings"), py::arg("threshold"));
+
+    string_m.def("string_similarity_batch",
+        [](const std::string& query, const std::vector<std::string>& targets, py::object out) {
+            static const uint32_t probe = axnmihn::stats::register_probe("string_ops.string_similarity_batch");
+            axnmihn::stats::CallScope call(probe);
+            auto result = output_array<double>(out, static_cast<py::ssize_t>(targets.size()));
+            call.elements(targets.size());
+            call.bytes_out(targets.size() * sizeof(double));
+            {
+                auto timer = call.kernel();
+                axnmihn::string_ops::string_similarity_batch_into(
+                    query, targets, mutable_view(result));
+            }
+            return result;
+        },
         "Batch calculate string similarities",
-        py::arg("query"), py::arg("targets"));
+        py::arg("query"), py::arg("targets"), py::kw_only(), py::arg("out") = py::none());
 
     // ====================
     // Text Operations
     // ====================
     py::module text_m = m.def_submodule("text_ops", "Korean text processing operations");
 
-    text_m.def("fix_korean_spacing", &axnmihn::text_ops::fix_korean_spacing,
+    text_m.def("fix_korean_spacing",
+        counted("text_ops.fix_korean_spacing", &axnmihn::text_ops::fix_korean_spacing),
         "Fix Korean spacing around punctuation and bracket boundaries",
         py::arg("text"));
 
-    text_m.def("fix_korean_spacing_batch", &axnmihn::text_ops::fix_korean_spacing_batch,
+    text_m.def("fix_korean_spacing_batch",
+        [](const std::vector<std::string>& texts) {
+            static const uint32_t probe = axnmihn::stats::register_probe("text_ops.fix_korean_spacing_batch");
+            axnmihn::stats::CallScope call(probe);
+            call.elements(texts.size());
+            // One concatenated buffer instead of a std::string per text
+            std::string fixed;
+            std::vector<size_t> offsets;
+            {
+                auto timer = call.kernel();
+                axnmihn::text_ops::fix_korean_spacing_batch_into(texts, fixed, offsets);
+            }
+            auto convert = call.phase("convert");
+            py::list result(texts.size());
+            for (size_t i = 0; i < texts.size(); ++i) {
+                result[i] = py::str(fixed.data() + offsets[i], offsets[i + 1] - offsets[i]);
+            }
+            return result;
+        },
         "Batch fix Korean spacing",
         py::arg("texts"));
 
+    // ====================
+    // Memory Engine
+    // ====================
+    py::module engine_m = m.def_submodule("memory_engine",
+        "Native memory store with a single-call context pipeline");
+
+    using axnmihn::engine::BuildFilters;
+    using axnmihn::engine::ContextSelection;
+    using axnmihn::engine::MemoryAttributes;
+    using axnmihn::engine::MemoryEngine;
+
+    py::class_<BuildFilters>(engine_m, "BuildFilters")
+        .def(py::init<>())
+        .def_readwrite("candidate_count", &BuildFilters::candidate_count)
+        .def_readwrite("min_similarity", &BuildFilters::min_similarity)
+        .def_readwrite("memory_type_mask", &BuildFilters::memory_type_mask)
+        .def_readwrite("time_from", &BuildFilters::time_from)
+        .def_readwrite("time_to", &BuildFilters::time_to)
+        .def_readwrite("temporal_target", &BuildFilters::temporal_target)
+        .def_readwrite("temporal_factor", &BuildFilters::temporal_factor)
+        .def_readwrite("hot_boost", &BuildFilters::hot_boost)
+        .def_readwrite("graph_depth", &BuildFilters::graph_depth)
+        .def_readwrite("graph_weight", &BuildFilters::graph_weight)
+        .def_readwrite("query_text", &BuildFilters::query_text)
+        .def_readwrite("text_weight", &BuildFilters::text_weight)
+        .def_readwrite("max_per_topic", &BuildFilters::max_per_topic);
+
+    auto selection_to_python = [](ContextSelection&& sel) {
+        py::list ids(sel.ids.size());
+        for (size_t i = 0; i < sel.ids.size(); ++i) {
+            ids[i] = py::str(sel.ids[i]);
+        }
+        return py::make_tuple(
+            ids,
+            vector_to_numpy(std::move(sel.scores)),
+            vector_to_numpy(std::move(sel.token_costs)));
+    };
+
+    auto current_time = []() {
+        return std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    };
+
+    py::class_<MemoryEngine>(engine_m, "MemoryEngine")
+        .def(py::init([](size_t dim, const axnmihn::decay::DecayConfig& config) {
+            auto engine = std::make_unique<MemoryEngine>(dim);
+            engine->set_decay_config(config);
+            return engine;
+        }), py::arg("dim"), py::arg("config") = axnmihn::decay::DecayConfig())
+        .def_property_readonly("dim", &MemoryEngine::dim)
+        .def_property("decay_config", &MemoryEngine::decay_config, &MemoryEngine::set_decay_config)
+        .def("__len__", &MemoryEngine::size)
+        .def("__contains__", &MemoryEngine::contains)
+        .def("upsert",
+            [](MemoryEngine& self, const std::string& id, py::handle embedding,
+               double importance, double event_time, double last_accessed,
+               int access_count, int connection_count, int memory_type,
+               int channel_mentions, int token_cost) {
+                auto e = borrow_array<double>(embedding, "embedding");
+                MemoryAttributes attrs{importance, event_time, last_accessed, access_count,
+                                       connection_count, memory_type, channel_mentions, token_cost};
+                self.upsert(id, view_1d(e, static_cast<py::ssize_t>(self.dim()), "embedding"), attrs);
+            },
+            "Insert or overwrite one memory. Timestamps are epoch seconds; token_cost <= 0\n"
+            "is unknown (estimated by index_text(), otherwise never packed).",
+            py::arg("id"), py::arg("embedding"), py::kw_only(),
+            py::arg("importance") = 0.5, py::arg("event_time") = 0.0,
+            py::arg("last_accessed") = -1.0, py::arg("access_count") = 0,
+            py::arg("connection_count") = 0, py::arg("memory_type") = 0,
+            py::arg("channel_mentions") = 0, py::arg("token_cost") = 0)
+        .def("upsert_batch",
+            [](MemoryEngine& self, const std::vector<std::string>& ids, py::handle embeddings,
+               py::object importance, py::object event_time, py::object last_accessed,
+               py::object access_count, py::object connection_count, py::object memory_type,
+               py::object channel_mentions, py::object token_cost) {
+                static const uint32_t probe = axnmihn::stats::register_probe("memory_engine.upsert_batch");
+                axnmihn::stats::CallScope call(probe);
+                auto e = borrow_array<double>(embeddings, "embeddings");
+                auto matrix = view_2d(e, "embeddings");
+                const auto n = static_cast<py::ssize_t>(ids.size());
+                if (matrix.rows != ids.size() || matrix.cols != self.dim()) {
+                    throw py::value_error("embeddings: expected shape (" + std::to_string(n) +
+                                          ", " + std::to_string(self.dim()) + ")");
+                }
+
+                const MemoryAttributes defaults;
+                py::array_t<double> imp_a, evt_a, last_a;
+                py::array_t<int> acc_a, conn_a, type_a, chan_a, cost_a;
+                auto imp = optional_column(importance, n, "importance", &defaults.importance, imp_a);
+                auto evt = optional_column(event_time, n, "event_time", &defaults.event_time, evt_a);
+                auto last = optional_column(last_accessed, n, "last_accessed", &defaults.last_accessed, last_a);
+                auto acc = optional_column(access_count, n, "access_count", &defaults.access_count, acc_a);
+                auto conn = optional_column(connection_count, n, "connection_count", &defaults.connection_count, conn_a);
+                auto type = optional_column(memory_type, n, "memory_type", &defaults.memory_type, type_a);
+                auto chan = optional_column(channel_mentions, n, "channel_mentions", &defaults.channel_mentions, chan_a);
+                auto cost = optional_column(token_cost, n, "token_cost", &defaults.token_cost, cost_a);
+
+                call.elements(ids.size());
+                call.bytes_in(array_bytes(e));
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                for (size_t i = 0; i < ids.size(); ++i) {
+                    MemoryAttributes attrs{imp[i], evt[i], last[i], acc[i],
+                                           conn[i], type[i], chan[i], cost[i]};
+                    self.upsert(ids[i], matrix.row(i), attrs);
+                }
+            },
+            "Insert or overwrite many memories from an (n, dim) array and optional\n"
+            "per-memory columns (None uses the upsert() default for every row).",
+            py::arg("ids"), py::arg("embeddings"), py::kw_only(),
+            py::arg("importance") = py::none(), py::arg("event_time") = py::none(),
+            py::arg("last_accessed") = py::none(), py::arg("access_count") = py::none(),
+            py::arg("connection_count") = py::none(), py::arg("memory_type") = py::none(),
+            py::arg("channel_mentions") = py::none(), py::arg("token_cost") = py::none())
+        .def("remove", &MemoryEngine::remove,
+            "Remove a memory; returns False if the id is unknown", py::arg("id"))
+        .def("index_text",
+            [](MemoryEngine& self, const std::string& id, const std::string& text) {
+                with_memory_id([&] { self.index_text(id, text); });
+            },
+            "Index a memory's text for keyword matching (the text is not stored)",
+            py::arg("id"), py::arg("text"))
+        .def("link_entity",
+            [](MemoryEngine& self, const std::string& id, const std::string& entity) {
+                with_memory_id([&] { self.link_entity(id, entity); });
+            },
+            "Link a memory to a graph entity", py::arg("memory_id"), py::arg("entity"))
+        .def("add_relation", &MemoryEngine::add_relation,
+            "Add an undirected edge between two entities",
+            py::arg("source"), py::arg("target"))
+        .def("set_topics",
+            [](MemoryEngine& self, const std::string& id, const std::vector<std::string>& topics) {
+                with_memory_id([&] { self.set_topics(id, topics); });
+            },
+            "Set the topics used by the max_per_topic diversity cap",
+            py::arg("memory_id"), py::arg("topics"))
+        .def("set_hot", &MemoryEngine::set_hot,
+            "Replace the set of hot (working-set) memory ids", py::arg("ids"))
+        .def("build_context",
+            [selection_to_python, current_time](
+                    const MemoryEngine& self, py::handle query_embedding,
+                    const std::vector<std::string>& query_entities, int64_t budget,
+                    std::optional<double> now, std::optional<BuildFilters> filters) {
+                static const uint32_t probe = axnmihn::stats::register_probe("memory_engine.build_context");
+                axnmihn::stats::CallScope call(probe);
+                auto q = borrow_array<double>(query_embedding, "query_embedding");
+                auto query_view = view_1d(q, static_cast<py::ssize_t>(self.dim()), "query_embedding");
+                const double at = now ? *now : current_time();
+                const BuildFilters opts = filters ? *filters : BuildFilters();
+
+                ContextSelection sel;
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    sel = self.build_context(query_view, query_entities, budget, at, opts);
+                }
+                call.elements(sel.candidates);
+                call.bytes_in(array_bytes(q));
+                auto convert = call.phase("convert");
+                return selection_to_python(std::move(sel));
+            },
+            "Retrieve, graph-expand, decay-score and budget-pack in one call.\n"
+            "Returns (ids, scores, token_costs) in descending score order.",
+            py::arg("query_embedding"), py::arg("query_entities") = std::vector<std::string>(),
+            py::arg("budget") = 4000, py::kw_only(),
+            py::arg("now") = py::none(), py::arg("filters") = py::none())
+        .def("build_context_async",
+            [selection_to_python, current_time](
+                    py::object self, py::handle query_embedding,
+                    std::vector<std::string> query_entities, int64_t budget,
+                    std::optional<double> now, std::optional<BuildFilters> filters) {
+                const MemoryEngine& engine = self.cast<const MemoryEngine&>();
+                auto q = borrow_array<double>(query_embedding, "query_embedding");
+                auto query_view = view_1d(q, static_cast<py::ssize_t>(engine.dim()), "query_embedding");
+                const double at = now ? *now : current_time();
+
+                return submit_async(py::make_tuple(self, q),
+                    [&engine, query_view, entities = std::move(query_entities), budget, at,
+                     opts = filters ? *filters : BuildFilters()](
+                            const axnmihn::runtime::CancelToken&) {
+                        static const uint32_t probe =
+                            axnmihn::stats::register_probe("memory_engine.build_context_async");
+                        axnmihn::stats::CallScope call(probe);
+                        auto timer = call.kernel();
+                        auto sel = engine.build_context(query_view, entities, budget, at, opts);
+                        call.elements(sel.candidates);
+                        return sel;
+                    },
+                    selection_to_python);
+            },
+            "Awaitable build_context running on the native thread pool",
+            py::arg("query_embedding"), py::arg("query_entities") = std::vector<std::string>(),
+            py::arg("budget") = 4000, py::kw_only(),
+            py::arg("now") = py::none(), py::arg("filters") = py::none());
+
+    // ====================
+    // Accuracy checks
+    // ====================
+    py::module accuracy_m = m.def_submodule("accuracy",
+        "Differential accuracy metrics for approximate kernels");
+
+    accuracy_m.def("compare_values",
+        [](py::handle approx, py::handle exact) {
+            auto a = borrow_array<double>(approx, "approx");
+            auto e = borrow_array<double>(exact, "exact");
+            const py::ssize_t n = length_1d(a, "approx");
+            auto a_view = view_1d(a, n, "approx");
+            auto e_view = view_1d(e, n, "exact");
+            return error_to_python(
+                axnmihn::accuracy::compare_values(a_view, e_view, static_cast<size_t>(n)));
+        },
+        "Element-wise error of approx against exact: count, max_abs, mean_abs,\n"
+        "max_rel, rmse and worst_index",
+        py::arg("approx"), py::arg("exact"));
+
+    accuracy_m.def("top_k",
+        [](py::handle scores, size_t k) {
+            auto s = borrow_array<double>(scores, "scores");
+            const py::ssize_t n = length_1d(s, "scores");
+            auto view = view_1d(s, n, "scores");
+            return vector_to_numpy(axnmihn::accuracy::top_k(view, static_cast<size_t>(n), k));
+        },
+        "Indices of the k largest scores, best first (ties by index)",
+        py::arg("scores"), py::arg("k"));
+
+    accuracy_m.def("recall_at_k",
+        [](py::handle approx, py::handle exact, size_t k) {
+            auto a = py::array_t<int64_t, py::array::c_style | py::array::forcecast>::ensure(approx);
+            auto e = py::array_t<int64_t, py::array::c_style | py::array::forcecast>::ensure(exact);
+            if (!a || !e) {
+                throw py::type_error("recall_at_k: expected integer index arrays");
+            }
+            return axnmihn::accuracy::recall_at_k(
+                a.data(), static_cast<size_t>(a.size()), e.data(), static_cast<size_t>(e.size()), k);
+        },
+        "|approx[:k] & exact[:k]| / min(k, len(exact))",
+        py::arg("approx"), py::arg("exact"), py::arg("k"));
+
+    accuracy_m.def("pair_agreement",
+        [](py::handle approx, py::handle exact) {
+            auto result = axnmihn::accuracy::pair_agreement(
+                pairs_from_python(approx, "approx"), pairs_from_python(exact, "exact"));
+            py::dict d;
+            d["approx"] = result.approx;
+            d["exact"] = result.exact;
+            d["common"] = result.common;
+            d["precision"] = result.precision();
+            d["recall"] = result.recall();
+            d["jaccard"] = result.jaccard();
+            return d;
+        },
+        "Agreement between two unordered duplicate-pair sets given as (i, j[, sim]) arrays",
+        py::arg("approx"), py::arg("exact"));
+
+    accuracy_m.def("set_sample_rate", [](double rate) {
+        axnmihn::accuracy::set_sample_rate(rate);
+    }, "Fraction of eligible calls (0-1) that also check against their reference; 0 disables",
+       py::arg("rate"));
+
+    accuracy_m.def("sample_rate", []() {
+        return axnmihn::accuracy::sample_rate();
+    }, "Current runtime sampling rate");
+
+    accuracy_m.def("metrics", []() {
+        py::dict result;
+        for (const auto& m : axnmihn::accuracy::metrics()) {
+            py::dict d = error_to_python(m.error);
+            d["samples"] = m.samples;
+            if (m.recall_samples > 0) {
+                d["recall_samples"] = m.recall_samples;
+                d["mean_recall"] = m.mean_recall();
+                d["min_recall"] = m.recall_min;
+            }
+            result[py::str(m.name)] = d;
+        }
+        return result;
+    }, "Runtime-sampled accuracy per approximate kernel since the last reset");
+
+    accuracy_m.def("reset_metrics", []() {
+        axnmihn::accuracy::reset_metrics();
+    }, "Clear the sampled accuracy metrics");
+
+    // ====================
+    // Event Ring
+    // ====================
+    py::module events_m = m.def_submodule("events",
+        "Bounded multi-producer ring for memory stream events");
+
+    using axnmihn::events::EventRing;
+
+    py::class_<EventRing>(events_m, "EventRing")
+        .def(py::init<size_t, size_t, size_t>(),
+            py::arg("capacity"), py::arg("num_types") = 16, py::arg("metadata_bytes") = 256)
+        .def_property_readonly("capacity", &EventRing::capacity)
+        .def_property_readonly("num_types", &EventRing::num_types)
+        .def_property_readonly("metadata_bytes", &EventRing::metadata_bytes)
+        .def_property_readonly("head", &EventRing::head,
+            "Sequence number the next push will get")
+        .def("__len__", [](const EventRing& self) { return self.stats().size; })
+        .def("push",
+            [](EventRing& self, uint32_t type, const std::string& event_id, double timestamp,
+               const std::string& metadata) {
+                static const uint32_t probe = axnmihn::stats::register_probe("events.push");
+                axnmihn::stats::CallScope call(probe);
+                call.elements(1);
+                auto timer = call.kernel();
+                return self.push(type, event_id, timestamp, metadata);  // out_of_range -> IndexError
+            },
+            "Append one event (oldest overwritten when full); returns its sequence number.\n"
+            "Metadata longer than metadata_bytes is dropped and read back as None.",
+            py::arg("type"), py::arg("event_id"), py::arg("timestamp"),
+            py::arg("metadata") = std::string())
+        .def("recent",
+            [](const EventRing& self, size_t n) {
+                static const uint32_t probe = axnmihn::stats::register_probe("events.recent");
+                axnmihn::stats::CallScope call(probe);
+                std::vector<axnmihn::events::Event> events;
+                {
+                    auto timer = call.kernel();
+                    events = self.recent(n);
+                }
+                call.elements(events.size());
+                auto convert = call.phase("convert");
+                return events_to_python(std::move(events));
+            },
+            "Last n events, oldest first, as (seq, type, timestamp, event_id, metadata)",
+            py::arg("n"))
+        .def("by_type",
+            [](const EventRing& self, uint32_t type, size_t limit) {
+                static const uint32_t probe = axnmihn::stats::register_probe("events.by_type");
+                axnmihn::stats::CallScope call(probe);
+                std::vector<axnmihn::events::Event> events;
+                {
+                    auto timer = call.kernel();
+                    events = self.by_type(type, limit);
+                }
+                call.elements(events.size());
+                auto convert = call.phase("convert");
+                return events_to_python(std::move(events));
+            },
+            "Up to `limit` events of one type, most recent first",
+            py::arg("type"), py::arg("limit") = 10)
+        .def("drain",
+            [](const EventRing& self, uint64_t cursor, size_t max_events) {
+                static const uint32_t probe = axnmihn::stats::register_probe("events.drain");
+                axnmihn::stats::CallScope call(probe);
+                axnmihn::events::DrainResult result;
+                {
+                    auto timer = call.kernel();
+                    result = self.drain(cursor, max_events);
+                }
+                call.elements(result.events.size());
+                auto convert = call.phase("convert");
+                return py::make_tuple(events_to_python(std::move(result.events)),
+                                      result.next_cursor, result.missed);
+            },
+            "Events with seq >= cursor, oldest first.\n"
+            "Returns (events, next_cursor, missed); missed counts events overwritten\n"
+            "before this call reached them.",
+            py::arg("cursor"), py::arg("max_events") = 1024)
+        .def("clear", &EventRing::clear,
+            "Hide every event pushed so far; counters are kept")
+        .def("stats",
+            [](const EventRing& self) {
+                const auto s = self.stats();
+                py::dict d;
+                d["pushed"] = s.pushed;
+                d["dropped"] = s.dropped;
+                d["size"] = s.size;
+                d["capacity"] = s.capacity;
+                d["metadata_bytes"] = s.metadata_bytes;
+                d["metadata_oversize"] = s.metadata_oversize;
+                return d;
+            },
+            "Push/drop counters and current size");
+
+    // ====================
+    // Interaction Log
+    // ====================
+    py::module ilog_m = m.def_submodule("interaction_log",
+        "Append-only interaction log segments with a background flusher");
+
+    using axnmihn::ilog::LogWriter;
+
+    py::class_<LogWriter>(ilog_m, "LogWriter")
+        .def(py::init([](const std::string& directory, size_t segment_bytes,
+                         uint32_t fsync_interval_ms, size_t queue_capacity,
+                         double max_age_seconds, uint64_t max_total_bytes) {
+            axnmihn::ilog::WriterOptions options;
+            options.segment_bytes = segment_bytes;
+            options.fsync_interval_ms = fsync_interval_ms;
+            options.queue_capacity = queue_capacity;
+            options.max_age_seconds = max_age_seconds;
+            options.max_total_bytes = max_total_bytes;
+            return std::make_unique<LogWriter>(directory, options);
+        }), py::arg("directory"), py::kw_only(),
+           py::arg("segment_bytes") = 64u * 1024 * 1024,
+           py::arg("fsync_interval_ms") = 1000, py::arg("queue_capacity") = 65536,
+           py::arg("max_age_seconds") = 0.0, py::arg("max_total_bytes") = 0)
+        .def("append",
+            [](LogWriter& self, double timestamp, const std::string& session_id,
+               const std::string& model, const std::string& tier, const std::string& router_reason,
+               int64_t turn_id, int32_t latency_ms, int32_t ttft_ms, int32_t tokens_in,
+               int32_t tokens_out, const std::string& tool_calls_json, uint16_t tool_call_count,
+               std::optional<std::string> error, bool refusal) {
+                static const uint32_t probe = axnmihn::stats::register_probe("interaction_log.append");
+                axnmihn::stats::CallScope call(probe);
+                call.elements(1);
+                axnmihn::ilog::InteractionRecord r;
+                r.timestamp = timestamp;
+                r.session_id = session_id;
+                r.model = model;
+                r.tier = tier;
+                r.router_reason = router_reason;
+                r.turn_id = turn_id;
+                r.latency_ms = latency_ms;
+                r.ttft_ms = ttft_ms;
+                r.tokens_in = tokens_in;
+                r.tokens_out = tokens_out;
+                r.tool_calls_json = tool_calls_json;
+                r.tool_call_count = tool_call_count;
+                r.has_error = error.has_value();
+                r.error = error.value_or(std::string());
+                r.refusal = refusal;
+                auto timer = call.kernel();
+                return self.append(r);
+            },
+            "Queue one record without blocking; False if the queue is full or closed.\n"
+            "Integers use -1 for unknown.",
+            py::arg("timestamp"), py::kw_only(),
+            py::arg("session_id") = "", py::arg("model") = "", py::arg("tier") = "",
+            py::arg("router_reason") = "", py::arg("turn_id") = -1,
+            py::arg("latency_ms") = -1, py::arg("ttft_ms") = -1,
+            py::arg("tokens_in") = -1, py::arg("tokens_out") = -1,
+            py::arg("tool_calls_json") = "[]", py::arg("tool_call_count") = 0,
+            py::arg("error") = py::none(), py::arg("refusal") = false)
+        .def("flush", &LogWriter::flush, py::call_guard<py::gil_scoped_release>(),
+            "Block until every record appended so far is written and fsynced")
+        .def("close", &LogWriter::close, py::call_guard<py::gil_scoped_release>(),
+            "Flush and stop the background writer")
+        .def("stats",
+            [](const LogWriter& self) {
+                const auto s = self.stats();
+                py::dict d;
+                d["appended"] = s.appended;
+                d["dropped"] = s.dropped;
+                d["written"] = s.written;
+                d["bytes_written"] = s.bytes_written;
+                d["segments"] = s.segments;
+                d["fsyncs"] = s.fsyncs;
+                d["write_errors"] = s.write_errors;
+                d["segments_deleted"] = s.segments_deleted;
+                return d;
+            },
+            "Queue, write, fsync and retention counters");
+
+    ilog_m.def("list_segments", &axnmihn::ilog::list_segments,
+        "Segment files in a log directory, oldest first", py::arg("directory"));
+
+    ilog_m.def("read_columns",
+        [](const std::string& directory, double since) {
+            static const uint32_t probe = axnmihn::stats::register_probe("interaction_log.read_columns");
+            axnmihn::stats::CallScope call(probe);
+            axnmihn::ilog::LogColumns cols;
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                cols = axnmihn::ilog::read_columns(directory, since);
+            }
+            call.elements(cols.size());
+            call.bytes_in(cols.bytes);
+            auto convert = call.phase("convert");
+            py::dict d;
+            d["segments"] = cols.segments;
+            d["bytes"] = cols.bytes;
+            d["corrupt"] = cols.corrupt;
+            d["skipped"] = cols.skipped;
+            d["timestamp"] = vector_to_numpy(std::move(cols.timestamp));
+            d["turn_id"] = vector_to_numpy(std::move(cols.turn_id));
+            d["latency_ms"] = vector_to_numpy(std::move(cols.latency_ms));
+            d["ttft_ms"] = vector_to_numpy(std::move(cols.ttft_ms));
+            d["tokens_in"] = vector_to_numpy(std::move(cols.tokens_in));
+            d["tokens_out"] = vector_to_numpy(std::move(cols.tokens_out));
+            d["tool_call_count"] = vector_to_numpy(std::move(cols.tool_call_count));
+            d["has_error"] = vector_to_numpy(std::move(cols.has_error));
+            d["refusal"] = vector_to_numpy(std::move(cols.refusal));
+            d["session_id"] = string_column_to_python(std::move(cols.session_id));
+            d["model"] = string_column_to_python(std::move(cols.model));
+            d["tier"] = string_column_to_python(std::move(cols.tier));
+            d["router_reason"] = string_column_to_python(std::move(cols.router_reason));
+            return d;
+        },
+        "Decode every segment record with timestamp >= since into NumPy columns.\n"
+        "String columns are (codes, dictionary). Reading stops at the first\n"
+        "damaged record of a segment; 'corrupt' counts such segments. Closed\n"
+        "segments whose index ends before `since` are not read ('skipped').",
+        py::arg("directory"), py::arg("since") = 0.0);
+
+    // ====================
+    // Access Sketch
+    // ====================
+    py::module sketch_m = m.def_submodule("sketch",
+        "Heavy-hitter sketch for memory access tracking");
+
+    using axnmihn::sketch::AccessSketch;
+
+    py::class_<AccessSketch>(sketch_m, "AccessSketch")
+        .def(py::init([](size_t capacity, double half_life_seconds, size_t cms_width,
+                         size_t cms_depth, uint8_t channel_precision) {
+            axnmihn::sketch::SketchOptions options;
+            options.capacity = capacity;
+            options.half_life_seconds = half_life_seconds;
+            options.cms_width = cms_width;
+            options.cms_depth = cms_depth;
+            options.channel_precision = channel_precision;
+            return std::make_unique<AccessSketch>(options);
+        }), py::arg("capacity") = 4096, py::kw_only(),
+           py::arg("half_life_seconds") = 0.0, py::arg("cms_width") = 2048,
+           py::arg("cms_depth") = 4, py::arg("channel_precision") = 6)
+        .def("record",
+            [](AccessSketch& self, const std::vector<std::string>& ids,
+               const std::string& channel, double now) {
+                static const uint32_t probe = axnmihn::stats::register_probe("sketch.record");
+                axnmihn::stats::CallScope call(probe);
+                call.elements(ids.size());
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                self.record(ids, channel, now);
+            },
+            "Record one access of `ids` from `channel` at epoch seconds `now`",
+            py::arg("ids"), py::arg("channel"), py::arg("now"))
+        .def("top",
+            [](const AccessSketch& self, size_t k, double now) {
+                static const uint32_t probe = axnmihn::stats::register_probe("sketch.top");
+                axnmihn::stats::CallScope call(probe);
+                std::vector<axnmihn::sketch::HotItem> items;
+                {
+                    auto timer = call.kernel();
+                    items = self.top(k, now);
+                }
+                call.elements(items.size());
+                auto convert = call.phase("convert");
+                py::list out;
+                for (const auto& item : items) {
+                    out.append(py::make_tuple(item.id, item.count, item.error, item.channels));
+                }
+                return out;
+            },
+            "Most accessed tracked ids as (id, count, error, channels), highest first",
+            py::arg("k"), py::arg("now"))
+        .def("estimate", &AccessSketch::estimate,
+            "Decayed access count (count-min estimate for untracked ids)",
+            py::arg("id"), py::arg("now"))
+        .def("channel_count", &AccessSketch::channel_count,
+            "Distinct channels for a tracked id, 0 if untracked", py::arg("id"))
+        .def("estimates",
+            [](const AccessSketch& self, const std::vector<std::string>& ids, double now) {
+                static const uint32_t probe = axnmihn::stats::register_probe("sketch.estimates");
+                axnmihn::stats::CallScope call(probe);
+                call.elements(ids.size());
+                std::vector<double> out;
+                {
+                    auto timer = call.kernel();
+                    out = self.estimates(ids, now);
+                }
+                return vector_to_numpy(std::move(out));
+            },
+            "estimate() for each id as a float64 column", py::arg("ids"), py::arg("now"))
+        .def("channel_counts",
+            [](const AccessSketch& self, const std::vector<std::string>& ids) {
+                static const uint32_t probe = axnmihn::stats::register_probe("sketch.channel_counts");
+                axnmihn::stats::CallScope call(probe);
+                call.elements(ids.size());
+                std::vector<int32_t> out;
+                {
+                    auto timer = call.kernel();
+                    out = self.channel_counts(ids);
+                }
+                return vector_to_numpy(std::move(out));
+            },
+            "channel_count() for each id as an int32 column", py::arg("ids"))
+        .def("clear", &AccessSketch::clear, "Forget every access")
+        .def("stats",
+            [](const AccessSketch& self) {
+                const auto s = self.stats();
+                py::dict d;
+                d["tracked"] = s.tracked;
+                d["capacity"] = s.capacity;
+                d["updates"] = s.updates;
+                d["evictions"] = s.evictions;
+                d["distinct_channels"] = s.distinct_channels;
+                return d;
+            },
+            "Tracked items, update/eviction counters and distinct channels");
+
+    // ====================
+    // Access Tracker
+    // ====================
+    py::module access_m = m.def_submodule("access",
+        "Concurrent coalescing accumulator for memory accesses");
+
+    using axnmihn::access::AccessAccumulator;
+
+    py::class_<AccessAccumulator>(access_m, "AccessAccumulator")
+        .def(py::init<size_t, size_t>(),
+             py::arg("num_shards") = 16, py::arg("initial_capacity") = 1024)
+        .def("track",
+            [](AccessAccumulator& self, const std::string& id, double timestamp,
+               uint64_t channel_mask) {
+                self.track(id, timestamp, channel_mask);
+            },
+            "Record one access; lock-free for ids seen before",
+            py::arg("id"), py::arg("timestamp"), py::arg("channel_mask") = 0)
+        .def("track_many",
+            [](AccessAccumulator& self, const std::vector<std::string>& ids, double timestamp,
+               uint64_t channel_mask) {
+                static const uint32_t probe = axnmihn::stats::register_probe("access.track_many");
+                axnmihn::stats::CallScope call(probe);
+                call.elements(ids.size());
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                self.track_many(ids, timestamp, channel_mask);
+            },
+            "Record an access of each id with one timestamp and channel mask",
+            py::arg("ids"), py::arg("timestamp"), py::arg("channel_mask") = 0)
+        .def("drain",
+            [](AccessAccumulator& self) {
+                static const uint32_t probe = axnmihn::stats::register_probe("access.drain");
+                axnmihn::stats::CallScope call(probe);
+                axnmihn::access::AccessColumns cols;
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    cols = self.drain();
+                }
+                call.elements(cols.size());
+                auto convert = call.phase("convert");
+                py::dict d;
+                d["ids"] = py::cast(cols.ids);
+                d["count"] = vector_to_numpy(std::move(cols.count));
+                d["last_ts"] = vector_to_numpy(std::move(cols.last_ts));
+                d["channels"] = vector_to_numpy(std::move(cols.channels));
+                return d;
+            },
+            "Take pending accesses as columns: ids (list), count (int32),\n"
+            "last_ts (float64) and channels (uint64 bitmask)")
+        .def_property_readonly("pending", &AccessAccumulator::pending,
+            "Ids with accesses not yet drained")
+        .def("stats",
+            [](const AccessAccumulator& self) {
+                const auto s = self.stats();
+                py::dict d;
+                d["interned"] = s.interned;
+                d["pending"] = s.pending;
+                d["accesses"] = s.accesses;
+                d["drains"] = s.drains;
+                return d;
+            },
+            "Interned ids, pending ids and access/drain counters");
+
+    // ====================
+    // Content Hashing
+    // ====================
+    py::module hash_m = m.def_submodule("hashing",
+        "XXH3 content hashing with normalization and duplicate grouping");
+
+    auto make_normalize = [](bool collapse_whitespace, bool casefold, size_t max_chars,
+                             bool nfkc) {
+        axnmihn::hashing::NormalizeOptions options;
+        options.collapse_whitespace = collapse_whitespace;
+        options.casefold = casefold;
+        options.max_chars = max_chars;
+        options.nfkc = nfkc;
+        return options;
+    };
+
+    hash_m.def("xxh3_64",
+        [](const std::string& data, uint64_t seed) {
+            return axnmihn::hashing::xxh3_64(data.data(), data.size(), seed);
+        },
+        "XXH3 64-bit hash of bytes (str is hashed as UTF-8)",
+        py::arg("data"), py::arg("seed") = 0);
+
+    hash_m.def("xxh3_128",
+        [](const std::string& data, uint64_t seed) {
+            const auto h = axnmihn::hashing::xxh3_128(data.data(), data.size(), seed);
+            return py::int_(h.high).attr("__lshift__")(64).attr("__or__")(py::int_(h.low));
+        },
+        "XXH3 128-bit hash as an int (same value as xxhash.xxh3_128_intdigest)",
+        py::arg("data"), py::arg("seed") = 0);
+
+    hash_m.def("normalize",
+        [make_normalize](const std::string& text, bool collapse_whitespace, bool casefold,
+                         size_t max_chars, bool nfkc) {
+            return axnmihn::hashing::normalize(
+                text, make_normalize(collapse_whitespace, casefold, max_chars, nfkc));
+        },
+        "Apply hash normalization: NFKC, full case fold (str.casefold),\n"
+        "whitespace collapse (str.split semantics) and truncation to\n"
+        "max_chars code points, in that order",
+        py::arg("text"), py::kw_only(), py::arg("collapse_whitespace") = false,
+        py::arg("casefold") = false, py::arg("max_chars") = 0, py::arg("nfkc") = false);
+
+    hash_m.def("hash_batch",
+        [make_normalize](const std::vector<std::string>& texts, int bits, uint64_t seed,
+                         bool collapse_whitespace, bool casefold, size_t max_chars, bool nfkc) {
+            static const uint32_t probe = axnmihn::stats::register_probe("hashing.hash_batch");
+            axnmihn::stats::CallScope call(probe);
+            call.elements(texts.size());
+            if (bits != 64 && bits != 128) {
+                throw std::invalid_argument("bits must be 64 or 128");
+            }
+            const auto options = make_normalize(collapse_whitespace, casefold, max_chars, nfkc);
+            if (bits == 64) {
+                std::vector<uint64_t> out;
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    out = axnmihn::hashing::hash64_batch(texts, options, seed);
+                }
+                return py::object(vector_to_numpy(std::move(out)));
+            }
+            std::vector<uint64_t> flat;
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                const auto hashes = axnmihn::hashing::hash128_batch(texts, options, seed);
+                flat.reserve(hashes.size() * 2);
+                for (const auto& h : hashes) {
+                    flat.push_back(h.low);
+                    flat.push_back(h.high);
+                }
+            }
+            const auto n = static_cast<py::ssize_t>(texts.size());
+            return vector_to_numpy(std::move(flat)).attr("reshape")(n, 2);
+        },
+        "Normalize and hash each text. bits=64 returns uint64 (n,);\n"
+        "bits=128 returns uint64 (n, 2) as [low, high]",
+        py::arg("texts"), py::kw_only(), py::arg("bits") = 64, py::arg("seed") = 0,
+        py::arg("collapse_whitespace") = false, py::arg("casefold") = false,
+        py::arg("max_chars") = 0, py::arg("nfkc") = false);
+
+    hash_m.def("duplicate_groups",
+        [make_normalize](const std::vector<std::string>& texts, bool collapse_whitespace,
+                         bool casefold, size_t max_chars, bool nfkc) {
+            static const uint32_t probe = axnmihn::stats::register_probe("hashing.duplicate_groups");
+            axnmihn::stats::CallScope call(probe);
+            call.elements(texts.size());
+            axnmihn::hashing::DuplicateGroups groups;
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                const auto options = make_normalize(collapse_whitespace, casefold, max_chars,
+                                                    nfkc);
+                groups = axnmihn::hashing::group_duplicates(
+                    axnmihn::hashing::hash128_batch(texts, options));
+            }
+            auto convert = call.phase("convert");
+            py::list out;
+            for (size_t g = 0; g < groups.size(); ++g) {
+                std::vector<uint32_t> members(groups.indices.begin() + groups.offsets[g],
+                                              groups.indices.begin() + groups.offsets[g + 1]);
+                out.append(vector_to_numpy(std::move(members)));
+            }
+            return out;
+        },
+        "Indices of texts whose normalized XXH3-128 hashes are equal, as a list\n"
+        "of uint32 arrays (groups of 2+, ascending, ordered by first index)",
+        py::arg("texts"), py::kw_only(), py::arg("collapse_whitespace") = false,
+        py::arg("casefold") = false, py::arg("max_chars") = 0, py::arg("nfkc") = false);
+
+    // ====================
+    // Unicode Normalization
+    // ====================
+    py::module unicode_m = m.def_submodule("unicode",
+        "Table-driven NFKC normalization and full case folding");
+
+    unicode_m.attr("UNICODE_VERSION") = axnmihn::unicode::unicode_version();
+
+    unicode_m.def("nfkc",
+        [](const std::string& text) { return axnmihn::unicode::nfkc(text); },
+        "unicodedata.normalize('NFKC', text)",
+        py::arg("text"));
+
+    unicode_m.def("casefold",
+        [](const std::string& text) { return axnmihn::unicode::casefold(text); },
+        "text.casefold() (full Unicode case folding)",
+        py::arg("text"));
+
+    unicode_m.def("is_ascii",
+        [](const std::string& text) { return axnmihn::unicode::is_ascii(text); },
+        "True when text is pure ASCII (SIMD scan)",
+        py::arg("text"));
+
+    unicode_m.def("normalize",
+        [make_normalize](const std::string& text, bool nfkc, bool casefold,
+                         bool collapse_whitespace, size_t max_chars) {
+            return axnmihn::hashing::normalize(
+                text, make_normalize(collapse_whitespace, casefold, max_chars, nfkc));
+        },
+        "NFKC, case fold, whitespace collapse and truncation to max_chars\n"
+        "code points, in that order (the canonical name/similarity key)",
+        py::arg("text"), py::kw_only(), py::arg("nfkc") = true, py::arg("casefold") = true,
+        py::arg("collapse_whitespace") = true, py::arg("max_chars") = 0);
+
+    unicode_m.def("normalize_batch",
+        [make_normalize](const std::vector<std::string>& texts, bool nfkc, bool casefold,
+                         bool collapse_whitespace, size_t max_chars) {
+            static const uint32_t probe = axnmihn::stats::register_probe("unicode.normalize_batch");
+            axnmihn::stats::CallScope call(probe);
+            call.elements(texts.size());
+            const auto options = make_normalize(collapse_whitespace, casefold, max_chars, nfkc);
+            std::vector<std::string> out;
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                out = axnmihn::hashing::normalize_batch(texts, options);
+            }
+            auto convert = call.phase("convert");
+            py::list result(out.size());
+            for (size_t i = 0; i < out.size(); ++i) {
+                result[i] = py::str(out[i]);
+            }
+            return result;
+        },
+        "normalize() for each text, in parallel for large batches",
+        py::arg("texts"), py::kw_only(), py::arg("nfkc") = true, py::arg("casefold") = true,
+        py::arg("collapse_whitespace") = true, py::arg("max_chars") = 0);
+
+    // ====================
+    // SimHash
+    // ====================
+    py::module simhash_m = m.def_submodule("simhash",
+        "SimHash fingerprints with banded near-duplicate lookup");
+
+    auto make_simhash = [make_normalize](const std::string& kind, size_t shingle_size,
+                                         bool collapse_whitespace, bool casefold,
+                                         size_t max_chars, uint64_t seed) {
+        axnmihn::simhash::SimHashOptions options;
+        if (kind == "word") {
+            options.kind = axnmihn::simhash::ShingleKind::Word;
+        } else if (kind == "char") {
+            options.kind = axnmihn::simhash::ShingleKind::Char;
+        } else {
+            throw std::invalid_argument("kind must be 'word' or 'char'");
+        }
+        options.shingle_size = shingle_size;
+        options.normalize = make_normalize(collapse_whitespace, casefold, max_chars, false);
+        options.seed = seed;
+        return options;
+    };
+
+    // Fingerprint arrays are copied once into a vector the kernels can share
+    auto fingerprints_from = [](py::handle obj) {
+        auto arr = borrow_array<uint64_t>(obj, "fingerprints");
+        const auto n = length_1d(arr, "fingerprints");
+        const auto view = view_1d(arr, n, "fingerprints");
+        std::vector<uint64_t> fps(static_cast<size_t>(n));
+        for (size_t i = 0; i < fps.size(); ++i) {
+            fps[i] = view[i];
+        }
+        return fps;
+    };
+
+    simhash_m.def("fingerprint",
+        [make_simhash](const std::string& text, const std::string& kind, size_t shingle_size,
+                       bool collapse_whitespace, bool casefold, size_t max_chars, uint64_t seed) {
+            return axnmihn::simhash::fingerprint(
+                text, make_simhash(kind, shingle_size, collapse_whitespace, casefold, max_chars,
+                                   seed));
+        },
+        "64-bit SimHash over word or character shingles of the normalized text",
+        py::arg("text"), py::kw_only(), py::arg("kind") = "word", py::arg("shingle_size") = 2,
+        py::arg("collapse_whitespace") = true, py::arg("casefold") = true,
+        py::arg("max_chars") = 0, py::arg("seed") = 0);
+
+    simhash_m.def("fingerprint_batch",
+        [make_simhash](const std::vector<std::string>& texts, const std::string& kind,
+                       size_t shingle_size, bool collapse_whitespace, bool casefold,
+                       size_t max_chars, uint64_t seed) {
+            static const uint32_t probe = axnmihn::stats::register_probe("simhash.fingerprint_batch");
+            axnmihn::stats::CallScope call(probe);
+            call.elements(texts.size());
+            const auto options = make_simhash(kind, shingle_size, collapse_whitespace, casefold,
+                                              max_chars, seed);
+            std::vector<uint64_t> out;
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                out = axnmihn::simhash::fingerprint_batch(texts, options);
+            }
+            return vector_to_numpy(std::move(out));
+        },
+        "fingerprint() for each text as a uint64 array",
+        py::arg("texts"), py::kw_only(), py::arg("kind") = "word", py::arg("shingle_size") = 2,
+        py::arg("collapse_whitespace") = true, py::arg("casefold") = true,
+        py::arg("max_chars") = 0, py::arg("seed") = 0);
+
+    simhash_m.def("hamming", &axnmihn::simhash::hamming,
+        "Number of differing bits between two fingerprints",
+        py::arg("a"), py::arg("b"));
+
+    simhash_m.def("near_duplicate_pairs",
+        [fingerprints_from](py::handle fingerprints, int max_distance, int bands) {
+            static const uint32_t probe = axnmihn::stats::register_probe("simhash.near_duplicate_pairs");
+            axnmihn::stats::CallScope call(probe);
+            auto fps = fingerprints_from(fingerprints);
+            call.elements(fps.size());
+            axnmihn::PairList pairs;
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                pairs = axnmihn::simhash::near_duplicate_pairs(fps, max_distance, bands);
+            }
+            auto convert = call.phase("convert");
+            return pairs_to_numpy(std::move(pairs));
+        },
+        "Pairs of fingerprints within max_distance bits as (i, j, similarity)\n"
+        "arrays ordered by (i, j); similarity is 1 - distance / 64",
+        py::arg("fingerprints"), py::arg("max_distance") = 6, py::arg("bands") = 0);
+
+    simhash_m.def("near_duplicate_groups",
+        [fingerprints_from](py::handle fingerprints, int max_distance, int bands) {
+            static const uint32_t probe = axnmihn::stats::register_probe("simhash.near_duplicate_groups");
+            axnmihn::stats::CallScope call(probe);
+            auto fps = fingerprints_from(fingerprints);
+            call.elements(fps.size());
+            axnmihn::hashing::DuplicateGroups groups;
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                groups = axnmihn::simhash::near_duplicate_groups(fps, max_distance, bands);
+            }
+            auto convert = call.phase("convert");
+            py::list out;
+            for (size_t g = 0; g < groups.size(); ++g) {
+                std::vector<uint32_t> members(groups.indices.begin() + groups.offsets[g],
+                                              groups.indices.begin() + groups.offsets[g + 1]);
+                out.append(vector_to_numpy(std::move(members)));
+            }
+            return out;
+        },
+        "Connected groups of fingerprints within max_distance bits, as a list\n"
+        "of uint32 arrays (groups of 2+, ascending, ordered by first index)",
+        py::arg("fingerprints"), py::arg("max_distance") = 6, py::arg("bands") = 0);
+
+    using axnmihn::simhash::SimHashIndex;
+
+    auto matches_to_list = [](const std::vector<axnmihn::simhash::NearMatch>& matches) {
+        py::list out;
+        for (const auto& match : matches) {
+            out.append(py::make_tuple(match.id, match.distance));
+        }
+        return out;
+    };
+
+    py::class_<SimHashIndex>(simhash_m, "SimHashIndex")
+        .def(py::init<int, int>(), py::arg("max_distance") = 6, py::arg("bands") = 0)
+        .def("add", &SimHashIndex::add,
+            "Add a fingerprint; returns its id (insertion order)",
+            py::arg("fingerprint"))
+        .def("query",
+            [matches_to_list](const SimHashIndex& self, uint64_t fp) {
+                return matches_to_list(self.query(fp));
+            },
+            "(id, distance) of indexed fingerprints within max_distance,\n"
+            "nearest first",
+            py::arg("fingerprint"))
+        .def("add_and_query",
+            [matches_to_list](SimHashIndex& self, uint64_t fp) {
+                uint32_t id = 0;
+                auto matches = self.add_and_query(fp, &id);
+                return py::make_tuple(id, matches_to_list(matches));
+            },
+            "Query, then add: (new id, matches among earlier fingerprints)",
+            py::arg("fingerprint"))
+        .def("fingerprint", &SimHashIndex::fingerprint, py::arg("id"))
+        .def("clear", &SimHashIndex::clear)
+        .def("__len__", &SimHashIndex::size)
+        .def_property_readonly("max_distance", &SimHashIndex::max_distance)
+        .def_property_readonly("bands", &SimHashIndex::bands);
+
+    // ====================
+    // Product Quantization
+    // ====================
+    py::module pq_m = m.def_submodule("pq",
+        "Product-quantized embeddings with asymmetric cosine search");
+
+    using axnmihn::pq::ProductQuantizer;
+    using axnmihn::pq::PQIndex;
+
+    // Codes must be a C-contiguous (n, code_size) uint8 array from encode()
+    auto codes_from = [](py::handle obj, size_t code_size) {
+        auto arr = borrow_array<uint8_t>(obj, "codes");
+        if (arr.ndim() != 2 || static_cast<size_t>(arr.shape(1)) != code_size) {
+            throw py::value_error("codes: expected shape (n, " + std::to_string(code_size) + ")");
+        }
+        if (!(arr.flags() & py::array::c_style)) {
+            throw py::value_error("codes: expected a C-contiguous array");
+        }
+        return arr;
+    };
+
+    py::class_<ProductQuantizer>(pq_m, "ProductQuantizer")
+        .def(py::init<size_t, size_t, int>(),
+            py::arg("dim"), py::arg("m"), py::arg("nbits") = 4)
+        .def_static("from_centroids",
+            [](py::handle centroids) {
+                auto c = borrow_array<float>(centroids, "centroids");
+                if (c.ndim() != 3) {
+                    throw py::value_error("centroids: expected shape (m, 2**nbits, dim // m)");
+                }
+                const auto m = static_cast<size_t>(c.shape(0));
+                const auto ksub = static_cast<size_t>(c.shape(1));
+                const auto dsub = static_cast<size_t>(c.shape(2));
+                if (ksub != 16 && ksub != 256) {
+                    throw py::value_error("centroids: expected 16 or 256 centroids per subspace");
+                }
+                std::vector<float> values(m * ksub * dsub);
+                auto u = c.unchecked<3>();
+                for (size_t s = 0; s < m; ++s) {
+                    for (size_t k = 0; k < ksub; ++k) {
+                        for (size_t d = 0; d < dsub; ++d) {
+                            values[(s * ksub + k) * dsub + d] = u(s, k, d);
+                        }
+                    }
+                }
+                return ProductQuantizer(m * dsub, m, ksub == 16 ? 4 : 8, std::move(values));
+            },
+            "Restore a trained quantizer from its centroids array",
+            py::arg("centroids"))
+        .def("train",
+            [](ProductQuantizer& self, py::handle data, int iterations, uint64_t seed) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pq.train");
+                axnmihn::stats::CallScope call(probe);
+                auto d = borrow_array<double>(data, "data");
+                auto view = view_2d(d, "data");
+                call.elements(view.rows);
+                call.bytes_in(array_bytes(d));
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                self.train(view, iterations, seed);
+            },
+            "Learn per-subspace k-means codebooks from (n, dim) float64 rows",
+            py::arg("data"), py::kw_only(), py::arg("iterations") = 20, py::arg("seed") = 0)
+        .def("encode",
+            [](const ProductQuantizer& self, py::handle data) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pq.encode");
+                axnmihn::stats::CallScope call(probe);
+                auto d = borrow_array<double>(data, "data");
+                auto view = view_2d(d, "data");
+                call.elements(view.rows);
+                call.bytes_in(array_bytes(d));
+                std::vector<uint8_t> codes;
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    codes = self.encode(view);
+                }
+                call.bytes_out(codes.size());
+                return vector_to_numpy(std::move(codes)).attr("reshape")(
+                    view.rows, self.code_size());
+            },
+            "Encode (n, dim) float64 rows as (n, code_size) uint8 codes",
+            py::arg("data"))
+        .def("decode",
+            [codes_from](const ProductQuantizer& self, py::handle codes) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pq.decode");
+                axnmihn::stats::CallScope call(probe);
+                auto c = codes_from(codes, self.code_size());
+                const auto n = static_cast<size_t>(c.shape(0));
+                call.elements(n);
+                call.bytes_in(array_bytes(c));
+                std::vector<float> out;
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    out = self.decode(c.data(), n);
+                }
+                call.bytes_out(out.size() * sizeof(float));
+                return vector_to_numpy(std::move(out)).attr("reshape")(n, self.dim());
+            },
+            "Reconstruct (n, dim) float32 unit vectors from codes",
+            py::arg("codes"))
+        .def("cosine_similarity_batch",
+            [codes_from](const ProductQuantizer& self, py::handle query, py::handle codes,
+                         py::object out) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pq.cosine_similarity_batch");
+                axnmihn::stats::CallScope call(probe);
+                auto marshal = call.phase("marshal");
+                auto q = borrow_array<double>(query, "query");
+                auto c = codes_from(codes, self.code_size());
+                const auto n = static_cast<size_t>(c.shape(0));
+                auto query_view = view_1d(q, static_cast<py::ssize_t>(self.dim()), "query");
+                auto result = output_array<double>(out, static_cast<py::ssize_t>(n));
+                marshal.stop();
+
+                call.elements(n);
+                call.bytes_in(array_bytes(q) + array_bytes(c));
+                call.bytes_out(n * sizeof(double));
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    self.cosine_similarity_batch_into(query_view, c.data(), n, mutable_view(result));
+                }
+                return result;
+            },
+            "Estimated cosine similarity between a query and encoded rows,\n"
+            "like vector_ops.cosine_similarity_batch; pass out= to reuse a buffer.",
+            py::arg("query"), py::arg("codes"), py::kw_only(), py::arg("out") = py::none())
+        .def("inner_product_table",
+            [](const ProductQuantizer& self, py::handle query) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pq.inner_product_table");
+                axnmihn::stats::CallScope call(probe);
+                auto q = borrow_array<double>(query, "query");
+                auto query_view = view_1d(q, static_cast<py::ssize_t>(self.dim()), "query");
+                call.elements(self.dim());
+                call.bytes_in(array_bytes(q));
+                std::vector<float> table;
+                {
+                    auto timer = call.kernel();
+                    table = self.inner_product_table(query_view);
+                }
+                call.bytes_out(table.size() * sizeof(float));
+                const size_t ksub = self.ksub();
+                const size_t rows = table.size() / ksub;
+                return vector_to_numpy(std::move(table)).attr("reshape")(rows, ksub);
+            },
+            "ADC lookup table (subspaces, 2**nbits) of query-centroid dot products",
+            py::arg("query"))
+        .def_property_readonly("centroids",
+            [](const ProductQuantizer& self) -> py::object {
+                if (!self.trained()) {
+                    return py::none();
+                }
+                std::vector<float> values = self.centroids();
+                return vector_to_numpy(std::move(values)).attr("reshape")(
+                    self.m(), self.ksub(), self.dsub());
+            },
+            "Codebooks as a float32 (m, 2**nbits, dim // m) array, None until trained")
+        .def_property_readonly("trained", &ProductQuantizer::trained)
+        .def_property_readonly("dim", &ProductQuantizer::dim)
+        .def_property_readonly("m", &ProductQuantizer::m)
+        .def_property_readonly("nbits", &ProductQuantizer::nbits)
+        .def_property_readonly("code_size", &ProductQuantizer::code_size);
+
+    py::class_<PQIndex>(pq_m, "PQIndex")
+        .def(py::init<ProductQuantizer>(), py::arg("quantizer"))
+        .def("add",
+            [](PQIndex& self, py::handle data) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pq.index_add");
+                axnmihn::stats::CallScope call(probe);
+                auto d = borrow_array<double>(data, "data");
+                auto view = view_2d(d, "data");
+                call.elements(view.rows);
+                call.bytes_in(array_bytes(d));
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                self.add(view);
+            },
+            "Encode and append (n, dim) float64 rows; ids continue from len()",
+            py::arg("data"))
+        .def("add_codes",
+            [codes_from](PQIndex& self, py::handle codes) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pq.index_add_codes");
+                axnmihn::stats::CallScope call(probe);
+                auto c = codes_from(codes, self.quantizer().code_size());
+                call.elements(static_cast<size_t>(c.shape(0)));
+                call.bytes_in(array_bytes(c));
+                auto timer = call.kernel();
+                self.add_codes(c.data(), static_cast<size_t>(c.shape(0)));
+            },
+            "Append (n, code_size) uint8 codes from ProductQuantizer.encode",
+            py::arg("codes"))
+        .def("codes",
+            [](const PQIndex& self) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pq.index_codes");
+                axnmihn::stats::CallScope call(probe);
+                const size_t code_size = self.quantizer().code_size();
+                std::vector<uint8_t> codes = self.codes();
+                const size_t n = codes.size() / code_size;
+                call.elements(n);
+                call.bytes_out(codes.size());
+                return vector_to_numpy(std::move(codes)).attr("reshape")(n, code_size);
+            },
+            "Stored codes as a (len, code_size) uint8 array")
+        .def("cosine_similarity_batch",
+            [](const PQIndex& self, py::handle query, py::object out) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pq.index_cosine_similarity_batch");
+                axnmihn::stats::CallScope call(probe);
+                auto q = borrow_array<double>(query, "query");
+                auto query_view = view_1d(q, static_cast<py::ssize_t>(self.quantizer().dim()), "query");
+                // Rows appended while the GIL is released are not scored
+                const size_t n = self.size();
+                auto result = output_array<double>(out, static_cast<py::ssize_t>(n));
+                call.elements(n);
+                call.bytes_in(array_bytes(q) + self.memory_bytes());
+                call.bytes_out(n * sizeof(double));
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    self.cosine_similarity_batch_into(query_view, mutable_view(result), n);
+                }
+                return result;
+            },
+            "Estimated cosine similarity of the query against every stored row",
+            py::arg("query"), py::kw_only(), py::arg("out") = py::none())
+        .def("search",
+            [](const PQIndex& self, py::handle query, size_t k, size_t refine) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pq.search");
+                axnmihn::stats::CallScope call(probe);
+                auto q = borrow_array<double>(query, "query");
+                auto query_view = view_1d(q, static_cast<py::ssize_t>(self.quantizer().dim()), "query");
+                call.elements(self.size());
+                call.bytes_in(array_bytes(q) + self.memory_bytes());
+                axnmihn::pq::SearchResult result;
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    result = self.search(query_view, k, refine);
+                }
+                auto convert = call.phase("convert");
+                return py::make_tuple(vector_to_numpy(std::move(result.ids)),
+                                      vector_to_numpy(std::move(result.scores)));
+            },
+            "Top-k (ids int64, scores float64) by estimated cosine, best first.\n"
+            "4-bit codes shortlist k * refine rows with the fast scan, then re-score.",
+            py::arg("query"), py::arg("k") = 10, py::arg("refine") = 4)
+        .def("__len__", &PQIndex::size)
+        .def_property_readonly("memory_bytes", &PQIndex::memory_bytes)
+        .def_property_readonly("quantizer",
+            [](const PQIndex& self) { return ProductQuantizer(self.quantizer()); },
+            "Copy of the quantizer; retraining it leaves the index unchanged");
+
+    // ====================
+    // Dimensionality Reduction
+    // ====================
+    py::module projection_m = m.def_submodule("projection",
+        "Randomized-SVD and random orthogonal projections for embeddings");
+
+    using axnmihn::projection::LinearProjection;
+
+    auto float_matrix = [](std::vector<float>&& values, size_t rows, size_t cols) {
+        return vector_to_numpy(std::move(values)).attr("reshape")(rows, cols);
+    };
+
+    py::class_<LinearProjection>(projection_m, "LinearProjection")
+        .def(py::init<size_t, size_t>(), py::arg("dim"), py::arg("out_dim"))
+        .def_static("from_components",
+            [](py::handle components, py::object mean) {
+                auto c = borrow_array<float>(components, "components");
+                if (c.ndim() != 2) {
+                    throw py::value_error("components: expected shape (out_dim, dim)");
+                }
+                const auto out_dim = static_cast<size_t>(c.shape(0));
+                const auto dim = static_cast<size_t>(c.shape(1));
+                std::vector<float> values(out_dim * dim);
+                auto u = c.unchecked<2>();
+                for (size_t i = 0; i < out_dim; ++i) {
+                    for (size_t j = 0; j < dim; ++j) {
+                        values[i * dim + j] = u(i, j);
+                    }
+                }
+                std::vector<float> mean_values(dim, 0.0f);
+                if (!mean.is_none()) {
+                    auto mu = borrow_array<float>(mean, "mean");
+                    auto view = view_1d(mu, static_cast<py::ssize_t>(dim), "mean");
+                    for (size_t j = 0; j < dim; ++j) {
+                        mean_values[j] = view[j];
+                    }
+                }
+                return LinearProjection(dim, out_dim, std::move(values), std::move(mean_values));
+            },
+            "Restore a fitted projection from its components (and mean)",
+            py::arg("components"), py::arg("mean") = py::none())
+        .def("train",
+            [](LinearProjection& self, py::handle data, size_t oversample, int power_iterations,
+               bool center, uint64_t seed) {
+                static const uint32_t probe = axnmihn::stats::register_probe("projection.train");
+                axnmihn::stats::CallScope call(probe);
+                auto d = borrow_array<double>(data, "data");
+                auto view = view_2d(d, "data");
+                axnmihn::projection::TrainOptions options;
+                options.oversample = oversample;
+                options.power_iterations = power_iterations;
+                options.center = center;
+                options.seed = seed;
+                call.elements(view.rows);
+                call.bytes_in(array_bytes(d));
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                self.train(view, options);
+            },
+            "Fit components to (n, dim) float64 rows with a randomized SVD",
+            py::arg("data"), py::kw_only(), py::arg("oversample") = 10,
+            py::arg("power_iterations") = 2, py::arg("center") = false, py::arg("seed") = 0)
+        .def("random_orthogonal", &LinearProjection::random_orthogonal,
+            "Use a seeded random orthonormal basis instead of training",
+            py::arg("seed") = 0)
+        .def("project",
+            [](const LinearProjection& self, py::handle data, size_t out, bool normalize,
+               const std::string& dtype) -> py::object {
+                static const uint32_t probe = axnmihn::stats::register_probe("projection.project");
+                axnmihn::stats::CallScope call(probe);
+                auto d = borrow_array<double>(data, "data");
+                auto view = view_2d(d, "data");
+                const size_t cols = out == 0 ? self.out_dim() : out;
+                call.elements(view.rows);
+                call.bytes_in(array_bytes(d));
+                if (dtype == "float32") {
+                    py::array_t<float> result({static_cast<py::ssize_t>(view.rows),
+                                               static_cast<py::ssize_t>(cols)});
+                    call.bytes_out(static_cast<uint64_t>(result.nbytes()));
+                    float* dst = result.mutable_data();
+                    {
+                        auto timer = call.kernel();
+                        py::gil_scoped_release release;
+                        self.project_into(view, out, normalize, dst);
+                    }
+                    return std::move(result);
+                }
+                if (dtype == "float16") {
+                    py::array result(py::dtype("float16"),
+                                     {static_cast<py::ssize_t>(view.rows),
+                                      static_cast<py::ssize_t>(cols)});
+                    call.bytes_out(static_cast<uint64_t>(result.nbytes()));
+                    auto* dst = static_cast<uint16_t*>(result.mutable_data());
+                    {
+                        auto timer = call.kernel();
+                        py::gil_scoped_release release;
+                        self.project_f16_into(view, out, normalize, dst);
+                    }
+                    return std::move(result);
+                }
+                throw std::invalid_argument("dtype must be 'float32' or 'float16'");
+            },
+            "Project (n, dim) float64 rows to (n, dim) values (dim=0: out_dim);\n"
+            "normalize=True L2-normalises each output row for cosine search",
+            py::arg("data"), py::kw_only(), py::arg("dim") = 0, py::arg("normalize") = false,
+            py::arg("dtype") = "float32")
+        .def("tradeoff",
+            [](const LinearProjection& self, py::handle data, const std::vector<size_t>& dims,
+               size_t k, size_t queries, uint64_t seed) {
+                static const uint32_t probe = axnmihn::stats::register_probe("projection.tradeoff");
+                axnmihn::stats::CallScope call(probe);
+                auto d = borrow_array<double>(data, "data");
+                auto view = view_2d(d, "data");
+                call.elements(view.rows);
+                std::vector<axnmihn::projection::TradeoffPoint> points;
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    points = self.tradeoff(view, dims, k, queries, seed);
+                }
+                py::list out;
+                for (const auto& point : points) {
+                    py::dict row;
+                    row["dim"] = point.dim;
+                    row["explained_variance_ratio"] = point.explained_variance_ratio;
+                    row["recall"] = point.recall;
+                    out.append(row);
+                }
+                return out;
+            },
+            "Explained variance and recall@k of projected cosine search for each\n"
+            "candidate dim, measured on a held-out (n, dim) float64 sample",
+            py::arg("data"), py::arg("dims"), py::kw_only(), py::arg("k") = 10,
+            py::arg("queries") = 200, py::arg("seed") = 0)
+        .def_property_readonly("components",
+            [float_matrix](const LinearProjection& self) -> py::object {
+                if (!self.fitted()) {
+                    return py::none();
+                }
+                std::vector<float> values = self.components();
+                return float_matrix(std::move(values), self.out_dim(), self.dim());
+            },
+            "float32 (out_dim, dim) rows, None until fitted")
+        .def_property_readonly("mean",
+            [](const LinearProjection& self) -> py::object {
+                if (!self.fitted()) {
+                    return py::none();
+                }
+                std::vector<float> values = self.mean();
+                return vector_to_numpy(std::move(values));
+            },
+            "float32 (dim,) vector subtracted from normalised inputs")
+        .def_property_readonly("explained_variance",
+            [](const LinearProjection& self) -> py::object {
+                std::vector<double> values = self.explained_variance();
+                if (values.empty()) {
+                    return py::none();
+                }
+                return vector_to_numpy(std::move(values));
+            },
+            "Training variance per component (train() only)")
+        .def_property_readonly("explained_variance_ratio",
+            [](const LinearProjection& self) -> py::object {
+                std::vector<double> values = self.explained_variance();
+                const double total = self.total_variance();
+                if (values.empty() || total <= 0.0) {
+                    return py::none();
+                }
+                for (auto& v : values) {
+                    v /= total;
+                }
+                return vector_to_numpy(std::move(values));
+            },
+            "explained_variance / total_variance (train() only)")
+        .def_property_readonly("total_variance", &LinearProjection::total_variance)
+        .def_property_readonly("fitted", &LinearProjection::fitted)
+        .def_property_readonly("dim", &LinearProjection::dim)
+        .def_property_readonly("out_dim", &LinearProjection::out_dim);
+
+    // ====================
+    // Embedding Space Mapping
+    // ====================
+    py::module mapping_m = m.def_submodule("mapping",
+        "Procrustes / least-squares maps between embedding models");
+
+    using axnmihn::mapping::LinearMap;
+
+    py::class_<LinearMap>(mapping_m, "LinearMap")
+        .def(py::init<size_t, size_t>(), py::arg("source_dim"), py::arg("target_dim"))
+        .def_static("from_matrix",
+            [](py::handle matrix) {
+                auto w = borrow_array<float>(matrix, "matrix");
+                if (w.ndim() != 2) {
+                    throw py::value_error("matrix: expected shape (target_dim, source_dim)");
+                }
+                const auto target_dim = static_cast<size_t>(w.shape(0));
+                const auto source_dim = static_cast<size_t>(w.shape(1));
+                std::vector<float> values(target_dim * source_dim);
+                auto u = w.unchecked<2>();
+                for (size_t i = 0; i < target_dim; ++i) {
+                    for (size_t j = 0; j < source_dim; ++j) {
+                        values[i * source_dim + j] = u(i, j);
+                    }
+                }
+                return LinearMap(source_dim, target_dim, std::move(values));
+            },
+            "Restore a fitted map from its (target_dim, source_dim) matrix",
+            py::arg("matrix"))
+        .def("fit",
+            [](LinearMap& self, py::handle source, py::handle target, const std::string& method,
+               double ridge) {
+                static const uint32_t probe = axnmihn::stats::register_probe("mapping.fit");
+                axnmihn::stats::CallScope call(probe);
+                auto s = borrow_array<double>(source, "source");
+                auto t = borrow_array<double>(target, "target");
+                auto source_view = view_2d(s, "source");
+                auto target_view = view_2d(t, "target");
+                axnmihn::mapping::FitOptions options;
+                if (method == "procrustes") {
+                    options.method = axnmihn::mapping::FitMethod::Procrustes;
+                } else if (method == "least_squares") {
+                    options.method = axnmihn::mapping::FitMethod::LeastSquares;
+                } else {
+                    throw std::invalid_argument("method must be 'procrustes' or 'least_squares'");
+                }
+                options.ridge = ridge;
+                call.elements(source_view.rows);
+                call.bytes_in(array_bytes(s) + array_bytes(t));
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                self.fit(source_view, target_view, options);
+            },
+            "Fit the map to paired (n, source_dim) and (n, target_dim) float64 rows",
+            py::arg("source"), py::arg("target"), py::kw_only(),
+            py::arg("method") = "procrustes", py::arg("ridge") = 1e-3)
+        .def("apply",
+            [](const LinearMap& self, py::handle data, bool normalize) {
+                static const uint32_t probe = axnmihn::stats::register_probe("mapping.apply");
+                axnmihn::stats::CallScope call(probe);
+                auto d = borrow_array<double>(data, "data");
+                auto view = view_2d(d, "data");
+                py::array_t<double> result({static_cast<py::ssize_t>(view.rows),
+                                            static_cast<py::ssize_t>(self.target_dim())});
+                call.elements(view.rows);
+                call.bytes_in(array_bytes(d));
+                call.bytes_out(static_cast<uint64_t>(result.nbytes()));
+                double* dst = result.mutable_data();
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    self.apply_into(view, normalize, dst);
+                }
+                return result;
+            },
+            "Map (n, source_dim) float64 rows to (n, target_dim) float64 rows",
+            py::arg("data"), py::kw_only(), py::arg("normalize") = true)
+        .def("evaluate",
+            [](const LinearMap& self, py::handle source, py::handle target, size_t k,
+               size_t queries, uint64_t seed) {
+                static const uint32_t probe = axnmihn::stats::register_probe("mapping.evaluate");
+                axnmihn::stats::CallScope call(probe);
+                auto s = borrow_array<double>(source, "source");
+                auto t = borrow_array<double>(target, "target");
+                auto source_view = view_2d(s, "source");
+                auto target_view = view_2d(t, "target");
+                call.elements(source_view.rows);
+                axnmihn::mapping::MapQuality quality;
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    quality = self.evaluate(source_view, target_view, k, queries, seed);
+                }
+                py::dict out;
+                out["pairs"] = quality.pairs;
+                out["queries"] = quality.queries;
+                out["k"] = quality.k;
+                out["mean_cosine"] = quality.mean_cosine;
+                out["min_cosine"] = quality.min_cosine;
+                out["neighbor_overlap"] = quality.neighbor_overlap;
+                out["top1"] = quality.top1;
+                return out;
+            },
+            "Mean/min cosine to the true targets, neighbour overlap@k and top-1\n"
+            "self-retrieval of the map on held-out pairs",
+            py::arg("source"), py::arg("target"), py::kw_only(), py::arg("k") = 10,
+            py::arg("queries") = 200, py::arg("seed") = 0)
+        .def_property_readonly("matrix",
+            [float_matrix](const LinearMap& self) -> py::object {
+                if (!self.fitted()) {
+                    return py::none();
+                }
+                std::vector<float> values = self.matrix();
+                return float_matrix(std::move(values), self.target_dim(), self.source_dim());
+            },
+            "float32 (target_dim, source_dim) matrix, None until fitted")
+        .def_property_readonly("fitted", &LinearMap::fitted)
+        .def_property_readonly("source_dim", &LinearMap::source_dim)
+        .def_property_readonly("target_dim", &LinearMap::target_dim);
+
+    // ====================
+    // pgvector Codec
+    // ====================
+    py::module pgvector_m = m.def_submodule("pgvector",
+        "pgvector text and binary (send/recv) encoding of embeddings");
+
+    pgvector_m.attr("MAX_DIM") = axnmihn::pgvector::MAX_DIM;
+
+    pgvector_m.def("format",
+        [](py::handle values) {
+            static const uint32_t probe = axnmihn::stats::register_probe("pgvector.format");
+            axnmihn::stats::CallScope call(probe);
+            std::string text;
+            if (py::isinstance<py::array_t<float>>(values)) {
+                auto v = py::reinterpret_borrow<py::array_t<float>>(values);
+                const py::ssize_t n = length_1d(v, "values");
+                auto view = view_1d(v, n, "values");
+                call.elements(static_cast<uint64_t>(n));
+                call.bytes_in(array_bytes(v));
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                axnmihn::pgvector::format_text(view, static_cast<size_t>(n), text);
+            } else {
+                auto v = borrow_array<double>(values, "values");
+                const py::ssize_t n = length_1d(v, "values");
+                auto view = view_1d(v, n, "values");
+                call.elements(static_cast<uint64_t>(n));
+                call.bytes_in(array_bytes(v));
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                axnmihn::pgvector::format_text(view, static_cast<size_t>(n), text);
+            }
+            call.bytes_out(text.size());
+            return py::str(text);
+        },
+        "pgvector text '[v1,v2,...]' of a 1-D float32/float64 array, each value\n"
+        "rounded to float32 and printed with the shortest round-trip digits",
+        py::arg("values"));
+
+    pgvector_m.def("format_rows",
+        [](py::handle rows) {
+            static const uint32_t probe = axnmihn::stats::register_probe("pgvector.format_rows");
+            axnmihn::stats::CallScope call(probe);
+            auto r = borrow_array<double>(rows, "rows");
+            auto view = view_2d(r, "rows");
+            call.elements(view.rows);
+            call.bytes_in(array_bytes(r));
+            std::vector<std::string> texts;
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                texts = axnmihn::pgvector::format_text_rows(view);
+            }
+            py::list out(texts.size());
+            for (size_t i = 0; i < texts.size(); ++i) {
+                call.bytes_out(texts[i].size());
+                out[i] = py::str(texts[i]);
+            }
+            return out;
+        },
+        "format() for every row of an (n, dim) array",
+        py::arg("rows"));
+
+    pgvector_m.def("parse",
+        [](py::handle text, const std::string& dtype) -> py::object {
+            static const uint32_t probe = axnmihn::stats::register_probe("pgvector.parse");
+            axnmihn::stats::CallScope call(probe);
+            const bool half = half_output(dtype);
+            const std::string_view view = text_view(text, "text");
+            call.bytes_in(view.size());
+            std::vector<float> values;
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                axnmihn::pgvector::parse_text(view, values);
+            }
+            call.elements(values.size());
+            if (!half) {
+                return vector_to_numpy(std::move(values));
+            }
+            py::array result(py::dtype("float16"), static_cast<py::ssize_t>(values.size()));
+            axnmihn::projection::float_to_half(
+                values.data(), values.size(), static_cast<uint16_t*>(result.mutable_data()));
+            return std::move(result);
+        },
+        "Parse pgvector text (str or bytes) into a 1-D float32 or float16 array",
+        py::arg("text"), py::kw_only(), py::arg("dtype") = "float32");
+
+    pgvector_m.def("parse_rows",
+        [](py::sequence texts, size_t dim, const std::string& dtype) -> py::object {
+            static const uint32_t probe = axnmihn::stats::register_probe("pgvector.parse_rows");
+            axnmihn::stats::CallScope call(probe);
+            const bool half = half_output(dtype);
+            // The copy keeps every text alive while the GIL is released
+            py::list held(texts);
+            std::vector<std::string_view> views;
+            views.reserve(held.size());
+            for (py::handle text : held) {
+                views.push_back(text_view(text, "texts"));
+                call.bytes_in(views.back().size());
+            }
+            call.elements(views.size());
+            std::vector<float> values;
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                values = axnmihn::pgvector::parse_text_rows(views, dim);
+            }
+            const auto rows = static_cast<py::ssize_t>(views.size());
+            const auto cols = static_cast<py::ssize_t>(dim);
+            if (!half) {
+                return vector_to_numpy(std::move(values)).attr("reshape")(rows, cols);
+            }
+            py::array result(py::dtype("float16"), {rows, cols});
+            axnmihn::projection::float_to_half(
+                values.data(), values.size(), static_cast<uint16_t*>(result.mutable_data()));
+            return std::move(result);
+        },
+        "Parse many pgvector texts of one dimension (dim=0: the first row's)\n"
+        "into an (n, dim) float32 or float16 array",
+        py::arg("texts"), py::kw_only(), py::arg("dim") = 0, py::arg("dtype") = "float32");
+
+    pgvector_m.def("encode_binary",
+        [](py::handle values, const std::string& type) {
+            static const uint32_t probe = axnmihn::stats::register_probe("pgvector.encode_binary");
+            axnmihn::stats::CallScope call(probe);
+            const auto wire = wire_type(type);
+            auto v = borrow_array<float>(values, "values");
+            const py::ssize_t n = length_1d(v, "values");
+            auto view = view_1d(v, n, "values");
+            call.elements(static_cast<uint64_t>(n));
+            call.bytes_in(array_bytes(v));
+
+            std::vector<float> contiguous;
+            const float* data = view.ptr();
+            if (!view.contiguous()) {
+                contiguous.resize(static_cast<size_t>(n));
+                for (py::ssize_t i = 0; i < n; ++i) {
+                    contiguous[static_cast<size_t>(i)] = view[static_cast<size_t>(i)];
+                }
+                data = contiguous.data();
+            }
+            std::string buffer(axnmihn::pgvector::binary_size(wire, static_cast<size_t>(n)), '\0');
+            {
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                axnmihn::pgvector::encode_binary(data, static_cast<size_t>(n), wire,
+                                                 reinterpret_cast<uint8_t*>(&buffer[0]));
+            }
+            call.bytes_out(buffer.size());
+            return py::bytes(buffer);
+        },
+        "Binary send/recv form of a 1-D array for a 'vector' or 'halfvec' column",
+        py::arg("values"), py::kw_only(), py::arg("type") = "vector");
+
+    pgvector_m.def("decode_binary",
+        [](py::bytes data, const std::string& type, const std::string& dtype) -> py::object {
+            static const uint32_t probe = axnmihn::stats::register_probe("pgvector.decode_binary");
+            axnmihn::stats::CallScope call(probe);
+            const auto wire = wire_type(type);
+            const bool half = half_output(dtype);
+            const std::string_view view = text_view(data, "data");
+            const auto* bytes = reinterpret_cast<const uint8_t*>(view.data());
+            const size_t dim = axnmihn::pgvector::binary_dim(bytes, view.size(), wire);
+            call.elements(dim);
+            call.bytes_in(view.size());
+            if (half) {
+                py::array result(py::dtype("float16"), static_cast<py::ssize_t>(dim));
+                auto timer = call.kernel();
+                axnmihn::pgvector::decode_binary(bytes, view.size(), wire,
+                                                 static_cast<uint16_t*>(result.mutable_data()));
+                return std::move(result);
+            }
+            py::array_t<float> result(static_cast<py::ssize_t>(dim));
+            auto timer = call.kernel();
+            axnmihn::pgvector::decode_binary(bytes, view.size(), wire, result.mutable_data());
+            return std::move(result);
+        },
+        "Decode a binary 'vector' or 'halfvec' value into a float32 or float16 array",
+        py::arg("data"), py::kw_only(), py::arg("type") = "vector",
+        py::arg("dtype") = "float32");
+
+    // ====================
+    // Binary COPY Loader
+    // ====================
+    py::module pgcopy_m = m.def_submodule("pgcopy",
+        "Columnar loading of the memories table from binary COPY output");
+
+    using axnmihn::pgcopy::MemoryColumns;
+    using axnmihn::pgcopy::MemoryLoader;
+
+    pgcopy_m.attr("BASE_COLUMNS") = axnmihn::pgcopy::BASE_COLUMNS;
+
+    py::class_<MemoryColumns>(pgcopy_m, "MemoryColumns")
+        .def("__len__", &MemoryColumns::rows)
+        .def_readonly("dim", &MemoryColumns::dim)
+        .def_property_readonly("ids",
+            [](const MemoryColumns& self) {
+                py::list ids(self.ids.size());
+                for (size_t i = 0; i < self.ids.size(); ++i) {
+                    ids[i] = py::str(self.ids[i]);
+                }
+                return ids;
+            },
+            "Memory uuids as a list of str")
+        .def_property_readonly("importance",
+            [](py::object self) { return column_view(self.cast<const MemoryColumns&>().importance, self); },
+            "float64 importance (NULL reads as 0.5)")
+        .def_property_readonly("created_at",
+            [](py::object self) { return column_view(self.cast<const MemoryColumns&>().created_at, self); },
+            "float64 epoch seconds (NULL reads as 0)")
+        .def_property_readonly("last_accessed",
+            [](py::object self) { return column_view(self.cast<const MemoryColumns&>().last_accessed, self); },
+            "float64 epoch seconds (NULL reads as -1)")
+        .def_property_readonly("access_count",
+            [](py::object self) { return column_view(self.cast<const MemoryColumns&>().access_count, self); },
+            "int32 access counts")
+        .def_property_readonly("memory_type",
+            [](py::object self) { return column_view(self.cast<const MemoryColumns&>().memory_type, self); },
+            "int32 decay type codes (0=conversation, 1=fact, 2=preference, 3=insight)")
+        .def_property_readonly("token_cost",
+            [](py::object self) { return column_view(self.cast<const MemoryColumns&>().token_cost, self); },
+            "int32 estimated prompt tokens, len(content) // 4 (NULL reads as 0)")
+        .def_property_readonly("has_embedding",
+            [](py::object self) -> py::object {
+                const auto& c = self.cast<const MemoryColumns&>();
+                if (c.dim == 0) {
+                    return py::none();
+                }
+                return py::array(py::dtype("bool"), {static_cast<py::ssize_t>(c.rows())},
+                                 c.has_embedding.data(), self);
+            },
+            "bool mask of rows with a non-NULL embedding, None without embeddings")
+        .def_property_readonly("embeddings",
+            [](py::object self) -> py::object {
+                const auto& c = self.cast<const MemoryColumns&>();
+                if (c.dim == 0) {
+                    return py::none();
+                }
+                return py::array_t<float>(
+                    {static_cast<py::ssize_t>(c.rows()), static_cast<py::ssize_t>(c.dim)},
+                    c.embeddings.data(), self);
+            },
+            "float32 (rows, dim) embeddings (zero rows for NULL), None without embeddings")
+        .def("decay_records",
+            [](const MemoryColumns& self, double now, py::object connection_count,
+               py::object channel_mentions) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pgcopy.decay_records");
+                axnmihn::stats::CallScope call(probe);
+                const auto n = static_cast<py::ssize_t>(self.rows());
+                const int32_t zero = 0;
+                py::array_t<int32_t> conn_a, chan_a;
+                auto conn = optional_column(connection_count, n, "connection_count", &zero, conn_a);
+                auto chan = optional_column(channel_mentions, n, "channel_mentions", &zero, chan_a);
+
+                py::array_t<axnmihn::decay::DecayRecord> result(n);
+                call.elements(self.rows());
+                call.bytes_out(self.rows() * sizeof(axnmihn::decay::DecayRecord));
+                {
+                    auto timer = call.kernel();
+                    py::gil_scoped_release release;
+                    axnmihn::pgcopy::decay_records(self, now, conn, chan, result.mutable_data());
+                }
+                return result;
+            },
+            "Decay inputs at time `now` (epoch seconds) as a decay_ops.RECORD_DTYPE array;\n"
+            "graph connections and channel mentions come from the caller (None = 0)",
+            py::arg("now"), py::kw_only(), py::arg("connection_count") = py::none(),
+            py::arg("channel_mentions") = py::none())
+        .def("upsert_into",
+            [](const MemoryColumns& self, MemoryEngine& engine) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pgcopy.upsert_into");
+                axnmihn::stats::CallScope call(probe);
+                call.elements(self.rows());
+                call.bytes_in(self.embeddings.size() * sizeof(float));
+                auto timer = call.kernel();
+                py::gil_scoped_release release;
+                return axnmihn::pgcopy::upsert_into(self, engine);
+            },
+            "Upsert every row with an embedding into a MemoryEngine; returns the count",
+            py::arg("engine"));
+
+    py::class_<MemoryLoader>(pgcopy_m, "MemoryLoader")
+        .def(py::init([](size_t dim, const std::string& type) {
+            return std::make_unique<MemoryLoader>(dim, wire_type(type));
+        }), py::arg("dim") = 0, py::kw_only(), py::arg("type") = "halfvec")
+        .def("feed",
+            [](MemoryLoader& self, py::handle data) {
+                static const uint32_t probe = axnmihn::stats::register_probe("pgcopy.feed");
+                axnmihn::stats::CallScope call(probe);
+                py::buffer_info info = contiguous_buffer(data, "data");
+                const auto nbytes = static_cast<size_t>(info.size * info.itemsize);
+                call.bytes_in(nbytes);
+                size_t rows = 0;
+                {
+                    auto timer = call.kernel();
+                    // GIL held: the caller's buffer may be reused once we return
+                    rows = self.feed(static_cast<const uint8_t*>(info.ptr), nbytes);
+                }
+                call.elements(rows);
+                return rows;
+            },
+            "Decode the next chunk of the COPY stream; returns the rows it completed",
+            py::arg("data"))
+        .def("write",
+            [](MemoryLoader& self, py::handle data) {
+                // File-like sink for cursor.copy_expert(); returns bytes consumed
+                py::buffer_info info = contiguous_buffer(data, "data");
+                const auto nbytes = static_cast<size_t>(info.size * info.itemsize);
+                self.feed(static_cast<const uint8_t*>(info.ptr), nbytes);
+                return nbytes;
+            },
+            "feed() under the file API, so a loader can be passed to copy_expert()",
+            py::arg("data"))
+        .def("finish", &MemoryLoader::finish,
+            "Raise ValueError unless the whole stream (through the trailer) was fed")
+        .def("reserve", &MemoryLoader::reserve,
+            "Reserve column space for a known row count", py::arg("rows"))
+        .def("take", &MemoryLoader::take,
+            "Hand over the rows decoded so far as MemoryColumns and start a new batch")
+        .def("__len__", [](const MemoryLoader& self) { return self.columns().rows(); },
+            "Rows in the current batch")
+        .def_property_readonly("done", &MemoryLoader::done)
+        .def_property_readonly("buffered", &MemoryLoader::buffered)
+        .def_property_readonly("total_rows", &MemoryLoader::total_rows)
+        .def_property_readonly("dim", &MemoryLoader::dim);
+
     // ====================
     // Module Info
     // ====================
@@ -272,5 +3037,115 @@ PYBIND11_MODULE(axnmihn_native, m) {
         #endif
     }, "Check if ARM NEON SIMD is available");
 
+    m.def("num_threads", []() {
+        return axnmihn::runtime::default_pool().size();
+    }, "Number of worker threads in the native pool used by *_async calls");
+
+    m.def("set_simd_variant", [](const std::string& variant) {
+        axnmihn::simd::set_variant(variant);  // invalid_argument -> ValueError
+    }, "Force the kernels onto one SIMD path: 'auto', 'scalar' or the compiled variant",
+       py::arg("variant"));
+
+    m.def("simd_variant", []() {
+        return std::string(axnmihn::simd::active());
+    }, "SIMD path the kernels currently take");
+
+    m.def("simd_variants", []() {
+        return axnmihn::simd::available();
+    }, "SIMD variants selectable on this build and CPU");
+
+    m.def("set_max_parallelism", [](size_t threads) {
+        axnmihn::runtime::set_max_parallelism(threads);
+    }, "Cap the threads (caller included) one parallel kernel may use; 0 removes the cap",
+       py::arg("threads"));
+
+    m.def("max_parallelism", []() {
+        return axnmihn::runtime::max_parallelism();
+    }, "Current parallel kernel thread cap (0 = pool size + 1)");
+
+    m.def("set_strict_mode", [](bool enabled) {
+        g_strict_arrays.store(enabled, std::memory_order_relaxed);
+    }, "Raise TypeError instead of copying inputs whose dtype needs conversion",
+       py::arg("enabled"));
+
+    m.def("strict_mode", []() {
+        return g_strict_arrays.load(std::memory_order_relaxed);
+    }, "Check whether strict (no hidden copy) mode is enabled");
+
+    m.def("allocator_stats", []() {
+        const auto arena = axnmihn::alloc::arena_stats();
+        const auto pool = axnmihn::alloc::buffer_pool::stats();
+        py::dict a;
+        a["arenas"] = arena.arenas;
+        a["chunk_allocs"] = arena.chunk_allocs;
+        a["chunk_frees"] = arena.chunk_frees;
+        a["bytes_reserved"] = arena.bytes_reserved;
+        a["high_water"] = arena.high_water;
+        py::dict p;
+        p["acquires"] = pool.acquires;
+        p["hits"] = pool.hits;
+        p["heap_allocs"] = pool.heap_allocs;
+        p["releases"] = pool.releases;
+        p["heap_frees"] = pool.heap_frees;
+        p["bytes_cached"] = pool.bytes_cached;
+        p["bytes_in_use"] = pool.bytes_in_use;
+        p["cache_limit"] = axnmihn::alloc::buffer_pool::cache_limit();
+        py::dict d;
+        d["arena"] = a;
+        d["pool"] = p;
+        return d;
+    }, "Per-thread arena (call temporaries) and result buffer pool counters");
+
+    m.def("set_buffer_pool_limit", [](size_t bytes) {
+        axnmihn::alloc::buffer_pool::set_cache_limit(bytes);
+    }, "Cap the bytes of released result buffers kept for reuse (default 256 MiB)",
+       py::arg("bytes"));
+
+    m.def("trim_buffer_pool", []() {
+        axnmihn::alloc::buffer_pool::trim();
+    }, "Return every cached result buffer to the heap");
+
+    m.def("stats", []() {
+        return stats_to_python(axnmihn::stats::snapshot());
+    }, "Per-entry-point call counters merged across threads since the last reset.\n"
+       "Each value has calls, elements, bytes_in, bytes_out, total_ns, kernel_ns,\n"
+       "max_ns, p50_ns/p90_ns/p99_ns and non-empty latency buckets as\n"
+       "(upper_bound_ns, count) pairs.");
+
+    m.def("reset_stats", []() {
+        axnmihn::stats::reset();
+    }, "Zero the counters reported by stats()");
+
+    m.def("set_stats_enabled", [](bool enabled) {
+        axnmihn::stats::set_enabled(enabled);
+    }, "Turn call counting on or off (on by default)", py::arg("enabled"));
+
+    m.def("stats_enabled", []() {
+        return axnmihn::stats::enabled();
+    }, "Check whether call counting is on");
+
+    m.def("set_tracing", [](bool enabled) {
+        axnmihn::trace::set_enabled(enabled);
+    }, "Turn span recording into per-thread ring buffers on or off (off by default)",
+       py::arg("enabled"));
+
+    m.def("tracing", []() {
+        return axnmihn::trace::enabled();
+    }, "Check whether span recording is on");
+
+    m.def("trace_dump", [](py::object path) {
+        std::string json = axnmihn::trace::dump_json();
+        if (!path.is_none()) {
+            py::module_::import("pathlib").attr("Path")(path).attr("write_text")(json);
+        }
+        return json;
+    }, "Return buffered spans as Chrome trace JSON (chrome://tracing, Perfetto);\n"
+       "also writes it to `path` when given",
+       py::arg("path") = py::none());
+
+    m.def("trace_clear", []() {
+        axnmihn::trace::clear();
+    }, "Drop all buffered spans");
+
     m.attr("__version__") = "0.1.0";
 }
@@ -0,0 +1,169 @@
+#include "buffer_pool.hpp"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace axnmihn {
+namespace alloc {
+namespace buffer_pool {
+
+namespace {
+
+constexpr size_t BUFFER_ALIGN = 64;
+constexpr unsigned MIN_SHIFT = 8;   // 256 B
+constexpr unsigned MAX_SHIFT = 26;  // 64 MiB
+constexpr size_t NUM_CLASSES = MAX_SHIFT - MIN_SHIFT + 1;
+
+static_assert(MIN_CLASS_BYTES == size_t{1} << MIN_SHIFT, "class bounds");
+static_assert(MAX_CLASS_BYTES == size_t{1} << MAX_SHIFT, "class bounds");
+
+struct SizeClass {
+    std::mutex mutex;
+    std::vector<void*> free;
+};
+
+struct Pool {
+    std::array<SizeClass, NUM_CLASSES> classes;
+    std::atomic<size_t> limit{256u * 1024 * 1024};
+
+    std::atomic<uint64_t> acquires{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> heap_allocs{0};
+    std::atomic<uint64_t> releases{0};
+    std::atomic<uint64_t> heap_frees{0};
+    std::atomic<uint64_t> bytes_cached{0};
+    std::atomic<uint64_t> bytes_in_use{0};
+};
+
+// Leaked: NumPy arrays may release buffers during interpreter teardown
+Pool& pool() {
+    static Pool* instance = new Pool();
+    return *instance;
+}
+
+// Class index for a request, or NUM_CLASSES when it bypasses the pool
+size_t class_of(size_t bytes) {
+    if (bytes <= MIN_CLASS_BYTES) {
+        return 0;
+    }
+    if (bytes > MAX_CLASS_BYTES) {
+        return NUM_CLASSES;
+    }
+    const unsigned shift = 64u - static_cast<unsigned>(__builtin_clzll(bytes - 1));
+    return shift - MIN_SHIFT;
+}
+
+size_t class_bytes(size_t index) {
+    return size_t{1} << (index + MIN_SHIFT);
+}
+
+void* heap_alloc(size_t bytes) {
+    return ::operator new(bytes, std::align_val_t(BUFFER_ALIGN));
+}
+
+void heap_free(void* ptr) {
+    ::operator delete(ptr, std::align_val_t(BUFFER_ALIGN));
+}
+
+}  // anonymous namespace
+
+void* acquire(size_t bytes) {
+    Pool& p = pool();
+    p.acquires.fetch_add(1, std::memory_order_relaxed);
+    const size_t index = class_of(bytes);
+    const size_t size = index < NUM_CLASSES ? class_bytes(index) : bytes;
+    p.bytes_in_use.fetch_add(size, std::memory_order_relaxed);
+
+    if (index < NUM_CLASSES) {
+        SizeClass& c = p.classes[index];
+        std::lock_guard<std::mutex> lock(c.mutex);
+        if (!c.free.empty()) {
+            void* ptr = c.free.back();
+            c.free.pop_back();
+            p.hits.fetch_add(1, std::memory_order_relaxed);
+            p.bytes_cached.fetch_sub(size, std::memory_order_relaxed);
+            return ptr;
+        }
+    }
+    p.heap_allocs.fetch_add(1, std::memory_order_relaxed);
+    return heap_alloc(size);
+}
+
+void release(void* ptr, size_t bytes) {
+    if (!ptr) {
+        return;
+    }
+    Pool& p = pool();
+    p.releases.fetch_add(1, std::memory_order_relaxed);
+    const size_t index = class_of(bytes);
+    const size_t size = index < NUM_CLASSES ? class_bytes(index) : bytes;
+    p.bytes_in_use.fetch_sub(size, std::memory_order_relaxed);
+
+    if (index < NUM_CLASSES &&
+        p.bytes_cached.load(std::memory_order_relaxed) + size <= p.limit.load(std::memory_order_relaxed)) {
+        SizeClass& c = p.classes[index];
+        std::lock_guard<std::mutex> lock(c.mutex);
+        c.free.push_back(ptr);
+        p.bytes_cached.fetch_add(size, std::memory_order_relaxed);
+        return;
+    }
+    p.heap_frees.fetch_add(1, std::memory_order_relaxed);
+    heap_free(ptr);
+}
+
+void set_cache_limit(size_t bytes) {
+    pool().limit.store(bytes, std::memory_order_relaxed);
+    // Drop the largest classes first until the cache fits
+    Pool& p = pool();
+    for (size_t index = NUM_CLASSES; index-- > 0;) {
+        if (p.bytes_cached.load(std::memory_order_relaxed) <= bytes) {
+            break;
+        }
+        SizeClass& c = p.classes[index];
+        std::lock_guard<std::mutex> lock(c.mutex);
+        while (!c.free.empty() && p.bytes_cached.load(std::memory_order_relaxed) > bytes) {
+            heap_free(c.free.back());
+            c.free.pop_back();
+            p.bytes_cached.fetch_sub(class_bytes(index), std::memory_order_relaxed);
+            p.heap_frees.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+size_t cache_limit() {
+    return pool().limit.load(std::memory_order_relaxed);
+}
+
+void trim() {
+    Pool& p = pool();
+    for (size_t index = 0; index < NUM_CLASSES; ++index) {
+        SizeClass& c = p.classes[index];
+        std::lock_guard<std::mutex> lock(c.mutex);
+        for (void* ptr : c.free) {
+            heap_free(ptr);
+        }
+        p.bytes_cached.fetch_sub(c.free.size() * class_bytes(index), std::memory_order_relaxed);
+        p.heap_frees.fetch_add(c.free.size(), std::memory_order_relaxed);
+        c.free.clear();
+        c.free.shrink_to_fit();
+    }
+}
+
+PoolStats stats() {
+    Pool& p = pool();
+    PoolStats s;
+    s.acquires = p.acquires.load(std::memory_order_relaxed);
+    s.hits = p.hits.load(std::memory_order_relaxed);
+    s.heap_allocs = p.heap_allocs.load(std::memory_order_relaxed);
+    s.releases = p.releases.load(std::memory_order_relaxed);
+    s.heap_frees = p.heap_frees.load(std::memory_order_relaxed);
+    s.bytes_cached = p.bytes_cached.load(std::memory_order_relaxed);
+    s.bytes_in_use = p.bytes_in_use.load(std::memory_order_relaxed);
+    return s;
+}
+
+}  // namespace buffer_pool
+}  // namespace alloc
+}  // namespace axnmihn
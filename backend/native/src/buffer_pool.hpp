@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace axnmihn {
+namespace alloc {
+
+/**
+ * Process-wide pool of size-classed buffers for kernel results.
+ *
+ * Result buffers outlive the call (they are handed to NumPy), so they
+ * cannot come from the thread arena. Instead each request is rounded up
+ * to a power-of-two class and served from that class's free list; the
+ * buffer goes back to the list when its owner (e.g. the NumPy capsule)
+ * releases it. Requests above MAX_CLASS_BYTES bypass the pool.
+ */
+namespace buffer_pool {
+
+constexpr size_t MIN_CLASS_BYTES = 256;
+constexpr size_t MAX_CLASS_BYTES = 64 * 1024 * 1024;
+
+/**
+ * Get a buffer of at least `bytes` (64-byte aligned).
+ *
+ * Args:
+ *     bytes: Requested size
+ *
+ * Returns:
+ *     Buffer to be returned with release(ptr, bytes) using the same size
+ */
+void* acquire(size_t bytes);
+
+/** Return a buffer obtained from acquire(bytes). */
+void release(void* ptr, size_t bytes);
+
+/**
+ * Cap on bytes kept in free lists (default 256 MiB). Releases beyond it
+ * go straight back to the heap. Lowering the cap trims immediately.
+ */
+void set_cache_limit(size_t bytes);
+size_t cache_limit();
+
+/** Free every cached buffer. */
+void trim();
+
+struct PoolStats {
+    uint64_t acquires = 0;
+    uint64_t hits = 0;           // served from a free list
+    uint64_t heap_allocs = 0;    // misses and oversize requests
+    uint64_t releases = 0;
+    uint64_t heap_frees = 0;     // over the cache limit, oversize, or trimmed
+    uint64_t bytes_cached = 0;   // sitting in free lists
+    uint64_t bytes_in_use = 0;   // acquired and not yet released
+};
+
+PoolStats stats();
+
+}  // namespace buffer_pool
+
+/**
+ * std-compatible allocator backed by the buffer pool. A vector using it
+ * can be moved into a NumPy capsule; freeing the array recycles the
+ * buffer for the next call.
+ */
+template<typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() = default;
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(buffer_pool::acquire(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t n) {
+        buffer_pool::release(p, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const { return true; }
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>&) const { return false; }
+};
+
+template<typename T>
+using pooled_vector = std::vector<T, PoolAllocator<T>>;
+
+}  // namespace alloc
+}  // namespace axnmihn
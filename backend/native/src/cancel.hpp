@@ -0,0 +1,29 @@
+#pragma once
+
+#include <atomic>
+
+namespace axnmihn {
+namespace runtime {
+
+/**
+ * Cooperative cancellation flag shared between a caller and a kernel.
+ *
+ * Long-running kernels take an optional `const CancelToken*` and poll
+ * it between units of work (rows, components, ...), returning early with
+ * a partial result once it is set. A null token means "never cancelled".
+ */
+class CancelToken {
+public:
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled_{false};
+};
+
+inline bool is_cancelled(const CancelToken* token) {
+    return token != nullptr && token->cancelled();
+}
+
+}  // namespace runtime
+}  // namespace axnmihn
@@ -0,0 +1,575 @@
+#include "content_hash.hpp"
+#include "thread_pool.hpp"
+#include "unicode_norm.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace axnmihn {
+namespace hashing {
+
+namespace {
+
+// =============================================================================
+// XXH3 (scalar port of the reference implementation)
+// =============================================================================
+
+constexpr uint32_t PRIME32_1 = 0x9E3779B1U;
+constexpr uint32_t PRIME32_2 = 0x85EBCA77U;
+constexpr uint32_t PRIME32_3 = 0xC2B2AE3DU;
+constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+constexpr uint64_t PRIME_MX1 = 0x165667919E3779F9ULL;
+constexpr uint64_t PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+constexpr size_t SECRET_SIZE = 192;
+constexpr size_t SECRET_SIZE_MIN = 136;
+constexpr size_t STRIPE_LEN = 64;
+constexpr size_t SECRET_CONSUME_RATE = 8;
+constexpr size_t ACC_NB = 8;
+constexpr size_t MIDSIZE_MAX = 240;
+constexpr size_t MIDSIZE_STARTOFFSET = 3;
+constexpr size_t MIDSIZE_LASTOFFSET = 17;
+constexpr size_t SECRET_LASTACC_START = 7;
+constexpr size_t SECRET_MERGEACCS_START = 11;
+
+alignas(64) constexpr uint8_t K_SECRET[SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+// Unaligned little-endian reads (x86-64 / aarch64 hosts)
+inline uint64_t read64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void write64(uint8_t* p, uint64_t v) {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+inline uint32_t rotl32(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+inline uint64_t swap64(uint64_t x) { return __builtin_bswap64(x); }
+inline uint32_t swap32(uint32_t x) { return __builtin_bswap32(x); }
+
+inline Hash128 mul64to128(uint64_t a, uint64_t b) {
+    const unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+    return Hash128{static_cast<uint64_t>(p), static_cast<uint64_t>(p >> 64)};
+}
+
+inline uint64_t mul128_fold64(uint64_t a, uint64_t b) {
+    const Hash128 p = mul64to128(a, b);
+    return p.low ^ p.high;
+}
+
+inline uint64_t xxh64_avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+inline uint64_t avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= PRIME_MX1;
+    h ^= h >> 32;
+    return h;
+}
+
+inline uint64_t rrmxmx(uint64_t h, uint64_t len) {
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= PRIME_MX2;
+    h ^= (h >> 35) + len;
+    h *= PRIME_MX2;
+    h ^= h >> 28;
+    return h;
+}
+
+inline uint64_t mix16(const uint8_t* in, const uint8_t* secret, uint64_t seed) {
+    return mul128_fold64(read64(in) ^ (read64(secret) + seed),
+                         read64(in + 8) ^ (read64(secret + 8) - seed));
+}
+
+// ---- 64-bit, short inputs ----
+
+uint64_t len_1to3_64(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    const uint32_t combined = (static_cast<uint32_t>(in[0]) << 16) |
+                              (static_cast<uint32_t>(in[len >> 1]) << 24) |
+                              static_cast<uint32_t>(in[len - 1]) |
+                              (static_cast<uint32_t>(len) << 8);
+    const uint64_t bitflip = (read32(secret) ^ read32(secret + 4)) + seed;
+    return xxh64_avalanche(static_cast<uint64_t>(combined) ^ bitflip);
+}
+
+uint64_t len_4to8_64(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+    const uint32_t in1 = read32(in);
+    const uint32_t in2 = read32(in + len - 4);
+    const uint64_t bitflip = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+    const uint64_t in64 = in2 + (static_cast<uint64_t>(in1) << 32);
+    return rrmxmx(in64 ^ bitflip, len);
+}
+
+uint64_t len_9to16_64(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    const uint64_t bitflip1 = (read64(secret + 24) ^ read64(secret + 32)) + seed;
+    const uint64_t bitflip2 = (read64(secret + 40) ^ read64(secret + 48)) - seed;
+    const uint64_t lo = read64(in) ^ bitflip1;
+    const uint64_t hi = read64(in + len - 8) ^ bitflip2;
+    const uint64_t acc = len + swap64(lo) + hi + mul128_fold64(lo, hi);
+    return avalanche(acc);
+}
+
+uint64_t len_0to16_64(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    if (len > 8) return len_9to16_64(in, len, secret, seed);
+    if (len >= 4) return len_4to8_64(in, len, secret, seed);
+    if (len > 0) return len_1to3_64(in, len, secret, seed);
+    return xxh64_avalanche(seed ^ (read64(secret + 56) ^ read64(secret + 64)));
+}
+
+uint64_t len_17to128_64(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    uint64_t acc = len * PRIME64_1;
+    if (len > 32) {
+        if (len > 64) {
+            if (len > 96) {
+                acc += mix16(in + 48, secret + 96, seed);
+                acc += mix16(in + len - 64, secret + 112, seed);
+            }
+            acc += mix16(in + 32, secret + 64, seed);
+            acc += mix16(in + len - 48, secret + 80, seed);
+        }
+        acc += mix16(in + 16, secret + 32, seed);
+        acc += mix16(in + len - 32, secret + 48, seed);
+    }
+    acc += mix16(in, secret, seed);
+    acc += mix16(in + len - 16, secret + 16, seed);
+    return avalanche(acc);
+}
+
+uint64_t len_129to240_64(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    uint64_t acc = len * PRIME64_1;
+    const size_t rounds = len / 16;
+    for (size_t i = 0; i < 8; ++i) {
+        acc += mix16(in + 16 * i, secret + 16 * i, seed);
+    }
+    acc = avalanche(acc);
+    for (size_t i = 8; i < rounds; ++i) {
+        acc += mix16(in + 16 * i, secret + 16 * (i - 8) + MIDSIZE_STARTOFFSET, seed);
+    }
+    acc += mix16(in + len - 16, secret + SECRET_SIZE_MIN - MIDSIZE_LASTOFFSET, seed);
+    return avalanche(acc);
+}
+
+// ---- long inputs (shared by both widths) ----
+
+inline void accumulate_512(uint64_t* acc, const uint8_t* in, const uint8_t* secret) {
+    for (size_t i = 0; i < ACC_NB; ++i) {
+        const uint64_t data = read64(in + 8 * i);
+        const uint64_t key = data ^ read64(secret + 8 * i);
+        acc[i ^ 1] += data;
+        acc[i] += static_cast<uint64_t>(static_cast<uint32_t>(key)) * (key >> 32);
+    }
+}
+
+inline void scramble(uint64_t* acc, const uint8_t* secret) {
+    for (size_t i = 0; i < ACC_NB; ++i) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= read64(secret + 8 * i);
+        a *= PRIME32_1;
+        acc[i] = a;
+    }
+}
+
+void hash_long_accumulate(uint64_t* acc, const uint8_t* in, size_t len, const uint8_t* secret) {
+    const size_t stripes_per_block = (SECRET_SIZE - STRIPE_LEN) / SECRET_CONSUME_RATE;
+    const size_t block_len = STRIPE_LEN * stripes_per_block;
+    const size_t blocks = (len - 1) / block_len;
+
+    for (size_t n = 0; n < blocks; ++n) {
+        const uint8_t* block = in + n * block_len;
+        for (size_t s = 0; s < stripes_per_block; ++s) {
+            accumulate_512(acc, block + s * STRIPE_LEN, secret + s * SECRET_CONSUME_RATE);
+        }
+        scramble(acc, secret + SECRET_SIZE - STRIPE_LEN);
+    }
+
+    const size_t stripes = ((len - 1) - block_len * blocks) / STRIPE_LEN;
+    const uint8_t* tail = in + blocks * block_len;
+    for (size_t s = 0; s < stripes; ++s) {
+        accumulate_512(acc, tail + s * STRIPE_LEN, secret + s * SECRET_CONSUME_RATE);
+    }
+    accumulate_512(acc, in + len - STRIPE_LEN,
+                   secret + SECRET_SIZE - STRIPE_LEN - SECRET_LASTACC_START);
+}
+
+uint64_t merge_accs(const uint64_t* acc, const uint8_t* secret, uint64_t start) {
+    uint64_t result = start;
+    for (size_t i = 0; i < 4; ++i) {
+        result += mul128_fold64(acc[2 * i] ^ read64(secret + 16 * i),
+                                acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+    }
+    return avalanche(result);
+}
+
+void init_acc(uint64_t* acc) {
+    acc[0] = PRIME32_3;
+    acc[1] = PRIME64_1;
+    acc[2] = PRIME64_2;
+    acc[3] = PRIME64_3;
+    acc[4] = PRIME64_4;
+    acc[5] = PRIME32_2;
+    acc[6] = PRIME64_5;
+    acc[7] = PRIME32_1;
+}
+
+// Seeded long hashes use the default secret shifted by the seed
+const uint8_t* long_secret(uint64_t seed, uint8_t* custom) {
+    if (seed == 0) {
+        return K_SECRET;
+    }
+    for (size_t i = 0; i < SECRET_SIZE / 16; ++i) {
+        write64(custom + 16 * i, read64(K_SECRET + 16 * i) + seed);
+        write64(custom + 16 * i + 8, read64(K_SECRET + 16 * i + 8) - seed);
+    }
+    return custom;
+}
+
+// ---- 128-bit, short and mid inputs ----
+
+Hash128 len_1to3_128(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    const uint32_t combinedl = (static_cast<uint32_t>(in[0]) << 16) |
+                               (static_cast<uint32_t>(in[len >> 1]) << 24) |
+                               static_cast<uint32_t>(in[len - 1]) |
+                               (static_cast<uint32_t>(len) << 8);
+    const uint32_t combinedh = rotl32(swap32(combinedl), 13);
+    const uint64_t bitflipl = (read32(secret) ^ read32(secret + 4)) + seed;
+    const uint64_t bitfliph = (read32(secret + 8) ^ read32(secret + 12)) - seed;
+    return Hash128{xxh64_avalanche(combinedl ^ bitflipl), xxh64_avalanche(combinedh ^ bitfliph)};
+}
+
+Hash128 len_4to8_128(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+    const uint32_t lo = read32(in);
+    const uint32_t hi = read32(in + len - 4);
+    const uint64_t in64 = lo + (static_cast<uint64_t>(hi) << 32);
+    const uint64_t bitflip = (read64(secret + 16) ^ read64(secret + 24)) + seed;
+    Hash128 m = mul64to128(in64 ^ bitflip, PRIME64_1 + (len << 2));
+    m.high += m.low << 1;
+    m.low ^= m.high >> 3;
+    m.low ^= m.low >> 35;
+    m.low *= PRIME_MX2;
+    m.low ^= m.low >> 28;
+    m.high = avalanche(m.high);
+    return m;
+}
+
+Hash128 len_9to16_128(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    const uint64_t bitflipl = (read64(secret + 32) ^ read64(secret + 40)) - seed;
+    const uint64_t bitfliph = (read64(secret + 48) ^ read64(secret + 56)) + seed;
+    const uint64_t lo = read64(in);
+    uint64_t hi = read64(in + len - 8);
+    Hash128 m = mul64to128(lo ^ hi ^ bitflipl, PRIME64_1);
+    m.low += static_cast<uint64_t>(len - 1) << 54;
+    hi ^= bitfliph;
+    m.high += hi + static_cast<uint64_t>(static_cast<uint32_t>(hi)) * (PRIME32_2 - 1);
+    m.low ^= swap64(m.high);
+    Hash128 h = mul64to128(m.low, PRIME64_2);
+    h.high += m.high * PRIME64_2;
+    h.low = avalanche(h.low);
+    h.high = avalanche(h.high);
+    return h;
+}
+
+Hash128 len_0to16_128(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    if (len > 8) return len_9to16_128(in, len, secret, seed);
+    if (len >= 4) return len_4to8_128(in, len, secret, seed);
+    if (len > 0) return len_1to3_128(in, len, secret, seed);
+    return Hash128{xxh64_avalanche(seed ^ read64(secret + 64) ^ read64(secret + 72)),
+                   xxh64_avalanche(seed ^ read64(secret + 80) ^ read64(secret + 88))};
+}
+
+inline void mix32(Hash128& acc, const uint8_t* in1, const uint8_t* in2, const uint8_t* secret,
+                  uint64_t seed) {
+    acc.low += mix16(in1, secret, seed);
+    acc.low ^= read64(in2) + read64(in2 + 8);
+    acc.high += mix16(in2, secret + 16, seed);
+    acc.high ^= read64(in1) + read64(in1 + 8);
+}
+
+Hash128 finish_mid_128(const Hash128& acc, size_t len, uint64_t seed) {
+    Hash128 h;
+    h.low = avalanche(acc.low + acc.high);
+    h.high = 0 - avalanche(acc.low * PRIME64_1 + acc.high * PRIME64_4 + (len - seed) * PRIME64_2);
+    return h;
+}
+
+Hash128 len_17to128_128(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    Hash128 acc{len * PRIME64_1, 0};
+    size_t i = (len - 1) / 32;
+    do {
+        mix32(acc, in + 16 * i, in + len - 16 * (i + 1), secret + 32 * i, seed);
+    } while (i-- != 0);
+    return finish_mid_128(acc, len, seed);
+}
+
+Hash128 len_129to240_128(const uint8_t* in, size_t len, const uint8_t* secret, uint64_t seed) {
+    Hash128 acc{len * PRIME64_1, 0};
+    for (size_t i = 32; i < 160; i += 32) {
+        mix32(acc, in + i - 32, in + i - 16, secret + i - 32, seed);
+    }
+    acc.low = avalanche(acc.low);
+    acc.high = avalanche(acc.high);
+    for (size_t i = 160; i <= len; i += 32) {
+        mix32(acc, in + i - 32, in + i - 16, secret + MIDSIZE_STARTOFFSET + i - 160, seed);
+    }
+    mix32(acc, in + len - 16, in + len - 32,
+          secret + SECRET_SIZE_MIN - MIDSIZE_LASTOFFSET - 16, 0 - seed);
+    return finish_mid_128(acc, len, seed);
+}
+
+// =============================================================================
+// Normalization
+// =============================================================================
+
+// Byte length of the Python-whitespace code point at p, 0 if not whitespace
+inline size_t whitespace_len(const uint8_t* p, const uint8_t* end) {
+    const uint8_t c = p[0];
+    if (c < 0x80) {
+        return ((c >= 0x09 && c <= 0x0D) || (c >= 0x1C && c <= 0x20)) ? 1 : 0;
+    }
+    const size_t avail = static_cast<size_t>(end - p);
+    if (c == 0xC2 && avail >= 2) {
+        return (p[1] == 0x85 || p[1] == 0xA0) ? 2 : 0;
+    }
+    if (avail < 3) {
+        return 0;
+    }
+    if (c == 0xE1) {
+        return (p[1] == 0x9A && p[2] == 0x80) ? 3 : 0;                    // U+1680
+    }
+    if (c == 0xE2) {
+        if (p[1] == 0x80) {
+            return (p[2] <= 0x8A || p[2] == 0xA8 || p[2] == 0xA9 || p[2] == 0xAF) ? 3 : 0;
+        }
+        return (p[1] == 0x81 && p[2] == 0x9F) ? 3 : 0;                    // U+205F
+    }
+    if (c == 0xE3) {
+        return (p[1] == 0x80 && p[2] == 0x80) ? 3 : 0;                    // U+3000
+    }
+    return 0;
+}
+
+inline size_t utf8_len(uint8_t lead) {
+    if (lead < 0x80) return 1;
+    if (lead < 0xE0) return 2;
+    if (lead < 0xF0) return 3;
+    return 4;
+}
+
+template<typename Hasher>
+void hash_batch(const std::vector<std::string>& texts, const NormalizeOptions& options,
+                Hasher hasher) {
+    runtime::parallel_for(runtime::default_pool(), texts.size(), 256,
+        [&](size_t begin, size_t end) {
+            std::string buffer;
+            for (size_t i = begin; i < end; ++i) {
+                if (options.identity()) {
+                    hasher(i, texts[i].data(), texts[i].size());
+                } else {
+                    normalize_into(texts[i], options, buffer);
+                    hasher(i, buffer.data(), buffer.size());
+                }
+            }
+        });
+}
+
+template<typename H>
+DuplicateGroups group_sorted(const std::vector<H>& hashes) {
+    std::vector<uint32_t> order(hashes.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(),
+        [&](uint32_t a, uint32_t b) { return hashes[a] < hashes[b]; });
+
+    // Runs of equal hashes, collected as (first index, run start, run length)
+    struct Run { uint32_t first; size_t start; size_t len; };
+    std::vector<Run> runs;
+    for (size_t i = 0; i < order.size();) {
+        size_t j = i + 1;
+        while (j < order.size() && hashes[order[j]] == hashes[order[i]]) {
+            ++j;
+        }
+        if (j - i > 1) {
+            runs.push_back(Run{order[i], i, j - i});
+        }
+        i = j;
+    }
+    std::sort(runs.begin(), runs.end(), [](const Run& a, const Run& b) { return a.first < b.first; });
+
+    DuplicateGroups groups;
+    groups.offsets.reserve(runs.size() + 1);
+    for (const auto& run : runs) {
+        groups.indices.insert(groups.indices.end(), order.begin() + run.start,
+                              order.begin() + run.start + run.len);
+        groups.offsets.push_back(static_cast<uint32_t>(groups.indices.size()));
+    }
+    return groups;
+}
+
+}  // anonymous namespace
+
+uint64_t xxh3_64(const void* data, size_t len, uint64_t seed) {
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+    if (len <= 16) return len_0to16_64(in, len, K_SECRET, seed);
+    if (len <= 128) return len_17to128_64(in, len, K_SECRET, seed);
+    if (len <= MIDSIZE_MAX) return len_129to240_64(in, len, K_SECRET, seed);
+
+    alignas(64) uint8_t custom[SECRET_SIZE];
+    const uint8_t* secret = long_secret(seed, custom);
+    alignas(64) uint64_t acc[ACC_NB];
+    init_acc(acc);
+    hash_long_accumulate(acc, in, len, secret);
+    return merge_accs(acc, secret + SECRET_MERGEACCS_START, len * PRIME64_1);
+}
+
+Hash128 xxh3_128(const void* data, size_t len, uint64_t seed) {
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+    if (len <= 16) return len_0to16_128(in, len, K_SECRET, seed);
+    if (len <= 128) return len_17to128_128(in, len, K_SECRET, seed);
+    if (len <= MIDSIZE_MAX) return len_129to240_128(in, len, K_SECRET, seed);
+
+    alignas(64) uint8_t custom[SECRET_SIZE];
+    const uint8_t* secret = long_secret(seed, custom);
+    alignas(64) uint64_t acc[ACC_NB];
+    init_acc(acc);
+    hash_long_accumulate(acc, in, len, secret);
+    Hash128 h;
+    h.low = merge_accs(acc, secret + SECRET_MERGEACCS_START, len * PRIME64_1);
+    h.high = merge_accs(acc, secret + SECRET_SIZE - STRIPE_LEN - SECRET_MERGEACCS_START,
+                        ~(len * PRIME64_2));
+    return h;
+}
+
+void normalize_into(std::string_view text, const NormalizeOptions& options, std::string& out) {
+    bool fold_ascii = options.casefold;
+    if (options.nfkc || options.casefold) {
+        if (!unicode::is_ascii(text)) {
+            // Unicode passes first; collapsing and truncation then run on
+            // their output
+            thread_local std::string folded;
+            unicode::nfkc_casefold_into(text, options.nfkc, options.casefold, folded);
+            text = folded;
+            fold_ascii = false;
+        } else if (options.casefold && !options.collapse_whitespace && !options.max_chars) {
+            out.resize(text.size());
+            unicode::ascii_lower(text.data(), text.size(), &out[0]);
+            return;
+        }
+    }
+
+    out.clear();
+    out.reserve(text.size());
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(text.data());
+    const uint8_t* end = p + text.size();
+    const size_t limit = options.max_chars ? options.max_chars : SIZE_MAX;
+    size_t chars = 0;
+    bool pending_space = false;
+
+    while (p < end && chars < limit) {
+        if (options.collapse_whitespace) {
+            const size_t ws = whitespace_len(p, end);
+            if (ws) {
+                pending_space = !out.empty();
+                p += ws;
+                continue;
+            }
+            if (pending_space) {
+                out.push_back(' ');
+                pending_space = false;
+                if (++chars == limit) {
+                    break;
+                }
+            }
+        }
+        const uint8_t c = *p;
+        if (c < 0x80) {
+            out.push_back(static_cast<char>(fold_ascii && c >= 'A' && c <= 'Z' ? c + 32 : c));
+            ++p;
+        } else {
+            const size_t n = std::min(utf8_len(c), static_cast<size_t>(end - p));
+            out.append(reinterpret_cast<const char*>(p), n);
+            p += n;
+        }
+        ++chars;
+    }
+}
+
+std::string normalize(std::string_view text, const NormalizeOptions& options) {
+    std::string out;
+    normalize_into(text, options, out);
+    return out;
+}
+
+std::vector<std::string> normalize_batch(const std::vector<std::string>& texts,
+                                         const NormalizeOptions& options) {
+    std::vector<std::string> out(texts.size());
+    runtime::parallel_for(runtime::default_pool(), texts.size(), 256,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                normalize_into(texts[i], options, out[i]);
+            }
+        });
+    return out;
+}
+
+std::vector<uint64_t> hash64_batch(const std::vector<std::string>& texts,
+                                   const NormalizeOptions& options, uint64_t seed) {
+    std::vector<uint64_t> out(texts.size());
+    hash_batch(texts, options, [&](size_t i, const char* data, size_t len) {
+        out[i] = xxh3_64(data, len, seed);
+    });
+    return out;
+}
+
+std::vector<Hash128> hash128_batch(const std::vector<std::string>& texts,
+                                   const NormalizeOptions& options, uint64_t seed) {
+    std::vector<Hash128> out(texts.size());
+    hash_batch(texts, options, [&](size_t i, const char* data, size_t len) {
+        out[i] = xxh3_128(data, len, seed);
+    });
+    return out;
+}
+
+DuplicateGroups group_duplicates(const std::vector<uint64_t>& hashes) {
+    return group_sorted(hashes);
+}
+
+DuplicateGroups group_duplicates(const std::vector<Hash128>& hashes) {
+    return group_sorted(hashes);
+}
+
+}  // namespace hashing
+}  // namespace axnmihn
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace axnmihn {
+namespace hashing {
+
+struct Hash128 {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const Hash128& o) const { return low == o.low && high == o.high; }
+    bool operator!=(const Hash128& o) const { return !(*this == o); }
+    bool operator<(const Hash128& o) const {
+        return high != o.high ? high < o.high : low < o.low;
+    }
+};
+
+/**
+ * XXH3 64-bit hash (bit-compatible with the reference xxHash 0.8).
+ *
+ * Args:
+ *     data: Input bytes
+ *     len: Input length
+ *     seed: Hash seed
+ */
+uint64_t xxh3_64(const void* data, size_t len, uint64_t seed = 0);
+
+/**
+ * XXH3 128-bit hash (bit-compatible with the reference xxHash 0.8).
+ */
+Hash128 xxh3_128(const void* data, size_t len, uint64_t seed = 0);
+
+/**
+ * Text normalization applied before hashing.
+ *
+ * Steps run in the order nfkc, casefold, collapse_whitespace, max_chars,
+ * matching Python's unicodedata.normalize("NFKC", ...), str.casefold()
+ * and " ".join(text.split()) (whitespace is every code point
+ * str.isspace() accepts). max_chars keeps the first N code points of the
+ * normalized text (0 = all). ASCII input skips the Unicode tables. Input
+ * must be valid UTF-8.
+ */
+struct NormalizeOptions {
+    bool collapse_whitespace = false;
+    bool casefold = false;
+    size_t max_chars = 0;
+    bool nfkc = false;
+
+    bool identity() const {
+        return !collapse_whitespace && !casefold && max_chars == 0 && !nfkc;
+    }
+};
+
+/**
+ * Normalize text into `out` (cleared first).
+ */
+void normalize_into(std::string_view text, const NormalizeOptions& options, std::string& out);
+
+std::string normalize(std::string_view text, const NormalizeOptions& options);
+
+/**
+ * normalize() for each text, in parallel for large batches.
+ */
+std::vector<std::string> normalize_batch(
+    const std::vector<std::string>& texts,
+    const NormalizeOptions& options
+);
+
+/**
+ * Normalize and hash a batch of texts, in parallel for large batches.
+ *
+ * Args:
+ *     texts: Input texts (UTF-8)
+ *     options: Normalization applied before hashing
+ *     seed: Hash seed
+ *
+ * Returns:
+ *     One hash per text
+ */
+std::vector<uint64_t> hash64_batch(
+    const std::vector<std::string>& texts,
+    const NormalizeOptions& options = NormalizeOptions(),
+    uint64_t seed = 0
+);
+
+std::vector<Hash128> hash128_batch(
+    const std::vector<std::string>& texts,
+    const NormalizeOptions& options = NormalizeOptions(),
+    uint64_t seed = 0
+);
+
+/**
+ * Groups of equal hashes in CSR form: group g is
+ * indices[offsets[g], offsets[g + 1]).
+ */
+struct DuplicateGroups {
+    std::vector<uint32_t> offsets{0};
+    std::vector<uint32_t> indices;
+
+    size_t size() const { return offsets.size() - 1; }
+};
+
+/**
+ * Group positions whose hashes are equal.
+ *
+ * Only groups with two or more members are returned. Indices within a
+ * group are ascending and groups are ordered by their first index, so
+ * the first member of each group is the earliest occurrence.
+ */
+DuplicateGroups group_duplicates(const std::vector<uint64_t>& hashes);
+DuplicateGroups group_duplicates(const std::vector<Hash128>& hashes);
+
+}  // namespace hashing
+}  // namespace axnmihn
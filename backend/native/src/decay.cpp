@@ -1,5 +1,8 @@
 #include "decay.hpp"
+#include "accuracy.hpp"
+#include "simd.hpp"
 #include <cmath>
+#include <cstddef>
 #include <algorithm>
 
 #ifdef HAS_AVX2
@@ -77,6 +80,22 @@ double calculate(const DecayInput& input, const DecayConfig& config) {
     return std::max(decayed, input.importance * config.min_retention);
 }
 
+double calculate_reference(const DecayInput& input, const DecayConfig& config) {
+    if (input.hours_passed < 0) {
+        return input.importance;
+    }
+    double stability = 1.0 + config.access_stability_k * std::log1p(static_cast<double>(input.access_count));
+    double resistance = std::min(1.0, input.connection_count * config.relation_resistance_k);
+    double type_multiplier = config.type_multipliers[std::clamp(input.memory_type, 0, 3)];
+    double channel_boost = 1.0 / (1.0 + config.channel_diversity_k * input.channel_mentions);
+    double effective_rate = config.base_decay_rate * type_multiplier * channel_boost / stability * (1.0 - resistance);
+    double decayed = input.importance * std::exp(-effective_rate * input.hours_passed);
+    if (input.last_access_hours >= 0 && input.hours_passed > 168.0 && input.last_access_hours < 24.0) {
+        decayed *= 1.3;
+    }
+    return std::max(decayed, input.importance * config.min_retention);
+}
+
 std::vector<double> calculate_batch(
     const std::vector<DecayInput>& inputs,
     const DecayConfig& config
@@ -96,7 +115,9 @@ std::vector<double> calculate_batch(
     return results;
 }
 
-void calculate_batch_arrays(
+namespace {
+
+void calculate_arrays_fast(
     size_t n,
     const double* importance,
     const double* hours_passed,
@@ -109,106 +130,128 @@ void calculate_batch_arrays(
     double* output
 ) {
 #ifdef HAS_AVX2
-    // AVX2 SIMD implementation for x86_64
-    // Process 4 doubles at a time
-
-    const __m256d one = _mm256_set1_pd(1.0);
-    const __m256d access_k = _mm256_set1_pd(config.access_stability_k);
-    const __m256d relation_k = _mm256_set1_pd(config.relation_resistance_k);
-    const __m256d base_rate = _mm256_set1_pd(config.base_decay_rate);
-    const __m256d min_ret = _mm256_set1_pd(config.min_retention);
-    const __m256d recency_boost = _mm256_set1_pd(1.3);
-    const __m256d hours_168 = _mm256_set1_pd(168.0);
-    const __m256d hours_24 = _mm256_set1_pd(24.0);
-    const __m256d neg_one = _mm256_set1_pd(-1.0);
-
-    size_t i = 0;
-    for (; i + 4 <= n; i += 4) {
-        // Load importance and hours_passed
-        __m256d imp = _mm256_loadu_pd(&importance[i]);
-        __m256d hours = _mm256_loadu_pd(&hours_passed[i]);
-
-        // Load and convert integer arrays
-        __m128i ac_i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&access_count[i]));
-        __m128i cc_i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&connection_count[i]));
-        __m128i mt_i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&memory_type[i]));
-
-        __m256d ac = _mm256_cvtepi32_pd(ac_i);
-        __m256d cc = _mm256_cvtepi32_pd(cc_i);
-
-        // Load last_access_hours
-        __m256d lah = _mm256_loadu_pd(&last_access_hours[i]);
-
-        // Calculate stability = 1 + K * log(1 + access_count)
-        // Note: Using scalar log for accuracy (SIMD log is complex)
-        double stab[4];
-        for (int k = 0; k < 4; ++k) {
-            stab[k] = 1.0 + config.access_stability_k * fast_log1p(static_cast<double>(access_count[i + k]));
-        }
-        __m256d stability = _mm256_loadu_pd(stab);
+    if (simd::use_avx2()) {
+        // AVX2 SIMD implementation for x86_64
+        // Process 4 doubles at a time
+
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d access_k = _mm256_set1_pd(config.access_stability_k);
+        const __m256d relation_k = _mm256_set1_pd(config.relation_resistance_k);
+        const __m256d base_rate = _mm256_set1_pd(config.base_decay_rate);
+        const __m256d min_ret = _mm256_set1_pd(config.min_retention);
+        const __m256d recency_boost = _mm256_set1_pd(1.3);
+        const __m256d hours_168 = _mm256_set1_pd(168.0);
+        const __m256d hours_24 = _mm256_set1_pd(24.0);
+        const __m256d neg_one = _mm256_set1_pd(-1.0);
+
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            // Load importance and hours_passed
+            __m256d imp = _mm256_loadu_pd(&importance[i]);
+            __m256d hours = _mm256_loadu_pd(&hours_passed[i]);
+
+            // Load and convert integer arrays
+            __m128i ac_i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&access_count[i]));
+            __m128i cc_i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&connection_count[i]));
+            __m128i mt_i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&memory_type[i]));
+
+            __m256d ac = _mm256_cvtepi32_pd(ac_i);
+            __m256d cc = _mm256_cvtepi32_pd(cc_i);
+
+            // Load last_access_hours
+            __m256d lah = _mm256_loadu_pd(&last_access_hours[i]);
+
+            // Calculate stability = 1 + K * log(1 + access_count)
+            // Note: Using scalar log for accuracy (SIMD log is complex)
+            double stab[4];
+            for (int k = 0; k < 4; ++k) {
+                stab[k] = 1.0 + config.access_stability_k * fast_log1p(static_cast<double>(access_count[i + k]));
+            }
+            __m256d stability = _mm256_loadu_pd(stab);
 
-        // Calculate resistance = min(1.0, connection_count * K)
-        __m256d resistance = _mm256_mul_pd(cc, relation_k);
-        resistance = _mm256_min_pd(resistance, one);
+            // Calculate resistance = min(1.0, connection_count * K)
+            __m256d resistance = _mm256_mul_pd(cc, relation_k);
+            resistance = _mm256_min_pd(resistance, one);
 
-        // Get type multipliers (scalar for simplicity)
-        double type_mult[4];
-        for (int k = 0; k < 4; ++k) {
-            int idx = std::clamp(memory_type[i + k], 0, 3);
-            type_mult[k] = config.type_multipliers[idx];
-        }
-        __m256d tm = _mm256_loadu_pd(type_mult);
+            // Get type multipliers (scalar for simplicity)
+            double type_mult[4];
+            for (int k = 0; k < 4; ++k) {
+                int idx = std::clamp(memory_type[i + k], 0, 3);
+                type_mult[k] = config.type_multipliers[idx];
+            }
+            __m256d tm = _mm256_loadu_pd(type_mult);
 
-        // T-02: Channel diversity boost (scalar for simplicity)
-        double ch_boost[4];
-        for (int k = 0; k < 4; ++k) {
-            ch_boost[k] = 1.0 / (1.0 + config.channel_diversity_k * channel_mentions[i + k]);
-        }
-        __m256d cb = _mm256_loadu_pd(ch_boost);
-
-        // effective_rate = base_rate * type_mult * channel_boost / stability * (1 - resistance)
-        __m256d eff_rate = _mm256_mul_pd(base_rate, tm);
-        eff_rate = _mm256_mul_pd(eff_rate, cb);
-        eff_rate = _mm256_div_pd(eff_rate, stability);
-        eff_rate = _mm256_mul_pd(eff_rate, _mm256_sub_pd(one, resistance));
-
-        // Calculate exp(-effective_rate * hours_passed) using scalar for accuracy
-        double decay_factor[4];
-        double eff_rate_arr[4], hours_arr[4];
-        _mm256_storeu_pd(eff_rate_arr, eff_rate);
-        _mm256_storeu_pd(hours_arr, hours);
-        for (int k = 0; k < 4; ++k) {
-            decay_factor[k] = fast_exp_neg(eff_rate_arr[k] * hours_arr[k]);
-        }
-        __m256d decay = _mm256_loadu_pd(decay_factor);
+            // T-02: Channel diversity boost (scalar for simplicity)
+            double ch_boost[4];
+            for (int k = 0; k < 4; ++k) {
+                ch_boost[k] = 1.0 / (1.0 + config.channel_diversity_k * channel_mentions[i + k]);
+            }
+            __m256d cb = _mm256_loadu_pd(ch_boost);
+
+            // effective_rate = base_rate * type_mult * channel_boost / stability * (1 - resistance)
+            __m256d eff_rate = _mm256_mul_pd(base_rate, tm);
+            eff_rate = _mm256_mul_pd(eff_rate, cb);
+            eff_rate = _mm256_div_pd(eff_rate, stability);
+            eff_rate = _mm256_mul_pd(eff_rate, _mm256_sub_pd(one, resistance));
+
+            // Calculate exp(-effective_rate * hours_passed) using scalar for accuracy
+            double decay_factor[4];
+            double eff_rate_arr[4], hours_arr[4];
+            _mm256_storeu_pd(eff_rate_arr, eff_rate);
+            _mm256_storeu_pd(hours_arr, hours);
+            for (int k = 0; k < 4; ++k) {
+                decay_factor[k] = fast_exp_neg(eff_rate_arr[k] * hours_arr[k]);
+            }
+            __m256d decay = _mm256_loadu_pd(decay_factor);
+
+            // decayed = importance * decay_factor
+            __m256d decayed = _mm256_mul_pd(imp, decay);
+
+            // Recency paradox check (scalar for complexity)
+            double decayed_arr[4];
+            _mm256_storeu_pd(decayed_arr, decayed);
+            double lah_arr[4], hours_arr2[4];
+            _mm256_storeu_pd(lah_arr, lah);
+            _mm256_storeu_pd(hours_arr2, hours);
+
+            for (int k = 0; k < 4; ++k) {
+                if (lah_arr[k] >= 0 && hours_arr2[k] > 168.0 && lah_arr[k] < 24.0) {
+                    decayed_arr[k] *= 1.3;
+                }
+            }
+            decayed = _mm256_loadu_pd(decayed_arr);
 
-        // decayed = importance * decay_factor
-        __m256d decayed = _mm256_mul_pd(imp, decay);
+            // Apply minimum retention
+            __m256d min_val = _mm256_mul_pd(imp, min_ret);
+            decayed = _mm256_max_pd(decayed, min_val);
 
-        // Recency paradox check (scalar for complexity)
-        double decayed_arr[4];
-        _mm256_storeu_pd(decayed_arr, decayed);
-        double lah_arr[4], hours_arr2[4];
-        _mm256_storeu_pd(lah_arr, lah);
-        _mm256_storeu_pd(hours_arr2, hours);
+            // Negative age (clock skew) keeps the original importance, as in calculate()
+            __m256d future = _mm256_cmp_pd(hours, _mm256_setzero_pd(), _CMP_LT_OQ);
+            decayed = _mm256_blendv_pd(decayed, imp, future);
 
-        for (int k = 0; k < 4; ++k) {
-            if (lah_arr[k] >= 0 && hours_arr2[k] > 168.0 && lah_arr[k] < 24.0) {
-                decayed_arr[k] *= 1.3;
-            }
+            // Store results
+            _mm256_storeu_pd(&output[i], decayed);
         }
-        decayed = _mm256_loadu_pd(decayed_arr);
 
-        // Apply minimum retention
-        __m256d min_val = _mm256_mul_pd(imp, min_ret);
-        decayed = _mm256_max_pd(decayed, min_val);
+        // Handle remaining elements
+        for (; i < n; ++i) {
+            DecayInput input{
+                importance[i],
+                hours_passed[i],
+                access_count[i],
+                connection_count[i],
+                last_access_hours[i],
+                memory_type[i],
+                channel_mentions[i]
+            };
+            output[i] = calculate(input, config);
+        }
 
-        // Store results
-        _mm256_storeu_pd(&output[i], decayed);
+        return;
     }
-
-    // Handle remaining elements
-    for (; i < n; ++i) {
+#endif
+    // Scalar fallback (also used on ARM, or when the scalar variant is forced)
+    for (size_t i = 0; i < n; ++i) {
         DecayInput input{
             importance[i],
             hours_passed[i],
@@ -220,21 +263,122 @@ void calculate_batch_arrays(
         };
         output[i] = calculate(input, config);
     }
+}
 
-#else
-    // Scalar fallback (also used on ARM, optimized with NEON later if needed)
-    for (size_t i = 0; i < n; ++i) {
+// Re-check a spread of sampled outputs against calculate_reference
+void sample_accuracy(
+    size_t n,
+    const double* importance,
+    const double* hours_passed,
+    const int* access_count,
+    const int* connection_count,
+    const double* last_access_hours,
+    const int* memory_type,
+    const int* channel_mentions,
+    const DecayConfig& config,
+    const double* output
+) {
+    const size_t samples = std::min(n, accuracy::SAMPLE_ELEMENTS);
+    double approx[accuracy::SAMPLE_ELEMENTS];
+    double exact[accuracy::SAMPLE_ELEMENTS];
+    for (size_t s = 0; s < samples; ++s) {
+        const size_t i = s * n / samples;
         DecayInput input{
             importance[i],
             hours_passed[i],
             access_count[i],
             connection_count[i],
             last_access_hours[i],
-            memory_type[i]
+            memory_type[i],
+            channel_mentions[i]
         };
-        output[i] = calculate(input, config);
+        approx[s] = output[i];
+        exact[s] = calculate_reference(input, config);
+    }
+    accuracy::record_error("decay.batch", accuracy::compare_values(approx, exact, samples));
+}
+
+}  // anonymous namespace
+
+void calculate_batch_arrays(
+    size_t n,
+    const double* importance,
+    const double* hours_passed,
+    const int* access_count,
+    const int* connection_count,
+    const double* last_access_hours,
+    const int* memory_type,
+    const int* channel_mentions,
+    const DecayConfig& config,
+    double* output
+) {
+    calculate_arrays_fast(n, importance, hours_passed, access_count, connection_count,
+                          last_access_hours, memory_type, channel_mentions, config, output);
+    if (n > 0 && accuracy::should_sample()) {
+        sample_accuracy(n, importance, hours_passed, access_count, connection_count,
+                        last_access_hours, memory_type, channel_mentions, config, output);
+    }
+}
+
+DecayColumns record_columns(const DecayRecord* records, std::ptrdiff_t stride) {
+    const char* base = reinterpret_cast<const char*>(records);
+    return DecayColumns{
+        StridedView<double>(base + offsetof(DecayRecord, importance), stride),
+        StridedView<double>(base + offsetof(DecayRecord, hours_passed), stride),
+        StridedView<int>(base + offsetof(DecayRecord, access_count), stride),
+        StridedView<int>(base + offsetof(DecayRecord, connection_count), stride),
+        StridedView<double>(base + offsetof(DecayRecord, last_access_hours), stride),
+        StridedView<int>(base + offsetof(DecayRecord, memory_type), stride),
+        StridedView<int>(base + offsetof(DecayRecord, channel_mentions), stride),
+    };
+}
+
+void calculate_batch_strided(
+    size_t n,
+    const DecayColumns& columns,
+    const DecayConfig& config,
+    MutableStridedView<double> output
+) {
+    if (columns.contiguous() && output.contiguous()) {
+        calculate_batch_arrays(
+            n,
+            columns.importance.ptr(),
+            columns.hours_passed.ptr(),
+            columns.access_count.ptr(),
+            columns.connection_count.ptr(),
+            columns.last_access_hours.ptr(),
+            columns.memory_type.ptr(),
+            columns.channel_mentions.ptr(),
+            config,
+            output.ptr()
+        );
+        return;
+    }
+
+    // Gather a block into contiguous scratch, run the array kernel, scatter
+    constexpr size_t block = 256;
+    double imp[block], hrs[block], last[block], out[block];
+    int acc[block], conn[block], mtype[block], chmnt[block];
+
+    for (size_t start = 0; start < n; start += block) {
+        size_t len = std::min(block, n - start);
+        for (size_t k = 0; k < len; ++k) {
+            size_t i = start + k;
+            imp[k] = columns.importance[i];
+            hrs[k] = columns.hours_passed[i];
+            acc[k] = columns.access_count[i];
+            conn[k] = columns.connection_count[i];
+            last[k] = columns.last_access_hours[i];
+            mtype[k] = columns.memory_type[i];
+            chmnt[k] = columns.channel_mentions[i];
+        }
+
+        calculate_batch_arrays(len, imp, hrs, acc, conn, last, mtype, chmnt, config, out);
+
+        for (size_t k = 0; k < len; ++k) {
+            output[start + k] = out[k];
+        }
     }
-#endif
 }
 
 }  // namespace decay
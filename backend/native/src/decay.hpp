@@ -1,8 +1,11 @@
 #pragma once
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
+#include "strided.hpp"
+
 namespace axnmihn {
 namespace decay {
 
@@ -45,6 +48,19 @@ struct DecayConfig {
  */
 double calculate(const DecayInput& input, const DecayConfig& config);
 
+/**
+ * Exact reference for calculate(): libm exp/log1p throughout, no fast
+ * paths. Used by the accuracy harness and runtime sampling only.
+ *
+ * Args:
+ *     input: Decay calculation parameters
+ *     config: Decay configuration
+ *
+ * Returns:
+ *     Decayed importance score
+ */
+double calculate_reference(const DecayInput& input, const DecayConfig& config);
+
 /**
  * Calculate decayed importance for a batch of memories.
  * Uses SIMD optimizations when available.
@@ -75,6 +91,10 @@ std::vector<double> calculate_batch(
  *     memory_type: Array of memory types (0-3)
  *     config: Decay configuration
  *     output: Output array for decayed importance scores
+ *
+ * When accuracy sampling is enabled, a sampled call also re-checks up to
+ * accuracy::SAMPLE_ELEMENTS outputs against calculate_reference and
+ * records the error under "decay.batch".
  */
 void calculate_batch_arrays(
     size_t n,
@@ -89,5 +109,80 @@ void calculate_batch_arrays(
     double* output
 );
 
+/**
+ * Strided views over the seven decay input columns.
+ *
+ * Each column may come from a separate array, a slice, or a field of a
+ * structured array; only the element type is fixed.
+ */
+struct DecayColumns {
+    StridedView<double> importance;
+    StridedView<double> hours_passed;
+    StridedView<int> access_count;
+    StridedView<int> connection_count;
+    StridedView<double> last_access_hours;
+    StridedView<int> memory_type;
+    StridedView<int> channel_mentions;
+
+    bool contiguous() const {
+        return importance.contiguous() && hours_passed.contiguous() &&
+               access_count.contiguous() && connection_count.contiguous() &&
+               last_access_hours.contiguous() && memory_type.contiguous() &&
+               channel_mentions.contiguous();
+    }
+};
+
+/**
+ * Packed per-memory decay record (C layout, 40 bytes, native byte order).
+ *
+ * Python builds one NumPy structured array with this layout
+ * (decay_ops.RECORD_DTYPE) instead of seven separate column arrays:
+ *
+ *     offset  0  float64  importance
+ *     offset  8  float64  hours_passed
+ *     offset 16  float64  last_access_hours
+ *     offset 24  int32    access_count
+ *     offset 28  int32    connection_count
+ *     offset 32  int32    memory_type
+ *     offset 36  int32    channel_mentions
+ */
+struct DecayRecord {
+    double importance;
+    double hours_passed;
+    double last_access_hours;
+    int32_t access_count;
+    int32_t connection_count;
+    int32_t memory_type;
+    int32_t channel_mentions;
+};
+
+static_assert(sizeof(DecayRecord) == 40, "DecayRecord layout is part of the Python API");
+
+/**
+ * Column views over an array of records with the given byte stride
+ * (sizeof(DecayRecord) for a packed buffer, larger for slices).
+ */
+DecayColumns record_columns(const DecayRecord* records, std::ptrdiff_t stride);
+
+/**
+ * Calculate decayed importance for strided input columns.
+ *
+ * Contiguous inputs go straight to calculate_batch_arrays. Otherwise the
+ * columns are gathered block-by-block into stack buffers so the SIMD path
+ * still applies, with no heap allocation.
+ *
+ * Args:
+ *     n: Number of elements
+ *     columns: Input column views
+ *     config: Decay configuration
+ *     output: Output view (may be strided)
+ */
+void calculate_batch_strided(
+    size_t n,
+    const DecayColumns& columns,
+    const DecayConfig& config,
+    MutableStridedView<double> output
+);
+
 }  // namespace decay
 }  // namespace axnmihn
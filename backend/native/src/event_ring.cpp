@@ -0,0 +1,274 @@
+#include "event_ring.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace axnmihn {
+namespace events {
+
+namespace {
+
+// Packed header word: type (16) | event_id length (8) | flags (8) | metadata length (32)
+constexpr uint64_t FLAG_META_LOST = 1;
+
+uint64_t pack_header(uint32_t type, size_t id_len, uint64_t flags, size_t meta_len) {
+    return (static_cast<uint64_t>(type) & 0xFFFF) |
+           (static_cast<uint64_t>(id_len) << 16) |
+           (flags << 24) |
+           (static_cast<uint64_t>(meta_len) << 32);
+}
+
+uint64_t double_bits(double v) {
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+double bits_double(uint64_t bits) {
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// Byte string <-> relaxed atomic words; the tail word is zero padded
+void store_words(std::atomic<uint64_t>* words, const char* data, size_t len) {
+    const size_t full = len / 8;
+    for (size_t w = 0; w < full; ++w) {
+        uint64_t word;
+        std::memcpy(&word, data + w * 8, 8);
+        words[w].store(word, std::memory_order_relaxed);
+    }
+    if (len % 8) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + full * 8, len % 8);
+        words[full].store(word, std::memory_order_relaxed);
+    }
+}
+
+void load_words(const std::atomic<uint64_t>* words, char* out, size_t len) {
+    const size_t full = len / 8;
+    for (size_t w = 0; w < full; ++w) {
+        const uint64_t word = words[w].load(std::memory_order_relaxed);
+        std::memcpy(out + w * 8, &word, 8);
+    }
+    if (len % 8) {
+        const uint64_t word = words[full].load(std::memory_order_relaxed);
+        std::memcpy(out + full * 8, &word, len % 8);
+    }
+}
+
+}  // anonymous namespace
+
+// Every field is a relaxed atomic word so a reader racing the writer sees
+// stale or mixed words (rejected by the version check), never a data race.
+struct alignas(64) EventRing::Slot {
+    static constexpr size_t ID_WORDS = 3;
+
+    std::atomic<uint64_t> version{0};  // 2*seq+1 while writing, 2*seq+2 when done
+    std::atomic<uint64_t> header{0};
+    std::atomic<uint64_t> timestamp{0};
+    std::atomic<uint64_t> id[ID_WORDS];
+
+    static_assert(MAX_EVENT_ID <= ID_WORDS * 8, "event_id must fit the slot");
+};
+
+EventRing::EventRing(size_t capacity, size_t num_types, size_t metadata_bytes)
+    : capacity_(capacity),
+      num_types_(num_types),
+      arena_words_((metadata_bytes + 7) / 8) {
+    if (capacity == 0) {
+        throw std::invalid_argument("capacity must be > 0");
+    }
+    if (num_types == 0 || num_types > MAX_TYPES) {
+        throw std::invalid_argument("num_types must be in 1.." + std::to_string(MAX_TYPES));
+    }
+    slots_.reset(new Slot[capacity_]);
+    for (size_t i = 0; i < capacity_; ++i) {
+        for (auto& word : slots_[i].id) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+    arena_.reset(new std::atomic<uint64_t>[capacity_ * arena_words_]);
+    type_index_.reset(new std::atomic<uint64_t>[num_types_ * capacity_]);
+    for (size_t i = 0; i < num_types_ * capacity_; ++i) {
+        type_index_[i].store(0, std::memory_order_relaxed);
+    }
+    type_heads_.reset(new std::atomic<uint64_t>[num_types_]);
+    for (size_t t = 0; t < num_types_; ++t) {
+        type_heads_[t].store(0, std::memory_order_relaxed);
+    }
+}
+
+EventRing::~EventRing() = default;
+
+uint64_t EventRing::push(uint32_t type, std::string_view event_id, double timestamp,
+                         std::string_view metadata) {
+    if (type >= num_types_) {
+        throw std::out_of_range("event type " + std::to_string(type) + " out of range");
+    }
+    const size_t id_len = std::min(event_id.size(), MAX_EVENT_ID);
+    uint64_t flags = 0;
+    size_t meta_len = metadata.size();
+    if (meta_len > arena_words_ * 8) {
+        oversize_.fetch_add(1, std::memory_order_relaxed);
+        flags |= FLAG_META_LOST;
+        meta_len = 0;
+    }
+
+    const uint64_t seq = head_.fetch_add(1, std::memory_order_relaxed);
+    const size_t index = static_cast<size_t>(seq % capacity_);
+    Slot& slot = slots_[index];
+    slot.version.store(2 * seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.header.store(pack_header(type, id_len, flags, meta_len), std::memory_order_relaxed);
+    slot.timestamp.store(double_bits(timestamp), std::memory_order_relaxed);
+    char id_bytes[Slot::ID_WORDS * 8] = {};
+    std::memcpy(id_bytes, event_id.data(), id_len);
+    store_words(slot.id, id_bytes, sizeof(id_bytes));
+    store_words(arena_.get() + index * arena_words_, metadata.data(), meta_len);
+
+    slot.version.store(2 * seq + 2, std::memory_order_release);
+
+    const uint64_t pos = type_heads_[type].fetch_add(1, std::memory_order_relaxed);
+    type_index_[type * capacity_ + pos % capacity_].store(seq + 1, std::memory_order_release);
+    return seq;
+}
+
+uint64_t EventRing::first_visible(uint64_t head) const {
+    const uint64_t window_start = head > capacity_ ? head - capacity_ : 0;
+    return std::max(window_start, floor_.load(std::memory_order_acquire));
+}
+
+bool EventRing::read_slot(uint64_t seq, Event& out) const {
+    const size_t index = static_cast<size_t>(seq % capacity_);
+    const Slot& slot = slots_[index];
+    const uint64_t v1 = slot.version.load(std::memory_order_acquire);
+    if (v1 != 2 * seq + 2) {
+        return false;
+    }
+    const uint64_t header = slot.header.load(std::memory_order_relaxed);
+    const uint64_t ts = slot.timestamp.load(std::memory_order_relaxed);
+    char id_bytes[Slot::ID_WORDS * 8];
+    load_words(slot.id, id_bytes, sizeof(id_bytes));
+    const size_t id_len = std::min<size_t>((header >> 16) & 0xFF, MAX_EVENT_ID);
+    const size_t meta_len = std::min<size_t>(header >> 32, arena_words_ * 8);
+    out.metadata.resize(meta_len);
+    load_words(arena_.get() + index * arena_words_, &out.metadata[0], meta_len);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.version.load(std::memory_order_relaxed) != v1) {
+        return false;
+    }
+    out.seq = seq;
+    out.type = static_cast<uint32_t>(header & 0xFFFF);
+    out.timestamp = bits_double(ts);
+    out.event_id.assign(id_bytes, id_len);
+    out.metadata_lost = ((header >> 24) & FLAG_META_LOST) != 0;
+    return true;
+}
+
+std::vector<Event> EventRing::recent(size_t n) const {
+    const uint64_t h = head();
+    const uint64_t first = first_visible(h);
+    const uint64_t start = h - std::min<uint64_t>(n, h - std::min(first, h));
+
+    std::vector<Event> out;
+    out.reserve(static_cast<size_t>(h - start));
+    Event ev;
+    for (uint64_t seq = start; seq < h; ++seq) {
+        if (read_slot(seq, ev)) {
+            out.push_back(std::move(ev));
+        }
+    }
+    return out;
+}
+
+std::vector<Event> EventRing::by_type(uint32_t type, size_t limit) const {
+    std::vector<Event> out;
+    if (type >= num_types_ || limit == 0) {
+        return out;
+    }
+    const uint64_t first = first_visible(head());
+    const uint64_t th = type_heads_[type].load(std::memory_order_acquire);
+    const std::atomic<uint64_t>* index = type_index_.get() + type * capacity_;
+
+    uint64_t last = UINT64_MAX;
+    Event ev;
+    for (uint64_t pos = th; pos-- > 0 && th - pos <= capacity_ && out.size() < limit;) {
+        const uint64_t entry = index[pos % capacity_].load(std::memory_order_acquire);
+        if (entry == 0) {
+            continue;  // claimed but not yet written
+        }
+        const uint64_t seq = entry - 1;
+        if (seq >= last) {
+            continue;  // entry was overwritten by a newer push after we started
+        }
+        if (seq < first) {
+            break;  // everything older is out of the window too
+        }
+        last = seq;
+        if (read_slot(seq, ev)) {
+            out.push_back(std::move(ev));
+        }
+    }
+    return out;
+}
+
+DrainResult EventRing::drain(uint64_t cursor, size_t max_events) const {
+    DrainResult result;
+    const uint64_t h = head();
+    const uint64_t first = first_visible(h);
+    const uint64_t overwritten_end = h > capacity_ ? h - capacity_ : 0;
+    const uint64_t floor = floor_.load(std::memory_order_acquire);
+    const uint64_t from = std::max(cursor, floor);
+    if (overwritten_end > from) {
+        result.missed = overwritten_end - from;
+    }
+
+    uint64_t seq = std::max(cursor, first);
+    Event ev;
+    while (seq < h && result.events.size() < max_events) {
+        if (read_slot(seq, ev)) {
+            result.events.push_back(std::move(ev));
+        } else {
+            const uint64_t v = slots_[seq % capacity_].version.load(std::memory_order_acquire);
+            if (v < 2 * seq + 2) {
+                break;  // still being written; resume here next time
+            }
+            ++result.missed;  // lapped while we were reading
+        }
+        ++seq;
+    }
+    result.next_cursor = seq;
+    return result;
+}
+
+void EventRing::clear() {
+    const uint64_t h = head();
+    const uint64_t floor = floor_.load(std::memory_order_acquire);
+    if (h - floor > capacity_) {
+        dropped_before_clear_.fetch_add(h - floor - capacity_, std::memory_order_relaxed);
+    }
+    floor_.store(h, std::memory_order_release);
+}
+
+RingStats EventRing::stats() const {
+    const uint64_t h = head();
+    const uint64_t floor = std::min(floor_.load(std::memory_order_acquire), h);
+    const uint64_t window = h - floor;
+
+    RingStats s;
+    s.pushed = h;
+    s.size = std::min<uint64_t>(window, capacity_);
+    s.dropped = dropped_before_clear_.load(std::memory_order_relaxed) +
+                (window > capacity_ ? window - capacity_ : 0);
+    s.capacity = capacity_;
+    s.metadata_bytes = arena_words_ * 8;
+    s.metadata_oversize = oversize_.load(std::memory_order_relaxed);
+    return s;
+}
+
+}  // namespace events
+}  // namespace axnmihn
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace axnmihn {
+namespace events {
+
+/**
+ * One event as read back from the ring.
+ */
+struct Event {
+    uint64_t seq = 0;          // Global push order (0-based)
+    uint32_t type = 0;         // Caller-defined type index (< num_types)
+    double timestamp = 0.0;    // Epoch seconds
+    std::string event_id;
+    std::string metadata;      // Opaque bytes; empty if metadata_lost
+    bool metadata_lost = false;  // Metadata was larger than the slot's arena space
+};
+
+/**
+ * Result of drain(): events after a cursor plus where to resume.
+ */
+struct DrainResult {
+    std::vector<Event> events;
+    uint64_t next_cursor = 0;  // Pass to the next drain()
+    uint64_t missed = 0;       // Events overwritten before they were drained
+};
+
+struct RingStats {
+    uint64_t pushed = 0;
+    uint64_t dropped = 0;          // Overwritten while still in the window
+    uint64_t size = 0;             // Events currently readable
+    uint64_t capacity = 0;
+    uint64_t metadata_bytes = 0;     // Side arena bytes per slot
+    uint64_t metadata_oversize = 0;  // Pushes whose metadata did not fit
+};
+
+/**
+ * Bounded multi-producer event ring for the M0 memory stream.
+ *
+ * Records are fixed-size slots; metadata bytes go to a side arena that
+ * gives every slot a fixed region, so the slot keeps only a length and
+ * no string is allocated on push. A push claims the next sequence
+ * number with one fetch_add and overwrites the oldest slot, so
+ * producers never wait on each other or on readers.
+ *
+ * Each slot (and its arena region) is guarded by a seqlock version.
+ * Readers copy a slot and keep it only if the version is unchanged and
+ * belongs to the sequence they asked for, so a reader racing a producer
+ * drops (never tears) the events being overwritten. Correctness assumes
+ * fewer than `capacity` concurrent pushes, which any sane capacity
+ * guarantees.
+ *
+ * A per-type index of sequence numbers makes by_type() proportional to
+ * the events returned rather than the ring size.
+ */
+class EventRing {
+public:
+    static constexpr size_t MAX_TYPES = 64;
+    static constexpr size_t MAX_EVENT_ID = 23;
+
+    /**
+     * Create a ring.
+     *
+     * Args:
+     *     capacity: Events kept (oldest overwritten first); must be > 0
+     *     num_types: Distinct type indices accepted by push()
+     *     metadata_bytes: Side arena bytes per slot (rounded up to 8)
+     */
+    explicit EventRing(size_t capacity, size_t num_types = 16, size_t metadata_bytes = 256);
+    ~EventRing();
+    EventRing(const EventRing&) = delete;
+    EventRing& operator=(const EventRing&) = delete;
+
+    /**
+     * Append one event in O(1). event_id is truncated to MAX_EVENT_ID bytes;
+     * metadata larger than metadata_bytes is not stored (metadata_lost).
+     *
+     * Args:
+     *     type: Type index (< num_types)
+     *     event_id: Short identifier
+     *     timestamp: Epoch seconds
+     *     metadata: Opaque payload (e.g. JSON)
+     *
+     * Returns:
+     *     Sequence number of the event
+     */
+    uint64_t push(uint32_t type, std::string_view event_id, double timestamp,
+                  std::string_view metadata);
+
+    /** Last n events, oldest first. */
+    std::vector<Event> recent(size_t n) const;
+
+    /** Up to `limit` events of one type, most recent first. */
+    std::vector<Event> by_type(uint32_t type, size_t limit) const;
+
+    /**
+     * Events with seq >= cursor, oldest first, stopping at max_events or at
+     * the first slot still being written. Start with cursor 0 (or
+     * head() to skip history).
+     */
+    DrainResult drain(uint64_t cursor, size_t max_events) const;
+
+    /** Hide every event pushed so far; counters are kept. */
+    void clear();
+
+    /** Sequence number the next push will get. */
+    uint64_t head() const { return head_.load(std::memory_order_acquire); }
+
+    size_t capacity() const { return capacity_; }
+    size_t num_types() const { return num_types_; }
+    size_t metadata_bytes() const { return arena_words_ * 8; }
+
+    RingStats stats() const;
+
+private:
+    struct Slot;
+
+    bool read_slot(uint64_t seq, Event& out) const;
+    uint64_t first_visible(uint64_t head) const;
+
+    size_t capacity_;
+    size_t num_types_;
+    size_t arena_words_;   // Per slot
+
+    std::unique_ptr<Slot[]> slots_;
+    // Word-sized relaxed atomics, like the slot fields, so racing reads are defined
+    std::unique_ptr<std::atomic<uint64_t>[]> arena_;
+    // Per type: ring of (seq + 1), 0 = empty
+    std::unique_ptr<std::atomic<uint64_t>[]> type_index_;
+    std::unique_ptr<std::atomic<uint64_t>[]> type_heads_;
+
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) std::atomic<uint64_t> floor_{0};      // clear() watermark
+    std::atomic<uint64_t> dropped_before_clear_{0};
+    std::atomic<uint64_t> oversize_{0};
+};
+
+}  // namespace events
+}  // namespace axnmihn
@@ -1,88 +1,201 @@
 #include "graph_ops.hpp"
-#include <queue>
+#include "arena.hpp"
+
+#include <stdexcept>
 
 namespace axnmihn {
 namespace graph_ops {
 
-std::unordered_set<size_t> bfs_neighbors(
-    const std::unordered_map<size_t, std::vector<size_t>>& adjacency,
+namespace {
+
+// Neighbour lookup for the adjacency-map form
+struct MapNeighbors {
+    const std::unordered_map<size_t, std::vector<size_t>>& adjacency;
+
+    size_t size_hint() const { return adjacency.size(); }
+
+    template<typename Fn>
+    void for_each(size_t node, Fn&& fn) const {
+        auto it = adjacency.find(node);
+        if (it == adjacency.end()) {
+            return;
+        }
+        for (size_t neighbor : it->second) {
+            fn(neighbor);
+        }
+    }
+};
+
+// Neighbour lookup for a validated CSR graph
+struct CsrNeighbors {
+    const CsrView& graph;
+
+    size_t size_hint() const { return graph.n_nodes; }
+
+    template<typename Fn>
+    void for_each(size_t node, Fn&& fn) const {
+        if (node >= graph.n_nodes) {
+            return;
+        }
+        for (int64_t e = graph.indptr[node]; e < graph.indptr[node + 1]; ++e) {
+            fn(static_cast<size_t>(graph.indices[static_cast<size_t>(e)]));
+        }
+    }
+};
+
+template<typename Neighbors>
+alloc::pooled_vector<int64_t> bfs_impl(
+    const Neighbors& neighbors,
     const std::vector<size_t>& start_nodes,
     int max_depth
 ) {
-    std::unordered_set<size_t> visited;
-    std::queue<std::pair<size_t, int>> frontier;
+    // Visited set and FIFO live in the thread arena; the scope is declared
+    // first so both containers are gone before it rewinds
+    alloc::ArenaScope scope;
+    alloc::ArenaAllocator<size_t> arena(scope.arena());
+    alloc::ArenaSet<size_t> visited(start_nodes.size() * 4 + 16, std::hash<size_t>(),
+                                    std::equal_to<size_t>(), arena);
+    alloc::ArenaVector<std::pair<size_t, int>> frontier(arena);
+    frontier.reserve(neighbors.size_hint() + start_nodes.size());
+    size_t head = 0;
+    alloc::pooled_vector<int64_t> order;
 
     // Initialize with start nodes at depth 0
     for (size_t node : start_nodes) {
-        if (visited.find(node) == visited.end()) {
-            visited.insert(node);
-            frontier.push({node, 0});
+        if (visited.insert(node).second) {
+            order.push_back(static_cast<int64_t>(node));
+            frontier.push_back({node, 0});
         }
     }
 
-    while (!frontier.empty()) {
-        auto [current, depth] = frontier.front();
-        frontier.pop();
+    while (head < frontier.size()) {
+        auto [current, depth] = frontier[head++];
 
         if (depth >= max_depth) {
             continue;
         }
 
-        auto it = adjacency.find(current);
-        if (it == adjacency.end()) {
-            continue;
-        }
-
-        for (size_t neighbor : it->second) {
-            if (visited.find(neighbor) == visited.end()) {
-                visited.insert(neighbor);
-                frontier.push({neighbor, depth + 1});
+        neighbors.for_each(current, [&](size_t neighbor) {
+            if (visited.insert(neighbor).second) {
+                order.push_back(static_cast<int64_t>(neighbor));
+                frontier.push_back({neighbor, depth + 1});
             }
-        }
+        });
     }
 
-    return visited;
+    return order;
 }
 
-std::vector<int> find_connected_components(
-    const std::unordered_map<size_t, std::vector<size_t>>& adjacency,
-    size_t n_nodes
+template<typename Neighbors>
+int components_impl(
+    const Neighbors& neighbors,
+    size_t n_nodes,
+    MutableStridedView<int> component_ids,
+    const runtime::CancelToken* cancel
 ) {
-    std::vector<int> component_ids(n_nodes, -1);
+    for (size_t node = 0; node < n_nodes; ++node) {
+        component_ids[node] = -1;
+    }
     int current_component = 0;
 
+    // Every node is queued at most once overall, so one n_nodes array
+    // serves as the FIFO for all the BFS runs
+    alloc::ArenaScope scope;
+    size_t* queue = scope.array<size_t>(n_nodes);
+
     for (size_t node = 0; node < n_nodes; ++node) {
         if (component_ids[node] != -1) {
             continue;
         }
+        if (runtime::is_cancelled(cancel)) {
+            break;
+        }
 
         // BFS from this node
-        std::queue<size_t> q;
-        q.push(node);
+        size_t head = 0;
+        size_t tail = 0;
+        queue[tail++] = node;
         component_ids[node] = current_component;
 
-        while (!q.empty()) {
-            size_t current = q.front();
-            q.pop();
-
-            auto it = adjacency.find(current);
-            if (it == adjacency.end()) {
-                continue;
-            }
+        while (head < tail) {
+            size_t current = queue[head++];
 
-            for (size_t neighbor : it->second) {
+            neighbors.for_each(current, [&](size_t neighbor) {
                 if (neighbor < n_nodes && component_ids[neighbor] == -1) {
                     component_ids[neighbor] = current_component;
-                    q.push(neighbor);
+                    queue[tail++] = neighbor;
                 }
-            }
+            });
         }
 
         ++current_component;
     }
 
+    return current_component;
+}
+
+}  // anonymous namespace
+
+void validate_csr(const CsrView& graph) {
+    if (graph.indptr[0] != 0 ||
+        graph.indptr[graph.n_nodes] != static_cast<int64_t>(graph.n_edges)) {
+        throw std::invalid_argument("indptr must start at 0 and end at len(indices)");
+    }
+    for (size_t i = 0; i < graph.n_nodes; ++i) {
+        if (graph.indptr[i + 1] < graph.indptr[i]) {
+            throw std::invalid_argument("indptr must be non-decreasing");
+        }
+    }
+    for (size_t e = 0; e < graph.n_edges; ++e) {
+        const int64_t neighbor = graph.indices[e];
+        if (neighbor < 0 || static_cast<size_t>(neighbor) >= graph.n_nodes) {
+            throw std::invalid_argument("indices: node id out of range");
+        }
+    }
+}
+
+alloc::pooled_vector<int64_t> bfs_neighbors(
+    const std::unordered_map<size_t, std::vector<size_t>>& adjacency,
+    const std::vector<size_t>& start_nodes,
+    int max_depth
+) {
+    return bfs_impl(MapNeighbors{adjacency}, start_nodes, max_depth);
+}
+
+alloc::pooled_vector<int64_t> bfs_neighbors(
+    const CsrView& graph,
+    const std::vector<size_t>& start_nodes,
+    int max_depth
+) {
+    return bfs_impl(CsrNeighbors{graph}, start_nodes, max_depth);
+}
+
+std::vector<int> find_connected_components(
+    const std::unordered_map<size_t, std::vector<size_t>>& adjacency,
+    size_t n_nodes
+) {
+    std::vector<int> component_ids(n_nodes);
+    find_connected_components_into(
+        adjacency, n_nodes, MutableStridedView<int>(component_ids.data()));
     return component_ids;
 }
 
+int find_connected_components_into(
+    const std::unordered_map<size_t, std::vector<size_t>>& adjacency,
+    size_t n_nodes,
+    MutableStridedView<int> component_ids,
+    const runtime::CancelToken* cancel
+) {
+    return components_impl(MapNeighbors{adjacency}, n_nodes, component_ids, cancel);
+}
+
+int find_connected_components_into(
+    const CsrView& graph,
+    MutableStridedView<int> component_ids,
+    const runtime::CancelToken* cancel
+) {
+    return components_impl(CsrNeighbors{graph}, graph.n_nodes, component_ids, cancel);
+}
+
 }  // namespace graph_ops
 }  // namespace axnmihn
@@ -1,13 +1,37 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
 
+#include "buffer_pool.hpp"
+#include "cancel.hpp"
+#include "strided.hpp"
+
 namespace axnmihn {
 namespace graph_ops {
 
+/**
+ * Graph in compressed sparse row form: node i's neighbours are
+ * indices[indptr[i]:indptr[i+1]]. This is the layout knn::build returns
+ * and scipy.sparse.csr_matrix uses, read in place.
+ */
+struct CsrView {
+    StridedView<int64_t> indptr;   // n_nodes + 1 offsets
+    StridedView<int64_t> indices;  // n_edges neighbour ids
+    size_t n_nodes = 0;
+    size_t n_edges = 0;
+};
+
+/**
+ * Check that indptr starts at 0, never decreases and ends at n_edges,
+ * and that every neighbour id is below n_nodes; throws
+ * std::invalid_argument otherwise.
+ */
+void validate_csr(const CsrView& graph);
+
 /**
  * Fast BFS for finding neighbors within a given depth.
  *
@@ -17,14 +41,24 @@ namespace graph_ops {
  *     max_depth: Maximum BFS depth
  *
  * Returns:
- *     Set of all reachable node IDs within max_depth
+ *     All reachable node IDs within max_depth, in discovery order
+ *     (start nodes first, each node listed once)
  */
-std::unordered_set<size_t> bfs_neighbors(
+alloc::pooled_vector<int64_t> bfs_neighbors(
     const std::unordered_map<size_t, std::vector<size_t>>& adjacency,
     const std::vector<size_t>& start_nodes,
     int max_depth
 );
 
+/**
+ * bfs_neighbors over a CSR graph (start nodes >= n_nodes have no neighbours).
+ */
+alloc::pooled_vector<int64_t> bfs_neighbors(
+    const CsrView& graph,
+    const std::vector<size_t>& start_nodes,
+    int max_depth
+);
+
 /**
  * Find connected components in an undirected graph.
  *
@@ -40,5 +74,28 @@ std::vector<int> find_connected_components(
     size_t n_nodes
 );
 
+/**
+ * Connected components writing into a caller-provided output with
+ * n_nodes elements. Returns the number of components found.
+ * When `cancel` is set, stops between components (remaining ids stay -1).
+ */
+int find_connected_components_into(
+    const std::unordered_map<size_t, std::vector<size_t>>& adjacency,
+    size_t n_nodes,
+    MutableStridedView<int> component_ids,
+    const runtime::CancelToken* cancel = nullptr
+);
+
+/**
+ * find_connected_components_into over a CSR graph with graph.n_nodes
+ * nodes. Edges are followed as stored, so pass a symmetric graph
+ * (knn::symmetrize) for undirected components.
+ */
+int find_connected_components_into(
+    const CsrView& graph,
+    MutableStridedView<int> component_ids,
+    const runtime::CancelToken* cancel = nullptr
+);
+
 }  // namespace graph_ops
 }  // namespace axnmihn
@@ -0,0 +1,786 @@
+#include "interaction_log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace axnmihn {
+namespace ilog {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr char SEGMENT_MAGIC[8] = {'A', 'X', 'I', 'L', 'O', 'G', '0', '1'};
+constexpr const char* SEGMENT_PREFIX = "interactions-";
+constexpr const char* SEGMENT_SUFFIX = ".axlog";
+constexpr char INDEX_MAGIC[8] = {'A', 'X', 'I', 'I', 'D', 'X', '0', '1'};
+constexpr const char* INDEX_SUFFIX = ".axidx";
+constexpr size_t INDEX_BYTES = 44;      // magic + records + bytes + min_ts + max_ts + crc
+constexpr size_t FRAME_BYTES = 8;       // u32 length + u32 crc
+constexpr size_t FIXED_PAYLOAD = 36;    // numeric fields before the strings
+constexpr size_t MAX_STRING = 0xFFFF;
+constexpr size_t MAX_RECORD = 16u * 1024 * 1024;
+constexpr size_t WRITE_BATCH_BYTES = 1u << 20;
+
+constexpr uint8_t FLAG_ERROR = 1;
+constexpr uint8_t FLAG_REFUSAL = 2;
+
+// Slicing-by-8 CRC-32 tables (reflected IEEE polynomial)
+struct CrcTables {
+    uint32_t t[8][256];
+
+    CrcTables() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[0][i] = c;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int s = 1; s < 8; ++s) {
+                t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+const CrcTables& crc_tables() {
+    static const CrcTables tables;
+    return tables;
+}
+
+template<typename T>
+void put(std::string& out, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+template<typename T>
+T get(const char* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+void put_string(std::string& out, const std::string& s) {
+    const size_t len = std::min(s.size(), MAX_STRING);
+    put<uint16_t>(out, static_cast<uint16_t>(len));
+    out.append(s.data(), len);
+}
+
+// Frame + payload for one record
+std::string encode(const InteractionRecord& r) {
+    std::string out;
+    out.reserve(FRAME_BYTES + FIXED_PAYLOAD + 12 + r.session_id.size() + r.model.size() +
+                r.tier.size() + r.router_reason.size() + r.tool_calls_json.size() + r.error.size());
+    out.resize(FRAME_BYTES);
+    put<double>(out, r.timestamp);
+    put<int64_t>(out, r.turn_id);
+    put<int32_t>(out, r.latency_ms);
+    put<int32_t>(out, r.ttft_ms);
+    put<int32_t>(out, r.tokens_in);
+    put<int32_t>(out, r.tokens_out);
+    put<uint16_t>(out, r.tool_call_count);
+    put<uint8_t>(out, static_cast<uint8_t>((r.has_error ? FLAG_ERROR : 0) | (r.refusal ? FLAG_REFUSAL : 0)));
+    put<uint8_t>(out, 0);
+    put_string(out, r.session_id);
+    put_string(out, r.model);
+    put_string(out, r.tier);
+    put_string(out, r.router_reason);
+    put_string(out, r.tool_calls_json);
+    put_string(out, r.error);
+
+    const uint32_t len = static_cast<uint32_t>(out.size() - FRAME_BYTES);
+    const uint32_t crc = crc32(out.data() + FRAME_BYTES, len);
+    std::memcpy(&out[0], &len, 4);
+    std::memcpy(&out[4], &crc, 4);
+    return out;
+}
+
+bool parse_segment_index(const std::string& name, uint64_t& index) {
+    const size_t prefix = std::strlen(SEGMENT_PREFIX);
+    const size_t suffix = std::strlen(SEGMENT_SUFFIX);
+    if (name.size() <= prefix + suffix || name.compare(0, prefix, SEGMENT_PREFIX) != 0 ||
+        name.compare(name.size() - suffix, suffix, SEGMENT_SUFFIX) != 0) {
+        return false;
+    }
+    const std::string digits = name.substr(prefix, name.size() - prefix - suffix);
+    if (digits.empty() || !std::all_of(digits.begin(), digits.end(),
+                                       [](unsigned char c) { return std::isdigit(c); })) {
+        return false;
+    }
+    index = std::stoull(digits);
+    return true;
+}
+
+std::vector<std::pair<uint64_t, std::string>> indexed_segments(const std::string& directory) {
+    std::vector<std::pair<uint64_t, std::string>> out;
+    std::error_code ec;
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        uint64_t index;
+        if (it->is_regular_file(ec) && parse_segment_index(it->path().filename().string(), index)) {
+            out.emplace_back(index, it->path().string());
+        }
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+int sync_fd(int fd) {
+#ifdef __linux__
+    return ::fdatasync(fd);
+#else
+    return ::fsync(fd);
+#endif
+}
+
+bool write_all(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        const ssize_t n = ::write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Sidecar summary of a closed segment
+struct SegmentIndex {
+    uint64_t records = 0;
+    uint64_t bytes = 0;    // Segment file size the summary describes
+    double min_ts = std::numeric_limits<double>::infinity();
+    double max_ts = -std::numeric_limits<double>::infinity();
+};
+
+std::string index_path(const std::string& segment) {
+    return segment.substr(0, segment.size() - std::strlen(SEGMENT_SUFFIX)) + INDEX_SUFFIX;
+}
+
+bool write_index(const std::string& path, const SegmentIndex& index) {
+    std::string out(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    put<uint64_t>(out, index.records);
+    put<uint64_t>(out, index.bytes);
+    put<double>(out, index.min_ts);
+    put<double>(out, index.max_ts);
+    put<uint32_t>(out, crc32(out.data(), out.size()));
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    const bool ok = write_all(fd, out.data(), out.size());
+    ::close(fd);
+    return ok;
+}
+
+// False if the index is missing, short or fails its CRC
+bool read_index(const std::string& path, SegmentIndex& index) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    char buf[INDEX_BYTES + 1];
+    ssize_t n;
+    do {
+        n = ::read(fd, buf, sizeof(buf));
+    } while (n < 0 && errno == EINTR);
+    ::close(fd);
+    if (n != static_cast<ssize_t>(INDEX_BYTES) ||
+        std::memcmp(buf, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+        crc32(buf, INDEX_BYTES - 4) != get<uint32_t>(buf + INDEX_BYTES - 4)) {
+        return false;
+    }
+    index.records = get<uint64_t>(buf + 8);
+    index.bytes = get<uint64_t>(buf + 16);
+    index.min_ts = get<double>(buf + 24);
+    index.max_ts = get<double>(buf + 32);
+    return true;
+}
+
+// Interns strings of one column while decoding
+class Dictionary {
+public:
+    explicit Dictionary(StringColumn& column) : column_(column) {}
+
+    void add(const char* data, size_t len) {
+        auto it = lookup_.find(std::string_view(data, len));
+        if (it == lookup_.end()) {
+            const auto code = static_cast<int32_t>(column_.dictionary.size());
+            column_.dictionary.emplace_back(data, len);
+            // Keys view heap copies that stay put; dictionary strings move as it grows
+            keys_.emplace_back(new std::string(data, len));
+            it = lookup_.emplace(std::string_view(*keys_.back()), code).first;
+        }
+        column_.codes.push_back(it->second);
+    }
+
+private:
+    StringColumn& column_;
+    std::vector<std::unique_ptr<std::string>> keys_;
+    std::unordered_map<std::string_view, int32_t> lookup_;
+};
+
+}  // anonymous namespace
+
+uint32_t crc32(const void* data, size_t len) {
+    const auto& t = crc_tables().t;
+    const auto* p = static_cast<const uint8_t*>(data);
+    uint32_t c = 0xFFFFFFFFu;
+    while (len >= 8) {
+        uint32_t lo, hi;
+        std::memcpy(&lo, p, 4);
+        std::memcpy(&hi, p + 4, 4);
+        lo ^= c;
+        c = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+            t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+        p += 8;
+        len -= 8;
+    }
+    while (len--) {
+        c = t[0][(c ^ *p++) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+// ====================
+// Writer
+// ====================
+
+struct LogWriter::Impl {
+    // Bounded MPMC queue cell (Vyukov): seq == pos when free for the
+    // producer of ticket pos, pos + 1 when holding that ticket's record.
+    struct Cell {
+        std::atomic<size_t> seq;
+        std::string data;
+    };
+
+    std::string directory;
+    WriterOptions options;
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    alignas(64) std::atomic<size_t> enqueue_pos{0};
+    alignas(64) size_t dequeue_pos = 0;  // flusher only
+
+    std::atomic<uint64_t> appended{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> bytes_written{0};
+    std::atomic<uint64_t> segments{0};
+    std::atomic<uint64_t> fsyncs{0};
+    std::atomic<uint64_t> write_errors{0};
+    std::atomic<uint64_t> segments_deleted{0};
+
+    std::atomic<bool> closed{false};
+    std::atomic<uint32_t> appending{0};  // append() calls past the closed check
+    std::atomic<bool> flusher_idle{false};
+
+    // Flusher wake-up and flush() handshake
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable synced_cv;
+    uint64_t flush_target = 0;   // appended count a flush() waits for
+    uint64_t synced = 0;         // records written and fsynced
+    bool stopping = false;
+    bool stopped = false;        // flusher has exited
+
+    int fd = -1;
+    uint64_t segment_index = 0;
+    size_t segment_size = 0;
+    std::string segment_path;
+    SegmentIndex segment_meta;  // records written to the current segment
+    std::thread flusher;
+
+    bool try_enqueue(std::string&& record) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            const size_t seq = cell.seq.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = std::move(record);
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_dequeue(std::string& out) {
+        Cell& cell = cells[dequeue_pos & mask];
+        const size_t seq = cell.seq.load(std::memory_order_acquire);
+        if (seq != dequeue_pos + 1) {
+            return false;  // empty, or the producer has not finished
+        }
+        out.swap(cell.data);
+        cell.data.clear();
+        cell.seq.store(dequeue_pos + mask + 1, std::memory_order_release);
+        ++dequeue_pos;
+        return true;
+    }
+
+    // Sync and close the current segment, then write its index
+    void close_segment() {
+        if (fd < 0) {
+            return;
+        }
+        sync_fd(fd);
+        ::close(fd);
+        fd = -1;
+        segment_meta.bytes = segment_size;
+        if (!write_index(index_path(segment_path), segment_meta)) {
+            write_errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void open_segment() {
+        close_segment();
+        ++segment_index;
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s%06llu%s", SEGMENT_PREFIX,
+                      static_cast<unsigned long long>(segment_index), SEGMENT_SUFFIX);
+        segment_path = (fs::path(directory) / name).string();
+        segment_meta = SegmentIndex();
+        fd = ::open(segment_path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0 || !write_all(fd, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC))) {
+            write_errors.fetch_add(1, std::memory_order_relaxed);
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+            return;
+        }
+        segment_size = sizeof(SEGMENT_MAGIC);
+        segments.fetch_add(1, std::memory_order_relaxed);
+        enforce_retention();
+    }
+
+    // Delete closed segments past max_age_seconds, then the oldest until
+    // the directory fits max_total_bytes. The current segment is kept.
+    void enforce_retention() {
+        if (options.max_age_seconds <= 0.0 && options.max_total_bytes == 0) {
+            return;
+        }
+        const double now = std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        struct Candidate {
+            std::string path;
+            uint64_t size;
+            bool expired;
+        };
+        std::vector<Candidate> closed_segments;
+        uint64_t total = 0;
+        for (const auto& [index, path] : indexed_segments(directory)) {
+            struct stat st;
+            if (::stat(path.c_str(), &st) != 0) {
+                continue;
+            }
+            const auto size = static_cast<uint64_t>(st.st_size);
+            total += size;
+            if (index >= segment_index) {
+                continue;
+            }
+            bool expired = false;
+            if (options.max_age_seconds > 0.0) {
+                // Without a usable index the file's mtime stands in for its newest record
+                SegmentIndex meta;
+                const double newest = read_index(index_path(path), meta) && meta.bytes == size &&
+                                              meta.records > 0
+                                          ? meta.max_ts
+                                          : static_cast<double>(st.st_mtime);
+                expired = newest < now - options.max_age_seconds;
+            }
+            closed_segments.push_back({path, size, expired});
+        }
+        for (const auto& c : closed_segments) {
+            const bool over_budget = options.max_total_bytes > 0 && total > options.max_total_bytes;
+            if (!c.expired && !over_budget) {
+                continue;
+            }
+            if (::unlink(c.path.c_str()) != 0) {
+                write_errors.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            ::unlink(index_path(c.path).c_str());
+            total -= c.size;
+            segments_deleted.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void write_batch(const std::string& batch, uint64_t count, double min_ts, double max_ts) {
+        if (batch.empty()) {
+            return;
+        }
+        // Rotate before a batch that would overflow a non-empty segment
+        if (fd < 0 || (segment_size > sizeof(SEGMENT_MAGIC) &&
+                       segment_size + batch.size() > options.segment_bytes)) {
+            open_segment();
+        }
+        if (fd < 0 || !write_all(fd, batch.data(), batch.size())) {
+            write_errors.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            segment_size += batch.size();
+            segment_meta.records += count;
+            segment_meta.min_ts = std::min(segment_meta.min_ts, min_ts);
+            segment_meta.max_ts = std::max(segment_meta.max_ts, max_ts);
+            bytes_written.fetch_add(batch.size(), std::memory_order_relaxed);
+        }
+        // Counted even on error so flush() cannot wait forever
+        written.fetch_add(count, std::memory_order_release);
+    }
+
+    void run() {
+        using clock = std::chrono::steady_clock;
+        const auto interval = std::chrono::milliseconds(options.fsync_interval_ms);
+        const size_t batch_limit = std::max<size_t>(1, std::min(WRITE_BATCH_BYTES, options.segment_bytes));
+        auto last_sync = clock::now();
+        uint64_t unsynced = 0;
+        std::string batch;
+        std::string record;
+
+        uint64_t count = 0;
+        double min_ts = 0.0;
+        double max_ts = 0.0;
+        auto emit = [&] {
+            write_batch(batch, count, min_ts, max_ts);
+            unsynced += count;
+            batch.clear();
+            count = 0;
+        };
+
+        for (;;) {
+            // Drain whatever is queued, writing in batches of up to 1 MiB
+            while (try_dequeue(record)) {
+                if (!batch.empty() && batch.size() + record.size() > batch_limit) {
+                    emit();
+                }
+                const double ts = get<double>(record.data() + FRAME_BYTES);
+                min_ts = batch.empty() ? ts : std::min(min_ts, ts);
+                max_ts = batch.empty() ? ts : std::max(max_ts, ts);
+                batch += record;
+                ++count;
+                if (batch.size() >= batch_limit) {
+                    emit();
+                }
+            }
+            emit();
+
+            std::unique_lock<std::mutex> lock(mutex);
+            const uint64_t done = written.load(std::memory_order_acquire);
+            const bool flush_wanted = flush_target > synced;
+            if (unsynced > 0 && (flush_wanted || stopping || clock::now() - last_sync >= interval)) {
+                lock.unlock();
+                if (fd >= 0) {
+                    sync_fd(fd);
+                    fsyncs.fetch_add(1, std::memory_order_relaxed);
+                }
+                last_sync = clock::now();
+                unsynced = 0;
+                lock.lock();
+            }
+            if (unsynced == 0 && done > synced) {
+                synced = done;
+                synced_cv.notify_all();
+            }
+            if (stopping && enqueue_pos.load(std::memory_order_acquire) == dequeue_pos) {
+                break;
+            }
+            if (flush_target > synced) {
+                lock.unlock();
+                std::this_thread::yield();  // a flush() waits on a record still being enqueued
+                continue;
+            }
+            flusher_idle.store(true, std::memory_order_seq_cst);
+            if (enqueue_pos.load(std::memory_order_seq_cst) == dequeue_pos) {
+                auto timeout = unsynced > 0 ? interval : std::chrono::milliseconds(1000);
+                wake.wait_for(lock, timeout);
+            }
+            flusher_idle.store(false, std::memory_order_relaxed);
+        }
+
+        if (fd >= 0) {
+            fsyncs.fetch_add(1, std::memory_order_relaxed);
+        }
+        close_segment();
+        std::lock_guard<std::mutex> lock(mutex);
+        synced = written.load(std::memory_order_acquire);
+        stopped = true;
+        synced_cv.notify_all();
+    }
+};
+
+LogWriter::LogWriter(const std::string& directory, WriterOptions options)
+    : impl_(new Impl()) {
+    if (options.queue_capacity < 2) {
+        throw std::invalid_argument("queue_capacity must be >= 2");
+    }
+    if (options.max_age_seconds < 0.0) {
+        throw std::invalid_argument("max_age_seconds must be >= 0");
+    }
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec) {
+        throw std::runtime_error("cannot create log directory " + directory + ": " + ec.message());
+    }
+    Impl& s = *impl_;
+    s.directory = directory;
+    s.options = options;
+
+    size_t capacity = 1;
+    while (capacity < options.queue_capacity) {
+        capacity <<= 1;
+    }
+    s.cells.reset(new Impl::Cell[capacity]);
+    for (size_t i = 0; i < capacity; ++i) {
+        s.cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    s.mask = capacity - 1;
+
+    // Continue numbering after existing segments; never reopen one
+    const auto existing = indexed_segments(directory);
+    s.segment_index = existing.empty() ? 0 : existing.back().first;
+
+    s.flusher = std::thread([&s] { s.run(); });
+}
+
+LogWriter::~LogWriter() {
+    close();
+}
+
+bool LogWriter::append(const InteractionRecord& record) {
+    Impl& s = *impl_;
+    // Registered before the closed check, so close() waits for this
+    // record to be queued before telling the flusher to stop
+    s.appending.fetch_add(1, std::memory_order_seq_cst);
+    if (s.closed.load(std::memory_order_seq_cst)) {
+        s.appending.fetch_sub(1, std::memory_order_release);
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const bool queued = s.try_enqueue(encode(record));
+    if (queued) {
+        s.appended.fetch_add(1, std::memory_order_release);
+    } else {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    s.appending.fetch_sub(1, std::memory_order_release);
+    if (queued && s.flusher_idle.load(std::memory_order_seq_cst)) {
+        s.wake.notify_one();
+    }
+    return queued;
+}
+
+void LogWriter::flush() {
+    Impl& s = *impl_;
+    std::unique_lock<std::mutex> lock(s.mutex);
+    const uint64_t target = s.appended.load(std::memory_order_acquire);
+    if (s.synced >= target) {
+        return;
+    }
+    s.flush_target = std::max(s.flush_target, target);
+    s.wake.notify_one();
+    // Once the flusher has exited nothing more will be synced
+    s.synced_cv.wait(lock, [&] { return s.synced >= target || s.stopped; });
+}
+
+void LogWriter::close() {
+    Impl& s = *impl_;
+    if (s.closed.exchange(true, std::memory_order_seq_cst)) {
+        return;
+    }
+    // Let appends that passed the closed check finish queueing
+    while (s.appending.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.stopping = true;
+    }
+    s.wake.notify_one();
+    s.flusher.join();
+}
+
+WriterStats LogWriter::stats() const {
+    const Impl& s = *impl_;
+    WriterStats out;
+    out.appended = s.appended.load(std::memory_order_relaxed);
+    out.dropped = s.dropped.load(std::memory_order_relaxed);
+    out.written = s.written.load(std::memory_order_relaxed);
+    out.bytes_written = s.bytes_written.load(std::memory_order_relaxed);
+    out.segments = s.segments.load(std::memory_order_relaxed);
+    out.fsyncs = s.fsyncs.load(std::memory_order_relaxed);
+    out.write_errors = s.write_errors.load(std::memory_order_relaxed);
+    out.segments_deleted = s.segments_deleted.load(std::memory_order_relaxed);
+    return out;
+}
+
+// ====================
+// Reader
+// ====================
+
+std::vector<std::string> list_segments(const std::string& directory) {
+    std::vector<std::string> out;
+    for (auto& entry : indexed_segments(directory)) {
+        out.push_back(std::move(entry.second));
+    }
+    return out;
+}
+
+namespace {
+
+// Maps a segment read-only; empty on failure
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                data_ = static_cast<const char*>(p);
+                size_ = static_cast<size_t>(st.st_size);
+#ifdef MADV_SEQUENTIAL
+                ::madvise(p, size_, MADV_SEQUENTIAL);
+#endif
+            }
+        }
+        ::close(fd);
+    }
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Reads the six length-prefixed strings; false if they overrun the payload
+bool split_strings(const char* p, const char* end, std::array<std::pair<const char*, size_t>, 6>& out) {
+    for (auto& field : out) {
+        if (end - p < 2) {
+            return false;
+        }
+        const size_t len = get<uint16_t>(p);
+        p += 2;
+        if (static_cast<size_t>(end - p) < len) {
+            return false;
+        }
+        field = {p, len};
+        p += len;
+    }
+    return true;
+}
+
+}  // anonymous namespace
+
+LogColumns read_columns(const std::string& directory, double since) {
+    LogColumns cols;
+    Dictionary sessions(cols.session_id);
+    Dictionary models(cols.model);
+    Dictionary tiers(cols.tier);
+    Dictionary reasons(cols.router_reason);
+
+    for (const auto& path : list_segments(directory)) {
+        ++cols.segments;
+        // A closed segment that ends before `since` needs no record-level work
+        SegmentIndex meta;
+        struct stat st;
+        if (::stat(path.c_str(), &st) == 0 && read_index(index_path(path), meta) &&
+            meta.bytes == static_cast<uint64_t>(st.st_size) && meta.max_ts < since) {
+            ++cols.skipped;
+            continue;
+        }
+        MappedFile file(path);
+        if (file.size() < sizeof(SEGMENT_MAGIC) ||
+            std::memcmp(file.data(), SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0) {
+            if (file.size() > 0) {
+                ++cols.corrupt;
+            }
+            continue;
+        }
+        cols.bytes += file.size();
+
+        const char* p = file.data() + sizeof(SEGMENT_MAGIC);
+        const char* end = file.data() + file.size();
+        while (p < end) {
+            if (static_cast<size_t>(end - p) < FRAME_BYTES) {
+                ++cols.corrupt;
+                break;
+            }
+            const uint32_t len = get<uint32_t>(p);
+            const uint32_t crc = get<uint32_t>(p + 4);
+            const char* payload = p + FRAME_BYTES;
+            std::array<std::pair<const char*, size_t>, 6> strings;
+            if (len < FIXED_PAYLOAD || len > MAX_RECORD || static_cast<size_t>(end - payload) < len ||
+                crc32(payload, len) != crc ||
+                !split_strings(payload + FIXED_PAYLOAD, payload + len, strings)) {
+                ++cols.corrupt;  // torn or damaged tail: nothing after it is trusted
+                break;
+            }
+            p = payload + len;
+
+            const double ts = get<double>(payload);
+            if (ts < since) {
+                continue;
+            }
+            const uint8_t flags = static_cast<uint8_t>(payload[34]);
+            cols.timestamp.push_back(ts);
+            cols.turn_id.push_back(get<int64_t>(payload + 8));
+            cols.latency_ms.push_back(get<int32_t>(payload + 16));
+            cols.ttft_ms.push_back(get<int32_t>(payload + 20));
+            cols.tokens_in.push_back(get<int32_t>(payload + 24));
+            cols.tokens_out.push_back(get<int32_t>(payload + 28));
+            cols.tool_call_count.push_back(get<uint16_t>(payload + 32));
+            cols.has_error.push_back((flags & FLAG_ERROR) ? 1 : 0);
+            cols.refusal.push_back((flags & FLAG_REFUSAL) ? 1 : 0);
+            sessions.add(strings[0].first, strings[0].second);
+            models.add(strings[1].first, strings[1].second);
+            tiers.add(strings[2].first, strings[2].second);
+            reasons.add(strings[3].first, strings[3].second);
+        }
+    }
+    return cols;
+}
+
+}  // namespace ilog
+}  // namespace axnmihn
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace axnmihn {
+namespace ilog {
+
+/**
+ * One LLM interaction as written to the log.
+ *
+ * Integers use -1 for "not recorded" (the SQL tables store NULL there).
+ * Strings longer than 65535 bytes are truncated.
+ */
+struct InteractionRecord {
+    double timestamp = 0.0;        // Epoch seconds
+    int64_t turn_id = -1;
+    int32_t latency_ms = -1;
+    int32_t ttft_ms = -1;
+    int32_t tokens_in = -1;
+    int32_t tokens_out = -1;
+    uint16_t tool_call_count = 0;
+    bool has_error = false;
+    bool refusal = false;
+    std::string session_id;
+    std::string model;
+    std::string tier;
+    std::string router_reason;
+    std::string tool_calls_json;
+    std::string error;
+};
+
+struct WriterOptions {
+    size_t segment_bytes = 64u * 1024 * 1024;  // Rotate after this many bytes
+    uint32_t fsync_interval_ms = 1000;         // 0 = fsync after every batch
+    size_t queue_capacity = 65536;             // Records buffered before append() fails
+    double max_age_seconds = 0.0;              // Delete segments whose newest record is older; 0 = keep
+    uint64_t max_total_bytes = 0;              // Delete oldest segments beyond this total; 0 = unlimited
+};
+
+struct WriterStats {
+    uint64_t appended = 0;       // Accepted by append()
+    uint64_t dropped = 0;        // Rejected because the queue was full
+    uint64_t written = 0;        // Handed to write(2)
+    uint64_t bytes_written = 0;
+    uint64_t segments = 0;       // Segment files opened by this writer
+    uint64_t fsyncs = 0;
+    uint64_t write_errors = 0;
+    uint64_t segments_deleted = 0;  // Removed by the retention policy
+};
+
+/**
+ * Append-only interaction log with a background flusher.
+ *
+ * append() encodes the record and pushes it onto a bounded lock-free
+ * queue (Vyukov MPMC cells), so callers never block on I/O or on each
+ * other. One flusher thread drains the queue in batches, writes them to
+ * the current segment file and fsyncs at most every fsync_interval_ms.
+ *
+ * Segments are `interactions-NNNNNN.axlog` in the log directory. Each
+ * starts with an 8-byte magic followed by records framed as
+ * [u32 payload length][u32 CRC-32 of payload][payload]. A writer always
+ * starts a new segment, so a torn tail from a crash is confined to the
+ * last record of an old file; read_columns() stops there.
+ *
+ * When a segment is closed (rotation or close()) the writer leaves a
+ * sidecar `interactions-NNNNNN.axidx` with its record count, size and
+ * timestamp range, which lets read_columns() skip the whole file. Each
+ * time a segment is opened, closed segments past max_age_seconds or
+ * beyond max_total_bytes (oldest first) are deleted with their index.
+ */
+class LogWriter {
+public:
+    /**
+     * Open a writer; creates the directory if needed.
+     *
+     * Args:
+     *     directory: Segment directory
+     *     options: Rotation, fsync and queue settings
+     */
+    explicit LogWriter(const std::string& directory, WriterOptions options = WriterOptions());
+    ~LogWriter();
+    LogWriter(const LogWriter&) = delete;
+    LogWriter& operator=(const LogWriter&) = delete;
+
+    /**
+     * Queue one record. Never blocks.
+     *
+     * Returns:
+     *     false if the queue is full or the writer is closed (record dropped)
+     */
+    bool append(const InteractionRecord& record);
+
+    /** Block until every record appended before the call is written and fsynced. */
+    void flush();
+
+    /** Flush, stop the flusher and close the segment. Idempotent. */
+    void close();
+
+    WriterStats stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * Dictionary-encoded string column: values[i] == dictionary[codes[i]].
+ */
+struct StringColumn {
+    std::vector<int32_t> codes;
+    std::vector<std::string> dictionary;
+};
+
+/**
+ * Interaction logs decoded into columns for analytics scans.
+ */
+struct LogColumns {
+    std::vector<double> timestamp;
+    std::vector<int64_t> turn_id;
+    std::vector<int32_t> latency_ms;
+    std::vector<int32_t> ttft_ms;
+    std::vector<int32_t> tokens_in;
+    std::vector<int32_t> tokens_out;
+    std::vector<int32_t> tool_call_count;
+    std::vector<uint8_t> has_error;
+    std::vector<uint8_t> refusal;
+    StringColumn session_id;
+    StringColumn model;
+    StringColumn tier;
+    StringColumn router_reason;
+
+    uint64_t segments = 0;
+    uint64_t bytes = 0;
+    uint64_t corrupt = 0;     // Segments whose tail failed framing or CRC
+    uint64_t skipped = 0;     // Segments whose index shows nothing at or after `since`
+
+    size_t size() const { return timestamp.size(); }
+};
+
+/**
+ * Segment files in a log directory, oldest first.
+ */
+std::vector<std::string> list_segments(const std::string& directory);
+
+/**
+ * Decode every record with timestamp >= since from the directory's segments.
+ *
+ * A closed segment whose index matches its size and ends before `since`
+ * is skipped without being mapped; the open segment, and any segment
+ * without a valid index, is scanned record by record.
+ *
+ * Args:
+ *     directory: Segment directory (missing directory -> empty result)
+ *     since: Minimum timestamp (epoch seconds)
+ *
+ * Returns:
+ *     Columns in file order (append order within one writer)
+ */
+LogColumns read_columns(const std::string& directory, double since = 0.0);
+
+/** CRC-32 (IEEE) used for record framing. */
+uint32_t crc32(const void* data, size_t len);
+
+}  // namespace ilog
+}  // namespace axnmihn
@@ -0,0 +1,389 @@
+#include "knn_graph.hpp"
+#include "accuracy.hpp"
+#include "linalg.hpp"
+#include "thread_pool.hpp"
+#include "vector_ops.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+
+namespace axnmihn {
+namespace knn {
+
+namespace {
+
+constexpr size_t QUERY_TILE = 64;
+constexpr size_t CORPUS_TILE = 64;
+constexpr size_t RECALL_QUERIES = 16;
+
+struct Neighbor {
+    float score;
+    int64_t index;
+    bool fresh;  // NN-descent: not yet joined
+};
+
+// Heap order: the worst neighbour (lowest score, then highest index) on top
+bool better(const Neighbor& a, const Neighbor& b) {
+    return a.score > b.score || (a.score == b.score && a.index < b.index);
+}
+
+// Offer a candidate to a bounded heap; returns true if it was kept
+bool offer(std::vector<Neighbor>& heap, size_t k, const Neighbor& candidate) {
+    if (heap.size() < k) {
+        heap.push_back(candidate);
+        std::push_heap(heap.begin(), heap.end(), better);
+        return true;
+    }
+    if (!better(candidate, heap.front())) {
+        return false;
+    }
+    std::pop_heap(heap.begin(), heap.end(), better);
+    heap.back() = candidate;
+    std::push_heap(heap.begin(), heap.end(), better);
+    return true;
+}
+
+// L2-normalised float32 copy (n x dim)
+std::vector<float> normalized_rows(const StridedMatrix<double>& data) {
+    std::vector<float> out(data.rows * data.cols);
+    runtime::parallel_for(runtime::default_pool(), data.rows, 256, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto row = data.row(i);
+            double norm_sq = 0.0;
+            for (size_t d = 0; d < data.cols; ++d) {
+                norm_sq += row[d] * row[d];
+            }
+            const double inv = norm_sq > 1e-20 ? 1.0 / std::sqrt(norm_sq) : 0.0;
+            for (size_t d = 0; d < data.cols; ++d) {
+                out[i * data.cols + d] = static_cast<float>(row[d] * inv);
+            }
+        }
+    });
+    return out;
+}
+
+CsrGraph to_csr(std::vector<std::vector<Neighbor>>& heaps) {
+    CsrGraph graph;
+    graph.indptr.reserve(heaps.size() + 1);
+    for (const auto& heap : heaps) {
+        graph.indptr.push_back(graph.indptr.back() + static_cast<int64_t>(heap.size()));
+    }
+    graph.indices.resize(static_cast<size_t>(graph.indptr.back()));
+    graph.scores.resize(graph.indices.size());
+    runtime::parallel_for(runtime::default_pool(), heaps.size(), 1024, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto& heap = heaps[i];
+            std::sort(heap.begin(), heap.end(), better);
+            const auto offset = static_cast<size_t>(graph.indptr[i]);
+            for (size_t j = 0; j < heap.size(); ++j) {
+                graph.indices[offset + j] = heap[j].index;
+                graph.scores[offset + j] = heap[j].score;
+            }
+        }
+    });
+    return graph;
+}
+
+std::vector<std::vector<Neighbor>> build_exact(const std::vector<float>& x, size_t n, size_t dim,
+                                               size_t k, float min_score,
+                                               const runtime::CancelToken* cancel) {
+    std::vector<std::vector<Neighbor>> heaps(n);
+    const size_t tiles = (n + QUERY_TILE - 1) / QUERY_TILE;
+    runtime::parallel_for(runtime::default_pool(), tiles, 1, [&](size_t tile_begin, size_t tile_end) {
+        std::vector<float> scores(linalg::ROW_BLOCK * CORPUS_TILE);
+        for (size_t tile = tile_begin; tile < tile_end; ++tile) {
+            const size_t q0 = tile * QUERY_TILE;
+            const size_t q1 = std::min(n, q0 + QUERY_TILE);
+            for (size_t i = q0; i < q1; ++i) {
+                heaps[i].reserve(k);
+            }
+            for (size_t c0 = 0; c0 < n; c0 += CORPUS_TILE) {
+                if (runtime::is_cancelled(cancel)) {
+                    return;
+                }
+                const size_t cols = std::min(CORPUS_TILE, n - c0);
+                for (size_t r0 = q0; r0 < q1; r0 += linalg::ROW_BLOCK) {
+                    const size_t rows = std::min(linalg::ROW_BLOCK, q1 - r0);
+                    linalg::multiply_rows(&x[r0 * dim], rows, &x[c0 * dim], dim, cols,
+                                          scores.data());
+                    for (size_t r = 0; r < rows; ++r) {
+                        const size_t i = r0 + r;
+                        auto& heap = heaps[i];
+                        const float* row_scores = &scores[r * cols];
+                        for (size_t c = 0; c < cols; ++c) {
+                            const size_t j = c0 + c;
+                            if (j == i || row_scores[c] < min_score) {
+                                continue;
+                            }
+                            offer(heap, k, {row_scores[c], static_cast<int64_t>(j), false});
+                        }
+                    }
+                }
+            }
+        }
+    });
+    return heaps;
+}
+
+// Reservoir-free sampling: shuffle and keep the first `count`
+void sample_into(std::vector<int64_t>& items, size_t count, std::mt19937_64& rng) {
+    if (items.size() <= count) {
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        std::swap(items[i], items[i + rng() % (items.size() - i)]);
+    }
+    items.resize(count);
+}
+
+std::vector<std::vector<Neighbor>> build_nn_descent(const std::vector<float>& x, size_t n,
+                                                    size_t dim, const BuildOptions& options,
+                                                    const runtime::CancelToken* cancel) {
+    const size_t k = options.k;
+    const size_t samples = std::max<size_t>(
+        1, static_cast<size_t>(std::ceil(options.sample_rate * static_cast<double>(k))));
+    auto similarity = [&](int64_t a, int64_t b) {
+        return vector_ops::dot_product_f32(&x[static_cast<size_t>(a) * dim],
+                                           &x[static_cast<size_t>(b) * dim], dim);
+    };
+
+    // Random initial graph: k distinct other rows each
+    std::vector<std::vector<Neighbor>> heaps(n);
+    runtime::parallel_for(runtime::default_pool(), n, 256, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            std::mt19937_64 rng(options.seed ^ (0x9E3779B97F4A7C15ULL * (i + 1)));
+            auto& heap = heaps[i];
+            heap.reserve(k);
+            while (heap.size() < k) {
+                const auto j = static_cast<int64_t>(rng() % n);
+                if (static_cast<size_t>(j) == i ||
+                    std::any_of(heap.begin(), heap.end(),
+                                [j](const Neighbor& nb) { return nb.index == j; })) {
+                    continue;
+                }
+                heap.push_back({similarity(static_cast<int64_t>(i), j), j, true});
+            }
+            std::make_heap(heap.begin(), heap.end(), better);
+        }
+    });
+
+    std::vector<std::mutex> locks(n);
+    auto update = [&](int64_t row, int64_t candidate, float score) -> size_t {
+        std::lock_guard<std::mutex> lock(locks[static_cast<size_t>(row)]);
+        auto& heap = heaps[static_cast<size_t>(row)];
+        const Neighbor entry{score, candidate, true};
+        if (!better(entry, heap.front())) {
+            return 0;
+        }
+        for (const auto& nb : heap) {
+            if (nb.index == candidate) {
+                return 0;
+            }
+        }
+        return offer(heap, k, entry) ? 1 : 0;
+    };
+
+    std::vector<std::vector<int64_t>> fresh(n), old(n), reverse_fresh(n), reverse_old(n);
+    const double stop = options.delta * static_cast<double>(n) * static_cast<double>(k);
+    for (size_t round = 0; round < options.max_iterations; ++round) {
+        if (runtime::is_cancelled(cancel)) {
+            break;
+        }
+        // Split each list into sampled new entries (now marked joined) and old ones
+        runtime::parallel_for(runtime::default_pool(), n, 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                std::mt19937_64 rng(options.seed + 0x632BE59BD9B4E019ULL * (round * n + i + 1));
+                fresh[i].clear();
+                old[i].clear();
+                for (const auto& nb : heaps[i]) {
+                    (nb.fresh ? fresh[i] : old[i]).push_back(nb.index);
+                }
+                sample_into(fresh[i], samples, rng);
+                for (auto& nb : heaps[i]) {
+                    if (nb.fresh &&
+                        std::find(fresh[i].begin(), fresh[i].end(), nb.index) != fresh[i].end()) {
+                        nb.fresh = false;
+                    }
+                }
+            }
+        });
+        for (size_t i = 0; i < n; ++i) {
+            reverse_fresh[i].clear();
+            reverse_old[i].clear();
+        }
+        for (size_t i = 0; i < n; ++i) {
+            for (int64_t j : fresh[i]) {
+                reverse_fresh[static_cast<size_t>(j)].push_back(static_cast<int64_t>(i));
+            }
+            for (int64_t j : old[i]) {
+                reverse_old[static_cast<size_t>(j)].push_back(static_cast<int64_t>(i));
+            }
+        }
+        runtime::parallel_for(runtime::default_pool(), n, 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                std::mt19937_64 rng(options.seed + 0xD1B54A32D192ED03ULL * (round * n + i + 1));
+                sample_into(reverse_fresh[i], samples, rng);
+                sample_into(reverse_old[i], samples, rng);
+                fresh[i].insert(fresh[i].end(), reverse_fresh[i].begin(), reverse_fresh[i].end());
+                old[i].insert(old[i].end(), reverse_old[i].begin(), reverse_old[i].end());
+                std::sort(fresh[i].begin(), fresh[i].end());
+                fresh[i].erase(std::unique(fresh[i].begin(), fresh[i].end()), fresh[i].end());
+                std::sort(old[i].begin(), old[i].end());
+                old[i].erase(std::unique(old[i].begin(), old[i].end()), old[i].end());
+            }
+        });
+
+        // Local join: neighbours of a row are likely neighbours of each other
+        std::atomic<size_t> changes{0};
+        runtime::parallel_for(runtime::default_pool(), n, 64, [&](size_t begin, size_t end) {
+            size_t local = 0;
+            for (size_t i = begin; i < end; ++i) {
+                const auto& f = fresh[i];
+                const auto& o = old[i];
+                for (size_t a = 0; a < f.size(); ++a) {
+                    for (size_t b = a + 1; b < f.size(); ++b) {
+                        const float s = similarity(f[a], f[b]);
+                        local += update(f[a], f[b], s) + update(f[b], f[a], s);
+                    }
+                    for (int64_t u : o) {
+                        if (u == f[a]) {
+                            continue;
+                        }
+                        const float s = similarity(f[a], u);
+                        local += update(f[a], u, s) + update(u, f[a], s);
+                    }
+                }
+            }
+            changes.fetch_add(local, std::memory_order_relaxed);
+        });
+        if (static_cast<double>(changes.load()) < stop) {
+            break;
+        }
+    }
+    return heaps;
+}
+
+// Recall@k of a few rows against an exact scan, for accuracy sampling
+void sample_recall(const std::vector<float>& x, size_t n, size_t dim, size_t k,
+                   const std::vector<std::vector<Neighbor>>& heaps) {
+    const size_t queries = std::min(n, RECALL_QUERIES);
+    std::vector<double> scores(n);
+    double total = 0.0;
+    for (size_t q = 0; q < queries; ++q) {
+        const size_t row = q * n / queries;
+        for (size_t j = 0; j < n; ++j) {
+            scores[j] = j == row ? -2.0 : vector_ops::dot_product_f32(&x[row * dim], &x[j * dim], dim);
+        }
+        const auto exact = accuracy::top_k(StridedView<double>(scores.data()), n, k);
+        std::vector<int64_t> approx;
+        for (const auto& nb : heaps[row]) {
+            approx.push_back(nb.index);
+        }
+        total += accuracy::recall_at_k(approx.data(), approx.size(), exact.data(), exact.size(), k);
+    }
+    accuracy::record_recall("knn.nn_descent", total / static_cast<double>(queries));
+}
+
+}  // anonymous namespace
+
+CsrGraph build(const StridedMatrix<double>& embeddings, const BuildOptions& options,
+               const runtime::CancelToken* cancel) {
+    if (options.k == 0) {
+        throw std::invalid_argument("k must be positive");
+    }
+    const size_t n = embeddings.rows;
+    const size_t dim = embeddings.cols;
+    // With at most k other rows, every other row is a neighbour
+    const size_t k = std::min(options.k, n > 0 ? n - 1 : 0);
+    if (k == 0) {
+        CsrGraph graph;
+        graph.indptr.assign(n + 1, 0);
+        return graph;
+    }
+    const std::vector<float> x = normalized_rows(embeddings);
+    const auto min_score = static_cast<float>(options.min_similarity);
+
+    // Small inputs are cheap to scan and too small for a random start
+    const bool exact = options.method == BuildMethod::Exact ||
+                       (options.method == BuildMethod::Auto && n <= options.exact_limit) ||
+                       n <= 2 * k + 1;
+    if (exact) {
+        auto heaps = build_exact(x, n, dim, k, min_score, cancel);
+        return to_csr(heaps);
+    }
+
+    BuildOptions descent = options;
+    descent.k = k;
+    auto heaps = build_nn_descent(x, n, dim, descent, cancel);
+    if (accuracy::should_sample()) {
+        sample_recall(x, n, dim, k, heaps);
+    }
+    for (auto& heap : heaps) {
+        heap.erase(std::remove_if(heap.begin(), heap.end(),
+                                  [min_score](const Neighbor& nb) { return nb.score < min_score; }),
+                   heap.end());
+    }
+    return to_csr(heaps);
+}
+
+CsrGraph symmetrize(const CsrGraph& graph, bool mutual) {
+    const size_t n = graph.nodes();
+    if (graph.indptr.empty() || graph.indptr.front() != 0 ||
+        static_cast<size_t>(graph.indptr.back()) != graph.edges() ||
+        graph.scores.size() != graph.edges()) {
+        throw std::invalid_argument("indptr, indices and scores do not form a CSR graph");
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (graph.indptr[i + 1] < graph.indptr[i]) {
+            throw std::invalid_argument("indptr must be non-decreasing");
+        }
+    }
+    struct Edge {
+        int64_t from;
+        int64_t to;
+        float score;
+    };
+    std::vector<Edge> edges;
+    edges.reserve(graph.edges() * 2);
+    for (size_t i = 0; i < n; ++i) {
+        for (auto e = graph.indptr[i]; e < graph.indptr[i + 1]; ++e) {
+            const int64_t j = graph.indices[static_cast<size_t>(e)];
+            if (j < 0 || static_cast<size_t>(j) >= n) {
+                throw std::invalid_argument("indices: neighbour out of range");
+            }
+            if (static_cast<size_t>(j) == i) {
+                continue;
+            }
+            const float s = graph.scores[static_cast<size_t>(e)];
+            edges.push_back({static_cast<int64_t>(i), j, s});
+            edges.push_back({j, static_cast<int64_t>(i), s});
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+        return a.from != b.from ? a.from < b.from : a.to < b.to;
+    });
+
+    // An edge listed in both directions appears twice after the sort
+    std::vector<std::vector<Neighbor>> rows(n);
+    for (size_t e = 0; e < edges.size();) {
+        size_t end = e + 1;
+        float score = edges[e].score;
+        while (end < edges.size() && edges[end].from == edges[e].from &&
+               edges[end].to == edges[e].to) {
+            score = std::max(score, edges[end].score);
+            ++end;
+        }
+        if (!mutual || end - e > 1) {
+            rows[static_cast<size_t>(edges[e].from)].push_back({score, edges[e].to, false});
+        }
+        e = end;
+    }
+    return to_csr(rows);
+}
+
+}  // namespace knn
+}  // namespace axnmihn
@@ -0,0 +1,421 @@
+#include "linalg.hpp"
+#include "simd.hpp"
+#include "thread_pool.hpp"
+#include "vector_ops.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef HAS_AVX2
+#include <immintrin.h>
+#endif
+
+namespace axnmihn {
+namespace linalg {
+
+namespace {
+
+// Floats of each x row multiply_rows() keeps in L1 per pass (8 rows = 16 KB)
+constexpr size_t INNER_BLOCK = 512;
+
+template<typename B>
+void multiply_transposed_impl(const float* a, size_t rows, size_t inner, const B* b, size_t cols,
+                              double* out) {
+    runtime::parallel_for(runtime::default_pool(), inner, 64, [&](size_t begin, size_t end) {
+        std::fill(out + begin * cols, out + end * cols, 0.0);
+        for (size_t i = 0; i < rows; ++i) {
+            const float* x = a + i * inner;
+            const B* src = b + i * cols;
+            for (size_t j = begin; j < end; ++j) {
+                const double v = x[j];
+                double* dst = out + j * cols;
+                for (size_t c = 0; c < cols; ++c) {
+                    dst[c] += v * src[c];
+                }
+            }
+        }
+    });
+}
+
+void transpose_square(std::vector<double>& a, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            std::swap(a[i * n + j], a[j * n + i]);
+        }
+    }
+}
+
+}  // anonymous namespace
+
+void multiply(const float* a, size_t rows, size_t inner, const double* b, size_t cols,
+              double* out) {
+    runtime::parallel_for(runtime::default_pool(), rows, 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            double* dst = out + i * cols;
+            std::fill(dst, dst + cols, 0.0);
+            const float* x = a + i * inner;
+            for (size_t j = 0; j < inner; ++j) {
+                const double v = x[j];
+                const double* src = b + j * cols;
+                for (size_t c = 0; c < cols; ++c) {
+                    dst[c] += v * src[c];
+                }
+            }
+        }
+    });
+}
+
+void multiply_transposed(const float* a, size_t rows, size_t inner, const double* b,
+                         size_t cols, double* out) {
+    multiply_transposed_impl(a, rows, inner, b, cols, out);
+}
+
+void multiply_transposed(const float* a, size_t rows, size_t inner, const float* b,
+                         size_t cols, double* out) {
+    multiply_transposed_impl(a, rows, inner, b, cols, out);
+}
+
+void orthonormalize_columns(double* a, size_t rows, size_t cols) {
+    std::vector<double> t(rows * cols);  // column-major copy
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t c = 0; c < cols; ++c) {
+            t[c * rows + i] = a[i * cols + c];
+        }
+    }
+    std::vector<double> r(cols);
+    for (size_t c = 0; c < cols; ++c) {
+        double* v = &t[c * rows];
+        double original = 0.0;
+        for (size_t i = 0; i < rows; ++i) {
+            original += v[i] * v[i];
+        }
+        for (int pass = 0; pass < 2; ++pass) {
+            runtime::parallel_for(runtime::default_pool(), c, 32, [&](size_t begin, size_t end) {
+                for (size_t p = begin; p < end; ++p) {
+                    const double* u = &t[p * rows];
+                    double dot = 0.0;
+                    for (size_t i = 0; i < rows; ++i) {
+                        dot += u[i] * v[i];
+                    }
+                    r[p] = dot;
+                }
+            });
+            for (size_t p = 0; p < c; ++p) {
+                const double* u = &t[p * rows];
+                for (size_t i = 0; i < rows; ++i) {
+                    v[i] -= r[p] * u[i];
+                }
+            }
+        }
+        double norm = 0.0;
+        for (size_t i = 0; i < rows; ++i) {
+            norm += v[i] * v[i];
+        }
+        const double scale = norm > original * 1e-20 && norm > 0.0 ? 1.0 / std::sqrt(norm) : 0.0;
+        for (size_t i = 0; i < rows; ++i) {
+            v[i] *= scale;
+        }
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t c = 0; c < cols; ++c) {
+            a[i * cols + c] = t[c * rows + i];
+        }
+    }
+}
+
+void symmetric_eigen(std::vector<double>& v, size_t size, std::vector<double>& d) {
+    const int n = static_cast<int>(size);
+    // Tridiagonalisation reads columns of the (symmetric) input, so it
+    // indexes the storage column-major; the storage then holds the
+    // transformation transposed, which is the layout the QL sweeps want
+    auto C = [&](int i, int j) -> double& { return v[static_cast<size_t>(j) * size + i]; };
+    auto V = [&](int i, int j) -> double& { return v[static_cast<size_t>(i) * size + j]; };
+    d.assign(size, 0.0);
+    std::vector<double> e(size, 0.0);
+
+    for (int j = 0; j < n; ++j) {
+        d[j] = C(n - 1, j);
+    }
+    for (int i = n - 1; i > 0; --i) {
+        double scale = 0.0;
+        double h = 0.0;
+        for (int k = 0; k < i; ++k) {
+            scale += std::fabs(d[k]);
+        }
+        if (scale == 0.0) {
+            e[i] = d[i - 1];
+            for (int j = 0; j < i; ++j) {
+                d[j] = C(i - 1, j);
+                C(i, j) = 0.0;
+                C(j, i) = 0.0;
+            }
+        } else {
+            for (int k = 0; k < i; ++k) {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            double f = d[i - 1];
+            double g = std::sqrt(h);
+            if (f > 0) {
+                g = -g;
+            }
+            e[i] = scale * g;
+            h -= f * g;
+            d[i - 1] = f - g;
+            for (int j = 0; j < i; ++j) {
+                e[j] = 0.0;
+            }
+            for (int j = 0; j < i; ++j) {
+                f = d[j];
+                C(j, i) = f;
+                g = e[j] + C(j, j) * f;
+                for (int k = j + 1; k <= i - 1; ++k) {
+                    g += C(k, j) * d[k];
+                    e[k] += C(k, j) * f;
+                }
+                e[j] = g;
+            }
+            f = 0.0;
+            for (int j = 0; j < i; ++j) {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            const double hh = f / (h + h);
+            for (int j = 0; j < i; ++j) {
+                e[j] -= hh * d[j];
+            }
+            for (int j = 0; j < i; ++j) {
+                f = d[j];
+                g = e[j];
+                for (int k = j; k <= i - 1; ++k) {
+                    C(k, j) -= (f * e[k] + g * d[k]);
+                }
+                d[j] = C(i - 1, j);
+                C(i, j) = 0.0;
+            }
+        }
+        d[i] = h;
+    }
+    for (int i = 0; i < n - 1; ++i) {
+        C(n - 1, i) = C(i, i);
+        C(i, i) = 1.0;
+        const double h = d[i + 1];
+        if (h != 0.0) {
+            for (int k = 0; k <= i; ++k) {
+                d[k] = C(k, i + 1) / h;
+            }
+            for (int j = 0; j <= i; ++j) {
+                double g = 0.0;
+                for (int k = 0; k <= i; ++k) {
+                    g += C(k, i + 1) * C(k, j);
+                }
+                for (int k = 0; k <= i; ++k) {
+                    C(k, j) -= g * d[k];
+                }
+            }
+        }
+        for (int k = 0; k <= i; ++k) {
+            C(k, i + 1) = 0.0;
+        }
+    }
+    for (int j = 0; j < n; ++j) {
+        d[j] = C(n - 1, j);
+        C(n - 1, j) = 0.0;
+    }
+    C(n - 1, n - 1) = 1.0;
+    e[0] = 0.0;
+
+    // QL sweeps: row r of the storage is eigenvector column r, so each
+    // rotation touches two contiguous rows
+    for (int i = 1; i < n; ++i) {
+        e[i - 1] = e[i];
+    }
+    e[n - 1] = 0.0;
+    double f = 0.0;
+    double tst1 = 0.0;
+    const double eps = std::numeric_limits<double>::epsilon();
+    for (int l = 0; l < n; ++l) {
+        tst1 = std::max(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+        int m = l;
+        while (m < n - 1 && std::fabs(e[m]) > eps * tst1) {
+            ++m;
+        }
+        if (m > l) {
+            do {
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2.0 * e[l]);
+                double r = std::hypot(p, 1.0);
+                if (p < 0) {
+                    r = -r;
+                }
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                const double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (int i = l + 2; i < n; ++i) {
+                    d[i] -= h;
+                }
+                f += h;
+
+                p = d[m];
+                double c = 1.0, c2 = 1.0, c3 = 1.0;
+                const double el1 = e[l + 1];
+                double s = 0.0, s2 = 0.0;
+                for (int i = m - 1; i >= l; --i) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+                    double* vi = &V(i, 0);
+                    double* vi1 = &V(i + 1, 0);
+                    for (int k = 0; k < n; ++k) {
+                        const double t = vi1[k];
+                        vi1[k] = s * vi[k] + c * t;
+                        vi[k] = c * vi[k] - s * t;
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while (std::fabs(e[l]) > eps * tst1);
+        }
+        d[l] += f;
+        e[l] = 0.0;
+    }
+
+    // Ascending order, eigenvectors following
+    for (int i = 0; i < n - 1; ++i) {
+        int k = i;
+        for (int j = i + 1; j < n; ++j) {
+            if (d[j] < d[k]) {
+                k = j;
+            }
+        }
+        if (k != i) {
+            std::swap(d[k], d[i]);
+            std::swap_ranges(&V(i, 0), &V(i, 0) + n, &V(k, 0));
+        }
+    }
+    transpose_square(v, size);
+}
+
+
+bool cholesky_solve(std::vector<double>& a, size_t n, double* b, size_t cols) {
+    // a = L L^T, L in the lower triangle (row-major, so row k of L is contiguous)
+    for (size_t j = 0; j < n; ++j) {
+        double* row_j = &a[j * n];
+        double diag = row_j[j];
+        for (size_t k = 0; k < j; ++k) {
+            diag -= row_j[k] * row_j[k];
+        }
+        if (!(diag > 0.0)) {
+            return false;
+        }
+        const double l_jj = std::sqrt(diag);
+        row_j[j] = l_jj;
+        runtime::parallel_for(runtime::default_pool(), n - j - 1, 64, [&](size_t begin, size_t end) {
+            for (size_t i = j + 1 + begin; i < j + 1 + end; ++i) {
+                double* row_i = &a[i * n];
+                double sum = row_i[j];
+                for (size_t k = 0; k < j; ++k) {
+                    sum -= row_i[k] * row_j[k];
+                }
+                row_i[j] = sum / l_jj;
+            }
+        });
+    }
+
+    // Forward (L y = b) then backward (L^T x = y) substitution
+    for (size_t i = 0; i < n; ++i) {
+        double* bi = b + i * cols;
+        for (size_t k = 0; k < i; ++k) {
+            const double l = a[i * n + k];
+            const double* bk = b + k * cols;
+            for (size_t c = 0; c < cols; ++c) {
+                bi[c] -= l * bk[c];
+            }
+        }
+        const double inv = 1.0 / a[i * n + i];
+        for (size_t c = 0; c < cols; ++c) {
+            bi[c] *= inv;
+        }
+    }
+    for (size_t i = n; i-- > 0;) {
+        double* bi = b + i * cols;
+        const double inv = 1.0 / a[i * n + i];
+        for (size_t c = 0; c < cols; ++c) {
+            bi[c] *= inv;
+        }
+        for (size_t k = 0; k < i; ++k) {
+            const double l = a[i * n + k];
+            double* bk = b + k * cols;
+            for (size_t c = 0; c < cols; ++c) {
+                bk[c] -= l * bi[c];
+            }
+        }
+    }
+    return true;
+}
+
+void multiply_rows(const float* x, size_t rows, const float* w, size_t dim, size_t out,
+                   float* dst) {
+#ifdef HAS_AVX2
+    if (simd::use_avx2() && rows == ROW_BLOCK) {
+        // Walk the inner dimension in slices so the eight x slices stay in
+        // L1 while every row of w streams past them; per-row partial sums
+        // live in acc_buf between slices
+        thread_local std::vector<float> acc_buf;
+        acc_buf.assign(out * ROW_BLOCK * 8, 0.0f);
+        const size_t vec_dim = dim - dim % 8;
+        for (size_t k0 = 0; k0 < vec_dim; k0 += INNER_BLOCK) {
+            const size_t k1 = std::min(vec_dim, k0 + INNER_BLOCK);
+            for (size_t j = 0; j < out; ++j) {
+                const float* wj = w + j * dim;
+                float* acc = &acc_buf[j * ROW_BLOCK * 8];
+                __m256 a[ROW_BLOCK];
+                for (size_t r = 0; r < ROW_BLOCK; ++r) {
+                    a[r] = _mm256_loadu_ps(acc + r * 8);
+                }
+                for (size_t k = k0; k < k1; k += 8) {
+                    const __m256 wv = _mm256_loadu_ps(wj + k);
+                    for (size_t r = 0; r < ROW_BLOCK; ++r) {
+                        a[r] = _mm256_fmadd_ps(_mm256_loadu_ps(x + r * dim + k), wv, a[r]);
+                    }
+                }
+                for (size_t r = 0; r < ROW_BLOCK; ++r) {
+                    _mm256_storeu_ps(acc + r * 8, a[r]);
+                }
+            }
+        }
+        for (size_t j = 0; j < out; ++j) {
+            const float* wj = w + j * dim;
+            for (size_t r = 0; r < ROW_BLOCK; ++r) {
+                const float* tmp = &acc_buf[(j * ROW_BLOCK + r) * 8];
+                float dot = ((tmp[0] + tmp[1]) + (tmp[2] + tmp[3])) +
+                            ((tmp[4] + tmp[5]) + (tmp[6] + tmp[7]));
+                for (size_t t = vec_dim; t < dim; ++t) {
+                    dot += x[r * dim + t] * wj[t];
+                }
+                dst[r * out + j] = dot;
+            }
+        }
+        return;
+    }
+#endif
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t j = 0; j < out; ++j) {
+            dst[r * out + j] = vector_ops::dot_product_f32(x + r * dim, w + j * dim, dim);
+        }
+    }
+}
+
+}  // namespace linalg
+}  // namespace axnmihn
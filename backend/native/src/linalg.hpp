@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace axnmihn {
+namespace linalg {
+
+/**
+ * Dense kernels shared by the embedding fitters (projection, mapping).
+ *
+ * Matrices are row-major. Samples are float (they are normalised
+ * embeddings); accumulation and the small factorised matrices are
+ * double. Products run on the default thread pool.
+ */
+
+/** Rows multiplied together by multiply_rows(), one component load per block. */
+constexpr size_t ROW_BLOCK = 8;
+
+/** out (rows x cols) = a (rows x inner) * b (inner x cols). */
+void multiply(const float* a, size_t rows, size_t inner, const double* b, size_t cols,
+              double* out);
+
+/** out (inner x cols) = a^T * b, with a rows x inner and b rows x cols. */
+void multiply_transposed(const float* a, size_t rows, size_t inner, const double* b,
+                         size_t cols, double* out);
+void multiply_transposed(const float* a, size_t rows, size_t inner, const float* b,
+                         size_t cols, double* out);
+
+/**
+ * Orthonormalise the columns of a (rows x cols) in place with classical
+ * Gram-Schmidt applied twice. Columns that depend linearly on earlier
+ * ones become zero.
+ */
+void orthonormalize_columns(double* a, size_t rows, size_t cols);
+
+/**
+ * Eigen-decomposition of a symmetric n x n matrix: Householder
+ * tridiagonalisation and the implicit QL method (after the public-domain
+ * JAMA tred2/tql2).
+ *
+ * Args:
+ *     a: Matrix, overwritten by the eigenvectors as columns
+ *     n: Order
+ *     eigenvalues: Set to the n eigenvalues, ascending
+ */
+void symmetric_eigen(std::vector<double>& a, size_t n, std::vector<double>& eigenvalues);
+
+/**
+ * Solve a x = b for a symmetric positive definite n x n matrix by
+ * Cholesky factorisation.
+ *
+ * Args:
+ *     a: Matrix, overwritten by its factor
+ *     n: Order
+ *     b: n x cols right-hand sides, overwritten by the solutions
+ *     cols: Number of right-hand sides
+ *
+ * Returns:
+ *     false when a is not positive definite
+ */
+bool cholesky_solve(std::vector<double>& a, size_t n, double* b, size_t cols);
+
+/**
+ * dst (rows x out) = x (rows x dim) * w^T, with w out x dim. Blocks of
+ * ROW_BLOCK rows load each row of w once (AVX2 FMA when available).
+ */
+void multiply_rows(const float* x, size_t rows, const float* w, size_t dim, size_t out,
+                   float* dst);
+
+}  // namespace linalg
+}  // namespace axnmihn
@@ -0,0 +1,347 @@
+#include "linear_map.hpp"
+#include "accuracy.hpp"
+#include "linalg.hpp"
+#include "thread_pool.hpp"
+#include "vector_ops.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace axnmihn {
+namespace mapping {
+
+namespace {
+
+double inverse_norm(StridedView<double> row, size_t dim) {
+    double norm_sq = 0.0;
+    for (size_t d = 0; d < dim; ++d) {
+        norm_sq += row[d] * row[d];
+    }
+    return norm_sq > 1e-20 ? 1.0 / std::sqrt(norm_sq) : 0.0;
+}
+
+// Normalised float copy of a matrix (n x dim)
+std::vector<float> normalized_rows(const StridedMatrix<double>& data) {
+    std::vector<float> out(data.rows * data.cols);
+    runtime::parallel_for(runtime::default_pool(), data.rows, 256, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto row = data.row(i);
+            const double inv = inverse_norm(row, data.cols);
+            for (size_t d = 0; d < data.cols; ++d) {
+                out[i * data.cols + d] = static_cast<float>(row[d] * inv);
+            }
+        }
+    });
+    return out;
+}
+
+// a (p x q, p <= q) -> (a a^T)^(-1/2) a, the orthogonal polar factor.
+// Directions with a vanishing singular value are dropped.
+std::vector<double> polar_factor(const std::vector<double>& a, size_t p, size_t q) {
+    std::vector<double> gram(p * p, 0.0);
+    runtime::parallel_for(runtime::default_pool(), p, 4, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const double* ai = &a[i * q];
+            for (size_t j = i; j < p; ++j) {
+                const double* aj = &a[j * q];
+                double dot = 0.0;
+                for (size_t c = 0; c < q; ++c) {
+                    dot += ai[c] * aj[c];
+                }
+                gram[i * p + j] = dot;
+            }
+        }
+    });
+    for (size_t i = 0; i < p; ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            gram[i * p + j] = gram[j * p + i];
+        }
+    }
+
+    std::vector<double> eigenvalues;
+    linalg::symmetric_eigen(gram, p, eigenvalues);
+    const double floor = std::max(eigenvalues[p - 1], 0.0) * 1e-12;
+
+    // inv_sqrt = Q diag(lambda^-1/2) Q^T, over the kept eigenpairs
+    std::vector<double> scaled(p * p, 0.0);  // Q diag(lambda^-1/2)
+    for (size_t c = 0; c < p; ++c) {
+        if (!(eigenvalues[c] > floor)) {
+            continue;
+        }
+        const double s = 1.0 / std::sqrt(std::sqrt(eigenvalues[c]));
+        for (size_t r = 0; r < p; ++r) {
+            scaled[r * p + c] = gram[r * p + c] * s;
+        }
+    }
+    // Split the power between both factors: inv_sqrt = S S^T with S = Q diag(lambda^-1/4)
+    std::vector<double> inv_sqrt(p * p, 0.0);
+    runtime::parallel_for(runtime::default_pool(), p, 4, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const double* si = &scaled[i * p];
+            for (size_t j = 0; j < p; ++j) {
+                const double* sj = &scaled[j * p];
+                double dot = 0.0;
+                for (size_t c = 0; c < p; ++c) {
+                    dot += si[c] * sj[c];
+                }
+                inv_sqrt[i * p + j] = dot;
+            }
+        }
+    });
+
+    std::vector<double> out(p * q, 0.0);
+    runtime::parallel_for(runtime::default_pool(), p, 4, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            double* dst = &out[i * q];
+            for (size_t k = 0; k < p; ++k) {
+                const double v = inv_sqrt[i * p + k];
+                const double* src = &a[k * q];
+                for (size_t c = 0; c < q; ++c) {
+                    dst[c] += v * src[c];
+                }
+            }
+        }
+    });
+    return out;
+}
+
+std::vector<double> transposed(const std::vector<double>& a, size_t rows, size_t cols) {
+    std::vector<double> out(a.size());
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            out[j * rows + i] = a[i * cols + j];
+        }
+    }
+    return out;
+}
+
+}  // anonymous namespace
+
+LinearMap::LinearMap(size_t source_dim, size_t target_dim)
+    : source_dim_(source_dim), target_dim_(target_dim) {
+    if (source_dim == 0 || target_dim == 0) {
+        throw std::invalid_argument("dimensions must be positive");
+    }
+}
+
+LinearMap::LinearMap(size_t source_dim, size_t target_dim, std::vector<float> matrix)
+    : LinearMap(source_dim, target_dim) {
+    if (matrix.size() != source_dim * target_dim) {
+        throw std::invalid_argument("matrix: expected target_dim * source_dim values");
+    }
+    matrix_ = std::move(matrix);
+}
+
+LinearMap::LinearMap(const LinearMap& other)
+    : source_dim_(other.source_dim_), target_dim_(other.target_dim_) {
+    std::shared_lock<std::shared_mutex> lock(other.mutex_);
+    matrix_ = other.matrix_;
+}
+
+bool LinearMap::fitted() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return !matrix_.empty();
+}
+
+std::vector<float> LinearMap::matrix() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return matrix_;
+}
+
+void LinearMap::check_fitted() const {
+    if (matrix_.empty()) {
+        throw std::runtime_error("linear map is not fitted");
+    }
+}
+
+void LinearMap::fit(const StridedMatrix<double>& source, const StridedMatrix<double>& target,
+                    const FitOptions& options) {
+    if (source.cols != source_dim_ || target.cols != target_dim_) {
+        throw std::invalid_argument("expected source_dim and target_dim columns");
+    }
+    if (source.rows != target.rows) {
+        throw std::invalid_argument("source and target need the same number of rows");
+    }
+    const size_t n = source.rows;
+    if (n < 2) {
+        throw std::invalid_argument("need at least 2 training pairs");
+    }
+    const size_t ds = source_dim_;
+    const size_t dt = target_dim_;
+
+    const std::vector<float> x = normalized_rows(source);
+    const std::vector<float> y = normalized_rows(target);
+
+    // cross = X^T Y (ds x dt); the fitted W^T has the same shape
+    std::vector<double> cross(ds * dt);
+    linalg::multiply_transposed(x.data(), n, ds, y.data(), dt, cross.data());
+
+    std::vector<double> wt;
+    if (options.method == FitMethod::Procrustes) {
+        wt = ds <= dt ? polar_factor(cross, ds, dt)
+                      : transposed(polar_factor(transposed(cross, ds, dt), dt, ds), dt, ds);
+    } else {
+        std::vector<double> gram(ds * ds);
+        linalg::multiply_transposed(x.data(), n, ds, x.data(), ds, gram.data());
+        double trace = 0.0;
+        for (size_t i = 0; i < ds; ++i) {
+            trace += gram[i * ds + i];
+        }
+        const double penalty = std::max(options.ridge, 0.0) * trace / static_cast<double>(ds);
+        for (size_t i = 0; i < ds; ++i) {
+            gram[i * ds + i] += penalty;
+        }
+        if (!linalg::cholesky_solve(gram, ds, cross.data(), dt)) {
+            throw std::runtime_error(
+                "least squares system is not positive definite; increase ridge");
+        }
+        wt = std::move(cross);
+    }
+
+    std::vector<float> matrix(dt * ds);
+    for (size_t s = 0; s < ds; ++s) {
+        for (size_t t = 0; t < dt; ++t) {
+            matrix[t * ds + s] = static_cast<float>(wt[s * dt + t]);
+        }
+    }
+    // The solve above only reads the sample; readers block for the swap alone
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    matrix_ = std::move(matrix);
+}
+
+void LinearMap::apply_into(const StridedMatrix<double>& data, bool normalize,
+                           double* output) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    apply_rows(data, normalize, output);
+}
+
+void LinearMap::apply_rows(const StridedMatrix<double>& data, bool normalize,
+                           double* output) const {
+    check_fitted();
+    if (data.cols != source_dim_) {
+        throw std::invalid_argument("data: expected " + std::to_string(source_dim_) + " columns");
+    }
+    const size_t ds = source_dim_;
+    const size_t dt = target_dim_;
+    runtime::parallel_for(runtime::default_pool(), data.rows, 64, [&](size_t begin, size_t end) {
+        std::vector<float> x(linalg::ROW_BLOCK * ds);
+        std::vector<float> mapped(linalg::ROW_BLOCK * dt);
+        for (size_t r = begin; r < end; r += linalg::ROW_BLOCK) {
+            const size_t rows = std::min(linalg::ROW_BLOCK, end - r);
+            for (size_t b = 0; b < rows; ++b) {
+                const auto row = data.row(r + b);
+                const double inv = inverse_norm(row, ds);
+                for (size_t d = 0; d < ds; ++d) {
+                    x[b * ds + d] = static_cast<float>(row[d] * inv);
+                }
+            }
+            linalg::multiply_rows(x.data(), rows, matrix_.data(), ds, dt, mapped.data());
+            for (size_t b = 0; b < rows; ++b) {
+                const float* src = &mapped[b * dt];
+                double* dst = output + (r + b) * dt;
+                double scale = 1.0;
+                if (normalize) {
+                    double norm_sq = 0.0;
+                    for (size_t t = 0; t < dt; ++t) {
+                        norm_sq += static_cast<double>(src[t]) * src[t];
+                    }
+                    scale = norm_sq > 1e-20 ? 1.0 / std::sqrt(norm_sq) : 0.0;
+                }
+                for (size_t t = 0; t < dt; ++t) {
+                    dst[t] = src[t] * scale;
+                }
+            }
+        }
+    });
+}
+
+MapQuality LinearMap::evaluate(const StridedMatrix<double>& source,
+                               const StridedMatrix<double>& target, size_t k, size_t queries,
+                               uint64_t seed) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    check_fitted();
+    if (target.cols != target_dim_) {
+        throw std::invalid_argument("target: expected " + std::to_string(target_dim_) + " columns");
+    }
+    if (source.rows != target.rows) {
+        throw std::invalid_argument("source and target need the same number of rows");
+    }
+    const size_t n = source.rows;
+    if (k == 0 || n <= k) {
+        throw std::invalid_argument("need more than k pairs");
+    }
+    const size_t dt = target_dim_;
+
+    std::vector<double> mapped(n * dt);
+    apply_rows(source, true, mapped.data());
+    const StridedMatrix<double> mapped_view(mapped.data(), n, dt);
+
+    MapQuality quality;
+    quality.pairs = n;
+    quality.k = k;
+    quality.min_cosine = std::numeric_limits<double>::infinity();
+    double cosine_sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const auto row = target.row(i);
+        const double inv = inverse_norm(row, dt);
+        double dot = 0.0;
+        for (size_t t = 0; t < dt; ++t) {
+            dot += mapped[i * dt + t] * row[t];
+        }
+        const double cosine = dot * inv;
+        cosine_sum += cosine;
+        quality.min_cosine = std::min(quality.min_cosine, cosine);
+    }
+    quality.mean_cosine = cosine_sum / static_cast<double>(n);
+
+    std::mt19937_64 rng(seed);
+    std::vector<size_t> rows(n);
+    std::iota(rows.begin(), rows.end(), size_t{0});
+    queries = std::min(queries, n);
+    for (size_t i = 0; i < queries; ++i) {
+        std::swap(rows[i], rows[i + rng() % (n - i)]);
+    }
+    rows.resize(queries);
+    std::sort(rows.begin(), rows.end());
+
+    std::vector<double> overlap(queries, 0.0);
+    std::vector<uint8_t> hit(queries, 0);
+    runtime::parallel_for(runtime::default_pool(), queries, 1, [&](size_t begin, size_t end) {
+        std::vector<double> scores(n);
+        const MutableStridedView<double> out(scores.data());
+        for (size_t qi = begin; qi < end; ++qi) {
+            const size_t row = rows[qi];
+            vector_ops::cosine_similarity_batch_into(target.row(row), target, out);
+            scores[row] = -std::numeric_limits<double>::infinity();
+            const auto exact = accuracy::top_k(StridedView<double>(scores.data()), n, k);
+
+            vector_ops::cosine_similarity_batch_into(mapped_view.row(row), mapped_view, out);
+            scores[row] = -std::numeric_limits<double>::infinity();
+            const auto approx = accuracy::top_k(StridedView<double>(scores.data()), n, k);
+            overlap[qi] = accuracy::recall_at_k(approx.data(), approx.size(), exact.data(),
+                                                exact.size(), k);
+
+            vector_ops::cosine_similarity_batch_into(mapped_view.row(row), target, out);
+            const auto nearest = accuracy::top_k(StridedView<double>(scores.data()), n, 1);
+            hit[qi] = !nearest.empty() && static_cast<size_t>(nearest[0]) == row;
+        }
+    });
+
+    quality.queries = queries;
+    if (queries) {
+        quality.neighbor_overlap =
+            std::accumulate(overlap.begin(), overlap.end(), 0.0) / static_cast<double>(queries);
+        quality.top1 = static_cast<double>(std::count(hit.begin(), hit.end(), uint8_t{1})) /
+                       static_cast<double>(queries);
+    }
+    return quality;
+}
+
+}  // namespace mapping
+}  // namespace axnmihn
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <vector>
+
+#include "strided.hpp"
+
+namespace axnmihn {
+namespace mapping {
+
+enum class FitMethod {
+    Procrustes,    // Best (semi-)orthogonal map: keeps angles between mapped vectors
+    LeastSquares,  // Ridge-regularised unconstrained map
+};
+
+struct FitOptions {
+    FitMethod method = FitMethod::Procrustes;
+    double ridge = 1e-3;  // Least squares: penalty relative to the mean diagonal of X^T X
+};
+
+/**
+ * How well a map reproduces the target model on held-out pairs, see
+ * LinearMap::evaluate.
+ */
+struct MapQuality {
+    size_t pairs = 0;
+    size_t queries = 0;
+    size_t k = 0;
+    double mean_cosine = 0.0;       // Mean cos(map(x_i), y_i)
+    double min_cosine = 0.0;        // Worst pair
+    double neighbor_overlap = 0.0;  // Mean |kNN among mapped ∩ kNN among targets| / k
+    double top1 = 0.0;              // Share of queries whose nearest target is their own pair
+};
+
+/**
+ * Linear map between two embedding spaces, for moving a store to a new
+ * embedding model without re-embedding every memory.
+ *
+ * Fitted on a sample embedded with both models (rows L2-normalised), the
+ * map W (target_dim x source_dim) sends x to W x. Procrustes solves
+ * min ||X W^T - Y|| over (semi-)orthogonal W as the polar factor of
+ * X^T Y; least squares solves the ridge normal equations by Cholesky.
+ * A sample with fewer rows than dimensions leaves directions outside its
+ * span unmapped (Procrustes) or shrunk towards zero (least squares).
+ *
+ * Thread-safe: fit() swaps in the new matrix under an exclusive lock,
+ * apply_into() and evaluate() read it under a shared lock.
+ */
+class LinearMap {
+public:
+    LinearMap(size_t source_dim, size_t target_dim);
+
+    /**
+     * Restore a fitted map from matrix().
+     *
+     * Args:
+     *     matrix: target_dim x source_dim values
+     */
+    LinearMap(size_t source_dim, size_t target_dim, std::vector<float> matrix);
+
+    LinearMap(const LinearMap& other);
+
+    /**
+     * Fit the map to paired rows.
+     *
+     * Args:
+     *     source: Sample in the source space (n x source_dim)
+     *     target: The same texts in the target space (n x target_dim)
+     *     options: Method and ridge penalty
+     */
+    void fit(const StridedMatrix<double>& source, const StridedMatrix<double>& target,
+             const FitOptions& options = FitOptions());
+
+    bool fitted() const;
+    size_t source_dim() const { return source_dim_; }
+    size_t target_dim() const { return target_dim_; }
+
+    /** W as target_dim x source_dim values. */
+    std::vector<float> matrix() const;
+
+    /**
+     * Map rows in blocks on the thread pool.
+     *
+     * Args:
+     *     data: Source rows (n x source_dim), normalised before mapping
+     *     normalize: L2-normalise each mapped row
+     *     output: n x target_dim values
+     */
+    void apply_into(const StridedMatrix<double>& data, bool normalize, double* output) const;
+
+    /**
+     * Compare mapped rows with their true target embeddings.
+     *
+     * `queries` pairs sampled with `seed` are searched among the mapped
+     * rows and among the target rows (excluding themselves); the overlap
+     * of the two top-k lists is the neighbour overlap@k.
+     *
+     * Args:
+     *     source: Held-out source rows (n x source_dim), n > k
+     *     target: Their target rows (n x target_dim)
+     *     k: Neighbours per query
+     *     queries: Number of queries (capped at n)
+     *     seed: Query sampling seed
+     */
+    MapQuality evaluate(const StridedMatrix<double>& source, const StridedMatrix<double>& target,
+                        size_t k = 10, size_t queries = 200, uint64_t seed = 0) const;
+
+private:
+    // Callers hold mutex_
+    void check_fitted() const;
+    void apply_rows(const StridedMatrix<double>& data, bool normalize, double* output) const;
+
+    size_t source_dim_;
+    size_t target_dim_;
+    std::vector<float> matrix_;
+    mutable std::shared_mutex mutex_;
+};
+
+}  // namespace mapping
+}  // namespace axnmihn
@@ -0,0 +1,499 @@
+#include "memory_engine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+
+#include "accuracy.hpp"
+#include "arena.hpp"
+#include "thread_pool.hpp"
+#include "vector_ops.hpp"
+
+namespace axnmihn {
+namespace engine {
+
+namespace {
+
+// Rows scored per parallel_for chunk during the similarity scan
+constexpr size_t SCAN_CHUNK = 2048;
+
+// FNV-1a, stable across runs so term hashes never depend on std::hash
+uint64_t hash_term(const std::string& term) {
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : term) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Re-score the eligible rows with double accumulation and record the
+// float32 scan's similarity error and recall@k under "engine.scan".
+// `eligible` holds the scan's own top-k in its first k slots.
+void sample_scan_accuracy(const float* query, const float* embeddings, size_t dim,
+                          const uint32_t* eligible, size_t n, size_t k,
+                          const float* similarity) {
+    std::vector<double> approx(n), exact(n);
+    for (size_t i = 0; i < n; ++i) {
+        const float* row = embeddings + static_cast<size_t>(eligible[i]) * dim;
+        double dot = 0.0;
+        for (size_t d = 0; d < dim; ++d) {
+            dot += static_cast<double>(query[d]) * static_cast<double>(row[d]);
+        }
+        approx[i] = similarity[eligible[i]];
+        exact[i] = dot;
+    }
+    std::vector<int64_t> selected(k);
+    for (size_t i = 0; i < k; ++i) {
+        selected[i] = static_cast<int64_t>(i);
+    }
+    const std::vector<int64_t> truth = accuracy::top_k(exact.data(), n, k);
+    accuracy::record_error("engine.scan", accuracy::compare_values(approx.data(), exact.data(), n));
+    accuracy::record_recall("engine.scan",
+        accuracy::recall_at_k(selected.data(), k, truth.data(), truth.size(), k));
+}
+
+bool is_term_byte(unsigned char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+           (c >= 'A' && c <= 'Z') || c >= 0x80;
+}
+
+struct Candidate {
+    uint32_t row;
+    double similarity = 0.0;
+    double text_score = 0.0;
+    double graph_bonus = 0.0;
+    double score = 0.0;
+};
+
+}  // anonymous namespace
+
+std::vector<uint64_t> keyword_terms(const std::string& text) {
+    std::vector<uint64_t> terms;
+    std::string term;
+    for (size_t i = 0; i <= text.size(); ++i) {
+        unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : ' ';
+        if (is_term_byte(c)) {
+            term += (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : static_cast<char>(c);
+        } else if (!term.empty()) {
+            terms.push_back(hash_term(term));
+            term.clear();
+        }
+    }
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+    return terms;
+}
+
+MemoryEngine::MemoryEngine(size_t dim) : dim_(dim) {
+    if (dim == 0) {
+        throw std::invalid_argument("dim must be positive");
+    }
+}
+
+size_t MemoryEngine::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return live_count_;
+}
+
+void MemoryEngine::set_decay_config(const decay::DecayConfig& config) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    decay_config_ = config;
+}
+
+decay::DecayConfig MemoryEngine::decay_config() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return decay_config_;
+}
+
+void MemoryEngine::upsert(
+    const std::string& id,
+    StridedView<double> embedding,
+    const MemoryAttributes& attrs
+) {
+    upsert_row(id, embedding, attrs);
+}
+
+void MemoryEngine::upsert(
+    const std::string& id,
+    StridedView<float> embedding,
+    const MemoryAttributes& attrs
+) {
+    upsert_row(id, embedding, attrs);
+}
+
+template<typename T>
+void MemoryEngine::upsert_row(
+    const std::string& id,
+    StridedView<T> embedding,
+    const MemoryAttributes& attrs
+) {
+    double norm_sq = 0.0;
+    for (size_t d = 0; d < dim_; ++d) {
+        const double v = embedding[d];
+        norm_sq += v * v;
+    }
+    const double inv_norm = norm_sq > 1e-20 ? 1.0 / std::sqrt(norm_sq) : 0.0;
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    uint32_t row;
+    auto it = id_to_row_.find(id);
+    if (it != id_to_row_.end()) {
+        row = it->second;
+    } else {
+        row = static_cast<uint32_t>(ids_.size());
+        ids_.push_back(id);
+        id_to_row_.emplace(id, row);
+        live_.push_back(1);
+        hot_.push_back(0);
+        attrs_.emplace_back();
+        text_costs_.push_back(0);
+        row_topics_.emplace_back();
+        row_terms_.emplace_back();
+        embeddings_.resize(embeddings_.size() + dim_);
+        ++live_count_;
+    }
+
+    float* dst = &embeddings_[static_cast<size_t>(row) * dim_];
+    for (size_t d = 0; d < dim_; ++d) {
+        dst[d] = static_cast<float>(embedding[d] * inv_norm);
+    }
+    attrs_[row] = attrs;
+}
+
+bool MemoryEngine::remove(const std::string& id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = id_to_row_.find(id);
+    if (it == id_to_row_.end()) {
+        return false;
+    }
+    uint32_t row = it->second;
+    unindex_text(row);
+    text_costs_[row] = 0;
+    live_[row] = 0;
+    hot_[row] = 0;
+    row_topics_[row].clear();
+    id_to_row_.erase(it);
+    --live_count_;
+    return true;
+}
+
+bool MemoryEngine::contains(const std::string& id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return id_to_row_.count(id) != 0;
+}
+
+void MemoryEngine::unindex_text(uint32_t row) {
+    for (uint64_t term : row_terms_[row]) {
+        auto posting = postings_.find(term);
+        if (posting == postings_.end()) {
+            continue;
+        }
+        auto& rows = posting->second;
+        rows.erase(std::remove(rows.begin(), rows.end(), row), rows.end());
+        if (rows.empty()) {
+            postings_.erase(posting);
+        }
+    }
+    row_terms_[row].clear();
+}
+
+void MemoryEngine::index_text(const std::string& id, const std::string& text) {
+    auto terms = keyword_terms(text);
+    // Code points, matching len(content) // 4 on the Python side
+    size_t chars = 0;
+    for (unsigned char ch : text) {
+        chars += (ch & 0xC0) != 0x80;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = id_to_row_.find(id);
+    if (it == id_to_row_.end()) {
+        throw std::out_of_range("unknown memory id: " + id);
+    }
+    uint32_t row = it->second;
+    unindex_text(row);
+    for (uint64_t term : terms) {
+        postings_[term].push_back(row);
+    }
+    row_terms_[row] = std::move(terms);
+    text_costs_[row] = static_cast<int32_t>(std::max<size_t>(1, chars / 4));
+}
+
+uint32_t MemoryEngine::entity_index(const std::string& name) {
+    auto it = entity_ids_.find(name);
+    if (it != entity_ids_.end()) {
+        return it->second;
+    }
+    uint32_t idx = static_cast<uint32_t>(entity_adjacency_.size());
+    entity_ids_.emplace(name, idx);
+    entity_adjacency_.emplace_back();
+    entity_rows_.emplace_back();
+    return idx;
+}
+
+void MemoryEngine::link_entity(const std::string& memory_id, const std::string& entity) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = id_to_row_.find(memory_id);
+    if (it == id_to_row_.end()) {
+        throw std::out_of_range("unknown memory id: " + memory_id);
+    }
+    auto& rows = entity_rows_[entity_index(entity)];
+    if (std::find(rows.begin(), rows.end(), it->second) == rows.end()) {
+        rows.push_back(it->second);
+    }
+}
+
+void MemoryEngine::add_relation(const std::string& source, const std::string& target) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    uint32_t a = entity_index(source);
+    uint32_t b = entity_index(target);
+    if (a == b) {
+        return;
+    }
+    auto& adj_a = entity_adjacency_[a];
+    if (std::find(adj_a.begin(), adj_a.end(), b) == adj_a.end()) {
+        adj_a.push_back(b);
+        entity_adjacency_[b].push_back(a);
+    }
+}
+
+void MemoryEngine::set_topics(const std::string& memory_id, const std::vector<std::string>& topics) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = id_to_row_.find(memory_id);
+    if (it == id_to_row_.end()) {
+        throw std::out_of_range("unknown memory id: " + memory_id);
+    }
+    auto& row_topics = row_topics_[it->second];
+    row_topics.clear();
+    for (const auto& topic : topics) {
+        auto inserted = topic_ids_.emplace(topic, static_cast<uint32_t>(topic_ids_.size()));
+        row_topics.push_back(inserted.first->second);
+    }
+    std::sort(row_topics.begin(), row_topics.end());
+    row_topics.erase(std::unique(row_topics.begin(), row_topics.end()), row_topics.end());
+}
+
+void MemoryEngine::set_hot(const std::vector<std::string>& ids) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    std::fill(hot_.begin(), hot_.end(), 0);
+    for (const auto& id : ids) {
+        auto it = id_to_row_.find(id);
+        if (it != id_to_row_.end()) {
+            hot_[it->second] = 1;
+        }
+    }
+}
+
+ContextSelection MemoryEngine::build_context(
+    StridedView<double> query,
+    const std::vector<std::string>& query_entities,
+    int64_t budget,
+    double now,
+    const BuildFilters& filters
+) const {
+    ContextSelection selection;
+    if (budget <= 0) {
+        return selection;
+    }
+
+    // Normalised float32 query so the scan is a plain dot product
+    // Scan temporaries come from the thread arena
+    alloc::ArenaScope scope;
+    float* q = scope.array<float>(dim_);
+    double norm_sq = 0.0;
+    for (size_t d = 0; d < dim_; ++d) {
+        norm_sq += query[d] * query[d];
+    }
+    const bool has_query = norm_sq > 1e-20;
+    const double inv_norm = has_query ? 1.0 / std::sqrt(norm_sq) : 0.0;
+    for (size_t d = 0; d < dim_; ++d) {
+        q[d] = static_cast<float>(query[d] * inv_norm);
+    }
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    const size_t n_rows = ids_.size();
+    auto type_allowed = [&](uint32_t row) {
+        int type = attrs_[row].memory_type;
+        return type >= 0 && type < 32 && ((filters.memory_type_mask >> type) & 1u);
+    };
+
+    // 1. Similarity scan over every live row
+    float* similarity = scope.array<float>(n_rows);
+    std::fill(similarity, similarity + n_rows, 0.0f);
+    if (has_query) {
+        runtime::parallel_for(runtime::default_pool(), n_rows, SCAN_CHUNK,
+            [&](size_t begin, size_t end) {
+                for (size_t r = begin; r < end; ++r) {
+                    if (live_[r]) {
+                        similarity[r] = vector_ops::dot_product_f32(
+                            q, &embeddings_[r * dim_], dim_);
+                    }
+                }
+            });
+    }
+
+    std::unordered_map<uint32_t, Candidate> candidates;
+    auto candidate = [&](uint32_t row) -> Candidate& {
+        auto inserted = candidates.emplace(row, Candidate{row});
+        if (inserted.second) {
+            inserted.first->second.similarity = similarity[row];
+        }
+        return inserted.first->second;
+    };
+
+    // 2. Top-K vector candidates
+    if (has_query && filters.candidate_count > 0) {
+        alloc::ArenaVector<uint32_t> order{alloc::ArenaAllocator<uint32_t>(scope.arena())};
+        order.reserve(live_count_);
+        for (uint32_t r = 0; r < n_rows; ++r) {
+            if (live_[r] && type_allowed(r) && similarity[r] >= filters.min_similarity) {
+                order.push_back(r);
+            }
+        }
+        size_t k = std::min(filters.candidate_count, order.size());
+        std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(k), order.end(),
+            [&](uint32_t a, uint32_t b) {
+                return similarity[a] > similarity[b] || (similarity[a] == similarity[b] && a < b);
+            });
+        for (size_t i = 0; i < k; ++i) {
+            candidate(order[i]);
+        }
+        if (k > 0 && accuracy::should_sample()) {
+            sample_scan_accuracy(q, embeddings_.data(), dim_, order.data(), order.size(), k, similarity);
+        }
+    }
+
+    // 3. Graph expansion: BFS over entities, bonus halves per hop
+    if (!query_entities.empty() && filters.graph_depth >= 0) {
+        std::vector<int> hop(entity_adjacency_.size(), -1);
+        std::deque<uint32_t> frontier;
+        for (const auto& name : query_entities) {
+            auto it = entity_ids_.find(name);
+            if (it != entity_ids_.end() && hop[it->second] < 0) {
+                hop[it->second] = 0;
+                frontier.push_back(it->second);
+            }
+        }
+        while (!frontier.empty()) {
+            uint32_t entity = frontier.front();
+            frontier.pop_front();
+            const double bonus = filters.graph_weight / static_cast<double>(1 << std::min(hop[entity], 30));
+            for (uint32_t row : entity_rows_[entity]) {
+                if (live_[row] && type_allowed(row)) {
+                    Candidate& c = candidate(row);
+                    c.graph_bonus = std::max(c.graph_bonus, bonus);
+                }
+            }
+            if (hop[entity] >= filters.graph_depth) {
+                continue;
+            }
+            for (uint32_t next : entity_adjacency_[entity]) {
+                if (hop[next] < 0) {
+                    hop[next] = hop[entity] + 1;
+                    frontier.push_back(next);
+                }
+            }
+        }
+    }
+
+    // 4. Keyword matches: fraction of query terms present
+    if (filters.text_weight > 0.0 && !filters.query_text.empty()) {
+        auto terms = keyword_terms(filters.query_text);
+        if (!terms.empty()) {
+            std::unordered_map<uint32_t, int> matches;
+            for (uint64_t term : terms) {
+                auto posting = postings_.find(term);
+                if (posting == postings_.end()) {
+                    continue;
+                }
+                for (uint32_t row : posting->second) {
+                    if (live_[row] && type_allowed(row)) {
+                        ++matches[row];
+                    }
+                }
+            }
+            for (const auto& match : matches) {
+                candidate(match.first).text_score =
+                    static_cast<double>(match.second) / static_cast<double>(terms.size());
+            }
+        }
+    }
+
+    // 5. Score: relevance * decay * importance weight, then boosts
+    const bool temporal = !std::isnan(filters.time_from) || !std::isnan(filters.time_to);
+    std::vector<Candidate> ranked;
+    ranked.reserve(candidates.size());
+    for (auto& entry : candidates) {
+        Candidate c = entry.second;
+        const MemoryAttributes& a = attrs_[c.row];
+
+        double relevance = (1.0 - filters.text_weight) * c.similarity +
+                           filters.text_weight * c.text_score;
+
+        decay::DecayInput input{
+            1.0,
+            a.event_time > 0.0 ? std::max(0.0, (now - a.event_time) / 3600.0) : 0.0,
+            a.access_count,
+            a.connection_count,
+            a.last_accessed >= 0.0 ? std::max(0.0, (now - a.last_accessed) / 3600.0) : -1.0,
+            a.memory_type,
+            a.channel_mentions,
+        };
+        double importance = std::min(1.0, std::max(0.0, a.importance));
+        double score = relevance * decay::calculate(input, decay_config_) * (0.5 + 0.5 * importance);
+
+        if (temporal && a.event_time > 0.0 &&
+            (std::isnan(filters.time_from) || a.event_time >= filters.time_from) &&
+            (std::isnan(filters.time_to) || a.event_time <= filters.time_to)) {
+            score = score * (1.0 - filters.temporal_factor) +
+                    filters.temporal_target * filters.temporal_factor;
+        }
+        if (hot_[c.row]) {
+            score += filters.hot_boost;
+        }
+        c.score = score + c.graph_bonus;
+        ranked.push_back(c);
+    }
+    selection.candidates = ranked.size();
+
+    std::sort(ranked.begin(), ranked.end(), [](const Candidate& a, const Candidate& b) {
+        return a.score > b.score || (a.score == b.score && a.row < b.row);
+    });
+
+    // 6. Greedy budget packing with a per-topic cap
+    std::unordered_map<uint32_t, int> topic_counts;
+    for (const Candidate& c : ranked) {
+        const int32_t known = attrs_[c.row].token_cost;
+        const int64_t cost = known > 0 ? known : text_costs_[c.row];
+        if (cost <= 0 || selection.tokens_used + cost > budget) {
+            continue;
+        }
+        if (filters.max_per_topic > 0) {
+            const auto& topics = row_topics_[c.row];
+            bool capped = std::any_of(topics.begin(), topics.end(), [&](uint32_t t) {
+                auto it = topic_counts.find(t);
+                return it != topic_counts.end() && it->second >= filters.max_per_topic;
+            });
+            if (capped) {
+                continue;
+            }
+            for (uint32_t t : topics) {
+                ++topic_counts[t];
+            }
+        }
+        selection.ids.push_back(ids_[c.row]);
+        selection.scores.push_back(c.score);
+        selection.token_costs.push_back(static_cast<int32_t>(cost));
+        selection.tokens_used += cost;
+    }
+
+    return selection;
+}
+
+}  // namespace engine
+}  // namespace axnmihn
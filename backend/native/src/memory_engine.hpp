@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "decay.hpp"
+#include "strided.hpp"
+
+namespace axnmihn {
+namespace engine {
+
+/**
+ * Per-memory attributes stored alongside the embedding.
+ *
+ * Timestamps are epoch seconds so build_context can derive ages from a
+ * single `now` without Python recomputing hours for every memory.
+ */
+struct MemoryAttributes {
+    double importance = 0.5;      // Stored importance (0-1)
+    double event_time = 0.0;      // event_timestamp/created_at (<= 0 if unknown)
+    double last_accessed = -1.0;  // Last access (< 0 if never)
+    int access_count = 0;
+    int connection_count = 0;
+    int memory_type = 0;          // 0=conversation, 1=fact, 2=preference, 3=insight
+    int channel_mentions = 0;
+    int token_cost = 0;           // Estimated prompt tokens (len(content) // 4), <= 0 if unknown
+};
+
+/**
+ * Scoring and selection knobs for build_context.
+ *
+ * Defaults mirror MemoryRetriever.query and MemGPT.context_budget_select.
+ */
+struct BuildFilters {
+    size_t candidate_count = 20;         // Top-K by embedding similarity
+    double min_similarity = 0.0;         // Drop vector candidates below this
+    uint32_t memory_type_mask = 0xF;     // Bit per memory type to include
+
+    // Temporal boost: score = score * (1 - factor) + target * factor
+    double time_from = std::numeric_limits<double>::quiet_NaN();
+    double time_to = std::numeric_limits<double>::quiet_NaN();
+    double temporal_target = 0.8;        // 1.0 for exact-date queries
+    double temporal_factor = 0.4;
+
+    double hot_boost = 0.1;              // Added for memories marked hot
+
+    int graph_depth = 1;                 // Entity hops from query_entities
+    double graph_weight = 0.1;           // Bonus at hop 0, halved per hop
+
+    std::string query_text;              // Keyword query for the text index
+    double text_weight = 0.0;            // Blend: (1-w)*vector + w*keyword
+
+    int max_per_topic = 0;               // Diversity cap (0 = unlimited)
+};
+
+/**
+ * Result of build_context, ordered by descending score.
+ */
+struct ContextSelection {
+    std::vector<std::string> ids;
+    std::vector<double> scores;
+    std::vector<int32_t> token_costs;
+    int64_t tokens_used = 0;
+    size_t candidates = 0;               // Candidates scored before packing
+};
+
+/**
+ * Native memory store: embeddings, decay columns, entity graph and a
+ * keyword index in one object, so a turn's candidate pipeline
+ * (retrieve -> graph expand -> decay -> budget pack) is one call.
+ *
+ * Embeddings are kept L2-normalised in float32. Rows are append-only;
+ * remove() tombstones a row and upsert() of an existing id overwrites it
+ * in place. build_context takes a shared lock and may run concurrently
+ * with other readers; mutations take an exclusive lock.
+ */
+class MemoryEngine {
+public:
+    explicit MemoryEngine(size_t dim);
+
+    size_t dim() const { return dim_; }
+
+    /** Number of live (non-removed) memories. */
+    size_t size() const;
+
+    void set_decay_config(const decay::DecayConfig& config);
+    decay::DecayConfig decay_config() const;
+
+    /**
+     * Insert a memory or overwrite an existing one with the same id.
+     *
+     * Args:
+     *     id: Memory id
+     *     embedding: View of `dim` values
+     *     attrs: Decay and packing attributes
+     */
+    void upsert(const std::string& id, StridedView<double> embedding, const MemoryAttributes& attrs);
+    void upsert(const std::string& id, StridedView<float> embedding, const MemoryAttributes& attrs);
+
+    /** Tombstone a memory. Returns false if the id is unknown. */
+    bool remove(const std::string& id);
+
+    bool contains(const std::string& id) const;
+
+    /**
+     * Replace the keyword index entry for a memory (text is not stored).
+     * The text length also estimates the token cost of rows upserted
+     * without one.
+     */
+    void index_text(const std::string& id, const std::string& text);
+
+    /** Link a memory to an entity; the entity is created on first use. */
+    void link_entity(const std::string& memory_id, const std::string& entity);
+
+    /** Add an undirected edge between two entities. */
+    void add_relation(const std::string& source, const std::string& target);
+
+    /** Replace the topic set used by the diversity cap. */
+    void set_topics(const std::string& memory_id, const std::vector<std::string>& topics);
+
+    /** Replace the set of hot (working-set) memories. Unknown ids are ignored. */
+    void set_hot(const std::vector<std::string>& ids);
+
+    /**
+     * Run the candidate pipeline and pack the best memories into a budget.
+     *
+     * Candidates are the top filters.candidate_count rows by cosine
+     * similarity, plus memories linked to entities within graph_depth hops
+     * of query_entities, plus keyword matches when text_weight > 0.
+     * Each candidate is scored as
+     *
+     *     relevance * decay(1.0, ...) * (0.5 + 0.5 * importance)
+     *
+     * then boosted (temporal window, graph hop, hot set) and packed greedily
+     * by score into `budget` tokens, skipping items that do not fit and
+     * enforcing max_per_topic. A row's cost is its token_cost, else the
+     * estimate from index_text(); rows with neither are never packed, so
+     * an unknown cost cannot slip past the budget. Calls picked by
+     * accuracy sampling also re-score the scan in double precision
+     * ("engine.scan").
+     *
+     * Args:
+     *     query: Query embedding view (dim values)
+     *     query_entities: Entity names to expand from
+     *     budget: Token budget (<= 0 returns nothing)
+     *     now: Current time in epoch seconds
+     *     filters: Scoring and selection options
+     *
+     * Returns:
+     *     Selected ids, scores and token costs in score order
+     */
+    ContextSelection build_context(
+        StridedView<double> query,
+        const std::vector<std::string>& query_entities,
+        int64_t budget,
+        double now,
+        const BuildFilters& filters
+    ) const;
+
+private:
+    template<typename T>
+    void upsert_row(const std::string& id, StridedView<T> embedding, const MemoryAttributes& attrs);
+    uint32_t entity_index(const std::string& name);
+    void unindex_text(uint32_t row);
+
+    size_t dim_;
+    decay::DecayConfig decay_config_;
+    mutable std::shared_mutex mutex_;
+
+    // Row storage (append-only, tombstoned by live_)
+    std::vector<std::string> ids_;
+    std::unordered_map<std::string, uint32_t> id_to_row_;
+    std::vector<uint8_t> live_;
+    std::vector<uint8_t> hot_;
+    std::vector<float> embeddings_;  // rows x dim, L2-normalised
+    std::vector<MemoryAttributes> attrs_;
+    std::vector<int32_t> text_costs_;  // len(text) // 4 from index_text (0 if none)
+    size_t live_count_ = 0;
+
+    // Diversity topics
+    std::unordered_map<std::string, uint32_t> topic_ids_;
+    std::vector<std::vector<uint32_t>> row_topics_;
+
+    // Entity graph
+    std::unordered_map<std::string, uint32_t> entity_ids_;
+    std::vector<std::vector<uint32_t>> entity_adjacency_;
+    std::vector<std::vector<uint32_t>> entity_rows_;
+
+    // Keyword index: term hash -> rows
+    std::unordered_map<uint64_t, std::vector<uint32_t>> postings_;
+    std::vector<std::vector<uint64_t>> row_terms_;
+};
+
+/**
+ * Split text into lower-cased keyword terms and hash them.
+ *
+ * Terms are runs of ASCII letters/digits or non-ASCII (e.g. Hangul)
+ * characters; everything else separates terms. Duplicates are removed.
+ */
+std::vector<uint64_t> keyword_terms(const std::string& text);
+
+}  // namespace engine
+}  // namespace axnmihn
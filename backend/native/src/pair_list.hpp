@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "buffer_pool.hpp"
+
+namespace axnmihn {
+
+/**
+ * Index pairs with a similarity score, stored as parallel columns.
+ *
+ * Pair-finding kernels fill the columns directly so the bindings can hand
+ * each one to NumPy as-is instead of building a Python tuple per pair.
+ * Columns come from the buffer pool, so their growth reuses buffers
+ * released by earlier results.
+ */
+struct PairList {
+    alloc::pooled_vector<int64_t> first;
+    alloc::pooled_vector<int64_t> second;
+    alloc::pooled_vector<double> similarity;
+
+    void add(size_t i, size_t j, double sim) {
+        first.push_back(static_cast<int64_t>(i));
+        second.push_back(static_cast<int64_t>(j));
+        similarity.push_back(sim);
+    }
+
+    size_t size() const { return first.size(); }
+};
+
+}  // namespace axnmihn
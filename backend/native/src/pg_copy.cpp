@@ -0,0 +1,329 @@
+#include "pg_copy.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+namespace axnmihn {
+namespace pgcopy {
+
+namespace {
+
+// "PGCOPY\n\377\r\n\0" followed by int32 flags and int32 extension length
+constexpr uint8_t SIGNATURE[11] = {'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xFF, '\r', '\n', 0};
+constexpr size_t HEADER_SIZE = sizeof(SIGNATURE) + 8;
+constexpr uint32_t FLAG_OIDS = 1u << 16;
+
+// timestamptz is microseconds since 2000-01-01 00:00:00 UTC
+constexpr double PG_EPOCH_OFFSET = 946684800.0;
+
+enum Field : size_t {
+    ID = 0,
+    MEMORY_TYPE,
+    IMPORTANCE,
+    ACCESS_COUNT,
+    CREATED_AT,
+    LAST_ACCESSED,
+    TOKEN_COST,
+    EMBEDDING,
+};
+
+const char* const FIELD_NAMES[] = {
+    "uuid", "memory_type", "importance", "access_count", "created_at", "last_accessed",
+    "token_cost", "embedding",
+};
+
+inline uint32_t load_be32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+inline uint64_t load_be64(const uint8_t* p) {
+    return (uint64_t(load_be32(p)) << 32) | load_be32(p + 4);
+}
+
+struct FieldRef {
+    const uint8_t* data = nullptr;  // nullptr for NULL
+    size_t size = 0;
+};
+
+void check_size(const FieldRef& field, size_t expected, size_t index) {
+    if (field.size != expected) {
+        throw std::invalid_argument(std::string(FIELD_NAMES[index]) + ": expected " +
+                                    std::to_string(expected) + " bytes, got " +
+                                    std::to_string(field.size) + " (check the column casts)");
+    }
+}
+
+double read_float8(const FieldRef& field, size_t index, double null_value) {
+    if (!field.data) {
+        return null_value;
+    }
+    check_size(field, 8, index);
+    const uint64_t bits = load_be64(field.data);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Epoch seconds; +/-infinity timestamps read like NULL
+double read_timestamptz(const FieldRef& field, size_t index, double null_value) {
+    if (!field.data) {
+        return null_value;
+    }
+    check_size(field, 8, index);
+    const auto micros = static_cast<int64_t>(load_be64(field.data));
+    if (micros == std::numeric_limits<int64_t>::max() ||
+        micros == std::numeric_limits<int64_t>::min()) {
+        return null_value;
+    }
+    return static_cast<double>(micros) / 1e6 + PG_EPOCH_OFFSET;
+}
+
+int32_t memory_type_code(std::string_view name) {
+    // Same mapping as DecayCalculator; unknown types decay like conversation
+    if (name == "fact") {
+        return 1;
+    }
+    if (name == "preference") {
+        return 2;
+    }
+    if (name == "insight") {
+        return 3;
+    }
+    return 0;
+}
+
+}  // anonymous namespace
+
+MemoryLoader::MemoryLoader(size_t dim, pgvector::WireType type)
+    : dim_(dim), type_(type), fields_(BASE_COLUMNS + (dim > 0 ? 1 : 0)) {
+    if (dim > pgvector::MAX_DIM) {
+        throw std::invalid_argument("dim exceeds the pgvector limit");
+    }
+    columns_.dim = dim;
+}
+
+size_t MemoryLoader::feed(const uint8_t* data, size_t len) {
+    size_t rows = 0;
+    if (pending_.empty()) {
+        // Decode in place and keep only an incomplete tail
+        const size_t used = parse(data, len, rows);
+        pending_.assign(data + used, data + len);
+        return rows;
+    }
+    pending_.insert(pending_.end(), data, data + len);
+    const size_t used = parse(pending_.data(), pending_.size(), rows);
+    pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(used));
+    return rows;
+}
+
+size_t MemoryLoader::parse(const uint8_t* data, size_t len, size_t& rows) {
+    size_t offset = 0;
+    if (!header_done_) {
+        offset = parse_header(data, len);
+        if (!header_done_) {
+            return 0;
+        }
+    }
+    while (offset < len) {
+        if (done_) {
+            throw std::invalid_argument("data after the COPY trailer");
+        }
+        const size_t used = parse_tuple(data + offset, len - offset);
+        if (used == 0) {
+            break;
+        }
+        offset += used;
+        if (!done_) {
+            ++rows;
+            ++total_rows_;
+        }
+    }
+    return offset;
+}
+
+size_t MemoryLoader::parse_header(const uint8_t* data, size_t len) {
+    const size_t check = std::min(len, sizeof(SIGNATURE));
+    if (std::memcmp(data, SIGNATURE, check) != 0) {
+        throw std::invalid_argument("not binary COPY data (bad signature)");
+    }
+    if (len < HEADER_SIZE) {
+        return 0;
+    }
+    const uint32_t flags = load_be32(data + sizeof(SIGNATURE));
+    if (flags & FLAG_OIDS) {
+        throw std::invalid_argument("COPY data with OIDs is not supported");
+    }
+    const size_t extension = load_be32(data + sizeof(SIGNATURE) + 4);
+    if (len < HEADER_SIZE + extension) {
+        return 0;
+    }
+    header_done_ = true;
+    return HEADER_SIZE + extension;
+}
+
+size_t MemoryLoader::parse_tuple(const uint8_t* data, size_t len) {
+    if (len < 2) {
+        return 0;
+    }
+    const auto count = static_cast<int16_t>((data[0] << 8) | data[1]);
+    if (count == -1) {
+        done_ = true;
+        return 2;
+    }
+    if (static_cast<size_t>(count) != fields_ || count < 0) {
+        throw std::invalid_argument("expected " + std::to_string(fields_) +
+                                    " columns per row, got " + std::to_string(count));
+    }
+
+    // Locate every field first so an incomplete tuple leaves no trace
+    FieldRef fields[BASE_COLUMNS + 1];
+    size_t offset = 2;
+    for (size_t f = 0; f < fields_; ++f) {
+        if (len - offset < 4) {
+            return 0;
+        }
+        const auto size = static_cast<int32_t>(load_be32(data + offset));
+        offset += 4;
+        if (size < 0) {
+            continue;  // NULL
+        }
+        if (len - offset < static_cast<size_t>(size)) {
+            return 0;
+        }
+        fields[f] = {data + offset, static_cast<size_t>(size)};
+        offset += static_cast<size_t>(size);
+    }
+
+    if (!fields[ID].data) {
+        throw std::invalid_argument("uuid must not be NULL");
+    }
+    int32_t access_count = 0;
+    if (fields[ACCESS_COUNT].data) {
+        check_size(fields[ACCESS_COUNT], 4, ACCESS_COUNT);
+        access_count = static_cast<int32_t>(load_be32(fields[ACCESS_COUNT].data));
+    }
+    int32_t token_cost = 0;
+    if (fields[TOKEN_COST].data) {
+        check_size(fields[TOKEN_COST], 4, TOKEN_COST);
+        token_cost = static_cast<int32_t>(load_be32(fields[TOKEN_COST].data));
+    }
+    const double importance = read_float8(fields[IMPORTANCE], IMPORTANCE, 0.5);
+    const double created_at = read_timestamptz(fields[CREATED_AT], CREATED_AT, 0.0);
+    const double last_accessed = read_timestamptz(fields[LAST_ACCESSED], LAST_ACCESSED, -1.0);
+
+    // Decode the embedding before appending so a bad value rejects the row
+    if (dim_ > 0) {
+        // NULL embeddings leave the zero row from resize()
+        const size_t base = columns_.embeddings.size();
+        columns_.embeddings.resize(base + dim_);
+        const FieldRef& embedding = fields[EMBEDDING];
+        if (embedding.data) {
+            try {
+                const size_t dim = pgvector::binary_dim(embedding.data, embedding.size, type_);
+                if (dim != dim_) {
+                    throw std::invalid_argument("expected " + std::to_string(dim_) +
+                                                " dimensions, got " + std::to_string(dim));
+                }
+                pgvector::decode_binary(embedding.data, embedding.size, type_,
+                                        columns_.embeddings.data() + base);
+            } catch (...) {
+                columns_.embeddings.resize(base);
+                throw;
+            }
+        }
+        columns_.has_embedding.push_back(embedding.data ? 1 : 0);
+    }
+
+    columns_.ids.emplace_back(reinterpret_cast<const char*>(fields[ID].data), fields[ID].size);
+    const FieldRef& type = fields[MEMORY_TYPE];
+    columns_.memory_type.push_back(
+        type.data ? memory_type_code(std::string_view(reinterpret_cast<const char*>(type.data),
+                                                      type.size))
+                  : 0);
+    columns_.importance.push_back(importance);
+    columns_.access_count.push_back(access_count);
+    columns_.created_at.push_back(created_at);
+    columns_.last_accessed.push_back(last_accessed);
+    columns_.token_cost.push_back(token_cost);
+    return offset;
+}
+
+void MemoryLoader::finish() const {
+    if (!done_) {
+        throw std::invalid_argument(header_done_ ? "COPY data ended before the trailer"
+                                                 : "COPY data ended before the header");
+    }
+}
+
+void MemoryLoader::reserve(size_t rows) {
+    columns_.ids.reserve(rows);
+    columns_.importance.reserve(rows);
+    columns_.created_at.reserve(rows);
+    columns_.last_accessed.reserve(rows);
+    columns_.access_count.reserve(rows);
+    columns_.memory_type.reserve(rows);
+    columns_.token_cost.reserve(rows);
+    if (dim_ > 0) {
+        columns_.has_embedding.reserve(rows);
+        columns_.embeddings.reserve(rows * dim_);
+    }
+}
+
+MemoryColumns MemoryLoader::take() {
+    MemoryColumns batch = std::move(columns_);
+    columns_ = MemoryColumns();
+    columns_.dim = dim_;
+    reserve(batch.rows());
+    return batch;
+}
+
+void decay_records(const MemoryColumns& columns, double now,
+                   StridedView<int32_t> connection_count, StridedView<int32_t> channel_mentions,
+                   decay::DecayRecord* out) {
+    constexpr double SECONDS_PER_HOUR = 3600.0;
+    for (size_t i = 0; i < columns.rows(); ++i) {
+        const double created = columns.created_at[i];
+        const double last = columns.last_accessed[i];
+        decay::DecayRecord& r = out[i];
+        r.importance = columns.importance[i];
+        r.hours_passed = created > 0.0 ? std::max(0.0, (now - created) / SECONDS_PER_HOUR) : 0.0;
+        r.last_access_hours = last >= 0.0 ? std::max(0.0, (now - last) / SECONDS_PER_HOUR) : -1.0;
+        r.access_count = columns.access_count[i];
+        r.connection_count = connection_count[i];
+        r.memory_type = columns.memory_type[i];
+        r.channel_mentions = channel_mentions[i];
+    }
+}
+
+size_t upsert_into(const MemoryColumns& columns, engine::MemoryEngine& engine) {
+    if (columns.dim == 0) {
+        throw std::invalid_argument("rows were loaded without embeddings");
+    }
+    if (columns.dim != engine.dim()) {
+        throw std::invalid_argument("engine dim " + std::to_string(engine.dim()) +
+                                    " does not match loaded dim " + std::to_string(columns.dim));
+    }
+    size_t upserted = 0;
+    for (size_t i = 0; i < columns.rows(); ++i) {
+        if (!columns.has_embedding[i]) {
+            continue;
+        }
+        engine::MemoryAttributes attrs;
+        attrs.importance = columns.importance[i];
+        attrs.event_time = columns.created_at[i];
+        attrs.last_accessed = columns.last_accessed[i];
+        attrs.access_count = columns.access_count[i];
+        attrs.memory_type = columns.memory_type[i];
+        attrs.token_cost = columns.token_cost[i];
+        engine.upsert(columns.ids[i],
+                      StridedView<float>(columns.embeddings.data() + i * columns.dim), attrs);
+        ++upserted;
+    }
+    return upserted;
+}
+
+}  // namespace pgcopy
+}  // namespace axnmihn
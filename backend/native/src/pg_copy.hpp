@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "decay.hpp"
+#include "memory_engine.hpp"
+#include "pgvector_codec.hpp"
+
+namespace axnmihn {
+namespace pgcopy {
+
+/**
+ * Columns of the memories table in the order MemoryLoader expects them
+ * from `COPY (SELECT ...) TO STDOUT (FORMAT binary)`:
+ *
+ *     uuid::text, memory_type::text, importance::float8,
+ *     access_count::int4, created_at::timestamptz,
+ *     last_accessed::timestamptz, (length(content) / 4)::int4
+ *     [, embedding::vector | ::halfvec]
+ */
+constexpr size_t BASE_COLUMNS = 7;
+
+/**
+ * Memory rows decoded into columns.
+ *
+ * Timestamps are epoch seconds like engine::MemoryAttributes. NULL
+ * importance reads as 0.5, created_at as 0 (unknown), last_accessed as
+ * -1 (never), memory_type and token_cost as 0; rows with a NULL
+ * embedding have a zero row and has_embedding 0.
+ */
+struct MemoryColumns {
+    size_t dim = 0;                      // 0 when loaded without embeddings
+    std::vector<std::string> ids;
+    std::vector<double> importance;
+    std::vector<double> created_at;
+    std::vector<double> last_accessed;
+    std::vector<int32_t> access_count;
+    std::vector<int32_t> memory_type;    // 0=conversation, 1=fact, 2=preference, 3=insight
+    std::vector<int32_t> token_cost;     // Estimated prompt tokens, 0 if unknown
+    std::vector<uint8_t> has_embedding;
+    std::vector<float> embeddings;       // rows() x dim
+
+    size_t rows() const { return ids.size(); }
+};
+
+/**
+ * Incremental parser for binary COPY output of the memories table.
+ *
+ * feed() accepts the stream in chunks of any size (e.g. one CopyData
+ * message per call) and decodes each complete tuple straight into
+ * MemoryColumns; only a tuple split across chunks is buffered, so memory
+ * beyond the columns themselves is bounded by one row. take() hands over
+ * the rows decoded so far, which lets callers process a large table in
+ * batches.
+ */
+class MemoryLoader {
+public:
+    /**
+     * Args:
+     *     dim: Embedding dimension, or 0 when the query has no embedding column
+     *     type: Binary type of the embedding column
+     */
+    explicit MemoryLoader(size_t dim = 0, pgvector::WireType type = pgvector::WireType::HalfVec);
+
+    /**
+     * Decode the next chunk of the stream.
+     *
+     * Returns:
+     *     Number of rows completed by this chunk
+     *
+     * Raises std::invalid_argument for a bad signature, a column count or
+     * field size that does not match the layout, or data after the trailer.
+     */
+    size_t feed(const uint8_t* data, size_t len);
+
+    /** Raise std::invalid_argument unless the trailer has been read. */
+    void finish() const;
+
+    /** Whether the end-of-data trailer has been read. */
+    bool done() const { return done_; }
+
+    /** Bytes of an incomplete tuple waiting for the next chunk. */
+    size_t buffered() const { return pending_.size(); }
+
+    /** Total rows decoded since construction. */
+    size_t total_rows() const { return total_rows_; }
+
+    size_t dim() const { return dim_; }
+
+    const MemoryColumns& columns() const { return columns_; }
+
+    /** Reserve column space for `rows` rows (e.g. from a prior count). */
+    void reserve(size_t rows);
+
+    /**
+     * Move out the rows decoded so far and start a new batch, reserving
+     * as many rows as the batch handed out.
+     */
+    MemoryColumns take();
+
+private:
+    size_t parse(const uint8_t* data, size_t len, size_t& rows);
+    size_t parse_header(const uint8_t* data, size_t len);
+    size_t parse_tuple(const uint8_t* data, size_t len);
+
+    size_t dim_;
+    pgvector::WireType type_;
+    size_t fields_;
+    bool header_done_ = false;
+    bool done_ = false;
+    size_t total_rows_ = 0;
+    std::vector<uint8_t> pending_;
+    MemoryColumns columns_;
+};
+
+/**
+ * Decay inputs for every row at time `now`, in decay_ops.RECORD_DTYPE
+ * layout. Ages are clamped at zero; rows with an unknown created_at get
+ * age 0.
+ *
+ * Args:
+ *     columns: Loaded rows
+ *     now: Current time in epoch seconds
+ *     connection_count: Per-row graph connections (stride 0 for one value)
+ *     channel_mentions: Per-row channel mentions (stride 0 for one value)
+ *     out: rows() records
+ */
+void decay_records(const MemoryColumns& columns, double now,
+                   StridedView<int32_t> connection_count, StridedView<int32_t> channel_mentions,
+                   decay::DecayRecord* out);
+
+/**
+ * Upsert every row that has an embedding into a MemoryEngine.
+ *
+ * Returns:
+ *     Number of rows upserted
+ */
+size_t upsert_into(const MemoryColumns& columns, engine::MemoryEngine& engine);
+
+}  // namespace pgcopy
+}  // namespace axnmihn
@@ -0,0 +1,481 @@
+#include "pgvector_codec.hpp"
+#include "projection.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace axnmihn {
+namespace pgvector {
+
+namespace {
+
+// Longest shortest-round-trip float32, e.g. "-1.17549435e-38"
+constexpr size_t MAX_FLOAT_CHARS = 16;
+
+// Exactly representable powers of ten (Clinger's fast path)
+constexpr double POW10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+constexpr int MAX_FAST_EXPONENT = 22;
+constexpr uint64_t MAX_FAST_MANTISSA = uint64_t(1) << 53;
+constexpr int MAX_MANTISSA_DIGITS = 19;
+
+std::invalid_argument syntax_error(const char* begin, const char* at) {
+    return std::invalid_argument("malformed vector text at offset " +
+                                 std::to_string(at - begin));
+}
+
+void check_dim(size_t n) {
+    if (n == 0) {
+        throw std::invalid_argument("vector must have at least 1 dimension");
+    }
+    if (n > MAX_DIM) {
+        throw std::invalid_argument("vector cannot have more than " +
+                                    std::to_string(MAX_DIM) + " dimensions");
+    }
+}
+
+inline bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool is_digit(char c) {
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// -----------------------------------------------------------------------------
+// SWAR digit parsing: eight ASCII digits per 64-bit load
+// -----------------------------------------------------------------------------
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool LITTLE_ENDIAN_HOST = false;
+#else
+constexpr bool LITTLE_ENDIAN_HOST = true;
+#endif
+
+inline uint64_t load8(const char* p) {
+    uint64_t chunk;
+    std::memcpy(&chunk, p, sizeof(chunk));
+    return chunk;
+}
+
+// Every byte is '0'..'9': no high nibble other than 3, and adding 6 to
+// the low nibble must not carry into it
+inline bool all_digits(uint64_t chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ull) |
+            (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+           0x3333333333333333ull;
+}
+
+// Value of eight digits, first byte most significant
+inline uint32_t eight_digits(uint64_t chunk) {
+    const uint64_t mask = 0x000000FF000000FFull;
+    const uint64_t mul1 = 0x000F424000000064ull;  // 100 + (1000000 << 32)
+    const uint64_t mul2 = 0x0000271000000001ull;  // 1 + (10000 << 32)
+    chunk -= 0x3030303030303030ull;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(chunk);
+}
+
+struct Digits {
+    uint64_t mantissa = 0;
+    int count = 0;          // Digits folded into mantissa
+    bool truncated = false; // More than MAX_MANTISSA_DIGITS significant digits
+};
+
+// Consume a digit run into `digits`; returns the number of digits read
+inline size_t read_digits(const char*& p, const char* end, Digits& digits) {
+    const char* start = p;
+    if constexpr (LITTLE_ENDIAN_HOST) {
+        while (end - p >= 8 && digits.count + 8 <= MAX_MANTISSA_DIGITS) {
+            const uint64_t chunk = load8(p);
+            if (!all_digits(chunk)) {
+                break;
+            }
+            digits.mantissa = digits.mantissa * 100000000u + eight_digits(chunk);
+            digits.count += 8;
+            p += 8;
+        }
+    }
+    for (; p < end && is_digit(*p); ++p) {
+        if (digits.count < MAX_MANTISSA_DIGITS) {
+            digits.mantissa = digits.mantissa * 10 + static_cast<uint64_t>(*p - '0');
+            ++digits.count;
+        } else {
+            digits.truncated = true;
+        }
+    }
+    return static_cast<size_t>(p - start);
+}
+
+// strtof()-compatible conversion of [num, end) (no sign); false on overflow
+bool slow_float(const char* num, const char* end, bool negative, float& value) {
+    float magnitude = 0.0f;
+    const auto result = std::from_chars(num, end, magnitude);
+    if (result.ec == std::errc::result_out_of_range) {
+        // Underflow flushes to zero like strtof(); overflow is an error
+        double wide = 0.0;
+        std::from_chars(num, end, wide);
+        if (!(std::fabs(wide) < 1.0)) {
+            return false;
+        }
+        magnitude = 0.0f;
+    }
+    value = negative ? -magnitude : magnitude;
+    return std::isfinite(value);
+}
+
+/**
+ * Parse one number at p (no leading whitespace) and advance p past it.
+ *
+ * Returns false when the number overflows float32; throws on bad syntax.
+ */
+bool read_float(const char* text, const char*& p, const char* end, float& value) {
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    const char* num = p;
+
+    Digits digits;
+    int exponent = 0;
+    size_t n_digits = 0;
+
+    // Leading zeros are not significant
+    while (p < end && *p == '0') {
+        ++p;
+        ++n_digits;
+    }
+    n_digits += read_digits(p, end, digits);
+    if (p < end && *p == '.') {
+        ++p;
+        if (digits.count == 0) {
+            while (p < end && *p == '0') {
+                ++p;
+                ++n_digits;
+                --exponent;
+            }
+        }
+        const int before = digits.count;
+        n_digits += read_digits(p, end, digits);
+        exponent -= digits.count - before;
+    }
+    if (n_digits == 0) {
+        throw syntax_error(text, start);
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool exp_negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            exp_negative = *p == '-';
+            ++p;
+        }
+        if (p >= end || !is_digit(*p)) {
+            throw syntax_error(text, start);
+        }
+        int e = 0;
+        for (; p < end && is_digit(*p); ++p) {
+            if (e < 100000) {
+                e = e * 10 + (*p - '0');
+            }
+        }
+        exponent += exp_negative ? -e : e;
+    }
+
+    if (digits.mantissa == 0 && !digits.truncated) {
+        value = negative ? -0.0f : 0.0f;
+        return true;
+    }
+    if (!digits.truncated && digits.mantissa <= MAX_FAST_MANTISSA &&
+        exponent >= -MAX_FAST_EXPONENT && exponent <= MAX_FAST_EXPONENT) {
+        // Exact mantissa and power of ten: one correctly rounded operation
+        double d = static_cast<double>(digits.mantissa);
+        d = exponent < 0 ? d / POW10[-exponent] : d * POW10[exponent];
+
+        // Narrowing matches direct rounding to float32 unless d sits on a
+        // float32 midpoint (the decimal may lie just beside it) or in the
+        // subnormal range, where the midpoints move
+        uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        if (d >= static_cast<double>(std::numeric_limits<float>::min()) &&
+            (bits & 0x1FFFFFFFull) != 0x10000000ull) {
+            const float f = static_cast<float>(d);
+            value = negative ? -f : f;
+            return std::isfinite(value);
+        }
+    }
+    return slow_float(num, p, negative, value);
+}
+
+template<typename T>
+void format_impl(StridedView<T> values, size_t n, std::string& out) {
+    check_dim(n);
+    const size_t base = out.size();
+    out.resize(base + 2 + n * (MAX_FLOAT_CHARS + 1));
+    char* p = &out[base];
+    char* const limit = &out[0] + out.size();
+    *p++ = '[';
+    for (size_t i = 0; i < n; ++i) {
+        const float f = static_cast<float>(values[i]);
+        if (!std::isfinite(f)) {
+            out.resize(base);
+            throw std::invalid_argument("vector values must be finite float32 (index " +
+                                        std::to_string(i) + ")");
+        }
+        if (i) {
+            *p++ = ',';
+        }
+        p = std::to_chars(p, limit, f).ptr;
+    }
+    *p++ = ']';
+    out.resize(static_cast<size_t>(p - &out[0]));
+}
+
+inline void store_be16(uint8_t* out, uint16_t v) {
+    out[0] = static_cast<uint8_t>(v >> 8);
+    out[1] = static_cast<uint8_t>(v);
+}
+
+inline uint16_t load_be16(const uint8_t* in) {
+    return static_cast<uint16_t>((in[0] << 8) | in[1]);
+}
+
+inline void store_be32(uint8_t* out, uint32_t v) {
+    if constexpr (LITTLE_ENDIAN_HOST) {
+        v = __builtin_bswap32(v);
+    }
+    std::memcpy(out, &v, sizeof(v));
+}
+
+inline uint32_t load_be32(const uint8_t* in) {
+    uint32_t v;
+    std::memcpy(&v, in, sizeof(v));
+    if constexpr (LITTLE_ENDIAN_HOST) {
+        v = __builtin_bswap32(v);
+    }
+    return v;
+}
+
+size_t element_size(WireType type) {
+    return type == WireType::Vector ? sizeof(float) : sizeof(uint16_t);
+}
+
+}  // anonymous namespace
+
+void format_text(StridedView<double> values, size_t n, std::string& out) {
+    format_impl(values, n, out);
+}
+
+void format_text(StridedView<float> values, size_t n, std::string& out) {
+    format_impl(values, n, out);
+}
+
+std::vector<std::string> format_text_rows(const StridedMatrix<double>& rows) {
+    check_dim(rows.cols);
+    std::vector<std::string> texts(rows.rows);
+    runtime::parallel_for(runtime::default_pool(), rows.rows, 64, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            format_text(rows.row(r), rows.cols, texts[r]);
+        }
+    });
+    return texts;
+}
+
+size_t parse_text(std::string_view text, std::vector<float>& out) {
+    out.clear();
+    const char* const begin = text.data();
+    const char* const end = begin + text.size();
+    const char* p = begin;
+
+    while (p < end && is_space(*p)) {
+        ++p;
+    }
+    if (p >= end || *p != '[') {
+        throw syntax_error(begin, p);
+    }
+    ++p;
+
+    bool closed = false;
+    while (p < end) {
+        while (p < end && is_space(*p)) {
+            ++p;
+        }
+        if (out.empty() && p < end && *p == ']') {
+            ++p;
+            closed = true;  // "[]" is reported as an empty vector below
+            break;
+        }
+        float value;
+        const char* token = p;
+        if (!read_float(begin, p, end, value)) {
+            throw std::invalid_argument("value at offset " + std::to_string(token - begin) +
+                                        " is out of range for float32");
+        }
+        if (out.size() == MAX_DIM) {
+            check_dim(MAX_DIM + 1);
+        }
+        out.push_back(value);
+        while (p < end && is_space(*p)) {
+            ++p;
+        }
+        if (p < end && *p == ',') {
+            ++p;
+            continue;
+        }
+        if (p < end && *p == ']') {
+            ++p;
+            closed = true;
+            break;
+        }
+        throw syntax_error(begin, p);
+    }
+    if (!closed) {
+        throw syntax_error(begin, p);
+    }
+    if (out.empty()) {
+        check_dim(0);
+    }
+    while (p < end && is_space(*p)) {
+        ++p;
+    }
+    if (p != end) {
+        throw syntax_error(begin, p);
+    }
+    return out.size();
+}
+
+std::vector<float> parse_text_rows(const std::vector<std::string_view>& texts, size_t& dim) {
+    if (texts.empty()) {
+        return {};
+    }
+    std::vector<float> scratch;
+    if (dim == 0) {
+        dim = parse_text(texts[0], scratch);
+    }
+    std::vector<float> values(texts.size() * dim);
+    runtime::parallel_for(runtime::default_pool(), texts.size(), 16, [&](size_t begin, size_t end) {
+        std::vector<float> row;
+        row.reserve(dim);
+        for (size_t r = begin; r < end; ++r) {
+            if (parse_text(texts[r], row) != dim) {
+                throw std::invalid_argument("row " + std::to_string(r) + ": expected " +
+                                            std::to_string(dim) + " dimensions, got " +
+                                            std::to_string(row.size()));
+            }
+            std::memcpy(values.data() + r * dim, row.data(), dim * sizeof(float));
+        }
+    });
+    return values;
+}
+
+size_t binary_size(WireType type, size_t dim) {
+    return 4 + dim * element_size(type);
+}
+
+void encode_binary(const float* values, size_t n, WireType type, uint8_t* out) {
+    check_dim(n);
+    store_be16(out, static_cast<uint16_t>(n));
+    store_be16(out + 2, 0);
+    uint8_t* p = out + 4;
+
+    if (type == WireType::Vector) {
+        for (size_t i = 0; i < n; ++i) {
+            if (!std::isfinite(values[i])) {
+                throw std::invalid_argument("vector values must be finite (index " +
+                                            std::to_string(i) + ")");
+            }
+            uint32_t bits;
+            std::memcpy(&bits, &values[i], sizeof(bits));
+            store_be32(p + 4 * i, bits);
+        }
+        return;
+    }
+
+    // Round in blocks so the F16C path gets full vectors
+    constexpr size_t BLOCK = 256;
+    uint16_t halves[BLOCK];
+    for (size_t start = 0; start < n; start += BLOCK) {
+        const size_t count = std::min(BLOCK, n - start);
+        projection::float_to_half(values + start, count, halves);
+        for (size_t i = 0; i < count; ++i) {
+            if ((halves[i] & 0x7C00u) == 0x7C00u) {
+                throw std::invalid_argument("value out of range for halfvec (index " +
+                                            std::to_string(start + i) + ")");
+            }
+            store_be16(p + 2 * (start + i), halves[i]);
+        }
+    }
+}
+
+size_t binary_dim(const uint8_t* data, size_t len, WireType type) {
+    if (len < 4) {
+        throw std::invalid_argument("binary vector is truncated");
+    }
+    const auto dim = static_cast<int16_t>(load_be16(data));
+    if (load_be16(data + 2) != 0) {
+        throw std::invalid_argument("expected unused to be 0");
+    }
+    if (dim < 1) {
+        check_dim(0);
+    }
+    check_dim(static_cast<size_t>(dim));
+    if (len != binary_size(type, static_cast<size_t>(dim))) {
+        throw std::invalid_argument("binary vector length " + std::to_string(len) +
+                                    " does not match dimension " + std::to_string(dim));
+    }
+    return static_cast<size_t>(dim);
+}
+
+void decode_binary(const uint8_t* data, size_t len, WireType type, float* out) {
+    const size_t dim = binary_dim(data, len, type);
+    const uint8_t* p = data + 4;
+    if (type == WireType::Vector) {
+        for (size_t i = 0; i < dim; ++i) {
+            const uint32_t bits = load_be32(p + 4 * i);
+            std::memcpy(&out[i], &bits, sizeof(bits));
+        }
+        return;
+    }
+    constexpr size_t BLOCK = 256;
+    uint16_t halves[BLOCK];
+    for (size_t start = 0; start < dim; start += BLOCK) {
+        const size_t count = std::min(BLOCK, dim - start);
+        for (size_t i = 0; i < count; ++i) {
+            halves[i] = load_be16(p + 2 * (start + i));
+        }
+        projection::half_to_float(halves, count, out + start);
+    }
+}
+
+void decode_binary(const uint8_t* data, size_t len, WireType type, uint16_t* out) {
+    const size_t dim = binary_dim(data, len, type);
+    const uint8_t* p = data + 4;
+    if (type == WireType::HalfVec) {
+        for (size_t i = 0; i < dim; ++i) {
+            out[i] = load_be16(p + 2 * i);
+        }
+        return;
+    }
+    constexpr size_t BLOCK = 256;
+    float floats[BLOCK];
+    for (size_t start = 0; start < dim; start += BLOCK) {
+        const size_t count = std::min(BLOCK, dim - start);
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t bits = load_be32(p + 4 * (start + i));
+            std::memcpy(&floats[i], &bits, sizeof(bits));
+        }
+        projection::float_to_half(floats, count, out + start);
+    }
+}
+
+}  // namespace pgvector
+}  // namespace axnmihn
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "strided.hpp"
+
+namespace axnmihn {
+namespace pgvector {
+
+/**
+ * pgvector column types handled by the binary send/recv codec.
+ *
+ * Both start with a big-endian int16 dimension and an int16 that must be
+ * zero, followed by the values in network byte order: float4 for vector,
+ * IEEE half-precision bits for halfvec.
+ */
+enum class WireType {
+    Vector,
+    HalfVec,
+};
+
+constexpr size_t MAX_DIM = 16000;  // VECTOR_MAX_DIM / HALFVEC_MAX_DIM
+
+/**
+ * Append pgvector's text form "[v1,v2,...]" for n values.
+ *
+ * Values are rounded to float32 (what vector_in / halfvec_in store) and
+ * printed with the shortest digits that parse back to the same float32,
+ * so the server stores the same value as for str(list) of the float64
+ * inputs (barring double-rounding ties) from much shorter text.
+ *
+ * Args:
+ *     values: Values to format
+ *     n: Number of values (1..MAX_DIM)
+ *     out: String the text is appended to
+ *
+ * Raises std::invalid_argument for NaN, infinities or values outside the
+ * float32 range.
+ */
+void format_text(StridedView<double> values, size_t n, std::string& out);
+void format_text(StridedView<float> values, size_t n, std::string& out);
+
+/**
+ * format_text() for every row of a matrix, on the thread pool.
+ */
+std::vector<std::string> format_text_rows(const StridedMatrix<double>& rows);
+
+/**
+ * Parse pgvector text "[v1,v2,...]" into float32 values.
+ *
+ * Accepts what vector_out and halfvec_out produce plus whitespace around
+ * tokens (so Python list reprs parse too). Numbers of up to 19 significant
+ * digits with small exponents take a fast path: digits are read eight at
+ * a time with SWAR arithmetic and converted by one exact double operation;
+ * the rare cases where that could round differently from strtof() (float32
+ * rounding midpoints, subnormals, long mantissas) go through
+ * std::from_chars.
+ *
+ * Args:
+ *     text: pgvector text
+ *     out: Receives the values (cleared first)
+ *
+ * Returns:
+ *     Number of values parsed
+ *
+ * Raises std::invalid_argument for malformed text, empty vectors, more
+ * than MAX_DIM values, or values that overflow float32.
+ */
+size_t parse_text(std::string_view text, std::vector<float>& out);
+
+/**
+ * Parse many vectors of one dimension into a row-major float32 matrix,
+ * on the thread pool.
+ *
+ * Args:
+ *     texts: pgvector texts
+ *     dim: Expected dimension; 0 takes the first row's, updated on return
+ *
+ * Returns:
+ *     texts.size() x dim values
+ */
+std::vector<float> parse_text_rows(const std::vector<std::string_view>& texts, size_t& dim);
+
+/** Size in bytes of the binary form of a dim-dimensional value. */
+size_t binary_size(WireType type, size_t dim);
+
+/**
+ * Write the binary send/recv form (binary_size(type, n) bytes).
+ *
+ * halfvec values are rounded to half precision like halfvec_in does.
+ * Raises std::invalid_argument for non-finite values, values that
+ * overflow the wire type, or n outside 1..MAX_DIM.
+ */
+void encode_binary(const float* values, size_t n, WireType type, uint8_t* out);
+
+/**
+ * Validate a binary value's header and length.
+ *
+ * Returns:
+ *     Its dimension
+ */
+size_t binary_dim(const uint8_t* data, size_t len, WireType type);
+
+/**
+ * Decode a binary value into binary_dim() float32 values, or into
+ * half-precision bits (exact for halfvec, rounded for vector).
+ */
+void decode_binary(const uint8_t* data, size_t len, WireType type, float* out);
+void decode_binary(const uint8_t* data, size_t len, WireType type, uint16_t* out);
+
+}  // namespace pgvector
+}  // namespace axnmihn
@@ -0,0 +1,577 @@
+#include "pq.hpp"
+#include "accuracy.hpp"
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#ifdef HAS_AVX2
+#include <immintrin.h>
+#endif
+
+namespace axnmihn {
+namespace pq {
+
+namespace {
+
+// Training sample cap, as in common PQ trainers: more points barely move
+// the centroids but cost linear time
+constexpr size_t MAX_POINTS_PER_CENTROID = 256;
+
+// Vectors per fast-scan block (one 256-bit register of byte codes)
+constexpr size_t BLOCK = 32;
+
+double inverse_norm(StridedView<double> row, size_t dim) {
+    double norm_sq = 0.0;
+    for (size_t d = 0; d < dim; ++d) {
+        norm_sq += row[d] * row[d];
+    }
+    return norm_sq > 1e-20 ? 1.0 / std::sqrt(norm_sq) : 0.0;
+}
+
+// Index of the centroid nearest to x (L2), lowest index on ties
+uint32_t nearest(const float* x, const float* centroids, const float* norms, size_t k, size_t d) {
+    uint32_t best = 0;
+    float best_dist = 0.0f;
+    for (size_t j = 0; j < k; ++j) {
+        const float* c = centroids + j * d;
+        float dot = 0.0f;
+        for (size_t i = 0; i < d; ++i) {
+            dot += x[i] * c[i];
+        }
+        const float dist = norms[j] - 2.0f * dot;
+        if (j == 0 || dist < best_dist) {
+            best = static_cast<uint32_t>(j);
+            best_dist = dist;
+        }
+    }
+    return best;
+}
+
+void centroid_norms(const float* centroids, size_t k, size_t d, float* norms) {
+    for (size_t j = 0; j < k; ++j) {
+        float sum = 0.0f;
+        for (size_t i = 0; i < d; ++i) {
+            sum += centroids[j * d + i] * centroids[j * d + i];
+        }
+        norms[j] = sum;
+    }
+}
+
+// Lloyd's k-means on n points of d values into k centroids
+void kmeans(const float* x, size_t n, size_t d, size_t k, int iterations, uint64_t seed,
+            float* centroids) {
+    std::mt19937_64 rng(seed);
+
+    // Start from k distinct points
+    std::vector<uint32_t> pick(n);
+    std::iota(pick.begin(), pick.end(), 0u);
+    for (size_t j = 0; j < k; ++j) {
+        std::swap(pick[j], pick[j + rng() % (n - j)]);
+        std::copy(x + pick[j] * d, x + pick[j] * d + d, centroids + j * d);
+    }
+
+    std::vector<uint32_t> assign(n, UINT32_MAX);
+    std::vector<float> norms(k);
+    std::vector<double> sums(k * d);
+    std::vector<uint32_t> counts(k);
+    for (int it = 0; it < iterations; ++it) {
+        centroid_norms(centroids, k, d, norms.data());
+        size_t changed = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t c = nearest(x + i * d, centroids, norms.data(), k, d);
+            if (c != assign[i]) {
+                assign[i] = c;
+                ++changed;
+            }
+        }
+        if (changed == 0) {
+            break;
+        }
+
+        std::fill(sums.begin(), sums.end(), 0.0);
+        std::fill(counts.begin(), counts.end(), 0u);
+        for (size_t i = 0; i < n; ++i) {
+            double* sum = &sums[assign[i] * d];
+            for (size_t v = 0; v < d; ++v) {
+                sum[v] += x[i * d + v];
+            }
+            ++counts[assign[i]];
+        }
+        for (size_t j = 0; j < k; ++j) {
+            float* c = centroids + j * d;
+            if (counts[j] == 0) {
+                const size_t i = rng() % n;
+                std::copy(x + i * d, x + i * d + d, c);
+                continue;
+            }
+            for (size_t v = 0; v < d; ++v) {
+                c[v] = static_cast<float>(sums[j * d + v] / counts[j]);
+            }
+        }
+    }
+}
+
+// Float table quantised to uint8 for the fast scan. Per-subspace minima
+// are subtracted and one step size is shared, so a vector's score is
+// bias + step * (sum of its entries); entries are capped so the sum of
+// all subspaces fits uint16.
+struct QuantizedTable {
+    std::vector<uint8_t> entries;  // subspaces x 16
+    double bias = 0.0;
+    double step = 1.0;
+};
+
+QuantizedTable quantize_table(const float* table, size_t subspaces) {
+    QuantizedTable q;
+    q.entries.resize(subspaces * 16);
+    std::vector<float> minima(subspaces);
+    float span = 0.0f;
+    for (size_t s = 0; s < subspaces; ++s) {
+        const float* row = table + s * 16;
+        const auto range = std::minmax_element(row, row + 16);
+        minima[s] = *range.first;
+        span = std::max(span, *range.second - *range.first);
+        q.bias += *range.first;
+    }
+    const size_t levels = std::min<size_t>(255, 65535 / std::max<size_t>(subspaces, 1));
+    q.step = span > 0.0f ? static_cast<double>(span) / static_cast<double>(levels) : 1.0;
+    for (size_t s = 0; s < subspaces; ++s) {
+        for (size_t j = 0; j < 16; ++j) {
+            const double level = std::nearbyint((table[s * 16 + j] - minima[s]) / q.step);
+            q.entries[s * 16 + j] = static_cast<uint8_t>(std::min(level, static_cast<double>(levels)));
+        }
+    }
+    return q;
+}
+
+// Sums of table entries for the 32 vectors of one block
+void fast_scan_block(const uint8_t* block, const uint8_t* table, size_t code_size, uint32_t* acc) {
+#ifdef HAS_AVX2
+    if (simd::use_avx2()) {
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        const __m256i low_byte = _mm256_set1_epi16(0x00FF);
+        __m256i even = _mm256_setzero_si256();   // vectors 0, 2, ..., 30
+        __m256i odd = _mm256_setzero_si256();    // vectors 1, 3, ..., 31
+        for (size_t j = 0; j < code_size; ++j) {
+            const __m256i codes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + j * BLOCK));
+            const __m256i lo = _mm256_and_si256(codes, nibble);
+            const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(codes, 4), nibble);
+            const __m256i table_lo = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + (2 * j) * 16)));
+            const __m256i table_hi = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + (2 * j + 1) * 16)));
+            const __m256i a = _mm256_shuffle_epi8(table_lo, lo);
+            const __m256i b = _mm256_shuffle_epi8(table_hi, hi);
+            even = _mm256_add_epi16(even, _mm256_and_si256(a, low_byte));
+            even = _mm256_add_epi16(even, _mm256_and_si256(b, low_byte));
+            odd = _mm256_add_epi16(odd, _mm256_srli_epi16(a, 8));
+            odd = _mm256_add_epi16(odd, _mm256_srli_epi16(b, 8));
+        }
+        alignas(32) uint16_t e[16];
+        alignas(32) uint16_t o[16];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(e), even);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(o), odd);
+        for (size_t t = 0; t < 16; ++t) {
+            acc[2 * t] = e[t];
+            acc[2 * t + 1] = o[t];
+        }
+        return;
+    }
+#endif
+    std::fill(acc, acc + BLOCK, 0u);
+    for (size_t j = 0; j < code_size; ++j) {
+        const uint8_t* lo_table = table + (2 * j) * 16;
+        const uint8_t* hi_table = lo_table + 16;
+        for (size_t i = 0; i < BLOCK; ++i) {
+            const uint8_t code = block[j * BLOCK + i];
+            acc[i] += lo_table[code & 0x0F] + hi_table[code >> 4];
+        }
+    }
+}
+
+}  // anonymous namespace
+
+// =============================================================================
+// ProductQuantizer
+// =============================================================================
+
+ProductQuantizer::ProductQuantizer(size_t dim, size_t m, int nbits)
+    : dim_(dim), m_(m), nbits_(nbits) {
+    if (dim == 0 || m == 0 || dim % m != 0) {
+        throw std::invalid_argument("dim must be a positive multiple of m");
+    }
+    if (nbits != 4 && nbits != 8) {
+        throw std::invalid_argument("nbits must be 4 or 8");
+    }
+}
+
+ProductQuantizer::ProductQuantizer(size_t dim, size_t m, int nbits, std::vector<float> centroids)
+    : ProductQuantizer(dim, m, nbits) {
+    if (centroids.size() != m_ * ksub() * dsub()) {
+        throw std::invalid_argument("centroids: expected m * 2^nbits * (dim / m) values");
+    }
+    centroids_ = std::move(centroids);
+}
+
+ProductQuantizer::ProductQuantizer(const ProductQuantizer& other)
+    : dim_(other.dim_), m_(other.m_), nbits_(other.nbits_) {
+    std::shared_lock<std::shared_mutex> lock(other.mutex_);
+    centroids_ = other.centroids_;
+}
+
+bool ProductQuantizer::trained() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return !centroids_.empty();
+}
+
+std::vector<float> ProductQuantizer::centroids() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return centroids_;
+}
+
+void ProductQuantizer::check_trained() const {
+    if (centroids_.empty()) {
+        throw std::runtime_error("product quantizer is not trained");
+    }
+}
+
+void ProductQuantizer::train(const StridedMatrix<double>& data, int iterations, uint64_t seed) {
+    if (data.cols != dim_) {
+        throw std::invalid_argument("data: expected " + std::to_string(dim_) + " columns");
+    }
+    const size_t k = ksub();
+    const size_t ds = dsub();
+    if (data.rows < k) {
+        throw std::invalid_argument("need at least " + std::to_string(k) + " training vectors");
+    }
+
+    std::mt19937_64 rng(seed);
+    std::vector<uint32_t> rows(data.rows);
+    std::iota(rows.begin(), rows.end(), 0u);
+    const size_t max_points = k * MAX_POINTS_PER_CENTROID;
+    if (rows.size() > max_points) {
+        for (size_t i = 0; i < max_points; ++i) {
+            std::swap(rows[i], rows[i + rng() % (rows.size() - i)]);
+        }
+        rows.resize(max_points);
+        std::sort(rows.begin(), rows.end());
+    }
+    const size_t n = rows.size();
+    std::vector<double> inv(n);
+    for (size_t i = 0; i < n; ++i) {
+        inv[i] = inverse_norm(data.row(rows[i]), dim_);
+    }
+
+    // Seeds are drawn up front so the result does not depend on scheduling
+    std::vector<uint64_t> seeds(m_);
+    for (auto& s : seeds) {
+        s = rng();
+    }
+
+    std::vector<float> centroids(m_ * k * ds);
+    runtime::parallel_for(runtime::default_pool(), m_, 1, [&](size_t begin, size_t end) {
+        std::vector<float> x(n * ds);
+        for (size_t s = begin; s < end; ++s) {
+            for (size_t i = 0; i < n; ++i) {
+                const auto row = data.row(rows[i]);
+                for (size_t d = 0; d < ds; ++d) {
+                    x[i * ds + d] = static_cast<float>(row[s * ds + d] * inv[i]);
+                }
+            }
+            kmeans(x.data(), n, ds, k, iterations, seeds[s], &centroids[s * k * ds]);
+        }
+    });
+    // Only the swap is exclusive; readers keep the old codebooks until then
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    centroids_ = std::move(centroids);
+}
+
+std::vector<uint8_t> ProductQuantizer::encode(const StridedMatrix<double>& data) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    check_trained();
+    if (data.cols != dim_) {
+        throw std::invalid_argument("data: expected " + std::to_string(dim_) + " columns");
+    }
+    const size_t k = ksub();
+    const size_t ds = dsub();
+    const size_t cs = code_size();
+    std::vector<float> norms(m_ * k);
+    for (size_t s = 0; s < m_; ++s) {
+        centroid_norms(&centroids_[s * k * ds], k, ds, &norms[s * k]);
+    }
+
+    std::vector<uint8_t> codes(data.rows * cs, 0);
+    runtime::parallel_for(runtime::default_pool(), data.rows, 256, [&](size_t begin, size_t end) {
+        std::vector<float> x(dim_);
+        for (size_t r = begin; r < end; ++r) {
+            const auto row = data.row(r);
+            const double inv = inverse_norm(row, dim_);
+            for (size_t d = 0; d < dim_; ++d) {
+                x[d] = static_cast<float>(row[d] * inv);
+            }
+            uint8_t* code = &codes[r * cs];
+            for (size_t s = 0; s < m_; ++s) {
+                const uint32_t c = nearest(&x[s * ds], &centroids_[s * k * ds], &norms[s * k], k, ds);
+                if (nbits_ == 8) {
+                    code[s] = static_cast<uint8_t>(c);
+                } else {
+                    code[s / 2] |= static_cast<uint8_t>(c << (4 * (s % 2)));
+                }
+            }
+        }
+    });
+    return codes;
+}
+
+std::vector<float> ProductQuantizer::decode(const uint8_t* codes, size_t n) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    check_trained();
+    const size_t k = ksub();
+    const size_t ds = dsub();
+    const size_t cs = code_size();
+    std::vector<float> out(n * dim_);
+    for (size_t r = 0; r < n; ++r) {
+        const uint8_t* code = codes + r * cs;
+        for (size_t s = 0; s < m_; ++s) {
+            const size_t c = nbits_ == 8 ? code[s] : (code[s / 2] >> (4 * (s % 2))) & 0x0F;
+            const float* centroid = &centroids_[(s * k + c) * ds];
+            std::copy(centroid, centroid + ds, &out[r * dim_ + s * ds]);
+        }
+    }
+    return out;
+}
+
+std::vector<float> ProductQuantizer::inner_product_table(StridedView<double> query) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    check_trained();
+    const size_t k = ksub();
+    const size_t ds = dsub();
+    const size_t subspaces = nbits_ == 8 ? m_ : 2 * code_size();
+    std::vector<float> table(subspaces * k, 0.0f);
+    const double inv = inverse_norm(query, dim_);
+    for (size_t s = 0; s < m_; ++s) {
+        for (size_t j = 0; j < k; ++j) {
+            const float* c = &centroids_[(s * k + j) * ds];
+            double dot = 0.0;
+            for (size_t d = 0; d < ds; ++d) {
+                dot += query[s * ds + d] * c[d];
+            }
+            table[s * k + j] = static_cast<float>(dot * inv);
+        }
+    }
+    return table;
+}
+
+void ProductQuantizer::cosine_similarity_batch_into(
+    StridedView<double> query,
+    const uint8_t* codes,
+    size_t n,
+    MutableStridedView<double> output
+) const {
+    // The table is a snapshot of the codebooks, so the scan needs no lock
+    const std::vector<float> table = inner_product_table(query);
+    const size_t cs = code_size();
+    runtime::parallel_for(runtime::default_pool(), n, 1024, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            const uint8_t* code = codes + r * cs;
+            float score = 0.0f;
+            if (nbits_ == 8) {
+                for (size_t s = 0; s < m_; ++s) {
+                    score += table[s * 256 + code[s]];
+                }
+            } else {
+                for (size_t j = 0; j < cs; ++j) {
+                    score += table[(2 * j) * 16 + (code[j] & 0x0F)] +
+                             table[(2 * j + 1) * 16 + (code[j] >> 4)];
+                }
+            }
+            output[r] = score;
+        }
+    });
+}
+
+// =============================================================================
+// PQIndex
+// =============================================================================
+
+PQIndex::PQIndex(ProductQuantizer quantizer) : quantizer_(std::move(quantizer)) {
+    if (!quantizer_.trained()) {
+        throw std::invalid_argument("quantizer must be trained");
+    }
+}
+
+size_t PQIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return n_;
+}
+
+size_t PQIndex::memory_bytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return codes_.size();
+}
+
+uint8_t PQIndex::code_byte(size_t row, size_t j) const {
+    const size_t cs = quantizer_.code_size();
+    if (quantizer_.nbits() == 8) {
+        return codes_[row * cs + j];
+    }
+    return codes_[(row / BLOCK) * BLOCK * cs + j * BLOCK + row % BLOCK];
+}
+
+void PQIndex::add(const StridedMatrix<double>& data) {
+    // Encode outside the lock so scans are only blocked by the copy
+    const std::vector<uint8_t> codes = quantizer_.encode(data);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    append_codes(codes.data(), data.rows);
+}
+
+void PQIndex::add_codes(const uint8_t* codes, size_t n) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    append_codes(codes, n);
+}
+
+void PQIndex::append_codes(const uint8_t* codes, size_t n) {
+    const size_t cs = quantizer_.code_size();
+    if (quantizer_.nbits() == 8) {
+        codes_.insert(codes_.end(), codes, codes + n * cs);
+        n_ += n;
+        return;
+    }
+    const size_t blocks = (n_ + n + BLOCK - 1) / BLOCK;
+    codes_.resize(blocks * BLOCK * cs, 0);
+    for (size_t r = 0; r < n; ++r) {
+        const size_t row = n_ + r;
+        uint8_t* block = &codes_[(row / BLOCK) * BLOCK * cs];
+        for (size_t j = 0; j < cs; ++j) {
+            block[j * BLOCK + row % BLOCK] = codes[r * cs + j];
+        }
+    }
+    n_ += n;
+}
+
+std::vector<uint8_t> PQIndex::codes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const size_t cs = quantizer_.code_size();
+    std::vector<uint8_t> out(n_ * cs);
+    for (size_t r = 0; r < n_; ++r) {
+        for (size_t j = 0; j < cs; ++j) {
+            out[r * cs + j] = code_byte(r, j);
+        }
+    }
+    return out;
+}
+
+void PQIndex::float_scores(const float* table, size_t begin, size_t end, double* out) const {
+    const size_t cs = quantizer_.code_size();
+    const size_t m = quantizer_.m();
+    for (size_t r = begin; r < end; ++r) {
+        float score = 0.0f;
+        if (quantizer_.nbits() == 8) {
+            const uint8_t* code = &codes_[r * cs];
+            for (size_t s = 0; s < m; ++s) {
+                score += table[s * 256 + code[s]];
+            }
+        } else {
+            for (size_t j = 0; j < cs; ++j) {
+                const uint8_t code = code_byte(r, j);
+                score += table[(2 * j) * 16 + (code & 0x0F)] + table[(2 * j + 1) * 16 + (code >> 4)];
+            }
+        }
+        out[r - begin] = score;
+    }
+}
+
+void PQIndex::fast_scan_scores(const float* table, double* out) const {
+    const size_t cs = quantizer_.code_size();
+    const QuantizedTable q = quantize_table(table, 2 * cs);
+    const size_t blocks = (n_ + BLOCK - 1) / BLOCK;
+    runtime::parallel_for(runtime::default_pool(), blocks, 64, [&](size_t begin, size_t end) {
+        uint32_t acc[BLOCK];
+        for (size_t b = begin; b < end; ++b) {
+            fast_scan_block(&codes_[b * BLOCK * cs], q.entries.data(), cs, acc);
+            const size_t count = std::min(BLOCK, n_ - b * BLOCK);
+            for (size_t i = 0; i < count; ++i) {
+                out[b * BLOCK + i] = q.bias + q.step * acc[i];
+            }
+        }
+    });
+}
+
+void PQIndex::cosine_similarity_batch_into(StridedView<double> query,
+                                           MutableStridedView<double> output, size_t n) const {
+    const std::vector<float> table = quantizer_.inner_product_table(query);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (n > n_) {
+        throw std::invalid_argument("n exceeds the number of stored vectors");
+    }
+    std::vector<double> scores(n_);
+    if (quantizer_.nbits() == 4) {
+        fast_scan_scores(table.data(), scores.data());
+    } else {
+        runtime::parallel_for(runtime::default_pool(), n_, 1024, [&](size_t begin, size_t end) {
+            float_scores(table.data(), begin, end, &scores[begin]);
+        });
+    }
+    for (size_t r = 0; r < n; ++r) {
+        output[r] = scores[r];
+    }
+}
+
+SearchResult PQIndex::search(StridedView<double> query, size_t k, size_t refine) const {
+    SearchResult result;
+    const std::vector<float> table = quantizer_.inner_product_table(query);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    k = std::min(k, n_);
+    if (k == 0) {
+        return result;
+    }
+    std::vector<double> scores(n_);
+
+    if (quantizer_.nbits() == 8) {
+        runtime::parallel_for(runtime::default_pool(), n_, 1024, [&](size_t begin, size_t end) {
+            float_scores(table.data(), begin, end, &scores[begin]);
+        });
+        result.ids = accuracy::top_k(scores.data(), n_, k);
+    } else {
+        // Fast-scan shortlist, re-scored with the float table
+        fast_scan_scores(table.data(), scores.data());
+        const size_t shortlist_size = std::min(n_, k * std::max<size_t>(refine, 1));
+        const std::vector<int64_t> shortlist = accuracy::top_k(scores.data(), n_, shortlist_size);
+        result.ids = shortlist;
+        for (int64_t id : shortlist) {
+            const auto row = static_cast<size_t>(id);
+            float_scores(table.data(), row, row + 1, &scores[row]);
+        }
+        std::partial_sort(result.ids.begin(), result.ids.begin() + static_cast<std::ptrdiff_t>(k),
+            result.ids.end(), [&](int64_t a, int64_t b) {
+                const double sa = scores[static_cast<size_t>(a)];
+                const double sb = scores[static_cast<size_t>(b)];
+                return sa > sb || (sa == sb && a < b);
+            });
+        result.ids.resize(k);
+
+        if (accuracy::should_sample()) {
+            std::vector<double> exact(n_);
+            float_scores(table.data(), 0, n_, exact.data());
+            const std::vector<int64_t> truth = accuracy::top_k(exact.data(), n_, k);
+            accuracy::record_recall("pq.fast_scan",
+                accuracy::recall_at_k(result.ids.data(), result.ids.size(), truth.data(), truth.size(), k));
+        }
+    }
+
+    result.scores.reserve(k);
+    for (int64_t id : result.ids) {
+        result.scores.push_back(scores[static_cast<size_t>(id)]);
+    }
+    return result;
+}
+
+}  // namespace pq
+}  // namespace axnmihn
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <vector>
+
+#include "strided.hpp"
+
+namespace axnmihn {
+namespace pq {
+
+/**
+ * Product quantizer for cosine search over L2-normalised embeddings.
+ *
+ * A vector is normalised, split into m subvectors of dim / m values, and
+ * each subvector is replaced by the index of its nearest centroid in
+ * that subspace's k-means codebook (2^nbits centroids). With nbits = 8
+ * a code is m bytes; with nbits = 4 two subspaces share a byte (low
+ * nibble = even subspace), so 3072-dim float64 rows (24 KB) shrink to
+ * 96 bytes with m = 96 (8-bit) or m = 192 (4-bit).
+ *
+ * Similarity is asymmetric (ADC): the query stays exact and is scored
+ * against the centroids once per subspace, so a code's cosine estimate
+ * is m table lookups. The estimate is the dot product of the
+ * normalised query with the reconstructed vector.
+ *
+ * Thread-safe: train() swaps the codebooks in under an exclusive lock,
+ * the other methods read them under a shared lock.
+ */
+class ProductQuantizer {
+public:
+    /**
+     * Args:
+     *     dim: Vector dimension (must be a multiple of m)
+     *     m: Number of subspaces
+     *     nbits: Bits per subspace code, 4 or 8
+     */
+    ProductQuantizer(size_t dim, size_t m, int nbits = 4);
+
+    /**
+     * Restore a trained quantizer from centroids().
+     *
+     * Args:
+     *     centroids: m x 2^nbits x (dim / m) values
+     */
+    ProductQuantizer(size_t dim, size_t m, int nbits, std::vector<float> centroids);
+
+    ProductQuantizer(const ProductQuantizer& other);
+
+    /**
+     * Learn the codebooks with k-means (Lloyd) per subspace, in parallel
+     * across subspaces.
+     *
+     * Rows are normalised first. At most 256 points per centroid are
+     * used, sampled with `seed`; centroids start at distinct sampled
+     * points and an empty cluster is re-seeded from a random point.
+     *
+     * Args:
+     *     data: Training vectors (n x dim), n >= 2^nbits
+     *     iterations: Maximum Lloyd iterations (stops early when stable)
+     *     seed: Sampling seed; equal inputs and seeds give equal codebooks
+     */
+    void train(const StridedMatrix<double>& data, int iterations = 20, uint64_t seed = 0);
+
+    bool trained() const;
+    size_t dim() const { return dim_; }
+    size_t m() const { return m_; }
+    int nbits() const { return nbits_; }
+    size_t ksub() const { return size_t{1} << nbits_; }
+    size_t dsub() const { return dim_ / m_; }
+
+    /** Bytes per encoded vector. */
+    size_t code_size() const { return nbits_ == 8 ? m_ : (m_ + 1) / 2; }
+
+    /** Codebooks as m x ksub x dsub values. */
+    std::vector<float> centroids() const;
+
+    /**
+     * Encode vectors (normalised first) into n x code_size() bytes.
+     */
+    std::vector<uint8_t> encode(const StridedMatrix<double>& data) const;
+
+    /**
+     * Reconstruct n encoded vectors as n x dim values.
+     */
+    std::vector<float> decode(const uint8_t* codes, size_t n) const;
+
+    /**
+     * ADC table: dot products of the normalised query's subvectors with
+     * every centroid, laid out as subspace x ksub. For nbits = 4 an odd
+     * m is padded with a zero subspace so the table covers every nibble.
+     */
+    std::vector<float> inner_product_table(StridedView<double> query) const;
+
+    /**
+     * Estimated cosine similarity of a query against row-major codes,
+     * the compressed counterpart of vector_ops::cosine_similarity_batch.
+     *
+     * Args:
+     *     query: Query view (dim values)
+     *     codes: n x code_size() bytes from encode()
+     *     n: Number of codes
+     *     output: Output view with n elements
+     */
+    void cosine_similarity_batch_into(
+        StridedView<double> query,
+        const uint8_t* codes,
+        size_t n,
+        MutableStridedView<double> output
+    ) const;
+
+private:
+    void check_trained() const;  // Caller holds mutex_
+
+    size_t dim_;
+    size_t m_;
+    int nbits_;
+    std::vector<float> centroids_;
+    mutable std::shared_mutex mutex_;
+};
+
+struct SearchResult {
+    std::vector<int64_t> ids;
+    std::vector<double> scores;
+};
+
+/**
+ * Append-only store of PQ codes with top-k cosine search.
+ *
+ * 4-bit codes are kept in fast-scan layout: blocks of 32 vectors where
+ * byte j of each vector's code is stored contiguously for the block, so
+ * one 32-byte load covers two subspaces of 32 vectors. The float ADC
+ * table is quantised to uint8 per query and looked up 32 vectors at a
+ * time with byte shuffles (AVX2), accumulating in uint16. 8-bit codes
+ * are scanned with the float table.
+ *
+ * Thread-safe: appends take an exclusive lock, scans a shared one.
+ */
+class PQIndex {
+public:
+    explicit PQIndex(ProductQuantizer quantizer);
+
+    const ProductQuantizer& quantizer() const { return quantizer_; }
+    size_t size() const;
+
+    /** Bytes held by the codes. */
+    size_t memory_bytes() const;
+
+    /** Encode and append vectors; ids continue from size(). */
+    void add(const StridedMatrix<double>& data);
+
+    /** Append n row-major codes from encode(). */
+    void add_codes(const uint8_t* codes, size_t n);
+
+    /** All codes in row-major order (n x code_size()). */
+    std::vector<uint8_t> codes() const;
+
+    /**
+     * Estimated cosine similarity of the query against the first n
+     * stored vectors (fast-scan estimate for 4-bit codes).
+     *
+     * Args:
+     *     query: Query view (dim values)
+     *     output: Output view with n elements
+     *     n: Rows to score, at most size() (rows appended after the
+     *        output was sized are left out)
+     */
+    void cosine_similarity_batch_into(StridedView<double> query, MutableStridedView<double> output,
+                                      size_t n) const;
+
+    /**
+     * Top-k ids by estimated cosine similarity.
+     *
+     * For 4-bit codes the fast scan picks k * refine candidates, which
+     * are then re-scored with the exact float table. Sampled calls (see
+     * accuracy::should_sample) record the shortlist's recall against a
+     * full float scan under "pq.fast_scan".
+     *
+     * Args:
+     *     query: Query view (dim values)
+     *     k: Number of results
+     *     refine: Shortlist multiplier for 4-bit codes (>= 1)
+     *
+     * Returns:
+     *     Ids and scores, best first (ties by id)
+     */
+    SearchResult search(StridedView<double> query, size_t k, size_t refine = 4) const;
+
+private:
+    // Callers hold mutex_
+    void append_codes(const uint8_t* codes, size_t n);
+    void float_scores(const float* table, size_t begin, size_t end, double* out) const;
+    void fast_scan_scores(const float* table, double* out) const;
+    uint8_t code_byte(size_t row, size_t j) const;
+
+    ProductQuantizer quantizer_;
+    size_t n_ = 0;
+    std::vector<uint8_t> codes_;  // row-major (8-bit) or 32-row blocks (4-bit)
+    mutable std::shared_mutex mutex_;
+};
+
+}  // namespace pq
+}  // namespace axnmihn
@@ -0,0 +1,552 @@
+#include "projection.hpp"
+#include "accuracy.hpp"
+#include "linalg.hpp"
+#include "simd.hpp"
+#include "thread_pool.hpp"
+#include "vector_ops.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#ifdef HAS_AVX2
+#include <immintrin.h>
+#endif
+
+namespace axnmihn {
+namespace projection {
+
+namespace {
+
+double inverse_norm(StridedView<double> row, size_t dim) {
+    double norm_sq = 0.0;
+    for (size_t d = 0; d < dim; ++d) {
+        norm_sq += row[d] * row[d];
+    }
+    return norm_sq > 1e-20 ? 1.0 / std::sqrt(norm_sq) : 0.0;
+}
+
+// Largest-magnitude entry positive, so components do not flip sign
+// between equivalent fits
+void fix_sign(float* row, size_t dim) {
+    size_t best = 0;
+    for (size_t i = 1; i < dim; ++i) {
+        if (std::fabs(row[i]) > std::fabs(row[best])) {
+            best = i;
+        }
+    }
+    if (row[best] < 0.0f) {
+        for (size_t i = 0; i < dim; ++i) {
+            row[i] = -row[i];
+        }
+    }
+}
+
+// Normalise a row and subtract the mean into x
+void prepare_row(StridedView<double> row, const float* mean, size_t dim, float* x) {
+    const double inv = inverse_norm(row, dim);
+    for (size_t d = 0; d < dim; ++d) {
+        x[d] = static_cast<float>(row[d] * inv) - mean[d];
+    }
+}
+
+void normalize_rows(float* dst, size_t rows, size_t out) {
+    for (size_t r = 0; r < rows; ++r) {
+        float* row = dst + r * out;
+        double norm_sq = 0.0;
+        for (size_t j = 0; j < out; ++j) {
+            norm_sq += static_cast<double>(row[j]) * row[j];
+        }
+        const float inv = norm_sq > 1e-20 ? static_cast<float>(1.0 / std::sqrt(norm_sq)) : 0.0f;
+        for (size_t j = 0; j < out; ++j) {
+            row[j] *= inv;
+        }
+    }
+}
+
+// Project rows [begin, end) into dst ((end - begin) x out)
+void project_range(const StridedMatrix<double>& data, size_t begin, size_t end,
+                   const float* components, const float* mean, size_t dim, size_t out,
+                   bool normalize, float* dst) {
+    std::vector<float> x(linalg::ROW_BLOCK * dim);
+    for (size_t r = begin; r < end; r += linalg::ROW_BLOCK) {
+        const size_t rows = std::min(linalg::ROW_BLOCK, end - r);
+        for (size_t b = 0; b < rows; ++b) {
+            prepare_row(data.row(r + b), mean, dim, &x[b * dim]);
+        }
+        float* block = dst + (r - begin) * out;
+        linalg::multiply_rows(x.data(), rows, components, dim, out, block);
+        if (normalize) {
+            normalize_rows(block, rows, out);
+        }
+    }
+}
+
+uint16_t half_from_float(float value) {
+    uint32_t x;
+    std::memcpy(&x, &value, sizeof(x));
+    const uint32_t sign = (x >> 16) & 0x8000u;
+    const uint32_t abs = x & 0x7FFFFFFFu;
+    if (abs >= 0x7F800000u) {  // inf, nan
+        return static_cast<uint16_t>(
+            sign | 0x7C00u | (abs > 0x7F800000u ? 0x200u | ((abs >> 13) & 0x3FFu) : 0u));
+    }
+    if (abs >= 0x477FF000u) {  // rounds past 65504
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (abs < 0x38800000u) {  // half subnormal or zero
+        if (abs < 0x33000000u) {
+            return static_cast<uint16_t>(sign);
+        }
+        const uint32_t exponent = abs >> 23;
+        const uint32_t mantissa = (abs & 0x7FFFFFu) | 0x800000u;
+        const uint32_t shift = 126 - exponent;
+        uint32_t h = mantissa >> shift;
+        const uint32_t rem = mantissa & ((1u << shift) - 1);
+        const uint32_t half = 1u << (shift - 1);
+        if (rem > half || (rem == half && (h & 1u))) {
+            ++h;
+        }
+        return static_cast<uint16_t>(sign | h);
+    }
+    uint32_t h = (abs - 0x38000000u) >> 13;
+    const uint32_t rem = abs & 0x1FFFu;
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) {
+        ++h;  // may carry into the exponent, which is still correct
+    }
+    return static_cast<uint16_t>(sign | h);
+}
+
+#ifdef HAS_AVX2
+bool cpu_has_f16c() {
+    static const bool has = __builtin_cpu_supports("f16c");
+    return has;
+}
+
+__attribute__((target("f16c")))
+size_t float_to_half_f16c(const float* input, size_t n, uint16_t* output) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), h);
+    }
+    return i;
+}
+
+__attribute__((target("f16c")))
+size_t half_to_float_f16c(const uint16_t* input, size_t n, float* output) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm256_storeu_ps(output + i, _mm256_cvtph_ps(h));
+    }
+    return i;
+}
+#endif
+
+}  // anonymous namespace
+
+void float_to_half(const float* input, size_t n, uint16_t* output) {
+    size_t i = 0;
+#ifdef HAS_AVX2
+    if (simd::use_avx2() && cpu_has_f16c()) {
+        i = float_to_half_f16c(input, n, output);
+    }
+#endif
+    for (; i < n; ++i) {
+        output[i] = half_from_float(input[i]);
+    }
+}
+
+void half_to_float(const uint16_t* input, size_t n, float* output) {
+    size_t i = 0;
+#ifdef HAS_AVX2
+    if (simd::use_avx2() && cpu_has_f16c()) {
+        i = half_to_float_f16c(input, n, output);
+    }
+#endif
+    for (; i < n; ++i) {
+        const uint32_t h = input[i];
+        const uint32_t sign = (h & 0x8000u) << 16;
+        const uint32_t exponent = (h >> 10) & 0x1Fu;
+        const uint32_t mantissa = h & 0x3FFu;
+        uint32_t bits;
+        if (exponent == 0) {
+            const float value = std::ldexp(static_cast<float>(mantissa), -24);
+            std::memcpy(&bits, &value, sizeof(bits));
+            bits |= sign;
+        } else if (exponent == 31) {
+            bits = sign | 0x7F800000u | (mantissa << 13);
+        } else {
+            bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+        std::memcpy(&output[i], &bits, sizeof(bits));
+    }
+}
+
+// =============================================================================
+// LinearProjection
+// =============================================================================
+
+LinearProjection::LinearProjection(size_t dim, size_t out_dim) : dim_(dim), out_dim_(out_dim) {
+    if (out_dim == 0 || out_dim > dim) {
+        throw std::invalid_argument("out_dim must be between 1 and dim");
+    }
+}
+
+LinearProjection::LinearProjection(size_t dim, size_t out_dim, std::vector<float> components,
+                                   std::vector<float> mean)
+    : LinearProjection(dim, out_dim) {
+    if (components.size() != out_dim * dim) {
+        throw std::invalid_argument("components: expected out_dim * dim values");
+    }
+    if (mean.size() != dim) {
+        throw std::invalid_argument("mean: expected dim values");
+    }
+    components_ = std::move(components);
+    mean_ = std::move(mean);
+}
+
+LinearProjection::LinearProjection(const LinearProjection& other)
+    : dim_(other.dim_), out_dim_(other.out_dim_) {
+    std::shared_lock<std::shared_mutex> lock(other.mutex_);
+    components_ = other.components_;
+    mean_ = other.mean_;
+    explained_variance_ = other.explained_variance_;
+    total_variance_ = other.total_variance_;
+}
+
+bool LinearProjection::fitted() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return !components_.empty();
+}
+
+std::vector<float> LinearProjection::components() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return components_;
+}
+
+std::vector<float> LinearProjection::mean() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return mean_;
+}
+
+std::vector<double> LinearProjection::explained_variance() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return explained_variance_;
+}
+
+double LinearProjection::total_variance() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return total_variance_;
+}
+
+void LinearProjection::check_fitted() const {
+    if (components_.empty()) {
+        throw std::runtime_error("projection is not fitted");
+    }
+}
+
+void LinearProjection::check_rows(const StridedMatrix<double>& data) const {
+    if (data.cols != dim_) {
+        throw std::invalid_argument("data: expected " + std::to_string(dim_) + " columns");
+    }
+}
+
+size_t LinearProjection::check_out(size_t out) const {
+    if (out == 0) {
+        return out_dim_;
+    }
+    if (out > out_dim_) {
+        throw std::invalid_argument("dim: at most " + std::to_string(out_dim_));
+    }
+    return out;
+}
+
+void LinearProjection::train(const StridedMatrix<double>& data, const TrainOptions& options) {
+    check_rows(data);
+    const size_t n = data.rows;
+    if (n < 2 || n < out_dim_) {
+        throw std::invalid_argument("need at least max(2, out_dim) training vectors");
+    }
+
+    // Normalised (and optionally centred) sample
+    std::vector<double> mean(dim_, 0.0);
+    std::vector<float> x(n * dim_);
+    for (size_t i = 0; i < n; ++i) {
+        const auto row = data.row(i);
+        const double inv = inverse_norm(row, dim_);
+        for (size_t d = 0; d < dim_; ++d) {
+            const double v = row[d] * inv;
+            x[i * dim_ + d] = static_cast<float>(v);
+            mean[d] += v;
+        }
+    }
+    std::vector<float> mean_f(dim_, 0.0f);
+    if (options.center) {
+        for (size_t d = 0; d < dim_; ++d) {
+            mean_f[d] = static_cast<float>(mean[d] / static_cast<double>(n));
+        }
+    }
+    double total = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        float* row = &x[i * dim_];
+        for (size_t d = 0; d < dim_; ++d) {
+            row[d] -= mean_f[d];
+            total += static_cast<double>(row[d]) * row[d];
+        }
+    }
+
+    // Range finder: Q spans the top of X's column space
+    const size_t l = std::min({out_dim_ + options.oversample, n, dim_});
+    std::mt19937_64 rng(options.seed);
+    std::normal_distribution<double> gaussian;
+    std::vector<double> omega(dim_ * l);
+    for (auto& v : omega) {
+        v = gaussian(rng);
+    }
+    std::vector<double> q(n * l);
+    std::vector<double> z(dim_ * l);
+    linalg::multiply(x.data(), n, dim_, omega.data(), l, q.data());
+    linalg::orthonormalize_columns(q.data(), n, l);
+    for (int it = 0; it < options.power_iterations; ++it) {
+        linalg::multiply_transposed(x.data(), n, dim_, q.data(), l, z.data());
+        linalg::orthonormalize_columns(z.data(), dim_, l);
+        linalg::multiply(x.data(), n, dim_, z.data(), l, q.data());
+        linalg::orthonormalize_columns(q.data(), n, l);
+    }
+
+    // B = Q^T X is l x dim; with Z = B^T, B B^T = Z^T Z
+    linalg::multiply_transposed(x.data(), n, dim_, q.data(), l, z.data());
+    std::vector<double> gram(l * l, 0.0);
+    runtime::parallel_for(runtime::default_pool(), l, 8, [&](size_t begin, size_t end) {
+        for (size_t a = begin; a < end; ++a) {
+            double* g = &gram[a * l];
+            for (size_t j = 0; j < dim_; ++j) {
+                const double* zr = &z[j * l];
+                const double va = zr[a];
+                for (size_t b = a; b < l; ++b) {
+                    g[b] += va * zr[b];
+                }
+            }
+        }
+    });
+    for (size_t a = 0; a < l; ++a) {
+        for (size_t b = 0; b < a; ++b) {
+            gram[a * l + b] = gram[b * l + a];
+        }
+    }
+    std::vector<double> eigenvalues;
+    linalg::symmetric_eigen(gram, l, eigenvalues);
+
+    // Right singular vectors of B: v_i = Z u_i / sigma_i, largest first
+    const double denom = static_cast<double>(n - 1);
+    const double floor = std::max(eigenvalues[l - 1], 0.0) * 1e-12;
+    std::vector<float> components(out_dim_ * dim_, 0.0f);
+    std::vector<double> explained(out_dim_, 0.0);
+    runtime::parallel_for(runtime::default_pool(), out_dim_, 8, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const size_t col = l - 1 - i;
+            const double lambda = eigenvalues[col];
+            if (!(lambda > floor)) {
+                continue;  // beyond the sample's rank
+            }
+            explained[i] = lambda / denom;
+            const double inv_sigma = 1.0 / std::sqrt(lambda);
+            float* row = &components[i * dim_];
+            for (size_t j = 0; j < dim_; ++j) {
+                const double* zr = &z[j * l];
+                double dot = 0.0;
+                for (size_t c = 0; c < l; ++c) {
+                    dot += zr[c] * gram[c * l + col];
+                }
+                row[j] = static_cast<float>(dot * inv_sigma);
+            }
+            fix_sign(row, dim_);
+        }
+    });
+
+    // The fit above only reads the sample; readers block for the swap alone
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    components_ = std::move(components);
+    mean_ = std::move(mean_f);
+    explained_variance_ = std::move(explained);
+    total_variance_ = total / denom;
+}
+
+void LinearProjection::random_orthogonal(uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> gaussian;
+    // Columns of a dim x out_dim Gaussian matrix, orthonormalised
+    std::vector<double> basis(dim_ * out_dim_);
+    for (auto& v : basis) {
+        v = gaussian(rng);
+    }
+    linalg::orthonormalize_columns(basis.data(), dim_, out_dim_);
+
+    std::vector<float> components(out_dim_ * dim_);
+    for (size_t i = 0; i < out_dim_; ++i) {
+        for (size_t j = 0; j < dim_; ++j) {
+            components[i * dim_ + j] = static_cast<float>(basis[j * out_dim_ + i]);
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    components_ = std::move(components);
+    mean_.assign(dim_, 0.0f);
+    explained_variance_.clear();
+    total_variance_ = 0.0;
+}
+
+void LinearProjection::project_into(const StridedMatrix<double>& data, size_t out, bool normalize,
+                                    float* output) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    project_rows(data, out, normalize, output);
+}
+
+void LinearProjection::project_rows(const StridedMatrix<double>& data, size_t out, bool normalize,
+                                    float* output) const {
+    check_fitted();
+    check_rows(data);
+    out = check_out(out);
+    runtime::parallel_for(runtime::default_pool(), data.rows, 64, [&](size_t begin, size_t end) {
+        project_range(data, begin, end, components_.data(), mean_.data(), dim_, out, normalize,
+                      output + begin * out);
+    });
+}
+
+void LinearProjection::project_f16_into(const StridedMatrix<double>& data, size_t out,
+                                        bool normalize, uint16_t* output) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    check_fitted();
+    check_rows(data);
+    out = check_out(out);
+    runtime::parallel_for(runtime::default_pool(), data.rows, 64, [&](size_t begin, size_t end) {
+        std::vector<float> block(linalg::ROW_BLOCK * out);
+        for (size_t r = begin; r < end; r += linalg::ROW_BLOCK) {
+            const size_t stop = std::min(r + linalg::ROW_BLOCK, end);
+            project_range(data, r, stop, components_.data(), mean_.data(), dim_, out, normalize,
+                          block.data());
+            float_to_half(block.data(), (stop - r) * out, output + r * out);
+        }
+    });
+}
+
+std::vector<TradeoffPoint> LinearProjection::tradeoff(const StridedMatrix<double>& data,
+                                                      const std::vector<size_t>& dims,
+                                                      size_t k, size_t queries,
+                                                      uint64_t seed) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    check_fitted();
+    check_rows(data);
+    const size_t n = data.rows;
+    if (k == 0 || n <= k) {
+        throw std::invalid_argument("need more than k rows");
+    }
+    if (dims.empty()) {
+        throw std::invalid_argument("dims must not be empty");
+    }
+    size_t max_dim = 0;
+    for (size_t d : dims) {
+        max_dim = std::max(max_dim, check_out(d == 0 ? out_dim_ : d));
+    }
+
+    std::vector<float> projected(n * max_dim);
+    project_rows(data, max_dim, false, projected.data());
+
+    // Variance about mean() kept by each leading component: the rows are
+    // orthonormal, so the kept share is the projected squared norm
+    double total = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const auto row = data.row(i);
+        const double inv = inverse_norm(row, dim_);
+        for (size_t d = 0; d < dim_; ++d) {
+            const double c = row[d] * inv - mean_[d];
+            total += c * c;
+        }
+    }
+    std::vector<double> column_var(max_dim, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < max_dim; ++j) {
+            const double p = projected[i * max_dim + j];
+            column_var[j] += p * p;
+        }
+    }
+
+    // Per-dimension prefix norms for projected cosine
+    std::vector<double> norms(dims.size() * n);
+    for (size_t t = 0; t < dims.size(); ++t) {
+        const size_t d = dims[t] == 0 ? out_dim_ : dims[t];
+        for (size_t i = 0; i < n; ++i) {
+            const float* p = &projected[i * max_dim];
+            double sum = 0.0;
+            for (size_t j = 0; j < d; ++j) {
+                sum += static_cast<double>(p[j]) * p[j];
+            }
+            norms[t * n + i] = std::sqrt(sum);
+        }
+    }
+
+    std::mt19937_64 rng(seed);
+    std::vector<size_t> rows(n);
+    std::iota(rows.begin(), rows.end(), size_t{0});
+    queries = std::min(queries, n);
+    for (size_t i = 0; i < queries; ++i) {
+        std::swap(rows[i], rows[i + rng() % (n - i)]);
+    }
+    rows.resize(queries);
+    std::sort(rows.begin(), rows.end());
+
+    std::vector<double> recall(queries * dims.size(), 0.0);
+    runtime::parallel_for(runtime::default_pool(), queries, 1, [&](size_t begin, size_t end) {
+        std::vector<double> scores(n);
+        for (size_t qi = begin; qi < end; ++qi) {
+            const size_t row = rows[qi];
+            vector_ops::cosine_similarity_batch_into(data.row(row), data,
+                                                     MutableStridedView<double>(scores.data()));
+            scores[row] = -std::numeric_limits<double>::infinity();
+            const auto exact = accuracy::top_k(StridedView<double>(scores.data()), n, k);
+
+            const float* query = &projected[row * max_dim];
+            for (size_t t = 0; t < dims.size(); ++t) {
+                const size_t d = dims[t] == 0 ? out_dim_ : dims[t];
+                const double q_norm = norms[t * n + row];
+                for (size_t i = 0; i < n; ++i) {
+                    const double denom = q_norm * norms[t * n + i];
+                    scores[i] = denom > 0.0
+                        ? vector_ops::dot_product_f32(query, &projected[i * max_dim], d) / denom
+                        : 0.0;
+                }
+                scores[row] = -std::numeric_limits<double>::infinity();
+                const auto approx = accuracy::top_k(StridedView<double>(scores.data()), n, k);
+                recall[qi * dims.size() + t] =
+                    accuracy::recall_at_k(approx.data(), approx.size(), exact.data(), exact.size(), k);
+            }
+        }
+    });
+
+    std::vector<TradeoffPoint> points(dims.size());
+    for (size_t t = 0; t < dims.size(); ++t) {
+        const size_t d = dims[t] == 0 ? out_dim_ : dims[t];
+        points[t].dim = d;
+        double kept = 0.0;
+        for (size_t j = 0; j < d; ++j) {
+            kept += column_var[j];
+        }
+        points[t].explained_variance_ratio = total > 0.0 ? kept / total : 0.0;
+        double sum = 0.0;
+        for (size_t qi = 0; qi < queries; ++qi) {
+            sum += recall[qi * dims.size() + t];
+        }
+        points[t].recall = queries ? sum / static_cast<double>(queries) : 0.0;
+    }
+    return points;
+}
+
+}  // namespace projection
+}  // namespace axnmihn
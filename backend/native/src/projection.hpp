@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <vector>
+
+#include "strided.hpp"
+
+namespace axnmihn {
+namespace projection {
+
+/**
+ * Reduced dimension's quality on a sample, see LinearProjection::tradeoff.
+ */
+struct TradeoffPoint {
+    size_t dim = 0;
+    double explained_variance_ratio = 0.0;  // Share of the sample's variance about mean() kept
+    double recall = 0.0;                    // Mean recall@k of projected cosine search
+};
+
+/**
+ * Randomized SVD settings for LinearProjection::train.
+ */
+struct TrainOptions {
+    size_t oversample = 10;    // Extra sketch columns for accuracy
+    int power_iterations = 2;  // Subspace iterations; 2 suits slowly decaying spectra
+    bool center = false;       // Subtract the sample mean (classic PCA)
+    uint64_t seed = 0;         // Sketch seed; equal inputs and seeds give equal components
+};
+
+/**
+ * Linear map from dim-dimensional embeddings to out_dim dimensions with
+ * orthonormal rows, for indexes and dedup that can work on 256-512
+ * values instead of 3072.
+ *
+ * Inputs are L2-normalised (embeddings are compared by cosine) and mean()
+ * is subtracted before projecting. Components are either the top right
+ * singular vectors of a sample from a randomized SVD (train) or a random
+ * orthonormal basis (random_orthogonal), and are ordered by explained
+ * variance, so projecting to the first d < out_dim values is the same
+ * fit at d dimensions.
+ *
+ * By default the sample is not centred: the shared mean direction of an
+ * embedding model carries part of every cosine score, so an uncentred fit
+ * keeps projected dot products closest to the original cosines. Centring
+ * (classic PCA) spends the budget on spread around the mean instead.
+ *
+ * Thread-safe: train() and random_orthogonal() swap in the new fit under
+ * an exclusive lock, projections read it under a shared lock.
+ */
+class LinearProjection {
+public:
+    /**
+     * Args:
+     *     dim: Input dimension
+     *     out_dim: Output dimension (1..dim)
+     */
+    LinearProjection(size_t dim, size_t out_dim);
+
+    /**
+     * Restore a fitted projection from components() and mean().
+     *
+     * Args:
+     *     components: out_dim x dim values
+     *     mean: dim values (zeros for no centering)
+     */
+    LinearProjection(size_t dim, size_t out_dim, std::vector<float> components,
+                     std::vector<float> mean);
+
+    LinearProjection(const LinearProjection& other);
+
+    /**
+     * Fit the components with a randomized SVD (Halko et al.).
+     *
+     * A Gaussian sketch of out_dim + oversample columns is refined with
+     * power_iterations rounds of subspace iteration (re-orthonormalised
+     * each round), and the exact SVD of the small projected matrix gives
+     * the components. Matrix products run on the thread pool.
+     *
+     * Args:
+     *     data: Sample of embeddings (n x dim), n >= max(2, out_dim)
+     *     options: Sketch size, iterations, centring and seed
+     */
+    void train(const StridedMatrix<double>& data, const TrainOptions& options = TrainOptions());
+
+    /**
+     * Use a random orthonormal basis (Gaussian rows, Gram-Schmidt) with
+     * no centring. Needs no data; explained_variance() stays empty.
+     */
+    void random_orthogonal(uint64_t seed = 0);
+
+    bool fitted() const;
+    size_t dim() const { return dim_; }
+    size_t out_dim() const { return out_dim_; }
+
+    /** Rows of the projection (out_dim x dim). */
+    std::vector<float> components() const;
+
+    /** Subtracted from normalised inputs (dim values, zeros unless centred). */
+    std::vector<float> mean() const;
+
+    /** Training variance along each component, about mean() (train only). */
+    std::vector<double> explained_variance() const;
+
+    /** Total training variance about mean() (train only). */
+    double total_variance() const;
+
+    /**
+     * Project rows to their first `out` values (0 = out_dim()).
+     *
+     * Args:
+     *     data: Rows to project (n x dim)
+     *     out: Output dimension, at most out_dim()
+     *     normalize: L2-normalise each projected row
+     *     output: n x out float32 values
+     */
+    void project_into(const StridedMatrix<double>& data, size_t out, bool normalize,
+                      float* output) const;
+
+    /** project_into() rounded to IEEE half precision (n x out bits). */
+    void project_f16_into(const StridedMatrix<double>& data, size_t out, bool normalize,
+                          uint16_t* output) const;
+
+    /**
+     * Explained variance and search recall for each candidate dimension.
+     *
+     * `queries` rows sampled with `seed` are searched against every row
+     * of `data` (excluding themselves): exact cosine in dim dimensions is
+     * the ground truth, cosine of the first d projected values the
+     * approximation. Explained variance is measured on `data` about
+     * mean(), so it is available for random projections too.
+     *
+     * Args:
+     *     data: Held-out sample (n x dim), n > k
+     *     dims: Candidate dimensions, each at most out_dim()
+     *     k: Neighbours per query
+     *     queries: Number of query rows (capped at n)
+     *     seed: Query sampling seed
+     */
+    std::vector<TradeoffPoint> tradeoff(const StridedMatrix<double>& data,
+                                        const std::vector<size_t>& dims, size_t k,
+                                        size_t queries, uint64_t seed = 0) const;
+
+private:
+    // Callers hold mutex_
+    void check_fitted() const;
+    void project_rows(const StridedMatrix<double>& data, size_t out, bool normalize,
+                      float* output) const;
+
+    void check_rows(const StridedMatrix<double>& data) const;
+    size_t check_out(size_t out) const;
+
+    size_t dim_;
+    size_t out_dim_;
+    std::vector<float> components_;
+    std::vector<float> mean_;
+    std::vector<double> explained_variance_;
+    double total_variance_ = 0.0;
+    mutable std::shared_mutex mutex_;
+};
+
+/**
+ * Round float32 values to IEEE 754 half precision (round to nearest
+ * even, overflow to infinity), identical to numpy's astype(float16).
+ * Uses F16C when the CPU has it.
+ */
+void float_to_half(const float* input, size_t n, uint16_t* output);
+
+/** Widen IEEE half-precision bits to float32 (exact; F16C when available). */
+void half_to_float(const uint16_t* input, size_t n, float* output);
+
+}  // namespace projection
+}  // namespace axnmihn
@@ -0,0 +1,79 @@
+#include "simd.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace axnmihn {
+namespace simd {
+
+namespace {
+
+bool cpu_has_avx2() {
+#if defined(HAS_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(HAS_AVX2)
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* compiled_name() {
+#if defined(HAS_AVX2)
+    return "avx2";
+#elif defined(HAS_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+bool compiled_supported() {
+#if defined(HAS_AVX2)
+    return cpu_has_avx2();
+#elif defined(HAS_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// true when kernels should take the compiled SIMD path
+std::atomic<bool> g_vector{compiled_supported()};
+
+}  // anonymous namespace
+
+bool use_avx2() {
+#ifdef HAS_AVX2
+    return g_vector.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+}
+
+const char* active() {
+    return g_vector.load(std::memory_order_relaxed) ? compiled_name() : "scalar";
+}
+
+void set_variant(const std::string& variant) {
+    if (variant == "auto") {
+        g_vector.store(compiled_supported(), std::memory_order_relaxed);
+    } else if (variant == "scalar") {
+        g_vector.store(false, std::memory_order_relaxed);
+    } else if (variant == compiled_name() && compiled_supported()) {
+        g_vector.store(true, std::memory_order_relaxed);
+    } else {
+        throw std::invalid_argument("SIMD variant not available: " + variant);
+    }
+}
+
+std::vector<std::string> available() {
+    std::vector<std::string> variants{"scalar"};
+    if (compiled_supported()) {
+        variants.emplace_back(compiled_name());
+    }
+    return variants;
+}
+
+}  // namespace simd
+}  // namespace axnmihn
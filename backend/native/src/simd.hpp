@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace axnmihn {
+namespace simd {
+
+/**
+ * Runtime selection between the compiled SIMD kernels and their scalar
+ * fallbacks.
+ *
+ * Kernels built with HAS_AVX2 check use_avx2() before taking the
+ * intrinsic path, so the scalar path can be exercised (and benchmarked)
+ * from the same binary. The default is the best variant that was both
+ * compiled in and is supported by the running CPU.
+ */
+bool use_avx2();
+
+/**
+ * Name of the variant kernels currently take ("avx2", "neon" or "scalar").
+ */
+const char* active();
+
+/**
+ * Force a variant: "auto", "scalar", or the compiled variant's name.
+ *
+ * Args:
+ *     variant: Variant name
+ *
+ * Throws:
+ *     std::invalid_argument if the variant is unknown, not compiled in,
+ *     or not supported by this CPU.
+ */
+void set_variant(const std::string& variant);
+
+/**
+ * Variants selectable on this build and CPU, scalar first.
+ */
+std::vector<std::string> available();
+
+}  // namespace simd
+}  // namespace axnmihn
@@ -0,0 +1,298 @@
+#include "simhash.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+namespace axnmihn {
+namespace simhash {
+
+namespace {
+
+inline bool is_continuation(uint8_t c) { return (c & 0xC0) == 0x80; }
+
+// Reused per thread across the texts of a batch
+struct Scratch {
+    std::string text;
+    std::vector<size_t> starts;
+};
+
+uint64_t fingerprint_with(std::string_view text, const SimHashOptions& options, Scratch& scratch) {
+    hashing::NormalizeOptions normalize = options.normalize;
+    if (options.kind == ShingleKind::Word) {
+        normalize.collapse_whitespace = true;
+    }
+    hashing::normalize_into(text, normalize, scratch.text);
+    const std::string& s = scratch.text;
+    if (s.empty()) {
+        return 0;
+    }
+
+    // Byte offset where each unit (word or code point) starts
+    auto& starts = scratch.starts;
+    starts.clear();
+    starts.push_back(0);
+    for (size_t i = 1; i < s.size(); ++i) {
+        const uint8_t c = static_cast<uint8_t>(s[i]);
+        if (options.kind == ShingleKind::Word ? s[i - 1] == ' ' : !is_continuation(c)) {
+            starts.push_back(i);
+        }
+    }
+
+    const size_t units = starts.size();
+    const size_t k = std::max<size_t>(options.shingle_size, 1);
+    if (units <= k) {
+        return hashing::xxh3_64(s.data(), s.size(), options.seed);
+    }
+
+    int32_t counts[64] = {};
+    for (size_t i = 0; i + k <= units; ++i) {
+        const size_t begin = starts[i];
+        size_t end = i + k < units ? starts[i + k] : s.size();
+        if (options.kind == ShingleKind::Word && i + k < units) {
+            --end;  // Drop the separating space
+        }
+        const uint64_t h = hashing::xxh3_64(s.data() + begin, end - begin, options.seed);
+        for (int b = 0; b < 64; ++b) {
+            counts[b] += static_cast<int32_t>((h >> b) & 1) * 2 - 1;
+        }
+    }
+
+    uint64_t fp = 0;
+    for (int b = 0; b < 64; ++b) {
+        if (counts[b] > 0) {
+            fp |= uint64_t(1) << b;
+        }
+    }
+    return fp;
+}
+
+struct Candidate {
+    uint32_t i;
+    uint32_t j;
+    int distance;
+
+    bool operator<(const Candidate& o) const { return std::tie(i, j) < std::tie(o.i, o.j); }
+};
+
+// Pairs within layout.max_distance, one band per task; a pair is kept
+// only by the first band its fingerprints share
+std::vector<Candidate> collect_pairs(const std::vector<uint64_t>& fps, const BandLayout& layout) {
+    std::vector<std::vector<Candidate>> per_band(layout.size());
+    runtime::parallel_for(runtime::default_pool(), layout.size(), 1,
+        [&](size_t begin, size_t end) {
+            std::vector<std::pair<uint64_t, uint32_t>> keyed(fps.size());
+            for (size_t band = begin; band < end; ++band) {
+                for (size_t i = 0; i < fps.size(); ++i) {
+                    keyed[i] = {layout.key(fps[i], band), static_cast<uint32_t>(i)};
+                }
+                std::sort(keyed.begin(), keyed.end());
+
+                auto& out = per_band[band];
+                for (size_t r = 0; r < keyed.size();) {
+                    size_t run_end = r + 1;
+                    while (run_end < keyed.size() && keyed[run_end].first == keyed[r].first) {
+                        ++run_end;
+                    }
+                    for (size_t a = r; a < run_end; ++a) {
+                        const uint64_t fa = fps[keyed[a].second];
+                        for (size_t b = a + 1; b < run_end; ++b) {
+                            const uint64_t fb = fps[keyed[b].second];
+                            const int d = hamming(fa, fb);
+                            if (d <= layout.max_distance && layout.first_shared_band(fa, fb, band)) {
+                                out.push_back(Candidate{keyed[a].second, keyed[b].second, d});
+                            }
+                        }
+                    }
+                    r = run_end;
+                }
+            }
+        });
+
+    std::vector<Candidate> pairs;
+    for (auto& band : per_band) {
+        pairs.insert(pairs.end(), band.begin(), band.end());
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+uint32_t find_root(std::vector<uint32_t>& parent, uint32_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+}  // anonymous namespace
+
+uint64_t fingerprint(std::string_view text, const SimHashOptions& options) {
+    Scratch scratch;
+    return fingerprint_with(text, options, scratch);
+}
+
+std::vector<uint64_t> fingerprint_batch(const std::vector<std::string>& texts,
+                                        const SimHashOptions& options) {
+    std::vector<uint64_t> out(texts.size());
+    runtime::parallel_for(runtime::default_pool(), texts.size(), 64,
+        [&](size_t begin, size_t end) {
+            Scratch scratch;
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = fingerprint_with(texts[i], options, scratch);
+            }
+        });
+    return out;
+}
+
+BandLayout::BandLayout(int max_distance_, int bands) : max_distance(max_distance_) {
+    if (max_distance < 0 || max_distance > 63) {
+        throw std::invalid_argument("max_distance must be in 0..63");
+    }
+    if (bands == 0) {
+        bands = max_distance + 1;
+    }
+    if (bands <= max_distance || bands > 64) {
+        throw std::invalid_argument("bands must be in max_distance+1..64");
+    }
+    const int base = 64 / bands;
+    const int extra = 64 % bands;
+    int offset = 0;
+    for (int b = 0; b < bands; ++b) {
+        const int width = base + (b < extra ? 1 : 0);
+        shift.push_back(offset);
+        mask.push_back(width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1);
+        offset += width;
+    }
+}
+
+bool BandLayout::first_shared_band(uint64_t a, uint64_t b, size_t band) const {
+    for (size_t earlier = 0; earlier < band; ++earlier) {
+        if (key(a, earlier) == key(b, earlier)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SimHashIndex::SimHashIndex(int max_distance, int bands)
+    : layout_(max_distance, bands), tables_(layout_.size()) {}
+
+uint32_t SimHashIndex::add(uint64_t fp) {
+    if (fingerprints_.size() >= UINT32_MAX) {
+        throw std::length_error("SimHashIndex is full");
+    }
+    const uint32_t id = static_cast<uint32_t>(fingerprints_.size());
+    fingerprints_.push_back(fp);
+    for (size_t band = 0; band < layout_.size(); ++band) {
+        tables_[band][layout_.key(fp, band)].push_back(id);
+    }
+    return id;
+}
+
+std::vector<NearMatch> SimHashIndex::query(uint64_t fp) const {
+    std::vector<NearMatch> matches;
+    for (size_t band = 0; band < layout_.size(); ++band) {
+        const auto it = tables_[band].find(layout_.key(fp, band));
+        if (it == tables_[band].end()) {
+            continue;
+        }
+        for (uint32_t id : it->second) {
+            const uint64_t other = fingerprints_[id];
+            const int d = hamming(fp, other);
+            if (d <= layout_.max_distance && layout_.first_shared_band(fp, other, band)) {
+                matches.push_back(NearMatch{id, d});
+            }
+        }
+    }
+    std::sort(matches.begin(), matches.end(), [](const NearMatch& a, const NearMatch& b) {
+        return a.distance != b.distance ? a.distance < b.distance : a.id < b.id;
+    });
+    return matches;
+}
+
+std::vector<NearMatch> SimHashIndex::add_and_query(uint64_t fp, uint32_t* id) {
+    auto matches = query(fp);
+    const uint32_t added = add(fp);
+    if (id != nullptr) {
+        *id = added;
+    }
+    return matches;
+}
+
+void SimHashIndex::clear() {
+    fingerprints_.clear();
+    for (auto& table : tables_) {
+        table.clear();
+    }
+}
+
+PairList near_duplicate_pairs(const std::vector<uint64_t>& fingerprints, int max_distance,
+                              int bands) {
+    const BandLayout layout(max_distance, bands);
+    PairList pairs;
+    for (const auto& c : collect_pairs(fingerprints, layout)) {
+        pairs.add(c.i, c.j, 1.0 - c.distance / 64.0);
+    }
+    return pairs;
+}
+
+hashing::DuplicateGroups near_duplicate_groups(const std::vector<uint64_t>& fingerprints,
+                                               int max_distance, int bands) {
+    const BandLayout layout(max_distance, bands);
+    const size_t n = fingerprints.size();
+
+    // Compare distinct fingerprints only, so exact duplicates cost nothing
+    std::vector<uint64_t> unique(fingerprints);
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+    std::vector<uint32_t> slot(n);
+    for (size_t i = 0; i < n; ++i) {
+        slot[i] = static_cast<uint32_t>(
+            std::lower_bound(unique.begin(), unique.end(), fingerprints[i]) - unique.begin());
+    }
+
+    std::vector<uint32_t> parent(unique.size());
+    std::iota(parent.begin(), parent.end(), 0u);
+    for (const auto& c : collect_pairs(unique, layout)) {
+        const uint32_t a = find_root(parent, c.i);
+        const uint32_t b = find_root(parent, c.j);
+        if (a != b) {
+            parent[std::max(a, b)] = std::min(a, b);
+        }
+    }
+
+    std::vector<uint32_t> size(unique.size(), 0);
+    std::vector<uint32_t> root(n);
+    for (size_t i = 0; i < n; ++i) {
+        root[i] = find_root(parent, slot[i]);
+        ++size[root[i]];
+    }
+
+    // Number groups in order of their first member
+    std::vector<uint32_t> group_of(unique.size(), UINT32_MAX);
+    std::vector<std::vector<uint32_t>> members;
+    for (size_t i = 0; i < n; ++i) {
+        if (size[root[i]] < 2) {
+            continue;
+        }
+        if (group_of[root[i]] == UINT32_MAX) {
+            group_of[root[i]] = static_cast<uint32_t>(members.size());
+            members.emplace_back();
+        }
+        members[group_of[root[i]]].push_back(static_cast<uint32_t>(i));
+    }
+
+    hashing::DuplicateGroups groups;
+    groups.offsets.reserve(members.size() + 1);
+    for (const auto& group : members) {
+        groups.indices.insert(groups.indices.end(), group.begin(), group.end());
+        groups.offsets.push_back(static_cast<uint32_t>(groups.indices.size()));
+    }
+    return groups;
+}
+
+}  // namespace simhash
+}  // namespace axnmihn
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "content_hash.hpp"
+#include "pair_list.hpp"
+
+namespace axnmihn {
+namespace simhash {
+
+enum class ShingleKind {
+    Word,   // shingle_size consecutive whitespace-separated words
+    Char    // shingle_size consecutive code points
+};
+
+/**
+ * How a text is turned into shingles before fingerprinting.
+ *
+ * Text is normalized first (see hashing::NormalizeOptions). Word
+ * shingles always collapse whitespace so words are split on single
+ * spaces. A text with fewer than shingle_size units is one shingle;
+ * empty text has fingerprint 0.
+ *
+ * With word pairs, a one-to-three word edit of a 100+ word message moves
+ * the fingerprint by about 2-8 bits while unrelated messages stay 20+
+ * bits apart, hence the max_distance default of 6 below.
+ */
+struct SimHashOptions {
+    ShingleKind kind = ShingleKind::Word;
+    size_t shingle_size = 2;
+    hashing::NormalizeOptions normalize{true, true, 0};
+    uint64_t seed = 0;
+};
+
+/**
+ * 64-bit SimHash of a text: the sign of the per-bit sum over the XXH3
+ * hashes of its shingles (each occurrence weighs 1).
+ *
+ * Args:
+ *     text: UTF-8 text
+ *     options: Shingling and normalization
+ *
+ * Returns:
+ *     Fingerprint; near-identical texts differ in few bits
+ */
+uint64_t fingerprint(std::string_view text, const SimHashOptions& options = SimHashOptions());
+
+/**
+ * fingerprint() for each text, in parallel for large batches.
+ */
+std::vector<uint64_t> fingerprint_batch(
+    const std::vector<std::string>& texts,
+    const SimHashOptions& options = SimHashOptions()
+);
+
+inline int hamming(uint64_t a, uint64_t b) { return __builtin_popcountll(a ^ b); }
+
+/**
+ * Split of the 64 fingerprint bits into bands.
+ *
+ * Two fingerprints within max_distance bits agree exactly on at least
+ * one of max_distance + 1 bands (pigeonhole), so looking fingerprints up
+ * by band value finds every candidate without a full scan.
+ */
+struct BandLayout {
+    /**
+     * Args:
+     *     max_distance: Largest Hamming distance reported (0..63)
+     *     bands: Band count, max_distance + 1 when 0; must exceed
+     *         max_distance and be at most 64
+     */
+    BandLayout(int max_distance, int bands);
+
+    int max_distance;
+    std::vector<int> shift;
+    std::vector<uint64_t> mask;
+
+    size_t size() const { return shift.size(); }
+    uint64_t key(uint64_t fp, size_t band) const { return (fp >> shift[band]) & mask[band]; }
+
+    // True when `band` is the first band on which a and b agree, so a
+    // pair found through several bands is reported once
+    bool first_shared_band(uint64_t a, uint64_t b, size_t band) const;
+};
+
+struct NearMatch {
+    uint32_t id;
+    int distance;
+};
+
+/**
+ * Incremental banded index of fingerprints.
+ *
+ * Fingerprints get ids in insertion order. Each band keeps a hash table
+ * from band value to ids, so a query costs one lookup per band plus a
+ * popcount per candidate.
+ */
+class SimHashIndex {
+public:
+    explicit SimHashIndex(int max_distance = 6, int bands = 0);
+
+    /** Add a fingerprint and return its id. */
+    uint32_t add(uint64_t fp);
+
+    /**
+     * Ids within the index's max_distance of fp.
+     *
+     * Returns:
+     *     Matches ordered by distance, then id
+     */
+    std::vector<NearMatch> query(uint64_t fp) const;
+
+    /**
+     * query() then add(): matches among earlier fingerprints only.
+     */
+    std::vector<NearMatch> add_and_query(uint64_t fp, uint32_t* id = nullptr);
+
+    uint64_t fingerprint(uint32_t id) const { return fingerprints_.at(id); }
+    size_t size() const { return fingerprints_.size(); }
+    int max_distance() const { return layout_.max_distance; }
+    size_t bands() const { return layout_.size(); }
+    void clear();
+
+private:
+    BandLayout layout_;
+    std::vector<uint64_t> fingerprints_;
+    std::vector<std::unordered_map<uint64_t, std::vector<uint32_t>>> tables_;
+};
+
+/**
+ * Every pair (i < j) within max_distance bits, found by sorting each
+ * band's values instead of comparing all pairs.
+ *
+ * Returns:
+ *     Pairs ordered by (i, j); similarity is 1 - distance / 64
+ */
+PairList near_duplicate_pairs(
+    const std::vector<uint64_t>& fingerprints,
+    int max_distance = 6,
+    int bands = 0
+);
+
+/**
+ * Connected components of the near_duplicate_pairs() graph.
+ *
+ * Only groups with two or more members are returned; indices are
+ * ascending and groups are ordered by their first index.
+ */
+hashing::DuplicateGroups near_duplicate_groups(
+    const std::vector<uint64_t>& fingerprints,
+    int max_distance = 6,
+    int bands = 0
+);
+
+}  // namespace simhash
+}  // namespace axnmihn
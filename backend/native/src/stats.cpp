@@ -0,0 +1,276 @@
+#include "stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+
+namespace axnmihn {
+namespace stats {
+
+namespace {
+
+using Counter = std::atomic<uint64_t>;
+
+// Single-writer increment: the owning thread is the only writer, so a
+// relaxed load + store is enough and avoids a locked RMW on the hot path.
+inline void bump(Counter& c, uint64_t n) {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+struct ProbeCounters {
+    Counter calls{0};
+    Counter elements{0};
+    Counter bytes_in{0};
+    Counter bytes_out{0};
+    Counter total_ns{0};
+    Counter kernel_ns{0};
+    Counter max_ns{0};
+    std::array<Counter, NUM_BUCKETS> buckets{};
+};
+
+// Plain totals used for retired threads and the reset baseline
+struct Totals {
+    uint64_t calls = 0;
+    uint64_t elements = 0;
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+    uint64_t total_ns = 0;
+    uint64_t kernel_ns = 0;
+    uint64_t max_ns = 0;
+    std::vector<uint64_t> buckets;
+
+    void add(const ProbeCounters& c) {
+        calls += c.calls.load(std::memory_order_relaxed);
+        elements += c.elements.load(std::memory_order_relaxed);
+        bytes_in += c.bytes_in.load(std::memory_order_relaxed);
+        bytes_out += c.bytes_out.load(std::memory_order_relaxed);
+        total_ns += c.total_ns.load(std::memory_order_relaxed);
+        kernel_ns += c.kernel_ns.load(std::memory_order_relaxed);
+        max_ns = std::max(max_ns, c.max_ns.load(std::memory_order_relaxed));
+        if (buckets.empty()) {
+            buckets.assign(NUM_BUCKETS, 0);
+        }
+        for (size_t b = 0; b < NUM_BUCKETS; ++b) {
+            buckets[b] += c.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+};
+
+std::atomic<bool> g_enabled{true};
+
+}  // anonymous namespace
+
+struct ThreadCounters {
+    std::array<std::atomic<ProbeCounters*>, MAX_PROBES> probes{};
+
+    ThreadCounters();
+    ~ThreadCounters();
+
+    ProbeCounters& probe(uint32_t id) {
+        ProbeCounters* p = probes[id].load(std::memory_order_acquire);
+        if (!p) {
+            p = new ProbeCounters();
+            probes[id].store(p, std::memory_order_release);
+        }
+        return *p;
+    }
+};
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::array<std::atomic<const char*>, MAX_PROBES> literals{};
+    std::vector<ThreadCounters*> threads;
+    std::vector<Totals> retired;   // counters of exited threads, per probe
+    std::vector<Totals> baseline;  // snapshot at the last reset(), per probe
+};
+
+// Leaked so thread-exit destructors can run during static teardown
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+}  // anonymous namespace
+
+ThreadCounters::ThreadCounters() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.threads.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.threads.erase(std::remove(reg.threads.begin(), reg.threads.end(), this), reg.threads.end());
+    for (size_t id = 0; id < MAX_PROBES; ++id) {
+        ProbeCounters* p = probes[id].load(std::memory_order_acquire);
+        if (p) {
+            reg.retired[id].add(*p);
+            delete p;
+        }
+    }
+}
+
+size_t bucket_index(uint64_t ns) {
+    if (ns < SUB_BUCKETS) {
+        return static_cast<size_t>(ns);
+    }
+    unsigned exponent = 63u - static_cast<unsigned>(__builtin_clzll(ns));
+    size_t sub = static_cast<size_t>((ns >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t bucket_lower_bound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    unsigned exponent = static_cast<unsigned>(index / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+    uint64_t sub = index % SUB_BUCKETS;
+    return (SUB_BUCKETS + sub) << (exponent - SUB_BUCKET_BITS);
+}
+
+uint64_t bucket_upper_bound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    unsigned exponent = static_cast<unsigned>(index / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+    return bucket_lower_bound(index) + (uint64_t{1} << (exponent - SUB_BUCKET_BITS)) - 1;
+}
+
+uint32_t register_probe(const char* name) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (size_t i = 0; i < reg.names.size(); ++i) {
+        if (reg.names[i] == name) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    if (reg.names.size() >= MAX_PROBES) {
+        // Out of slots: share the last one rather than failing a call
+        return static_cast<uint32_t>(MAX_PROBES - 1);
+    }
+    reg.literals[reg.names.size()].store(name, std::memory_order_release);
+    reg.names.emplace_back(name);
+    reg.retired.emplace_back();
+    reg.baseline.emplace_back();
+    return static_cast<uint32_t>(reg.names.size() - 1);
+}
+
+const char* probe_name(uint32_t probe) {
+    const char* name = probe < MAX_PROBES
+        ? registry().literals[probe].load(std::memory_order_acquire) : nullptr;
+    return name ? name : "unknown";
+}
+
+bool enabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+void set_enabled(bool on) {
+    g_enabled.store(on, std::memory_order_relaxed);
+}
+
+ThreadCounters* thread_counters() {
+    thread_local ThreadCounters counters;
+    return &counters;
+}
+
+void record(ThreadCounters* counters, uint32_t probe, uint64_t ns, uint64_t kernel_ns,
+            uint64_t elements, uint64_t bytes_in, uint64_t bytes_out) {
+    ProbeCounters& c = counters->probe(probe);
+    bump(c.calls, 1);
+    bump(c.elements, elements);
+    bump(c.bytes_in, bytes_in);
+    bump(c.bytes_out, bytes_out);
+    bump(c.total_ns, ns);
+    bump(c.kernel_ns, kernel_ns);
+    if (ns > c.max_ns.load(std::memory_order_relaxed)) {
+        c.max_ns.store(ns, std::memory_order_relaxed);
+    }
+    bump(c.buckets[bucket_index(ns)], 1);
+}
+
+namespace {
+
+// Raw totals per probe (live + retired threads). Caller holds the lock.
+std::vector<Totals> collect(Registry& reg) {
+    std::vector<Totals> totals = reg.retired;
+    for (ThreadCounters* t : reg.threads) {
+        for (size_t id = 0; id < totals.size(); ++id) {
+            ProbeCounters* p = t->probes[id].load(std::memory_order_acquire);
+            if (p) {
+                totals[id].add(*p);
+            }
+        }
+    }
+    return totals;
+}
+
+}  // anonymous namespace
+
+std::vector<ProbeStats> snapshot() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<Totals> totals = collect(reg);
+
+    std::vector<ProbeStats> result;
+    for (size_t id = 0; id < totals.size(); ++id) {
+        const Totals& now = totals[id];
+        const Totals& base = reg.baseline[id];
+        if (now.calls <= base.calls) {
+            continue;
+        }
+
+        ProbeStats s;
+        s.name = reg.names[id];
+        s.calls = now.calls - base.calls;
+        s.elements = now.elements - base.elements;
+        s.bytes_in = now.bytes_in - base.bytes_in;
+        s.bytes_out = now.bytes_out - base.bytes_out;
+        s.total_ns = now.total_ns - base.total_ns;
+        s.kernel_ns = now.kernel_ns - base.kernel_ns;
+        s.buckets.assign(NUM_BUCKETS, 0);
+        size_t highest = 0;
+        for (size_t b = 0; b < NUM_BUCKETS; ++b) {
+            uint64_t before = base.buckets.empty() ? 0 : base.buckets[b];
+            s.buckets[b] = now.buckets[b] - before;
+            if (s.buckets[b]) {
+                highest = b;
+            }
+        }
+        // The raw max may predate the reset; clamp it to the highest live bucket
+        s.max_ns = std::min(now.max_ns, bucket_upper_bound(highest));
+        result.push_back(std::move(s));
+    }
+    return result;
+}
+
+void reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.baseline = collect(reg);
+}
+
+uint64_t ProbeStats::percentile(double q) const {
+    if (calls == 0 || buckets.empty()) {
+        return 0;
+    }
+    q = std::min(1.0, std::max(0.0, q));
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(calls) + 0.5);
+    rank = std::max<uint64_t>(1, std::min(rank, calls));
+    uint64_t seen = 0;
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            return std::min(bucket_upper_bound(b), max_ns);
+        }
+    }
+    return max_ns;
+}
+
+}  // namespace stats
+}  // namespace axnmihn
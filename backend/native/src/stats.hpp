@@ -0,0 +1,188 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "simd.hpp"
+#include "trace.hpp"
+
+namespace axnmihn {
+namespace stats {
+
+/**
+ * Log-linear latency buckets (HDR-style): exact below 8 ns, then 8
+ * sub-buckets per power of two, so any recorded value is within 12.5%
+ * of its bucket's bounds.
+ */
+constexpr unsigned SUB_BUCKET_BITS = 3;
+constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+constexpr size_t NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+constexpr size_t MAX_PROBES = 128;
+
+size_t bucket_index(uint64_t ns);
+uint64_t bucket_lower_bound(size_t index);
+uint64_t bucket_upper_bound(size_t index);
+
+/**
+ * Register a named entry point and return its probe id. Registering the
+ * same name again returns the same id. Call once per site (e.g. from a
+ * function-local static). `name` must be a string literal: trace spans
+ * keep the pointer.
+ */
+uint32_t register_probe(const char* name);
+
+/** Name a probe was registered with (lock-free; used for trace spans). */
+const char* probe_name(uint32_t probe);
+
+bool enabled();
+void set_enabled(bool on);
+
+/**
+ * Counters for one probe, merged across threads.
+ */
+struct ProbeStats {
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t elements = 0;
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+    uint64_t total_ns = 0;
+    uint64_t kernel_ns = 0;
+    uint64_t max_ns = 0;
+    std::vector<uint64_t> buckets;  // NUM_BUCKETS latency counts
+
+    /** Latency at quantile q (0-1), as the bucket's upper bound. */
+    uint64_t percentile(double q) const;
+};
+
+/**
+ * Merge every thread's counters (live and exited) for probes that have
+ * been called since the last reset().
+ */
+std::vector<ProbeStats> snapshot();
+
+/**
+ * Zero the counters seen by snapshot(). Implemented as a baseline, so
+ * writers never need to synchronise with it.
+ */
+void reset();
+
+/**
+ * Per-thread counter block. Each thread only writes its own block, so
+ * updates are plain relaxed load/store pairs (no locked instructions);
+ * readers sum blocks with relaxed loads.
+ */
+struct ThreadCounters;
+
+ThreadCounters* thread_counters();
+void record(ThreadCounters* counters, uint32_t probe, uint64_t ns, uint64_t kernel_ns,
+            uint64_t elements, uint64_t bytes_in, uint64_t bytes_out);
+
+/**
+ * Times one entry-point call and records it on destruction.
+ *
+ * Usage:
+ *     static const uint32_t probe = stats::register_probe("vector_ops.foo");
+ *     stats::CallScope call(probe);
+ *     call.elements(n);
+ *     { auto timer = call.kernel(); run_kernel(); }
+ *
+ * With tracing on, the call and its kernel()/phase() sections are also
+ * emitted as trace spans carrying the batch size and SIMD variant. When
+ * both stats and tracing are off the scope does not read the clock.
+ */
+class CallScope {
+public:
+    explicit CallScope(uint32_t probe)
+        : probe_(probe), stats_(enabled()), trace_(trace::enabled()) {
+        if (stats_ || trace_) {
+            start_ = trace::now_ns();
+        }
+    }
+
+    ~CallScope() {
+        if (stats_ || trace_) {
+            const uint64_t end = trace::now_ns();
+            if (stats_) {
+                record(thread_counters(), probe_, end - start_, kernel_ns_,
+                       elements_, bytes_in_, bytes_out_);
+            }
+            if (trace_) {
+                trace::record(probe_name(probe_), "call", start_, end, elements_, simd_);
+            }
+        }
+    }
+
+    CallScope(const CallScope&) = delete;
+    CallScope& operator=(const CallScope&) = delete;
+
+    void elements(uint64_t n) { elements_ += n; }
+    void bytes_in(uint64_t n) { bytes_in_ += n; }
+    void bytes_out(uint64_t n) { bytes_out_ += n; }
+
+    /** SIMD path this call actually took (defaults to the active variant). */
+    void simd(const char* variant) { simd_ = variant; }
+
+    /**
+     * RAII timer for one phase of the call ("marshal", "decode",
+     * "kernel", "convert"). Kernel phases also count towards kernel_ns.
+     */
+    class PhaseTimer {
+    public:
+        PhaseTimer(CallScope& scope, const char* name, bool kernel)
+            : scope_(scope), name_(name), kernel_(kernel && scope.stats_),
+              running_(kernel_ || scope.trace_) {
+            if (running_) {
+                start_ = trace::now_ns();
+            }
+        }
+        ~PhaseTimer() { stop(); }
+
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+        /** End the phase before the end of its scope. */
+        void stop() {
+            if (!running_) {
+                return;
+            }
+            running_ = false;
+            const uint64_t end = trace::now_ns();
+            if (kernel_) {
+                scope_.kernel_ns_ += end - start_;
+            }
+            if (scope_.trace_) {
+                trace::record(name_, probe_name(scope_.probe_), start_, end,
+                              scope_.elements_, scope_.simd_);
+            }
+        }
+
+    private:
+        CallScope& scope_;
+        const char* name_;
+        bool kernel_;
+        bool running_;
+        uint64_t start_ = 0;
+    };
+
+    PhaseTimer kernel() { return PhaseTimer(*this, "kernel", true); }
+    PhaseTimer phase(const char* name) { return PhaseTimer(*this, name, false); }
+
+private:
+    uint32_t probe_;
+    bool stats_;
+    bool trace_;
+    uint64_t start_ = 0;
+    uint64_t kernel_ns_ = 0;
+    uint64_t elements_ = 0;
+    uint64_t bytes_in_ = 0;
+    uint64_t bytes_out_ = 0;
+    const char* simd_ = ::axnmihn::simd::active();
+};
+
+}  // namespace stats
+}  // namespace axnmihn
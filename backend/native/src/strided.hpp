@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+
+namespace axnmihn {
+
+/**
+ * Read-only view over a 1-D column with an arbitrary byte stride.
+ *
+ * Mirrors NumPy's layout model so kernels can read slices, transposes
+ * and structured-array fields in place instead of requiring a copy.
+ */
+template<typename T>
+struct StridedView {
+    const char* data = nullptr;
+    std::ptrdiff_t stride = sizeof(T);  // bytes between consecutive elements
+
+    StridedView() = default;
+    StridedView(const T* ptr) : data(reinterpret_cast<const char*>(ptr)) {}
+    StridedView(const void* ptr, std::ptrdiff_t byte_stride)
+        : data(static_cast<const char*>(ptr)), stride(byte_stride) {}
+
+    const T& operator[](size_t i) const {
+        return *reinterpret_cast<const T*>(data + static_cast<std::ptrdiff_t>(i) * stride);
+    }
+
+    bool contiguous() const { return stride == static_cast<std::ptrdiff_t>(sizeof(T)); }
+    const T* ptr() const { return reinterpret_cast<const T*>(data); }
+};
+
+/**
+ * Writable counterpart of StridedView, used for caller-provided outputs.
+ */
+template<typename T>
+struct MutableStridedView {
+    char* data = nullptr;
+    std::ptrdiff_t stride = sizeof(T);
+
+    MutableStridedView() = default;
+    MutableStridedView(T* ptr) : data(reinterpret_cast<char*>(ptr)) {}
+    MutableStridedView(void* ptr, std::ptrdiff_t byte_stride)
+        : data(static_cast<char*>(ptr)), stride(byte_stride) {}
+
+    T& operator[](size_t i) const {
+        return *reinterpret_cast<T*>(data + static_cast<std::ptrdiff_t>(i) * stride);
+    }
+
+    bool contiguous() const { return stride == static_cast<std::ptrdiff_t>(sizeof(T)); }
+    T* ptr() const { return reinterpret_cast<T*>(data); }
+};
+
+/**
+ * Read-only view over a 2-D row-major-ish matrix with byte strides on
+ * both axes. Rows are contiguous when col_stride == sizeof(T).
+ */
+template<typename T>
+struct StridedMatrix {
+    const char* data = nullptr;
+    size_t rows = 0;
+    size_t cols = 0;
+    std::ptrdiff_t row_stride = 0;
+    std::ptrdiff_t col_stride = sizeof(T);
+
+    StridedMatrix() = default;
+    StridedMatrix(const T* ptr, size_t n_rows, size_t n_cols)
+        : data(reinterpret_cast<const char*>(ptr)), rows(n_rows), cols(n_cols),
+          row_stride(static_cast<std::ptrdiff_t>(n_cols * sizeof(T))) {}
+    StridedMatrix(const void* ptr, size_t n_rows, size_t n_cols,
+                  std::ptrdiff_t rstride, std::ptrdiff_t cstride)
+        : data(static_cast<const char*>(ptr)), rows(n_rows), cols(n_cols),
+          row_stride(rstride), col_stride(cstride) {}
+
+    StridedView<T> row(size_t i) const {
+        return StridedView<T>(data + static_cast<std::ptrdiff_t>(i) * row_stride, col_stride);
+    }
+
+    bool rows_contiguous() const { return col_stride == static_cast<std::ptrdiff_t>(sizeof(T)); }
+};
+
+}  // namespace axnmihn
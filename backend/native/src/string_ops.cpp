@@ -1,6 +1,8 @@
 #include "string_ops.hpp"
+#include "arena.hpp"
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace axnmihn {
 namespace string_ops {
@@ -12,9 +14,10 @@ int levenshtein_distance(const std::string& a, const std::string& b) {
     if (m == 0) return static_cast<int>(n);
     if (n == 0) return static_cast<int>(m);
 
-    // Use only two rows for space efficiency
-    std::vector<int> prev(n + 1);
-    std::vector<int> curr(n + 1);
+    // Use only two rows for space efficiency, from the thread arena
+    alloc::ArenaScope scope;
+    int* prev = scope.array<int>(n + 1);
+    int* curr = scope.array<int>(n + 1);
 
     // Initialize first row
     for (size_t j = 0; j <= n; ++j) {
@@ -54,15 +57,18 @@ double string_similarity(const std::string& a, const std::string& b) {
     return 1.0 - static_cast<double>(dist) / static_cast<double>(max_len);
 }
 
-std::vector<std::tuple<size_t, size_t, double>> find_string_duplicates(
+PairList find_string_duplicates(
     const std::vector<std::string>& strings,
-    double threshold
+    double threshold,
+    const runtime::CancelToken* cancel
 ) {
-    std::vector<std::tuple<size_t, size_t, double>> duplicates;
+    PairList duplicates;
     size_t n = strings.size();
 
     // O(N^2) pairwise comparison with early termination optimization
     for (size_t i = 0; i < n; ++i) {
+        if (runtime::is_cancelled(cancel)) break;
+
         const std::string& a = strings[i];
         size_t len_a = a.size();
 
@@ -85,7 +91,7 @@ std::vector<std::tuple<size_t, size_t, double>> find_string_duplicates(
 
             double sim = string_similarity(a, b);
             if (sim >= threshold) {
-                duplicates.emplace_back(i, j, sim);
+                duplicates.add(i, j, sim);
             }
         }
     }
@@ -98,12 +104,18 @@ std::vector<double> string_similarity_batch(
     const std::vector<std::string>& targets
 ) {
     std::vector<double> results(targets.size());
+    string_similarity_batch_into(query, targets, MutableStridedView<double>(results.data()));
+    return results;
+}
 
+void string_similarity_batch_into(
+    const std::string& query,
+    const std::vector<std::string>& targets,
+    MutableStridedView<double> output
+) {
     for (size_t i = 0; i < targets.size(); ++i) {
-        results[i] = string_similarity(query, targets[i]);
+        output[i] = string_similarity(query, targets[i]);
     }
-
-    return results;
 }
 
 }  // namespace string_ops
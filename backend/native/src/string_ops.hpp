@@ -2,7 +2,10 @@
 
 #include <vector>
 #include <string>
-#include <tuple>
+
+#include "cancel.hpp"
+#include "pair_list.hpp"
+#include "strided.hpp"
 
 namespace axnmihn {
 namespace string_ops {
@@ -38,13 +41,15 @@ double string_similarity(const std::string& a, const std::string& b);
  * Args:
  *     strings: Vector of strings to compare
  *     threshold: Similarity threshold for duplicates (0-1)
+ *     cancel: Optional token; the scan stops after the current row once set
  *
  * Returns:
- *     Vector of (i, j, similarity) tuples for duplicates
+ *     Parallel (i, j, similarity) columns for duplicates
  */
-std::vector<std::tuple<size_t, size_t, double>> find_string_duplicates(
+PairList find_string_duplicates(
     const std::vector<std::string>& strings,
-    double threshold
+    double threshold,
+    const runtime::CancelToken* cancel = nullptr
 );
 
 /**
@@ -62,5 +67,15 @@ std::vector<double> string_similarity_batch(
     const std::vector<std::string>& targets
 );
 
+/**
+ * Batch string similarity writing into a caller-provided output
+ * with targets.size() elements.
+ */
+void string_similarity_batch_into(
+    const std::string& query,
+    const std::vector<std::string>& targets,
+    MutableStridedView<double> output
+);
+
 }  // namespace string_ops
 }  // namespace axnmihn
@@ -1,4 +1,5 @@
 #include "text_ops.hpp"
+#include "arena.hpp"
 
 #include <cstddef>
 
@@ -67,25 +68,15 @@ inline void encode_utf8(uint32_t cp, std::string& out) {
     }
 }
 
-/// Decode entire UTF-8 string into a vector of codepoints.
-inline std::vector<uint32_t> to_codepoints(const std::string& s) {
-    std::vector<uint32_t> cps;
-    cps.reserve(s.size());  // upper bound
+/// Decode a UTF-8 string into `cps` (room for s.size() codepoints).
+/// Returns the number of codepoints written.
+inline size_t to_codepoints(const std::string& s, uint32_t* cps) {
+    size_t count = 0;
     size_t pos = 0;
     while (pos < s.size()) {
-        cps.push_back(decode_utf8(s.data(), s.size(), pos));
+        cps[count++] = decode_utf8(s.data(), s.size(), pos);
     }
-    return cps;
-}
-
-/// Encode a vector of codepoints back to UTF-8.
-inline std::string from_codepoints(const std::vector<uint32_t>& cps) {
-    std::string out;
-    out.reserve(cps.size() * 3);  // rough estimate for CJK-heavy text
-    for (auto cp : cps) {
-        encode_utf8(cp, out);
-    }
-    return out;
+    return count;
 }
 
 // Character classification helpers
@@ -114,17 +105,18 @@ bool is_korean(uint32_t cp) {
            (cp >= 0x3130 && cp <= 0x318F);     // Compatibility Jamo
 }
 
-std::string fix_korean_spacing(const std::string& text) {
+namespace {
+
+/// Append the spacing-fixed form of `text` to `out`.
+void append_fixed_spacing(const std::string& text, std::string& out) {
     if (text.empty()) {
-        return text;
+        return;
     }
 
-    auto cps = to_codepoints(text);
-    const size_t n = cps.size();
-
-    // Output codepoints – worst case doubles the size
-    std::vector<uint32_t> out;
-    out.reserve(n + n / 4);
+    // Codepoints go to the thread arena; output is encoded straight into `out`
+    alloc::ArenaScope scope;
+    uint32_t* cps = scope.array<uint32_t>(text.size());
+    const size_t n = to_codepoints(text, cps);
 
     for (size_t i = 0; i < n; ++i) {
         uint32_t cur = cps[i];
@@ -136,7 +128,7 @@ std::string fix_korean_spacing(const std::string& text) {
             continue;
         }
 
-        out.push_back(cur);
+        encode_utf8(cur, out);
 
         // Nothing to do for the very last codepoint
         if (i + 1 >= n) {
@@ -187,8 +179,15 @@ std::string fix_korean_spacing(const std::string& text) {
             out.push_back(' ');
         }
     }
+}
 
-    return from_codepoints(out);
+}  // anonymous namespace
+
+std::string fix_korean_spacing(const std::string& text) {
+    std::string out;
+    out.reserve(text.size() + text.size() / 4);
+    append_fixed_spacing(text, out);
+    return out;
 }
 
 std::vector<std::string> fix_korean_spacing_batch(
@@ -201,5 +200,24 @@ std::vector<std::string> fix_korean_spacing_batch(
     return results;
 }
 
+void fix_korean_spacing_batch_into(
+    const std::vector<std::string>& texts,
+    std::string& out,
+    std::vector<size_t>& offsets) {
+    size_t total = 0;
+    for (const auto& t : texts) {
+        total += t.size();
+    }
+    out.clear();
+    out.reserve(total + total / 4);
+    offsets.clear();
+    offsets.reserve(texts.size() + 1);
+    offsets.push_back(0);
+    for (const auto& t : texts) {
+        append_fixed_spacing(t, out);
+        offsets.push_back(out.size());
+    }
+}
+
 }  // namespace text_ops
 }  // namespace axnmihn
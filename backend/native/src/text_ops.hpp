@@ -36,5 +36,21 @@ std::string fix_korean_spacing(const std::string& text);
 std::vector<std::string> fix_korean_spacing_batch(
     const std::vector<std::string>& texts);
 
+/**
+ * Batch fix into one concatenated buffer: result i is
+ * out[offsets[i], offsets[i + 1]). Two buffers per call regardless of
+ * the number of texts; callers that keep them across calls allocate
+ * nothing once they have grown.
+ *
+ * Args:
+ *     texts: Input texts
+ *     out: Cleared, then filled with the concatenated results
+ *     offsets: Cleared, then filled with texts.size() + 1 offsets
+ */
+void fix_korean_spacing_batch_into(
+    const std::vector<std::string>& texts,
+    std::string& out,
+    std::vector<size_t>& offsets);
+
 }  // namespace text_ops
 }  // namespace axnmihn
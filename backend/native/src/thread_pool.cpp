@@ -0,0 +1,160 @@
+#include "thread_pool.hpp"
+
+#include "trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+namespace axnmihn {
+namespace runtime {
+
+namespace {
+
+thread_local bool t_in_pool_worker = false;
+
+std::atomic<size_t> g_max_parallelism{0};
+
+}  // anonymous namespace
+
+ThreadPool::ThreadPool(size_t n_threads) {
+    n_threads = std::max<size_t>(1, n_threads);
+    workers_.reserve(n_threads);
+    for (size_t i = 0; i < n_threads; ++i) {
+        workers_.emplace_back([this, i] {
+            trace::set_thread_name("native-pool-" + std::to_string(i));
+            worker_loop();
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+size_t ThreadPool::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+void ThreadPool::worker_loop() {
+    t_in_pool_worker = true;
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_ && queue_.empty()) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        try {
+            task();
+        } catch (...) {
+            // Tasks report their own errors; a throwing task must not kill the worker
+        }
+    }
+}
+
+void set_max_parallelism(size_t threads) {
+    g_max_parallelism.store(threads, std::memory_order_relaxed);
+}
+
+size_t max_parallelism() {
+    return g_max_parallelism.load(std::memory_order_relaxed);
+}
+
+ThreadPool& default_pool() {
+    static ThreadPool* pool = [] {
+        size_t n = std::thread::hardware_concurrency();
+        if (const char* env = std::getenv("AXNMIHN_NATIVE_THREADS")) {
+            long requested = std::strtol(env, nullptr, 10);
+            if (requested > 0) {
+                n = static_cast<size_t>(requested);
+            }
+        }
+        return new ThreadPool(n == 0 ? 2 : n);
+    }();
+    return *pool;
+}
+
+void parallel_for(
+    ThreadPool& pool,
+    size_t n,
+    size_t min_chunk,
+    const std::function<void(size_t, size_t)>& fn
+) {
+    if (n == 0) {
+        return;
+    }
+    min_chunk = std::max<size_t>(1, min_chunk);
+    size_t chunks = std::min(pool.size() + 1, (n + min_chunk - 1) / min_chunk);
+    if (size_t cap = max_parallelism()) {
+        chunks = std::min(chunks, cap);
+    }
+    if (chunks <= 1 || t_in_pool_worker) {
+        fn(0, n);
+        return;
+    }
+
+    const size_t chunk_size = (n + chunks - 1) / chunks;
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    size_t remaining = chunks - 1;
+    std::exception_ptr first_error;
+
+    auto run_chunk = [&](size_t begin, size_t end) {
+        try {
+            fn(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!first_error) {
+                first_error = std::current_exception();
+            }
+        }
+    };
+
+    // Chunks 1..chunks-1 go to the pool; the caller runs chunk 0
+    for (size_t c = 1; c < chunks; ++c) {
+        size_t begin = c * chunk_size;
+        size_t end = std::min(n, begin + chunk_size);
+        pool.submit([&, begin, end] {
+            if (begin < end) {
+                run_chunk(begin, end);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--remaining == 0) {
+                done_cv.notify_one();
+            }
+        });
+    }
+    run_chunk(0, std::min(n, chunk_size));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cv.wait(lock, [&] { return remaining == 0; });
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+}
+
+}  // namespace runtime
+}  // namespace axnmihn
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace axnmihn {
+namespace runtime {
+
+/**
+ * Fixed-size worker pool for running native work off the caller's thread.
+ *
+ * Tasks are plain callables executed in FIFO order. The pool never touches
+ * Python; bindings that complete Python futures acquire the GIL themselves.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t n_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queue a task for execution on a worker thread.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * Number of worker threads.
+     */
+    size_t size() const { return workers_.size(); }
+
+    /**
+     * Number of tasks waiting for a worker.
+     */
+    size_t pending() const;
+
+private:
+    void worker_loop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> queue_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
+
+/**
+ * Process-wide pool used by the async bindings.
+ *
+ * Sized from AXNMIHN_NATIVE_THREADS when set, otherwise from
+ * std::thread::hardware_concurrency(). Created on first use and
+ * intentionally never destroyed, so worker threads are not joined
+ * during interpreter teardown.
+ */
+ThreadPool& default_pool();
+
+/**
+ * Cap the number of threads (caller included) a parallel_for may use.
+ * 0 removes the cap. Used for thread-count sweeps and to keep
+ * synchronous calls from occupying the whole pool.
+ */
+void set_max_parallelism(size_t threads);
+size_t max_parallelism();
+
+/**
+ * Run fn(begin, end) over [0, n) split into chunks of at least
+ * `min_chunk` items, using the pool plus the calling thread (subject to
+ * set_max_parallelism), and block
+ * until every chunk has finished. The first exception thrown by a chunk
+ * is rethrown to the caller.
+ *
+ * Runs inline when there is only one chunk, or when called from a pool
+ * worker (e.g. inside an *_async task), so nested use cannot deadlock.
+ */
+void parallel_for(
+    ThreadPool& pool,
+    size_t n,
+    size_t min_chunk,
+    const std::function<void(size_t, size_t)>& fn
+);
+
+}  // namespace runtime
+}  // namespace axnmihn
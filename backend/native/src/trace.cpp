@@ -0,0 +1,229 @@
+#include "trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace axnmihn {
+namespace trace {
+
+namespace {
+
+// One ring slot, guarded by a per-slot sequence number (seqlock): odd
+// while the owning thread is writing, 2*index+2 once event `index` is
+// complete. Readers copy the fields and keep them only if the sequence
+// did not change underneath them.
+struct Slot {
+    std::atomic<uint64_t> seq{0};
+    std::atomic<uint64_t> start_ns{0};
+    std::atomic<uint64_t> end_ns{0};
+    std::atomic<uint64_t> batch{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<const char*> category{nullptr};
+    std::atomic<const char*> simd{nullptr};
+};
+
+// Single-producer ring owned by one thread
+struct Ring {
+    explicit Ring(uint32_t id) : tid(id), slots(RING_CAPACITY) {}
+
+    uint32_t tid;
+    std::string thread_name;
+    std::atomic<uint64_t> head{0};   // events ever written
+    std::atomic<uint64_t> floor{0};  // events before this were cleared
+    std::atomic<bool> retired{false};
+    std::vector<Slot> slots;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Ring>> rings;
+    uint32_t next_tid = 1;
+};
+
+// Leaked so exiting threads can still reach it during static teardown
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+std::atomic<bool> g_enabled{false};
+
+const std::chrono::steady_clock::time_point g_epoch = std::chrono::steady_clock::now();
+
+// Owns the calling thread's ring; marks it retired on thread exit so
+// clear() can free it once its events are no longer wanted.
+struct ThreadRing {
+    std::shared_ptr<Ring> ring;
+    std::string name;  // applied when the ring is created
+
+    ~ThreadRing() {
+        if (ring) {
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+
+    Ring& get() {
+        if (!ring) {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            ring = std::make_shared<Ring>(reg.next_tid++);
+            ring->thread_name = name.empty() ? "thread-" + std::to_string(ring->tid) : name;
+            reg.rings.push_back(ring);
+        }
+        return *ring;
+    }
+};
+
+thread_local ThreadRing t_ring;
+
+void append_escaped(std::string& out, const char* text) {
+    for (const char* p = text ? text : ""; *p; ++p) {
+        char c = *p;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+}
+
+void append_us(std::string& out, uint64_t ns) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%llu.%03llu",
+                  static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    out += buf;
+}
+
+}  // anonymous namespace
+
+bool enabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+void set_enabled(bool on) {
+    g_enabled.store(on, std::memory_order_relaxed);
+}
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - g_epoch).count());
+}
+
+void set_thread_name(const std::string& name) {
+    t_ring.name = name;
+    if (t_ring.ring) {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        t_ring.ring->thread_name = name;
+    }
+}
+
+void record(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns,
+            uint64_t batch, const char* simd) {
+    Ring& ring = t_ring.get();
+    const uint64_t index = ring.head.load(std::memory_order_relaxed);
+    Slot& slot = ring.slots[index & (RING_CAPACITY - 1)];
+
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.start_ns.store(start_ns, std::memory_order_relaxed);
+    slot.end_ns.store(end_ns, std::memory_order_relaxed);
+    slot.batch.store(batch, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.simd.store(simd, std::memory_order_relaxed);
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+
+    ring.head.store(index + 1, std::memory_order_release);
+}
+
+std::string dump_json() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+    };
+
+    for (const auto& ring : reg.rings) {
+        separator();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        out += std::to_string(ring->tid);
+        out += ",\"args\":{\"name\":\"";
+        append_escaped(out, ring->thread_name.c_str());
+        out += "\"}}";
+
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        const uint64_t floor = ring->floor.load(std::memory_order_relaxed);
+        uint64_t begin = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+        begin = std::max(begin, floor);
+
+        for (uint64_t index = begin; index < head; ++index) {
+            const Slot& slot = ring->slots[index & (RING_CAPACITY - 1)];
+            const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq != 2 * index + 2) {
+                continue;  // overwritten or being written
+            }
+            const uint64_t start = slot.start_ns.load(std::memory_order_relaxed);
+            const uint64_t end = slot.end_ns.load(std::memory_order_relaxed);
+            const uint64_t batch = slot.batch.load(std::memory_order_relaxed);
+            const char* name = slot.name.load(std::memory_order_relaxed);
+            const char* category = slot.category.load(std::memory_order_relaxed);
+            const char* simd = slot.simd.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != seq) {
+                continue;  // torn read
+            }
+
+            separator();
+            out += "{\"name\":\"";
+            append_escaped(out, name);
+            out += "\",\"cat\":\"";
+            append_escaped(out, category);
+            out += "\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+            out += std::to_string(ring->tid);
+            out += ",\"ts\":";
+            append_us(out, start);
+            out += ",\"dur\":";
+            append_us(out, end >= start ? end - start : 0);
+            out += ",\"args\":{\"batch\":";
+            out += std::to_string(batch);
+            if (simd) {
+                out += ",\"simd\":\"";
+                append_escaped(out, simd);
+                out += '"';
+            }
+            out += "}}";
+        }
+    }
+    out += "]}";
+    return out;
+}
+
+void clear() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.rings.erase(
+        std::remove_if(reg.rings.begin(), reg.rings.end(), [](const std::shared_ptr<Ring>& ring) {
+            return ring->retired.load(std::memory_order_acquire);
+        }),
+        reg.rings.end());
+    for (const auto& ring : reg.rings) {
+        ring->floor.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+}  // namespace trace
+}  // namespace axnmihn
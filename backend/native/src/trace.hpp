@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace axnmihn {
+namespace trace {
+
+/**
+ * Events kept per thread. The ring overwrites its oldest events, so a
+ * long run keeps the most recent window.
+ */
+constexpr size_t RING_CAPACITY = size_t{1} << 15;
+
+/**
+ * Opt-in tracing switch (off by default). When off a Span costs one
+ * relaxed load.
+ */
+bool enabled();
+void set_enabled(bool on);
+
+/** Nanoseconds on the steady clock since the tracer's epoch. */
+uint64_t now_ns();
+
+/**
+ * Label the calling thread in dumps (e.g. "native-pool-2"). Does not
+ * allocate a ring by itself.
+ */
+void set_thread_name(const std::string& name);
+
+/**
+ * Append one complete span to the calling thread's ring.
+ *
+ * `name`, `category` and `simd` must be string literals or otherwise
+ * outlive the tracer; only the pointers are stored.
+ */
+void record(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns,
+            uint64_t batch, const char* simd);
+
+/**
+ * Chrome trace JSON ({"traceEvents": [...]}) for every thread's
+ * buffered events, readable by chrome://tracing and Perfetto.
+ * Safe to call while other threads are still recording.
+ */
+std::string dump_json();
+
+/** Drop all buffered events. */
+void clear();
+
+/**
+ * RAII span recorded on destruction when tracing is on.
+ *
+ * Usage:
+ *     trace::Span span("kernel", "vector_ops.cosine_similarity_batch");
+ *     span.batch(n);
+ */
+class Span {
+public:
+    Span(const char* name, const char* category)
+        : name_(name), category_(category), active_(enabled()) {
+        if (active_) {
+            start_ = now_ns();
+        }
+    }
+
+    ~Span() {
+        if (active_) {
+            record(name_, category_, start_, now_ns(), batch_, simd_);
+        }
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    void batch(uint64_t n) { batch_ = n; }
+    void simd(const char* variant) { simd_ = variant; }
+
+private:
+    const char* name_;
+    const char* category_;
+    bool active_;
+    uint64_t start_ = 0;
+    uint64_t batch_ = 0;
+    const char* simd_ = nullptr;
+};
+
+}  // namespace trace
+}  // namespace axnmihn
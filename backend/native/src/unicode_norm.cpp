@@ -0,0 +1,349 @@
+#include "unicode_norm.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#ifdef HAS_AVX2
+#include <immintrin.h>
+#endif
+
+namespace axnmihn {
+namespace unicode {
+
+namespace {
+
+#include "unicode_tables.inc"
+
+// Hangul syllables compose and decompose algorithmically
+constexpr uint32_t S_BASE = 0xAC00;
+constexpr uint32_t L_BASE = 0x1100;
+constexpr uint32_t V_BASE = 0x1161;
+constexpr uint32_t T_BASE = 0x11A7;
+constexpr uint32_t L_COUNT = 19;
+constexpr uint32_t V_COUNT = 21;
+constexpr uint32_t T_COUNT = 28;
+constexpr uint32_t S_COUNT = L_COUNT * V_COUNT * T_COUNT;
+
+inline const CharRecord& record(uint32_t cp) {
+    if (cp >= 0x110000) {
+        return RECORDS[0];
+    }
+    const uint32_t block = STAGE1[cp >> BLOCK_SHIFT];
+    return RECORDS[STAGE2[(block << BLOCK_SHIFT) | (cp & ((1u << BLOCK_SHIFT) - 1))]];
+}
+
+// NFKC leaves the character alone and nothing before or after it can
+// interact with it, so runs of these are copied verbatim
+inline bool inert(const CharRecord& r) {
+    return r.decomp == 0 && r.ccc == 0 && !(r.flags & FLAG_COMPOSE_SECOND);
+}
+
+inline const uint32_t* sequence(uint32_t packed, size_t& len) {
+    len = packed & 31;
+    return SEQUENCE_DATA + (packed >> 5);
+}
+
+// Valid UTF-8 assumed; a truncated trailing sequence decodes what is there
+inline uint32_t decode(const uint8_t*& p, const uint8_t* end) {
+    uint32_t c = *p++;
+    if (c < 0x80) {
+        return c;
+    }
+    int extra;
+    if (c < 0xE0) {
+        c &= 0x1F;
+        extra = 1;
+    } else if (c < 0xF0) {
+        c &= 0x0F;
+        extra = 2;
+    } else {
+        c &= 0x07;
+        extra = 3;
+    }
+    while (extra-- > 0 && p < end) {
+        c = (c << 6) | (*p++ & 0x3F);
+    }
+    return c;
+}
+
+inline void encode(uint32_t cp, std::string& out) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+// Primary composite of (a, b), 0 if none
+uint32_t compose_pair(uint32_t a, uint32_t b) {
+    if (a - L_BASE < L_COUNT && b - V_BASE < V_COUNT) {
+        return S_BASE + ((a - L_BASE) * V_COUNT + (b - V_BASE)) * T_COUNT;
+    }
+    if (a - S_BASE < S_COUNT && (a - S_BASE) % T_COUNT == 0 && b - T_BASE - 1 < T_COUNT - 1) {
+        return a + (b - T_BASE);
+    }
+    const ComposePair* end = COMPOSE_PAIRS + sizeof(COMPOSE_PAIRS) / sizeof(COMPOSE_PAIRS[0]);
+    const ComposePair* it = std::lower_bound(COMPOSE_PAIRS, end, ComposePair{a, b, 0},
+        [](const ComposePair& x, const ComposePair& y) {
+            return x.first != y.first ? x.first < y.first : x.second < y.second;
+        });
+    return (it != end && it->first == a && it->second == b) ? it->composite : 0;
+}
+
+// Decompose, canonically order and recompose one segment, appending to out
+void normalize_segment(const std::vector<uint32_t>& segment, std::vector<uint32_t>& work,
+                       std::string& out) {
+    work.clear();
+    for (uint32_t cp : segment) {
+        const CharRecord& r = record(cp);
+        if (r.decomp) {
+            size_t len;
+            const uint32_t* seq = sequence(r.decomp, len);
+            work.insert(work.end(), seq, seq + len);
+        } else {
+            work.push_back(cp);
+        }
+    }
+
+    // Canonical ordering: stable insertion sort of each run of marks
+    for (size_t i = 1; i < work.size(); ++i) {
+        const uint8_t ccc = record(work[i]).ccc;
+        if (ccc == 0) {
+            continue;
+        }
+        size_t j = i;
+        while (j > 0 && record(work[j - 1]).ccc > ccc) {
+            std::swap(work[j - 1], work[j]);
+            --j;
+        }
+    }
+
+    // Canonical composition, in place
+    size_t starter = SIZE_MAX;
+    int last_ccc = -1;   // Class of the last kept mark after the starter, -1 if none
+    size_t n = 0;
+    for (size_t i = 0; i < work.size(); ++i) {
+        const uint32_t cp = work[i];
+        const int ccc = record(cp).ccc;
+        if (starter != SIZE_MAX && (last_ccc < 0 || last_ccc < ccc)) {
+            if (const uint32_t composite = compose_pair(work[starter], cp)) {
+                work[starter] = composite;
+                continue;
+            }
+        }
+        if (ccc == 0) {
+            starter = n;
+            last_ccc = -1;
+        } else {
+            last_ccc = ccc;
+        }
+        work[n++] = cp;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        encode(work[i], out);
+    }
+}
+
+struct Scratch {
+    std::vector<uint32_t> segment;
+    std::vector<uint32_t> work;
+    std::string text;
+};
+
+Scratch& scratch() {
+    thread_local Scratch s;
+    return s;
+}
+
+}  // anonymous namespace
+
+const char* unicode_version() {
+    return UNICODE_VERSION;
+}
+
+size_t ascii_prefix(const char* data, size_t len) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+    size_t i = 0;
+#ifdef HAS_AVX2
+    if (simd::use_avx2()) {
+        for (; i + 32 <= len; i += 32) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+            const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(v));
+            if (mask) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+    }
+#endif
+    for (; i + 8 <= len; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, p + i, sizeof(word));
+        const uint64_t high = word & 0x8080808080808080ULL;
+        if (high) {
+            return i + (__builtin_ctzll(high) >> 3);
+        }
+    }
+    while (i < len && p[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+void ascii_lower(const char* data, size_t len, char* out) {
+    size_t i = 0;
+#ifdef HAS_AVX2
+    if (simd::use_avx2()) {
+        const __m256i before_a = _mm256_set1_epi8('A' - 1);
+        const __m256i after_z = _mm256_set1_epi8('Z' + 1);
+        const __m256i bit = _mm256_set1_epi8(0x20);
+        for (; i + 32 <= len; i += 32) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            // Signed compares: bytes >= 0x80 are negative and never in range
+            const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, before_a),
+                                                   _mm256_cmpgt_epi8(after_z, v));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_add_epi8(v, _mm256_and_si256(upper, bit)));
+        }
+    }
+#endif
+    for (; i < len; ++i) {
+        const char c = data[i];
+        out[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c;
+    }
+}
+
+void nfkc_into(std::string_view text, std::string& out) {
+    out.clear();
+    out.reserve(text.size());
+    const uint8_t* const begin = reinterpret_cast<const uint8_t*>(text.data());
+    const uint8_t* const end = begin + text.size();
+
+    Scratch& s = scratch();
+    auto& segment = s.segment;
+    segment.clear();
+
+    // Pending verbatim run [run_begin, p), whose last character (starting
+    // at last_inert) may still start the next segment
+    const uint8_t* run_begin = begin;
+    const uint8_t* last_inert = nullptr;
+    uint32_t last_inert_cp = 0;
+
+    const uint8_t* p = begin;
+    while (p < end) {
+        if (*p < 0x80) {
+            if (!segment.empty()) {
+                normalize_segment(segment, s.work, out);
+                segment.clear();
+                run_begin = p;
+            }
+            const size_t n = ascii_prefix(reinterpret_cast<const char*>(p),
+                                          static_cast<size_t>(end - p));
+            p += n;
+            last_inert = p - 1;
+            last_inert_cp = *last_inert;
+            continue;
+        }
+
+        const uint8_t* at = p;
+        const uint32_t cp = decode(p, end);
+        if (inert(record(cp))) {
+            if (!segment.empty()) {
+                normalize_segment(segment, s.work, out);
+                segment.clear();
+                run_begin = at;
+            }
+            last_inert = at;
+            last_inert_cp = cp;
+            continue;
+        }
+
+        if (segment.empty()) {
+            // The run's last character may compose with or reorder against cp
+            const uint8_t* cut = at;
+            if (last_inert != nullptr && last_inert >= run_begin) {
+                cut = last_inert;
+                segment.push_back(last_inert_cp);
+            }
+            out.append(reinterpret_cast<const char*>(run_begin), static_cast<size_t>(cut - run_begin));
+        }
+        segment.push_back(cp);
+    }
+
+    if (!segment.empty()) {
+        normalize_segment(segment, s.work, out);
+        segment.clear();
+    } else {
+        out.append(reinterpret_cast<const char*>(run_begin), static_cast<size_t>(end - run_begin));
+    }
+}
+
+void casefold_into(std::string_view text, std::string& out) {
+    out.clear();
+    out.reserve(text.size());
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(text.data());
+    const uint8_t* const end = p + text.size();
+    while (p < end) {
+        const size_t n = ascii_prefix(reinterpret_cast<const char*>(p), static_cast<size_t>(end - p));
+        if (n) {
+            const size_t at = out.size();
+            out.resize(at + n);
+            ascii_lower(reinterpret_cast<const char*>(p), n, &out[at]);
+            p += n;
+            continue;
+        }
+        const uint8_t* start = p;
+        const uint32_t cp = decode(p, end);
+        const CharRecord& r = record(cp);
+        if (r.fold) {
+            size_t len;
+            const uint32_t* seq = sequence(r.fold, len);
+            for (size_t i = 0; i < len; ++i) {
+                encode(seq[i], out);
+            }
+        } else {
+            out.append(reinterpret_cast<const char*>(start), static_cast<size_t>(p - start));
+        }
+    }
+}
+
+void nfkc_casefold_into(std::string_view text, bool nfkc, bool casefold, std::string& out) {
+    if (nfkc && casefold) {
+        std::string& tmp = scratch().text;
+        nfkc_into(text, tmp);
+        casefold_into(tmp, out);
+    } else if (nfkc) {
+        nfkc_into(text, out);
+    } else if (casefold) {
+        casefold_into(text, out);
+    } else {
+        out.assign(text.data(), text.size());
+    }
+}
+
+std::string nfkc(std::string_view text) {
+    std::string out;
+    nfkc_into(text, out);
+    return out;
+}
+
+std::string casefold(std::string_view text) {
+    std::string out;
+    casefold_into(text, out);
+    return out;
+}
+
+}  // namespace unicode
+}  // namespace axnmihn
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace axnmihn {
+namespace unicode {
+
+/**
+ * Unicode version of the generated tables (see
+ * tools/gen_unicode_tables.py).
+ */
+const char* unicode_version();
+
+/**
+ * Length of the leading run of ASCII bytes (SIMD when available).
+ */
+size_t ascii_prefix(const char* data, size_t len);
+
+inline bool is_ascii(std::string_view text) {
+    return ascii_prefix(text.data(), text.size()) == text.size();
+}
+
+/**
+ * Lower-case ASCII letters of data[0, len) into out (SIMD when
+ * available); other bytes are copied unchanged. out may alias data.
+ */
+void ascii_lower(const char* data, size_t len, char* out);
+
+/**
+ * NFKC normalization, identical to unicodedata.normalize("NFKC", text)
+ * for the tables' Unicode version.
+ *
+ * Runs of characters that NFKC cannot change (no decomposition,
+ * combining class 0, never the second half of a composition) are copied
+ * as-is, so ASCII and most Hangul text takes the fast path. Input must be
+ * valid UTF-8; `out` is cleared first.
+ */
+void nfkc_into(std::string_view text, std::string& out);
+
+/**
+ * Full Unicode case folding, identical to str.casefold() (e.g. "ß" ->
+ * "ss"). `out` is cleared first.
+ */
+void casefold_into(std::string_view text, std::string& out);
+
+/**
+ * casefold(nfkc(text)) with a single scratch buffer.
+ */
+void nfkc_casefold_into(std::string_view text, bool nfkc, bool casefold, std::string& out);
+
+std::string nfkc(std::string_view text);
+std::string casefold(std::string_view text);
+
+}  // namespace unicode
+}  // namespace axnmihn
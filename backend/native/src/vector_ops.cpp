@@ -1,4 +1,6 @@
 #include "vector_ops.hpp"
+#include "arena.hpp"
+#include "simd.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -9,6 +11,111 @@
 namespace axnmihn {
 namespace vector_ops {
 
+namespace {
+
+// Dot product of two contiguous vectors
+inline double dot_product(const double* a, const double* b, size_t dim) {
+    double dot = 0.0;
+#ifdef HAS_AVX2
+    if (simd::use_avx2()) {
+        size_t d = 0;
+        __m256d sum = _mm256_setzero_pd();
+
+        for (; d + 4 <= dim; d += 4) {
+            __m256d va = _mm256_loadu_pd(&a[d]);
+            __m256d vb = _mm256_loadu_pd(&b[d]);
+            sum = _mm256_fmadd_pd(va, vb, sum);
+        }
+
+        double tmp[4];
+        _mm256_storeu_pd(tmp, sum);
+        dot = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+
+        for (; d < dim; ++d) {
+            dot += a[d] * b[d];
+        }
+        return dot;
+    }
+#endif
+    for (size_t d = 0; d < dim; ++d) {
+        dot += a[d] * b[d];
+    }
+    return dot;
+}
+
+// Dot product of query and vec plus squared norm of vec (contiguous inputs)
+inline void dot_and_norm(const double* query, const double* vec, size_t dim,
+                         double& dot, double& vec_norm_sq) {
+    dot = 0.0;
+    vec_norm_sq = 0.0;
+#ifdef HAS_AVX2
+    if (simd::use_avx2()) {
+        size_t i = 0;
+        __m256d sum_dot = _mm256_setzero_pd();
+        __m256d sum_norm = _mm256_setzero_pd();
+
+        for (; i + 4 <= dim; i += 4) {
+            __m256d vq = _mm256_loadu_pd(&query[i]);
+            __m256d vv = _mm256_loadu_pd(&vec[i]);
+
+            sum_dot = _mm256_fmadd_pd(vq, vv, sum_dot);
+            sum_norm = _mm256_fmadd_pd(vv, vv, sum_norm);
+        }
+
+        double tmp[4];
+        _mm256_storeu_pd(tmp, sum_dot);
+        dot = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+
+        _mm256_storeu_pd(tmp, sum_norm);
+        vec_norm_sq = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+
+        for (; i < dim; ++i) {
+            dot += query[i] * vec[i];
+            vec_norm_sq += vec[i] * vec[i];
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < dim; ++i) {
+        dot += query[i] * vec[i];
+        vec_norm_sq += vec[i] * vec[i];
+    }
+}
+
+}  // anonymous namespace
+
+float dot_product_f32(const float* a, const float* b, size_t dim) {
+    float dot = 0.0f;
+#ifdef HAS_AVX2
+    if (simd::use_avx2()) {
+        size_t d = 0;
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+
+        for (; d + 16 <= dim; d += 16) {
+            sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&a[d]), _mm256_loadu_ps(&b[d]), sum0);
+            sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(&a[d + 8]), _mm256_loadu_ps(&b[d + 8]), sum1);
+        }
+        for (; d + 8 <= dim; d += 8) {
+            sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&a[d]), _mm256_loadu_ps(&b[d]), sum0);
+        }
+
+        float tmp[8];
+        _mm256_storeu_ps(tmp, _mm256_add_ps(sum0, sum1));
+        dot = ((tmp[0] + tmp[1]) + (tmp[2] + tmp[3])) + ((tmp[4] + tmp[5]) + (tmp[6] + tmp[7]));
+
+        for (; d < dim; ++d) {
+            dot += a[d] * b[d];
+        }
+        return dot;
+    }
+#endif
+    for (size_t d = 0; d < dim; ++d) {
+        dot += a[d] * b[d];
+    }
+    return dot;
+}
+
 double cosine_similarity(const std::vector<double>& a, const std::vector<double>& b) {
     if (a.size() != b.size() || a.empty()) {
         return 0.0;
@@ -16,47 +123,52 @@ double cosine_similarity(const std::vector<double>& a, const std::vector<double>
 
     double dot = 0.0, norm_a = 0.0, norm_b = 0.0;
 
+    bool vectorized = false;
 #ifdef HAS_AVX2
-    size_t n = a.size();
-    size_t i = 0;
+    if (simd::use_avx2()) {
+        size_t n = a.size();
+        size_t i = 0;
 
-    __m256d sum_dot = _mm256_setzero_pd();
-    __m256d sum_a = _mm256_setzero_pd();
-    __m256d sum_b = _mm256_setzero_pd();
+        __m256d sum_dot = _mm256_setzero_pd();
+        __m256d sum_a = _mm256_setzero_pd();
+        __m256d sum_b = _mm256_setzero_pd();
 
-    for (; i + 4 <= n; i += 4) {
-        __m256d va = _mm256_loadu_pd(&a[i]);
-        __m256d vb = _mm256_loadu_pd(&b[i]);
+        for (; i + 4 <= n; i += 4) {
+            __m256d va = _mm256_loadu_pd(&a[i]);
+            __m256d vb = _mm256_loadu_pd(&b[i]);
 
-        sum_dot = _mm256_fmadd_pd(va, vb, sum_dot);
-        sum_a = _mm256_fmadd_pd(va, va, sum_a);
-        sum_b = _mm256_fmadd_pd(vb, vb, sum_b);
-    }
+            sum_dot = _mm256_fmadd_pd(va, vb, sum_dot);
+            sum_a = _mm256_fmadd_pd(va, va, sum_a);
+            sum_b = _mm256_fmadd_pd(vb, vb, sum_b);
+        }
 
-    // Horizontal sum
-    double tmp[4];
-    _mm256_storeu_pd(tmp, sum_dot);
-    dot = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+        // Horizontal sum
+        double tmp[4];
+        _mm256_storeu_pd(tmp, sum_dot);
+        dot = tmp[0] + tmp[1] + tmp[2] + tmp[3];
 
-    _mm256_storeu_pd(tmp, sum_a);
-    norm_a = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+        _mm256_storeu_pd(tmp, sum_a);
+        norm_a = tmp[0] + tmp[1] + tmp[2] + tmp[3];
 
-    _mm256_storeu_pd(tmp, sum_b);
-    norm_b = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+        _mm256_storeu_pd(tmp, sum_b);
+        norm_b = tmp[0] + tmp[1] + tmp[2] + tmp[3];
 
-    // Handle remaining elements
-    for (; i < n; ++i) {
-        dot += a[i] * b[i];
-        norm_a += a[i] * a[i];
-        norm_b += b[i] * b[i];
-    }
-#else
-    for (size_t i = 0; i < a.size(); ++i) {
-        dot += a[i] * b[i];
-        norm_a += a[i] * a[i];
-        norm_b += b[i] * b[i];
+        // Handle remaining elements
+        for (; i < n; ++i) {
+            dot += a[i] * b[i];
+            norm_a += a[i] * a[i];
+            norm_b += b[i] * b[i];
+        }
+        vectorized = true;
     }
 #endif
+    if (!vectorized) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            dot += a[i] * b[i];
+            norm_a += a[i] * a[i];
+            norm_b += b[i] * b[i];
+        }
+    }
 
     double denom = std::sqrt(norm_a) * std::sqrt(norm_b);
     if (denom < 1e-10) {
@@ -77,6 +189,22 @@ std::vector<double> cosine_similarity_batch(
         return results;
     }
 
+    cosine_similarity_batch_into(
+        StridedView<double>(query.data()),
+        StridedMatrix<double>(corpus, n_vectors, dim),
+        MutableStridedView<double>(results.data()));
+    return results;
+}
+
+void cosine_similarity_batch_into(
+    StridedView<double> query,
+    const StridedMatrix<double>& corpus,
+    MutableStridedView<double> output,
+    const runtime::CancelToken* cancel
+) {
+    const size_t n_vectors = corpus.rows;
+    const size_t dim = corpus.cols;
+
     // Pre-compute query norm
     double query_norm_sq = 0.0;
     for (size_t i = 0; i < dim; ++i) {
@@ -85,70 +213,70 @@ std::vector<double> cosine_similarity_batch(
     double query_norm = std::sqrt(query_norm_sq);
 
     if (query_norm < 1e-10) {
-        return results;
+        for (size_t v = 0; v < n_vectors; ++v) {
+            output[v] = 0.0;
+        }
+        return;
     }
 
-    for (size_t v = 0; v < n_vectors; ++v) {
-        const double* vec = corpus + v * dim;
+    const bool simd_ok = query.contiguous() && corpus.rows_contiguous();
 
-        double dot = 0.0;
-        double vec_norm_sq = 0.0;
-
-#ifdef HAS_AVX2
-        size_t i = 0;
-        __m256d sum_dot = _mm256_setzero_pd();
-        __m256d sum_norm = _mm256_setzero_pd();
-
-        for (; i + 4 <= dim; i += 4) {
-            __m256d vq = _mm256_loadu_pd(&query[i]);
-            __m256d vv = _mm256_loadu_pd(&vec[i]);
-
-            sum_dot = _mm256_fmadd_pd(vq, vv, sum_dot);
-            sum_norm = _mm256_fmadd_pd(vv, vv, sum_norm);
+    for (size_t v = 0; v < n_vectors; ++v) {
+        if ((v & 1023) == 0 && runtime::is_cancelled(cancel)) {
+            return;
         }
 
-        double tmp[4];
-        _mm256_storeu_pd(tmp, sum_dot);
-        dot = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+        StridedView<double> row = corpus.row(v);
 
-        _mm256_storeu_pd(tmp, sum_norm);
-        vec_norm_sq = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+        double dot = 0.0;
+        double vec_norm_sq = 0.0;
 
-        for (; i < dim; ++i) {
-            dot += query[i] * vec[i];
-            vec_norm_sq += vec[i] * vec[i];
-        }
-#else
-        for (size_t i = 0; i < dim; ++i) {
-            dot += query[i] * vec[i];
-            vec_norm_sq += vec[i] * vec[i];
+        if (simd_ok) {
+            dot_and_norm(query.ptr(), row.ptr(), dim, dot, vec_norm_sq);
+        } else {
+            // Strided layout: scalar gather, still no copy
+            for (size_t i = 0; i < dim; ++i) {
+                double x = row[i];
+                dot += query[i] * x;
+                vec_norm_sq += x * x;
+            }
         }
-#endif
 
         double vec_norm = std::sqrt(vec_norm_sq);
         if (vec_norm < 1e-10) {
-            results[v] = 0.0;
+            output[v] = 0.0;
         } else {
-            results[v] = dot / (query_norm * vec_norm);
+            output[v] = dot / (query_norm * vec_norm);
         }
     }
-
-    return results;
 }
 
-std::vector<std::tuple<size_t, size_t, double>> find_duplicates_by_embedding(
+PairList find_duplicates_by_embedding(
     const double* embeddings,
     size_t n,
     size_t dim,
     double threshold
 ) {
-    std::vector<std::tuple<size_t, size_t, double>> duplicates;
+    return find_duplicates_by_embedding(
+        StridedMatrix<double>(embeddings, n, dim), threshold);
+}
+
+PairList find_duplicates_by_embedding(
+    const StridedMatrix<double>& embeddings,
+    double threshold,
+    const runtime::CancelToken* cancel
+) {
+    PairList duplicates;
+    const size_t n = embeddings.rows;
+    const size_t dim = embeddings.cols;
+    const bool simd_ok = embeddings.rows_contiguous();
 
     // Pre-compute all norms
-    std::vector<double> norms(n);
+    alloc::ArenaScope scope;
+    double* norms = scope.array<double>(n);
     for (size_t i = 0; i < n; ++i) {
+        StridedView<double> vec = embeddings.row(i);
         double norm_sq = 0.0;
-        const double* vec = embeddings + i * dim;
         for (size_t d = 0; d < dim; ++d) {
             norm_sq += vec[d] * vec[d];
         }
@@ -157,43 +285,29 @@ std::vector<std::tuple<size_t, size_t, double>> find_duplicates_by_embedding(
 
     // O(N^2) pairwise comparison
     for (size_t i = 0; i < n; ++i) {
+        if (runtime::is_cancelled(cancel)) break;
         if (norms[i] < 1e-10) continue;
 
-        const double* vec_i = embeddings + i * dim;
+        StridedView<double> vec_i = embeddings.row(i);
 
         for (size_t j = i + 1; j < n; ++j) {
             if (norms[j] < 1e-10) continue;
 
-            const double* vec_j = embeddings + j * dim;
+            StridedView<double> vec_j = embeddings.row(j);
 
             double dot = 0.0;
-#ifdef HAS_AVX2
-            size_t d = 0;
-            __m256d sum = _mm256_setzero_pd();
-
-            for (; d + 4 <= dim; d += 4) {
-                __m256d vi = _mm256_loadu_pd(&vec_i[d]);
-                __m256d vj = _mm256_loadu_pd(&vec_j[d]);
-                sum = _mm256_fmadd_pd(vi, vj, sum);
+            if (simd_ok) {
+                dot = dot_product(vec_i.ptr(), vec_j.ptr(), dim);
+            } else {
+                for (size_t d = 0; d < dim; ++d) {
+                    dot += vec_i[d] * vec_j[d];
+                }
             }
 
-            double tmp[4];
-            _mm256_storeu_pd(tmp, sum);
-            dot = tmp[0] + tmp[1] + tmp[2] + tmp[3];
-
-            for (; d < dim; ++d) {
-                dot += vec_i[d] * vec_j[d];
-            }
-#else
-            for (size_t d = 0; d < dim; ++d) {
-                dot += vec_i[d] * vec_j[d];
-            }
-#endif
-
             double similarity = dot / (norms[i] * norms[j]);
 
             if (similarity >= threshold) {
-                duplicates.emplace_back(i, j, similarity);
+                duplicates.add(i, j, similarity);
             }
         }
     }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <vector>
-#include <tuple>
 #include <cstdint>
 
+#include "cancel.hpp"
+#include "pair_list.hpp"
+#include "strided.hpp"
+
 namespace axnmihn {
 namespace vector_ops {
 
@@ -19,6 +22,11 @@ namespace vector_ops {
  */
 double cosine_similarity(const std::vector<double>& a, const std::vector<double>& b);
 
+/**
+ * Dot product of two contiguous float32 vectors (AVX2 when available).
+ */
+float dot_product_f32(const float* a, const float* b, size_t dim);
+
 /**
  * Calculate cosine similarity between a query and a corpus of vectors.
  * Uses SIMD optimizations when available.
@@ -39,6 +47,27 @@ std::vector<double> cosine_similarity_batch(
     size_t dim
 );
 
+/**
+ * Calculate cosine similarity between a query and a strided corpus,
+ * writing into a caller-provided output.
+ *
+ * A contiguous query and contiguous rows take the SIMD path; any other
+ * layout (column slices, transposed views) uses a scalar strided loop.
+ * No temporaries are allocated.
+ *
+ * Args:
+ *     query: Query view with corpus.cols elements
+ *     corpus: Corpus matrix view (n_vectors x dim)
+ *     output: Output view with corpus.rows elements
+ *     cancel: Optional token polled between row blocks
+ */
+void cosine_similarity_batch_into(
+    StridedView<double> query,
+    const StridedMatrix<double>& corpus,
+    MutableStridedView<double> output,
+    const runtime::CancelToken* cancel = nullptr
+);
+
 /**
  * Find duplicate pairs by embedding similarity.
  *
@@ -49,14 +78,25 @@ std::vector<double> cosine_similarity_batch(
  *     threshold: Similarity threshold for duplicates
  *
  * Returns:
- *     Vector of (i, j, similarity) tuples for duplicates
+ *     Parallel (i, j, similarity) columns for duplicates
  */
-std::vector<std::tuple<size_t, size_t, double>> find_duplicates_by_embedding(
+PairList find_duplicates_by_embedding(
     const double* embeddings,
     size_t n,
     size_t dim,
     double threshold
 );
 
+/**
+ * Strided variant of find_duplicates_by_embedding.
+ * Row slices are read in place; rows must be contiguous for SIMD.
+ * When `cancel` is set the scan stops after the current row.
+ */
+PairList find_duplicates_by_embedding(
+    const StridedMatrix<double>& embeddings,
+    double threshold,
+    const runtime::CancelToken* cancel = nullptr
+);
+
 }  // namespace vector_ops
 }  // namespace axnmihn
@@ -121,10 +121,13 @@ def benchmark_decay_batch(batch_sizes: list = [100, 1000, 5000, 10000]):
             conn_arr = connection_count.astype(np.int32)
             last_arr = last_access_hours.astype(np.float64)
             type_arr = memory_type.astype(np.int32)
+            mention_arr = np.zeros(batch_size, dtype=np.int32)
+            out = np.empty(batch_size, dtype=np.float64)
 
             start = time.perf_counter()
             native.decay_ops.calculate_batch_numpy(
-                imp_arr, hrs_arr, acc_arr, conn_arr, last_arr, type_arr, config
+                imp_arr, hrs_arr, acc_arr, conn_arr, last_arr, type_arr, mention_arr,
+                config, out=out,
             )
             native_time = time.perf_counter() - start
 
@@ -176,9 +179,9 @@ def benchmark_find_duplicates(n_embeddings: int = 500, dim: int = 768):
 
     if HAS_NATIVE:
         start = time.perf_counter()
-        native_dups = native.vector_ops.find_duplicates_by_embedding(embeddings, threshold)
+        dup_i, _, _ = native.vector_ops.find_duplicates_by_embedding(embeddings, threshold)
         native_time = time.perf_counter() - start
-        print(f"Native: {native_time*1000:.2f}ms (found {len(native_dups)} duplicates)")
+        print(f"Native: {native_time*1000:.2f}ms (found {len(dup_i)} duplicates)")
         print(f"Speedup: {python_time/native_time:.1f}x")
 
 
@@ -209,9 +212,9 @@ def benchmark_string_similarity(n_strings: int = 100):
 
     if HAS_NATIVE:
         start = time.perf_counter()
-        native_dups = native.string_ops.find_string_duplicates(strings, threshold)
+        dup_i, _, _ = native.string_ops.find_string_duplicates(strings, threshold)
         native_time = time.perf_counter() - start
-        print(f"Native: {native_time*1000:.2f}ms (found {len(native_dups)} duplicates)")
+        print(f"Native: {native_time*1000:.2f}ms (found {len(dup_i)} duplicates)")
         print(f"Speedup: {python_time/native_time:.1f}x")
 
 
@@ -0,0 +1,92 @@
+"""Tests for the native access accumulator."""
+
+import threading
+
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestAccessAccumulator:
+    """Tests for coalescing, draining and concurrent tracking."""
+
+    def test_coalesces_per_id(self):
+        """Test repeated accesses become one row with count, max ts and channel OR."""
+        acc = native.access.AccessAccumulator()
+        acc.track("x", 1.0, 1)
+        acc.track("x", 3.0, 2)
+        acc.track("x", 2.0)
+        acc.track("y", 5.0)
+        assert acc.pending == 2
+
+        cols = acc.drain()
+        rows = {
+            i: (c, t, ch)
+            for i, c, t, ch in zip(cols["ids"], cols["count"].tolist(),
+                                   cols["last_ts"].tolist(), cols["channels"].tolist())
+        }
+        assert rows == {"x": (3, 3.0, 3), "y": (1, 5.0, 0)}
+        assert cols["count"].dtype.name == "int32"
+        assert cols["channels"].dtype.name == "uint64"
+        assert acc.pending == 0
+
+    def test_drain_resets_counts(self):
+        """Test a second drain only returns accesses made after the first."""
+        acc = native.access.AccessAccumulator()
+        acc.track_many(["a", "b", "a"], 1.0)
+        assert len(acc.drain()["ids"]) == 2
+        assert acc.drain()["ids"] == []
+        acc.track("a", 2.0)
+        cols = acc.drain()
+        assert cols["ids"] == ["a"]
+        assert cols["count"].tolist() == [1]
+
+    def test_growth_keeps_ids(self):
+        """Test tables grow past their initial capacity without losing counts."""
+        acc = native.access.AccessAccumulator(num_shards=2, initial_capacity=8)
+        ids = [f"mem-{i}" for i in range(5000)]
+        acc.track_many(ids, 1.0)
+        acc.track_many(ids, 2.0)
+        cols = acc.drain()
+        assert sorted(cols["ids"]) == sorted(ids)
+        assert set(cols["count"].tolist()) == {2}
+        stats = acc.stats()
+        assert stats["interned"] == 5000
+        assert stats["accesses"] == 10000
+
+    def test_concurrent_track_and_drain(self):
+        """Test every access is drained exactly once under concurrency."""
+        acc = native.access.AccessAccumulator()
+        ids = [f"id{i}" for i in range(500)]
+        totals = {}
+        stop = threading.Event()
+
+        def drainer():
+            while not stop.is_set():
+                cols = acc.drain()
+                for i, c in zip(cols["ids"], cols["count"].tolist()):
+                    totals[i] = totals.get(i, 0) + c
+
+        def writer():
+            for _ in range(20):
+                acc.track_many(ids, 1.0)
+
+        d = threading.Thread(target=drainer)
+        d.start()
+        writers = [threading.Thread(target=writer) for _ in range(4)]
+        for w in writers:
+            w.start()
+        for w in writers:
+            w.join()
+        stop.set()
+        d.join()
+        cols = acc.drain()
+        for i, c in zip(cols["ids"], cols["count"].tolist()):
+            totals[i] = totals.get(i, 0) + c
+        assert totals == {i: 80 for i in ids}
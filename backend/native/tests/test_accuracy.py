@@ -0,0 +1,127 @@
+"""Tests for the accuracy submodule and runtime sampling."""
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+@pytest.fixture
+def sampling():
+    native.accuracy.reset_metrics()
+    native.accuracy.set_sample_rate(1.0)
+    yield
+    native.accuracy.set_sample_rate(0.0)
+    native.accuracy.reset_metrics()
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestMetrics:
+    """Tests for compare_values / top_k / recall_at_k / pair_agreement."""
+
+    def test_compare_values(self):
+        """Test max, mean and worst index of the error."""
+        m = native.accuracy.compare_values([1.0, 2.0, 3.5], [1.0, 2.5, 3.0])
+        assert m["count"] == 3
+        assert m["max_abs"] == pytest.approx(0.5)
+        assert m["mean_abs"] == pytest.approx(1.0 / 3.0)
+        assert m["worst_index"] == 1
+
+    def test_length_mismatch_raises(self):
+        """Test arrays of different length are rejected."""
+        with pytest.raises(ValueError):
+            native.accuracy.compare_values([1.0, 2.0], [1.0])
+
+    def test_top_k_and_recall(self):
+        """Test top_k ordering and recall against it."""
+        top = native.accuracy.top_k(np.array([0.1, 0.9, 0.5, 0.9]), 3)
+        assert top.tolist() == [1, 3, 2]
+        assert native.accuracy.recall_at_k([1, 3, 0], top, 3) == pytest.approx(2.0 / 3.0)
+        assert native.accuracy.recall_at_k([], [], 5) == 1.0
+
+    def test_pair_agreement_is_unordered(self):
+        """Test (i, j) and (j, i) count as the same pair."""
+        approx = (np.array([0, 3], dtype=np.int64), np.array([1, 2], dtype=np.int64))
+        exact = (np.array([1, 4], dtype=np.int64), np.array([0, 5], dtype=np.int64))
+        a = native.accuracy.pair_agreement(approx, exact)
+        assert (a["approx"], a["exact"], a["common"]) == (2, 2, 1)
+        assert a["jaccard"] == pytest.approx(1.0 / 3.0)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestDecayReference:
+    """Tests for decay_ops.calculate_reference."""
+
+    def test_batch_matches_reference(self):
+        """Test the batch kernel (both SIMD paths) against the exact reference."""
+        rng = np.random.default_rng(11)
+        n = 1001
+        cols = (rng.random(n), rng.exponential(2000.0, n) * np.where(rng.random(n) < 0.1, -1, 1),
+                rng.integers(0, 100, n, dtype=np.int32), rng.integers(0, 12, n, dtype=np.int32),
+                np.where(rng.random(n) < 0.3, -1.0, rng.exponential(48.0, n)),
+                rng.integers(-1, 5, n, dtype=np.int32), rng.integers(0, 5, n, dtype=np.int32))
+        config = native.decay_ops.DecayConfig()
+        exact = np.array([
+            native.decay_ops.calculate_reference(
+                native.decay_ops.DecayInput(*(float(c[i]) if c.dtype == np.float64 else int(c[i])
+                                              for c in cols)), config)
+            for i in range(n)])
+        for variant in native.simd_variants():
+            native.set_simd_variant(variant)
+            try:
+                fast = native.decay_ops.calculate_batch_numpy(*cols, config)
+            finally:
+                native.set_simd_variant("auto")
+            assert native.accuracy.compare_values(fast, exact)["max_abs"] < 1e-12, variant
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestSampling:
+    """Tests for runtime sampling."""
+
+    def test_off_by_default(self):
+        """Test nothing is recorded at rate 0."""
+        native.accuracy.reset_metrics()
+        assert native.accuracy.sample_rate() == 0.0
+        native.decay_ops.calculate_batch_numpy(
+            np.ones(8), np.ones(8), *(np.zeros(8, dtype=np.int32),) * 2,
+            -np.ones(8), *(np.zeros(8, dtype=np.int32),) * 2, native.decay_ops.DecayConfig())
+        assert native.accuracy.metrics() == {}
+
+    def test_decay_batch_sampled(self, sampling):
+        """Test a sampled batch records at most SAMPLE_ELEMENTS errors."""
+        n = 1000
+        native.decay_ops.calculate_batch_numpy(
+            np.ones(n), np.linspace(0, 5000, n), *(np.zeros(n, dtype=np.int32),) * 2,
+            -np.ones(n), *(np.zeros(n, dtype=np.int32),) * 2, native.decay_ops.DecayConfig())
+        m = native.accuracy.metrics()["decay.batch"]
+        assert m["samples"] == 1
+        assert m["count"] == 64
+        assert m["max_abs"] < 1e-12
+
+    def test_engine_scan_sampled(self, sampling):
+        """Test build_context records scan recall and similarity error."""
+        rng = np.random.default_rng(5)
+        engine = native.memory_engine.MemoryEngine(32)
+        engine.upsert_batch([f"m{i}" for i in range(2000)], rng.standard_normal((2000, 32)))
+        engine.build_context(rng.standard_normal(32), budget=100000, now=1.7e9)
+        m = native.accuracy.metrics()["engine.scan"]
+        assert m["recall_samples"] == 1
+        assert m["mean_recall"] == pytest.approx(1.0)
+        assert m["max_abs"] < 1e-5
+
+    def test_rate_is_clamped(self, sampling):
+        """Test out-of-range rates clamp to [0, 1]."""
+        native.accuracy.set_sample_rate(3.0)
+        assert native.accuracy.sample_rate() == pytest.approx(1.0)
+        native.accuracy.set_sample_rate(-1.0)
+        assert native.accuracy.sample_rate() == 0.0
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v"])
@@ -0,0 +1,69 @@
+"""Tests for the call arena and result buffer pool."""
+
+import gc
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestArena:
+    """Tests for arena-backed kernel temporaries."""
+
+    def test_steady_state_needs_no_new_chunks(self):
+        """Test repeated calls reuse the thread arena's chunks."""
+        texts = ["안녕.하세요(테스트)" * 20] * 200
+        native.text_ops.fix_korean_spacing_batch(texts)
+        native.string_ops.string_similarity_batch(texts[0], texts)
+        before = native.allocator_stats()["arena"]["chunk_allocs"]
+        for _ in range(5):
+            native.text_ops.fix_korean_spacing_batch(texts)
+            native.string_ops.string_similarity_batch(texts[0], texts)
+        assert native.allocator_stats()["arena"]["chunk_allocs"] == before
+
+    def test_batch_spacing_matches_single(self):
+        """Test the concatenated batch path splits results correctly."""
+        texts = ["", "안녕.하세요", "a  b", "(괄호)테스트", "끝!"]
+        batch = native.text_ops.fix_korean_spacing_batch(texts)
+        assert batch == [native.text_ops.fix_korean_spacing(t) for t in texts]
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestBufferPool:
+    """Tests for pooled result buffers."""
+
+    def test_released_results_are_reused(self):
+        """Test freeing a pair result lets the next call reuse its buffers."""
+        rng = np.random.default_rng(0)
+        emb = rng.standard_normal((200, 16))
+        emb[100:] = emb[:100] + 1e-3
+        first = native.vector_ops.find_duplicates_by_embedding(emb, 0.99)
+        del first
+        gc.collect()
+        before = native.allocator_stats()["pool"]
+        second = native.vector_ops.find_duplicates_by_embedding(emb, 0.99)
+        after = native.allocator_stats()["pool"]
+        assert len(second[0]) >= 100
+        assert after["hits"] > before["hits"]
+
+    def test_trim_and_limit(self):
+        """Test trim empties the cache and the limit round-trips."""
+        limit = native.allocator_stats()["pool"]["cache_limit"]
+        try:
+            native.set_buffer_pool_limit(1 << 20)
+            assert native.allocator_stats()["pool"]["cache_limit"] == 1 << 20
+            native.trim_buffer_pool()
+            assert native.allocator_stats()["pool"]["bytes_cached"] == 0
+        finally:
+            native.set_buffer_pool_limit(limit)
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v"])
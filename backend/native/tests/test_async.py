@@ -0,0 +1,154 @@
+"""Tests for asyncio-native *_async bindings."""
+
+import asyncio
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestAsyncResults:
+    """Async variants return the same results as their sync counterparts."""
+
+    def test_num_threads_positive(self):
+        """Test the native pool has at least one worker."""
+        assert native.num_threads() >= 1
+
+    def test_cosine_similarity_batch_async(self):
+        """Test awaited scores match the synchronous call."""
+        np.random.seed(1)
+        query = np.random.randn(64)
+        corpus = np.random.randn(200, 64)
+
+        async def run():
+            return await native.vector_ops.cosine_similarity_batch_async(query, corpus)
+
+        result = asyncio.run(run())
+        expected = native.vector_ops.cosine_similarity_batch(query, corpus)
+        np.testing.assert_allclose(result, expected, atol=1e-12)
+
+    def test_find_duplicates_async(self):
+        """Test awaited duplicate pairs match the synchronous call."""
+        embeddings = np.array([
+            [1.0, 0.0, 0.0],
+            [0.0, 1.0, 0.0],
+            [1.0, 0.0, 0.0],
+        ])
+
+        async def run():
+            return await native.vector_ops.find_duplicates_by_embedding_async(embeddings, 0.99)
+
+        dup_i, dup_j, dup_sim = asyncio.run(run())
+        assert list(zip(dup_i.tolist(), dup_j.tolist())) == [(0, 2)]
+        assert abs(dup_sim[0] - 1.0) < 1e-6
+
+    def test_connected_components_async(self):
+        """Test awaited component ids match the synchronous call."""
+        adjacency = {0: [1], 1: [0], 2: [3], 3: [2]}
+
+        async def run():
+            return await native.graph_ops.find_connected_components_async(adjacency, 5)
+
+        result = asyncio.run(run())
+        expected = native.graph_ops.find_connected_components(adjacency, 5)
+        assert result.tolist() == expected.tolist()
+
+    def test_knn_build_async(self):
+        """Test the awaited kNN graph matches the synchronous build."""
+        np.random.seed(3)
+        embeddings = np.random.randn(300, 32)
+
+        async def run():
+            return await native.knn.build_async(embeddings, 5)
+
+        result = asyncio.run(run())
+        expected = native.knn.build(embeddings, 5)
+        for got, want in zip(result, expected):
+            np.testing.assert_array_equal(got, want)
+
+    def test_string_duplicates_async(self):
+        """Test awaited string pairs match the synchronous call."""
+        strings = ["hello world", "hello world!", "completely different"]
+
+        async def run():
+            return await native.string_ops.find_string_duplicates_async(strings, 0.8)
+
+        dup_i, dup_j, _ = asyncio.run(run())
+        assert list(zip(dup_i.tolist(), dup_j.tolist())) == [(0, 1)]
+
+    def test_concurrent_calls(self):
+        """Test many futures can be in flight at once."""
+        corpus = np.random.randn(50, 16)
+        queries = [np.random.randn(16) for _ in range(20)]
+
+        async def run():
+            return await asyncio.gather(*(
+                native.vector_ops.cosine_similarity_batch_async(q, corpus) for q in queries
+            ))
+
+        results = asyncio.run(run())
+        for q, result in zip(queries, results):
+            expected = native.vector_ops.cosine_similarity_batch(q, corpus)
+            np.testing.assert_allclose(result, expected, atol=1e-12)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestAsyncBehaviour:
+    """Loop integration, errors and cancellation."""
+
+    def test_requires_running_loop(self):
+        """Test calling outside a coroutine raises instead of blocking."""
+        with pytest.raises(RuntimeError):
+            native.vector_ops.cosine_similarity_batch_async(np.ones(3), np.ones((2, 3)))
+
+    def test_validation_errors_raise_immediately(self):
+        """Test shape errors surface at call time, before any work is queued."""
+        async def run():
+            native.vector_ops.cosine_similarity_batch_async(np.ones(3), np.ones((2, 4)))
+
+        with pytest.raises(ValueError):
+            asyncio.run(run())
+
+    def test_loop_stays_responsive(self):
+        """Test the event loop keeps running while a large dedup is in flight."""
+        embeddings = np.random.randn(1500, 256)
+
+        async def run():
+            ticks = 0
+            future = native.vector_ops.find_duplicates_by_embedding_async(embeddings, 0.99)
+            while not future.done():
+                ticks += 1
+                await asyncio.sleep(0)
+            await future
+            return ticks
+
+        assert asyncio.run(run()) > 0
+
+    def test_cancellation(self):
+        """Test a cancelled future raises CancelledError and the pool keeps working."""
+        embeddings = np.random.randn(4000, 512)
+
+        async def run():
+            future = native.vector_ops.find_duplicates_by_embedding_async(embeddings, 0.99)
+            await asyncio.sleep(0)
+            future.cancel()
+            with pytest.raises(asyncio.CancelledError):
+                await future
+
+            # Subsequent calls still complete normally
+            small = np.eye(3)
+            dup_i, _, _ = await native.vector_ops.find_duplicates_by_embedding_async(small, 0.5)
+            return len(dup_i)
+
+        assert asyncio.run(run()) == 0
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v"])
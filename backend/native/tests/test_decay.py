@@ -228,11 +228,12 @@ class TestDecayBatch:
         connection_count = np.random.randint(0, 10, n).astype(np.int32)
         last_access_hours = np.random.uniform(-1, 100, n).astype(np.float64)
         memory_type = np.random.randint(0, 4, n).astype(np.int32)
+        channel_mentions = np.zeros(n, dtype=np.int32)
 
         results = native.decay_ops.calculate_batch_numpy(
             importance, hours_passed, access_count,
             connection_count, last_access_hours, memory_type,
-            decay_config
+            channel_mentions, decay_config
         )
 
         assert len(results) == n
@@ -245,10 +246,156 @@ class TestDecayBatch:
             )
             assert abs(results[i] - expected) < 1e-6, f"Mismatch at index {i}"
 
+    def _columns(self, n):
+        import numpy as np
+
+        rng = np.random.default_rng(3)
+        return (
+            rng.uniform(0.1, 1.0, n),
+            rng.uniform(0, 1000, n),
+            rng.integers(0, 50, n).astype(np.int32),
+            rng.integers(0, 10, n).astype(np.int32),
+            rng.uniform(-1, 100, n),
+            rng.integers(0, 4, n).astype(np.int32),
+            rng.integers(0, 5, n).astype(np.int32),
+        )
+
+    def test_numpy_batch_out_buffer(self, decay_config):
+        """Test results are written into a caller-provided out array."""
+        import numpy as np
+
+        cols = self._columns(37)
+        out = np.empty(37, dtype=np.float64)
+
+        result = native.decay_ops.calculate_batch_numpy(*cols, decay_config, out=out)
+
+        assert result is out
+        expected = native.decay_ops.calculate_batch_numpy(*cols, decay_config)
+        np.testing.assert_allclose(out, expected, atol=1e-12)
+
+    def test_numpy_batch_strided_inputs(self, decay_config):
+        """Test strided column views give the same results as contiguous ones."""
+        import numpy as np
+
+        cols = self._columns(600)
+        strided = tuple(c[::3] for c in cols)
+        contiguous = tuple(np.ascontiguousarray(c) for c in strided)
+
+        result = native.decay_ops.calculate_batch_numpy(*strided, decay_config)
+        expected = native.decay_ops.calculate_batch_numpy(*contiguous, decay_config)
+
+        np.testing.assert_allclose(result, expected, atol=1e-12)
+
+    def test_numpy_batch_length_mismatch_raises(self, decay_config):
+        """Test mismatched column lengths raise instead of reading past the end."""
+        cols = list(self._columns(10))
+        cols[3] = cols[3][:5]
+
+        with pytest.raises(ValueError):
+            native.decay_ops.calculate_batch_numpy(*cols, decay_config)
+
+    def _records(self, cols):
+        import numpy as np
+
+        imp, hrs, acc, conn, last, mtype, chmnt = cols
+        records = np.zeros(len(imp), dtype=native.decay_ops.RECORD_DTYPE)
+        records["importance"] = imp
+        records["hours_passed"] = hrs
+        records["access_count"] = acc
+        records["connection_count"] = conn
+        records["last_access_hours"] = last
+        records["memory_type"] = mtype
+        records["channel_mentions"] = chmnt
+        return records
+
+    def test_record_dtype_layout(self):
+        """Test RECORD_DTYPE matches the documented 40-byte C layout."""
+        dtype = native.decay_ops.RECORD_DTYPE
+        assert dtype.itemsize == 40
+        offsets = {name: dtype.fields[name][1] for name in dtype.names}
+        assert offsets == {
+            "importance": 0,
+            "hours_passed": 8,
+            "last_access_hours": 16,
+            "access_count": 24,
+            "connection_count": 28,
+            "memory_type": 32,
+            "channel_mentions": 36,
+        }
+
+    def test_records_match_columns(self, decay_config):
+        """Test one structured array gives the same results as seven columns."""
+        import numpy as np
+
+        cols = self._columns(301)
+        records = self._records(cols)
+
+        result = native.decay_ops.calculate_batch_numpy(records, decay_config)
+        expected = native.decay_ops.calculate_batch_numpy(*cols, decay_config)
+
+        np.testing.assert_allclose(result, expected, atol=1e-12)
+
+    def test_records_from_packed_bytes(self, decay_config):
+        """Test a raw buffer of packed records is accepted."""
+        import numpy as np
+
+        cols = self._columns(50)
+        records = self._records(cols)
+        out = np.empty(50)
+
+        native.decay_ops.calculate_batch_numpy(records.tobytes(), decay_config, out=out)
+        expected = native.decay_ops.calculate_batch_numpy(records, decay_config)
+
+        np.testing.assert_allclose(out, expected, atol=1e-12)
+
+    def test_records_any_field_order(self, decay_config):
+        """Test fields are read by name, with extra fields and row slices."""
+        import numpy as np
+
+        cols = self._columns(40)
+        dtype = np.dtype([
+            ("memory_id", "S8"),
+            ("channel_mentions", np.int32),
+            ("importance", np.float64),
+            ("memory_type", np.int32),
+            ("hours_passed", np.float64),
+            ("access_count", np.int32),
+            ("last_access_hours", np.float64),
+            ("connection_count", np.int32),
+        ])
+        shuffled = np.zeros(40, dtype=dtype)
+        for name in native.decay_ops.RECORD_DTYPE.names:
+            shuffled[name] = self._records(cols)[name]
+
+        result = native.decay_ops.calculate_batch_numpy(shuffled[::2], decay_config)
+        expected = native.decay_ops.calculate_batch_numpy(
+            *(c[::2] for c in cols), decay_config
+        )
+
+        np.testing.assert_allclose(result, expected, atol=1e-12)
+
+    def test_records_bad_buffer_size_raises(self, decay_config):
+        """Test a buffer that is not a whole number of records is rejected."""
+        with pytest.raises(ValueError):
+            native.decay_ops.calculate_batch_numpy(b"\x00" * 41, decay_config)
+
+    def test_records_wrong_field_type_raises(self, decay_config):
+        """Test a field with the wrong dtype is rejected, not reinterpreted."""
+        import numpy as np
+
+        descr = [
+            (name, np.float32 if name == "importance" else dt)
+            for name, (dt, _) in native.decay_ops.RECORD_DTYPE.fields.items()
+        ]
+        records = np.zeros(4, dtype=descr)
+
+        with pytest.raises(TypeError):
+            native.decay_ops.calculate_batch_numpy(records, decay_config)
+
     def test_empty_batch(self, decay_config):
         """Test empty batch handling."""
         results = native.decay_ops.calculate_batch([], decay_config)
-        assert results == []
+        assert len(results) == 0
 
 
 @pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
@@ -0,0 +1,138 @@
+"""Tests for the native event ring."""
+
+import threading
+
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestEventRing:
+    """Tests for EventRing push, snapshot and index reads."""
+
+    def test_recent_is_oldest_first(self):
+        """Test recent() returns the last n events in push order."""
+        ring = native.events.EventRing(8, 4)
+        for i in range(5):
+            ring.push(i % 2, f"id{i}", 100.0 + i, f'{{"i": {i}}}')
+        events = ring.recent(3)
+        assert [e[0] for e in events] == [2, 3, 4]
+        seq, type_, ts, event_id, metadata = events[0]
+        assert (type_, ts, event_id, metadata) == (0, 102.0, "id2", b'{"i": 2}')
+
+    def test_overwrites_oldest_when_full(self):
+        """Test the ring keeps the newest capacity events and counts drops."""
+        ring = native.events.EventRing(4)
+        for i in range(10):
+            ring.push(0, str(i), float(i))
+        assert [e[3] for e in ring.recent(100)] == ["6", "7", "8", "9"]
+        stats = ring.stats()
+        assert stats["pushed"] == 10
+        assert stats["dropped"] == 6
+        assert stats["size"] == 4
+        assert len(ring) == 4
+
+    def test_by_type_most_recent_first(self):
+        """Test the per-type index returns newest events of one type."""
+        ring = native.events.EventRing(16, 3)
+        for i in range(9):
+            ring.push(i % 3, str(i), 0.0)
+        assert [e[3] for e in ring.by_type(1, 2)] == ["7", "4"]
+        assert ring.by_type(2, 0) == []
+
+    def test_by_type_skips_overwritten(self):
+        """Test index entries whose slot was overwritten are not returned."""
+        ring = native.events.EventRing(4, 2)
+        ring.push(1, "old", 0.0)
+        for i in range(4):
+            ring.push(0, str(i), 0.0)
+        assert ring.by_type(1, 10) == []
+
+    def test_oversize_metadata_reads_none(self):
+        """Test metadata larger than the slot's arena space is dropped."""
+        ring = native.events.EventRing(4, 1, 16)
+        ring.push(0, "big", 0.0, "x" * 100)
+        ring.push(0, "small", 0.0, "ok")
+        events = ring.recent(2)
+        assert events[0][4] is None
+        assert events[1][4] == b"ok"
+        assert ring.stats()["metadata_oversize"] == 1
+
+    def test_event_id_truncated(self):
+        """Test long event ids are cut to the record size."""
+        ring = native.events.EventRing(2)
+        ring.push(0, "a" * 40, 0.0)
+        assert ring.recent(1)[0][3] == "a" * 23
+
+    def test_type_out_of_range(self):
+        """Test pushing an unknown type index raises."""
+        ring = native.events.EventRing(2, 2)
+        with pytest.raises(IndexError):
+            ring.push(2, "x", 0.0)
+
+    def test_clear_keeps_counters(self):
+        """Test clear() hides events but keeps pushed/dropped."""
+        ring = native.events.EventRing(2)
+        for i in range(3):
+            ring.push(0, str(i), 0.0)
+        ring.clear()
+        assert ring.recent(10) == []
+        assert ring.stats()["pushed"] == 3
+        assert ring.stats()["dropped"] == 1
+        ring.push(0, "new", 0.0)
+        assert [e[3] for e in ring.recent(10)] == ["new"]
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestEventRingDrain:
+    """Tests for cursor-based batch drain."""
+
+    def test_drain_in_batches(self):
+        """Test drain resumes from next_cursor without gaps or repeats."""
+        ring = native.events.EventRing(64)
+        for i in range(10):
+            ring.push(0, str(i), 0.0)
+        seen = []
+        cursor = 0
+        while True:
+            events, cursor, missed = ring.drain(cursor, 4)
+            assert missed == 0
+            if not events:
+                break
+            seen.extend(e[3] for e in events)
+        assert seen == [str(i) for i in range(10)]
+        assert cursor == ring.head
+
+    def test_drain_reports_missed(self):
+        """Test a lagging cursor reports overwritten events."""
+        ring = native.events.EventRing(4)
+        for i in range(10):
+            ring.push(0, str(i), 0.0)
+        events, cursor, missed = ring.drain(0)
+        assert missed == 6
+        assert [e[3] for e in events] == ["6", "7", "8", "9"]
+        assert cursor == 10
+
+    def test_concurrent_producers(self):
+        """Test records stay intact with several pushing threads."""
+        ring = native.events.EventRing(256, 4)
+
+        def produce(t):
+            for i in range(2000):
+                ring.push(t, f"p{t}", float(i), f'{{"t": {t}}}')
+
+        threads = [threading.Thread(target=produce, args=(t,)) for t in range(4)]
+        for th in threads:
+            th.start()
+        for th in threads:
+            th.join()
+        assert ring.head == 8000
+        for seq, type_, ts, event_id, metadata in ring.recent(256):
+            assert event_id == f"p{type_}"
+            assert metadata == f'{{"t": {type_}}}'.encode()
@@ -0,0 +1,146 @@
+"""Tests for native content hashing."""
+
+import random
+import unicodedata
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+try:
+    import xxhash
+    HAS_XXHASH = True
+except ImportError:
+    xxhash = None
+    HAS_XXHASH = False
+
+
+def _reference_normalize(text, collapse_whitespace=False, casefold=False, max_chars=0,
+                         nfkc=False):
+    if nfkc:
+        text = unicodedata.normalize("NFKC", text)
+    if casefold:
+        text = text.casefold()
+    if collapse_whitespace:
+        text = " ".join(text.split())
+    if max_chars:
+        text = text[:max_chars]
+    return text
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestXXH3:
+    """Tests for the scalar XXH3 port."""
+
+    @pytest.mark.skipif(not HAS_XXHASH, reason="xxhash not installed")
+    @pytest.mark.parametrize("seed", [0, 1, 0x9E3779B97F4A7C15])
+    def test_matches_reference_across_lengths(self, seed):
+        """Test every length class (0-16, 17-128, 129-240, long) against xxhash."""
+        rng = random.Random(seed)
+        for length in list(range(0, 260)) + [1023, 1024, 1025, 4096, 10000]:
+            data = bytes(rng.getrandbits(8) for _ in range(length))
+            assert native.hashing.xxh3_64(data, seed) == xxhash.xxh3_64_intdigest(data, seed)
+            assert native.hashing.xxh3_128(data, seed) == xxhash.xxh3_128_intdigest(data, seed)
+
+    def test_str_hashed_as_utf8(self):
+        """Test str input hashes the same as its UTF-8 bytes."""
+        text = "안녕하세요 axel"
+        assert native.hashing.xxh3_64(text) == native.hashing.xxh3_64(text.encode())
+
+    def test_seed_changes_hash(self):
+        """Test different seeds give different hashes."""
+        assert native.hashing.xxh3_64(b"memory", 0) != native.hashing.xxh3_64(b"memory", 1)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestNormalize:
+    """Tests for hash normalization."""
+
+    def test_identity_by_default(self):
+        """Test no options leaves text untouched."""
+        text = "  Mixed\tCase 　text "
+        assert native.hashing.normalize(text) == text
+
+    def test_matches_python_semantics(self):
+        """Test collapse/fold/truncate match the Python reference on random text."""
+        rng = random.Random(3)
+        alphabet = "aZ \t\n\r\x0b\x0c\x1c\x85\xa0 　​가éßﬁＦ\u0301ᄀ\u1161"
+        for _ in range(500):
+            text = "".join(rng.choice(alphabet) for _ in range(rng.randint(0, 40)))
+            options = {
+                "collapse_whitespace": rng.random() < 0.5,
+                "casefold": rng.random() < 0.5,
+                "max_chars": rng.choice([0, 1, 5, 20]),
+                "nfkc": rng.random() < 0.5,
+            }
+            assert native.hashing.normalize(text, **options) == _reference_normalize(text, **options)
+
+    def test_casefold_is_full_unicode(self):
+        """Test non-ASCII letters fold like str.casefold()."""
+        assert native.hashing.normalize("ÉAß", casefold=True) == "éass"
+
+    def test_nfkc_before_collapse(self):
+        """Test NFKC runs first, so the ideographic space it maps is collapsed."""
+        assert native.hashing.normalize("Ｆｕｌｌ　 ｗｉｄｔｈ", nfkc=True,
+                                        collapse_whitespace=True) == "Full width"
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestHashBatch:
+    """Tests for batched hashing."""
+
+    def test_shapes_and_values(self):
+        """Test 64- and 128-bit outputs agree with the scalar hashes."""
+        texts = [f"memory {i}" for i in range(1000)]
+        h64 = native.hashing.hash_batch(texts)
+        h128 = native.hashing.hash_batch(texts, bits=128)
+        assert h64.dtype == np.uint64 and h64.shape == (1000,)
+        assert h128.dtype == np.uint64 and h128.shape == (1000, 2)
+        for i in (0, 499, 999):
+            assert int(h64[i]) == native.hashing.xxh3_64(texts[i])
+            low, high = int(h128[i, 0]), int(h128[i, 1])
+            assert (high << 64) | low == native.hashing.xxh3_128(texts[i])
+
+    def test_normalization_applied(self):
+        """Test texts equal after normalization hash equally."""
+        h = native.hashing.hash_batch(["Hello  World", " hello world "],
+                                      collapse_whitespace=True, casefold=True)
+        assert h[0] == h[1]
+
+    def test_invalid_bits(self):
+        """Test bits other than 64/128 are rejected."""
+        with pytest.raises(ValueError):
+            native.hashing.hash_batch(["a"], bits=32)
+
+    def test_empty(self):
+        """Test an empty batch returns an empty array."""
+        assert native.hashing.hash_batch([]).shape == (0,)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestDuplicateGroups:
+    """Tests for exact-duplicate grouping."""
+
+    def test_groups_ordered_by_first_index(self):
+        """Test only repeated texts are grouped, in first-occurrence order."""
+        texts = ["b", "a", "c", "a", "b", "a"]
+        groups = native.hashing.duplicate_groups(texts)
+        assert [g.tolist() for g in groups] == [[0, 4], [1, 3, 5]]
+
+    def test_normalized_grouping(self):
+        """Test grouping respects normalization options."""
+        texts = ["Same text", "same   TEXT", "other"]
+        assert native.hashing.duplicate_groups(texts) == []
+        groups = native.hashing.duplicate_groups(texts, collapse_whitespace=True, casefold=True)
+        assert [g.tolist() for g in groups] == [[0, 1]]
+
+    def test_truncation(self):
+        """Test max_chars compares only the prefix."""
+        groups = native.hashing.duplicate_groups(["prefix-1", "prefix-2"], max_chars=6)
+        assert [g.tolist() for g in groups] == [[0, 1]]
@@ -0,0 +1,152 @@
+"""Tests for the native interaction log writer and columnar reader."""
+
+import threading
+import time
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+def _append(writer, i, **kwargs):
+    return writer.append(
+        1000.0 + i, session_id=f"s{i % 3}", model="gemini", tier="standard",
+        latency_ms=i, tool_call_count=i % 2, **kwargs)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestLogWriter:
+    """Tests for queued, segmented writes."""
+
+    def test_round_trip(self, tmp_path):
+        """Test appended records come back as columns in order."""
+        writer = native.interaction_log.LogWriter(str(tmp_path))
+        for i in range(100):
+            assert _append(writer, i)
+        writer.append(2000.0, error="timeout", refusal=True)
+        writer.close()
+
+        cols = native.interaction_log.read_columns(str(tmp_path))
+        assert cols["corrupt"] == 0
+        np.testing.assert_array_equal(cols["latency_ms"][:100], np.arange(100))
+        assert cols["latency_ms"][100] == -1
+        assert list(cols["has_error"][-2:]) == [0, 1]
+        assert cols["refusal"][-1] == 1
+        codes, dictionary = cols["session_id"]
+        assert [dictionary[c] for c in codes[:4]] == ["s0", "s1", "s2", "s0"]
+
+    def test_since_filter(self, tmp_path):
+        """Test read_columns skips records older than `since`."""
+        writer = native.interaction_log.LogWriter(str(tmp_path))
+        for i in range(10):
+            _append(writer, i)
+        writer.flush()
+        cols = native.interaction_log.read_columns(str(tmp_path), since=1007.0)
+        assert list(cols["timestamp"]) == [1007.0, 1008.0, 1009.0]
+        writer.close()
+
+    def test_segments_rotate(self, tmp_path):
+        """Test small segment_bytes spreads records over several files."""
+        writer = native.interaction_log.LogWriter(str(tmp_path), segment_bytes=1024)
+        for i in range(200):
+            _append(writer, i)
+        writer.close()
+        segments = native.interaction_log.list_segments(str(tmp_path))
+        assert len(segments) > 1
+        assert len(native.interaction_log.read_columns(str(tmp_path))["timestamp"]) == 200
+
+    def test_reopen_starts_new_segment(self, tmp_path):
+        """Test a new writer never appends to an existing segment."""
+        for _ in range(2):
+            writer = native.interaction_log.LogWriter(str(tmp_path))
+            _append(writer, 0)
+            writer.close()
+        assert len(native.interaction_log.list_segments(str(tmp_path))) == 2
+
+    def test_torn_tail_is_skipped(self, tmp_path):
+        """Test a truncated final record is reported, earlier ones kept."""
+        writer = native.interaction_log.LogWriter(str(tmp_path))
+        for i in range(5):
+            _append(writer, i)
+        writer.close()
+        segment = native.interaction_log.list_segments(str(tmp_path))[-1]
+        with open(segment, "r+b") as f:
+            f.truncate(f.seek(0, 2) - 3)
+        cols = native.interaction_log.read_columns(str(tmp_path))
+        assert len(cols["timestamp"]) == 4
+        assert cols["corrupt"] == 1
+
+    def test_index_skips_old_segments(self, tmp_path):
+        """Test closed segments that end before `since` are not scanned."""
+        writer = native.interaction_log.LogWriter(str(tmp_path), segment_bytes=1024)
+        for i in range(200):
+            _append(writer, i)
+            writer.flush()
+        writer.close()
+        cols = native.interaction_log.read_columns(str(tmp_path), since=1190.0)
+        assert list(cols["timestamp"]) == [1190.0 + i for i in range(10)]
+        assert cols["skipped"] == cols["segments"] - 1
+        assert native.interaction_log.read_columns(str(tmp_path))["skipped"] == 0
+
+    def test_retention_by_bytes(self, tmp_path):
+        """Test the oldest segments are deleted past max_total_bytes."""
+        writer = native.interaction_log.LogWriter(
+            str(tmp_path), segment_bytes=1024, max_total_bytes=4096)
+        for i in range(200):
+            _append(writer, i)
+            writer.flush()
+        writer.close()
+        assert writer.stats()["segments_deleted"] > 0
+        cols = native.interaction_log.read_columns(str(tmp_path))
+        assert cols["timestamp"][-1] == 1199.0
+        assert cols["timestamp"][0] > 1000.0
+        assert not [p for p in tmp_path.glob("*.axidx") if not p.with_suffix(".axlog").exists()]
+
+    def test_retention_by_age(self, tmp_path):
+        """Test segments whose newest record is older than max_age_seconds are deleted."""
+        old = native.interaction_log.LogWriter(str(tmp_path))
+        _append(old, 0)
+        old.close()
+        writer = native.interaction_log.LogWriter(str(tmp_path), max_age_seconds=3600)
+        writer.append(time.time())
+        writer.close()
+        assert writer.stats()["segments_deleted"] == 1
+        assert len(native.interaction_log.list_segments(str(tmp_path))) == 1
+
+    def test_concurrent_appends(self, tmp_path):
+        """Test appends from several threads are all written once."""
+        writer = native.interaction_log.LogWriter(str(tmp_path), queue_capacity=64)
+
+        def produce(offset):
+            for i in range(500):
+                while not _append(writer, offset + i):
+                    pass
+
+        threads = [threading.Thread(target=produce, args=(t * 1000,)) for t in range(4)]
+        for th in threads:
+            th.start()
+        for th in threads:
+            th.join()
+        writer.close()
+        stats = writer.stats()
+        assert stats["written"] == stats["appended"] == 2000
+        cols = native.interaction_log.read_columns(str(tmp_path))
+        assert sorted(cols["latency_ms"]) == sorted(t * 1000 + i for t in range(4) for i in range(500))
+
+    def test_append_after_close_is_dropped(self, tmp_path):
+        """Test a closed writer rejects records."""
+        writer = native.interaction_log.LogWriter(str(tmp_path))
+        writer.close()
+        assert not _append(writer, 0)
+        assert writer.stats()["dropped"] == 1
+
+    def test_missing_directory_reads_empty(self, tmp_path):
+        """Test reading a directory with no segments."""
+        cols = native.interaction_log.read_columns(str(tmp_path / "none"))
+        assert len(cols["timestamp"]) == 0
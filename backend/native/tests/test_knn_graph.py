@@ -0,0 +1,148 @@
+"""Tests for native kNN graph construction."""
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+def _clustered(n, dim, clusters, seed, spread=0.7):
+    rng = np.random.default_rng(seed)
+    centers = rng.standard_normal((clusters, dim))
+    return centers[rng.integers(0, clusters, n)] + spread * rng.standard_normal((n, dim))
+
+
+def _exact_neighbors(x, k):
+    unit = x / np.linalg.norm(x, axis=1, keepdims=True)
+    sims = unit @ unit.T
+    np.fill_diagonal(sims, -np.inf)
+    # Stable sort on -sim breaks ties by the lower index, like the native build
+    order = np.argsort(-sims, axis=1, kind="stable")[:, :k]
+    return order, np.take_along_axis(sims, order, axis=1)
+
+
+def _rows(indptr, indices):
+    return [indices[indptr[i]:indptr[i + 1]] for i in range(len(indptr) - 1)]
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestKnnBuild:
+    def test_exact_matches_brute_force(self):
+        x = _clustered(700, 48, 20, seed=1)
+        indptr, indices, scores = native.knn.build(x, 8, method="exact")
+
+        assert indptr.dtype == np.int64 and indices.dtype == np.int64
+        assert scores.dtype == np.float32
+        assert indptr.tolist() == list(range(0, 700 * 8 + 1, 8))
+        expected, expected_scores = _exact_neighbors(x, 8)
+        # float32 scores may swap near-ties; the score lists must still agree
+        np.testing.assert_allclose(scores.reshape(700, 8), expected_scores, atol=1e-5)
+        assert np.mean(indices.reshape(700, 8) == expected) > 0.99
+
+    def test_rows_are_best_first_without_self(self):
+        x = _clustered(300, 32, 10, seed=2)
+        indptr, indices, scores = native.knn.build(x, 5, method="exact")
+        for i, row in enumerate(_rows(indptr, indices)):
+            assert i not in row.tolist()
+            assert len(set(row.tolist())) == 5
+        for row_scores in _rows(indptr, scores):
+            assert np.all(np.diff(row_scores) <= 0)
+
+    def test_nn_descent_recall(self):
+        x = _clustered(3000, 32, 60, seed=3)
+        indptr, indices, _ = native.knn.build(x, 10, method="nn_descent", seed=1)
+        assert np.all(np.diff(indptr) == 10)
+
+        expected, _ = _exact_neighbors(x, 10)
+        found = indices.reshape(3000, 10)
+        recall = np.mean([len(np.intersect1d(found[i], expected[i])) / 10 for i in range(3000)])
+        assert recall > 0.95
+
+    def test_auto_uses_exact_for_small_inputs(self):
+        x = _clustered(200, 16, 5, seed=4)
+        auto = native.knn.build(x, 6)
+        exact = native.knn.build(x, 6, method="exact")
+        for a, b in zip(auto, exact):
+            np.testing.assert_array_equal(a, b)
+
+    def test_min_similarity_shortens_rows(self):
+        x = _clustered(400, 32, 8, seed=5, spread=2.0)
+        indptr, _, scores = native.knn.build(x, 10, method="exact", min_similarity=0.5)
+        assert np.all(scores >= 0.5)
+        assert np.all(np.diff(indptr) <= 10) and indptr[-1] < 4000
+
+    def test_small_inputs(self):
+        indptr, indices, _ = native.knn.build(np.eye(3), 10)
+        assert indptr.tolist() == [0, 2, 4, 6]
+        assert sorted(_rows(indptr, indices)[0].tolist()) == [1, 2]
+
+        indptr, indices, scores = native.knn.build(np.ones((1, 4)), 5)
+        assert indptr.tolist() == [0, 0] and len(indices) == 0 and len(scores) == 0
+
+    def test_strided_input(self):
+        x = _clustered(150, 24, 6, seed=6)
+        wide = np.zeros((150, 48))
+        wide[:, ::2] = x
+        for a, b in zip(native.knn.build(wide[:, ::2], 5), native.knn.build(x, 5)):
+            np.testing.assert_array_equal(a, b)
+
+    def test_errors(self):
+        with pytest.raises(ValueError):
+            native.knn.build(np.ones((10, 4)), 0)
+        with pytest.raises(ValueError):
+            native.knn.build(np.ones((10, 4)), 3, method="hnsw")
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestKnnGraphUse:
+    def test_symmetrize(self):
+        x = _clustered(250, 16, 6, seed=7)
+        indptr, indices, scores = native.knn.build(x, 4, method="exact")
+        directed = {(i, int(j)) for i, row in enumerate(_rows(indptr, indices)) for j in row}
+
+        u_indptr, u_indices, u_scores = native.knn.symmetrize(indptr, indices, scores)
+        union = {(i, int(j)) for i, row in enumerate(_rows(u_indptr, u_indices)) for j in row}
+        assert union == directed | {(j, i) for i, j in directed}
+        for row_scores in _rows(u_indptr, u_scores):
+            assert np.all(np.diff(row_scores) <= 0)
+
+        m_indptr, m_indices, _ = native.knn.symmetrize(indptr, indices, scores, mutual=True)
+        mutual = {(i, int(j)) for i, row in enumerate(_rows(m_indptr, m_indices)) for j in row}
+        assert mutual == {(i, j) for i, j in directed if (j, i) in directed}
+
+    def test_components_find_clusters(self):
+        rng = np.random.default_rng(8)
+        centers = 10 * np.eye(6, 32)
+        labels = np.repeat(np.arange(6), 50)
+        x = centers[labels] + 0.5 * rng.standard_normal((300, 32))
+
+        indptr, indices, scores = native.knn.build(x, 5)
+        u_indptr, u_indices, _ = native.knn.symmetrize(indptr, indices, scores)
+        components = native.graph_ops.find_connected_components_csr(u_indptr, u_indices)
+
+        assert len(set(components.tolist())) == 6
+        for label in range(6):
+            assert len(set(components[labels == label].tolist())) == 1
+
+    def test_bfs_csr_matches_dict(self):
+        x = _clustered(120, 16, 4, seed=9)
+        indptr, indices, _ = native.knn.build(x, 3)
+        adjacency = {i: row.tolist() for i, row in enumerate(_rows(indptr, indices))}
+        for start in ([0], [5, 17]):
+            csr = native.graph_ops.bfs_neighbors_csr(indptr, indices, start, 2)
+            legacy = native.graph_ops.bfs_neighbors(adjacency, start, 2)
+            assert csr.tolist() == legacy.tolist()
+
+    def test_invalid_csr(self):
+        with pytest.raises(ValueError):
+            native.graph_ops.find_connected_components_csr(
+                np.array([0, 2, 1]), np.array([1, 0]))
+        with pytest.raises(ValueError):
+            native.graph_ops.bfs_neighbors_csr(np.array([0, 1]), np.array([5]), [0], 1)
+        with pytest.raises(ValueError):
+            native.knn.symmetrize(np.array([0, 1]), np.array([0]), np.zeros(2, dtype=np.float32))
@@ -0,0 +1,153 @@
+"""Tests for native embedding-space mapping."""
+
+import threading
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+def _unit(x):
+    return x / np.linalg.norm(x, axis=-1, keepdims=True)
+
+
+def _paired(n, source_dim, target_dim, seed, noise=0.05):
+    """Source rows and their image under a random linear map plus noise."""
+    rng = np.random.default_rng(seed)
+    x = rng.standard_normal((n, source_dim))
+    a = rng.standard_normal((target_dim, source_dim))
+    y = x @ a.T + noise * rng.standard_normal((n, target_dim)) * np.sqrt(source_dim)
+    return x, y
+
+
+def _procrustes(x, y):
+    u, _, vt = np.linalg.svd(_unit(x).T @ _unit(y), full_matrices=False)
+    return (u @ vt).T
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestLinearMap:
+    @pytest.mark.parametrize("source_dim,target_dim", [(32, 48), (48, 32), (40, 40)])
+    def test_procrustes_matches_svd(self, source_dim, target_dim):
+        x, y = _paired(500, source_dim, target_dim, seed=1)
+        mapping = native.mapping.LinearMap(source_dim, target_dim)
+        assert not mapping.fitted
+        mapping.fit(x, y)
+
+        w = mapping.matrix
+        assert w.shape == (target_dim, source_dim)
+        np.testing.assert_allclose(w, _procrustes(x, y), atol=1e-5)
+        # Semi-orthogonal: the narrower side keeps its geometry
+        small = min(source_dim, target_dim)
+        gram = w.T @ w if source_dim <= target_dim else w @ w.T
+        np.testing.assert_allclose(gram, np.eye(small), atol=1e-5)
+
+    def test_recovers_rotation(self):
+        rng = np.random.default_rng(2)
+        rotation = np.linalg.qr(rng.standard_normal((64, 64)))[0]
+        x = rng.standard_normal((300, 64))
+        mapping = native.mapping.LinearMap(64, 64)
+        mapping.fit(x, x @ rotation.T)
+        np.testing.assert_allclose(mapping.matrix, rotation, atol=1e-5)
+
+    def test_least_squares_matches_ridge(self):
+        x, y = _paired(400, 48, 64, seed=3)
+        mapping = native.mapping.LinearMap(48, 64)
+        mapping.fit(x, y, method="least_squares", ridge=1e-2)
+
+        xn, yn = _unit(x), _unit(y)
+        gram = xn.T @ xn
+        penalty = 1e-2 * np.trace(gram) / 48
+        expected = np.linalg.solve(gram + penalty * np.eye(48), xn.T @ yn).T
+        np.testing.assert_allclose(mapping.matrix, expected, atol=1e-5)
+
+    def test_apply_matches_matrix_product(self):
+        x, y = _paired(333, 40, 56, seed=4)
+        mapping = native.mapping.LinearMap(40, 56)
+        mapping.fit(x, y)
+
+        expected = _unit(x).astype(np.float32) @ mapping.matrix.T
+        raw = mapping.apply(x, normalize=False)
+        assert raw.dtype == np.float64 and raw.shape == (333, 56)
+        np.testing.assert_allclose(raw, expected, atol=1e-5)
+        np.testing.assert_allclose(mapping.apply(x), _unit(expected), atol=1e-5)
+
+    def test_apply_while_fitting(self):
+        """Test mapping during a refit uses one fitted matrix, never a mix."""
+        x, y = _paired(300, 32, 40, seed=9)
+        mapping = native.mapping.LinearMap(32, 40)
+        expected = []
+        for method in ("procrustes", "least_squares"):
+            mapping.fit(x, y, method=method)
+            expected.append(mapping.apply(x[:50]))
+
+        def refit():
+            for i in range(10):
+                mapping.fit(x, y, method=("procrustes", "least_squares")[i % 2])
+
+        fitter = threading.Thread(target=refit)
+        fitter.start()
+        while fitter.is_alive():
+            out = mapping.apply(x[:50])
+            assert any(np.array_equal(out, e) for e in expected)
+        fitter.join()
+
+    def test_strided_input(self):
+        x, y = _paired(100, 24, 32, seed=5)
+        wide = np.zeros((100, 48))
+        wide[:, ::2] = x
+        mapping = native.mapping.LinearMap(24, 32)
+        mapping.fit(wide[:, ::2], y)
+        np.testing.assert_allclose(mapping.apply(wide[:, ::2]), mapping.apply(x), atol=1e-12)
+
+    def test_evaluate(self):
+        x, y = _paired(1000, 48, 64, seed=6)
+        fitted = native.mapping.LinearMap(48, 64)
+        fitted.fit(x[:600], y[:600], method="least_squares")
+
+        report = fitted.evaluate(x[600:], y[600:], k=10, queries=100)
+        assert report["pairs"] == 400 and report["queries"] == 100 and report["k"] == 10
+        assert report["mean_cosine"] > 0.99 and report["min_cosine"] <= report["mean_cosine"]
+        assert report["neighbor_overlap"] > 0.8
+        assert report["top1"] == 1.0
+
+        # A map that ignores the relation scores far worse
+        rng = np.random.default_rng(7)
+        unrelated = native.mapping.LinearMap(48, 64)
+        unrelated.fit(rng.standard_normal((600, 48)), rng.standard_normal((600, 64)))
+        baseline = unrelated.evaluate(x[600:], y[600:], k=10, queries=100)
+        assert baseline["neighbor_overlap"] < report["neighbor_overlap"]
+        assert baseline["mean_cosine"] < 0.5
+
+    def test_from_matrix_round_trip(self):
+        x, y = _paired(200, 32, 40, seed=8)
+        mapping = native.mapping.LinearMap(32, 40)
+        mapping.fit(x, y)
+
+        restored = native.mapping.LinearMap.from_matrix(mapping.matrix)
+        assert (restored.source_dim, restored.target_dim) == (32, 40)
+        np.testing.assert_array_equal(restored.apply(x), mapping.apply(x))
+
+    def test_errors(self):
+        with pytest.raises(ValueError):
+            native.mapping.LinearMap(0, 8)
+        mapping = native.mapping.LinearMap(8, 12)
+        with pytest.raises(RuntimeError):
+            mapping.apply(np.zeros((2, 8)))
+        with pytest.raises(ValueError):
+            mapping.fit(np.ones((5, 8)), np.ones((4, 12)))  # unpaired rows
+        with pytest.raises(ValueError):
+            mapping.fit(np.ones((5, 8)), np.ones((5, 12)), method="cca")
+
+        x, y = _paired(50, 8, 12, seed=9)
+        mapping.fit(x, y)
+        with pytest.raises(ValueError):
+            mapping.apply(np.zeros((2, 12)))
+        with pytest.raises(ValueError):
+            mapping.evaluate(x[:5], y[:5], k=10)
@@ -0,0 +1,208 @@
+"""Tests for the native MemoryEngine facade."""
+
+import asyncio
+import math
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+NOW = 1_700_000_000.0
+
+
+def _engine(dim=4):
+    return native.memory_engine.MemoryEngine(dim)
+
+
+def _filters(**kwargs):
+    filters = native.memory_engine.BuildFilters()
+    for key, value in kwargs.items():
+        setattr(filters, key, value)
+    return filters
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestMemoryEngineStore:
+    """Insert, overwrite and remove."""
+
+    def test_upsert_and_len(self):
+        """Test upsert adds rows and overwrites by id."""
+        engine = _engine()
+        engine.upsert("a", np.array([1.0, 0, 0, 0]))
+        engine.upsert("b", np.array([0, 1.0, 0, 0]))
+        engine.upsert("a", np.array([0, 0, 1.0, 0]))
+        assert len(engine) == 2
+        assert "a" in engine
+
+    def test_remove(self):
+        """Test removed memories are never selected."""
+        engine = _engine()
+        engine.upsert("a", np.array([1.0, 0, 0, 0]), token_cost=1)
+        assert engine.remove("a")
+        assert not engine.remove("a")
+        ids, _, _ = engine.build_context(np.array([1.0, 0, 0, 0]), now=NOW)
+        assert ids == []
+
+    def test_upsert_batch_shape_mismatch(self):
+        """Test a wrong embedding width raises ValueError."""
+        with pytest.raises(ValueError):
+            _engine().upsert_batch(["a"], np.zeros((1, 3)))
+
+    def test_unknown_id_raises_key_error(self):
+        """Test linking an unknown memory raises KeyError."""
+        with pytest.raises(KeyError):
+            _engine().link_entity("missing", "paris")
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestBuildContext:
+    """Candidate pipeline and budget packing."""
+
+    def test_matches_python_scoring(self):
+        """Test score = similarity * decay * importance weight."""
+        config = native.decay_ops.DecayConfig()
+        engine = native.memory_engine.MemoryEngine(4, config)
+        emb = np.array([0.6, 0.8, 0.0, 0.0])
+        engine.upsert("a", emb, importance=0.7, event_time=NOW - 48 * 3600,
+                      access_count=3, token_cost=10)
+
+        query = np.array([1.0, 0.0, 0.0, 0.0])
+        ids, scores, costs = engine.build_context(query, budget=100, now=NOW)
+
+        decay = native.decay_ops.calculate(
+            native.decay_ops.DecayInput(1.0, 48.0, access_count=3), config)
+        expected = 0.6 * decay * (0.5 + 0.5 * 0.7)
+        assert ids == ["a"]
+        assert scores[0] == pytest.approx(expected, rel=1e-5)
+        assert costs.tolist() == [10]
+
+    def test_budget_skips_items_that_do_not_fit(self):
+        """Test greedy packing skips oversized items but keeps going."""
+        engine = _engine()
+        engine.upsert("big", np.array([1.0, 0, 0, 0]), token_cost=80)
+        engine.upsert("small", np.array([0.9, 0.1, 0, 0]), token_cost=30)
+        engine.upsert("tiny", np.array([0.8, 0.2, 0, 0]), token_cost=10)
+
+        ids, _, costs = engine.build_context(np.array([1.0, 0, 0, 0]), budget=50, now=NOW)
+        assert ids == ["small", "tiny"]
+        assert costs.sum() <= 50
+
+    def test_non_positive_budget_returns_nothing(self):
+        """Test budget <= 0 selects nothing, even zero-cost rows."""
+        engine = _engine()
+        engine.upsert("a", np.array([1.0, 0, 0, 0]), token_cost=1)
+        for budget in (0, -5):
+            ids, _, _ = engine.build_context(np.array([1.0, 0, 0, 0]), budget=budget, now=NOW)
+            assert ids == []
+
+    def test_unknown_cost_is_not_free(self):
+        """Test rows without a token_cost use the index_text estimate or are skipped."""
+        engine = _engine()
+        engine.upsert("unknown", np.array([1.0, 0, 0, 0]))
+        engine.upsert("indexed", np.array([0.9, 0.1, 0, 0]))
+        engine.index_text("indexed", "x" * 40)
+
+        ids, _, costs = engine.build_context(np.array([1.0, 0, 0, 0]), budget=100, now=NOW)
+        assert ids == ["indexed"]
+        assert list(costs) == [10]
+        ids, _, _ = engine.build_context(np.array([1.0, 0, 0, 0]), budget=9, now=NOW)
+        assert ids == []
+
+    def test_topic_cap(self):
+        """Test max_per_topic limits memories sharing a topic."""
+        engine = _engine()
+        for i, name in enumerate(["a", "b", "c"]):
+            engine.upsert(name, np.array([1.0, 0.1 * i, 0, 0]), token_cost=1)
+            engine.set_topics(name, ["food"])
+
+        ids, _, _ = engine.build_context(
+            np.array([1.0, 0, 0, 0]), now=NOW, filters=_filters(max_per_topic=2))
+        assert ids == ["a", "b"]
+
+    def test_graph_expansion_adds_candidates(self):
+        """Test memories linked to nearby entities join the candidate set."""
+        engine = _engine()
+        engine.upsert("near", np.array([1.0, 0, 0, 0]), token_cost=1)
+        engine.upsert("linked", np.array([0, 0, 0, 1.0]), token_cost=1)
+        engine.link_entity("linked", "paris")
+        engine.add_relation("paris", "france")
+
+        query = np.array([1.0, 0, 0, 0])
+        ids, _, _ = engine.build_context(query, now=NOW, filters=_filters(candidate_count=1))
+        assert ids == ["near"]
+
+        ids, scores, _ = engine.build_context(
+            query, ["france"], now=NOW, filters=_filters(candidate_count=1, graph_depth=1))
+        assert ids == ["near", "linked"]
+        assert scores[1] == pytest.approx(0.1 / 2)
+
+    def test_keyword_blend(self):
+        """Test keyword matches are blended in when text_weight > 0."""
+        engine = _engine()
+        engine.upsert("a", np.array([0, 1.0, 0, 0]), token_cost=1)
+        engine.index_text("a", "Trip to PARIS")
+
+        filters = _filters(query_text="paris", text_weight=0.5)
+        ids, scores, _ = engine.build_context(np.array([1.0, 0, 0, 0]), now=NOW, filters=filters)
+        assert ids == ["a"]
+        assert scores[0] == pytest.approx(0.5 * 0.75, rel=1e-5)
+
+    def test_temporal_and_hot_boost(self):
+        """Test the temporal window and hot set boosts."""
+        engine = _engine()
+        engine.upsert("old", np.array([1.0, 0, 0, 0]), event_time=NOW - 3600, token_cost=1)
+        engine.upsert("hot", np.array([1.0, 0, 0, 0]), event_time=NOW - 3600, token_cost=1)
+        engine.set_hot(["hot"])
+
+        filters = _filters(time_from=NOW - 7200, time_to=NOW, temporal_target=1.0)
+        ids, scores, _ = engine.build_context(np.array([1.0, 0, 0, 0]), now=NOW, filters=filters)
+        assert ids == ["hot", "old"]
+        assert scores[0] - scores[1] == pytest.approx(0.1)
+        assert scores[1] > 0.6 * 0.75
+
+    def test_memory_type_mask(self):
+        """Test memory types outside the mask are excluded."""
+        engine = _engine()
+        engine.upsert("conv", np.array([1.0, 0, 0, 0]), memory_type=0, token_cost=1)
+        engine.upsert("fact", np.array([1.0, 0, 0, 0]), memory_type=1, token_cost=1)
+
+        ids, _, _ = engine.build_context(
+            np.array([1.0, 0, 0, 0]), now=NOW, filters=_filters(memory_type_mask=0b10))
+        assert ids == ["fact"]
+
+    def test_batch_matches_cosine_ranking(self):
+        """Test top-K order matches cosine_similarity_batch on a random store."""
+        rng = np.random.default_rng(7)
+        emb = rng.standard_normal((500, 32))
+        ids = [f"m{i}" for i in range(500)]
+        engine = native.memory_engine.MemoryEngine(32)
+        engine.upsert_batch(ids, emb, token_cost=np.ones(500, dtype=np.int32))
+
+        query = rng.standard_normal(32)
+        got, scores, _ = engine.build_context(
+            query, budget=1000, now=NOW, filters=_filters(candidate_count=10, hot_boost=0.0))
+
+        sims = native.vector_ops.cosine_similarity_batch(query, emb)
+        expected = [ids[i] for i in np.argsort(-sims)[:10]]
+        assert got == expected
+        assert all(not math.isnan(s) for s in scores)
+
+    def test_async_matches_sync(self):
+        """Test build_context_async returns the synchronous result."""
+        engine = _engine()
+        engine.upsert("a", np.array([1.0, 0, 0, 0]), token_cost=1)
+        query = np.array([1.0, 0, 0, 0])
+
+        async def run():
+            return await engine.build_context_async(query, now=NOW)
+
+        ids, scores, _ = asyncio.run(run())
+        sync_ids, sync_scores, _ = engine.build_context(query, now=NOW)
+        assert ids == sync_ids
+        np.testing.assert_allclose(scores, sync_scores)
@@ -0,0 +1,210 @@
+"""Tests for the native binary COPY loader of the memories table."""
+
+import struct
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+PG_EPOCH = 946684800
+HEADER = b"PGCOPY\n\xff\r\n\x00" + struct.pack(">ii", 0, 0)
+TRAILER = struct.pack(">h", -1)
+
+
+def _field(data):
+    if data is None:
+        return struct.pack(">i", -1)
+    return struct.pack(">i", len(data)) + data
+
+
+def _timestamp(seconds):
+    return None if seconds is None else struct.pack(">q", int((seconds - PG_EPOCH) * 1e6))
+
+
+def _tuple(uuid, mtype="fact", importance=0.7, access=3, created=1.7e9, last=1.7e9 + 3600,
+           embedding=None, dim=0, type="halfvec", cost=12):
+    fields = [
+        uuid.encode(),
+        None if mtype is None else mtype.encode(),
+        None if importance is None else struct.pack(">d", importance),
+        struct.pack(">i", access),
+        _timestamp(created),
+        _timestamp(last),
+        None if cost is None else struct.pack(">i", cost),
+    ]
+    if dim:
+        if embedding is None:
+            fields.append(None)
+        else:
+            fields.append(native.pgvector.encode_binary(
+                np.asarray(embedding, dtype=np.float32), type=type))
+    return struct.pack(">h", len(fields)) + b"".join(_field(f) for f in fields)
+
+
+def _stream(tuples):
+    return HEADER + b"".join(tuples) + TRAILER
+
+
+def _embedding(dim, seed=0):
+    return np.random.default_rng(seed).normal(0, 0.1, dim).astype(np.float32)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestMemoryLoader:
+    def test_columns(self):
+        e = _embedding(8)
+        data = _stream([
+            _tuple("a", "fact", 0.9, 4, 1.7e9, 1.7e9 + 60, e, dim=8),
+            _tuple("b", "insight", None, 0, None, None, None, dim=8, cost=None),
+        ])
+        loader = native.pgcopy.MemoryLoader(8)
+        assert loader.feed(data) == 2
+        loader.finish()
+        assert loader.done and loader.buffered == 0 and loader.total_rows == 2
+
+        cols = loader.take()
+        assert len(cols) == 2 and cols.dim == 8 and len(loader) == 0
+        assert cols.ids == ["a", "b"]
+        np.testing.assert_array_equal(cols.importance, [0.9, 0.5])
+        np.testing.assert_array_equal(cols.access_count, [4, 0])
+        np.testing.assert_array_equal(cols.memory_type, [1, 3])
+        np.testing.assert_array_equal(cols.created_at, [1.7e9, 0.0])
+        np.testing.assert_array_equal(cols.last_accessed, [1.7e9 + 60, -1.0])
+        np.testing.assert_array_equal(cols.token_cost, [12, 0])
+        np.testing.assert_array_equal(cols.has_embedding, [True, False])
+        assert cols.embeddings.shape == (2, 8)
+        np.testing.assert_array_equal(cols.embeddings[0], e.astype(np.float16).astype(np.float32))
+        np.testing.assert_array_equal(cols.embeddings[1], np.zeros(8))
+
+    def test_vector_wire_type_and_no_embeddings(self):
+        e = _embedding(5, seed=1)
+        loader = native.pgcopy.MemoryLoader(5, type="vector")
+        loader.feed(_stream([_tuple("a", embedding=e, dim=5, type="vector")]))
+        np.testing.assert_array_equal(loader.take().embeddings[0], e)
+
+        loader = native.pgcopy.MemoryLoader()
+        loader.feed(_stream([_tuple("a", mtype=None), _tuple("b", mtype="preference")]))
+        cols = loader.take()
+        assert cols.embeddings is None and cols.has_embedding is None
+        np.testing.assert_array_equal(cols.memory_type, [0, 2])
+
+    def test_chunked_feed_matches_whole(self):
+        dim = 32
+        tuples = [_tuple(f"m{i:02d}", embedding=_embedding(dim, i), dim=dim) for i in range(20)]
+        data = _stream(tuples)
+        whole = native.pgcopy.MemoryLoader(dim)
+        whole.feed(data)
+        expected = whole.take()
+
+        for chunk in (1, 3, 64, 1000):
+            loader = native.pgcopy.MemoryLoader(dim)
+            rows = 0
+            for start in range(0, len(data), chunk):
+                rows += loader.feed(memoryview(data)[start:start + chunk])
+                # Never more than one split tuple (or the header) is held
+                assert loader.buffered < max(len(tuples[0]), len(HEADER))
+            loader.finish()
+            assert rows == 20
+            cols = loader.take()
+            assert cols.ids == expected.ids
+            np.testing.assert_array_equal(cols.embeddings, expected.embeddings)
+
+    def test_take_starts_new_batch(self):
+        loader = native.pgcopy.MemoryLoader()
+        loader.feed(HEADER + _tuple("a") + _tuple("b"))
+        first = loader.take()
+        loader.feed(_tuple("c") + TRAILER)
+        second = loader.take()
+        assert first.ids == ["a", "b"] and second.ids == ["c"]
+        assert loader.total_rows == 3
+
+    def test_columns_outlive_loader(self):
+        loader = native.pgcopy.MemoryLoader(4)
+        loader.feed(_stream([_tuple("a", embedding=np.ones(4), dim=4)]))
+        embeddings = loader.take().embeddings
+        del loader
+        np.testing.assert_array_equal(embeddings, np.ones((1, 4)))
+
+    def test_write_for_copy_expert(self):
+        data = _stream([_tuple("a")])
+        loader = native.pgcopy.MemoryLoader()
+        assert loader.write(data[:10]) == 10
+        assert loader.write(data[10:]) == len(data) - 10
+        loader.finish()
+        assert len(loader) == 1
+
+    def test_errors(self):
+        good = _stream([_tuple("a", embedding=np.ones(4), dim=4)])
+        with pytest.raises(ValueError):
+            native.pgcopy.MemoryLoader(4).feed(b"PGCOPX" + good[6:])
+        with pytest.raises(ValueError):
+            native.pgcopy.MemoryLoader(4).feed(good + b"\x00")
+        with pytest.raises(ValueError):
+            native.pgcopy.MemoryLoader().feed(good)         # column count
+        with pytest.raises(ValueError):
+            native.pgcopy.MemoryLoader(3).feed(good)        # dimension
+        with pytest.raises(ValueError):
+            native.pgcopy.MemoryLoader(4, type="vector").feed(good)
+        # access_count sent as int8 instead of int4
+        bad_int = HEADER + struct.pack(">h", 7) + b"".join(_field(f) for f in [
+            b"a", b"fact", struct.pack(">d", 0.5), struct.pack(">q", 1), None, None, None])
+        with pytest.raises(ValueError):
+            native.pgcopy.MemoryLoader().feed(bad_int)
+        with pytest.raises(ValueError):
+            native.pgcopy.MemoryLoader(4, type="sparsevec")
+        with pytest.raises(TypeError):
+            native.pgcopy.MemoryLoader().feed("PGCOPY")
+
+        loader = native.pgcopy.MemoryLoader(4)
+        loader.feed(good[:-1])
+        with pytest.raises(ValueError):
+            loader.finish()
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestConsumers:
+    def _columns(self, dim=6):
+        loader = native.pgcopy.MemoryLoader(dim)
+        loader.feed(_stream([
+            _tuple("a", "fact", 0.8, 2, 1.7e9, 1.7e9 + 7200, _embedding(dim, 1), dim=dim),
+            _tuple("b", "preference", 0.4, 0, 1.7e9 + 3600, None, None, dim=dim),
+            _tuple("c", "conversation", 0.6, 1, 1.7e9, 1.7e9, _embedding(dim, 2), dim=dim),
+        ]))
+        return loader.take()
+
+    def test_decay_records(self):
+        cols = self._columns()
+        now = 1.7e9 + 36000
+        records = cols.decay_records(now, connection_count=np.array([1, 2, 3], dtype=np.int32))
+        assert records.dtype == native.decay_ops.RECORD_DTYPE
+        np.testing.assert_allclose(records["hours_passed"], [10.0, 9.0, 10.0])
+        np.testing.assert_allclose(records["last_access_hours"], [8.0, -1.0, 10.0])
+        np.testing.assert_array_equal(records["connection_count"], [1, 2, 3])
+        np.testing.assert_array_equal(records["channel_mentions"], [0, 0, 0])
+        np.testing.assert_array_equal(records["memory_type"], [1, 2, 0])
+
+        config = native.decay_ops.DecayConfig()
+        np.testing.assert_allclose(
+            native.decay_ops.calculate_batch_numpy(records, config),
+            [native.decay_ops.calculate(native.decay_ops.DecayInput(
+                importance=float(r["importance"]), hours_passed=float(r["hours_passed"]),
+                access_count=int(r["access_count"]), connection_count=int(r["connection_count"]),
+                last_access_hours=float(r["last_access_hours"]), memory_type=int(r["memory_type"])),
+                config) for r in records])
+
+        with pytest.raises(ValueError):
+            cols.decay_records(now, channel_mentions=np.zeros(2, dtype=np.int32))
+
+    def test_upsert_into_engine(self):
+        cols = self._columns()
+        engine = native.memory_engine.MemoryEngine(6)
+        assert cols.upsert_into(engine) == 2
+        assert len(engine) == 2 and "a" in engine and "b" not in engine
+        with pytest.raises(ValueError):
+            cols.upsert_into(native.memory_engine.MemoryEngine(5))
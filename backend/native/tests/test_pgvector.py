@@ -0,0 +1,122 @@
+"""Tests for the native pgvector text and binary codec."""
+
+import struct
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+def _embedding(dim=3072, seed=0):
+    return np.random.default_rng(seed).normal(0, 0.02, dim)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestText:
+    def test_format_round_trips_through_float32(self):
+        x = _embedding()
+        text = native.pgvector.format(x)
+        assert text.startswith("[") and text.endswith("]") and " " not in text
+        # Every token parses back to the float32 the server would store
+        parsed = np.array([np.float32(t) for t in text[1:-1].split(",")])
+        np.testing.assert_array_equal(parsed, x.astype(np.float32))
+        assert len(text) < len(str(x.tolist()))
+
+    def test_format_float32_and_strided(self):
+        x = _embedding(64, seed=1)
+        assert native.pgvector.format(x.astype(np.float32)) == native.pgvector.format(x)
+        wide = np.zeros(128)
+        wide[::2] = x
+        assert native.pgvector.format(wide[::2]) == native.pgvector.format(x)
+
+    def test_format_rows(self):
+        rows = np.stack([_embedding(32, seed=s) for s in range(5)])
+        assert native.pgvector.format_rows(rows) == [native.pgvector.format(r) for r in rows]
+
+    def test_parse_matches_float32(self):
+        x = _embedding(seed=2)
+        for text in (native.pgvector.format(x), str(x.tolist())):
+            values = native.pgvector.parse(text)
+            assert values.dtype == np.float32
+            np.testing.assert_array_equal(values, x.astype(np.float32))
+
+    def test_parse_edge_numbers(self):
+        tokens = ["0", "-0", "1e-05", "-1.5E+3", ".5", "7.", "3.4028235e38",
+                  "1e-50", "0.1234567890123456789012", "1.40129846e-45"]
+        values = native.pgvector.parse("[" + ",".join(tokens) + "]")
+        expected = np.array([float(t) for t in tokens], dtype=np.float32)
+        np.testing.assert_array_equal(values, expected)
+        assert np.signbit(values[1])
+
+    def test_parse_float16_and_bytes(self):
+        x = _embedding(100, seed=3)
+        text = native.pgvector.format(x)
+        half = native.pgvector.parse(text.encode(), dtype="float16")
+        assert half.dtype == np.float16
+        np.testing.assert_array_equal(half, x.astype(np.float32).astype(np.float16))
+
+    def test_parse_rows(self):
+        rows = np.stack([_embedding(48, seed=s) for s in range(20)])
+        texts = native.pgvector.format_rows(rows)
+        matrix = native.pgvector.parse_rows(texts)
+        assert matrix.shape == (20, 48)
+        np.testing.assert_array_equal(matrix, rows.astype(np.float32))
+        assert native.pgvector.parse_rows([], dim=3).shape == (0, 3)
+        with pytest.raises(ValueError):
+            native.pgvector.parse_rows(texts, dim=47)
+
+    def test_parse_errors(self):
+        for text in ["[]", "[1,]", "1,2", "[1 2]", "[1,2]x", "[NaN]", "[1e39]", "[", "[1e]"]:
+            with pytest.raises(ValueError):
+                native.pgvector.parse(text)
+        with pytest.raises(ValueError):
+            native.pgvector.format(np.array([1.0, np.nan]))
+        with pytest.raises(ValueError):
+            native.pgvector.format(np.array([1e39]))
+        with pytest.raises(TypeError):
+            native.pgvector.parse(None)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestBinary:
+    def test_vector_layout(self):
+        x = np.array([1.0, -2.5, 0.125], dtype=np.float32)
+        data = native.pgvector.encode_binary(x)
+        assert data == struct.pack(">hh3f", 3, 0, *x)
+        np.testing.assert_array_equal(native.pgvector.decode_binary(data), x)
+
+    def test_halfvec_layout(self):
+        x = _embedding(256, seed=4).astype(np.float32)
+        data = native.pgvector.encode_binary(x, type="halfvec")
+        halves = x.astype(np.float16)
+        assert data == struct.pack(">hh", 256, 0) + halves.astype(">f2").tobytes()
+
+        decoded = native.pgvector.decode_binary(data, type="halfvec", dtype="float16")
+        np.testing.assert_array_equal(decoded, halves)
+        widened = native.pgvector.decode_binary(data, type="halfvec")
+        np.testing.assert_array_equal(widened, halves.astype(np.float32))
+
+    def test_vector_to_float16(self):
+        x = _embedding(40, seed=5).astype(np.float32)
+        data = native.pgvector.encode_binary(x)
+        half = native.pgvector.decode_binary(data, dtype="float16")
+        np.testing.assert_array_equal(half, x.astype(np.float16))
+
+    def test_binary_errors(self):
+        data = native.pgvector.encode_binary(np.ones(4, dtype=np.float32))
+        with pytest.raises(ValueError):
+            native.pgvector.decode_binary(data[:-1])
+        with pytest.raises(ValueError):
+            native.pgvector.decode_binary(data, type="halfvec")
+        with pytest.raises(ValueError):
+            native.pgvector.decode_binary(data[:2] + b"\x00\x01" + data[4:])
+        with pytest.raises(ValueError):
+            native.pgvector.encode_binary(np.array([7e4], dtype=np.float32), type="halfvec")
+        with pytest.raises(ValueError):
+            native.pgvector.encode_binary(np.ones(3, dtype=np.float32), type="sparsevec")
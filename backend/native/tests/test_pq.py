@@ -0,0 +1,220 @@
+"""Tests for native product quantization."""
+
+import threading
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+def _clustered(n, dim, seed, clusters=32, noise=0.05):
+    """Unit rows scattered around a few random directions."""
+    rng = np.random.default_rng(seed)
+    centers = rng.standard_normal((clusters, dim))
+    rows = centers[rng.integers(0, clusters, n)] + noise * rng.standard_normal((n, dim))
+    return rows / np.linalg.norm(rows, axis=1, keepdims=True)
+
+
+def _exact_cosine(query, data):
+    return data @ query / (np.linalg.norm(data, axis=1) * np.linalg.norm(query))
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestProductQuantizer:
+    @pytest.mark.parametrize("m,nbits,code_size", [(8, 8, 8), (16, 4, 8), (5, 4, 3)])
+    def test_code_shape(self, m, nbits, code_size):
+        dim = m * 4
+        data = _clustered(300, dim, seed=1)
+        pq = native.pq.ProductQuantizer(dim, m, nbits=nbits)
+        assert not pq.trained
+        pq.train(data, seed=3)
+
+        codes = pq.encode(data)
+        assert pq.code_size == code_size
+        assert codes.shape == (300, code_size)
+        assert codes.dtype == np.uint8
+        assert pq.centroids.shape == (m, 2 ** nbits, 4)
+
+    @pytest.mark.parametrize("m,nbits", [(96, 8), (192, 4)])
+    def test_3072_dim_codes_under_100_bytes(self, m, nbits):
+        pq = native.pq.ProductQuantizer(3072, m, nbits=nbits)
+        assert pq.code_size == 96
+
+    @pytest.mark.parametrize("nbits", [4, 8])
+    def test_estimate_matches_decoded_dot_product(self, nbits):
+        data = _clustered(600, 64, seed=2)
+        pq = native.pq.ProductQuantizer(64, 16, nbits=nbits)
+        pq.train(data, seed=5)
+        codes = pq.encode(data)
+        query = data[7] * 3.0  # scale does not matter
+
+        sims = pq.cosine_similarity_batch(query, codes)
+        expected = pq.decode(codes).astype(np.float64) @ data[7]
+        np.testing.assert_allclose(sims, expected, atol=1e-5)
+
+    def test_estimate_tracks_exact_cosine(self):
+        data = _clustered(2000, 64, seed=4)
+        pq = native.pq.ProductQuantizer(64, 16, nbits=8)
+        pq.train(data, seed=1)
+        sims = pq.cosine_similarity_batch(data[0], pq.encode(data))
+        exact = _exact_cosine(data[0], data)
+        assert np.corrcoef(sims, exact)[0, 1] > 0.95
+
+    def test_training_is_deterministic(self):
+        data = _clustered(500, 32, seed=6)
+        a = native.pq.ProductQuantizer(32, 8)
+        b = native.pq.ProductQuantizer(32, 8)
+        a.train(data, seed=11)
+        b.train(data, seed=11)
+        np.testing.assert_array_equal(a.centroids, b.centroids)
+
+    def test_from_centroids_round_trip(self):
+        data = _clustered(400, 48, seed=8)
+        pq = native.pq.ProductQuantizer(48, 12, nbits=4)
+        pq.train(data)
+
+        restored = native.pq.ProductQuantizer.from_centroids(pq.centroids)
+        assert (restored.dim, restored.m, restored.nbits) == (48, 12, 4)
+        np.testing.assert_array_equal(restored.encode(data), pq.encode(data))
+
+    def test_out_buffer(self):
+        data = _clustered(300, 32, seed=9)
+        pq = native.pq.ProductQuantizer(32, 8)
+        pq.train(data)
+        codes = pq.encode(data)
+        out = np.empty(300)
+        result = pq.cosine_similarity_batch(data[0], codes, out=out)
+        assert result is out
+        np.testing.assert_array_equal(out, pq.cosine_similarity_batch(data[0], codes))
+
+    def test_errors(self):
+        with pytest.raises(ValueError):
+            native.pq.ProductQuantizer(30, 8)  # dim not a multiple of m
+        with pytest.raises(ValueError):
+            native.pq.ProductQuantizer(32, 8, nbits=6)
+
+        pq = native.pq.ProductQuantizer(32, 8)
+        with pytest.raises(RuntimeError):
+            pq.encode(np.zeros((2, 32)))
+        with pytest.raises(ValueError):
+            pq.train(np.ones((4, 32)))  # fewer rows than centroids
+
+        pq.train(_clustered(100, 32, seed=0))
+        with pytest.raises(ValueError):
+            pq.decode(np.zeros((2, 5), dtype=np.uint8))
+        with pytest.raises(ValueError):
+            pq.cosine_similarity_batch(np.zeros(16), np.zeros((2, 4), dtype=np.uint8))
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestPQIndex:
+    @pytest.fixture(params=[4, 8])
+    def index_and_data(self, request):
+        data = _clustered(1500, 96, seed=12, noise=0.3)
+        pq = native.pq.ProductQuantizer(96, 24, nbits=request.param)
+        pq.train(data, seed=2)
+        index = native.pq.PQIndex(pq)
+        index.add(data[:1000])
+        index.add(data[1000:])
+        return index, data
+
+    def test_size_and_memory(self, index_and_data):
+        index, data = index_and_data
+        assert len(index) == 1500
+        assert index.memory_bytes >= 1500 * index.quantizer.code_size
+        assert index.memory_bytes < 1500 * index.quantizer.code_size + 32 * 96
+
+    def test_codes_round_trip(self, index_and_data):
+        index, data = index_and_data
+        codes = index.codes()
+        np.testing.assert_array_equal(codes, index.quantizer.encode(data))
+
+        copy = native.pq.PQIndex(index.quantizer)
+        copy.add_codes(codes[:700])
+        copy.add_codes(codes[700:])
+        np.testing.assert_array_equal(copy.codes(), codes)
+
+    def test_batch_scores_match_quantizer(self, index_and_data):
+        index, data = index_and_data
+        expected = index.quantizer.cosine_similarity_batch(data[3], index.codes())
+        # 4-bit codes use the byte-quantised fast-scan table
+        atol = 0.02 if index.quantizer.nbits == 4 else 1e-9
+        np.testing.assert_allclose(index.cosine_similarity_batch(data[3]), expected, atol=atol)
+
+    def test_search_finds_self_and_orders_scores(self, index_and_data):
+        index, data = index_and_data
+        for row in (0, 321, 1499):
+            ids, scores = index.search(data[row], k=50)
+            assert ids.dtype == np.int64 and len(ids) == 50
+            assert np.all(np.diff(scores) <= 0)
+            # Re-ranking the shortlist with exact vectors puts the row first
+            exact = native.vector_ops.cosine_similarity_batch(data[row], data[ids])
+            assert ids[np.argmax(exact)] == row
+
+    def test_search_scores_are_float_estimates(self, index_and_data):
+        index, data = index_and_data
+        ids, scores = index.search(data[5], k=20)
+        expected = index.quantizer.cosine_similarity_batch(data[5], index.codes())
+        np.testing.assert_allclose(scores, expected[ids], atol=1e-9)
+
+    def test_search_recall_against_float_scan(self, index_and_data):
+        index, data = index_and_data
+        codes = index.codes()
+        hits = 0
+        for row in range(0, 1500, 75):
+            full = index.quantizer.cosine_similarity_batch(data[row], codes)
+            truth = set(np.argsort(-full, kind="stable")[:10])
+            ids, _ = index.search(data[row], k=10)
+            hits += len(truth & set(ids))
+        assert hits / (20 * 10) >= 0.9
+
+    def test_k_larger_than_index(self, index_and_data):
+        index, data = index_and_data
+        empty = native.pq.PQIndex(index.quantizer)
+        ids, scores = empty.search(data[0], k=5)
+        assert len(ids) == 0 and len(scores) == 0
+
+        small = native.pq.PQIndex(index.quantizer)
+        small.add(data[:3])
+        ids, _ = small.search(data[0], k=10)
+        assert sorted(ids) == [0, 1, 2]
+
+    def test_search_while_adding(self, index_and_data):
+        """Test scans running alongside appends see whole rows only."""
+        index, data = index_and_data
+        grow = native.pq.PQIndex(index.quantizer)
+        grow.add(data[:100])
+
+        def produce():
+            for start in range(100, 1500, 100):
+                grow.add(data[start:start + 100])
+
+        writer = threading.Thread(target=produce)
+        writer.start()
+        while writer.is_alive():
+            scores = grow.cosine_similarity_batch(data[0])
+            assert len(scores) % 100 == 0
+            ids, _ = grow.search(data[0], k=5)
+            assert len(ids) == 5 and ids.max() < len(grow)
+        writer.join()
+        np.testing.assert_array_equal(grow.codes(), index.codes())
+
+    def test_quantizer_is_a_copy(self, index_and_data):
+        index, data = index_and_data
+        ids, scores = index.search(data[7], k=20)
+        quantizer = index.quantizer
+        quantizer.train(data[::-1], seed=99)
+        assert not np.array_equal(quantizer.centroids, index.quantizer.centroids)
+        new_ids, new_scores = index.search(data[7], k=20)
+        np.testing.assert_array_equal(new_ids, ids)
+        np.testing.assert_array_equal(new_scores, scores)
+
+    def test_untrained_quantizer_rejected(self):
+        with pytest.raises(ValueError):
+            native.pq.PQIndex(native.pq.ProductQuantizer(32, 8))
@@ -0,0 +1,168 @@
+"""Tests for native dimensionality reduction."""
+
+import threading
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+def _low_rank(n, dim, rank, seed, offset=0.3):
+    """Rows with a decaying spectrum over `rank` directions plus a shared mean."""
+    rng = np.random.default_rng(seed)
+    basis = np.linalg.qr(rng.standard_normal((dim, rank)))[0]
+    scales = 1.0 / np.arange(1, rank + 1)
+    return (rng.standard_normal((n, rank)) * scales) @ basis.T + offset * rng.standard_normal(dim)
+
+
+def _unit(x):
+    return x / np.linalg.norm(x, axis=-1, keepdims=True)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestLinearProjection:
+    def test_matches_numpy_svd(self):
+        data = _low_rank(800, 96, 48, seed=1)
+        proj = native.projection.LinearProjection(96, 16)
+        assert not proj.fitted
+        # A sketch as wide as the data makes the randomized SVD exact
+        proj.train(data, oversample=96, seed=3)
+
+        x = _unit(data)
+        _, s, vt = np.linalg.svd(x, full_matrices=False)
+        np.testing.assert_allclose(proj.explained_variance, s[:16] ** 2 / (800 - 1), rtol=1e-6)
+        # Components agree with the singular vectors up to sign
+        agreement = np.abs(np.sum(proj.components * vt[:16], axis=1))
+        assert agreement.min() > 0.999
+        np.testing.assert_allclose(proj.components @ proj.components.T, np.eye(16), atol=1e-5)
+        assert np.all(proj.mean == 0)
+
+    def test_centered_fit_is_pca(self):
+        data = _low_rank(600, 64, 32, seed=2)
+        proj = native.projection.LinearProjection(64, 8)
+        proj.train(data, center=True)
+
+        x = _unit(data)
+        np.testing.assert_allclose(proj.mean, x.mean(axis=0), atol=1e-6)
+        _, s, _ = np.linalg.svd(x - x.mean(axis=0), full_matrices=False)
+        np.testing.assert_allclose(proj.explained_variance, s[:8] ** 2 / (600 - 1), rtol=1e-2)
+        ratio = proj.explained_variance_ratio
+        assert np.all(np.diff(ratio) <= 0) and 0 < ratio.sum() < 1
+
+    def test_training_is_deterministic(self):
+        data = _low_rank(300, 48, 24, seed=4)
+        a = native.projection.LinearProjection(48, 12)
+        b = native.projection.LinearProjection(48, 12)
+        a.train(data, seed=9)
+        b.train(data, seed=9)
+        np.testing.assert_array_equal(a.components, b.components)
+
+    def test_project_matches_matrix_product(self):
+        data = _low_rank(200, 64, 32, seed=5)
+        proj = native.projection.LinearProjection(64, 16)
+        proj.train(data, center=True)
+
+        expected = (_unit(data).astype(np.float32) - proj.mean) @ proj.components.T
+        out = proj.project(data)
+        assert out.dtype == np.float32 and out.shape == (200, 16)
+        np.testing.assert_allclose(out, expected, atol=1e-5)
+
+        prefix = proj.project(data, dim=4, normalize=True)
+        np.testing.assert_allclose(prefix, _unit(expected[:, :4]), atol=1e-5)
+
+    def test_float16_output(self):
+        data = _low_rank(123, 40, 20, seed=6)
+        proj = native.projection.LinearProjection(40, 10)
+        proj.train(data)
+        half = proj.project(data, normalize=True, dtype="float16")
+        assert half.dtype == np.float16 and half.shape == (123, 10)
+        full = proj.project(data, normalize=True)
+        np.testing.assert_array_equal(half, full.astype(np.float16))
+
+    def test_strided_input(self):
+        data = _low_rank(100, 32, 16, seed=7)
+        wide = np.zeros((100, 64))
+        wide[:, ::2] = data
+        proj = native.projection.LinearProjection(32, 8)
+        proj.train(data)
+        np.testing.assert_allclose(proj.project(wide[:, ::2]), proj.project(data), atol=1e-6)
+
+    def test_random_orthogonal(self):
+        proj = native.projection.LinearProjection(128, 32)
+        proj.random_orthogonal(seed=1)
+        assert proj.fitted and proj.explained_variance is None
+        np.testing.assert_allclose(proj.components @ proj.components.T, np.eye(32), atol=1e-5)
+
+        other = native.projection.LinearProjection(128, 32)
+        other.random_orthogonal(seed=1)
+        np.testing.assert_array_equal(proj.components, other.components)
+
+    def test_from_components_round_trip(self):
+        data = _low_rank(300, 48, 24, seed=8)
+        proj = native.projection.LinearProjection(48, 12)
+        proj.train(data, center=True)
+
+        restored = native.projection.LinearProjection.from_components(proj.components, proj.mean)
+        assert (restored.dim, restored.out_dim) == (48, 12)
+        np.testing.assert_array_equal(restored.project(data), proj.project(data))
+
+    def test_project_while_training(self):
+        """Test projections during a refit come from one fit, never a mix."""
+        data = _low_rank(400, 64, 32, seed=11)
+        proj = native.projection.LinearProjection(64, 16)
+        expected = []
+        for seed in (1, 2):
+            proj.train(data, center=bool(seed % 2), seed=seed)
+            expected.append(proj.project(data[:50]))
+
+        def retrain():
+            for i in range(10):
+                proj.train(data, center=bool(i % 2), seed=2 - i % 2)
+
+        trainer = threading.Thread(target=retrain)
+        trainer.start()
+        while trainer.is_alive():
+            out = proj.project(data[:50])
+            assert any(np.array_equal(out, e) for e in expected)
+        trainer.join()
+
+    def test_tradeoff(self):
+        data = _low_rank(1200, 96, 48, seed=10)
+        proj = native.projection.LinearProjection(96, 48)
+        proj.train(data[:800])
+
+        points = proj.tradeoff(data[800:], [8, 24, 48], k=10, queries=50)
+        assert [p["dim"] for p in points] == [8, 24, 48]
+        ratios = [p["explained_variance_ratio"] for p in points]
+        recalls = [p["recall"] for p in points]
+        assert ratios == sorted(ratios) and ratios[-1] > 0.999
+        assert recalls[-1] > 0.95 and recalls[0] < recalls[-1]
+
+        # PCA keeps far more variance than a random basis of the same size
+        rand = native.projection.LinearProjection(96, 8)
+        rand.random_orthogonal()
+        random_point = rand.tradeoff(data[800:], [8], k=10, queries=50)[0]
+        assert random_point["explained_variance_ratio"] < ratios[0]
+
+    def test_errors(self):
+        with pytest.raises(ValueError):
+            native.projection.LinearProjection(16, 32)
+        proj = native.projection.LinearProjection(16, 4)
+        with pytest.raises(RuntimeError):
+            proj.project(np.zeros((2, 16)))
+        with pytest.raises(ValueError):
+            proj.train(np.ones((3, 16)))  # fewer rows than out_dim
+
+        proj.train(_low_rank(50, 16, 8, seed=0))
+        with pytest.raises(ValueError):
+            proj.project(np.zeros((2, 8)))
+        with pytest.raises(ValueError):
+            proj.project(np.zeros((2, 16)), dim=5)
+        with pytest.raises(ValueError):
+            proj.project(np.zeros((2, 16)), dtype="int8")
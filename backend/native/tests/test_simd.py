@@ -0,0 +1,94 @@
+"""Tests for runtime SIMD variant selection and the parallelism cap."""
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+@pytest.fixture
+def restore_defaults():
+    yield
+    native.set_simd_variant("auto")
+    native.set_max_parallelism(0)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestSimdVariant:
+    """Tests for set_simd_variant / simd_variant."""
+
+    def test_scalar_always_available(self):
+        """Test scalar is selectable on every build."""
+        variants = native.simd_variants()
+        assert variants[0] == "scalar"
+        assert native.simd_variant() in variants
+
+    def test_forced_scalar_matches_vector_path(self, restore_defaults):
+        """Test both variants compute the same similarities."""
+        rng = np.random.default_rng(7)
+        query = rng.standard_normal(3072)
+        corpus = rng.standard_normal((64, 3072))
+
+        native.set_simd_variant("scalar")
+        assert native.simd_variant() == "scalar"
+        scalar = native.vector_ops.cosine_similarity_batch(query, corpus)
+
+        native.set_simd_variant("auto")
+        auto = native.vector_ops.cosine_similarity_batch(query, corpus)
+
+        np.testing.assert_allclose(scalar, auto, rtol=1e-9, atol=1e-12)
+
+    def test_unknown_variant_raises(self, restore_defaults):
+        """Test an unavailable variant is rejected."""
+        with pytest.raises(ValueError):
+            native.set_simd_variant("avx512")
+
+    def test_trace_reports_forced_variant(self, restore_defaults):
+        """Test call spans carry the variant that actually ran."""
+        native.trace_clear()
+        native.set_simd_variant("scalar")
+        native.set_tracing(True)
+        try:
+            native.vector_ops.cosine_similarity([1.0, 2.0], [2.0, 1.0])
+        finally:
+            native.set_tracing(False)
+        dump = native.trace_dump()
+        native.trace_clear()
+        assert '"simd":"scalar"' in dump
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestMaxParallelism:
+    """Tests for set_max_parallelism."""
+
+    def test_round_trip(self, restore_defaults):
+        """Test the cap is stored and 0 removes it."""
+        native.set_max_parallelism(1)
+        assert native.max_parallelism() == 1
+        native.set_max_parallelism(0)
+        assert native.max_parallelism() == 0
+
+    def test_results_independent_of_cap(self, restore_defaults):
+        """Test build_context selects the same memories at any thread cap."""
+        rng = np.random.default_rng(3)
+        engine = native.memory_engine.MemoryEngine(32)
+        ids = [f"m{i}" for i in range(5000)]
+        engine.upsert_batch(ids, rng.standard_normal((5000, 32)))
+        query = rng.standard_normal(32)
+
+        native.set_max_parallelism(1)
+        single = engine.build_context(query, budget=100000, now=1.7e9)
+        native.set_max_parallelism(0)
+        parallel = engine.build_context(query, budget=100000, now=1.7e9)
+
+        assert single[0] == parallel[0]
+        np.testing.assert_allclose(single[1], parallel[1])
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v"])
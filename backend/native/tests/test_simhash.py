@@ -0,0 +1,143 @@
+"""Tests for native SimHash near-duplicate detection."""
+
+import random
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+def _random_fingerprints(n, seed, max_flips=8):
+    """Random fingerprints where ~40% are bit-flipped copies of earlier ones."""
+    rng = random.Random(seed)
+    fps = []
+    for _ in range(n):
+        if fps and rng.random() < 0.4:
+            fp = rng.choice(fps)
+            for _ in range(rng.randint(0, max_flips)):
+                fp ^= 1 << rng.randrange(64)
+        else:
+            fp = rng.getrandbits(64)
+        fps.append(fp)
+    return fps
+
+
+def _brute_pairs(fps, max_distance):
+    return [
+        (i, j, bin(fps[i] ^ fps[j]).count("1"))
+        for i in range(len(fps))
+        for j in range(i + 1, len(fps))
+        if bin(fps[i] ^ fps[j]).count("1") <= max_distance
+    ]
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestFingerprint:
+    """Tests for shingled fingerprints."""
+
+    TEXT = " ".join(f"word{i % 37} token{i % 11}" for i in range(120))
+
+    def test_empty_and_whitespace(self):
+        """Test empty text fingerprints to 0."""
+        assert native.simhash.fingerprint("") == 0
+        assert native.simhash.fingerprint(" \t\n") == 0
+
+    def test_normalization(self):
+        """Test case and whitespace differences do not change the fingerprint."""
+        assert native.simhash.fingerprint("  Hello\n\nWORLD  again") == \
+            native.simhash.fingerprint("hello world again")
+
+    def test_edit_is_near(self):
+        """Test a one-word edit of a long text stays within a few bits."""
+        edited = self.TEXT.replace("word5 ", "changed ", 1)
+        a = native.simhash.fingerprint(self.TEXT)
+        b = native.simhash.fingerprint(edited)
+        assert native.simhash.hamming(a, b) <= 8
+
+    def test_batch_matches_single(self):
+        """Test fingerprint_batch agrees with fingerprint for both shingle kinds."""
+        texts = [self.TEXT, "short", "", "안녕하세요 반가워요 오늘 날씨 좋네요"] * 50
+        for kind, k in (("word", 2), ("char", 4)):
+            batch = native.simhash.fingerprint_batch(texts, kind=kind, shingle_size=k)
+            assert batch.dtype == np.uint64 and batch.shape == (len(texts),)
+            for i in range(4):
+                assert int(batch[i]) == native.simhash.fingerprint(texts[i], kind=kind, shingle_size=k)
+
+    def test_invalid_kind(self):
+        """Test unknown shingle kinds are rejected."""
+        with pytest.raises(ValueError):
+            native.simhash.fingerprint("x", kind="line")
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestNearDuplicatePairs:
+    """Tests for banded batch lookup against brute force."""
+
+    @pytest.mark.parametrize("max_distance,bands", [(0, 0), (3, 0), (3, 6), (6, 0), (8, 12)])
+    def test_matches_brute_force(self, max_distance, bands):
+        """Test every pair within the threshold is reported exactly once."""
+        fps = _random_fingerprints(400, seed=max_distance + bands)
+        i, j, sim = native.simhash.near_duplicate_pairs(
+            np.array(fps, dtype=np.uint64), max_distance, bands)
+        got = [(a, b, round((1 - s) * 64)) for a, b, s in zip(i.tolist(), j.tolist(), sim.tolist())]
+        assert got == _brute_pairs(fps, max_distance)
+
+    def test_invalid_bands(self):
+        """Test band counts that cannot guarantee recall are rejected."""
+        with pytest.raises(ValueError):
+            native.simhash.near_duplicate_pairs(np.zeros(4, dtype=np.uint64), 6, 6)
+
+    def test_groups_are_components(self):
+        """Test groups are the connected components of the pair graph."""
+        fps = _random_fingerprints(300, seed=9)
+        parent = list(range(len(fps)))
+
+        def find(x):
+            while parent[x] != x:
+                x = parent[x]
+            return x
+
+        for a, b, _ in _brute_pairs(fps, 6):
+            parent[find(b)] = find(a)
+        members = {}
+        for k in range(len(fps)):
+            members.setdefault(find(k), []).append(k)
+        expected = sorted(g for g in members.values() if len(g) > 1)
+
+        groups = native.simhash.near_duplicate_groups(np.array(fps, dtype=np.uint64), 6)
+        assert [g.tolist() for g in groups] == expected
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestSimHashIndex:
+    """Tests for the incremental index."""
+
+    def test_add_and_query(self):
+        """Test matches come from earlier fingerprints, nearest first."""
+        fps = _random_fingerprints(300, seed=4)
+        index = native.simhash.SimHashIndex(max_distance=5)
+        for k, fp in enumerate(fps):
+            fp_id, matches = index.add_and_query(fp)
+            assert fp_id == k
+            expected = sorted(
+                ((j, bin(fp ^ fps[j]).count("1")) for j in range(k)
+                 if bin(fp ^ fps[j]).count("1") <= 5),
+                key=lambda m: (m[1], m[0]),
+            )
+            assert [tuple(m) for m in matches] == expected
+        assert len(index) == 300
+        assert index.bands == 6
+
+    def test_clear(self):
+        """Test clear empties the index."""
+        index = native.simhash.SimHashIndex()
+        index.add(123)
+        index.clear()
+        assert len(index) == 0
+        assert index.query(123) == []
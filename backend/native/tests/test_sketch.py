@@ -0,0 +1,101 @@
+"""Tests for the native access sketch."""
+
+import random
+
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestAccessSketch:
+    """Tests for space-saving top-k, count-min estimates and channel counts."""
+
+    def test_counts_exact_below_capacity(self):
+        """Test counts and channels are exact while every id is tracked."""
+        sketch = native.sketch.AccessSketch(16)
+        sketch.record(["a", "b"], "discord", 0.0)
+        sketch.record(["a"], "voice", 1.0)
+        sketch.record(["a"], "discord", 2.0)
+        top = sketch.top(10, 2.0)
+        assert [(i, c, e, ch) for i, c, e, ch in top] == [
+            ("a", 3.0, 0.0, 2),
+            ("b", 1.0, 0.0, 1),
+        ]
+        assert sketch.channel_count("a") == 2
+        assert sketch.channel_count("missing") == 0
+        assert sketch.estimate("missing", 2.0) == 0.0
+
+    def test_heavy_hitters_survive_eviction(self):
+        """Test frequent ids stay tracked under a long skewed stream."""
+        sketch = native.sketch.AccessSketch(64)
+        rng = random.Random(7)
+        weights = [1.0 / (r + 1) for r in range(2000)]
+        exact = {}
+        for i in range(50000):
+            mid = f"m{rng.choices(range(2000), weights)[0]}"
+            exact[mid] = exact.get(mid, 0) + 1
+            sketch.record([mid], f"c{i % 3}", float(i))
+        top = sketch.top(5, 0.0)
+        assert {item[0] for item in top} == {"m0", "m1", "m2", "m3", "m4"}
+        for mid, count, error, channels in top:
+            assert count - error <= exact[mid] <= count
+            assert channels == 3
+        stats = sketch.stats()
+        assert stats["tracked"] == 64
+        assert stats["evictions"] > 0
+        assert stats["distinct_channels"] == 3
+
+    def test_half_life_decay(self):
+        """Test counts halve every half-life."""
+        sketch = native.sketch.AccessSketch(8, half_life_seconds=10.0)
+        sketch.record(["x"], "c", 100.0)
+        assert sketch.estimate("x", 100.0) == pytest.approx(1.0)
+        assert sketch.estimate("x", 110.0) == pytest.approx(0.5)
+        sketch.record(["y"], "c", 110.0)
+        assert [item[0] for item in sketch.top(2, 110.0)] == ["y", "x"]
+
+    def test_decay_rescale_keeps_counts(self):
+        """Test long runs past the rescale threshold keep steady-state counts."""
+        sketch = native.sketch.AccessSketch(8, half_life_seconds=1.0)
+        for t in range(500):
+            sketch.record(["y"], "c", float(t))
+        assert sketch.estimate("y", 499.0) == pytest.approx(2.0, rel=1e-6)
+
+    def test_channel_counts_column(self):
+        """Test channel_counts returns an int32 column aligned with ids."""
+        sketch = native.sketch.AccessSketch(16)
+        for ch in ["a", "b", "c"]:
+            sketch.record(["m1"], ch, 0.0)
+        sketch.record(["m2"], "a", 0.0)
+        col = sketch.channel_counts(["m2", "missing", "m1"])
+        assert col.dtype.name == "int32"
+        assert col.tolist() == [1, 0, 3]
+        assert sketch.estimates(["m1", "m2"], 0.0).tolist() == [3.0, 1.0]
+
+    def test_many_channels_approximate(self):
+        """Test channel counts switch to HyperLogLog past the exact range."""
+        sketch = native.sketch.AccessSketch(4)
+        for i in range(1000):
+            sketch.record(["m"], f"channel-{i}", 0.0)
+        assert 800 <= sketch.channel_count("m") <= 1200
+
+    def test_clear(self):
+        """Test clear forgets counts and channels."""
+        sketch = native.sketch.AccessSketch(4)
+        sketch.record(["a"], "c", 0.0)
+        sketch.clear()
+        assert sketch.top(10, 0.0) == []
+        assert sketch.stats()["tracked"] == 0
+
+    def test_invalid_options(self):
+        """Test invalid options raise ValueError."""
+        with pytest.raises(ValueError):
+            native.sketch.AccessSketch(0)
+        with pytest.raises(ValueError):
+            native.sketch.AccessSketch(8, channel_precision=2)
@@ -0,0 +1,79 @@
+"""Tests for native call counters (native.stats())."""
+
+import threading
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+@pytest.fixture
+def clean_stats():
+    native.set_stats_enabled(True)
+    native.reset_stats()
+    yield
+    native.set_stats_enabled(True)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestStats:
+    """Counters, histograms and reset."""
+
+    def test_counts_calls_and_elements(self, clean_stats):
+        """Test batch calls record calls, elements and bytes."""
+        query = np.random.randn(16)
+        corpus = np.random.randn(100, 16)
+        for _ in range(3):
+            native.vector_ops.cosine_similarity_batch(query, corpus)
+
+        s = native.stats()["vector_ops.cosine_similarity_batch"]
+        assert s["calls"] == 3
+        assert s["elements"] == 300
+        assert s["bytes_in"] == 3 * (query.nbytes + corpus.nbytes)
+        assert s["bytes_out"] == 3 * 100 * 8
+        assert 0 < s["kernel_ns"] <= s["total_ns"]
+
+    def test_histogram_consistent(self, clean_stats):
+        """Test bucket counts sum to calls and percentiles are ordered."""
+        for _ in range(50):
+            native.string_ops.levenshtein_distance("kitten", "sitting")
+
+        s = native.stats()["string_ops.levenshtein_distance"]
+        assert sum(count for _, count in s["buckets"]) == s["calls"] == 50
+        assert s["p50_ns"] <= s["p90_ns"] <= s["p99_ns"] <= s["max_ns"]
+
+    def test_merges_threads(self, clean_stats):
+        """Test counters from several threads are merged on read."""
+        def work():
+            for _ in range(100):
+                native.string_ops.string_similarity("abc", "abd")
+
+        threads = [threading.Thread(target=work) for _ in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+        assert native.stats()["string_ops.string_similarity"]["calls"] == 400
+
+    def test_reset(self, clean_stats):
+        """Test reset_stats zeroes counters."""
+        native.string_ops.levenshtein_distance("a", "b")
+        native.reset_stats()
+        assert "string_ops.levenshtein_distance" not in native.stats()
+
+        native.string_ops.levenshtein_distance("a", "b")
+        assert native.stats()["string_ops.levenshtein_distance"]["calls"] == 1
+
+    def test_disable(self, clean_stats):
+        """Test nothing is recorded while disabled."""
+        native.set_stats_enabled(False)
+        assert not native.stats_enabled()
+        native.string_ops.levenshtein_distance("a", "b")
+        assert native.stats() == {}
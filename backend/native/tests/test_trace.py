@@ -0,0 +1,78 @@
+"""Tests for the native Chrome-trace span recorder."""
+
+import json
+
+import numpy as np
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+
+@pytest.fixture
+def tracer():
+    native.trace_clear()
+    native.set_tracing(True)
+    yield
+    native.set_tracing(False)
+    native.trace_clear()
+
+
+def _spans(trace_json):
+    return [e for e in json.loads(trace_json)["traceEvents"] if e["ph"] == "X"]
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestTrace:
+    """Span recording, dump format and toggling."""
+
+    def test_off_by_default_records_nothing(self):
+        """Test no spans are recorded while tracing is off."""
+        native.set_tracing(False)
+        native.trace_clear()
+        native.string_ops.levenshtein_distance("a", "b")
+        assert _spans(native.trace_dump()) == []
+
+    def test_call_and_phase_spans(self, tracer):
+        """Test a batch call emits call, marshal and kernel spans with args."""
+        query = np.random.randn(8)
+        corpus = np.random.randn(50, 8)
+        native.vector_ops.cosine_similarity_batch(query, corpus)
+
+        spans = _spans(native.trace_dump())
+        call = [s for s in spans if s["cat"] == "call"
+                and s["name"] == "vector_ops.cosine_similarity_batch"]
+        phases = {s["name"] for s in spans if s["cat"] == "vector_ops.cosine_similarity_batch"}
+        assert len(call) == 1
+        assert call[0]["args"]["batch"] == 50
+        assert call[0]["args"]["simd"] in ("avx2", "neon", "scalar")
+        assert {"marshal", "kernel"} <= phases
+
+    def test_strided_input_reports_scalar(self, tracer):
+        """Test strided rows are tagged with the scalar variant."""
+        corpus = np.random.randn(20, 16)[:, ::2]
+        native.vector_ops.cosine_similarity_batch(np.random.randn(8), corpus)
+
+        call = [s for s in _spans(native.trace_dump()) if s["cat"] == "call"]
+        assert call[-1]["args"]["simd"] == "scalar"
+
+    def test_dump_to_file(self, tracer, tmp_path):
+        """Test trace_dump(path) writes valid Chrome trace JSON."""
+        native.string_ops.levenshtein_distance("kitten", "sitting")
+        path = tmp_path / "trace.json"
+        native.trace_dump(str(path))
+
+        data = json.loads(path.read_text())
+        assert data["displayTimeUnit"] == "ns"
+        assert any(e["ph"] == "M" for e in data["traceEvents"])
+        assert _spans(path.read_text())
+
+    def test_clear(self, tracer):
+        """Test trace_clear drops buffered spans."""
+        native.string_ops.levenshtein_distance("a", "b")
+        native.trace_clear()
+        assert _spans(native.trace_dump()) == []
@@ -0,0 +1,109 @@
+"""Tests for native NFKC normalization and case folding."""
+
+import random
+import sys
+import unicodedata
+
+import pytest
+
+try:
+    import axnmihn_native as native
+    HAS_NATIVE = True
+except ImportError:
+    native = None
+    HAS_NATIVE = False
+
+needs_same_unicode = pytest.mark.skipif(
+    HAS_NATIVE and native.unicode.UNICODE_VERSION != unicodedata.unidata_version,
+    reason="Tables generated for a different Unicode version",
+)
+
+
+def _all_code_points():
+    return [chr(c) for c in range(sys.maxunicode + 1) if not 0xD800 <= c <= 0xDFFF]
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+@needs_same_unicode
+class TestNFKC:
+    """Tests for table-driven NFKC."""
+
+    def test_every_code_point(self):
+        """Test each code point alone matches unicodedata."""
+        for ch in _all_code_points():
+            assert native.unicode.nfkc(ch) == unicodedata.normalize("NFKC", ch), hex(ord(ch))
+
+    def test_random_combining_sequences(self):
+        """Test reordering and composition across starters and marks."""
+        rng = random.Random(7)
+        starters = "aeoAOnC\u1100\uac00\u304b\u03b1\u1f00\u00c5\u0fb2\u212b"
+        marks = "\u0338\u05b4\u0327\u031b\u0323\u0301\u0300\u0308\u0345\u1161\u11a8\u3099\u0f71"
+        for _ in range(20000):
+            text = "".join(
+                rng.choice(starters if rng.random() < 0.4 else marks)
+                for _ in range(rng.randint(1, 8))
+            )
+            assert native.unicode.nfkc(text) == unicodedata.normalize("NFKC", text), ascii(text)
+
+    def test_compatibility_forms(self):
+        """Test full-width, ligature and circled forms."""
+        assert native.unicode.nfkc("ｆｕｌｌ ﬁ ① ㎏") == "full fi 1 kg"
+
+    def test_hangul(self):
+        """Test precomposed syllables pass and conjoining jamo compose."""
+        assert native.unicode.nfkc("한국어") == "한국어"
+        assert native.unicode.nfkc("\u1112\u1161\u11ab") == "\ud55c"
+
+    def test_ascii_unchanged(self):
+        """Test long ASCII text takes the copy path unchanged."""
+        text = "The quick brown fox, 0123456789! " * 40
+        assert native.unicode.nfkc(text) == text
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+@needs_same_unicode
+class TestCasefold:
+    """Tests for full case folding."""
+
+    def test_every_code_point(self):
+        """Test each code point alone matches str.casefold()."""
+        for ch in _all_code_points():
+            assert native.unicode.casefold(ch) == ch.casefold(), hex(ord(ch))
+
+    def test_special_foldings(self):
+        """Test multi-character and final-sigma folds."""
+        assert native.unicode.casefold("Straße ΣΑΣ İ") == "Straße ΣΑΣ İ".casefold()
+
+    def test_ascii_lower_across_simd_widths(self):
+        """Test ASCII lower-casing for lengths around the vector width."""
+        rng = random.Random(1)
+        for length in range(0, 100):
+            text = "".join(chr(rng.randrange(1, 128)) for _ in range(length))
+            assert native.unicode.casefold(text) == text.casefold()
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+@needs_same_unicode
+class TestNormalize:
+    """Tests for the combined name/similarity key."""
+
+    def test_defaults(self):
+        """Test NFKC, fold and collapse are all on by default."""
+        assert native.unicode.normalize("  ＪＯＨＮ 　 Doe ") == "john doe"
+
+    def test_max_chars(self):
+        """Test truncation counts code points of the normalized text."""
+        assert native.unicode.normalize("ﬁle NAME", max_chars=4) == "file"
+
+    def test_batch_matches_scalar(self):
+        """Test the parallel batch agrees with per-text calls."""
+        rng = random.Random(5)
+        pool = ["Ａ", "b", "ß", " ", "\u3000", "é", "e\u0301", "가", "ﬁ", "Σ"]
+        texts = ["".join(rng.choice(pool) for _ in range(rng.randint(0, 12))) for _ in range(2000)]
+        assert native.unicode.normalize_batch(texts) == [native.unicode.normalize(t) for t in texts]
+
+    def test_is_ascii(self):
+        """Test the ASCII scan on either side of a vector boundary."""
+        assert native.unicode.is_ascii("a" * 64)
+        assert not native.unicode.is_ascii("a" * 40 + "é")
+        assert native.unicode.is_ascii("")
@@ -89,6 +89,96 @@ class TestCosineSimilarityBatch:
             results = native.vector_ops.cosine_similarity_batch(query, corpus)
             assert len(results) == 50
 
+    def test_returns_numpy_array(self):
+        """Test batch results come back as a float64 NumPy array."""
+        query = np.random.randn(16).astype(np.float64)
+        corpus = np.random.randn(8, 16).astype(np.float64)
+
+        results = native.vector_ops.cosine_similarity_batch(query, corpus)
+        assert isinstance(results, np.ndarray)
+        assert results.dtype == np.float64
+        assert results.shape == (8,)
+
+
+@pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
+class TestBufferReuse:
+    """Test out= buffers, strided views and strict mode."""
+
+    def test_out_buffer_is_filled_and_returned(self):
+        """Test the caller's out array is written in place."""
+        query = np.random.randn(32)
+        corpus = np.random.randn(10, 32)
+        out = np.empty(10, dtype=np.float64)
+
+        result = native.vector_ops.cosine_similarity_batch(query, corpus, out=out)
+
+        assert result is out
+        expected = native.vector_ops.cosine_similarity_batch(query, corpus)
+        np.testing.assert_allclose(out, expected, atol=1e-12)
+
+    def test_strided_views_match_contiguous(self):
+        """Test row/column slices and strided out give the same results."""
+        np.random.seed(7)
+        base = np.random.randn(40, 64)
+        query_base = np.random.randn(128)
+
+        corpus = base[::2, ::2]          # strided rows and columns
+        query = query_base[::4]          # strided query
+        out_base = np.zeros(40)
+        out = out_base[::2]              # strided output
+
+        native.vector_ops.cosine_similarity_batch(query, corpus, out=out)
+        expected = native.vector_ops.cosine_similarity_batch(
+            np.ascontiguousarray(query), np.ascontiguousarray(corpus)
+        )
+
+        np.testing.assert_allclose(out, expected, atol=1e-12)
+        assert np.all(out_base[1::2] == 0.0)
+
+    def test_dimension_mismatch_raises(self):
+        """Test query/corpus dimension mismatch is an error."""
+        with pytest.raises(ValueError):
+            native.vector_ops.cosine_similarity_batch(np.zeros(3), np.zeros((4, 5)))
+
+    def test_out_wrong_dtype_raises(self):
+        """Test out must already have the result dtype."""
+        with pytest.raises(TypeError):
+            native.vector_ops.cosine_similarity_batch(
+                np.ones(3), np.ones((4, 3)), out=np.empty(4, dtype=np.float32)
+            )
+
+    def test_strict_mode_rejects_copies(self):
+        """Test strict mode raises instead of converting float32 input."""
+        query = np.ones(8, dtype=np.float32)
+        corpus = np.ones((2, 8), dtype=np.float64)
+
+        native.set_strict_mode(True)
+        try:
+            assert native.strict_mode() is True
+            with pytest.raises(TypeError):
+                native.vector_ops.cosine_similarity_batch(query, corpus)
+            # Matching dtype with strides is still accepted
+            native.vector_ops.cosine_similarity_batch(corpus[0, ::2], corpus[:, ::2])
+        finally:
+            native.set_strict_mode(False)
+
+        # Default mode converts silently
+        result = native.vector_ops.cosine_similarity_batch(query, corpus)
+        assert abs(result[0] - 1.0) < 1e-6
+
+    def test_duplicates_on_strided_rows(self):
+        """Test duplicate search reads row slices in place."""
+        embeddings = np.array([
+            [1.0, 0.0, 0.0],
+            [9.0, 9.0, 9.0],
+            [0.0, 1.0, 0.0],
+            [9.0, 9.0, 9.0],
+            [1.0, 0.0, 0.0],
+        ], dtype=np.float64)
+
+        dup_i, dup_j, _ = native.vector_ops.find_duplicates_by_embedding(embeddings[::2], 0.99)
+        assert list(zip(dup_i.tolist(), dup_j.tolist())) == [(0, 2)]
+
 
 @pytest.mark.skipif(not HAS_NATIVE, reason="Native module not available")
 class TestFindDuplicates:
@@ -102,29 +192,44 @@ class TestFindDuplicates:
             [1.0, 0.0, 0.0],  # Duplicate of first
         ], dtype=np.float64)
 
-        duplicates = native.vector_ops.find_duplicates_by_embedding(embeddings, 0.99)
+        dup_i, dup_j, dup_sim = native.vector_ops.find_duplicates_by_embedding(embeddings, 0.99)
 
         # Should find (0, 2) as duplicates
-        assert len(duplicates) == 1
-        i, j, sim = duplicates[0]
-        assert (i, j) == (0, 2)
-        assert abs(sim - 1.0) < 1e-6
+        assert len(dup_i) == 1
+        assert (dup_i[0], dup_j[0]) == (0, 2)
+        assert abs(dup_sim[0] - 1.0) < 1e-6
 
     def test_threshold_filtering(self):
         """Test that threshold correctly filters results."""
         np.random.seed(42)
         embeddings = np.random.randn(10, 50).astype(np.float64)
 
-        high_threshold = native.vector_ops.find_duplicates_by_embedding(embeddings, 0.99)
-        low_threshold = native.vector_ops.find_duplicates_by_embedding(embeddings, 0.5)
+        high_i, _, _ = native.vector_ops.find_duplicates_by_embedding(embeddings, 0.99)
+        low_i, _, low_sim = native.vector_ops.find_duplicates_by_embedding(embeddings, 0.5)
+
+        assert len(low_i) >= len(high_i)
+        assert np.all(low_sim >= 0.5)
+
+    def test_returns_parallel_arrays(self):
+        """Test pairs come back as (int64, int64, float64) parallel arrays."""
+        embeddings = np.array([
+            [1.0, 0.0],
+            [1.0, 0.0],
+            [1.0, 0.0],
+        ], dtype=np.float64)
+
+        dup_i, dup_j, dup_sim = native.vector_ops.find_duplicates_by_embedding(embeddings, 0.99)
 
-        assert len(low_threshold) >= len(high_threshold)
+        assert dup_i.dtype == np.int64
+        assert dup_j.dtype == np.int64
+        assert dup_sim.dtype == np.float64
+        assert list(zip(dup_i.tolist(), dup_j.tolist())) == [(0, 1), (0, 2), (1, 2)]
 
     def test_empty_embeddings(self):
         """Test with empty input."""
         embeddings = np.array([], dtype=np.float64).reshape(0, 10)
-        duplicates = native.vector_ops.find_duplicates_by_embedding(embeddings, 0.9)
-        assert duplicates == []
+        dup_i, dup_j, dup_sim = native.vector_ops.find_duplicates_by_embedding(embeddings, 0.9)
+        assert len(dup_i) == len(dup_j) == len(dup_sim) == 0
 
 
 if __name__ == "__main__":
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+"""Generate src/unicode_tables.inc for the native Unicode normalizer.
+
+The tables are derived from Python's unicodedata, so the native NFKC and
+case folding agree with unicodedata.normalize("NFKC", s) and
+str.casefold() of the Python that ran this script. Re-run after moving
+to a Python with a newer Unicode version:
+
+    python3 backend/native/tools/gen_unicode_tables.py
+"""
+
+import sys
+import unicodedata
+from pathlib import Path
+
+OUT = Path(__file__).resolve().parent.parent / "src" / "unicode_tables.inc"
+
+BLOCK_SHIFT = 7
+BLOCK_SIZE = 1 << BLOCK_SHIFT
+MAX_CP = 0x110000
+
+S_BASE, S_COUNT = 0xAC00, 11172
+V_BASE, V_COUNT = 0x1161, 21
+T_BASE, T_COUNT = 0x11A7, 28
+
+FLAG_COMPOSE_SECOND = 1
+
+
+def is_surrogate(cp):
+    return 0xD800 <= cp <= 0xDFFF
+
+
+def is_hangul_syllable(cp):
+    return S_BASE <= cp < S_BASE + S_COUNT
+
+
+def build():
+    data = []          # Shared code point pool for decompositions and folds
+    data_index = {}    # Sequence -> offset, so repeated sequences are stored once
+
+    def intern(seq):
+        key = tuple(seq)
+        if key not in data_index:
+            data_index[key] = len(data)
+            data.extend(seq)
+        return (data_index[key] << 5) | len(seq)
+
+    # Primary composites: canonical pairs that NFC recomposes
+    compose_seconds = set(range(V_BASE, V_BASE + V_COUNT)) | set(range(T_BASE + 1, T_BASE + T_COUNT))
+    pairs = []
+    for cp in range(MAX_CP):
+        if is_surrogate(cp) or is_hangul_syllable(cp):
+            continue
+        decomp = unicodedata.decomposition(chr(cp))
+        if not decomp or decomp.startswith("<"):
+            continue
+        parts = [int(p, 16) for p in decomp.split()]
+        if len(parts) != 2:
+            continue
+        if unicodedata.normalize("NFC", chr(parts[0]) + chr(parts[1])) == chr(cp):
+            pairs.append((parts[0], parts[1], cp))
+            compose_seconds.add(parts[1])
+    pairs.sort()
+
+    records = {(0, 0, 0, 0): 0}
+    record_list = [(0, 0, 0, 0)]
+    cp_record = [0] * MAX_CP
+    for cp in range(MAX_CP):
+        if is_surrogate(cp):
+            continue
+        ch = chr(cp)
+        decomp = 0
+        if not is_hangul_syllable(cp):
+            nfkd = unicodedata.normalize("NFKD", ch)
+            if nfkd != ch:
+                decomp = intern([ord(c) for c in nfkd])
+        folded = ch.casefold()
+        fold = intern([ord(c) for c in folded]) if folded != ch else 0
+        ccc = unicodedata.combining(ch)
+        flags = FLAG_COMPOSE_SECOND if cp in compose_seconds else 0
+        rec = (decomp, fold, ccc, flags)
+        if rec not in records:
+            records[rec] = len(record_list)
+            record_list.append(rec)
+        cp_record[cp] = records[rec]
+
+    blocks = {}
+    block_list = []
+    stage1 = []
+    for start in range(0, MAX_CP, BLOCK_SIZE):
+        block = tuple(cp_record[start:start + BLOCK_SIZE])
+        if block not in blocks:
+            blocks[block] = len(block_list)
+            block_list.append(block)
+        stage1.append(blocks[block])
+
+    return data, pairs, record_list, block_list, stage1
+
+
+def emit_array(lines, ctype, name, values, per_line=12):
+    lines.append(f"alignas(64) constexpr {ctype} {name}[{len(values)}] = {{")
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(str(v) for v in values[i:i + per_line]) + ",")
+    lines.append("};")
+    lines.append("")
+
+
+def main():
+    data, pairs, records, blocks, stage1 = build()
+    assert len(records) < 1 << 16 and len(blocks) < 1 << 16
+
+    lines = [
+        "// Generated by backend/native/tools/gen_unicode_tables.py; do not edit.",
+        f"// Unicode {unicodedata.unidata_version} (Python {sys.version.split()[0]} unicodedata)",
+        "",
+        f'constexpr const char UNICODE_VERSION[] = "{unicodedata.unidata_version}";',
+        f"constexpr int BLOCK_SHIFT = {BLOCK_SHIFT};",
+        f"constexpr uint8_t FLAG_COMPOSE_SECOND = {FLAG_COMPOSE_SECOND};",
+        "",
+        "// decomp / fold: (offset into SEQUENCE_DATA << 5) | length, 0 = none",
+        "struct CharRecord {",
+        "    uint32_t decomp;",
+        "    uint32_t fold;",
+        "    uint8_t ccc;",
+        "    uint8_t flags;",
+        "};",
+        "",
+        f"constexpr CharRecord RECORDS[{len(records)}] = {{",
+    ]
+    for i in range(0, len(records), 4):
+        chunk = records[i:i + 4]
+        lines.append("    " + " ".join(f"{{{d}, {f}, {c}, {fl}}}," for d, f, c, fl in chunk))
+    lines.append("};")
+    lines.append("")
+
+    emit_array(lines, "uint16_t", "STAGE1", stage1, per_line=16)
+    flat = [r for block in blocks for r in block]
+    emit_array(lines, "uint16_t", "STAGE2", flat, per_line=16)
+    emit_array(lines, "uint32_t", "SEQUENCE_DATA", data)
+
+    lines.append("// Canonical composition pairs sorted by (first, second)")
+    lines.append("struct ComposePair {")
+    lines.append("    uint32_t first;")
+    lines.append("    uint32_t second;")
+    lines.append("    uint32_t composite;")
+    lines.append("};")
+    lines.append("")
+    lines.append(f"constexpr ComposePair COMPOSE_PAIRS[{len(pairs)}] = {{")
+    for i in range(0, len(pairs), 4):
+        chunk = pairs[i:i + 4]
+        lines.append("    " + " ".join(f"{{0x{a:X}, 0x{b:X}, 0x{c:X}}}," for a, b, c in chunk))
+    lines.append("};")
+    lines.append("")
+
+    OUT.write_text("\n".join(lines))
+    print(f"{OUT}: {len(records)} records, {len(blocks)} blocks, "
+          f"{len(data)} sequence code points, {len(pairs)} composition pairs")
+
+
+if __name__ == "__main__":
+    main()
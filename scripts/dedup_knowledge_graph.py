@@ -18,6 +18,7 @@ from dotenv import load_dotenv
 load_dotenv()
 
 from backend.config import KNOWLEDGE_GRAPH_PATH
+from backend.core.utils.text_normalize import text_key
 
 # Try to import native module for optimized string operations
 try:
@@ -66,12 +67,11 @@ RELATION_NORMALIZATION = {
     "prefers": ["likes", "enjoys", "favors", "선호"],
 }
 
-def normalize_name(name: str) -> str:
+_NAME_SEPARATORS = str.maketrans({c: " " for c in "_-()"})
 
-    n = name.lower()
-    n = n.replace("_", " ").replace("-", " ").replace("(", " ").replace(")", " ")
-    n = " ".join(n.split())
-    return n
+def normalize_name(name: str) -> str:
+    """Name key shared with the graph's name index, with _-() as spaces."""
+    return text_key(name.translate(_NAME_SEPARATORS))
 
 def string_similarity(a: str, b: str) -> float:
     """Calculate string similarity using Levenshtein distance.
@@ -149,9 +149,9 @@ def find_duplicates(entities: dict, threshold: float = 0.85) -> List[Tuple[str,
     # Use native batch processing if available
     if _HAS_NATIVE and n > 20:
         # Native batch comparison
-        native_dups = _native.string_ops.find_string_duplicates(names, threshold)
+        dup_i, dup_j, dup_sim = _native.string_ops.find_string_duplicates(names, threshold)
 
-        for i, j, sim in native_dups:
+        for i, j, sim in zip(dup_i.tolist(), dup_j.tolist(), dup_sim.tolist()):
             id1, e1 = entity_list[i]
             id2, e2 = entity_list[j]
 
@@ -226,7 +226,7 @@ def _find_isolated_clusters(
 
     components = _native.graph_ops.find_connected_components(
         dict(adjacency), n_nodes
-    )
+    ).tolist()
 
     # Count nodes per component
     comp_sizes: dict[int, int] = defaultdict(int)
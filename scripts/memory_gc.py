@@ -22,10 +22,9 @@ from backend.memory.permanent import LongTermMemory, MemoryConfig
 from backend.memory.recent import SessionArchive
 from backend.memory import MemoryManager
 from backend.core.identity.ai_brain import IdentityManager
-from collections import defaultdict
+from backend.core.utils.content_hash import content_hash, duplicate_groups
 
 init_state = None
-import hashlib
 
 # Try to import native module for optimized vector operations
 try:
@@ -42,39 +41,29 @@ OVERSIZED_PATTERNS = [
     "data:image/webp;base64,",
 ]
 
-def get_content_hash(content: str) -> str:
+_DEDUP_NORMALIZE = {"collapse_whitespace": True, "casefold": True, "max_chars": 200}
+
 
-    normalized = content.lower().strip()[:200]
-    return hashlib.md5(normalized.encode()).hexdigest()
+def get_content_hash(content: str) -> str:
+    """XXH3-128 hash of normalized content for dedup."""
+    return content_hash(content, **_DEDUP_NORMALIZE)
 
 def phase1_hash_dedup(ltm, all_data, dry_run: bool = False) -> list:
     """Phase 1: Hash-based exact duplicate removal."""
 
     print("\n[Phase 1] Hash-based deduplication (exact matches)...")
 
-    hash_to_ids = defaultdict(list)
-
-    for i, (doc_id, doc, meta) in enumerate(zip(
-        all_data['ids'],
-        all_data['documents'],
-        all_data['metadatas'] or [{}] * len(all_data['ids'])
-    )):
-        content_hash = get_content_hash(doc)
-        hash_to_ids[content_hash].append({
-            'id': doc_id,
-            'doc': doc,
-            'meta': meta or {},
-            'importance': (meta or {}).get('importance', 0.5)
-        })
+    docs = [doc or "" for doc in all_data['documents']]
+    metas = all_data['metadatas'] or [{}] * len(all_data['ids'])
 
     duplicates_to_delete = []
 
-    for content_hash, entries in hash_to_ids.items():
-        if len(entries) > 1:
-            entries.sort(key=lambda x: x['importance'], reverse=True)
-            for dup in entries[1:]:
-                duplicates_to_delete.append(dup['id'])
-                print(f"  [HASH] {dup['doc'][:50]}...")
+    for group in duplicate_groups(docs, **_DEDUP_NORMALIZE):
+        # Highest importance survives; ties keep the earliest entry
+        group.sort(key=lambda i: (metas[i] or {}).get('importance', 0.5), reverse=True)
+        for i in group[1:]:
+            duplicates_to_delete.append(all_data['ids'][i])
+            print(f"  [HASH] {docs[i][:50]}...")
 
     if duplicates_to_delete:
         if not dry_run:
@@ -129,14 +118,14 @@ def _phase2_native(ltm, threshold: float) -> list[dict]:
     embeddings = np.array(valid_embeddings, dtype=np.float64)
     print(f"  Native batch: {len(valid_embeddings)} embeddings, dim={embeddings.shape[1]}")
 
-    dup_pairs = _native.vector_ops.find_duplicates_by_embedding(embeddings, threshold)
-    print(f"  Found {len(dup_pairs)} duplicate pairs via native")
+    dup_i, dup_j, dup_sim = _native.vector_ops.find_duplicates_by_embedding(embeddings, threshold)
+    print(f"  Found {len(dup_i)} duplicate pairs via native")
 
     # For each pair, decide which to keep (higher importance wins)
     to_delete: list[dict] = []
     delete_ids: set[str] = set()
 
-    for vi, vj, sim in dup_pairs:
+    for vi, vj, sim in zip(dup_i.tolist(), dup_j.tolist(), dup_sim.tolist()):
         idx_i = valid_indices[vi]
         idx_j = valid_indices[vj]
         id_i = ids[idx_i]
@@ -881,6 +870,7 @@ Examples:
   python scripts/memory_gc.py check        # Status check only
   python scripts/memory_gc.py cleanup      # Remove oversized entries
   python scripts/memory_gc.py cleanup --dry-run  # Preview cleanup
+  python scripts/memory_gc.py full --trace gc.json  # Record native spans (chrome://tracing)
 """
     )
 
@@ -894,6 +884,7 @@ Examples:
 
     full_parser = subparsers.add_parser("full", help="Complete 7-phase garbage collection")
     full_parser.add_argument("--dry-run", action="store_true", help="Simulate without deleting")
+    full_parser.add_argument("--trace", metavar="PATH", help="Write native kernel spans as Chrome trace JSON")
 
     args = parser.parse_args()
 
@@ -905,7 +896,17 @@ Examples:
     elif args.command == "full" or args.command is None:
 
         dry_run = getattr(args, 'dry_run', False)
-        asyncio.run(main_async(dry_run=dry_run))
+        trace_path = getattr(args, 'trace', None)
+        if trace_path and _native is not None:
+            _native.trace_clear()
+            _native.set_tracing(True)
+        try:
+            asyncio.run(main_async(dry_run=dry_run))
+        finally:
+            if trace_path and _native is not None:
+                _native.set_tracing(False)
+                _native.trace_dump(trace_path)
+                print(f"Native trace written to {trace_path}")
 
 if __name__ == "__main__":
     main()
@@ -0,0 +1,299 @@
+#!/usr/bin/env python3
+"""Differential accuracy harness for the native kernels.
+
+Runs each fast native kernel next to an exact float64 NumPy reference
+over the same inputs and reports how far they drift apart:
+
+    decay    decay_ops.calculate_batch_numpy vs the decay formula in NumPy
+             (max/mean abs error, max relative error)
+    search   MemoryEngine.build_context float32 scan vs exact cosine top-k
+             (recall@k, similarity error of the returned scores)
+    dedup    vector_ops.find_duplicates_by_embedding vs exact pair set
+             (precision, recall, jaccard)
+
+Inputs are seeded random data, optionally followed by recorded production
+inputs from an .npz file (keys: embeddings, queries, and the seven decay
+columns importance, hours_passed, access_count, connection_count,
+last_access_hours, memory_type, channel_mentions; any subset may be
+present). A check outside its threshold fails the run (exit code 1).
+
+The same metrics are available at runtime: set
+axnmihn_native.accuracy.set_sample_rate(rate) and read
+axnmihn_native.accuracy.metrics().
+
+Usage:
+    python scripts/native_accuracy.py                        # 1M decay, 100k x 768 search
+    python scripts/native_accuracy.py --recorded dump.npz    # plus recorded inputs
+    python scripts/native_accuracy.py --out accuracy.json    # keep the report
+"""
+
+import argparse
+import json
+import os
+import sys
+from pathlib import Path
+
+import numpy as np
+
+if os.path.exists('/app'):
+    sys.path.insert(0, '/app')
+else:
+    sys.path.insert(0, str(Path(__file__).parent.parent))
+
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE = True
+except ImportError:
+    _native = None
+    _HAS_NATIVE = False
+
+# Limits per check; a metric outside its limit fails the run
+THRESHOLDS = {
+    "decay": {"max_abs": 1e-9, "max_rel": 1e-9},
+    "search": {"min_recall": 0.99, "max_abs": 1e-5},
+    "dedup": {"min_jaccard": 0.999},
+}
+
+DECAY_COLUMNS = (
+    "importance", "hours_passed", "access_count", "connection_count",
+    "last_access_hours", "memory_type", "channel_mentions",
+)
+_INT_COLUMNS = {"access_count", "connection_count", "memory_type", "channel_mentions"}
+
+
+# ── Inputs ───────────────────────────────────────────────────────────────────
+
+
+def random_decay_columns(n: int, rng: np.random.Generator) -> dict:
+    """Decay inputs covering the edge cases: negative age, never accessed,
+    recency boost window, out-of-range memory types."""
+    hours = rng.exponential(2000.0, n)
+    hours[rng.random(n) < 0.01] *= -1.0          # clock skew
+    last = rng.exponential(48.0, n)
+    last[rng.random(n) < 0.3] = -1.0             # never accessed
+    return {
+        "importance": rng.random(n),
+        "hours_passed": hours,
+        "access_count": rng.integers(0, 200, n, dtype=np.int32),
+        "connection_count": rng.integers(0, 15, n, dtype=np.int32),
+        "last_access_hours": last,
+        "memory_type": rng.integers(-1, 5, n, dtype=np.int32),
+        "channel_mentions": rng.integers(0, 6, n, dtype=np.int32),
+    }
+
+
+def random_embeddings(n: int, dim: int, rng: np.random.Generator, dup_every: int = 50) -> np.ndarray:
+    """Gaussian rows; every dup_every-th row is a near-copy of an earlier one."""
+    emb = rng.standard_normal((n, dim))
+    for row in range(dup_every, n, dup_every):
+        src = int(rng.integers(0, row))
+        emb[row] = emb[src] + rng.standard_normal(dim) * 0.05
+    return emb
+
+
+def load_recorded(path: Path) -> dict:
+    """Read recorded inputs; decay columns are returned only when all seven exist."""
+    with np.load(path) as data:
+        recorded = {key: data[key] for key in data.files}
+    result = {}
+    if all(col in recorded for col in DECAY_COLUMNS):
+        result["decay"] = {
+            col: np.ascontiguousarray(recorded[col],
+                                      dtype=np.int32 if col in _INT_COLUMNS else np.float64)
+            for col in DECAY_COLUMNS
+        }
+    if "embeddings" in recorded:
+        result["embeddings"] = np.ascontiguousarray(recorded["embeddings"], dtype=np.float64)
+    if "queries" in recorded:
+        result["queries"] = np.ascontiguousarray(recorded["queries"], dtype=np.float64)
+    return result
+
+
+# ── Exact references ─────────────────────────────────────────────────────────
+
+
+def decay_reference(cols: dict, config=None) -> np.ndarray:
+    """The decay formula in float64 NumPy (mirrors decay::calculate_reference)."""
+    base_rate, min_retention, access_k, relation_k, channel_k = 0.002, 0.1, 0.3, 0.1, 0.2
+    multipliers = np.array([1.0, 0.3, 0.5, 0.7])
+    if config is not None:
+        base_rate = config.base_decay_rate
+        min_retention = config.min_retention
+        access_k = config.access_stability_k
+        relation_k = config.relation_resistance_k
+        channel_k = config.channel_diversity_k
+
+    imp = cols["importance"]
+    hours = cols["hours_passed"]
+    last = cols["last_access_hours"]
+    stability = 1.0 + access_k * np.log1p(cols["access_count"].astype(np.float64))
+    resistance = np.minimum(1.0, cols["connection_count"] * relation_k)
+    type_mult = multipliers[np.clip(cols["memory_type"], 0, 3)]
+    channel_boost = 1.0 / (1.0 + channel_k * cols["channel_mentions"])
+    rate = base_rate * type_mult * channel_boost / stability * (1.0 - resistance)
+    decayed = imp * np.exp(-rate * hours)
+    decayed = np.where((last >= 0) & (hours > 168.0) & (last < 24.0), decayed * 1.3, decayed)
+    result = np.maximum(decayed, imp * min_retention)
+    return np.where(hours < 0, imp, result)
+
+
+def exact_top_k(unit: np.ndarray, query: np.ndarray, k: int) -> tuple[np.ndarray, np.ndarray]:
+    """Exact cosine top-k over L2-normalised rows (ties by index)."""
+    q = query / np.linalg.norm(query)
+    sims = unit @ q
+    order = np.lexsort((np.arange(len(sims)), -sims))[:k]
+    return order, sims
+
+
+def exact_pairs(embeddings: np.ndarray, threshold: float) -> tuple[np.ndarray, np.ndarray]:
+    """All (i < j) pairs with cosine similarity >= threshold."""
+    norms = np.linalg.norm(embeddings, axis=1)
+    norms[norms == 0] = 1.0
+    unit = embeddings / norms[:, None]
+    sims = unit @ unit.T
+    i, j = np.nonzero(np.triu(sims >= threshold, k=1))
+    return i.astype(np.int64), j.astype(np.int64)
+
+
+# ── Checks ───────────────────────────────────────────────────────────────────
+
+
+def check_decay(cols: dict, source: str) -> dict:
+    config = _native.decay_ops.DecayConfig()
+    fast = _native.decay_ops.calculate_batch_numpy(*(cols[c] for c in DECAY_COLUMNS), config)
+    exact = decay_reference(cols, config)
+    metrics = _native.accuracy.compare_values(fast, exact)
+    limits = THRESHOLDS["decay"]
+    ok = metrics["max_abs"] <= limits["max_abs"] and metrics["max_rel"] <= limits["max_rel"]
+    return {"check": "decay", "source": source, "n": len(exact), "ok": ok, **metrics}
+
+
+def check_search(embeddings: np.ndarray, queries: np.ndarray, k: int, source: str) -> dict:
+    """Neutral attributes (importance 1, no age, no boosts) make the
+    build_context score equal to the float32 cosine similarity."""
+    n, dim = embeddings.shape
+    engine = _native.memory_engine.MemoryEngine(dim)
+    ids = [str(i) for i in range(n)]
+    engine.upsert_batch(ids, embeddings, importance=np.ones(n))
+
+    filters = _native.memory_engine.BuildFilters()
+    filters.candidate_count = k
+    filters.min_similarity = -2.0
+    filters.hot_boost = 0.0
+    filters.graph_weight = 0.0
+
+    norms = np.linalg.norm(embeddings, axis=1)
+    norms[norms == 0] = 1.0
+    unit = embeddings / norms[:, None]
+
+    recalls, errors = [], []
+    for query in queries:
+        got_ids, got_scores, _ = engine.build_context(query, budget=1 << 30, filters=filters)
+        got = np.array([int(i) for i in got_ids], dtype=np.int64)
+        truth, sims = exact_top_k(unit, query, k)
+        recalls.append(_native.accuracy.recall_at_k(got, truth, k))
+        if len(got):
+            errors.append(_native.accuracy.compare_values(got_scores, sims[got]))
+
+    limits = THRESHOLDS["search"]
+    mean_recall = float(np.mean(recalls)) if recalls else 1.0
+    min_recall = float(np.min(recalls)) if recalls else 1.0
+    max_abs = max((e["max_abs"] for e in errors), default=0.0)
+    mean_abs = float(np.mean([e["mean_abs"] for e in errors])) if errors else 0.0
+    ok = min_recall >= limits["min_recall"] and max_abs <= limits["max_abs"]
+    return {"check": "search", "source": source, "n": n, "dim": dim, "queries": len(queries),
+            "k": k, "ok": ok, "mean_recall": mean_recall, "min_recall": min_recall,
+            "max_abs": max_abs, "mean_abs": mean_abs}
+
+
+def check_dedup(embeddings: np.ndarray, threshold: float, source: str) -> dict:
+    fast = _native.vector_ops.find_duplicates_by_embedding(embeddings, threshold)
+    exact = exact_pairs(embeddings, threshold)
+    agreement = _native.accuracy.pair_agreement(fast, exact)
+    ok = agreement["jaccard"] >= THRESHOLDS["dedup"]["min_jaccard"]
+    return {"check": "dedup", "source": source, "n": len(embeddings),
+            "threshold": threshold, "ok": ok, **agreement}
+
+
+def run_checks(args) -> list[dict]:
+    rng = np.random.default_rng(args.seed)
+    results = [
+        check_decay(random_decay_columns(args.decay_n, rng), "random"),
+        check_search(random_embeddings(args.memories, args.dim, rng),
+                     rng.standard_normal((args.queries, args.dim)), args.k, "random"),
+        check_dedup(random_embeddings(args.dedup_n, args.dim, rng),
+                    args.dedup_threshold, "random"),
+    ]
+
+    if args.recorded:
+        recorded = load_recorded(args.recorded)
+        source = args.recorded.name
+        if "decay" in recorded:
+            results.append(check_decay(recorded["decay"], source))
+        if "embeddings" in recorded:
+            embeddings = recorded["embeddings"]
+            queries = recorded.get("queries")
+            if queries is None:
+                pick = rng.choice(len(embeddings), min(args.queries, len(embeddings)), replace=False)
+                queries = embeddings[pick]
+            results.append(check_search(embeddings, queries, args.k, source))
+            results.append(check_dedup(embeddings[-args.dedup_n:], args.dedup_threshold, source))
+    return results
+
+
+def print_report(results: list[dict]) -> None:
+    print(f"{'check':<8} {'source':<16} {'n':>9}  metrics")
+    for r in results:
+        if r["check"] == "decay":
+            detail = f"max_abs={r['max_abs']:.3g} mean_abs={r['mean_abs']:.3g} max_rel={r['max_rel']:.3g}"
+        elif r["check"] == "search":
+            detail = (f"recall@{r['k']} mean={r['mean_recall']:.4f} min={r['min_recall']:.4f} "
+                      f"max_abs={r['max_abs']:.3g}")
+        else:
+            detail = (f"pairs {r['approx']}/{r['exact']} common={r['common']} "
+                      f"jaccard={r['jaccard']:.4f}")
+        status = "ok" if r["ok"] else "FAIL"
+        print(f"{r['check']:<8} {r['source']:<16} {r['n']:>9}  {detail}  {status}")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Differential accuracy harness for native kernels",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog=__doc__.split("Usage:", 1)[1],
+    )
+    parser.add_argument("--decay-n", type=int, default=1_000_000)
+    parser.add_argument("--memories", type=int, default=100_000)
+    parser.add_argument("--dim", type=int, default=768)
+    parser.add_argument("--queries", type=int, default=50)
+    parser.add_argument("--k", type=int, default=20)
+    parser.add_argument("--dedup-n", type=int, default=2000,
+                        help="Rows compared pairwise in the dedup check")
+    parser.add_argument("--dedup-threshold", type=float, default=0.9)
+    parser.add_argument("--seed", type=int, default=20240917)
+    parser.add_argument("--recorded", type=Path, help=".npz of recorded production inputs")
+    parser.add_argument("--out", type=Path, help="Write the report as JSON")
+    args = parser.parse_args()
+
+    if not _HAS_NATIVE:
+        print("axnmihn_native is not importable; build backend/native first.")
+        return 2
+
+    results = run_checks(args)
+    print_report(results)
+
+    if args.out:
+        with open(args.out, "w", encoding="utf-8") as f:
+            json.dump({"thresholds": THRESHOLDS, "simd": _native.simd_variant(),
+                       "results": results}, f, indent=2)
+
+    failed = [f"{r['check']}/{r['source']}" for r in results if not r["ok"]]
+    if failed:
+        print(f"\nFAIL: {', '.join(failed)}")
+        return 1
+    print("\nPASS")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,548 @@
+#!/usr/bin/env python3
+"""End-to-end native regression benchmark.
+
+Builds a seeded fixture (memory store with embeddings, a knowledge graph
+and an interaction log), drives the Python memory layer over it with the
+native module loaded, and times each phase:
+
+    load           MemoryEngine.upsert_batch + entity/topic/keyword indexing
+    consolidation  MemoryConsolidator.consolidate (native decay batch)
+    dedup          memory_gc phase 2 (native embedding dedup) on a window
+    retrieval      KnowledgeGraph.get_neighbors + MemoryEngine top-K per turn
+    context_build  MemoryEngine.build_context with graph/topic/budget per turn
+
+Phase medians are compared against the checked-in baseline for the same
+fixture shape; a phase slower than baseline * (1 + tolerance) + slack
+fails the run (exit code 1), and so does a shape or phase with no
+recorded baseline.
+
+Usage:
+    python scripts/native_regression.py                      # 100k x 3072
+    python scripts/native_regression.py --ci                 # 20k x 768 CI shape
+    python scripts/native_regression.py --memories 20000 --dim 768
+    python scripts/native_regression.py --write-baseline     # record this machine
+    python scripts/native_regression.py --out run.json       # keep the report
+"""
+
+import argparse
+import json
+import os
+import platform
+import statistics
+import sys
+import tempfile
+import time
+from datetime import datetime, timedelta, timezone
+from pathlib import Path
+from unittest import mock
+
+import numpy as np
+
+if os.path.exists('/app'):
+    sys.path.insert(0, '/app')
+else:
+    sys.path.insert(0, str(Path(__file__).parent.parent))
+
+try:
+    import axnmihn_native as _native
+    _HAS_NATIVE = True
+except ImportError:
+    _native = None
+    _HAS_NATIVE = False
+
+BASELINE_PATH = Path(__file__).with_name("native_regression_baseline.json")
+
+DEFAULT_TOLERANCE = 0.15
+DEFAULT_SLACK_MS = 5.0
+
+# Smaller fixture for CI runners; its baseline is keyed separately
+CI_SHAPE = {"memories": 20_000, "dim": 768, "entities": 2_000, "relations": 10_000, "turns": 50}
+
+MEMORY_TYPES = ("conversation", "fact", "preference", "insight")
+
+_WORDS = (
+    "오늘", "내일", "사용자", "메모리", "대화", "프로젝트", "회의", "일정", "커피", "서울",
+    "회사", "친구", "가족", "주말", "여행", "음악", "영화", "코드", "서버", "모델",
+    "검색", "기억", "질문", "답변", "문제", "운동", "날씨", "공부", "계획", "목표",
+    "Python", "API", "GPU", "PostgreSQL", "Redis",
+)
+_PARTICLES = ("은", "는", "이", "가", "을", "를", "에", "에서", "와", "도", "")
+
+
+# ── Fixture ──────────────────────────────────────────────────────────────────
+
+
+class Fixture:
+    """Seeded synthetic store shaped like production data.
+
+    Attributes:
+        ids: Memory ids
+        embeddings: float32 (n, dim) matrix; every 20th row is a
+            near-duplicate of an earlier one
+        texts: Korean memory contents
+        metadatas: Chroma-style metadata dicts (ISO timestamps)
+        entities: Entity id per memory
+        relations: (source, target) entity pairs
+        turns: Interaction log entries (query embedding, text, entities)
+        now: Reference time the timestamps were generated against
+    """
+
+    def __init__(self, n_memories: int, dim: int, n_entities: int, n_relations: int,
+                 n_turns: int, seed: int = 20240917):
+        rng = np.random.default_rng(seed)
+        # Timestamps are relative to the wall clock so the decay layer
+        # (which reads the current time) sees the same ages on every run
+        self.now = datetime.now(timezone.utc).replace(microsecond=0)
+        self.ids = [f"mem-{i:07d}" for i in range(n_memories)]
+
+        self.embeddings = np.empty((n_memories, dim), dtype=np.float32)
+        chunk = 8192
+        for start in range(0, n_memories, chunk):
+            stop = min(n_memories, start + chunk)
+            self.embeddings[start:stop] = rng.standard_normal((stop - start, dim), dtype=np.float32)
+        dup_rows = np.arange(20, n_memories, 20)
+        sources = rng.integers(0, np.maximum(dup_rows, 1))
+        noise = rng.standard_normal((len(dup_rows), dim), dtype=np.float32) * 0.05
+        self.embeddings[dup_rows] = self.embeddings[sources] + noise
+
+        words = np.array([w + p for w in _WORDS for p in _PARTICLES])
+        lengths = rng.integers(4, 30, n_memories)
+        picks = rng.integers(0, len(words), int(lengths.sum()))
+        self.texts = []
+        offset = 0
+        for length in lengths:
+            self.texts.append(" ".join(words[picks[offset:offset + length]]) + ".")
+            offset += length
+
+        ages = rng.random(n_memories) ** 2 * 24 * 730  # hours, skewed recent
+        access = np.where(rng.random(n_memories) < 0.25, rng.integers(0, 50, n_memories),
+                          rng.integers(0, 3, n_memories))
+        types = rng.integers(0, 4, n_memories)
+        importance = 0.1 + 0.9 * rng.random(n_memories)
+        repetitions = rng.integers(1, 5, n_memories)
+        n_entities = max(1, n_entities)
+        entity_of = rng.integers(0, n_entities, n_memories)
+
+        self.metadatas = []
+        self.entities = []
+        for i in range(n_memories):
+            created = self.now - timedelta(hours=float(ages[i]))
+            meta = {
+                "created_at": created.isoformat(),
+                "importance": float(importance[i]),
+                "access_count": int(access[i]),
+                "repetitions": int(repetitions[i]),
+                "type": MEMORY_TYPES[types[i]],
+                "content": self.texts[i],
+            }
+            if access[i] > 0:
+                accessed = created + (self.now - created) * float(rng.random())
+                meta["last_accessed"] = accessed.isoformat()
+            self.metadatas.append(meta)
+            self.entities.append(f"entity-{entity_of[i]}")
+
+        src = (rng.random(n_relations) ** 2 * n_entities).astype(np.int64)
+        dst = rng.integers(0, n_entities, n_relations)
+        self.relations = [(f"entity-{a}", f"entity-{b}") for a, b in zip(src, dst) if a != b]
+        self.n_entities = n_entities
+
+        targets = rng.integers(0, n_memories, n_turns)
+        self.turns = []
+        for t in targets:
+            query = self.embeddings[t] + rng.standard_normal(dim, dtype=np.float32) * 0.3
+            self.turns.append({
+                "embedding": query.astype(np.float64),
+                "text": " ".join(self.texts[t].split()[:5]),
+                "entities": [self.entities[t]],
+            })
+
+    @property
+    def shape_key(self) -> str:
+        return f"{len(self.ids)}x{self.embeddings.shape[1]}"
+
+
+class FixtureRepository:
+    """In-memory stand-in for ChromaDBRepository (the calls consolidate uses).
+
+    Updates and deletes are counted but not applied, so every repeat sees
+    the same store.
+    """
+
+    def __init__(self, ids, metadatas):
+        self._ids = list(ids)
+        self._metadatas = [dict(m) for m in metadatas]
+
+    def get_all(self, include=None):
+        return {"ids": self._ids, "metadatas": self._metadatas}
+
+    def batch_update_metadata(self, ids, metadatas):
+        return len(ids)
+
+    def delete(self, ids):
+        return len(ids)
+
+
+class FixtureGraph:
+    """GraphRAG stand-in answering get_connection_count from the fixture."""
+
+    def __init__(self, counts):
+        self._counts = counts
+
+    def get_connection_count(self, memory_id):
+        return self._counts.get(memory_id, 0)
+
+
+class FixtureLTM:
+    """LongTermMemory stand-in for memory_gc phase 2 over a window."""
+
+    def __init__(self, fixture: Fixture, window: int):
+        rows = slice(max(0, len(fixture.ids) - window), len(fixture.ids))
+        self._results = {
+            "ids": fixture.ids[rows],
+            "documents": fixture.texts[rows],
+            "metadatas": fixture.metadatas[rows],
+            "embeddings": fixture.embeddings[rows],
+        }
+
+    def get_all_memories(self, include=None):
+        return self._results
+
+
+# ── Phases ───────────────────────────────────────────────────────────────────
+
+
+def _epoch(iso: str) -> float:
+    return datetime.fromisoformat(iso).timestamp()
+
+
+def phase_load(fixture: Fixture, dim: int):
+    """Build a MemoryEngine from the fixture."""
+    engine = _native.memory_engine.MemoryEngine(dim)
+    metas = fixture.metadatas
+    chunk = 8192
+    for start in range(0, len(fixture.ids), chunk):
+        stop = min(len(fixture.ids), start + chunk)
+        rows = metas[start:stop]
+        engine.upsert_batch(
+            fixture.ids[start:stop],
+            fixture.embeddings[start:stop],
+            importance=np.array([m["importance"] for m in rows]),
+            event_time=np.array([_epoch(m["created_at"]) for m in rows]),
+            last_accessed=np.array([_epoch(m["last_accessed"]) if "last_accessed" in m else -1.0
+                                    for m in rows]),
+            access_count=np.array([m["access_count"] for m in rows], dtype=np.int32),
+            memory_type=np.array([MEMORY_TYPES.index(m["type"]) for m in rows], dtype=np.int32),
+            token_cost=np.array([len(m["content"]) // 4 for m in rows], dtype=np.int32),
+        )
+    for memory_id, entity, text, meta in zip(fixture.ids, fixture.entities, fixture.texts, metas):
+        engine.link_entity(memory_id, entity)
+        engine.set_topics(memory_id, [meta["type"]])
+        engine.index_text(memory_id, text)
+    for source, target in fixture.relations:
+        engine.add_relation(source, target)
+    return engine
+
+
+def phase_consolidation(repository: FixtureRepository, connection_counts):
+    """Run MemoryConsolidator over the in-memory store (which it never mutates)."""
+    from backend.memory.permanent.config import MemoryConfig
+    from backend.memory.permanent.consolidator import MemoryConsolidator
+
+    class _Config(MemoryConfig):
+        REASSESS_BATCH_SIZE = 0  # reassessment calls an LLM; not a native path
+
+    consolidator = MemoryConsolidator(repository, config=_Config)
+    with mock.patch("backend.memory.graph_rag.GraphRAG",
+                    return_value=FixtureGraph(connection_counts)):
+        return consolidator.consolidate()
+
+
+def phase_dedup(fixture: Fixture, window: int, threshold: float):
+    """memory_gc phase 2 (native path) over the most recent `window` memories."""
+    from scripts.memory_gc import _phase2_native
+
+    return _phase2_native(FixtureLTM(fixture, window), threshold)
+
+
+def build_graph(fixture: Fixture, persist_dir: str):
+    """KnowledgeGraph holding the fixture's entities and relations."""
+    from backend.memory.graph_rag.knowledge_graph import Entity, KnowledgeGraph, Relation
+
+    graph = KnowledgeGraph(persist_path=os.path.join(persist_dir, "graph.json"))
+    for i in range(fixture.n_entities):
+        graph.add_entity(Entity(id=f"entity-{i}", name=f"entity-{i}", entity_type="person"))
+    for source, target in fixture.relations:
+        graph.add_relation(Relation(source_id=source, target_id=target, relation_type="related_to"))
+    return graph
+
+
+def phase_retrieval(fixture: Fixture, engine, graph, now: float):
+    """Per turn: entity expansion plus vector top-K (no packing limit)."""
+    filters = _native.memory_engine.BuildFilters()
+    filters.candidate_count = 50
+    filters.graph_depth = 0
+    hits = 0
+    for turn in fixture.turns:
+        for entity in turn["entities"]:
+            graph.get_neighbors(entity, depth=2)
+        ids, _scores, _costs = engine.build_context(
+            turn["embedding"], [], budget=1 << 40, now=now, filters=filters)
+        hits += len(ids)
+    return hits
+
+
+def phase_context_build(fixture: Fixture, engine, now: float):
+    """Per turn: the full build_context the chat path runs."""
+    filters = _native.memory_engine.BuildFilters()
+    filters.graph_depth = 2
+    filters.max_per_topic = 5
+    filters.text_weight = 0.2
+    selected = 0
+    for turn in fixture.turns:
+        filters.query_text = turn["text"]
+        ids, _scores, _costs = engine.build_context(
+            turn["embedding"], turn["entities"], budget=4000, now=now, filters=filters)
+        selected += len(ids)
+    return selected
+
+
+# ── Measurement ──────────────────────────────────────────────────────────────
+
+
+def _kernel_ms() -> float:
+    """Total native kernel time recorded so far, in ms."""
+    return sum(s.get("kernel_ns", 0) for s in _native.stats().values()) / 1e6
+
+
+def timed(fn, repeat: int):
+    """Run fn `repeat` times; return (result, wall ms list, kernel ms list)."""
+    walls, kernels = [], []
+    result = None
+    for _ in range(repeat):
+        kernel_before = _kernel_ms()
+        start = time.perf_counter()
+        result = fn()
+        walls.append((time.perf_counter() - start) * 1000.0)
+        kernels.append(_kernel_ms() - kernel_before)
+    return result, walls, kernels
+
+
+def summarize(walls, kernels) -> dict:
+    return {
+        "median_ms": round(statistics.median(walls), 3),
+        "min_ms": round(min(walls), 3),
+        "max_ms": round(max(walls), 3),
+        "kernel_median_ms": round(statistics.median(kernels), 3),
+        "runs": len(walls),
+    }
+
+
+def run_scenario(args) -> dict:
+    print(f"Building fixture: {args.memories} memories x {args.dim} dims, "
+          f"{args.entities} entities / {args.relations} relations, {args.turns} turns")
+    start = time.perf_counter()
+    fixture = Fixture(args.memories, args.dim, args.entities, args.relations, args.turns, args.seed)
+    print(f"  fixture ready in {time.perf_counter() - start:.1f}s")
+
+    connection_counts = {}
+    degree = {}
+    for source, target in fixture.relations:
+        degree[source] = degree.get(source, 0) + 1
+        degree[target] = degree.get(target, 0) + 1
+    for memory_id, entity in zip(fixture.ids, fixture.entities):
+        connection_counts[memory_id] = degree.get(entity, 0)
+
+    _native.reset_stats()
+    phases = {}
+    now = fixture.now.timestamp()
+
+    # load runs once per repeat too, but only the last engine is kept
+    engine, walls, kernels = timed(lambda: phase_load(fixture, args.dim), args.load_repeat)
+    phases["load"] = summarize(walls, kernels)
+
+    repository = FixtureRepository(fixture.ids, fixture.metadatas)
+    report, walls, kernels = timed(
+        lambda: phase_consolidation(repository, connection_counts), args.repeat)
+    if not report.get("checked"):
+        raise RuntimeError("consolidation checked no memories; see the memory log for the error")
+    phases["consolidation"] = {**summarize(walls, kernels), "deleted": report.get("deleted", 0)}
+
+    pairs, walls, kernels = timed(
+        lambda: phase_dedup(fixture, args.dedup_window, args.dedup_threshold), args.repeat)
+    phases["dedup"] = {**summarize(walls, kernels), "duplicates": len(pairs)}
+
+    with tempfile.TemporaryDirectory() as tmp:
+        graph = build_graph(fixture, tmp)
+        hits, walls, kernels = timed(
+            lambda: phase_retrieval(fixture, engine, graph, now), args.repeat)
+    phases["retrieval"] = {**summarize(walls, kernels), "hits": hits}
+
+    selected, walls, kernels = timed(
+        lambda: phase_context_build(fixture, engine, now), args.repeat)
+    phases["context_build"] = {**summarize(walls, kernels), "selected": selected}
+
+    return {
+        "shape": fixture.shape_key,
+        "fixture": {
+            "memories": args.memories, "dim": args.dim, "entities": args.entities,
+            "relations": args.relations, "turns": args.turns, "seed": args.seed,
+            "dedup_window": args.dedup_window,
+        },
+        "environment": environment(),
+        "phases": phases,
+    }
+
+
+def environment() -> dict:
+    env = {
+        "host": platform.node(),
+        "machine": platform.machine(),
+        "python": platform.python_version(),
+        "cpus": os.cpu_count(),
+        "recorded_at": datetime.now(timezone.utc).isoformat(timespec="seconds"),
+    }
+    if _HAS_NATIVE:
+        env["simd"] = _native.simd_variant()
+        env["native_threads"] = _native.num_threads()
+    return env
+
+
+# ── Baseline ─────────────────────────────────────────────────────────────────
+
+
+def load_baseline(path: Path) -> dict:
+    if not path.exists():
+        return {"tolerance": {"default": DEFAULT_TOLERANCE}, "slack_ms": DEFAULT_SLACK_MS,
+                "shapes": {}}
+    with open(path, encoding="utf-8") as f:
+        return json.load(f)
+
+
+def compare(result: dict, baseline: dict) -> list[dict]:
+    """Check each phase against the baseline for the same shape.
+
+    Args:
+        result: run_scenario() output
+        baseline: Baseline document (tolerance, slack_ms, shapes)
+
+    Returns:
+        One row per phase: phase, median_ms, baseline_ms, limit_ms,
+        status ('ok', 'regressed', 'improved' or 'no-baseline')
+    """
+    tolerances = baseline.get("tolerance", {})
+    default_tol = tolerances.get("default", DEFAULT_TOLERANCE)
+    slack = baseline.get("slack_ms", DEFAULT_SLACK_MS)
+    recorded = baseline.get("shapes", {}).get(result["shape"], {}).get("phases", {})
+
+    rows = []
+    for phase, measured in result["phases"].items():
+        row = {"phase": phase, "median_ms": measured["median_ms"],
+               "baseline_ms": None, "limit_ms": None, "status": "no-baseline"}
+        base = recorded.get(phase)
+        if base and base.get("median_ms") is not None:
+            tol = tolerances.get(phase, default_tol)
+            limit = base["median_ms"] * (1.0 + tol) + slack
+            row.update(baseline_ms=base["median_ms"], limit_ms=round(limit, 3))
+            if measured["median_ms"] > limit:
+                row["status"] = "regressed"
+            elif measured["median_ms"] < base["median_ms"] * (1.0 - tol):
+                row["status"] = "improved"
+            else:
+                row["status"] = "ok"
+        rows.append(row)
+    return rows
+
+
+def verdict(rows: list[dict]) -> tuple[int, str]:
+    """Exit code and summary line for compared phases.
+
+    A phase without a baseline fails like a regression: an empty or stale
+    baseline must not let the gate pass.
+    """
+    missing = [row["phase"] for row in rows if row["status"] == "no-baseline"]
+    regressed = [row["phase"] for row in rows if row["status"] == "regressed"]
+    if regressed:
+        return 1, f"FAIL: regressed phases: {', '.join(regressed)}"
+    if missing:
+        return 1, (f"FAIL: no baseline for phases: {', '.join(missing)}; "
+                   "record one on the reference host with --write-baseline")
+    return 0, "PASS"
+
+
+def write_baseline(path: Path, baseline: dict, result: dict) -> None:
+    """Record this run's phase medians for its shape, keeping the others."""
+    shapes = baseline.setdefault("shapes", {})
+    shapes[result["shape"]] = {
+        "fixture": result["fixture"],
+        "environment": result["environment"],
+        "phases": {p: {"median_ms": v["median_ms"]} for p, v in result["phases"].items()},
+    }
+    with open(path, "w", encoding="utf-8") as f:
+        json.dump(baseline, f, indent=2, ensure_ascii=False)
+        f.write("\n")
+
+
+def print_report(rows: list[dict], result: dict) -> None:
+    print(f"\n{'Phase':<15} {'Median':>12} {'Kernel':>12} {'Baseline':>12} {'Limit':>12}  Status")
+    print("-" * 80)
+    for row in rows:
+        kernel = result["phases"][row["phase"]]["kernel_median_ms"]
+        base = f"{row['baseline_ms']:.1f}" if row["baseline_ms"] is not None else "-"
+        limit = f"{row['limit_ms']:.1f}" if row["limit_ms"] is not None else "-"
+        print(f"{row['phase']:<15} {row['median_ms']:>10.1f}ms {kernel:>10.1f}ms "
+              f"{base:>12} {limit:>12}  {row['status'].upper()}")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="End-to-end native regression benchmark",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog=__doc__.split("Usage:", 1)[1],
+    )
+    parser.add_argument("--ci", action="store_true",
+                        help="Use the CI fixture shape (overrides the size options)")
+    parser.add_argument("--memories", type=int, default=100_000)
+    parser.add_argument("--dim", type=int, default=3072)
+    parser.add_argument("--entities", type=int, default=10_000)
+    parser.add_argument("--relations", type=int, default=50_000)
+    parser.add_argument("--turns", type=int, default=200, help="Interaction-log turns replayed")
+    parser.add_argument("--seed", type=int, default=20240917)
+    parser.add_argument("--repeat", type=int, default=5, help="Runs per phase (median reported)")
+    parser.add_argument("--load-repeat", type=int, default=1, help="Runs of the load phase")
+    parser.add_argument("--dedup-window", type=int, default=2000,
+                        help="Most recent memories compared pairwise in the dedup phase")
+    parser.add_argument("--dedup-threshold", type=float, default=0.9)
+    parser.add_argument("--baseline", type=Path, default=BASELINE_PATH)
+    parser.add_argument("--write-baseline", action="store_true",
+                        help="Record this run as the baseline for its fixture shape")
+    parser.add_argument("--out", type=Path, help="Write the run report as JSON")
+    args = parser.parse_args()
+    if args.ci:
+        for name, value in CI_SHAPE.items():
+            setattr(args, name, value)
+
+    if not _HAS_NATIVE:
+        print("axnmihn_native is not importable; build backend/native first.")
+        return 2
+
+    result = run_scenario(args)
+    baseline = load_baseline(args.baseline)
+    rows = compare(result, baseline)
+    print_report(rows, result)
+
+    if args.out:
+        with open(args.out, "w", encoding="utf-8") as f:
+            json.dump({**result, "comparison": rows}, f, indent=2, ensure_ascii=False)
+
+    if args.write_baseline:
+        write_baseline(args.baseline, baseline, result)
+        print(f"\nBaseline for {result['shape']} written to {args.baseline}")
+        return 0
+
+    code, summary = verdict(rows)
+    print(f"\n{summary}")
+    return code
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -3,12 +3,14 @@
 
 Cleans both SQLite and ChromaDB stores:
 - Phase 1: Delete long/code-heavy conversation turns from SQLite
+- Phase 1N: Delete turns a later turn nearly repeats (SimHash, no embeddings)
 - Phase 2: Replace role labels in ChromaDB (User->Mark, Assistant/AI->Axel)
 - Phase 3: Text cleaning via OpenAI API (emoji removal, spell check, etc.)
 - Phase 4: Verification
 
 Usage:
     python scripts/optimize_memory.py phase1 --dry-run
+    python scripts/optimize_memory.py neardup --dry-run
     python scripts/optimize_memory.py phase2 --dry-run
     python scripts/optimize_memory.py phase3 --dry-run --limit 10
     python scripts/optimize_memory.py all --dry-run
@@ -46,6 +48,7 @@ logging.basicConfig(
 logger = logging.getLogger(__name__)
 
 PROJECT_ROOT = Path(__file__).parent.parent
+sys.path.insert(0, str(PROJECT_ROOT))
 DATA_ROOT = PROJECT_ROOT / "data"
 DB_PATH = DATA_ROOT / "sqlite" / "sqlite_memory.db"
 CHROMADB_PATH = DATA_ROOT / "chroma_db"
@@ -341,6 +344,86 @@ def phase1_delete_long_turns(dry_run: bool = False) -> dict:
     }
 
 
+# ======================================================================
+# Phase 1N: SQLite — near-duplicate turn removal
+# ======================================================================
+
+NEAR_DUP_MAX_DISTANCE = 6
+
+
+def phase1n_near_duplicate_turns(dry_run: bool = False) -> dict:
+    """Delete turns that a later turn in the same session nearly repeats.
+
+    Retries and edited resends leave near-identical Mark/Axel turns that
+    have no embeddings. Each turn (Mark + Axel text) gets a SimHash
+    fingerprint; of each chain of near-duplicates within a session only
+    the latest turn is kept. Non-neutral emotional turns are protected.
+
+    Returns:
+        Stats dict with counts.
+    """
+    # Imported here so the other phases don't load the backend package
+    from backend.core.utils.simhash import superseded_near_duplicates
+
+    conn = sqlite3.connect(DB_PATH)
+    cursor = conn.cursor()
+
+    cursor.execute(
+        """
+        SELECT m_axel.session_id, m_mark.id, m_axel.id,
+               m_mark.content, m_axel.content, m_axel.emotional_context
+        FROM messages m_axel
+        JOIN messages m_mark ON m_mark.session_id = m_axel.session_id
+            AND m_mark.turn_id = m_axel.turn_id - 1
+            AND m_mark.role = 'Mark'
+        WHERE m_axel.role = 'Axel'
+        ORDER BY m_axel.session_id, m_axel.turn_id
+        """
+    )
+    turns_by_session: dict[str, list[tuple]] = {}
+    for row in cursor.fetchall():
+        turns_by_session.setdefault(row[0], []).append(row)
+
+    target_ids: list[int] = []
+    target_turns = 0
+    protected_emotional = 0
+    for turns in turns_by_session.values():
+        texts = [f"{mark or ''}\n{axel or ''}" for _, _, _, mark, axel, _ in turns]
+        for i in superseded_near_duplicates(texts, NEAR_DUP_MAX_DISTANCE):
+            _, mark_id, axel_id, _, axel, emotional_ctx = turns[i]
+            if emotional_ctx and emotional_ctx.lower() != "neutral":
+                protected_emotional += 1
+                continue
+            target_turns += 1
+            target_ids.extend((mark_id, axel_id))
+            if dry_run and target_turns <= 5:
+                preview = (axel or "")[:100].replace("\n", " ")
+                logger.info("  [DRY-RUN] Would delete superseded turn Axel id=%d: %s...",
+                            axel_id, preview)
+
+    logger.info(
+        "Phase 1N — Superseded turns: %d, Protected (emotional): %d",
+        target_turns,
+        protected_emotional,
+    )
+
+    if not target_ids or dry_run:
+        conn.close()
+        result = {"deleted_turns": target_turns, "deleted_messages": 0}
+        if dry_run:
+            result["dry_run"] = True
+        return result
+
+    placeholders = ",".join("?" * len(target_ids))
+    cursor.execute(f"DELETE FROM messages WHERE id IN ({placeholders})", target_ids)
+    deleted = cursor.rowcount
+    conn.commit()
+    conn.close()
+    logger.info("Phase 1N — Deleted %d messages (%d turns)", deleted, target_turns)
+
+    return {"deleted_turns": target_turns, "deleted_messages": deleted}
+
+
 # ======================================================================
 # Phase 2: ChromaDB — role label replacement
 # ======================================================================
@@ -1041,6 +1124,7 @@ def main() -> None:
 Examples:
   python scripts/optimize_memory.py phase1 --dry-run
   python scripts/optimize_memory.py phase1
+  python scripts/optimize_memory.py neardup --dry-run
   python scripts/optimize_memory.py phase2 --dry-run
   python scripts/optimize_memory.py phase2
   python scripts/optimize_memory.py phase3 --dry-run
@@ -1053,7 +1137,7 @@ Examples:
     )
     parser.add_argument(
         "phase",
-        choices=["phase1", "phase2", "phase3", "strip", "all", "verify"],
+        choices=["phase1", "neardup", "phase2", "phase3", "strip", "all", "verify"],
         help="Which phase to run",
     )
     parser.add_argument(
@@ -1084,7 +1168,7 @@ Examples:
     phases_to_run: list[str] = []
 
     if args.phase == "all":
-        phases_to_run = ["phase1", "phase2", "strip"]
+        phases_to_run = ["phase1", "neardup", "phase2", "strip"]
     elif args.phase == "verify":
         phases_to_run = ["verify"]
     else:
@@ -1097,6 +1181,12 @@ Examples:
             logger.info("=" * 60)
             all_results["phase1"] = phase1_delete_long_turns(dry_run=args.dry_run)
 
+        elif phase == "neardup":
+            logger.info("=" * 60)
+            logger.info("Phase 1N: Delete near-duplicate turns from SQLite")
+            logger.info("=" * 60)
+            all_results["neardup"] = phase1n_near_duplicate_turns(dry_run=args.dry_run)
+
         elif phase == "phase2":
             logger.info("=" * 60)
             logger.info("Phase 2: Replace role labels in ChromaDB")
@@ -1163,6 +1253,9 @@ Examples:
             p1 = all_results["phase1"]
             print(f"  Phase 1: {p1.get('deleted_turns', 0)} turns deleted, "
                   f"{p1.get('orphans_deleted', 0)} orphans")
+        if "neardup" in all_results:
+            nd = all_results["neardup"]
+            print(f"  Phase 1N: {nd.get('deleted_turns', 0)} near-duplicate turns deleted")
         if "phase2" in all_results:
             p2 = all_results["phase2"]
             print(f"  Phase 2: {p2.get('changed', 0)} labels changed, "
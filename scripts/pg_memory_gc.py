@@ -13,7 +13,6 @@
 """
 
 import argparse
-import hashlib
 import logging
 import os
 import re
@@ -32,6 +31,7 @@ else:
 import psycopg2
 
 from backend.config import DATABASE_URL, DEFAULT_GEMINI_MODEL
+from backend.core.utils.content_hash import content_hash, duplicate_groups
 
 logging.getLogger("httpx").setLevel(logging.WARNING)
 logging.getLogger("google.genai").setLevel(logging.WARNING)
@@ -78,10 +78,13 @@ def remove_emoji(text: str) -> str:
     return _EMOJI_RE.sub("", text)
 
 
+# Dedup normalization: whitespace-collapsed, case-folded, first 500 chars
+_DEDUP_NORMALIZE = {"collapse_whitespace": True, "casefold": True, "max_chars": 500}
+
+
 def _content_hash(content: str) -> str:
-    """SHA-256 hash of normalized content for dedup."""
-    normalized = content.strip().lower()[:500]
-    return hashlib.sha256(normalized.encode()).hexdigest()
+    """XXH3-128 hash of normalized content for dedup."""
+    return content_hash(content, **_DEDUP_NORMALIZE)
 
 
 # ── KeyRotator ───────────────────────────────────────────────────────────────
@@ -288,7 +291,7 @@ def phase2_llm_summarize(conn, dry_run: bool = False) -> dict:
 
 
 def phase3_hash_dedup(conn, dry_run: bool = False) -> dict:
-    """Phase 3: Remove duplicate memories by SHA-256 content hash."""
+    """Phase 3: Remove duplicate memories by normalized content hash."""
     print("\n[Phase 3] Hash dedup...")
 
     with conn.cursor() as cur:
@@ -297,17 +300,14 @@ def phase3_hash_dedup(conn, dry_run: bool = False) -> dict:
 
     print(f"  Total memories: {len(rows)}")
 
-    hash_groups: dict[str, list] = {}
-    for uuid_val, content, importance in rows:
-        h = _content_hash(content or "")
-        hash_groups.setdefault(h, []).append((uuid_val, importance or 0.5))
+    groups = duplicate_groups([content or "" for _, content, _ in rows], **_DEDUP_NORMALIZE)
 
     to_delete = []
-    for h, entries in hash_groups.items():
-        if len(entries) > 1:
-            entries.sort(key=lambda x: x[1], reverse=True)
-            for uuid_val, _ in entries[1:]:
-                to_delete.append(uuid_val)
+    for group in groups:
+        entries = [(rows[i][0], rows[i][2] or 0.5) for i in group]
+        entries.sort(key=lambda x: x[1], reverse=True)
+        for uuid_val, _ in entries[1:]:
+            to_delete.append(uuid_val)
 
     print(f"  Duplicates found: {len(to_delete)}")
 
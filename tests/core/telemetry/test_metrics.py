@@ -7,6 +7,7 @@ from backend.core.telemetry.metrics import (
     Gauge,
     Histogram,
     MetricsRegistry,
+    format_native_stats,
 )
 
 
@@ -125,3 +126,41 @@ class TestMetricsRegistry:
         text = reg.format_all()
         assert "requests 10" in text
         assert "conns 5" in text
+
+    def test_collectors_appended(self):
+        reg = MetricsRegistry()
+        reg.counter("requests", "Requests").inc()
+        reg.register_collector(lambda: "extra_metric 7")
+        reg.register_collector(lambda: "")
+        text = reg.format_all()
+        assert text.endswith("extra_metric 7")
+
+
+class TestNativeStats:
+
+    STATS = {
+        "vector_ops.cosine_similarity_batch": {
+            "calls": 3, "elements": 300, "bytes_in": 2400, "bytes_out": 2400,
+            "total_ns": 3_000_000, "kernel_ns": 2_500_000, "max_ns": 1_500_000,
+            "p50_ns": 800_000, "p90_ns": 1_500_000, "p99_ns": 1_500_000,
+            "buckets": [(5_000, 1), (800_000, 1), (1_500_000, 1)],
+        },
+    }
+
+    def test_empty(self):
+        assert format_native_stats({}) == ""
+
+    def test_counters(self):
+        text = format_native_stats(self.STATS)
+        assert 'axnmihn_native_calls_total{fn="vector_ops.cosine_similarity_batch"} 3' in text
+        assert 'axnmihn_native_elements_total{fn="vector_ops.cosine_similarity_batch"} 300' in text
+        assert 'axnmihn_native_kernel_seconds_total{fn="vector_ops.cosine_similarity_batch"} 0.0025' in text
+
+    def test_histogram_buckets_cumulative(self):
+        text = format_native_stats(self.STATS)
+        name = "axnmihn_native_call_duration_seconds"
+        fn = 'fn="vector_ops.cosine_similarity_batch"'
+        assert f'{name}_bucket{{{fn},le="1e-05"}} 1' in text
+        assert f'{name}_bucket{{{fn},le="0.001"}} 2' in text
+        assert f'{name}_bucket{{{fn},le="0.01"}} 3' in text
+        assert f'{name}_count{{{fn}}} 3' in text
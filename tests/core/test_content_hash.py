@@ -0,0 +1,74 @@
+"""Tests for backend.core.utils.content_hash."""
+
+import pytest
+
+from backend.core.utils import content_hash as ch
+
+
+@pytest.fixture(params=[True, False], ids=["native", "python"])
+def impl(request, monkeypatch):
+    """Run each test on the native path (when available) and the Python path."""
+    if request.param and not ch._HAS_NATIVE:
+        pytest.skip("Native module not available")
+    monkeypatch.setattr(ch, "_HAS_NATIVE", request.param)
+    return ch
+
+
+class TestNormalizeText:
+    def test_identity_by_default(self):
+        assert ch.normalize_text("  A  b ") == "  A  b "
+
+    def test_collapse_whitespace(self):
+        assert ch.normalize_text(" a \t\n b　c ", collapse_whitespace=True) == "a b c"
+
+    def test_casefold_full_unicode(self):
+        assert ch.normalize_text("HeLLo É Straße", casefold=True) == "hello é strasse"
+
+    def test_nfkc_runs_before_collapse(self):
+        assert ch.normalize_text("ｆｉｌｅ　 ﬁ", collapse_whitespace=True, nfkc=True) == "file fi"
+
+    def test_truncates_after_normalizing(self):
+        assert ch.normalize_text("  ab   cd", collapse_whitespace=True, max_chars=4) == "ab c"
+
+
+class TestContentHash:
+    def test_hex_digest(self, impl):
+        digest = impl.content_hash("hello")
+        assert len(digest) == 32
+        int(digest, 16)
+
+    def test_same_content_same_hash(self, impl):
+        assert impl.content_hash("hello world") == impl.content_hash("hello world")
+
+    def test_normalization(self, impl):
+        a = impl.content_hash(" Hello   World ", collapse_whitespace=True, casefold=True)
+        b = impl.content_hash("hello world", collapse_whitespace=True, casefold=True)
+        assert a == b
+        assert impl.content_hash(" Hello   World ") != impl.content_hash("hello world")
+
+    def test_different_content_different_hash(self, impl):
+        assert impl.content_hash("hello") != impl.content_hash("world")
+
+    def test_hash64_stable(self, impl):
+        assert impl.hash64("key") == impl.hash64("key")
+        assert impl.hash64("key") != impl.hash64("other")
+        assert 0 <= impl.hash64("key") < 2**64
+
+    @pytest.mark.skipif(ch._xxhash is None, reason="xxhash not installed")
+    def test_native_and_python_agree(self):
+        if not ch._HAS_NATIVE:
+            pytest.skip("Native module not available")
+        assert ch.content_hash("memory") == f"{ch._xxhash.xxh3_128_intdigest(b'memory'):032x}"
+
+
+class TestDuplicateGroups:
+    def test_groups_ordered_by_first_index(self, impl):
+        texts = ["b", "a", "c", "a", "b", "a"]
+        assert impl.duplicate_groups(texts) == [[0, 4], [1, 3, 5]]
+
+    def test_no_duplicates(self, impl):
+        assert impl.duplicate_groups(["a", "b", "c"]) == []
+
+    def test_normalized(self, impl):
+        texts = ["Same text", "same   TEXT", "other"]
+        assert impl.duplicate_groups(texts, collapse_whitespace=True, casefold=True) == [[0, 1]]
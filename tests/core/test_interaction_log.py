@@ -2,9 +2,12 @@
 
 import pytest
 from backend.core.telemetry.interaction_log import (
+    _HAS_NATIVE_LOG,
     InteractionLog,
+    InteractionLogWriter,
     log_interaction,
     query_interactions,
+    read_interaction_columns,
 )
 
 
@@ -52,3 +55,30 @@ class TestInteractionLog:
         )
         row_id = log_interaction(initialized_db, log)
         assert row_id > 0
+
+
+@pytest.mark.skipif(not _HAS_NATIVE_LOG, reason="Native module not available")
+class TestInteractionLogWriter:
+
+    def test_append_flush_read(self, tmp_path):
+        writer = InteractionLogWriter(tmp_path, fsync_interval_ms=10)
+        for i in range(5):
+            assert writer.append(
+                InteractionLog(
+                    session_id="s1",
+                    effective_model="gemini",
+                    latency_ms=100 + i,
+                    tool_calls=["search"] if i % 2 else [],
+                    turn_id=i,
+                ),
+                timestamp=1000.0 + i,
+            )
+        writer.flush()
+        assert writer.stats["written"] == 5
+
+        cols = read_interaction_columns(tmp_path, since=1002.0)
+        assert list(cols["latency_ms"]) == [102, 103, 104]
+        assert list(cols["tool_call_count"]) == [0, 1, 0]
+        codes, dictionary = cols["session_id"]
+        assert [dictionary[c] for c in codes] == ["s1"] * 3
+        writer.close()
@@ -0,0 +1,111 @@
+"""Tests for backend.core.utils.simhash."""
+
+import random
+
+import pytest
+
+from backend.core.utils import content_hash as ch
+from backend.core.utils import simhash as sh
+
+BASE = (
+    "I think we should move the deployment to Thursday because the staging "
+    "database migration still needs another review pass, and Mark wants to "
+    "double check the rollback script before anything touches production. "
+    "Let me know if that works for everyone on the team, otherwise we can "
+    "talk about it tomorrow morning during the usual standup meeting."
+)
+OTHER = (
+    "The weather in Vancouver has been rainy all week, so the hiking trip is "
+    "postponed until the trails dry out and the forecast looks better for the "
+    "weekend after next. Bring the new boots anyway, and remember the permit "
+    "for the campsite near the lake that we booked last month with Sarah."
+)
+
+
+@pytest.fixture(params=[True, False], ids=["native", "python"])
+def impl(request, monkeypatch):
+    """Run each test on the native path (when available) and the Python path."""
+    if request.param and not sh._HAS_NATIVE:
+        pytest.skip("Native module not available")
+    monkeypatch.setattr(sh, "_HAS_NATIVE", request.param)
+    return sh
+
+
+class TestFingerprint:
+    def test_empty_is_zero(self, impl):
+        assert impl.fingerprint("") == 0
+        assert impl.fingerprint("   \n ") == 0
+
+    def test_normalized_before_shingling(self, impl):
+        assert impl.fingerprint("  Hello   WORLD again ") == impl.fingerprint("hello world again")
+
+    def test_small_edit_is_near(self, impl):
+        edited = BASE.replace("Thursday", "Friday")
+        assert impl.hamming(impl.fingerprint(BASE), impl.fingerprint(edited)) <= 6
+
+    def test_unrelated_is_far(self, impl):
+        assert impl.hamming(impl.fingerprint(BASE), impl.fingerprint(OTHER)) > 12
+
+    def test_char_shingles(self, impl):
+        a = impl.fingerprint(BASE, kind="char", shingle_size=4)
+        b = impl.fingerprint(BASE + "!", kind="char", shingle_size=4)
+        assert impl.hamming(a, b) <= 6
+
+    def test_invalid_kind(self, impl):
+        with pytest.raises(ValueError):
+            impl.fingerprints(["x"], kind="line")
+
+    @pytest.mark.skipif(not sh._HAS_NATIVE, reason="Native module not available")
+    @pytest.mark.skipif(ch._xxhash is None, reason="xxhash not installed")
+    def test_python_matches_native(self):
+        texts = [BASE, OTHER, "short", "안녕하세요 반가워요 오늘 날씨"]
+        for kind, k in (("word", 2), ("char", 4)):
+            native = sh.fingerprints(texts, kind, k)
+            python = [sh._fingerprint_py(t, kind, k) for t in texts]
+            assert native == python
+
+
+class TestSimHashIndex:
+    @pytest.mark.parametrize("use_native", [True, False])
+    def test_matches_brute_force(self, use_native):
+        if use_native and not sh._HAS_NATIVE:
+            pytest.skip("Native module not available")
+        rng = random.Random(11)
+        fps = []
+        for _ in range(300):
+            if fps and rng.random() < 0.4:
+                fp = rng.choice(fps)
+                for _ in range(rng.randint(0, 8)):
+                    fp ^= 1 << rng.randrange(64)
+            else:
+                fp = rng.getrandbits(64)
+            fps.append(fp)
+
+        index = sh.SimHashIndex(max_distance=4, use_native=use_native)
+        assert index.is_native == use_native
+        for i, fp in enumerate(fps):
+            fp_id, matches = index.add_and_query(fp)
+            assert fp_id == i
+            expected = sorted(
+                ((j, sh.hamming(fp, fps[j])) for j in range(i) if sh.hamming(fp, fps[j]) <= 4),
+                key=lambda m: (m[1], m[0]),
+            )
+            assert [tuple(m) for m in matches] == expected
+        assert len(index) == len(fps)
+
+    def test_invalid_distance(self):
+        with pytest.raises(ValueError):
+            sh.SimHashIndex(max_distance=64, use_native=False)
+
+
+class TestNearDuplicates:
+    def test_groups(self, impl):
+        texts = [BASE, OTHER, BASE.replace("Thursday", "Friday"), "tiny", OTHER + " Thanks!"]
+        assert impl.near_duplicate_groups(texts) == [[0, 2], [1, 4]]
+
+    def test_superseded_keeps_latest(self, impl):
+        texts = [BASE, OTHER, BASE.replace("Thursday", "Friday"), OTHER + " Thanks!"]
+        assert impl.superseded_near_duplicates(texts) == [0, 1]
+
+    def test_short_texts_ignored(self, impl):
+        assert impl.superseded_near_duplicates(["ok", "ok", "ok"]) == []
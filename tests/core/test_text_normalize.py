@@ -0,0 +1,41 @@
+"""Tests for backend.core.utils.text_normalize."""
+
+import pytest
+
+from backend.core.utils import text_normalize as tn
+
+
+@pytest.fixture(params=[True, False], ids=["native", "python"])
+def impl(request, monkeypatch):
+    """Run each test on the native path (when available) and the Python path."""
+    if request.param and not tn._HAS_NATIVE:
+        pytest.skip("Native module not available")
+    monkeypatch.setattr(tn, "_HAS_NATIVE", request.param)
+    return tn
+
+
+class TestNormalizeText:
+    def test_identity_by_default(self):
+        assert tn.normalize_text(" Ｆ  ß ") == " Ｆ  ß "
+
+    def test_order_nfkc_fold_collapse_truncate(self):
+        text = " ＡＢ　 Straße "
+        assert tn.normalize_text(text, True, True, 6, nfkc=True) == "ab str"
+
+
+class TestTextKey:
+    def test_width_case_and_whitespace(self, impl):
+        assert impl.text_key("  ＪＯＨＮ   Doe ") == impl.text_key("john doe") == "john doe"
+
+    def test_full_casefold(self, impl):
+        assert impl.text_key("STRASSE") == impl.text_key("Straße")
+
+    def test_composed_and_decomposed_match(self, impl):
+        assert impl.text_key("Cafe\u0301") == impl.text_key("Caf\u00e9")
+
+    def test_max_chars(self, impl):
+        assert impl.text_key("ﬁle NAME", max_chars=4) == "file"
+
+    def test_keys_batch(self, impl):
+        names = [f"Ｎａｍｅ {i}" for i in range(100)] + ["Straße"]
+        assert impl.text_keys(names) == [f"name {i}" for i in range(100)] + ["strasse"]
@@ -0,0 +1,147 @@
+"""Tests for backend.memory.pg.columnar — binary COPY loading.
+
+copy_to is mocked to replay a COPY stream built with struct, split into
+small messages the way psycopg2 delivers CopyData.
+"""
+
+import struct
+from unittest.mock import MagicMock
+
+import numpy as np
+import pytest
+
+from backend.memory.pg import columnar
+
+needs_native = pytest.mark.skipif(not columnar.available(),
+                                  reason="Native module not available")
+
+_PG_EPOCH = 946684800
+
+
+def _field(data):
+    if data is None:
+        return struct.pack(">i", -1)
+    return struct.pack(">i", len(data)) + data
+
+
+def _copy_stream(rows, dim):
+    out = b"PGCOPY\n\xff\r\n\x00" + struct.pack(">ii", 0, 0)
+    for uuid, mtype, importance, access, created, last, emb in rows:
+        fields = [
+            uuid.encode(),
+            mtype.encode(),
+            struct.pack(">d", importance),
+            struct.pack(">i", access),
+            struct.pack(">q", int((created - _PG_EPOCH) * 1e6)),
+            None if last is None else struct.pack(">q", int((last - _PG_EPOCH) * 1e6)),
+            struct.pack(">i", len(uuid) // 4),
+        ]
+        if dim:
+            fields.append(None if emb is None else
+                          struct.pack(">hh", dim, 0) + np.asarray(emb, ">f2").tobytes())
+        out += struct.pack(">h", len(fields)) + b"".join(_field(f) for f in fields)
+    return out + struct.pack(">h", -1)
+
+
+def _rows(n, dim, seed=0):
+    rng = np.random.default_rng(seed)
+    return [
+        (f"00000000-0000-0000-0000-{i:012d}", ["fact", "insight", "conversation"][i % 3],
+         0.1 + 0.01 * i, i, 1.7e9 + 60 * i, None if i % 4 == 0 else 1.7e9 + 90 * i,
+         None if i % 5 == 0 else rng.normal(0, 0.1, dim))
+        for i in range(n)
+    ]
+
+
+def _conn_mgr(stream, chunk=7):
+    mgr = MagicMock()
+
+    def _copy_to(sql, sink):
+        for start in range(0, len(stream), chunk):
+            sink.write(stream[start:start + chunk])
+
+    mgr.copy_to = MagicMock(side_effect=_copy_to)
+    return mgr
+
+
+class TestCopyQuery:
+
+    def test_columns_and_embedding_cast(self):
+        sql = columnar.copy_query(3072, "halfvec")
+        assert sql.startswith("COPY (SELECT uuid::text, memory_type::text, importance::float8")
+        assert "last_accessed::timestamptz, (length(content) / 4)::int4" in sql
+        assert "embedding::halfvec(3072)" in sql
+        assert sql.endswith("TO STDOUT (FORMAT binary)")
+        assert "LIMIT" not in sql
+
+    def test_without_embeddings_and_limit(self):
+        sql = columnar.copy_query(0, limit=100)
+        assert "embedding" not in sql
+        assert "ORDER BY created_at DESC LIMIT 100" in sql
+
+    def test_rejects_unknown_type(self):
+        with pytest.raises(ValueError):
+            columnar.copy_query(8, "sparsevec")
+
+
+class TestBatchSink:
+
+    def test_hands_over_full_batches(self):
+        loader = MagicMock()
+        loader.__len__.side_effect = [1, 2, 1]
+        batches = []
+        sink = columnar._BatchSink(loader, 2, batches.append)
+        assert sink.write(b"abc") == 3
+        sink.write(b"d")
+        sink.write(b"e")
+        assert loader.feed.call_count == 3
+        assert batches == [loader.take.return_value]
+
+
+class TestWithoutNative:
+
+    def test_raises(self, monkeypatch):
+        monkeypatch.setattr(columnar, "_HAS_NATIVE", False)
+        mgr = MagicMock()
+        with pytest.raises(RuntimeError):
+            columnar.load_columns(mgr, dim=4)
+        mgr.copy_to.assert_not_called()
+
+
+@needs_native
+class TestLoad:
+
+    def test_load_columns(self):
+        dim = 16
+        rows = _rows(23, dim)
+        mgr = _conn_mgr(_copy_stream(rows, dim))
+        cols = columnar.load_columns(mgr, dim=dim)
+
+        assert "halfvec(16)" in mgr.copy_to.call_args[0][0]
+        assert len(cols) == 23 and cols.dim == dim
+        assert cols.ids == [r[0] for r in rows]
+        np.testing.assert_allclose(cols.importance, [r[2] for r in rows])
+        np.testing.assert_array_equal(cols.access_count, [r[3] for r in rows])
+        np.testing.assert_allclose(cols.created_at, [r[4] for r in rows])
+        np.testing.assert_allclose(cols.last_accessed, [-1 if r[5] is None else r[5] for r in rows])
+        np.testing.assert_array_equal(cols.memory_type, [[1, 3, 0][i % 3] for i in range(23)])
+        np.testing.assert_array_equal(cols.token_cost, [len(r[0]) // 4 for r in rows])
+        np.testing.assert_array_equal(cols.has_embedding, [r[6] is not None for r in rows])
+        for i, r in enumerate(rows):
+            expected = np.zeros(dim) if r[6] is None else np.asarray(r[6], np.float16)
+            np.testing.assert_array_equal(cols.embeddings[i], expected.astype(np.float32))
+
+    def test_stream_columns_in_batches(self):
+        dim = 8
+        rows = _rows(25, dim, seed=1)
+        batches = []
+        total = columnar.stream_columns(_conn_mgr(_copy_stream(rows, dim), chunk=13),
+                                        batches.append, batch_rows=10, dim=dim)
+        assert total == 25
+        assert [len(b) for b in batches] == [10, 10, 5]
+        assert sum((b.ids for b in batches), []) == [r[0] for r in rows]
+
+    def test_truncated_stream_raises(self):
+        stream = _copy_stream(_rows(3, 4), 4)
+        with pytest.raises(ValueError):
+            columnar.load_columns(_conn_mgr(stream[:-2]), dim=4)
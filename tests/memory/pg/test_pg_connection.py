@@ -4,6 +4,7 @@ Covers:
 - __init__ pool creation and error handling
 - get_connection context manager (commit / rollback / putconn)
 - execute, execute_one, execute_dict, execute_many convenience methods
+- copy_to streaming into a sink
 - health_check success and failure
 - close idempotent behavior
 """
@@ -207,6 +208,16 @@ class TestExecuteMany:
         assert result == 3
 
 
+class TestCopyTo:
+
+    def test_streams_into_sink(self, mock_conn_mgr, fake_pool):
+        sink = MagicMock()
+        sql = "COPY (SELECT 1) TO STDOUT (FORMAT binary)"
+        mock_conn_mgr.copy_to(sql, sink)
+        fake_pool._cursor.copy_expert.assert_called_once_with(sql, sink)
+        fake_pool._conn.commit.assert_called_once()
+
+
 # ============================================================================
 # health_check
 # ============================================================================
@@ -16,6 +16,7 @@ Covers:
 
 from unittest.mock import MagicMock, patch
 
+import numpy as np
 import pytest
 
 from backend.memory.pg.memory_repository import PgMemoryRepository
@@ -95,6 +96,7 @@ class TestAdd:
         params = args[0][1]
         assert params[2] == "insight"  # type
         assert params[3] == 0.5  # importance
+        assert params[4] in ("[1]", "[1.0]")  # embedding as pgvector text
 
 
 # ============================================================================
@@ -117,7 +119,17 @@ class TestGetAll:
         repo._conn.execute_dict.return_value = [sample_row]
         result = repo.get_all(include=["documents", "metadatas", "embeddings"])
         assert "embeddings" in result
-        assert result["embeddings"] == ["[0.1, 0.2]"]
+        assert len(result["embeddings"]) == 1
+        np.testing.assert_array_equal(
+            result["embeddings"][0], np.array([0.1, 0.2], dtype=np.float32)
+        )
+
+    def test_get_all_embeddings_keep_nulls(self, repo, sample_row):
+        missing = dict(sample_row, uuid="def-456", embedding=None)
+        repo._conn.execute_dict.return_value = [sample_row, missing]
+        result = repo.get_all(include=["embeddings"])
+        assert result["embeddings"][0].dtype == np.float32
+        assert result["embeddings"][1] is None
 
     def test_get_all_empty_include_defaults_to_docs_and_meta(self, repo, sample_row):
         """Empty list is falsy, so include defaults to ['documents', 'metadatas']."""
@@ -183,6 +195,12 @@ class TestQueryByEmbedding:
         results = repo.query_by_embedding(embedding=[0.1], n_results=10)
         assert results == []
 
+    def test_sends_compact_vector_text(self, repo):
+        repo._conn.execute_dict.return_value = []
+        repo.query_by_embedding(embedding=[0.1, -2.5, 1e-5], n_results=3)
+        params = repo._conn.execute_dict.call_args[0][1]
+        assert params[0] == "[0.1,-2.5,1e-05]"
+
     def test_with_where_filter(self, repo, sample_row):
         sample_row["similarity"] = 0.8
         repo._conn.execute_dict.return_value = [sample_row]
@@ -0,0 +1,78 @@
+"""Tests for backend.memory.pg.vector_codec — pgvector text encoding.
+
+Each test runs against the native codec (when built) and the NumPy
+fallback, which must agree value for value.
+"""
+
+import numpy as np
+import pytest
+
+from backend.memory.pg import vector_codec
+
+
+@pytest.fixture(params=["native", "python"])
+def codec(request, monkeypatch):
+    if request.param == "native":
+        if not vector_codec._HAS_NATIVE:
+            pytest.skip("Native module not available")
+    else:
+        monkeypatch.setattr(vector_codec, "_HAS_NATIVE", False)
+    return vector_codec
+
+
+def _embedding(dim=3072, seed=0):
+    return np.random.default_rng(seed).normal(0, 0.02, dim)
+
+
+class TestToText:
+
+    def test_round_trips_float32(self, codec):
+        x = _embedding()
+        text = codec.to_text(x.tolist())
+        assert text.startswith("[") and text.endswith("]")
+        parsed = np.array(text[1:-1].split(","), dtype=np.float32)
+        np.testing.assert_array_equal(parsed, x.astype(np.float32))
+
+    def test_shorter_than_list_repr(self, codec):
+        x = _embedding().tolist()
+        assert len(codec.to_text(x)) < 0.7 * len(str(x))
+
+    def test_rejects_non_finite(self, codec):
+        with pytest.raises(ValueError):
+            codec.to_text([0.1, float("nan")])
+        with pytest.raises(ValueError):
+            codec.to_text([])
+
+    def test_rows(self, codec):
+        rows = [_embedding(16, seed=s) for s in range(3)]
+        assert codec.to_text_rows(rows) == [codec.to_text(r) for r in rows]
+        assert codec.to_text_rows([]) == []
+
+
+class TestFromText:
+
+    def test_parses_server_and_repr_forms(self, codec):
+        x = _embedding(seed=1)
+        for text in (codec.to_text(x), str(x.tolist())):
+            values = codec.from_text(text)
+            assert values.dtype == np.float32
+            np.testing.assert_array_equal(values, x.astype(np.float32))
+
+    def test_null_and_sequences(self, codec):
+        assert codec.from_text(None) is None
+        np.testing.assert_array_equal(codec.from_text([1.0, 2.0]), [1.0, 2.0])
+
+    def test_malformed(self, codec):
+        for text in ("1,2", "[]", "[1,x]"):
+            with pytest.raises(ValueError):
+                codec.from_text(text)
+
+    def test_rows_keep_nulls(self, codec):
+        texts = [codec.to_text(_embedding(8, seed=s)) for s in range(3)]
+        rows = codec.from_text_rows([texts[0], None, texts[1], texts[2]])
+        assert rows[1] is None
+        np.testing.assert_array_equal(rows[2], codec.from_text(texts[1]))
+
+    def test_rows_mixed_dimensions(self, codec):
+        rows = codec.from_text_rows(["[1,2]", "[3]"])
+        assert [r.tolist() for r in rows] == [[1.0, 2.0], [3.0]]
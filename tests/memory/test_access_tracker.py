@@ -0,0 +1,81 @@
+"""Tests for AccessTracker: coalesced access accumulation and batched flush."""
+
+from datetime import datetime
+from unittest.mock import MagicMock
+
+import pytest
+
+from backend.memory.permanent.access_tracker import AccessTracker
+
+
+def _make_tracker(use_native, **kwargs):
+    repo = MagicMock()
+    repo.batch_update_metadata.side_effect = lambda ids, metas: len(ids)
+    return AccessTracker(repository=repo, use_native=use_native, **kwargs), repo
+
+
+@pytest.mark.parametrize("use_native", [False, True])
+class TestCoalescing:
+
+    def test_repeated_access_coalesces(self, use_native):
+        """Many accesses to one memory become one pending row."""
+        tracker, _ = _make_tracker(use_native)
+        for _ in range(30):
+            tracker.track_access("mem-1")
+        tracker.track_access("mem-2")
+
+        assert tracker.pending_count == 2
+        ids, counts, last_ts, _ = tracker.drain()
+        assert dict(zip(ids, counts)) == {"mem-1": 30, "mem-2": 1}
+        assert all(ts > 0 for ts in last_ts)
+        assert tracker.pending_count == 0
+
+    def test_channel_bits(self, use_native):
+        """Channels accessed from are OR-ed into one bitmask per memory."""
+        tracker, _ = _make_tracker(use_native)
+        tracker.track_access("mem-1", channel_id="discord")
+        tracker.track_access("mem-1", channel_id="voice")
+        tracker.track_access("mem-1")
+
+        ids, _, _, channels = tracker.drain()
+        expected = (1 << tracker.channel_bit("discord")) | (1 << tracker.channel_bit("voice"))
+        assert ids == ["mem-1"]
+        assert channels == [expected]
+
+    def test_flush_is_one_batch_call(self, use_native):
+        """Flush writes every accessed memory with a single batch update."""
+        tracker, repo = _make_tracker(use_native)
+        for i in range(10):
+            tracker.track_access(f"mem-{i % 3}")
+
+        assert tracker.flush() == 3
+        repo.batch_update_metadata.assert_called_once()
+        ids, metadatas = repo.batch_update_metadata.call_args[0]
+        assert sorted(ids) == ["mem-0", "mem-1", "mem-2"]
+        for metadata in metadatas:
+            assert datetime.fromisoformat(metadata["last_accessed"]).tzinfo is not None
+
+        assert tracker.flush() == 0
+        assert repo.batch_update_metadata.call_count == 1
+
+    def test_threshold_triggers_flush(self, use_native):
+        """maybe_flush flushes once enough distinct memories are pending."""
+        tracker, repo = _make_tracker(use_native, flush_threshold=3, flush_interval=3600)
+        tracker.track_access("mem-1")
+        tracker.track_access("mem-1")
+        tracker.track_access("mem-2")
+        tracker.maybe_flush()
+        repo.batch_update_metadata.assert_not_called()
+
+        tracker.track_access("mem-3")
+        tracker.maybe_flush()
+        repo.batch_update_metadata.assert_called_once()
+
+    def test_clear_pending(self, use_native):
+        """clear_pending drops accesses without writing them."""
+        tracker, repo = _make_tracker(use_native)
+        tracker.track_access("mem-1")
+        tracker.clear_pending()
+        assert tracker.pending_count == 0
+        assert tracker.flush() == 0
+        repo.batch_update_metadata.assert_not_called()
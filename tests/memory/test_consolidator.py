@@ -265,3 +265,69 @@ class TestMemoryConsolidator:
         assert report["deleted"] == 0
         # Decay should not be calculated for preserved memories
         calc.calculate.assert_not_called()
+
+
+class TestColumnarDecay:
+    """Decay inputs streamed from binary COPY columns."""
+
+    @staticmethod
+    def _metadata():
+        return {"importance": 0.1, "created_at": get_past_time(30), "repetitions": 1,
+                "access_count": 0, "preserved": False}
+
+    def test_streamed_rows_use_decay_records(self, mock_repository):
+        """Streamed rows go through calculate_records; unstreamed ones through metadata."""
+        np = pytest.importorskip("numpy")
+        mock_repository.get_all.return_value = {
+            "ids": ["mem-001", "mem-002", "mem-new"],
+            "metadatas": [self._metadata() for _ in range(3)],
+        }
+        columns = MagicMock()
+        columns.ids = ["mem-002", "mem-other", "mem-001"]
+        columns.decay_records.return_value = "records"
+
+        def stream_columns(on_batch):
+            on_batch(columns)
+            return len(columns.ids)
+
+        mock_repository.stream_columns.side_effect = stream_columns
+        calc = MagicMock(spec=AdaptiveDecayCalculator)
+        calc.calculate_records.return_value = np.array([0.9, 0.5, 0.01])
+        calc.calculate_batch.return_value = [0.8]
+
+        with patch(
+            "backend.memory.permanent.consolidator.get_connection_count",
+            return_value=2,
+        ), patch(
+            "backend.memory.permanent.consolidator.is_native_available",
+            return_value=True,
+        ):
+            consolidator = MemoryConsolidator(repository=mock_repository, decay_calculator=calc)
+            report = consolidator.consolidate()
+
+        mock_repository.delete.assert_called_once_with(["mem-001"])
+        assert report["deleted"] == 1
+        # Only the row missing from the stream is built as a dict
+        assert len(calc.calculate_batch.call_args[0][0]) == 1
+        connections = columns.decay_records.call_args.kwargs["connection_count"]
+        assert list(connections) == [2, 0, 2]
+        updates = dict(zip(*mock_repository.batch_update_metadata.call_args[0]))
+        assert updates == {"mem-002": {"importance": 0.9}, "mem-new": {"importance": 0.8}}
+
+    def test_without_native_uses_metadata(self, mock_repository):
+        """Without the native module the stream is never opened."""
+        mock_repository.get_all.return_value = {"ids": ["mem-001"], "metadatas": [self._metadata()]}
+        calc = MagicMock(spec=AdaptiveDecayCalculator)
+        calc.calculate_batch.return_value = [0.5]
+
+        with patch(
+            "backend.memory.permanent.consolidator.get_connection_count",
+            return_value=0,
+        ), patch(
+            "backend.memory.permanent.consolidator.is_native_available",
+            return_value=False,
+        ):
+            MemoryConsolidator(repository=mock_repository, decay_calculator=calc).consolidate()
+
+        mock_repository.stream_columns.assert_not_called()
+        calc.calculate_batch.assert_called_once()
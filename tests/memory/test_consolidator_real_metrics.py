@@ -29,7 +29,8 @@ class TestConsolidatorRealMetrics:
 
             consolidator.consolidate()
 
-        mock_collect.assert_called_once_with(mock_conn_mgr)
+        from backend.config import INTERACTION_LOG_DIR
+        mock_collect.assert_called_once_with(mock_conn_mgr, log_dir=INTERACTION_LOG_DIR)
 
     def test_conn_mgr_none_still_works(self):
         """collect_behavior_metrics(None) returns defaults — no crash."""
@@ -87,3 +87,53 @@ class TestDetectPeakHours:
 
     def test_invalid_length(self):
         assert detect_peak_hours([1.0, 2.0]) == []
+
+
+class TestCollectFromLogSegments:
+    """Test metrics from native interaction log segments."""
+
+    @staticmethod
+    def _columns(timestamps, latency, tools):
+        import numpy as np
+
+        return {
+            "timestamp": np.asarray(timestamps, dtype=np.float64),
+            "latency_ms": np.asarray(latency, dtype=np.int32),
+            "tool_call_count": np.asarray(tools, dtype=np.int32),
+            "corrupt": 0,
+        }
+
+    def test_segments_replace_interaction_query(self, monkeypatch):
+        import time
+
+        now = time.time()
+        columns = self._columns([now - 60, now - 30, now - 10], [200, -1, 400], [0, 2, 1])
+        monkeypatch.setattr(
+            "backend.core.telemetry.interaction_log.read_interaction_columns",
+            lambda directory, since=0.0: columns,
+        )
+        mock_conn = MagicMock()
+        mock_conn.execute_dict.return_value = [{"avg_dur": 900.0}]
+
+        metrics = collect_behavior_metrics(conn_mgr=mock_conn, log_dir="/logs")
+
+        assert metrics.avg_latency_ms == pytest.approx(300.0)  # -1 (unknown) skipped
+        assert metrics.tool_usage_frequency == pytest.approx(2 / 3 * 10)
+        assert sum(metrics.hourly_activity_rate) == pytest.approx(3 / 7)
+        assert metrics.session_duration_avg == 900.0
+        assert mock_conn.execute_dict.call_count == 1  # sessions only
+
+    def test_empty_segments_fall_back_to_db(self, monkeypatch):
+        monkeypatch.setattr(
+            "backend.core.telemetry.interaction_log.read_interaction_columns",
+            lambda directory, since=0.0: self._columns([], [], []),
+        )
+        mock_conn = MagicMock()
+        mock_conn.execute_dict.side_effect = [
+            [{"avg_latency": 500.0, "tool_calls": 10, "total_interactions": 100}],
+            [{"avg_dur": 1200.0}],
+        ]
+
+        metrics = collect_behavior_metrics(conn_mgr=mock_conn, log_dir="/logs")
+        assert metrics.avg_latency_ms == 500.0
+        assert metrics.tool_usage_frequency == pytest.approx(1.0)
@@ -0,0 +1,155 @@
+"""Tests for EmbeddingSpaceMigrator."""
+
+from typing import Any, Dict, List
+
+import numpy as np
+import pytest
+
+from backend.memory.permanent.migrator import EmbeddingSpaceMigrator
+
+
+class FakeRepository:
+    """In-memory store exposing the calls the migrator uses."""
+
+    def __init__(self, ids: List[str], documents: List[str], embeddings: List[Any]):
+        self.ids = ids
+        self.documents = documents
+        self.embeddings = embeddings
+        self.updates: Dict[str, List[float]] = {}
+        self.fail_after = None  # Batches written before update_embeddings starts failing
+        self.update_calls = 0
+
+    def count(self) -> int:
+        return len(self.ids)
+
+    def get_all(self, include=None, limit=None) -> Dict[str, Any]:
+        return {"ids": self.ids, "documents": self.documents, "embeddings": self.embeddings}
+
+    def update_embeddings(self, doc_ids, embeddings) -> int:
+        self.update_calls += 1
+        if self.fail_after is not None:
+            if self.fail_after == 0:
+                return 0  # ChromaDBRepository swallows the error
+            self.fail_after -= 1
+        for doc_id, embedding in zip(doc_ids, embeddings):
+            self.updates[doc_id] = list(embedding)
+        return len(doc_ids)
+
+
+def _unit(x):
+    return x / np.linalg.norm(x, axis=-1, keepdims=True)
+
+
+@pytest.fixture
+def store():
+    """Old 32-dim embeddings whose new-model embeddings are a fixed rotation into 48 dims."""
+    rng = np.random.default_rng(0)
+    n = 600
+    old = rng.standard_normal((n, 32))
+    basis = np.linalg.qr(rng.standard_normal((48, 32)))[0]
+    new = _unit(old @ basis.T + 0.01 * rng.standard_normal((n, 48)))
+    ids = [f"mem-{i:04d}" for i in range(n)]
+    documents = [f"memory text {i}" for i in range(n)]
+    truth = dict(zip(documents, new))
+    calls: List[str] = []
+
+    def embed(text):
+        calls.append(text)
+        return truth[text].tolist()
+
+    repo = FakeRepository(ids, documents, [row.tolist() for row in old])
+    return repo, embed, calls, dict(zip(ids, new))
+
+
+class TestEmbeddingSpaceMigrator:
+    def test_dry_run_reports_quality_without_writing(self, store):
+        repo, embed, calls, _ = store
+        migrator = EmbeddingSpaceMigrator(repo, embed, sample_size=200, holdout=0.25)
+
+        report = migrator.migrate(dry_run=True)
+
+        assert report["action"] == "dry_run" and report["total"] == 600
+        quality = report["quality"]
+        assert quality["fitted_on"] == 150 and quality["pairs"] == 50
+        assert quality["mean_cosine"] > 0.99
+        assert quality["neighbor_overlap"] > 0.8
+        assert quality["top1"] == 1.0
+        assert len(calls) == 200
+        assert repo.updates == {}
+
+    def test_migrate_maps_whole_store(self, store):
+        repo, embed, calls, truth = store
+        migrator = EmbeddingSpaceMigrator(repo, embed, sample_size=200, batch_size=64)
+
+        report = migrator.migrate(dry_run=False, store_dim=48)
+
+        assert report["action"] == "migrated"
+        assert report["mapped"] == 400 and report["reembedded"] == 200
+        assert report["updated"] == 600 and report["skipped"] == 0
+        assert len(calls) == 200  # only the sample hit the embedding API
+        for doc_id, expected in truth.items():
+            assert float(np.dot(repo.updates[doc_id], expected)) > 0.99
+
+    def test_least_squares(self, store):
+        repo, embed, _, _ = store
+        migrator = EmbeddingSpaceMigrator(repo, embed, sample_size=300, method="least_squares")
+        quality = migrator.fit()
+        assert quality["method"] == "least_squares"
+        assert quality["mean_cosine"] > 0.99
+
+    def test_quality_threshold_blocks_writes(self, store):
+        repo, _, _, _ = store
+        rng = np.random.default_rng(1)
+        unrelated = {doc: _unit(rng.standard_normal(48)).tolist() for doc in repo.documents}
+        migrator = EmbeddingSpaceMigrator(repo, unrelated.get, sample_size=200)
+
+        report = migrator.migrate(dry_run=False, min_neighbor_overlap=0.5)
+
+        assert report["action"] == "rejected"
+        assert report["quality"]["neighbor_overlap"] < 0.5
+        assert repo.updates == {}
+
+    def test_store_dim_must_match(self, store):
+        repo, embed, _, _ = store
+        migrator = EmbeddingSpaceMigrator(repo, embed, sample_size=200)
+        with pytest.raises(ValueError):
+            migrator.migrate(dry_run=False)
+        with pytest.raises(ValueError):
+            migrator.migrate(dry_run=False, store_dim=32)
+        assert repo.updates == {}
+
+    def test_failed_batch_stops_migration(self, store):
+        repo, embed, _, _ = store
+        repo.fail_after = 2
+        migrator = EmbeddingSpaceMigrator(repo, embed, sample_size=200, batch_size=64)
+
+        with pytest.raises(RuntimeError):
+            migrator.migrate(dry_run=False, store_dim=48)
+        # Nothing is sent after the failed third batch
+        assert repo.update_calls == 3 and 0 < len(repo.updates) < 600
+
+    def test_parses_pgvector_text(self, store):
+        repo, embed, _, truth = store
+        repo.embeddings = ["[" + ",".join(map(repr, row)) + "]" for row in repo.embeddings]
+        repo.embeddings[5] = None
+        migrator = EmbeddingSpaceMigrator(repo, embed, sample_size=100)
+
+        report = migrator.migrate(dry_run=False, store_dim=48)
+
+        assert report["skipped"] == 1 and "mem-0005" not in repo.updates
+        assert float(np.dot(repo.updates["mem-0010"], truth["mem-0010"])) > 0.99
+
+    def test_failed_embeddings_are_skipped_in_sample(self, store):
+        repo, embed, _, _ = store
+        migrator = EmbeddingSpaceMigrator(
+            repo, lambda text: None if text.endswith("7") else embed(text), sample_size=100
+        )
+        migrator.fit()
+        assert len(migrator._sampled) == 100
+        assert all(not doc_id.endswith("7") for doc_id in migrator._sampled)
+
+    def test_too_few_samples(self, store):
+        repo, _, _, _ = store
+        migrator = EmbeddingSpaceMigrator(repo, lambda text: None)
+        with pytest.raises(ValueError):
+            migrator.fit()
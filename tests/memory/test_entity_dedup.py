@@ -41,3 +41,21 @@ class TestEntityDedup:
         e = Entity(id="is_1", name="is", entity_type="person")
         result = graph.add_entity(e)
         assert result != ""
+
+    def test_normalize_folds_compatibility_forms(self, graph):
+        assert graph._normalize_entity_name(" Ｊｏｈｎ　Doe ") == "John Doe"
+
+    def test_dedup_full_width_and_casefold(self, graph):
+        graph.add_entity(Entity(id="strasse_1", name="Straße", entity_type="place"))
+        assert graph.add_entity(Entity(id="strasse_2", name="ＳＴＲＡＳＳＥ", entity_type="place")) == "strasse_1"
+        assert len(graph.entities) == 1
+
+    def test_find_by_name_uses_name_key(self, graph):
+        graph.add_entity(Entity(id="k_1", name="Kubernetes Cluster", entity_type="tool"))
+        assert [e.id for e in graph.find_entities_by_name("ｋｕｂｅｒｎｅｔｅｓ")] == ["k_1"]
+
+    def test_load_rebuilds_name_index(self, graph, tmp_path):
+        graph.add_entity(Entity(id="john_1", name="John", entity_type="person"))
+        graph.save()
+        reloaded = KnowledgeGraph(persist_path=str(tmp_path / "test_kg.json"))
+        assert reloaded.add_entity(Entity(id="john_2", name="JOHN", entity_type="person")) == "john_1"
@@ -1,6 +1,7 @@
 """Tests for M0 Event Buffer."""
 
 import asyncio
+from datetime import datetime, timezone
 
 import pytest
 
@@ -132,3 +133,134 @@ class TestEventBufferClear:
         assert buf.stats["current_size"] == 0
         # Counters persist after clear
         assert buf.stats["total_pushed"] == 2
+
+
+class TestEventBufferDrain:
+
+    def test_drain_from_cursor(self):
+        """drain returns events after the cursor in push order."""
+        buf = EventBuffer()
+        for i in range(5):
+            buf.push(StreamEvent(event_id=str(i)))
+
+        events, cursor, missed = buf.drain(0, max_events=3)
+        assert [e.event_id for e in events] == ["0", "1", "2"]
+        assert missed == 0
+        events, cursor, missed = buf.drain(cursor)
+        assert [e.event_id for e in events] == ["3", "4"]
+        assert cursor == 5
+
+    def test_drain_reports_dropped_events(self):
+        """A cursor older than the buffer reports the dropped events."""
+        buf = EventBuffer(maxsize=2)
+        for i in range(5):
+            buf.push(StreamEvent(event_id=str(i)))
+
+        events, cursor, missed = buf.drain(0)
+        assert [e.event_id for e in events] == ["3", "4"]
+        assert missed == 3
+
+    def test_metadata_round_trip(self):
+        """Metadata, type and timestamp survive storage."""
+        buf = EventBuffer()
+        event = StreamEvent(
+            event_id="m", type=EventType.MEMORY_ACCESSED,
+            metadata={"query": "안녕", "memory_ids": ["a", "b"]},
+        )
+        buf.push(event)
+
+        stored = buf.get_recent(1)[0]
+        assert stored.type == EventType.MEMORY_ACCESSED
+        assert stored.metadata == event.metadata
+        assert stored.timestamp == event.timestamp
+
+    def test_unserializable_event_kept_whole(self):
+        """Events the native record cannot hold come back unchanged."""
+        buf = EventBuffer()
+        marker = object()
+        event = StreamEvent(event_id="x" * 40, metadata={"obj": marker})
+        buf.push(event)
+
+        stored = buf.get_recent(1)[0]
+        assert stored.event_id == "x" * 40
+        assert stored.metadata["obj"] is marker
+
+    def test_int_keys_and_foreign_timezone_kept_whole(self):
+        """Metadata or timestamps JSON would alter come back unchanged."""
+        buf = EventBuffer()
+        keyed = StreamEvent(event_id="k", metadata={1: "one", "pair": (1, 2)})
+        utc = StreamEvent(event_id="u", timestamp=datetime(2026, 1, 1, tzinfo=timezone.utc))
+        buf.push(keyed)
+        buf.push(utc)
+
+        stored_keyed, stored_utc = buf.get_recent(2)
+        assert stored_keyed.metadata == {1: "one", "pair": (1, 2)}
+        assert stored_utc.timestamp.tzinfo is timezone.utc
+
+
+class _RecordRing:
+    """Python stand-in for events.EventRing storing (seq, type, ts, id, metadata)."""
+
+    def __init__(self):
+        self.records = []
+
+    def push(self, type_index, event_id, timestamp, metadata):
+        self.records.append((len(self.records), type_index, timestamp, event_id, metadata))
+        return len(self.records) - 1
+
+    def recent(self, n):
+        return self.records[::-1][:n]
+
+
+class TestEventBufferNativeRecords:
+
+    def _buffer(self):
+        buf = EventBuffer(use_native=False)
+        buf._ring = _RecordRing()
+        return buf
+
+    def test_json_safe_event_stored_as_record(self):
+        buf = self._buffer()
+        event = StreamEvent(event_id="m", metadata={"query": "안녕", "ids": ["a"]})
+        buf.push(event)
+
+        assert buf._spill == {}
+        assert buf._ring.records[0][4]
+        stored = buf.get_recent(1)[0]
+        assert stored.metadata == event.metadata
+        assert stored.timestamp == event.timestamp
+
+    def test_lossy_events_spill(self):
+        buf = self._buffer()
+        events = [
+            StreamEvent(event_id="k", metadata={1: "one"}),
+            StreamEvent(event_id="t", metadata={"pair": (1, 2)}),
+            StreamEvent(event_id="u", timestamp=datetime(2026, 1, 1, tzinfo=timezone.utc)),
+        ]
+        for event in events:
+            buf.push(event)
+
+        assert sorted(buf._spill) == [0, 1, 2]
+        assert all(record[4] == "" for record in buf._ring.records)
+        assert buf.get_recent(3) == events[::-1]
+
+
+class TestEventBufferDispatchPending:
+
+    @pytest.mark.asyncio
+    async def test_dispatch_pending_delivers_pushed_events(self):
+        """Events added with push() reach handlers once, in order."""
+        buf = EventBuffer()
+        received = []
+
+        async def handler(event: StreamEvent):
+            received.append(event.event_id)
+
+        buf.register_handler(handler)
+        buf.push(StreamEvent(event_id="1"))
+        buf.push(StreamEvent(event_id="2"))
+
+        assert await buf.dispatch_pending() == 2
+        await buf.dispatch(StreamEvent(event_id="3"))
+        assert await buf.dispatch_pending() == 0
+        assert received == ["1", "2", "3"]
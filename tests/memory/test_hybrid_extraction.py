@@ -103,6 +103,23 @@ class TestNerLlmMerge:
         python_e = next(e for e in merged if e["name"] == "Python")
         assert python_e["type"] == "tool"
 
+    def test_merge_matches_graph_name_keys(self):
+        """Names equal under text_key (width, case folding) count as a match."""
+        rag = GraphRAG(client=MagicMock(), model_name="test")
+
+        ner = [
+            {"name": "ＰＹＴＨＯＮ", "type": "concept", "importance": 0.7},
+            {"name": "Straße", "type": "concept", "importance": 0.7},
+        ]
+        llm = [
+            {"name": "python", "type": "tool", "importance": 0.9},
+            {"name": "STRASSE", "type": "concept", "importance": 0.8},
+        ]
+
+        merged = rag._extractor._merge_ner_llm(ner, llm)
+
+        assert merged == llm
+
 
 class TestSpacyUnavailableFallback:
 
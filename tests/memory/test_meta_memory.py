@@ -2,6 +2,7 @@
 
 import pytest
 
+from backend.memory import meta_memory as meta_module
 from backend.memory.meta_memory import MetaMemory
 from backend.memory.recent.connection import SQLiteConnectionManager
 from backend.memory.recent.schema import SchemaManager
@@ -96,3 +97,73 @@ class TestEmptyAccessReturnsEmpty:
         assert meta_memory.get_hot_memories() == []
         assert meta_memory.stats["tracked_memories"] == 0
         assert meta_memory.stats["total_patterns"] == 0
+
+
+class TestChannelMentionsBatch:
+
+    def test_batch_matches_single_lookups(self, meta_memory):
+        """Batch lookup returns one count per ID, in order."""
+        for ch in ["discord", "voice", "web"]:
+            meta_memory.record_access("q", ["mem-1"], channel_id=ch)
+        meta_memory.record_access("q", ["mem-2"], channel_id="discord")
+
+        ids = ["mem-2", "unknown", "mem-1"]
+        assert meta_memory.get_channel_mentions_batch(ids) == [1, 0, 3]
+        assert meta_memory.get_channel_mentions_batch(ids) == [
+            meta_memory.get_channel_mentions(mid) for mid in ids
+        ]
+
+    @pytest.mark.skipif(not meta_module._HAS_NATIVE, reason="Native module not available")
+    def test_evicted_memory_keeps_a_channel_mention(self):
+        """An ID evicted from the native sketch still reports a mention."""
+        meta = MetaMemory(capacity=2, use_native=True)
+        meta.record_access("q", ["long-tail"], channel_id="discord")
+        for i in range(50):
+            meta.record_access("q", [f"hot-{i % 4}"], channel_id="web")
+        assert meta.get_channel_mentions("long-tail") >= 1
+        assert meta.get_channel_mentions_batch(["long-tail", "hot-0"])[0] >= 1
+
+    def test_native_sketch_is_opt_in(self):
+        """The lossy sketch is only used when asked for."""
+        assert not MetaMemory().is_native
+
+    def test_stats_count_channels(self, meta_memory):
+        """unique_channels counts channels across all memories."""
+        meta_memory.record_access("q", ["mem-1"], channel_id="discord")
+        meta_memory.record_access("q", ["mem-2"], channel_id="voice")
+        meta_memory.record_access("q", [], channel_id="web")
+        assert meta_memory.stats["unique_channels"] == 2
+        assert meta_memory.stats["tracked_memories"] == 2
+
+
+class TestAccessDecay:
+
+    @pytest.mark.parametrize("use_native", [False, True])
+    def test_half_life_favors_recent_access(self, use_native, monkeypatch):
+        """With a half-life, recent accesses outrank older repeated ones."""
+        import backend.memory.meta_memory as meta_module
+
+        clock = [1_000_000.0]
+        monkeypatch.setattr(meta_module.time, "time", lambda: clock[0])
+        meta = MetaMemory(half_life_hours=1.0, use_native=use_native)
+
+        meta.record_access("q", ["old"])
+        meta.record_access("q", ["old"])
+        clock[0] += 3 * 3600  # three half-lives
+        meta.record_access("q", ["new"])
+
+        hot = meta.get_hot_memories(limit=2)
+        assert [h["memory_id"] for h in hot] == ["new", "old"]
+        assert hot[0]["access_count"] == 1
+        assert hot[1]["access_count"] == 0  # 2 * 1/8 rounds down
+
+    def test_no_decay_by_default(self, meta_memory, monkeypatch):
+        """Without a half-life counts stay exact however much time passes."""
+        import backend.memory.meta_memory as meta_module
+
+        clock = [1_000_000.0]
+        monkeypatch.setattr(meta_module.time, "time", lambda: clock[0])
+        meta_memory.record_access("q", ["mem-1"])
+        clock[0] += 365 * 86400
+        meta_memory.record_access("q", ["mem-1"])
+        assert meta_memory.get_hot_memories()[0]["access_count"] == 2
@@ -178,3 +178,16 @@ class TestChromaDBRepository:
         passed_metadatas = call_args.kwargs["metadatas"]
         assert "b" not in passed_metadatas[0]
         assert "d" not in passed_metadatas[1]
+
+    def test_update_embeddings(self, mock_chromadb_client, mock_chromadb_collection):
+        """update_embeddings() should replace embeddings in one update call."""
+        mock_chromadb_client.get_or_create_collection.return_value = mock_chromadb_collection
+        repo = ChromaDBRepository(client=mock_chromadb_client)
+
+        updated = repo.update_embeddings(["id1", "id2"], [[0.1, 0.2], [0.3, 0.4]])
+
+        assert updated == 2
+        call_args = mock_chromadb_collection.update.call_args
+        assert call_args.kwargs["ids"] == ["id1", "id2"]
+        assert call_args.kwargs["embeddings"] == [[0.1, 0.2], [0.3, 0.4]]
+        assert repo.update_embeddings(["id1"], []) == 0
@@ -9,7 +9,7 @@ import pytest
 from backend.memory.recent.connection import SQLiteConnectionManager
 from backend.memory.recent.schema import SchemaManager
 from backend.memory.recent.repository import SessionRepository
-from backend.memory.recent.summarizer import SessionSummarizer
+from backend.memory.recent.summarizer import SessionSummarizer, drop_near_duplicate_messages
 
 VANCOUVER_TZ = ZoneInfo("America/Vancouver")
 
@@ -124,3 +124,72 @@ class TestSummarizeExpired:
         result = await summarizer.summarize_expired(llm_client=mock_llm)
         assert result["sessions_processed"] == 0
         assert result["messages_archived"] == 0
+
+
+# ── Near-duplicate messages ─────────────────────────────────────────────────
+
+_LONG = (
+    "I think we should move the deployment to Thursday because the staging "
+    "database migration still needs another review pass, and Mark wants to "
+    "double check the rollback script before anything touches production. "
+    "Let me know if that works for everyone on the team, otherwise we can "
+    "talk about it tomorrow morning during the usual standup meeting."
+)
+
+
+class TestDropNearDuplicateMessages:
+    def test_keeps_latest_of_retries(self):
+        messages = [
+            {"role": "user", "content": _LONG},
+            {"role": "assistant", "content": "Sounds good."},
+            {"role": "user", "content": _LONG.replace("Thursday", "Friday")},
+            {"role": "assistant", "content": "Sounds good."},
+        ]
+        kept = drop_near_duplicate_messages(messages)
+        # Short replies are never treated as near-duplicates
+        assert kept == messages[1:]
+
+    def test_roles_compared_separately(self):
+        messages = [
+            {"role": "user", "content": _LONG},
+            {"role": "assistant", "content": _LONG},
+        ]
+        assert drop_near_duplicate_messages(messages) == messages
+
+    @pytest.mark.asyncio
+    async def test_archive_keeps_superseded(self, summarizer, repo, mock_llm):
+        now = datetime.now(VANCOUVER_TZ)
+        past = now - timedelta(days=10)
+        repo.save_session(
+            session_id="sess-retry",
+            summary="",
+            key_topics=[],
+            emotional_tone="neutral",
+            turn_count=2,
+            started_at=past,
+            ended_at=past,
+            messages=[
+                {"role": "user", "content": _LONG, "timestamp": past.isoformat()},
+                {"role": "user", "content": _LONG + " ", "timestamp": past.isoformat()},
+            ],
+        )
+        with repo._conn_mgr.get_connection() as conn:
+            conn.execute(
+                "UPDATE sessions SET expires_at = ?, summary = NULL WHERE session_id = ?",
+                ((past - timedelta(days=1)).isoformat(), "sess-retry"),
+            )
+            conn.commit()
+
+        result = await summarizer.summarize_expired(llm_client=mock_llm)
+        # Only the summary prompt skips the retry; the archive keeps both
+        assert mock_llm.generate.call_args[0][0].count("user: ") == 1
+        assert result["messages_archived"] == 2
+        with repo._conn_mgr.get_connection() as conn:
+            archived = conn.execute(
+                "SELECT COUNT(*) FROM archived_messages WHERE session_id = 'sess-retry'"
+            ).fetchone()[0]
+            remaining = conn.execute(
+                "SELECT COUNT(*) FROM messages WHERE session_id = 'sess-retry'"
+            ).fetchone()[0]
+        assert archived == 2
+        assert remaining == 0
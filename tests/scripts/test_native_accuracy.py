@@ -0,0 +1,79 @@
+"""Tests for scripts/native_accuracy.py — inputs and exact references only."""
+
+import numpy as np
+
+from scripts.native_accuracy import (
+    DECAY_COLUMNS,
+    decay_reference,
+    exact_pairs,
+    exact_top_k,
+    load_recorded,
+    random_decay_columns,
+)
+
+
+def _cols(**overrides):
+    cols = {
+        "importance": np.array([0.8]),
+        "hours_passed": np.array([100.0]),
+        "access_count": np.array([0], dtype=np.int32),
+        "connection_count": np.array([0], dtype=np.int32),
+        "last_access_hours": np.array([-1.0]),
+        "memory_type": np.array([0], dtype=np.int32),
+        "channel_mentions": np.array([0], dtype=np.int32),
+    }
+    cols.update({k: np.asarray(v) for k, v in overrides.items()})
+    return cols
+
+
+class TestDecayReference:
+    def test_plain_exponential(self):
+        out = decay_reference(_cols())
+        assert out[0] == np.float64(0.8 * np.exp(-0.002 * 100.0))
+
+    def test_negative_age_keeps_importance(self):
+        assert decay_reference(_cols(hours_passed=[-5.0]))[0] == 0.8
+
+    def test_min_retention_floor(self):
+        out = decay_reference(_cols(hours_passed=[1e7]))
+        assert out[0] == np.float64(0.8 * 0.1)
+
+    def test_recency_boost(self):
+        base = decay_reference(_cols(hours_passed=[500.0]))[0]
+        boosted = decay_reference(_cols(hours_passed=[500.0], last_access_hours=[2.0]))[0]
+        assert boosted == base * 1.3
+
+    def test_type_is_clamped(self):
+        high = decay_reference(_cols(memory_type=np.array([9], dtype=np.int32)))[0]
+        insight = decay_reference(_cols(memory_type=np.array([3], dtype=np.int32)))[0]
+        assert high == insight
+
+
+class TestInputs:
+    def test_random_decay_covers_edge_cases(self):
+        cols = random_decay_columns(20_000, np.random.default_rng(0))
+        assert set(cols) == set(DECAY_COLUMNS)
+        assert (cols["hours_passed"] < 0).any()
+        assert (cols["last_access_hours"] < 0).any()
+        assert cols["memory_type"].min() < 0 and cols["memory_type"].max() > 3
+        assert cols["access_count"].dtype == np.int32
+
+    def test_load_recorded_partial(self, tmp_path):
+        path = tmp_path / "dump.npz"
+        np.savez(path, embeddings=np.ones((3, 4), dtype=np.float32), importance=np.ones(3))
+        recorded = load_recorded(path)
+        assert "decay" not in recorded
+        assert recorded["embeddings"].dtype == np.float64
+
+
+class TestExactReferences:
+    def test_top_k_ties_by_index(self):
+        unit = np.array([[1.0, 0.0], [0.0, 1.0], [1.0, 0.0]])
+        order, sims = exact_top_k(unit, np.array([2.0, 0.0]), 2)
+        assert order.tolist() == [0, 2]
+        assert sims[1] == 0.0
+
+    def test_pairs_upper_triangle(self):
+        emb = np.array([[1.0, 0.0], [2.0, 0.01], [0.0, 1.0]])
+        i, j = exact_pairs(emb, 0.99)
+        assert list(zip(i.tolist(), j.tolist())) == [(0, 1)]
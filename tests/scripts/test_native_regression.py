@@ -0,0 +1,136 @@
+"""Tests for scripts/native_regression.py — fixture and baseline logic only."""
+
+import json
+
+import numpy as np
+import pytest
+
+from scripts.native_regression import (
+    Fixture,
+    FixtureLTM,
+    compare,
+    load_baseline,
+    verdict,
+    write_baseline,
+)
+
+
+def _result(shape="100x8", **medians):
+    return {
+        "shape": shape,
+        "fixture": {"memories": 100, "dim": 8},
+        "environment": {"host": "test"},
+        "phases": {p: {"median_ms": m, "kernel_median_ms": 0.0} for p, m in medians.items()},
+    }
+
+
+def _baseline(shape="100x8", tolerance=None, slack_ms=0.0, **medians):
+    return {
+        "tolerance": tolerance or {"default": 0.1},
+        "slack_ms": slack_ms,
+        "shapes": {shape: {"phases": {p: {"median_ms": m} for p, m in medians.items()}}},
+    }
+
+
+class TestFixture:
+    def test_shape_and_determinism(self):
+        a = Fixture(100, 8, n_entities=10, n_relations=30, n_turns=5, seed=1)
+        b = Fixture(100, 8, n_entities=10, n_relations=30, n_turns=5, seed=1)
+
+        assert a.shape_key == "100x8"
+        assert a.embeddings.shape == (100, 8)
+        assert a.embeddings.dtype == np.float32
+        np.testing.assert_array_equal(a.embeddings, b.embeddings)
+        assert a.texts == b.texts
+        assert len(a.metadatas) == len(a.entities) == 100
+        assert len(a.turns) == 5
+
+    def test_plants_near_duplicates(self):
+        f = Fixture(100, 64, n_entities=10, n_relations=30, n_turns=1, seed=2)
+        row = f.embeddings[20]
+        sims = f.embeddings[:20] @ row / (
+            np.linalg.norm(f.embeddings[:20], axis=1) * np.linalg.norm(row))
+        assert sims.max() > 0.99
+
+    def test_metadata_is_chroma_style(self):
+        f = Fixture(50, 4, n_entities=5, n_relations=10, n_turns=1, seed=3)
+        meta = f.metadatas[0]
+        assert {"created_at", "importance", "access_count", "repetitions", "type"} <= meta.keys()
+        assert meta["type"] in ("conversation", "fact", "preference", "insight")
+
+    def test_ltm_window_takes_latest_rows(self):
+        f = Fixture(50, 4, n_entities=5, n_relations=10, n_turns=1, seed=4)
+        results = FixtureLTM(f, 10).get_all_memories()
+        assert results["ids"] == f.ids[40:]
+        assert results["embeddings"].shape == (10, 4)
+
+
+class TestCompare:
+    def test_within_tolerance_is_ok(self):
+        rows = compare(_result(load=105.0), _baseline(load=100.0))
+        assert rows[0]["status"] == "ok"
+        assert rows[0]["limit_ms"] == pytest.approx(110.0)
+
+    def test_regression_detected(self):
+        rows = compare(_result(load=120.0), _baseline(load=100.0))
+        assert rows[0]["status"] == "regressed"
+
+    def test_improvement_reported(self):
+        rows = compare(_result(load=80.0), _baseline(load=100.0))
+        assert rows[0]["status"] == "improved"
+
+    def test_slack_absorbs_tiny_phases(self):
+        rows = compare(_result(dedup=1.5), _baseline(slack_ms=5.0, dedup=0.5))
+        assert rows[0]["status"] == "ok"
+
+    def test_per_phase_tolerance(self):
+        baseline = _baseline(tolerance={"default": 0.1, "load": 0.5}, load=100.0, dedup=100.0)
+        rows = {r["phase"]: r for r in compare(_result(load=140.0, dedup=140.0), baseline)}
+        assert rows["load"]["status"] == "ok"
+        assert rows["dedup"]["status"] == "regressed"
+
+    def test_other_shape_has_no_baseline(self):
+        rows = compare(_result(shape="10x8", load=1.0), _baseline(load=100.0))
+        assert rows[0]["status"] == "no-baseline"
+        assert rows[0]["baseline_ms"] is None
+
+
+class TestVerdict:
+    def test_pass(self):
+        assert verdict(compare(_result(load=100.0), _baseline(load=100.0)))[0] == 0
+
+    def test_regression_fails(self):
+        code, summary = verdict(compare(_result(load=150.0), _baseline(load=100.0)))
+        assert code == 1 and "load" in summary
+
+    def test_missing_shape_fails(self):
+        code, summary = verdict(compare(_result(shape="10x8", load=1.0), _baseline(load=100.0)))
+        assert code == 1 and "no baseline" in summary
+
+    def test_missing_phase_fails(self):
+        rows = compare(_result(load=100.0, dedup=1.0), _baseline(load=100.0))
+        assert verdict(rows)[0] == 1
+
+
+class TestBaselineFile:
+    def test_missing_file_gives_defaults(self, tmp_path):
+        baseline = load_baseline(tmp_path / "none.json")
+        assert baseline["shapes"] == {}
+        assert "default" in baseline["tolerance"]
+
+    def test_write_keeps_other_shapes_and_tolerances(self, tmp_path):
+        path = tmp_path / "baseline.json"
+        baseline = _baseline(shape="other", tolerance={"default": 0.2}, load=1.0)
+        write_baseline(path, baseline, _result(load=12.5, dedup=3.0))
+
+        saved = json.loads(path.read_text())
+        assert saved["tolerance"] == {"default": 0.2}
+        assert "other" in saved["shapes"]
+        assert saved["shapes"]["100x8"]["phases"]["load"] == {"median_ms": 12.5}
+
+    def test_checked_in_baseline_parses(self):
+        from scripts.native_regression import BASELINE_PATH
+
+        baseline = load_baseline(BASELINE_PATH)
+        assert "default" in baseline["tolerance"]
+        assert isinstance(baseline["shapes"], dict)